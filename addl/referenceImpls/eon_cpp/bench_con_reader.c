@@ -5,9 +5,13 @@
  *
  * Build: cc -O2 -o bench_con_reader bench_con_reader.c -lm
  * Usage: ./bench_con_reader <file.con> [repeat]
+ *
+ * Define EON_CON_READER_NO_MAIN to link only eon_ref_read_frame (see
+ * bench_con_reader.h), as the C++ benchmark suite in benches/cpp does.
  */
+#include "bench_con_reader.h"
+
 #include <math.h>
-#include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <time.h>
@@ -15,23 +19,7 @@
 #define MAXC 100
 #define MAX_LINE 512
 
-typedef struct {
-    double x, y, z;
-    int fixed;
-    long atom_id;
-    double mass;
-    char symbol[4];
-} Atom;
-
-typedef struct {
-    double cell[3];
-    double angles[3];
-    Atom *atoms;
-    int n_atoms;
-    int n_types;
-} Frame;
-
-static int read_frame(FILE *f, Frame *frame) {
+int eon_ref_read_frame(FILE *f, Frame *frame) {
     char line[MAX_LINE];
 
     /* Line 1: comment */
@@ -105,6 +93,7 @@ static int read_frame(FILE *f, Frame *frame) {
     return 1;
 }
 
+#ifndef EON_CON_READER_NO_MAIN
 int main(int argc, char **argv) {
     if (argc < 2) {
         fprintf(stderr, "Usage: %s <file.con> [repeat]\n", argv[0]);
@@ -120,7 +109,7 @@ int main(int argc, char **argv) {
         if (!f) { perror("fopen"); return 1; }
         Frame frame;
         int count = 0;
-        while (read_frame(f, &frame)) {
+        while (eon_ref_read_frame(f, &frame)) {
             free(frame.atoms);
             count++;
         }
@@ -137,7 +126,7 @@ int main(int argc, char **argv) {
 
         Frame frame;
         int count = 0;
-        while (read_frame(f, &frame)) {
+        while (eon_ref_read_frame(f, &frame)) {
             free(frame.atoms);
             count++;
         }
@@ -153,3 +142,4 @@ int main(int argc, char **argv) {
     printf("%.2f ms (best of %d runs)\n", best, repeat);
     return 0;
 }
+#endif /* EON_CON_READER_NO_MAIN */
@@ -0,0 +1,38 @@
+/*
+ * eOn-style CON frame reader shared by bench_con_reader.c and the C++
+ * benchmark suite (benches/cpp). Plain, uncompressed, positions-only CON.
+ */
+#ifndef EON_BENCH_CON_READER_H
+#define EON_BENCH_CON_READER_H
+
+#include <stdio.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct {
+    double x, y, z;
+    int fixed;
+    long atom_id;
+    double mass;
+    char symbol[4];
+} Atom;
+
+typedef struct {
+    double cell[3];
+    double angles[3];
+    Atom *atoms;
+    int n_atoms;
+    int n_types;
+} Frame;
+
+/* Reads the next frame; returns 1 on success (caller frees frame->atoms),
+ * 0 at end of input or on a malformed frame. */
+int eon_ref_read_frame(FILE *f, Frame *frame);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* EON_BENCH_CON_READER_H */
@@ -0,0 +1,532 @@
+// C++ wrapper throughput: readcon-core.hpp readers, span accessors, writer and
+// builder, next to the eOn-style reference reader (bench_con_reader.c) and a
+// writer using eOn's matter2con line format.
+//
+// Inputs are generated once per (atoms, frames, sections, compression) into
+// $READCON_BENCH_DIR (default: <tmp>/readcon-core-bench) and reused across
+// runs. Grids stop at $READCON_BENCH_MAX_ATOMS total atoms per file
+// (default 1e6) so the 10^6-atom frames stay in the default run.
+//
+// Counters: bytes_per_second is uncompressed CON text, items_per_second is
+// frames (atoms for the builder), peak_rss_MB is the process high-water mark
+// over the timed loop (VmHWM after /proc/self/clear_refs on Linux).
+
+#include "readcon-core.hpp"
+
+#include "bench_con_reader.h"
+
+#include <benchmark/benchmark.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/resource.h>
+#endif
+
+namespace fs = std::filesystem;
+
+namespace {
+
+enum Sections : int64_t { kPositions = 0, kVelocities = 1, kVelocitiesForces = 2 };
+enum Codec : int64_t { kPlain = 0, kGzip = 1, kZstd = 2 };
+
+const std::vector<int64_t> kAtoms{10, 1000, 100000, 1000000};
+const std::vector<int64_t> kFrames{1, 10, 100, 1000};
+
+int64_t max_total_atoms() {
+    const char *env = std::getenv("READCON_BENCH_MAX_ATOMS");
+    return env ? std::atoll(env) : 1000000;
+}
+
+fs::path bench_dir() {
+    const char *env = std::getenv("READCON_BENCH_DIR");
+    fs::path dir = env ? fs::path(env) : fs::temp_directory_path() / "readcon-core-bench";
+    fs::create_directories(dir);
+    return dir;
+}
+
+readcon::ConFrameWriter::Compression compression_of(int64_t codec) {
+    switch (codec) {
+    case kGzip:
+        return readcon::ConFrameWriter::Compression::Gzip;
+    case kZstd:
+        return readcon::ConFrameWriter::Compression::Zstd;
+    default:
+        return readcon::ConFrameWriter::Compression::None;
+    }
+}
+
+const char *extension_of(int64_t codec) {
+    return codec == kGzip ? ".con.gz" : codec == kZstd ? ".con.zst" : ".con";
+}
+
+/// One synthetic frame: a Cu slab with a quarter H, LCG positions in a 50 A box.
+readcon::ConFrame make_frame(int64_t atoms, int64_t sections) {
+    const size_t n = static_cast<size_t>(atoms);
+    std::vector<double> pos(3 * n), masses(n), vel, frc;
+    uint64_t state = 0x9e3779b97f4a7c15ULL;
+    auto next = [&state] {
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        return static_cast<double>(state >> 11) / 9007199254740992.0;
+    };
+    for (double &x : pos) {
+        x = 50.0 * next();
+    }
+    const size_t n_h = n / 4;
+    for (size_t i = 0; i < n; ++i) {
+        masses[i] = i < n - n_h ? 63.546 : 1.008;
+    }
+    readcon::FrameArrays cols;
+    cols.positions = pos;
+    cols.masses = masses;
+    if (sections >= kVelocities) {
+        vel.resize(3 * n);
+        for (double &v : vel) {
+            v = next() - 0.5;
+        }
+        cols.velocities = vel;
+    }
+    if (sections >= kVelocitiesForces) {
+        frc.resize(3 * n);
+        for (double &f : frc) {
+            f = 2.0 * next() - 1.0;
+        }
+        cols.forces = frc;
+    }
+    std::vector<std::string> symbols{"Cu", "H"};
+    std::vector<size_t> counts{n - n_h, n_h};
+    // A non-empty comment line: a blank line 1 would read as a legacy
+    // velocity separator in sectionless multi-frame files.
+    readcon::ConFrameBuilder builder({50.0, 50.0, 50.0}, {90.0, 90.0, 90.0},
+                                     {"readcon-core benchmark", ""});
+    builder.set_atoms_from_arrays(symbols, counts, cols);
+    builder.set_energy(-1.0);
+    return builder.build();
+}
+
+struct Input {
+    fs::path path;
+    int64_t text_bytes = 0;
+};
+
+/// Writes (or reuses) the input file; `text_bytes` is the plain CON size.
+const Input &input(int64_t atoms, int64_t frames, int64_t sections, int64_t codec) {
+    static std::map<std::tuple<int64_t, int64_t, int64_t, int64_t>, Input> cache;
+    const auto key = std::make_tuple(atoms, frames, sections, codec);
+    if (auto it = cache.find(key); it != cache.end()) {
+        return it->second;
+    }
+    const int64_t text_bytes =
+        codec == kPlain ? 0 : input(atoms, frames, sections, kPlain).text_bytes;
+    const std::string stem = "a" + std::to_string(atoms) + "_f" + std::to_string(frames) +
+                             "_s" + std::to_string(sections);
+    Input in;
+    in.path = bench_dir() / (stem + extension_of(codec));
+    if (!fs::exists(in.path)) {
+        // Write beside the target and rename so an interrupted run never
+        // leaves a truncated input behind for the next one.
+        fs::path partial = in.path;
+        partial += ".partial";
+        {
+            readcon::ConFrameWriter writer(partial, compression_of(codec));
+            std::vector<readcon::ConFrame> batch;
+            batch.push_back(make_frame(atoms, sections));
+            for (int64_t f = 0; f < frames; ++f) {
+                writer.extend(batch);
+            }
+        }
+        fs::rename(partial, in.path);
+    }
+    in.text_bytes =
+        codec == kPlain ? static_cast<int64_t>(fs::file_size(in.path)) : text_bytes;
+    return cache.emplace(key, in).first->second;
+}
+
+/// Peak resident set over one benchmark's timed loop.
+class PeakRss {
+  public:
+    PeakRss() {
+#if defined(__linux__)
+        std::ofstream("/proc/self/clear_refs") << "5";
+#endif
+    }
+
+    double megabytes() const {
+#if defined(__linux__)
+        std::ifstream status("/proc/self/status");
+        for (std::string line; std::getline(status, line);) {
+            if (line.rfind("VmHWM:", 0) == 0) {
+                return std::atof(line.c_str() + 6) / 1024.0;
+            }
+        }
+        return 0.0;
+#elif defined(__APPLE__)
+        rusage usage{};
+        getrusage(RUSAGE_SELF, &usage);
+        return static_cast<double>(usage.ru_maxrss) / (1024.0 * 1024.0);
+#elif defined(__unix__)
+        rusage usage{};
+        getrusage(RUSAGE_SELF, &usage);
+        return static_cast<double>(usage.ru_maxrss) / 1024.0;
+#else
+        return 0.0;
+#endif
+    }
+};
+
+/// Flags a reader that stopped before the last frame (the iterator drops
+/// unparsable tails instead of throwing).
+bool read_everything(benchmark::State &state, int64_t read) {
+    if (read != state.range(1)) {
+        state.SkipWithError("reader stopped before the last frame");
+        return false;
+    }
+    return true;
+}
+
+void report(benchmark::State &state, int64_t bytes, int64_t items, const PeakRss &rss) {
+    if (bytes > 0) {
+        state.SetBytesProcessed(state.iterations() * bytes);
+    }
+    state.SetItemsProcessed(state.iterations() * items);
+    state.counters["peak_rss_MB"] = rss.megabytes();
+}
+
+int64_t atoms_arg(const benchmark::State &state) { return state.range(0); }
+int64_t frames_arg(const benchmark::State &state) { return state.range(1); }
+int64_t sections_arg(const benchmark::State &state) { return state.range(2); }
+int64_t codec_arg(const benchmark::State &state) { return state.range(3); }
+
+/// Registers atoms x frames (within the total-atom cap) x sections x codecs.
+void grid(benchmark::internal::Benchmark *b, std::vector<int64_t> sections,
+          std::vector<int64_t> codecs) {
+    b->ArgNames({"atoms", "frames", "sections", "codec"});
+    for (int64_t atoms : kAtoms) {
+        for (int64_t frames : kFrames) {
+            if (atoms * frames > max_total_atoms()) {
+                continue;
+            }
+            for (int64_t s : sections) {
+                for (int64_t c : codecs) {
+                    b->Args({atoms, frames, s, c});
+                }
+            }
+        }
+    }
+    b->Unit(benchmark::kMillisecond);
+}
+
+std::vector<int64_t> all_codecs() {
+#if defined(READCON_CORE_HAS_ZSTD)
+    return {kPlain, kGzip, kZstd};
+#else
+    return {kPlain, kGzip};
+#endif
+}
+
+void full_grid(benchmark::internal::Benchmark *b) {
+    grid(b, {kPositions, kVelocities, kVelocitiesForces}, all_codecs());
+}
+void plain_grid(benchmark::internal::Benchmark *b) {
+    grid(b, {kPositions, kVelocitiesForces}, {kPlain});
+}
+/// The reference reader only understands plain positions-only CON.
+void reference_grid(benchmark::internal::Benchmark *b) { grid(b, {kPositions}, {kPlain}); }
+
+std::vector<readcon::ConFrame> load(const benchmark::State &state) {
+    return readcon::read_all_frames(
+        input(atoms_arg(state), frames_arg(state), sections_arg(state), kPlain).path);
+}
+
+// ----- readers ---------------------------------------------------------------
+
+void BM_ConFrameIterator(benchmark::State &state) {
+    const Input &in = input(atoms_arg(state), frames_arg(state), sections_arg(state),
+                            codec_arg(state));
+    PeakRss rss;
+    int64_t read = 0;
+    for (auto _ : state) {
+        read = 0;
+        readcon::ConFrameIterator frames(in.path);
+        for (auto &&frame : frames) {
+            benchmark::DoNotOptimize(frame.positions().data());
+            ++read;
+        }
+    }
+    if (read_everything(state, read)) {
+        report(state, in.text_bytes, frames_arg(state), rss);
+    }
+}
+BENCHMARK(BM_ConFrameIterator)->Apply(full_grid);
+
+void BM_ConFrameIteratorParallel(benchmark::State &state) {
+    const Input &in = input(atoms_arg(state), frames_arg(state), sections_arg(state),
+                            codec_arg(state));
+    PeakRss rss;
+    int64_t read = 0;
+    for (auto _ : state) {
+        read = 0;
+        readcon::ConFrameIterator frames(in.path, 0);
+        for (auto &&frame : frames) {
+            benchmark::DoNotOptimize(frame.positions().data());
+            ++read;
+        }
+    }
+    if (read_everything(state, read)) {
+        report(state, in.text_bytes, frames_arg(state), rss);
+    }
+}
+BENCHMARK(BM_ConFrameIteratorParallel)->Apply(plain_grid);
+
+/// Iteration plus the AoS `atoms()` cache, the pre-span access path.
+void BM_ConFrameIteratorAtoms(benchmark::State &state) {
+    const Input &in = input(atoms_arg(state), frames_arg(state), sections_arg(state),
+                            codec_arg(state));
+    PeakRss rss;
+    int64_t read = 0;
+    for (auto _ : state) {
+        read = 0;
+        readcon::ConFrameIterator frames(in.path);
+        for (auto &&frame : frames) {
+            benchmark::DoNotOptimize(frame.atoms().data());
+            ++read;
+        }
+    }
+    if (read_everything(state, read)) {
+        report(state, in.text_bytes, frames_arg(state), rss);
+    }
+}
+BENCHMARK(BM_ConFrameIteratorAtoms)->Apply(plain_grid);
+
+void BM_ReadAllFrames(benchmark::State &state) {
+    const Input &in = input(atoms_arg(state), frames_arg(state), sections_arg(state),
+                            codec_arg(state));
+    PeakRss rss;
+    int64_t read = 0;
+    for (auto _ : state) {
+        auto frames = readcon::read_all_frames(in.path);
+        benchmark::DoNotOptimize(frames.data());
+        read = static_cast<int64_t>(frames.size());
+    }
+    if (read_everything(state, read)) {
+        report(state, in.text_bytes, frames_arg(state), rss);
+    }
+}
+BENCHMARK(BM_ReadAllFrames)->Apply(full_grid);
+
+void BM_EonReferenceRead(benchmark::State &state) {
+    const Input &in = input(atoms_arg(state), frames_arg(state), kPositions, kPlain);
+    PeakRss rss;
+    int64_t read = 0;
+    for (auto _ : state) {
+        FILE *file = std::fopen(in.path.string().c_str(), "r");
+        if (!file) {
+            state.SkipWithError("cannot open input");
+            break;
+        }
+        Frame frame;
+        read = 0;
+        while (eon_ref_read_frame(file, &frame)) {
+            benchmark::DoNotOptimize(frame.atoms);
+            std::free(frame.atoms);
+            ++read;
+        }
+        std::fclose(file);
+    }
+    if (!state.error_occurred() && read_everything(state, read)) {
+        report(state, in.text_bytes, frames_arg(state), rss);
+    }
+}
+BENCHMARK(BM_EonReferenceRead)->Apply(reference_grid);
+
+// ----- accessors (frames preloaded, no I/O in the loop) ---------------------
+
+void BM_SpanPositions(benchmark::State &state) {
+    const auto frames = load(state);
+    PeakRss rss;
+    for (auto _ : state) {
+        double sum = 0.0;
+        for (const auto &frame : frames) {
+            for (double x : frame.positions()) {
+                sum += x;
+            }
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    report(state, frames_arg(state) * atoms_arg(state) * 3 * int64_t(sizeof(double)),
+           frames_arg(state), rss);
+}
+BENCHMARK(BM_SpanPositions)->Apply(plain_grid);
+
+void BM_CopyPositions(benchmark::State &state) {
+    const auto frames = load(state);
+    std::vector<double> buffer(3 * static_cast<size_t>(atoms_arg(state)));
+    PeakRss rss;
+    for (auto _ : state) {
+        for (const auto &frame : frames) {
+            frame.copy_positions(buffer.data(), buffer.size());
+            benchmark::DoNotOptimize(buffer.data());
+        }
+    }
+    report(state, frames_arg(state) * atoms_arg(state) * 3 * int64_t(sizeof(double)),
+           frames_arg(state), rss);
+}
+BENCHMARK(BM_CopyPositions)->Apply(plain_grid);
+
+// ----- writers ---------------------------------------------------------------
+
+void BM_ConFrameWriter(benchmark::State &state) {
+    const auto frames = load(state);
+    const Input &in = input(atoms_arg(state), frames_arg(state), sections_arg(state),
+                            codec_arg(state));
+    const fs::path out = bench_dir() / (std::string("out") + extension_of(codec_arg(state)));
+    PeakRss rss;
+    for (auto _ : state) {
+        readcon::ConFrameWriter writer(out, compression_of(codec_arg(state)));
+        writer.extend(frames);
+    }
+    fs::remove(out);
+    report(state, in.text_bytes, frames_arg(state), rss);
+}
+BENCHMARK(BM_ConFrameWriter)->Apply(full_grid);
+
+void BM_ConFrameWriterParallel(benchmark::State &state) {
+    const auto frames = load(state);
+    const Input &in = input(atoms_arg(state), frames_arg(state), sections_arg(state), kPlain);
+    const fs::path out = bench_dir() / "out_parallel.con";
+    PeakRss rss;
+    for (auto _ : state) {
+        auto writer = readcon::ConFrameWriter::parallel(out);
+        writer.extend(frames);
+    }
+    fs::remove(out);
+    report(state, in.text_bytes, frames_arg(state), rss);
+}
+BENCHMARK(BM_ConFrameWriterParallel)->Apply(plain_grid);
+
+/// ConFrameWriter at matter2con's 17 decimals, the pair for BM_EonStyleWrite.
+void BM_ConFrameWriterEonPrecision(benchmark::State &state) {
+    const auto frames = load(state);
+    const fs::path out = bench_dir() / "out_p17.con";
+    PeakRss rss;
+    for (auto _ : state) {
+        readcon::ConFrameWriter writer(out, 17);
+        writer.extend(frames);
+    }
+    const auto bytes = static_cast<int64_t>(fs::file_size(out));
+    fs::remove(out);
+    report(state, bytes, frames_arg(state), rss);
+}
+BENCHMARK(BM_ConFrameWriterEonPrecision)->Apply(reference_grid);
+
+/// Header and atom lines in eOn's matter2con format (fprintf, %22.17f).
+void BM_EonStyleWrite(benchmark::State &state) {
+    const auto frames = load(state);
+    const fs::path out = bench_dir() / "out_eon.con";
+    PeakRss rss;
+    for (auto _ : state) {
+        FILE *file = std::fopen(out.string().c_str(), "wb");
+        if (!file) {
+            state.SkipWithError("cannot open output");
+            break;
+        }
+        for (const auto &frame : frames) {
+            const auto &cell = frame.cell();
+            const auto &angles = frame.angles();
+            std::fputs("Generated by eOn\n\n", file);
+            std::fprintf(file, "%f\t%f\t%f\n", cell[0], cell[1], cell[2]);
+            std::fprintf(file, "%f\t%f\t%f\n", angles[0], angles[1], angles[2]);
+            std::fputs("0 0\n0 0 0\n", file);
+            const size_t n = frame.atom_count();
+            const size_t n_h = n / 4;
+            const size_t counts[2] = {n - n_h, n_h};
+            const char *symbols[2] = {"Cu", "H"};
+            const auto pos = frame.positions();
+            const auto masses = frame.masses();
+            std::fprintf(file, "2\n%zu %zu \n%f %f \n", counts[0], counts[1], masses[0],
+                         masses[n - 1]);
+            size_t i = 0;
+            for (int t = 0; t < 2; ++t) {
+                std::fprintf(file, "%s\nCoordinates of Component %d\n", symbols[t], t + 1);
+                for (size_t k = 0; k < counts[t]; ++k, ++i) {
+                    std::fprintf(file, "%22.17f %22.17f %22.17f %d %4zu\n", pos[3 * i],
+                                 pos[3 * i + 1], pos[3 * i + 2], 0, i);
+                }
+            }
+        }
+        std::fclose(file);
+    }
+    if (state.error_occurred()) {
+        return;
+    }
+    const auto bytes = static_cast<int64_t>(fs::file_size(out));
+    fs::remove(out);
+    report(state, bytes, frames_arg(state), rss);
+}
+BENCHMARK(BM_EonStyleWrite)->Apply(reference_grid);
+
+// ----- builder ---------------------------------------------------------------
+
+void builder_grid(benchmark::internal::Benchmark *b) {
+    b->ArgNames({"atoms"});
+    for (int64_t atoms : kAtoms) {
+        b->Arg(atoms);
+    }
+    b->Unit(benchmark::kMillisecond);
+}
+
+struct BuilderColumns {
+    explicit BuilderColumns(size_t n) : pos(3 * n), masses(n, 63.546) {
+        for (size_t i = 0; i < pos.size(); ++i) {
+            pos[i] = 0.001 * static_cast<double>(i % 50000);
+        }
+    }
+    std::vector<double> pos, masses;
+};
+
+void BM_BuilderAddAtom(benchmark::State &state) {
+    const size_t n = static_cast<size_t>(state.range(0));
+    const BuilderColumns cols(n);
+    PeakRss rss;
+    for (auto _ : state) {
+        readcon::ConFrameBuilder builder({50.0, 50.0, 50.0}, {90.0, 90.0, 90.0});
+        for (size_t i = 0; i < n; ++i) {
+            builder.add_atom("Cu", cols.pos[3 * i], cols.pos[3 * i + 1], cols.pos[3 * i + 2],
+                             false, i, cols.masses[i]);
+        }
+        auto frame = builder.build();
+        benchmark::DoNotOptimize(frame.atom_count());
+    }
+    report(state, 0, static_cast<int64_t>(n), rss);
+}
+BENCHMARK(BM_BuilderAddAtom)->Apply(builder_grid);
+
+void BM_BuilderFromArrays(benchmark::State &state) {
+    const size_t n = static_cast<size_t>(state.range(0));
+    const BuilderColumns cols(n);
+    const std::vector<std::string> symbols{"Cu"};
+    const std::vector<size_t> counts{n};
+    readcon::FrameArrays arrays;
+    arrays.positions = cols.pos;
+    arrays.masses = cols.masses;
+    PeakRss rss;
+    for (auto _ : state) {
+        readcon::ConFrameBuilder builder({50.0, 50.0, 50.0}, {90.0, 90.0, 90.0});
+        builder.set_atoms_from_arrays(symbols, counts, arrays);
+        auto frame = builder.build();
+        benchmark::DoNotOptimize(frame.atom_count());
+    }
+    report(state, 0, static_cast<int64_t>(n), rss);
+}
+BENCHMARK(BM_BuilderFromArrays)->Apply(builder_grid);
+
+} // namespace
+
+BENCHMARK_MAIN();
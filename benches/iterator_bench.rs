@@ -165,6 +165,59 @@ fn fast_float_microbench(c: &mut Criterion) {
         })
     });
 
+    // One 256-row coordinate block: bitmask block kernel vs the per-line path.
+    let block: String = (0..256)
+        .map(|i| format!("{:>12.6} {:>12.6} {:>12.6} {} {i}\n", i as f64 * 0.37, 1.5, -2.25, i % 2))
+        .collect();
+    group.bench_function(
+        format!("coordinate_block_256_{}", readcon_core::scan::active_kernel()),
+        |b| {
+            b.iter(|| {
+                let mut sum = 0.0;
+                let (_, r) = readcon_core::scan::decode_coordinate_rows(
+                    black_box(&block),
+                    256,
+                    0,
+                    |_, row| sum += row.0[0],
+                );
+                r.unwrap();
+                let _ = black_box(sum);
+            })
+        },
+    );
+    group.bench_function("coordinate_block_256_scalar_masks", |b| {
+        b.iter(|| {
+            let mut sum = 0.0;
+            let (_, r) = readcon_core::scan::decode_coordinate_rows_scalar(
+                black_box(&block),
+                256,
+                0,
+                |_, row| sum += row.0[0],
+            );
+            r.unwrap();
+            let _ = black_box(sum);
+        })
+    });
+    group.bench_function("coordinate_block_256_line_by_line", |b| {
+        b.iter(|| {
+            let defaults = [0.0f64; 5];
+            let mut buf = [0.0f64; 5];
+            let mut sum = 0.0;
+            for line in black_box(&block).lines() {
+                readcon_core::parser::parse_line_of_range_f64_stack(
+                    line,
+                    4,
+                    5,
+                    &defaults,
+                    &mut buf,
+                )
+                .unwrap();
+                sum += buf[0];
+            }
+            let _ = black_box(sum);
+        })
+    });
+
     group.bench_function("fast_float2_parse_5_vec", |b| {
         b.iter(|| {
             let vals = readcon_core::parser::parse_line_of_n_f64(black_box(line), 5).unwrap();
@@ -2,7 +2,8 @@
 //! Usage: cargo run --release --example cachegrind_harness [--features chemfiles] -- [scenario|all|list]
 
 use readcon_core::iterators::ConFrameIterator;
-use readcon_core::parser::{parse_line_of_n, parse_line_of_n_f64};
+use readcon_core::parser::{parse_line_of_n, parse_line_of_n_f64, parse_line_of_range_f64_stack};
+use readcon_core::scan::decode_coordinate_rows;
 use readcon_core::writer::ConFrameWriter;
 use std::env;
 use std::fs;
@@ -94,6 +95,33 @@ fn scenario_float_std() {
     }
 }
 
+fn coordinate_block() -> String {
+    let line = "  1.23456789012345  -9.87654321098765  0.00000000000001  1  42\n";
+    line.repeat(256)
+}
+
+fn scenario_coord_block_kernel() {
+    let block = coordinate_block();
+    for _ in 0..40 {
+        let (_, r) = decode_coordinate_rows(black_box(&block), 256, 0, |_, row| {
+            black_box(row);
+        });
+        r.unwrap();
+    }
+}
+
+fn scenario_coord_block_lines() {
+    let block = coordinate_block();
+    let defaults = [0.0f64; 5];
+    let mut buf = [0.0f64; 5];
+    for _ in 0..40 {
+        for line in black_box(&block).lines() {
+            parse_line_of_range_f64_stack(line, 4, 5, &defaults, &mut buf).unwrap();
+            black_box(buf);
+        }
+    }
+}
+
 fn scenario_write_100() {
     let large = gen_frames(100);
     let frames: Vec<_> = ConFrameIterator::new(&large)
@@ -152,6 +180,8 @@ fn core_scenarios() -> Vec<Scenario> {
         ("parse_cuh2_218", scenario_cuh2),
         ("float_fast_float2", scenario_float_fast),
         ("float_std_parse", scenario_float_std),
+        ("coord_block_kernel_256", scenario_coord_block_kernel),
+        ("coord_block_lines_256", scenario_coord_block_lines),
         ("write_100_frames", scenario_write_100),
     ]
 }
@@ -71,6 +71,12 @@ static int smoke_section_buffers(const readcon::ConFrame &frame) {
         std::cerr << "copy_positions failed: " << static_cast<int>(st) << "\n";
         return 1;
     }
+    // Zero-copy view of the same SoA storage.
+    const auto view = frame.positions();
+    if (view.size() != pos.size() || !std::equal(view.begin(), view.end(), pos.begin())) {
+        std::cerr << "positions() view disagrees with copy_positions\n";
+        return 1;
+    }
     std::vector<double> vel(n * 3);
     st = frame.copy_velocities(vel.data(), vel.size());
     if (st != RKR_STATUS_SUCCESS && st != RKR_STATUS_SECTION_ABSENT) {
@@ -94,6 +100,24 @@ static int smoke_section_buffers(const readcon::ConFrame &frame) {
     return 0;
 }
 
+// Batched trajectory tensors: every frame in one (F, N, 3) buffer.
+static int smoke_trajectory_tensors(const std::string &path, int frame_count) {
+    const auto batch = readcon::read_trajectory_tensors(path);
+    if (batch.frame_count() != static_cast<std::size_t>(frame_count)) {
+        std::cerr << "trajectory tensors: frame_count " << batch.frame_count()
+                  << " != " << frame_count << "\n";
+        return 1;
+    }
+    const auto pos = batch.positions();
+    if (pos.size() != batch.frame_count() * batch.atom_count() * 3) {
+        std::cerr << "trajectory tensors: positions length " << pos.size() << "\n";
+        return 1;
+    }
+    std::cout << "trajectory_tensors ok frames=" << batch.frame_count()
+              << " natoms=" << batch.atom_count() << "\n";
+    return 0;
+}
+
 int main(int argc, char *argv[]) {
     if (argc < 2 || argc > 3) {
         std::cerr << "Usage: " << argv[0] << " <input.con> [output.con]"
@@ -126,6 +150,10 @@ int main(int argc, char *argv[]) {
                 << "\n==================================================\n";
             std::cout << "Iteration complete. Total frames processed: "
                       << frame_count << std::endl;
+            if (frame_count > 0 &&
+                smoke_trajectory_tensors(input_filename, frame_count) != 0) {
+                return 2;
+            }
         }
         // --- Read and Write Mode ---
         else { // argc == 3
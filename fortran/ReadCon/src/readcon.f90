@@ -19,11 +19,12 @@ module readcon
   public :: mts_block_free_rkr
   public :: library_version, con_spec_version, has_chemfiles_support, status_message
   public :: symbol_to_z, z_to_symbol
-  public :: frame_t, iterator_t, builder_t, writer_t
+  public :: frame_t, iterator_t, builder_t, writer_t, trajectory_t
   public :: read_first_frame, read_all_frames, open_iterator, new_builder, open_writer
   public :: open_writer_gzip, open_writer_zstd
   public :: open_writer_gzip_with_precision, open_writer_zstd_with_precision
-  public :: read_chemfiles_first
+  public :: read_chemfiles_first, read_trajectory_tensors
+  public :: rkr_frames_end
 
   ! Mirror include/readcon-core.h RKRStatus (keep in sync with src/ffi.rs)
   integer(c_int), parameter :: rkr_status_success = 0
@@ -38,6 +39,8 @@ module readcon
   integer(c_int), parameter :: rkr_status_validation_error = -9
   integer(c_int), parameter :: rkr_status_selection_error = -10
   integer(c_int), parameter :: rkr_status_feature_disabled = -11
+  ! RKR_FRAMES_END (SIZE_MAX) as a stop index: read to the end of the file
+  integer(c_size_t), parameter :: rkr_frames_end = -1_c_size_t
 
   type, bind(C), public :: catom_t
     integer(c_int64_t) :: atomic_number = 0_c_int64_t
@@ -128,6 +131,11 @@ module readcon
     procedure :: copy_velocities => fr_copy_velocities
     procedure :: copy_forces => fr_copy_forces
     procedure :: copy_masses => fr_copy_masses
+    procedure :: positions_view => fr_positions_view
+    procedure :: velocities_view => fr_velocities_view
+    procedure :: forces_view => fr_forces_view
+    procedure :: masses_view => fr_masses_view
+    procedure :: atom_energies_view => fr_atom_energies_view
     procedure :: potential_type => fr_pot
     procedure :: frame_index => fr_fidx
     procedure :: sim_time => fr_time
@@ -150,6 +158,9 @@ module readcon
   contains
     procedure :: valid => it_valid
     procedure :: next => it_next
+    procedure :: skip => it_skip
+    procedure :: seek => it_seek
+    procedure :: position => it_position
     procedure :: free => it_free
   end type
 
@@ -160,6 +171,7 @@ module readcon
     procedure :: valid => bd_valid
     procedure :: free => bd_free
     procedure :: add_atom => bd_add_atom
+    procedure :: set_atoms_from_arrays => bd_set_atoms_from_arrays
     procedure :: set_energy => bd_set_energy
     procedure :: set_metadata_json => bd_set_meta
     procedure :: set_frame_index => bd_set_fidx
@@ -186,6 +198,20 @@ module readcon
     procedure :: is_canonical => wr_is_canonical
   end type
 
+  type :: trajectory_t
+    private
+    type(c_ptr) :: t = c_null_ptr
+  contains
+    procedure :: valid => tr_valid
+    procedure :: free => tr_free
+    procedure :: frame_count => tr_frame_count
+    procedure :: atom_count => tr_atom_count
+    procedure :: has_forces => tr_has_forces
+    procedure :: positions_view => tr_positions_view
+    procedure :: forces_view => tr_forces_view
+    procedure :: energies_view => tr_energies_view
+  end type
+
   interface
     function c_rkr_con_spec_version() bind(C, name="rkr_con_spec_version")
       import :: c_int32_t
@@ -397,6 +423,23 @@ module readcon
       type(c_ptr), value :: it
       type(c_ptr) :: c_con_frame_iterator_next
     end function
+    function c_con_frame_iterator_skip(it, n) bind(C, name="con_frame_iterator_skip")
+      import :: c_ptr, c_size_t
+      type(c_ptr), value :: it
+      integer(c_size_t), value :: n
+      integer(c_size_t) :: c_con_frame_iterator_skip
+    end function
+    function c_con_frame_iterator_seek(it, idx) bind(C, name="con_frame_iterator_seek")
+      import :: c_ptr, c_size_t, c_int
+      type(c_ptr), value :: it
+      integer(c_size_t), value :: idx
+      integer(c_int) :: c_con_frame_iterator_seek
+    end function
+    function c_con_frame_iterator_position(it) bind(C, name="con_frame_iterator_position")
+      import :: c_ptr, c_size_t
+      type(c_ptr), value :: it
+      integer(c_size_t) :: c_con_frame_iterator_position
+    end function
     subroutine c_free_con_frame_iterator(it) bind(C, name="free_con_frame_iterator")
       import :: c_ptr
       type(c_ptr), value :: it
@@ -467,6 +510,14 @@ module readcon
       logical(c_bool), value :: fx, fy, fz
       integer(c_int) :: c_rkr_frame_add_atom_with_fixed_mask
     end function
+    function c_rkr_frame_builder_set_atoms_from_arrays(b, n, pos, masses, run_syms, run_counts, &
+         n_runs, zs, fixed, ids, vel, frc, eng) bind(C, name="rkr_frame_builder_set_atoms_from_arrays")
+      import :: c_ptr, c_size_t, c_int
+      type(c_ptr), value :: b
+      integer(c_size_t), value :: n, n_runs
+      type(c_ptr), value :: pos, masses, run_syms, run_counts, zs, fixed, ids, vel, frc, eng
+      integer(c_int) :: c_rkr_frame_builder_set_atoms_from_arrays
+    end function
     function c_rkr_frame_builder_set_energy(b, e) bind(C, name="rkr_frame_builder_set_energy")
       import :: c_ptr, c_double, c_int
       type(c_ptr), value :: b
@@ -618,6 +669,78 @@ module readcon
       import :: c_ptr
       type(c_ptr), value :: s
     end subroutine
+    ! Borrowed SoA blocks (const double*, NULL when absent or not stored as f64)
+    function c_rkr_frame_positions_data(f) bind(C, name="rkr_frame_positions_data")
+      import :: c_ptr
+      type(c_ptr), value :: f
+      type(c_ptr) :: c_rkr_frame_positions_data
+    end function
+    function c_rkr_frame_velocities_data(f) bind(C, name="rkr_frame_velocities_data")
+      import :: c_ptr
+      type(c_ptr), value :: f
+      type(c_ptr) :: c_rkr_frame_velocities_data
+    end function
+    function c_rkr_frame_forces_data(f) bind(C, name="rkr_frame_forces_data")
+      import :: c_ptr
+      type(c_ptr), value :: f
+      type(c_ptr) :: c_rkr_frame_forces_data
+    end function
+    function c_rkr_frame_masses_data(f) bind(C, name="rkr_frame_masses_data")
+      import :: c_ptr
+      type(c_ptr), value :: f
+      type(c_ptr) :: c_rkr_frame_masses_data
+    end function
+    function c_rkr_frame_atom_energies_data(f) bind(C, name="rkr_frame_atom_energies_data")
+      import :: c_ptr
+      type(c_ptr), value :: f
+      type(c_ptr) :: c_rkr_frame_atom_energies_data
+    end function
+    function c_rkr_read_trajectory_tensors(fn, start, stop, step, dtype, out) &
+         bind(C, name="rkr_read_trajectory_tensors")
+      import :: c_ptr, c_char, c_size_t, c_int
+      character(kind=c_char), intent(in) :: fn(*)
+      integer(c_size_t), value :: start, stop, step
+      type(c_ptr), value :: dtype
+      type(c_ptr), intent(out) :: out
+      integer(c_int) :: c_rkr_read_trajectory_tensors
+    end function
+    subroutine c_free_rkr_trajectory_tensors(t) bind(C, name="free_rkr_trajectory_tensors")
+      import :: c_ptr
+      type(c_ptr), value :: t
+    end subroutine
+    function c_rkr_trajectory_tensors_frame_count(t) &
+         bind(C, name="rkr_trajectory_tensors_frame_count")
+      import :: c_ptr, c_size_t
+      type(c_ptr), value :: t
+      integer(c_size_t) :: c_rkr_trajectory_tensors_frame_count
+    end function
+    function c_rkr_trajectory_tensors_atom_count(t) &
+         bind(C, name="rkr_trajectory_tensors_atom_count")
+      import :: c_ptr, c_size_t
+      type(c_ptr), value :: t
+      integer(c_size_t) :: c_rkr_trajectory_tensors_atom_count
+    end function
+    function c_rkr_trajectory_tensors_has_forces(t) &
+         bind(C, name="rkr_trajectory_tensors_has_forces")
+      import :: c_ptr, c_bool
+      type(c_ptr), value :: t
+      logical(c_bool) :: c_rkr_trajectory_tensors_has_forces
+    end function
+    function c_rkr_trajectory_positions_data(t) bind(C, name="rkr_trajectory_positions_data")
+      import :: c_ptr
+      type(c_ptr), value :: t
+      type(c_ptr) :: c_rkr_trajectory_positions_data
+    end function
+    function c_rkr_trajectory_forces_data(t) bind(C, name="rkr_trajectory_forces_data")
+      import :: c_ptr
+      type(c_ptr), value :: t
+      type(c_ptr) :: c_rkr_trajectory_forces_data
+    end function
+    function c_rkr_trajectory_energies_data(t) bind(C, name="rkr_trajectory_energies_data")
+      import :: c_ptr
+      type(c_ptr), value :: t
+      type(c_ptr) :: c_rkr_trajectory_energies_data
+    end function
   end interface
 
 contains
@@ -1061,6 +1184,33 @@ contains
     fr%handle = c_con_frame_iterator_next(self%it)
   end function
 
+  integer function it_skip(self, n)
+    class(iterator_t), intent(inout) :: self
+    integer, intent(in) :: n
+    it_skip = 0
+    if (.not. c_associated(self%it) .or. n <= 0) return
+    it_skip = int(c_con_frame_iterator_skip(self%it, int(n, c_size_t)))
+  end function
+
+  integer function it_seek(self, idx0)
+    class(iterator_t), intent(inout) :: self
+    integer, intent(in) :: idx0
+    it_seek = rkr_status_null_pointer
+    if (.not. c_associated(self%it)) return
+    if (idx0 < 0) then
+      it_seek = rkr_status_index_out_of_bounds
+      return
+    end if
+    it_seek = int(c_con_frame_iterator_seek(self%it, int(idx0, c_size_t)))
+  end function
+
+  integer function it_position(self)
+    class(iterator_t), intent(in) :: self
+    it_position = 0
+    if (.not. c_associated(self%it)) return
+    it_position = int(c_con_frame_iterator_position(self%it))
+  end function
+
   subroutine it_free(self)
     class(iterator_t), intent(inout) :: self
     if (c_associated(self%it)) then
@@ -1106,6 +1256,76 @@ contains
          real(mass,c_double), logical(fixed_x,c_bool), logical(fixed_y,c_bool), logical(fixed_z,c_bool)))
   end function
 
+  ! Replace every atom in one C call. positions/velocities/forces are (3, n); species come
+  ! from symbols + counts (runs in atom order) or from atomic_numbers. fixed holds CON
+  ! column-4 bitmask values; absent fixed / atom_ids mean all free / 0..n-1.
+  integer function bd_set_atoms_from_arrays(self, positions, masses, symbols, counts, &
+       atomic_numbers, fixed, atom_ids, velocities, forces, energies) result(st)
+    class(builder_t), intent(inout) :: self
+    real(c_double), intent(in), contiguous, target :: positions(:,:), masses(:)
+    character(len=*), intent(in), optional :: symbols(:)
+    integer(int64), intent(in), optional :: counts(:)
+    integer(c_int64_t), intent(in), optional, contiguous, target :: atomic_numbers(:), atom_ids(:)
+    integer(c_int8_t), intent(in), optional, contiguous, target :: fixed(:)
+    real(c_double), intent(in), optional, contiguous, target :: velocities(:,:), forces(:,:)
+    real(c_double), intent(in), optional, contiguous, target :: energies(:)
+    character(kind=c_char), allocatable, target :: names(:)
+    type(c_ptr), allocatable, target :: name_ptrs(:)
+    integer(c_size_t), allocatable, target :: run_counts(:)
+    type(c_ptr) :: p_syms, p_counts, p_zs, p_fixed, p_ids, p_vel, p_frc, p_eng
+    integer :: k, j, at, w, n
+    logical :: sized
+    st = rkr_status_null_pointer
+    if (.not. c_associated(self%b)) return
+    ! The C side trusts n = size(masses) for every column; check shapes before crossing.
+    n = size(masses)
+    sized = size(positions, 1) == 3 .and. size(positions, 2) == n
+    if (present(atomic_numbers)) sized = sized .and. size(atomic_numbers) == n
+    if (present(fixed)) sized = sized .and. size(fixed) == n
+    if (present(atom_ids)) sized = sized .and. size(atom_ids) == n
+    if (present(velocities)) sized = sized .and. size(velocities) == 3 * n
+    if (present(forces)) sized = sized .and. size(forces) == 3 * n
+    if (present(energies)) sized = sized .and. size(energies) == n
+    if (.not. sized) then
+      st = rkr_status_index_out_of_bounds
+      return
+    end if
+    p_syms = c_null_ptr; p_counts = c_null_ptr; p_zs = c_null_ptr
+    allocate(run_counts(0))
+    if (present(symbols) .and. present(counts)) then
+      if (size(symbols) /= size(counts)) then
+        st = rkr_status_index_out_of_bounds
+        return
+      end if
+      w = len(symbols) + 1
+      allocate(names(w * size(symbols)), name_ptrs(size(symbols)))
+      names = c_null_char
+      run_counts = int(counts, c_size_t)
+      do k = 1, size(symbols)
+        at = (k - 1) * w
+        do j = 1, len_trim(symbols(k))
+          names(at + j) = symbols(k)(j:j)
+        end do
+        name_ptrs(k) = c_loc(names(at + 1))
+      end do
+      p_syms = c_loc(name_ptrs)
+      if (size(run_counts) > 0) p_counts = c_loc(run_counts)
+    else if (present(atomic_numbers)) then
+      p_zs = c_loc(atomic_numbers)
+    else
+      return
+    end if
+    p_fixed = c_null_ptr; p_ids = c_null_ptr; p_vel = c_null_ptr; p_frc = c_null_ptr; p_eng = c_null_ptr
+    if (present(fixed)) p_fixed = c_loc(fixed)
+    if (present(atom_ids)) p_ids = c_loc(atom_ids)
+    if (present(velocities)) p_vel = c_loc(velocities)
+    if (present(forces)) p_frc = c_loc(forces)
+    if (present(energies)) p_eng = c_loc(energies)
+    st = int(c_rkr_frame_builder_set_atoms_from_arrays(self%b, int(n, c_size_t), &
+         c_loc(positions), c_loc(masses), p_syms, p_counts, int(size(run_counts), c_size_t), &
+         p_zs, p_fixed, p_ids, p_vel, p_frc, p_eng))
+  end function
+
   integer function bd_set_energy(self, energy)
     class(builder_t), intent(inout) :: self
     real(real64), intent(in) :: energy
@@ -1529,5 +1749,158 @@ contains
     mass(1:n) = real(flat(1:n), real64)
   end function
 
+  ! Borrowed views: Fortran pointers aliasing the frame's own SoA buffers, no
+  ! copy or transpose (row-major (N, 3) in C is column-major (3, N) here).
+  ! They stay valid until fr%free(). SECTION_ABSENT also covers frames stored
+  ! narrower than f64; use copy_* for those.
+  integer function xyz_view(handle, p, view)
+    type(c_ptr), intent(in) :: handle, p
+    real(c_double), pointer, intent(out) :: view(:,:)
+    nullify(view)
+    xyz_view = rkr_status_null_pointer
+    if (.not. c_associated(handle)) return
+    xyz_view = rkr_status_section_absent
+    if (.not. c_associated(p)) return
+    call c_f_pointer(p, view, [3_c_size_t, c_rkr_frame_atom_count(handle)])
+    xyz_view = rkr_status_success
+  end function
+
+  integer function per_atom_view(handle, p, view)
+    type(c_ptr), intent(in) :: handle, p
+    real(c_double), pointer, intent(out) :: view(:)
+    nullify(view)
+    per_atom_view = rkr_status_null_pointer
+    if (.not. c_associated(handle)) return
+    per_atom_view = rkr_status_section_absent
+    if (.not. c_associated(p)) return
+    call c_f_pointer(p, view, [c_rkr_frame_atom_count(handle)])
+    per_atom_view = rkr_status_success
+  end function
+
+  integer function fr_positions_view(self, pos)
+    class(frame_t), intent(in) :: self
+    real(c_double), pointer, intent(out) :: pos(:,:)
+    fr_positions_view = xyz_view(self%handle, c_rkr_frame_positions_data(self%handle), pos)
+  end function
+
+  integer function fr_velocities_view(self, vel)
+    class(frame_t), intent(in) :: self
+    real(c_double), pointer, intent(out) :: vel(:,:)
+    fr_velocities_view = xyz_view(self%handle, c_rkr_frame_velocities_data(self%handle), vel)
+  end function
+
+  integer function fr_forces_view(self, frc)
+    class(frame_t), intent(in) :: self
+    real(c_double), pointer, intent(out) :: frc(:,:)
+    fr_forces_view = xyz_view(self%handle, c_rkr_frame_forces_data(self%handle), frc)
+  end function
+
+  integer function fr_masses_view(self, mass)
+    class(frame_t), intent(in) :: self
+    real(c_double), pointer, intent(out) :: mass(:)
+    fr_masses_view = per_atom_view(self%handle, c_rkr_frame_masses_data(self%handle), mass)
+  end function
+
+  integer function fr_atom_energies_view(self, eng)
+    class(frame_t), intent(in) :: self
+    real(c_double), pointer, intent(out) :: eng(:)
+    fr_atom_energies_view = per_atom_view(self%handle, &
+         c_rkr_frame_atom_energies_data(self%handle), eng)
+  end function
+
+  function read_trajectory_tensors(path, start0, stop0, step, status) result(tr)
+    ! Frames start0, start0 + step, ... before stop0 (0-based; default: all)
+    ! batched as float64 (F, N, 3) positions / forces and (F,) energies.
+    character(len=*), intent(in) :: path
+    integer, intent(in), optional :: start0, stop0, step
+    integer, intent(out), optional :: status
+    type(trajectory_t) :: tr
+    character(kind=c_char), allocatable :: c(:)
+    integer(c_size_t) :: a, b, s
+    integer :: st
+    a = 0_c_size_t
+    b = rkr_frames_end
+    s = 1_c_size_t
+    if (present(start0)) a = int(start0, c_size_t)
+    if (present(stop0)) b = int(stop0, c_size_t)
+    if (present(step)) s = int(step, c_size_t)
+    call to_c(path, c)
+    st = int(c_rkr_read_trajectory_tensors(c, a, b, s, c_null_ptr, tr%t))
+    if (st /= 0) tr%t = c_null_ptr
+    if (present(status)) status = st
+  end function
+
+  logical function tr_valid(self)
+    class(trajectory_t), intent(in) :: self
+    tr_valid = c_associated(self%t)
+  end function
+
+  subroutine tr_free(self)
+    class(trajectory_t), intent(inout) :: self
+    if (c_associated(self%t)) then
+      call c_free_rkr_trajectory_tensors(self%t)
+      self%t = c_null_ptr
+    end if
+  end subroutine
+
+  integer(c_size_t) function tr_frame_count(self)
+    class(trajectory_t), intent(in) :: self
+    tr_frame_count = 0_c_size_t
+    if (.not. c_associated(self%t)) return
+    tr_frame_count = c_rkr_trajectory_tensors_frame_count(self%t)
+  end function
+
+  integer(c_size_t) function tr_atom_count(self)
+    class(trajectory_t), intent(in) :: self
+    tr_atom_count = 0_c_size_t
+    if (.not. c_associated(self%t)) return
+    tr_atom_count = c_rkr_trajectory_tensors_atom_count(self%t)
+  end function
+
+  logical function tr_has_forces(self)
+    class(trajectory_t), intent(in) :: self
+    tr_has_forces = .false.
+    if (.not. c_associated(self%t)) return
+    tr_has_forces = logical(c_rkr_trajectory_tensors_has_forces(self%t))
+  end function
+
+  ! (3, N, F) views of the batch buffers, valid until tr%free()
+  integer function batch_xyz_view(self, p, view)
+    class(trajectory_t), intent(in) :: self
+    type(c_ptr), intent(in) :: p
+    real(c_double), pointer, intent(out) :: view(:,:,:)
+    nullify(view)
+    batch_xyz_view = rkr_status_null_pointer
+    if (.not. c_associated(self%t)) return
+    batch_xyz_view = rkr_status_section_absent
+    if (.not. c_associated(p)) return
+    call c_f_pointer(p, view, [3_c_size_t, self%atom_count(), self%frame_count()])
+    batch_xyz_view = rkr_status_success
+  end function
+
+  integer function tr_positions_view(self, pos)
+    class(trajectory_t), intent(in) :: self
+    real(c_double), pointer, intent(out) :: pos(:,:,:)
+    tr_positions_view = batch_xyz_view(self, c_rkr_trajectory_positions_data(self%t), pos)
+  end function
+
+  integer function tr_forces_view(self, frc)
+    class(trajectory_t), intent(in) :: self
+    real(c_double), pointer, intent(out) :: frc(:,:,:)
+    tr_forces_view = batch_xyz_view(self, c_rkr_trajectory_forces_data(self%t), frc)
+  end function
+
+  integer function tr_energies_view(self, eng)
+    class(trajectory_t), intent(in) :: self
+    real(c_double), pointer, intent(out) :: eng(:)
+    nullify(eng)
+    tr_energies_view = rkr_status_null_pointer
+    if (.not. c_associated(self%t)) return
+    tr_energies_view = rkr_status_section_absent
+    if (.not. c_associated(c_rkr_trajectory_energies_data(self%t))) return
+    call c_f_pointer(c_rkr_trajectory_energies_data(self%t), eng, [self%frame_count()])
+    tr_energies_view = rkr_status_success
+  end function
+
 
 end module readcon
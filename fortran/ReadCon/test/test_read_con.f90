@@ -56,6 +56,55 @@ program test_read_con
     if (st2 /= 0 .and. st2 /= -8) nfail = nfail + 1
     print *, "frame_copy_masses st=", st2
   end block
+  ! borrowed views alias the frame SoA buffers (no copy, no transpose)
+  block
+    real(real64), allocatable :: pbuf(:,:)
+    real(c_double), pointer :: pv(:,:), fv(:,:), mv(:)
+    integer :: st2
+    allocate(pbuf(3, int(fr%atom_count())))
+    st2 = fr%copy_positions(pbuf)
+    st2 = fr%positions_view(pv)
+    if (st2 /= 0 .or. .not. associated(pv)) then
+      nfail = nfail + 1
+    else if (any(shape(pv) /= shape(pbuf)) .or. any(pv /= pbuf)) then
+      nfail = nfail + 1
+    end if
+    st2 = fr%forces_view(fv)
+    if (st2 /= rkr_status_section_absent .or. associated(fv)) nfail = nfail + 1
+    st2 = fr%masses_view(mv)
+    if (st2 /= 0 .or. size(mv) /= size(pbuf, 2)) nfail = nfail + 1
+    print *, "frame_positions_view st=", st2, " shape=", shape(pv)
+  end block
+  block
+    type(trajectory_t) :: tr
+    real(c_double), pointer :: tp(:,:,:), tf(:,:,:), te(:)
+    type(frame_t) :: last
+    type(iterator_t) :: it
+    real(real64), allocatable :: pbuf(:,:)
+    integer :: st2, nf
+    tr = read_trajectory_tensors(trim(root) // "/resources/test/tiny_multi_cuh2.con", &
+         status=st2)
+    if (st2 /= 0 .or. .not. tr%valid()) then
+      nfail = nfail + 1
+    else
+      nf = int(tr%frame_count())
+      st2 = tr%positions_view(tp)
+      if (st2 /= 0 .or. size(tp, 3) /= nf .or. size(tp, 2) /= int(tr%atom_count())) &
+           nfail = nfail + 1
+      if (tr%forces_view(tf) /= rkr_status_section_absent) nfail = nfail + 1
+      if (tr%energies_view(te) /= 0 .or. size(te) /= nf) nfail = nfail + 1
+      it = open_iterator(trim(root) // "/resources/test/tiny_multi_cuh2.con")
+      st2 = it%seek(nf - 1)
+      last = it%next()
+      allocate(pbuf(3, int(last%atom_count())))
+      st2 = last%copy_positions(pbuf)
+      if (any(tp(:, :, nf) /= pbuf)) nfail = nfail + 1
+      print *, "trajectory_positions_view shape=", shape(tp)
+      call last%free()
+      call it%free()
+      call tr%free()
+    end if
+  end block
   block
     type(frame_t), allocatable :: allf(:)
     integer :: ia
@@ -101,9 +150,14 @@ program test_read_con
           if (int(fiter%atom_count()) < 1) nfail = nfail + 1
           call fiter%free()
         end do
-        call it%free()
         print *, "iterator frames=", nframes
         if (nframes /= 2) nfail = nfail + 1
+        if (it%seek(1) /= rkr_status_success) nfail = nfail + 1
+        if (it%position() /= 1) nfail = nfail + 1
+        if (it%seek(0) /= rkr_status_success) nfail = nfail + 1
+        if (it%skip(5) /= 2) nfail = nfail + 1
+        if (it%seek(2) /= rkr_status_index_out_of_bounds) nfail = nfail + 1
+        call it%free()
       end if
     end if
   end block
@@ -256,6 +310,47 @@ program test_read_con
     end if
   end block
 
+  ! Bulk builder: one call from (3, n) columns, species as runs or atomic numbers
+  block
+    type(builder_t) :: bd3
+    type(frame_t) :: frc
+    type(catom_t) :: a2, a3
+    real(c_double) :: p3(3, 3), m3(3), f3(3, 3)
+    integer(c_int8_t) :: fx3(3)
+    integer(c_int64_t) :: z3(3)
+    character(len=2) :: syms(2)
+    integer :: st6
+    cell = 10.0_real64; ang = 90.0_real64
+    p3 = reshape([0.0_c_double, 0.0_c_double, 0.0_c_double, 1.0_c_double, 0.0_c_double, &
+         0.0_c_double, 0.0_c_double, 1.0_c_double, 0.0_c_double], [3, 3])
+    m3 = [63.546_c_double, 63.546_c_double, 1.008_c_double]
+    f3 = 0.5_c_double
+    fx3 = [0_c_int8_t, 7_c_int8_t, 0_c_int8_t]
+    syms = [character(len=2) :: "Cu", "H"]
+    bd3 = new_builder(cell, ang)
+    st6 = bd3%set_atoms_from_arrays(p3, m3, symbols=syms, counts=[2_int64, 1_int64], &
+         fixed=fx3, forces=f3)
+    print *, "builder_set_atoms_from_arrays runs st=", st6
+    if (st6 /= 0) nfail = nfail + 1
+    frc = bd3%build()
+    if (.not. frc%valid() .or. frc%atom_count() /= 3 .or. .not. frc%has_forces()) nfail = nfail + 1
+    if (frc%valid()) then
+      a2 = frc%atom(2); a3 = frc%atom(3)
+      if (.not. a2%fixed_x .or. a3%fixed_x .or. a3%atomic_number /= 1_c_int64_t) nfail = nfail + 1
+      call frc%free()
+    end if
+    bd3 = new_builder(cell, ang)
+    z3 = [29_c_int64_t, 1_c_int64_t, 29_c_int64_t]
+    st6 = bd3%set_atoms_from_arrays(p3, m3, atomic_numbers=z3)
+    print *, "builder_set_atoms_from_arrays Z st=", st6
+    if (st6 /= 0) nfail = nfail + 1
+    st6 = bd3%set_atoms_from_arrays(p3(:, 1:2), m3, atomic_numbers=z3)
+    if (st6 /= rkr_status_index_out_of_bounds) nfail = nfail + 1
+    st6 = bd3%set_atoms_from_arrays(p3, m3, symbols=syms, counts=[1_int64, 1_int64])
+    if (st6 /= rkr_status_index_out_of_bounds) nfail = nfail + 1
+    call bd3%free()
+  end block
+
   ! Builder metadata / free / valid + plain/precision writers
   block
     type(builder_t) :: bd2
@@ -50,6 +50,8 @@ typedef struct DLManagedTensorVersioned RKRDLManagedTensorVersioned;
  * and include <metatensor.h>, or use the incomplete struct typedef below. */
 struct mts_block_t;
 typedef struct mts_block_t mts_block_t;
+struct mts_tensormap_t;
+typedef struct mts_tensormap_t mts_tensormap_t;
 
 
 #ifndef READCON_H
@@ -95,6 +97,49 @@ namespace readcon {
  */
 #define RKR_CON_SPEC_VERSION 3
 
+/**
+ * Column bits for [`con_frame_iterator_set_columns`] (mirror
+ * `crate::types::ColumnMask`). 0 selects header-only frames.
+ */
+#define RKR_COLUMN_POSITIONS (1 << 0)
+
+#define RKR_COLUMN_VELOCITIES (1 << 1)
+
+#define RKR_COLUMN_FORCES (1 << 2)
+
+#define RKR_COLUMN_ENERGIES (1 << 3)
+
+#define RKR_COLUMN_CHARGES (1 << 4)
+
+#define RKR_COLUMN_SPINS (1 << 5)
+
+#define RKR_COLUMN_MAGMOMS (1 << 6)
+
+/**
+ * Every column; the default for new iterators.
+ */
+#define RKR_COLUMNS_ALL ((1 << 7) - 1)
+
+/**
+ * `stop` for [`rkr_read_trajectory_tensors`]: read to the last frame.
+ */
+#define RKR_FRAMES_END SIZE_MAX
+
+/**
+ * `keys` for [`rkr_read_trajectory_metatensor`]: one block per quantity.
+ */
+#define RKR_MTS_KEYS_QUANTITY 0
+
+/**
+ * One positions block per species (atomic number).
+ */
+#define RKR_MTS_KEYS_SPECIES_POSITIONS 1
+
+/**
+ * One forces block per species (atomic number).
+ */
+#define RKR_MTS_KEYS_SPECIES_FORCES 2
+
 #define RKR_DL_INT 0
 
 #define RKR_DL_UINT 1
@@ -130,6 +175,33 @@ namespace readcon {
  */
 #define SECTIONS_MASK_ENERGIES (1 << 2)
 
+/**
+ * Stage indices into the `RKRStats` per-stage arrays (mirror
+ * `crate::stats::Stage`).
+ */
+#define RKR_STAGE_READ 0
+
+#define RKR_STAGE_DECOMPRESS 1
+
+#define RKR_STAGE_SCAN 2
+
+#define RKR_STAGE_HEADER 3
+
+#define RKR_STAGE_METADATA 4
+
+#define RKR_STAGE_COORDINATES 5
+
+#define RKR_STAGE_SECTIONS 6
+
+#define RKR_STAGE_ASSEMBLE 7
+
+#define RKR_STAGE_WRITE 8
+
+/**
+ * Length of the `RKRStats` per-stage arrays.
+ */
+#define RKR_STAGE_COUNT 9
+
 /**
  * Error codes for RKR functions.
  */
@@ -213,12 +285,55 @@ typedef struct ConFrameIterator ConFrameIterator;
  */
 typedef struct Dimension Dimension;
 
+/**
+ * Holds file contents either as an owned String or a memory-mapped region.
+ */
+typedef struct FileContents FileContents;
+
+/**
+ * Persisted frame offset index (`<file>.con.idx`).
+ */
+typedef struct FrameOffsetIndex FrameOffsetIndex;
+
+/**
+ * Decoder behind a [`read_con_file_iterator_parallel`] handle.
+ */
+typedef struct ParallelFrameIterator ParallelFrameIterator;
+
+/**
+ * Opaque handle to a [`crate::chemfiles_selection::CompiledSelection`].
+ */
+typedef struct RKRCompiledSelection RKRCompiledSelection;
+
+/**
+ * Opaque handle to a [`crate::follow::ConFrameFollower`].
+ */
+typedef struct RKRFollower RKRFollower;
+
+/**
+ * Opaque handle to a [`crate::prefetch::FramePrefetcher`].
+ */
+typedef struct RKRFramePrefetcher RKRFramePrefetcher;
+
+/**
+ * Streaming frame source behind a compressed-path [`CConFrameIterator`].
+ */
+typedef struct RKRFrameStream RKRFrameStream;
+
 /**
  * Opaque handle for a cached selection evaluation result.
  */
 typedef struct RKRSelectionResult RKRSelectionResult;
 
-typedef struct String String;
+/**
+ * Opaque handle for the frames accepted by [`rkr_query_frames`].
+ */
+typedef struct RKRQueryResult RKRQueryResult;
+
+/**
+ * Opaque handle to a frame range batched by [`rkr_read_trajectory_tensors`].
+ */
+typedef struct RKRTrajectoryTensors RKRTrajectoryTensors;
 
 /**
  * An opaque handle to a full, lossless Rust `ConFrame` object.
@@ -228,9 +343,35 @@ typedef struct RKRConFrame {
     uint8_t _private[0];
 } RKRConFrame;
 
+/**
+ * C iterator handle. Owns the backing [`FileContents`] (heap string or
+ * read-only mmap) and a `ConFrameIterator` borrowing it for `'static`.
+ *
+ * Path-backed iterators over uncompressed files keep the mapping instead of
+ * copying it, and release pages behind the cursor as frames are consumed,
+ * so resident memory stays bounded by one [`crate::compression::RELEASE_CHUNK`]
+ * window plus the frame being parsed.
+ *
+ * Compressed paths instead hold a [`RKRFrameStream`] (with `iterator` and
+ * `file_contents` NULL) that inflates one chunk at a time.
+ *
+ * `offset_index` is the file's fresh `.con.idx` sidecar when one existed at
+ * open time (NULL otherwise); [`con_frame_iterator_seek`] then jumps
+ * directly instead of skipping frame by frame.
+ */
 typedef struct CConFrameIterator {
     struct ConFrameIterator *iterator;
-    struct String *file_contents;
+    struct FileContents *file_contents;
+    /**
+     * Prefix of a mapped buffer already handed back to the kernel.
+     */
+    uintptr_t released;
+    struct RKRFrameStream *stream;
+    struct FrameOffsetIndex *offset_index;
+    /**
+     * Set instead of `iterator` by [`read_con_file_iterator_parallel`].
+     */
+    struct ParallelFrameIterator *parallel;
 } CConFrameIterator;
 
 /**
@@ -349,7 +490,7 @@ typedef struct RKRDLDevice {
  * `RKR_STATUS_VALIDATION_ERROR` until implemented.
  *
  * **Device:** `kDLCPU` always; with `--features cuda`, `kDLCUDA` performs H2D
- * into real device memory then exports DLPack. Other devices return
+ * into real device memory then exports DLPack (`kDLFloat` 64 / 32 / 16). Other devices return
  * `RKR_STATUS_FEATURE_DISABLED` so callers can feature-detect.
  */
 typedef struct RKRDlpackExportOptions {
@@ -363,6 +504,33 @@ typedef struct RKRDlpackExportOptions {
     struct RKRDLDevice device;
 } RKRDlpackExportOptions;
 
+/**
+ * Process-wide read / write counters filled by [`rkr_stats_get`]; see
+ * `crate::stats::Stats` for the meaning of each field.
+ */
+typedef struct RKRStats {
+    uint64_t stage_nanos[RKR_STAGE_COUNT];
+    uint64_t stage_calls[RKR_STAGE_COUNT];
+    uint64_t stage_bytes[RKR_STAGE_COUNT];
+    uint64_t frames_read;
+    uint64_t frames_written;
+    uint64_t buffers_allocated;
+    uint64_t buffers_reused;
+    uint64_t parallel_batches;
+    uint64_t parallel_wall_nanos;
+    uint64_t parallel_busy_nanos;
+    uint64_t parallel_capacity_nanos;
+} RKRStats;
+
+/**
+ * Per-frame callback for [`rkr_prefetch_for_each`]: the frame (borrowed,
+ * valid only during the call), its index in the file and the caller's
+ * `user_data`. Return `false` to stop early.
+ */
+typedef bool (*RKRFrameCallback)(const struct RKRConFrame *frame,
+                                 uintptr_t index,
+                                 void *user_data);
+
 #if !defined(READCON_CORE_HAS_METATENSOR)
 /**
  * Lean-build stubs: always export metatensor C symbols so Fortran/C can link without `#ifdef`.
@@ -373,6 +541,12 @@ typedef struct mts_block_t {
 } mts_block_t;
 #endif
 
+#if !defined(READCON_CORE_HAS_METATENSOR)
+typedef struct mts_tensormap_t {
+    uint8_t _private[0];
+} mts_tensormap_t;
+#endif
+
 
 
 
@@ -566,8 +740,16 @@ const char *rkr_status_message(enum RKRStatus status);
  * gzip (`.con.gz`) and zstd (`.con.zst`, requires `zstd` feature) inputs via
  * [`crate::compression::read_file_contents`].
  *
- * Returns NULL if the file cannot be read, decompressed, or is not valid
- * UTF-8. A successfully-opened file with zero frames returns a non-NULL
+ * Uncompressed files of 64 KiB or more are iterated directly over a
+ * read-only memory map (no heap copy); pages already parsed are released
+ * as the iterator advances. Compressed files are inflated incrementally
+ * (one frame plus one chunk resident), so decompression or UTF-8 errors
+ * past the first bytes surface as NULL from [`con_frame_iterator_next`].
+ * A fresh `<file>.idx` sidecar, if present, is loaded for
+ * [`con_frame_iterator_seek`].
+ *
+ * Returns NULL if the file cannot be opened, uses an unsupported
+ * compression, or an uncompressed file is not valid UTF-8. A successfully-opened file with zero frames returns a non-NULL
  * iterator that yields NULL on the first call to [`con_frame_iterator_next`].
  * The caller OWNS the returned pointer and MUST call [`free_con_frame_iterator`].
  *
@@ -577,6 +759,25 @@ const char *rkr_status_message(enum RKRStatus status);
  */
 struct CConFrameIterator *read_con_file_iterator(const char *filename_c);
 
+/**
+ * Like [`read_con_file_iterator`], but uncompressed files are decoded by a
+ * pipelined parallel parser on `num_threads` workers (0: the global Rayon
+ * pool). Frames still come back in file order from
+ * [`con_frame_iterator_next`]; a bounded window of frames is decoded ahead,
+ * so memory does not grow with the file. Skip, seek and position behave as
+ * for the sequential iterator.
+ *
+ * Compressed files are streamed sequentially, as by
+ * [`read_con_file_iterator`]. Builds without the `parallel` feature decode
+ * on the calling thread and ignore `num_threads`.
+ *
+ * # Safety
+ * filename_c must be a valid null-terminated string. The caller takes
+ * ownership of the returned iterator and MUST call [`free_con_frame_iterator`].
+ */
+struct CConFrameIterator *read_con_file_iterator_parallel(const char *filename_c,
+                                                          uintptr_t num_threads);
+
 /**
  * Iterate frames from an in-memory CON text buffer (null-terminated C string).
  *
@@ -608,6 +809,80 @@ struct CConFrameIterator *read_con_buffer_iterator(const uint8_t *data,
  */
 struct RKRConFrame *con_frame_iterator_next(struct CConFrameIterator *iterator);
 
+/**
+ * Recycling counterpart of [`con_frame_iterator_next`]: parses the next
+ * frame into `*frame`, reusing that handle's buffers (header strings, atom
+ * vector, SoA blocks, interned symbols) when the atom count and species are
+ * unchanged. If `*frame` is NULL a new handle is allocated and stored there.
+ *
+ * Returns true when `*frame` holds the next frame; false at end of input
+ * or on a malformed frame (the cases where `con_frame_iterator_next`
+ * returns NULL), leaving `*frame` owned by the caller either way. Free the
+ * handle with [`free_rkr_frame`] once, after the loop. Frames from a
+ * parallel iterator are decoded ahead, so they replace the handle's
+ * contents instead of refilling it.
+ *
+ * # Safety
+ * `iterator` must be valid; `frame` non-null, pointing at NULL or at a
+ * handle from this library that no other thread is using.
+ */
+bool con_frame_iterator_next_into(struct CConFrameIterator *iterator,
+                                  struct RKRConFrame **frame);
+
+/**
+ * Skips up to `n` frames without parsing their atom data and returns the
+ * number actually skipped (fewer than `n` at end of input or at a malformed
+ * frame). Use with [`con_frame_iterator_next`] for strided reads: next, then
+ * skip `step - 1`.
+ *
+ * # Safety
+ * iterator must be valid or null (returns 0).
+ */
+uintptr_t con_frame_iterator_skip(struct CConFrameIterator *iterator, uintptr_t n);
+
+/**
+ * Positions the iterator so the next [`con_frame_iterator_next`] returns
+ * frame `frame_index` (0-based). Backward seeks are allowed.
+ *
+ * O(1) when the file had a fresh `.con.idx` sidecar at open time (see
+ * [`rkr_write_offset_index`]); otherwise intervening frames are skipped
+ * without parsing, and compressed inputs are reopened to seek backward.
+ *
+ * Returns `RKR_STATUS_INDEX_OUT_OF_BOUNDS` when the input holds fewer than
+ * `frame_index + 1` frames (the iterator is then exhausted), and
+ * `RKR_STATUS_IO_ERROR` on a malformed frame before the target or a failed
+ * reopen.
+ *
+ * # Safety
+ * iterator must be valid or null.
+ */
+enum RKRStatus con_frame_iterator_seek(struct CConFrameIterator *iterator, uintptr_t frame_index);
+
+/**
+ * Index of the frame the next [`con_frame_iterator_next`] returns.
+ *
+ * # Safety
+ * iterator must be valid or null (returns 0).
+ */
+uintptr_t con_frame_iterator_position(const struct CConFrameIterator *iterator);
+
+/**
+ * Restricts the per-atom columns decoded by later
+ * [`con_frame_iterator_next`] calls to `columns`, a bitwise OR of
+ * `RKR_COLUMN_*` values (`RKR_COLUMNS_ALL` restores the full parse).
+ *
+ * Sections left out are skipped by line count without decoding their rows
+ * and are absent from the returned frames; any section bit implies
+ * `RKR_COLUMN_POSITIONS`. With `columns == 0` frames carry the header and
+ * metadata only (no atoms), e.g. for energy screening; such frames cannot
+ * be written back. Frames a parallel iterator already decoded ahead keep
+ * the previous projection.
+ *
+ * # Safety
+ * iterator must be valid or null.
+ */
+enum RKRStatus con_frame_iterator_set_columns(struct CConFrameIterator *iterator, uint32_t columns);
+
 /**
  * Frees the memory for an opaque `RKRConFrame` handle.
  *
@@ -749,6 +1024,22 @@ uint8_t rkr_writer_is_canonical(const struct RKRConFrameWriter *writer_handle);
 struct RKRConFrameWriter *create_writer_from_path_with_precision_c(const char *filename_c,
                                                                    uint8_t precision);
 
+/**
+ * Creates a writer whose `rkr_writer_extend` formats frames in parallel
+ * chunks and writes them in order. A `.gz` / `.zst` filename compresses
+ * each chunk as an independent gzip member / zstd frame on the worker, so
+ * compression scales with cores too; other names write plain text. A
+ * `.zst` output ends with a seek table, so `rkr_read_frame`-style random
+ * access inflates only the block holding the frame.
+ * Returns NULL on a bad path, on I/O failure, or for `.zst` when the
+ * library was built without zstd.
+ * The caller OWNS the returned pointer and MUST call `free_rkr_writer`.
+ *
+ * # Safety
+ * filename_c must be valid. The caller takes ownership of the returned writer.
+ */
+struct RKRConFrameWriter *create_writer_parallel_c(const char *filename_c, uint8_t precision);
+
 /**
  * Attaches a velocity vector to the most recently added atom on a builder.
  * No-op if no atom has been added yet.
@@ -913,6 +1204,38 @@ enum RKRStatus rkr_frame_builder_set_atom_energies_from_flat(struct RKRConFrameB
                                                              const double *energies,
                                                              uintptr_t len);
 
+/**
+ * Replaces every atom in the builder from flat columns in one call.
+ *
+ * Species come from `n_runs` symbol runs (`run_symbols[k]` repeated
+ * `run_counts[k]` times) or, when `run_symbols` is NULL, from one atomic
+ * number per atom in `atomic_numbers`. `positions` (and `velocities` /
+ * `forces` when non-NULL) hold `3 * n_atoms` row-major f64; `masses`,
+ * `fixed` (CON column-4 bitmask), `atom_ids` and `energies` hold `n_atoms`
+ * values. NULL `fixed` means all free, NULL `atom_ids` means `0..n_atoms`,
+ * and NULL `velocities` / `forces` / `energies` leave that section out.
+ * Run counts that do not sum to `n_atoms` return
+ * RKR_STATUS_INDEX_OUT_OF_BOUNDS; run counts whose sum overflows `size_t`,
+ * or an `n_atoms` whose `3 * n_atoms` f64 columns would overflow the
+ * address space, return RKR_STATUS_VALIDATION_ERROR.
+ * # Safety
+ * builder_handle must be valid; every non-NULL pointer must cover the
+ * lengths above, and each `run_symbols[k]` must be a NUL-terminated string.
+ */
+enum RKRStatus rkr_frame_builder_set_atoms_from_arrays(struct RKRConFrameBuilder *builder_handle,
+                                                       uintptr_t n_atoms,
+                                                       const double *positions,
+                                                       const double *masses,
+                                                       const char *const *run_symbols,
+                                                       const uintptr_t *run_counts,
+                                                       uintptr_t n_runs,
+                                                       const uint64_t *atomic_numbers,
+                                                       const uint8_t *fixed,
+                                                       const uint64_t *atom_ids,
+                                                       const double *velocities,
+                                                       const double *forces,
+                                                       const double *energies);
+
 /**
  * Reads the position of an existing atom into 3 contiguous f64 out values.
  * # Safety
@@ -1540,6 +1863,87 @@ struct RKRConFrameWriter *create_writer_zstd_with_precision_c(const char *filena
  */
 struct RKRConFrame *rkr_read_first_frame(const char *filename_c);
 
+/**
+ * Reads frame `index` (0-based) from a .con file.
+ * Uses a fresh `<file>.idx` sidecar (see [`rkr_write_offset_index`]) to seek
+ * straight to the frame; otherwise skips the preceding frames without
+ * parsing their atom data.
+ * The caller OWNS the returned handle and MUST call `free_rkr_frame`.
+ * Returns NULL on error or if `index` is past the last frame.
+ *
+ * # Safety
+ * filename_c must be valid. The caller takes ownership of the returned frame.
+ */
+struct RKRConFrame *rkr_read_frame(const char *filename_c, uintptr_t index);
+
+/**
+ * Builds the frame offset index for an uncompressed .con file and writes it
+ * to `<file>.idx`. Later [`rkr_read_frame`] calls (and `count_frames` in
+ * every binding) use it while the file's size and mtime are unchanged.
+ *
+ * Returns `RKR_STATUS_IO_ERROR` if the file cannot be read or parsed, is
+ * compressed, or the sidecar cannot be written.
+ *
+ * # Safety
+ * filename_c must be a valid null-terminated string or NULL.
+ */
+enum RKRStatus rkr_write_offset_index(const char *filename_c);
+
+/**
+ * Screens the .con file at `filename_c` with a frame query such as
+ * `energy < -40 && composition == 'Cu:2|H:2' && fmax < 0.05` (grammar in
+ * [`crate::query::FrameQuery::parse`]). Answered from a fresh `<file>.idx`
+ * sidecar without parsing frames when present, otherwise by a projected
+ * scan that decodes only the columns the predicates need.
+ *
+ * On success writes a result handle to `*out_result` (free with
+ * [`rkr_query_result_free`]). Returns `RKR_STATUS_VALIDATION_ERROR` for a
+ * malformed expression and `RKR_STATUS_IO_ERROR` if the file cannot be
+ * read or parsed; `*out_result` is untouched on error.
+ *
+ * # Safety
+ * All pointers must be non-null; strings must be null-terminated.
+ */
+enum RKRStatus rkr_query_frames(const char *filename_c,
+                                const char *expr_c,
+                                struct RKRQueryResult **out_result);
+
+/**
+ * Number of frames accepted by the query (0 for NULL).
+ *
+ * # Safety
+ * `result_handle` must be from [`rkr_query_frames`] or NULL.
+ */
+uint64_t rkr_query_result_len(const struct RKRQueryResult *result_handle);
+
+/**
+ * Copies the accepted frames, in file order: frame indices to `out_frames`
+ * and byte offset / length of each frame to `out_offsets` / `out_lens`.
+ * Any of the three arrays may be NULL to skip it. `*out_written` (if
+ * non-null) receives the hit count; returns `RKR_STATUS_BUFFER_TOO_SMALL`
+ * when `capacity` is less than that.
+ *
+ * Spans address the file bytes, or the decompressed text for a
+ * compressed input (which is never indexed).
+ *
+ * # Safety
+ * Non-null arrays must hold at least `capacity` elements.
+ */
+enum RKRStatus rkr_query_result_hits(const struct RKRQueryResult *result_handle,
+                                     uint64_t *out_frames,
+                                     uint64_t *out_offsets,
+                                     uint64_t *out_lens,
+                                     uint64_t capacity,
+                                     uint64_t *out_written);
+
+/**
+ * Frees a result from [`rkr_query_frames`]. Safe with NULL.
+ *
+ * # Safety
+ * `result_handle` must be from [`rkr_query_frames`] or NULL.
+ */
+void rkr_query_result_free(struct RKRQueryResult *result_handle);
+
 /**
  * Reads all frames from a .con file using mmap.
  * Returns an array of frame handles and sets `num_frames` to the count.
@@ -1606,6 +2010,37 @@ enum RKRStatus rkr_frame_metatensor_atom_energies_block(const struct RKRConFrame
                                                         struct mts_block_t **out_block);
 #endif
 
+#if defined(READCON_CORE_HAS_METATENSOR)
+/**
+ * Free an owned map from [`rkr_read_trajectory_metatensor`]. Prefer this
+ * or `mts_tensormap_free` (metatensor.h) — not both on the same pointer.
+ *
+ * # Safety
+ * `map` is NULL or an owning `mts_tensormap_t*` from this library.
+ */
+void rkr_mts_tensormap_free(struct mts_tensormap_t *map);
+#endif
+
+#if defined(READCON_CORE_HAS_METATENSOR)
+/**
+ * Frames `start, start + step, …` before `stop` (`RKR_FRAMES_END`: to the
+ * end) as one TensorMap with `(system, atom)` samples, keyed per
+ * `RKR_MTS_KEYS_*`. Frame-range rules and errors are those of
+ * [`rkr_read_trajectory_tensors`]; an unknown `keys` or forces requested
+ * from frames without them is `RKR_STATUS_VALIDATION_ERROR`. Caller frees
+ * with `rkr_mts_tensormap_free` / `mts_tensormap_free`.
+ *
+ * # Safety
+ * `filename_c` must be a valid null-terminated string; `out_map` non-null.
+ */
+enum RKRStatus rkr_read_trajectory_metatensor(const char *filename_c,
+                                              uintptr_t start,
+                                              uintptr_t stop,
+                                              uintptr_t step,
+                                              uint32_t keys,
+                                              struct mts_tensormap_t **out_map);
+#endif
+
 #if !defined(READCON_CORE_HAS_ZSTD)
 struct RKRConFrameWriter *create_writer_zstd_c(const char *_filename_c);
 #endif
@@ -1619,6 +2054,19 @@ struct RKRConFrameWriter *create_writer_zstd_with_precision_c(const char *_filen
 void rkr_mts_block_free(struct mts_block_t *_block);
 #endif
 
+#if !defined(READCON_CORE_HAS_METATENSOR)
+void rkr_mts_tensormap_free(struct mts_tensormap_t *_map);
+#endif
+
+#if !defined(READCON_CORE_HAS_METATENSOR)
+enum RKRStatus rkr_read_trajectory_metatensor(const char *_filename_c,
+                                              uintptr_t _start,
+                                              uintptr_t _stop,
+                                              uintptr_t _step,
+                                              uint32_t _keys,
+                                              struct mts_tensormap_t **out_map);
+#endif
+
 #if !defined(READCON_CORE_HAS_METATENSOR)
 enum RKRStatus rkr_frame_metatensor_positions_block(const struct RKRConFrame *_frame_handle,
                                                     struct mts_block_t **out_block);
@@ -1671,6 +2119,67 @@ enum RKRStatus rkr_frame_copy_atom_ids(const struct RKRConFrame *frame_handle,
                                        uint64_t *out,
                                        uintptr_t out_len);
 
+/**
+ * Borrow positions as a row-major `(N, 3)` f64 buffer, `N =
+ * rkr_frame_atom_count`. NULL for a null handle, a frame without atoms, or
+ * non-f64 storage.
+ *
+ * # Safety
+ * `frame_handle` must be valid or null; the pointer dies with the frame.
+ */
+const double *rkr_frame_positions_data(const struct RKRConFrame *frame_handle);
+
+/**
+ * Borrow velocities as `(N, 3)` f64; NULL when the section is absent.
+ *
+ * # Safety
+ * Same contract as rkr_frame_positions_data.
+ */
+const double *rkr_frame_velocities_data(const struct RKRConFrame *frame_handle);
+
+/**
+ * Borrow forces as `(N, 3)` f64; NULL when the section is absent.
+ *
+ * # Safety
+ * Same contract as rkr_frame_positions_data.
+ */
+const double *rkr_frame_forces_data(const struct RKRConFrame *frame_handle);
+
+/**
+ * Borrow per-atom masses as `(N,)` f64.
+ *
+ * # Safety
+ * Same contract as rkr_frame_positions_data.
+ */
+const double *rkr_frame_masses_data(const struct RKRConFrame *frame_handle);
+
+/**
+ * Borrow per-atom energies as `(N,)` f64; NULL when the section is absent.
+ *
+ * # Safety
+ * Same contract as rkr_frame_positions_data.
+ */
+const double *rkr_frame_atom_energies_data(const struct RKRConFrame *frame_handle);
+
+/**
+ * Borrow per-atom ids as `(N,)` u64.
+ *
+ * # Safety
+ * Same contract as rkr_frame_positions_data.
+ */
+const uint64_t *rkr_frame_atom_ids_data(const struct RKRConFrame *frame_handle);
+
+/**
+ * Copy the cell lengths and angles into `out_cell[3]` / `out_angles[3]`
+ * without building the `CFrame` AoS copy. Either output may be NULL.
+ *
+ * # Safety
+ * `frame_handle` must be valid; non-null outputs must hold 3 doubles.
+ */
+enum RKRStatus rkr_frame_get_cell(const struct RKRConFrame *frame_handle,
+                                  double *out_cell,
+                                  double *out_angles);
+
 /**
  * Metatensor-style: export positions as they are stored (CPU f64), with
  * explicit device request. Non-CPU → `FEATURE_DISABLED`. Prefer this over
@@ -1747,6 +2256,305 @@ enum RKRStatus rkr_frame_atom_energies_dlpack_ex(const struct RKRConFrame *frame
                                                  const struct RKRDlpackExportOptions *opts,
                                                  RKRDLManagedTensorVersioned **out_tensor);
 
+/**
+ * Reads frames `start, start + step, …` before `stop` (`RKR_FRAMES_END`:
+ * to the end) into one batch: positions and forces `(F, N, 3)` and total
+ * energies `(F,)` (NaN where a frame has none), each in a single buffer.
+ *
+ * `dtype` (NULL → float64) selects the element type of all three blocks:
+ * `RKR_DL_FLOAT` with 64, 32 or 16 bits. Every selected frame must have the
+ * atom count of the first; forces are batched when the first frame has a
+ * force section, and then every frame must.
+ *
+ * Returns `RKR_STATUS_VALIDATION_ERROR` for a bad dtype, zero `step` or a
+ * mismatched frame, `RKR_STATUS_IO_ERROR` if the file cannot be read or
+ * parsed. On success the caller owns `*out` and MUST call
+ * [`free_rkr_trajectory_tensors`].
+ *
+ * # Safety
+ * `filename_c` must be a valid null-terminated string; `out` non-null;
+ * `dtype` null or valid.
+ */
+enum RKRStatus rkr_read_trajectory_tensors(const char *filename_c,
+                                           size_t start,
+                                           size_t stop,
+                                           size_t step,
+                                           const struct RKRDLDataType *dtype,
+                                           RKRTrajectoryTensors **out);
+
+/**
+ * Frees a batch from [`rkr_read_trajectory_tensors`]. Tensors exported from
+ * it stay valid (they share the buffers). Safe with NULL.
+ *
+ * # Safety
+ * `handle` must be NULL or a handle not yet freed.
+ */
+void free_rkr_trajectory_tensors(RKRTrajectoryTensors *handle);
+
+/**
+ * Number of frames `F` in the batch (0 on NULL).
+ *
+ * # Safety
+ * `handle` must be valid or NULL.
+ */
+size_t rkr_trajectory_tensors_frame_count(const RKRTrajectoryTensors *handle);
+
+/**
+ * Atoms per frame `N` (0 on NULL).
+ *
+ * # Safety
+ * `handle` must be valid or NULL.
+ */
+size_t rkr_trajectory_tensors_atom_count(const RKRTrajectoryTensors *handle);
+
+/**
+ * Whether the batch carries a forces block.
+ *
+ * # Safety
+ * `handle` must be valid or NULL.
+ */
+bool rkr_trajectory_tensors_has_forces(const RKRTrajectoryTensors *handle);
+
+/**
+ * Export the whole `(F, N, 3)` positions block as one DLPack tensor in the
+ * batch dtype. `device` NULL → CPU, which shares the buffer (no copy);
+ * `RKR_DL_CUDA` (with `--features cuda`) copies it to the device in the same dtype.
+ * Free with [`rkr_dlpack_delete`].
+ *
+ * # Safety
+ * `handle` / `out_tensor` valid; `device` null or valid.
+ */
+enum RKRStatus rkr_trajectory_positions_dlpack(const RKRTrajectoryTensors *handle,
+                                               const struct RKRDLDevice *device,
+                                               RKRDLManagedTensorVersioned **out_tensor);
+
+/**
+ * Forces `(F, N, 3)` as one DLPack tensor, or `SECTION_ABSENT`; see
+ * [`rkr_trajectory_positions_dlpack`].
+ *
+ * # Safety
+ * `handle` / `out_tensor` valid; `device` null or valid.
+ */
+enum RKRStatus rkr_trajectory_forces_dlpack(const RKRTrajectoryTensors *handle,
+                                            const struct RKRDLDevice *device,
+                                            RKRDLManagedTensorVersioned **out_tensor);
+
+/**
+ * Total energies `(F,)` as one DLPack tensor; see
+ * [`rkr_trajectory_positions_dlpack`].
+ *
+ * # Safety
+ * `handle` / `out_tensor` valid; `device` null or valid.
+ */
+enum RKRStatus rkr_trajectory_energies_dlpack(const RKRTrajectoryTensors *handle,
+                                              const struct RKRDLDevice *device,
+                                              RKRDLManagedTensorVersioned **out_tensor);
+
+/**
+ * Copy positions as row-major `(F, N, 3)` doubles into `out`
+ * (`out_len >= 3 * F * N`), widening f32 / f16 batches.
+ *
+ * # Safety
+ * `handle` valid; `out` must hold `out_len` doubles.
+ */
+enum RKRStatus rkr_trajectory_copy_positions(const RKRTrajectoryTensors *handle,
+                                             double *out,
+                                             size_t out_len);
+
+/**
+ * Copy forces like [`rkr_trajectory_copy_positions`], or `SECTION_ABSENT`.
+ *
+ * # Safety
+ * `handle` valid; `out` must hold `out_len` doubles.
+ */
+enum RKRStatus rkr_trajectory_copy_forces(const RKRTrajectoryTensors *handle,
+                                          double *out,
+                                          size_t out_len);
+
+/**
+ * Copy the `(F,)` total energies into `out` (`out_len >= F`).
+ *
+ * # Safety
+ * `handle` valid; `out` must hold `out_len` doubles.
+ */
+enum RKRStatus rkr_trajectory_copy_energies(const RKRTrajectoryTensors *handle,
+                                            double *out,
+                                            size_t out_len);
+
+/**
+ * Borrow positions as a row-major `(F, N, 3)` f64 buffer, valid while the
+ * batch handle is alive. NULL for a null handle, an empty batch, or an
+ * f32 / f16 batch.
+ *
+ * # Safety
+ * `handle` must be valid or null; the pointer dies with the batch.
+ */
+const double *rkr_trajectory_positions_data(const RKRTrajectoryTensors *handle);
+
+/**
+ * Borrow forces `(F, N, 3)`; NULL also when the batch has no forces.
+ *
+ * # Safety
+ * Same contract as rkr_trajectory_positions_data.
+ */
+const double *rkr_trajectory_forces_data(const RKRTrajectoryTensors *handle);
+
+/**
+ * Borrow the `(F,)` total energies.
+ *
+ * # Safety
+ * Same contract as rkr_trajectory_positions_data.
+ */
+const double *rkr_trajectory_energies_data(const RKRTrajectoryTensors *handle);
+
+
+/**
+ * Opens `filename_c`, a plain `.con` / `.convel` file another process may
+ * still be appending to, for following from byte `offset` (0: the start,
+ * otherwise a value from [`rkr_follower_byte_offset`]). `frames_before` is
+ * the index reported for the first frame read.
+ *
+ * Returns `RKR_STATUS_IO_ERROR` if the file cannot be opened, is compressed,
+ * or is shorter than `offset`. On success the caller owns `*out` and MUST
+ * call [`free_rkr_follower`].
+ *
+ * # Safety
+ * `filename_c` must be a valid null-terminated string; `out` non-null.
+ */
+enum RKRStatus rkr_follower_open(const char *filename_c,
+                                 uint64_t offset,
+                                 uintptr_t frames_before,
+                                 RKRFollower **out);
+
+/**
+ * Returns the next complete frame in `*out_frame`, waiting up to
+ * `timeout_ms` milliseconds for the writer to finish it (0: check once).
+ *
+ * `RKR_STATUS_SUCCESS` with `*out_frame == NULL` means "no complete frame
+ * yet": the file ends inside a frame, or exactly at the end of one whose
+ * sections are not declared. Call again later. Otherwise the caller owns
+ * `*out_frame` and must free it with [`free_rkr_frame`].
+ *
+ * Returns `RKR_STATUS_IO_ERROR` if the file shrank or is not valid UTF-8,
+ * and `RKR_STATUS_VALIDATION_ERROR` for a malformed frame (which is
+ * consumed, so the next call moves on).
+ *
+ * # Safety
+ * `follower` must be valid; `out_frame` non-null.
+ */
+enum RKRStatus rkr_follower_next(RKRFollower *follower,
+                                 uint64_t timeout_ms,
+                                 struct RKRConFrame **out_frame);
+
+/**
+ * File offset just past the last frame returned (0 on NULL). Pass it to
+ * [`rkr_follower_open`] to resume later.
+ *
+ * # Safety
+ * `follower` must be valid or NULL.
+ */
+uint64_t rkr_follower_byte_offset(RKRFollower *follower);
+
+/**
+ * Index of the frame the next successful [`rkr_follower_next`] returns
+ * (0 on NULL).
+ *
+ * # Safety
+ * `follower` must be valid or NULL.
+ */
+uintptr_t rkr_follower_position(RKRFollower *follower);
+
+/**
+ * Decodes only `columns` in later reads, as [`con_frame_iterator_set_columns`].
+ *
+ * # Safety
+ * `follower` must be valid or NULL.
+ */
+enum RKRStatus rkr_follower_set_columns(RKRFollower *follower, uint32_t columns);
+
+/**
+ * Frees a follower from [`rkr_follower_open`]. Safe with NULL.
+ *
+ * # Safety
+ * `follower` must be NULL or a handle not yet freed.
+ */
+void free_rkr_follower(RKRFollower *follower);
+
+/**
+ * Opens `filename_c` and starts parsing frames `start, start + step, …`
+ * before `stop` (`RKR_FRAMES_END`: to the end) on a background thread, at
+ * most `depth` frames ahead (0: 16), decoding only `columns`
+ * (`RKR_COLUMN_*`). Frame boundaries come from a fresh `.con.idx` sidecar
+ * or one skip scan; gzip / zstd inputs are inflated in memory first.
+ *
+ * Returns `RKR_STATUS_VALIDATION_ERROR` for a zero `step` and
+ * `RKR_STATUS_IO_ERROR` if the file cannot be read. On success the caller
+ * owns `*out` and MUST call [`free_rkr_prefetcher`].
+ *
+ * # Safety
+ * `filename_c` must be a valid null-terminated string; `out` non-null.
+ */
+enum RKRStatus rkr_prefetcher_open(const char *filename_c,
+                                   uintptr_t start,
+                                   uintptr_t stop,
+                                   uintptr_t step,
+                                   uintptr_t depth,
+                                   uint32_t columns,
+                                   RKRFramePrefetcher **out);
+
+/**
+ * Waits for the next prefetched frame and stores it in `*frame`, with its
+ * index in the file in `*out_index`. A handle already in `*frame` is
+ * handed back to the worker, which parses a later frame into its buffers,
+ * and then holds the new frame; if `*frame` is NULL a handle is allocated.
+ * Free the handle with [`free_rkr_frame`] once, after the loop.
+ *
+ * Once every frame has been delivered, returns `RKR_STATUS_SUCCESS` with
+ * `*out_index == RKR_FRAMES_END` and `*frame` untouched. A malformed
+ * frame returns `RKR_STATUS_IO_ERROR` (with its index; `*frame` untouched)
+ * and the next call moves on.
+ *
+ * # Safety
+ * `prefetcher` must be valid; `frame` and `out_index` non-null, `*frame`
+ * NULL or a handle from this library that no other thread is using.
+ */
+enum RKRStatus rkr_prefetcher_next(RKRFramePrefetcher *prefetcher,
+                                   struct RKRConFrame **frame,
+                                   uintptr_t *out_index);
+
+/**
+ * Frees a prefetcher from [`rkr_prefetcher_open`], stopping its worker.
+ * Frames already returned stay valid. Safe with NULL.
+ *
+ * # Safety
+ * `prefetcher` must be NULL or a handle not yet freed.
+ */
+void free_rkr_prefetcher(RKRFramePrefetcher *prefetcher);
+
+/**
+ * Calls `callback` on the frames [`rkr_prefetcher_open`] would select, in
+ * order, on the calling thread, while a background thread parses ahead;
+ * the plain-C counterpart of `readcon::ConFramePrefetcher`. The frame
+ * passed to the callback is recycled afterwards: copy out what should
+ * outlive it.
+ *
+ * Returns `RKR_STATUS_SUCCESS` after the last frame or when the callback
+ * returns false, `RKR_STATUS_VALIDATION_ERROR` for a zero `step`, and
+ * `RKR_STATUS_IO_ERROR` if the file cannot be read or a frame is
+ * malformed (frames before it have been delivered).
+ *
+ * # Safety
+ * `filename_c` must be a valid null-terminated string; `callback` must
+ * be safe to call with `user_data`.
+ */
+enum RKRStatus rkr_prefetch_for_each(const char *filename_c,
+                                     uintptr_t start,
+                                     uintptr_t stop,
+                                     uintptr_t step,
+                                     uintptr_t depth,
+                                     uint32_t columns,
+                                     RKRFrameCallback callback,
+                                     void *user_data);
 /**
  * Evaluate a chemfiles selection-language string on an `RKRConFrame`.
  *
@@ -1811,6 +2619,67 @@ enum RKRStatus rkr_selection_result_primary_indices(const struct RKRSelectionRes
  */
 void rkr_selection_result_free(struct RKRSelectionResult *result_handle);
 
+/**
+ * Parse `selection` once for repeated evaluation.
+ *
+ * On success writes a handle to `*out_selection` (caller frees with
+ * [`rkr_compiled_selection_free`]). Returns `RKR_STATUS_SELECTION_ERROR` for
+ * invalid grammar or without the `chemfiles` feature.
+ *
+ * # Safety
+ * `selection` must be a valid NUL-terminated UTF-8 string; `out_selection`
+ * must be non-null.
+ */
+enum RKRStatus rkr_selection_compile(const char *selection,
+                                     RKRCompiledSelection **out_selection);
+
+/**
+ * Context size of a compiled selection (1=atom … 4=dihedral; 0 for NULL).
+ *
+ * # Safety
+ * `compiled` must be valid or NULL.
+ */
+uint32_t rkr_compiled_selection_context_size(const RKRCompiledSelection *compiled);
+
+/**
+ * Evaluate a compiled selection on one frame.
+ *
+ * Consecutive calls on frames with the same topology (atom count, symbols,
+ * chemfiles name / type sidecars, bonds) update the handle's chemfiles frame
+ * in place instead of rebuilding it. The result is read and freed like one
+ * from [`rkr_frame_select`].
+ *
+ * # Safety
+ * All pointers must be non-null and valid; one thread at a time per handle.
+ */
+enum RKRStatus rkr_compiled_selection_evaluate(RKRCompiledSelection *compiled,
+                                               const struct RKRConFrame *frame_handle,
+                                               struct RKRSelectionResult **out_result);
+
+/**
+ * Evaluate a compiled selection on `n_frames` frames (in parallel when the
+ * library is built with `parallel`).
+ *
+ * On success `out_results[i]` receives the result for `frames[i]`; free
+ * each with [`rkr_selection_result_free`]. On error nothing is written.
+ *
+ * # Safety
+ * `frames` and `out_results` must each hold `n_frames` entries; every frame
+ * handle must be valid and not mutated during the call.
+ */
+enum RKRStatus rkr_compiled_selection_evaluate_frames(const RKRCompiledSelection *compiled,
+                                                      const struct RKRConFrame *const *frames,
+                                                      uintptr_t n_frames,
+                                                      struct RKRSelectionResult **out_results);
+
+/**
+ * Free a compiled selection. Safe with NULL.
+ *
+ * # Safety
+ * `compiled` must be from [`rkr_selection_compile`] or NULL.
+ */
+void rkr_compiled_selection_free(RKRCompiledSelection *compiled);
+
 /**
  * Returns 1 when this library build includes chemfiles selection support.
  */
@@ -1845,6 +2714,20 @@ struct RKRConFrame **rkr_read_chemfiles_memory(const char *data_c,
  */
 void rkr_dlpack_delete(RKRDLManagedTensorVersioned *tensor);
 
+/**
+ * Copy the current counters into `*out`. Without the `stats` feature
+ * `*out` is zeroed and `RKR_STATUS_FEATURE_DISABLED` is returned.
+ *
+ * # Safety
+ * `out` must be NULL or point to writable `RKRStats` storage.
+ */
+enum RKRStatus rkr_stats_get(struct RKRStats *out);
+
+/**
+ * Zero the counters. `RKR_STATUS_FEATURE_DISABLED` without `stats`.
+ */
+enum RKRStatus rkr_stats_reset(void);
+
 #ifdef __cplusplus
 }  // extern "C"
 #endif  // __cplusplus
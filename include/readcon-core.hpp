@@ -12,6 +12,7 @@
 
 #include <algorithm>
 #include <array>
+#include <chrono>
 #include <cmath>
 #include <cstdint>
 #include <filesystem>
@@ -21,12 +22,58 @@
 #include <stdexcept>
 #include <string>
 #include <string_view>
+#include <type_traits>
 #include <vector>
 
+#if __cplusplus >= 202002L && defined(__has_include)
+#if __has_include(<span>)
+#include <span>
+#define READCON_CORE_HAS_STD_SPAN 1
+#endif
+#endif
+
 #include "readcon-core.h"
 
 namespace readcon {
 
+#if defined(READCON_CORE_HAS_STD_SPAN)
+/// Contiguous view type returned by the zero-copy accessors (`std::span`).
+template <class T> using span = std::span<T>;
+#else
+/**
+ * @brief Minimal C++17 stand-in for `std::span` (pointer + length).
+ *
+ * Used by the zero-copy accessors when `<span>` is unavailable; under
+ * C++20 `readcon::span` is `std::span` itself.
+ */
+template <class T> class span {
+  public:
+    using element_type = T;
+    using iterator = T *;
+
+    constexpr span() noexcept = default;
+    constexpr span(T *data, std::size_t size) noexcept
+        : data_(data), size_(size) {}
+    /// Views a contiguous container (`std::vector`, `std::array`, ...).
+    template <class Container,
+              class = std::enable_if_t<
+                  !std::is_same_v<std::decay_t<Container>, span> &&
+                  std::is_convertible_v<decltype(std::declval<Container &>().data()), T *>>>
+    constexpr span(Container &&c) noexcept : data_(c.data()), size_(c.size()) {}
+
+    constexpr T *data() const noexcept { return data_; }
+    constexpr std::size_t size() const noexcept { return size_; }
+    constexpr bool empty() const noexcept { return size_ == 0; }
+    constexpr T &operator[](std::size_t i) const { return data_[i]; }
+    constexpr iterator begin() const noexcept { return data_; }
+    constexpr iterator end() const noexcept { return data_ + size_; }
+
+  private:
+    T *data_ = nullptr;
+    std::size_t size_ = 0;
+};
+#endif
+
 /**
  * @brief C++ representation of a single atom's core data.
  *
@@ -121,6 +168,9 @@ class ConFrame;
 class ConFrameWriter;
 class ConFrameBuilder;
 class SelectionResult;
+class TrajectoryTensors;
+class ConFrameFollower;
+class ConFramePrefetcher;
 
 /**
  * @brief Optional frame topology bond (`metadata["bonds"]` entry).
@@ -146,9 +196,16 @@ struct Bond {
  * for (auto&& frame : frames) { // Use && to allow moving
  * // use frame
  * }
+ *
+ * The current frame is refilled in place on each increment
+ * (con_frame_iterator_next_into), so a reference to `*it` sees the next
+ * frame after `++it`; `std::move(*it)` keeps a frame across increments.
  */
 class ConFrameIterator {
   public:
+    /** @brief "Until the end" sentinel for slice() `stop`. */
+    static constexpr size_t npos = static_cast<size_t>(-1);
+
     /**
      * @brief The nested iterator class that conforms to C++ iterator concepts.
      */
@@ -175,18 +232,58 @@ class ConFrameIterator {
 
       private:
         friend class ConFrameIterator;
-        explicit Iterator(CConFrameIterator *iterator_ptr);
+        explicit Iterator(CConFrameIterator *iterator_ptr, size_t stop = npos,
+                          size_t step = 1);
         void fetch_next_frame();
         CConFrameIterator *iterator_ptr_ = nullptr;
         std::unique_ptr<ConFrame> current_frame_;
+        size_t stop_ = npos;
+        size_t step_ = 1;
+    };
+
+    /**
+     * @brief Strided frame range returned by slice(); single-pass.
+     */
+    class Range {
+      public:
+        /** @brief Seeks to `start` and yields the first selected frame. */
+        Iterator begin();
+        Iterator end();
+
+      private:
+        friend class ConFrameIterator;
+        Range(CConFrameIterator *iterator_ptr, size_t start, size_t stop,
+              size_t step)
+            : iterator_ptr_(iterator_ptr), start_(start), stop_(stop),
+              step_(step) {}
+        CConFrameIterator *iterator_ptr_;
+        size_t start_;
+        size_t stop_;
+        size_t step_;
     };
 
     /**
      * @brief Constructs a frame iterator from a file path.
+     *
+     * Large uncompressed files are iterated over a read-only memory map
+     * without a heap copy; pages behind the cursor are released as frames
+     * are consumed. `.con.gz` / `.con.zst` inputs are inflated incrementally,
+     * so only the current frame is resident.
      * @param path The path to the .con file.
      * @throws std::runtime_error if the file cannot be opened.
      */
     explicit ConFrameIterator(const std::filesystem::path &path);
+    /**
+     * @brief Opens a file for iteration with a pipelined parallel decoder.
+     *
+     * Frames are still yielded in file order; a bounded window is decoded
+     * ahead on `num_threads` workers (0 uses the global Rayon pool).
+     * Compressed inputs are streamed sequentially.
+     * @param path The path to the .con file.
+     * @param num_threads Decoder worker count.
+     * @throws std::runtime_error if the file cannot be opened.
+     */
+    ConFrameIterator(const std::filesystem::path &path, size_t num_threads);
     /**
      * @brief Returns an iterator to the beginning of the sequence of frames.
      */
@@ -196,6 +293,36 @@ class ConFrameIterator {
      */
     Iterator end();
 
+    /**
+     * @brief Skips up to `n` frames without parsing their atoms.
+     * @return Frames actually skipped (fewer than `n` at end of input).
+     */
+    size_t skip(size_t n);
+    /**
+     * @brief Makes frame `frame_index` (0-based) the next one read.
+     *
+     * O(1) with a fresh `.con.idx` sidecar (see write_offset_index()),
+     * otherwise a skip walk. Backward seeks are allowed.
+     * @throws std::runtime_error if the file has no such frame.
+     */
+    void seek(size_t frame_index);
+    /** @brief Index of the frame the next read returns. */
+    size_t position() const;
+    /**
+     * @brief Decodes only `columns` (bitwise OR of `RKR_COLUMN_*`) in later
+     * reads; skipped sections are absent from the frames. `0` yields
+     * header-only frames, `RKR_COLUMNS_ALL` restores the full parse.
+     */
+    void set_columns(uint32_t columns);
+    /**
+     * @brief Frames `start, start + step, ...` before `stop`, like Python's
+     * `frames[start:stop:step]`; unselected frames are never parsed.
+     *
+     * Iterating the range advances this iterator.
+     * @throws std::invalid_argument if `step` is zero.
+     */
+    Range slice(size_t start, size_t stop = npos, size_t step = 1);
+
   private:
     // Custom deleter for the CConFrameIterator to call the C free function.
     struct IteratorDeleter {
@@ -221,7 +348,10 @@ class ConFrame {
     friend class ConFrameIterator::Iterator;
     friend class ConFrameWriter;
     friend class ConFrameBuilder;
+    friend class ConFrameFollower;
+    friend class ConFramePrefetcher;
     friend ConFrame read_first_frame(const std::filesystem::path &);
+    friend ConFrame read_frame(const std::filesystem::path &, size_t);
     friend std::vector<ConFrame> read_all_frames(const std::filesystem::path &);
 
     ConFrame(const ConFrame &) = delete;
@@ -321,6 +451,34 @@ class ConFrame {
     std::vector<size_t> select_atom_indices(std::string_view selection) const;
 
 
+    /**
+     * @name Zero-copy SoA views
+     *
+     * Borrow the frame's own storage without materializing the CFrame /
+     * `Atom` cache. `positions()`, `velocities()` and `forces()` are
+     * row-major xyz (`3 * atom_count()` values); `masses()` and
+     * `atom_ids()` hold one value per atom. A view is empty when the
+     * section is absent or stored in a non-f64 dtype (use the `copy_*`
+     * methods then). Views stay valid while this frame is alive.
+     * @{
+     */
+    span<const double> positions() const {
+        return block_view(rkr_frame_positions_data(frame_handle_.get()), 3);
+    }
+    span<const double> velocities() const {
+        return block_view(rkr_frame_velocities_data(frame_handle_.get()), 3);
+    }
+    span<const double> forces() const {
+        return block_view(rkr_frame_forces_data(frame_handle_.get()), 3);
+    }
+    span<const double> masses() const {
+        return block_view(rkr_frame_masses_data(frame_handle_.get()), 1);
+    }
+    span<const uint64_t> atom_ids() const {
+        return block_view(rkr_frame_atom_ids_data(frame_handle_.get()), 1);
+    }
+    /** @} */
+
     /**
      * Atom count without materializing CFrame / AoS atoms cache.
      */
@@ -422,9 +580,27 @@ class ConFrame {
     explicit ConFrame(RKRConFrame *frame_handle);
     std::unique_ptr<RKRConFrame, FrameDeleter> frame_handle_;
 
+    template <class T>
+    span<const T> block_view(const T *data, std::size_t width) const {
+        return data ? span<const T>(data, width * atom_count()) : span<const T>();
+    }
+
     // --- Caching Implementation ---
+    // cell/angles and the header lines are fetched on their own, so
+    // cell() / prebox_header() never force the `Atom` cache.
     void cache_data() const;
+    void cache_cell() const;
+    void cache_headers() const;
+    // Overwrite this frame with the next one from `iterator`, reusing the
+    // handle's buffers; false (handle unchanged) at the end or on error.
+    bool refill_from(CConFrameIterator *iterator);
+    // Same for the next frame of `prefetcher` (its index in `index`); the
+    // old buffers go back to the worker. Throws on a malformed frame.
+    bool refill_from(RKRFramePrefetcher *prefetcher, size_t &index);
+    void invalidate_caches();
     mutable bool is_cached_ = false;
+    mutable bool cell_cached_ = false;
+    mutable bool headers_cached_ = false;
     mutable std::vector<Atom> atoms_cache_;
     mutable std::array<double, 3> cell_cache_;
     mutable std::array<double, 3> angles_cache_;
@@ -516,6 +692,245 @@ class SelectionResult {
 
 inline bool has_chemfiles_support() { return rkr_has_chemfiles_support() != 0; }
 
+/**
+ * @brief RAII batch from read_trajectory_tensors(): positions and forces
+ *        `(F, N, 3)` and total energies `(F,)`, each one contiguous buffer.
+ *
+ * DLPack exports share the batch buffers (CPU) and stay valid after the
+ * batch is destroyed; free them with `rkr_dlpack_delete`.
+ */
+class TrajectoryTensors {
+  public:
+    TrajectoryTensors(const TrajectoryTensors &) = delete;
+    TrajectoryTensors &operator=(const TrajectoryTensors &) = delete;
+    TrajectoryTensors(TrajectoryTensors &&) = default;
+    TrajectoryTensors &operator=(TrajectoryTensors &&) = default;
+
+    explicit TrajectoryTensors(RKRTrajectoryTensors *handle) : handle_(handle) {}
+
+    size_t frame_count() const { return rkr_trajectory_tensors_frame_count(handle_.get()); }
+    size_t atom_count() const { return rkr_trajectory_tensors_atom_count(handle_.get()); }
+    bool has_forces() const { return rkr_trajectory_tensors_has_forces(handle_.get()); }
+
+    /** Whole positions block as one tensor; `device` nullptr → CPU. */
+    RKRStatus positions_dlpack(RKRDLManagedTensorVersioned **out_tensor,
+                               const RKRDLDevice *device = nullptr) const {
+        return rkr_trajectory_positions_dlpack(handle_.get(), device, out_tensor);
+    }
+    /** Forces block, or `RKR_STATUS_SECTION_ABSENT`. */
+    RKRStatus forces_dlpack(RKRDLManagedTensorVersioned **out_tensor,
+                            const RKRDLDevice *device = nullptr) const {
+        return rkr_trajectory_forces_dlpack(handle_.get(), device, out_tensor);
+    }
+    RKRStatus energies_dlpack(RKRDLManagedTensorVersioned **out_tensor,
+                              const RKRDLDevice *device = nullptr) const {
+        return rkr_trajectory_energies_dlpack(handle_.get(), device, out_tensor);
+    }
+
+    /// Row-major `(F, N, 3)` positions widened to double.
+    std::vector<double> positions() const {
+        return copy_block(rkr_trajectory_copy_positions, 3 * frame_count() * atom_count(),
+                          "rkr_trajectory_copy_positions");
+    }
+    /// Row-major `(F, N, 3)` forces (empty when has_forces() is false).
+    std::vector<double> forces() const {
+        if (!has_forces()) {
+            return {};
+        }
+        return copy_block(rkr_trajectory_copy_forces, 3 * frame_count() * atom_count(),
+                          "rkr_trajectory_copy_forces");
+    }
+    /// `(F,)` total energies; NaN where a frame has none.
+    std::vector<double> energies() const {
+        return copy_block(rkr_trajectory_copy_energies, frame_count(),
+                          "rkr_trajectory_copy_energies");
+    }
+
+    const RKRTrajectoryTensors *get_handle() const { return handle_.get(); }
+
+  private:
+    using CopyFn = RKRStatus (*)(const RKRTrajectoryTensors *, double *, size_t);
+
+    std::vector<double> copy_block(CopyFn copy, size_t len, const char *op) const {
+        std::vector<double> out(len);
+        RKRStatus st = copy(handle_.get(), out.data(), out.size());
+        if (st != RKR_STATUS_SUCCESS) {
+            throw std::runtime_error(std::string(op) + ": " + rkr_status_message(st));
+        }
+        return out;
+    }
+
+    struct Deleter {
+        void operator()(RKRTrajectoryTensors *p) const { free_rkr_trajectory_tensors(p); }
+    };
+    std::unique_ptr<RKRTrajectoryTensors, Deleter> handle_;
+};
+
+/**
+ * @brief Follows a `.con` file that another process is still writing.
+ *
+ * next() returns frames as the writer completes them and an empty optional
+ * while the file ends inside a frame (or at the end of a frame whose
+ * sections are not declared), so a monitoring loop can simply retry.
+ * Growth is detected by polling the file size.
+ *
+ * Example:
+ *
+ * readcon::ConFrameFollower live("neb.con");
+ * while (running) {
+ *     if (auto frame = live.next(std::chrono::milliseconds(500))) { ... }
+ * }
+ */
+class ConFrameFollower {
+  public:
+    /**
+     * @brief Starts following `path` at byte `offset` (a previous
+     * byte_offset(), or 0), numbering frames from `frames_before`.
+     * @throws std::runtime_error if the file cannot be opened, is
+     * compressed, or is shorter than `offset`.
+     */
+    explicit ConFrameFollower(const std::filesystem::path &path, uint64_t offset = 0,
+                              size_t frames_before = 0) {
+        RKRFollower *raw = nullptr;
+        throw_status(rkr_follower_open(path.string().c_str(), offset, frames_before, &raw),
+                     "rkr_follower_open(" + path.string() + ")");
+        handle_.reset(raw);
+    }
+
+    /**
+     * @brief The next complete frame, waiting up to `timeout` for it.
+     * @throws std::runtime_error if the file shrank or a frame is malformed
+     * (the malformed frame is skipped by the next call).
+     */
+    std::optional<ConFrame>
+    next(std::chrono::milliseconds timeout = std::chrono::milliseconds(0)) {
+        RKRConFrame *frame = nullptr;
+        auto ms = static_cast<uint64_t>(std::max<std::chrono::milliseconds::rep>(
+            timeout.count(), 0));
+        throw_status(rkr_follower_next(handle_.get(), ms, &frame), "rkr_follower_next");
+        if (!frame) {
+            return std::nullopt;
+        }
+        return ConFrame(frame);
+    }
+
+    /** @brief File offset just past the last frame returned. */
+    uint64_t byte_offset() const { return rkr_follower_byte_offset(handle_.get()); }
+    /** @brief Index of the frame the next successful next() returns. */
+    size_t position() const { return rkr_follower_position(handle_.get()); }
+    /** @brief Decodes only `columns` (bitwise OR of `RKR_COLUMN_*`). */
+    void set_columns(uint32_t columns) {
+        throw_status(rkr_follower_set_columns(handle_.get(), columns), "set_columns");
+    }
+
+  private:
+    static void throw_status(RKRStatus st, const std::string &op) {
+        if (st != RKR_STATUS_SUCCESS) {
+            throw std::runtime_error(op + ": " + rkr_status_message(st));
+        }
+    }
+
+    struct Deleter {
+        void operator()(RKRFollower *p) const { free_rkr_follower(p); }
+    };
+    std::unique_ptr<RKRFollower, Deleter> handle_;
+};
+
+/**
+ * @brief Frames parsed ahead on a background thread (`rkr_prefetcher_open`).
+ *
+ * A worker parses up to `depth` frames (on the Rayon pool in `parallel`
+ * builds) into a bounded queue while the caller works on the current one,
+ * so per-frame compute overlaps the parse. Range-for refills one frame in
+ * place and hands its old buffers back to the worker, as with
+ * ConFrameIterator; `std::move(*it)` or next() keep a frame. The span
+ * accessors (positions(), forces(), ...) work on every frame as usual.
+ * Plain C: `rkr_prefetch_for_each` takes a callback instead.
+ *
+ * Example:
+ *
+ * readcon::ConFramePrefetcher frames("md.con", 0, readcon::ConFramePrefetcher::npos, 10);
+ * for (auto&& frame : frames) {
+ *     analyse(frame.positions()); // later frames parse meanwhile
+ * }
+ */
+class ConFramePrefetcher {
+  public:
+    /** @brief "Until the end" sentinel for `stop`, and the index after the last frame. */
+    static constexpr size_t npos = static_cast<size_t>(-1);
+
+    /** @brief Single-pass input iterator over the prefetched frames. */
+    class Iterator {
+      public:
+        using iterator_category = std::input_iterator_tag;
+        using value_type = ConFrame;
+        using difference_type = std::ptrdiff_t;
+        using pointer = ConFrame *;
+        using reference = ConFrame &;
+
+        reference operator*() { return *current_frame_; }
+        pointer operator->() { return current_frame_.get(); }
+        /** @brief Waits for the next frame. @throws std::runtime_error on a malformed frame. */
+        Iterator &operator++() {
+            fetch_next_frame();
+            return *this;
+        }
+        /** @brief Equal once both are past the end. */
+        bool operator==(const Iterator &other) const {
+            return !current_frame_ && !other.current_frame_;
+        }
+        bool operator!=(const Iterator &other) const { return !(*this == other); }
+        /** @brief Index in the file of the current frame. */
+        size_t index() const { return index_; }
+
+      private:
+        friend class ConFramePrefetcher;
+        explicit Iterator(RKRFramePrefetcher *prefetcher) : prefetcher_(prefetcher) {
+            if (prefetcher_)
+                fetch_next_frame();
+        }
+        void fetch_next_frame();
+        RKRFramePrefetcher *prefetcher_ = nullptr;
+        std::unique_ptr<ConFrame> current_frame_;
+        size_t index_ = npos;
+    };
+
+    /**
+     * @brief Starts parsing frames `start, start + step, ...` before `stop`
+     * of `path`, at most `depth` ahead (0: 16), decoding only `columns`
+     * (bitwise OR of `RKR_COLUMN_*`).
+     * @throws std::runtime_error if the file cannot be read or `step` is 0.
+     */
+    explicit ConFramePrefetcher(const std::filesystem::path &path, size_t start = 0,
+                                size_t stop = npos, size_t step = 1, size_t depth = 0,
+                                uint32_t columns = RKR_COLUMNS_ALL);
+
+    /**
+     * @brief The next frame as a new handle, or std::nullopt after the last.
+     * @throws std::runtime_error on a malformed frame (the next call moves on).
+     */
+    std::optional<ConFrame> next();
+    /**
+     * @brief Overwrites `frame` with the next frame, recycling its buffers;
+     * false (frame unchanged) after the last.
+     * @throws std::runtime_error on a malformed frame.
+     */
+    bool next_into(ConFrame &frame);
+    /** @brief Index in the file of the frame last returned by next() / next_into(). */
+    size_t last_index() const { return last_index_; }
+
+    /** @brief Starts the range; waits for the first frame. Single-pass. */
+    Iterator begin() { return Iterator(handle_.get()); }
+    Iterator end() { return Iterator(nullptr); }
+
+  private:
+    struct Deleter {
+        void operator()(RKRFramePrefetcher *p) const { free_rkr_prefetcher(p); }
+    };
+    std::unique_ptr<RKRFramePrefetcher, Deleter> handle_;
+    size_t last_index_ = npos;
+};
+
 inline SelectionResult ConFrame::select(std::string_view selection) const {
     if (!has_chemfiles_support()) {
         throw std::runtime_error(
@@ -546,6 +961,92 @@ inline std::vector<size_t> ConFrame::select_atom_indices(std::string_view select
     return out;
 }
 
+/**
+ * @brief RAII chemfiles selection parsed once (`rkr_selection_compile`).
+ *
+ * evaluate() keeps a projected chemfiles frame between calls and only copies
+ * cell, positions and velocities in while the topology is unchanged, so a
+ * loop over a trajectory avoids re-parsing and re-projecting per frame.
+ * evaluate_frames() runs a batch on the library's worker pool. One thread at
+ * a time per object for evaluate().
+ *
+ * Example:
+ *
+ * readcon::CompiledSelection sel("name O and z > 5.0");
+ * for (auto&& frame : frames) {
+ *   auto hits = sel.evaluate(frame).primary_indices();
+ * }
+ */
+class CompiledSelection {
+  public:
+    explicit CompiledSelection(std::string_view selection) {
+        if (!has_chemfiles_support()) {
+            throw std::runtime_error(
+                "readcon::CompiledSelection requires a chemfiles-enabled readcon_core build");
+        }
+        std::string sel(selection);
+        RKRCompiledSelection *raw = nullptr;
+        RKRStatus st = rkr_selection_compile(sel.c_str(), &raw);
+        if (st != RKR_STATUS_SUCCESS) {
+            throw std::runtime_error(std::string("rkr_selection_compile: ") +
+                                     rkr_status_message(st));
+        }
+        handle_.reset(raw);
+    }
+
+    CompiledSelection(const CompiledSelection &) = delete;
+    CompiledSelection &operator=(const CompiledSelection &) = delete;
+    CompiledSelection(CompiledSelection &&) = default;
+    CompiledSelection &operator=(CompiledSelection &&) = default;
+
+    uint32_t context_size() const {
+        return rkr_compiled_selection_context_size(handle_.get());
+    }
+
+    SelectionResult evaluate(const ConFrame &frame) {
+        RKRSelectionResult *raw = nullptr;
+        RKRStatus st = rkr_compiled_selection_evaluate(handle_.get(), frame.get_handle(), &raw);
+        if (st != RKR_STATUS_SUCCESS) {
+            throw std::runtime_error(std::string("rkr_compiled_selection_evaluate: ") +
+                                     rkr_status_message(st));
+        }
+        return SelectionResult(raw);
+    }
+
+    /// One result per frame, in order.
+    std::vector<SelectionResult> evaluate_frames(const std::vector<ConFrame> &frames) const {
+        std::vector<const RKRConFrame *> handles;
+        handles.reserve(frames.size());
+        for (const auto &frame : frames) {
+            handles.push_back(frame.get_handle());
+        }
+        std::vector<RKRSelectionResult *> raw(frames.size(), nullptr);
+        RKRStatus st = rkr_compiled_selection_evaluate_frames(handle_.get(), handles.data(),
+                                                              handles.size(), raw.data());
+        if (st != RKR_STATUS_SUCCESS) {
+            throw std::runtime_error(std::string("rkr_compiled_selection_evaluate_frames: ") +
+                                     rkr_status_message(st));
+        }
+        std::vector<SelectionResult> out;
+        out.reserve(raw.size());
+        for (auto *r : raw) {
+            out.emplace_back(r);
+        }
+        return out;
+    }
+
+    const RKRCompiledSelection *get_handle() const { return handle_.get(); }
+
+  private:
+    struct Deleter {
+        void operator()(RKRCompiledSelection *p) const {
+            if (p)
+                rkr_compiled_selection_free(p);
+        }
+    };
+    std::unique_ptr<RKRCompiledSelection, Deleter> handle_;
+};
+
 /**
  * @brief A C++ wrapper for writing frames to a .con file.
  *
@@ -601,6 +1102,18 @@ class ConFrameWriter {
     static Compression compression_from_extension(
         const std::filesystem::path &path);
 
+    /**
+     * @brief Constructs a writer that formats `extend()` batches in parallel
+     *        chunks, written in order.
+     * @param path The output path; `.gz` / `.zst` compress every chunk as an
+     *        independent gzip member / zstd frame, so compression runs in
+     *        parallel as well.
+     * @param precision Number of decimal places for floating-point output (default 6).
+     * @throws std::runtime_error if the writer cannot be created.
+     */
+    static ConFrameWriter parallel(const std::filesystem::path &path,
+                                   uint8_t precision = 6);
+
     /**
      * @brief Writes all frames from a vector to the file.
      * @param frames A vector of ConFrame objects.
@@ -615,6 +1128,8 @@ class ConFrameWriter {
     }
 
   private:
+    explicit ConFrameWriter(RKRConFrameWriter *raw) : writer_handle_(raw) {}
+
     struct WriterDeleter {
         void operator()(RKRConFrameWriter *ptr) const {
             if (ptr)
@@ -636,6 +1151,24 @@ class ConFrameWriter {
  * builder.add_atom("Cu", 0.0, 0.0, 0.0, true, 0, 63.546);
  * auto frame = builder.build();
  */
+/**
+ * @brief Borrowed per-atom columns for ConFrameBuilder::set_atoms_from_arrays.
+ *
+ * The atom count is `masses.size()`. Vector blocks are row-major
+ * `[x0, y0, z0, x1, ...]`; `fixed` holds CON column-4 bitmask values. An
+ * empty optional column means all free (`fixed`), `0..N` (`atom_ids`), or
+ * no section (`velocities`, `forces`, `energies`).
+ */
+struct FrameArrays {
+    span<const double> positions;
+    span<const double> masses;
+    span<const uint8_t> fixed;
+    span<const uint64_t> atom_ids;
+    span<const double> velocities;
+    span<const double> forces;
+    span<const double> energies;
+};
+
 class ConFrameBuilder {
   public:
     /**
@@ -773,6 +1306,20 @@ class ConFrameBuilder {
     /// Bulk-update per-atom energies from a buffer of length `atom_count()`.
     ConFrameBuilder &set_atom_energies_from_flat(const std::vector<double> &energies);
 
+    /**
+     * @brief Replaces every atom from flat columns in one C call.
+     *
+     * Species are `symbols[k]` repeated `counts[k]` times, in atom order.
+     * @throws std::runtime_error if a column length disagrees with
+     * `columns.masses.size()`.
+     */
+    ConFrameBuilder &set_atoms_from_arrays(span<const std::string> symbols,
+                                           span<const size_t> counts,
+                                           const FrameArrays &columns);
+    /// As above, with one atomic number per atom (unknown numbers map to "X").
+    ConFrameBuilder &set_atoms_from_arrays(span<const uint64_t> atomic_numbers,
+                                           const FrameArrays &columns);
+
     /// Read-only accessor: position of atom `i` as `(x, y, z)`.
     [[nodiscard]] std::array<double, 3> get_atom_position(size_t i) const;
     /// Read-only accessor: velocity of atom `i`, if any.
@@ -826,6 +1373,10 @@ class ConFrameBuilder {
     ConFrame build();
 
   private:
+    void set_atoms_from_columns(const char *const *run_symbols, const uintptr_t *run_counts,
+                                size_t n_runs, const uint64_t *atomic_numbers,
+                                const FrameArrays &columns);
+
     RKRConFrameBuilder *builder_handle_ = nullptr;
 };
 
@@ -861,6 +1412,65 @@ inline void throw_on_error(RKRStatus status, const std::string &operation) {
     }
 }
 
+// --- Hot-path statistics ---
+
+/// Timed regions reported by stats(); values index the RKRStats arrays.
+enum class Stage : uint32_t {
+    Read = RKR_STAGE_READ,
+    Decompress = RKR_STAGE_DECOMPRESS,
+    Scan = RKR_STAGE_SCAN,
+    Header = RKR_STAGE_HEADER,
+    Metadata = RKR_STAGE_METADATA,
+    Coordinates = RKR_STAGE_COORDINATES,
+    Sections = RKR_STAGE_SECTIONS,
+    Assemble = RKR_STAGE_ASSEMBLE,
+    Write = RKR_STAGE_WRITE,
+};
+
+/**
+ * @brief Snapshot of the process-wide read / write counters.
+ *
+ * All zero unless the library was built with the `stats` Cargo feature
+ * (see stats_enabled()). Per-stage times nest and, for parallel reads, sum
+ * over workers.
+ */
+struct Stats {
+    RKRStats raw{};
+
+    uint64_t nanos(Stage stage) const { return raw.stage_nanos[index(stage)]; }
+    uint64_t calls(Stage stage) const { return raw.stage_calls[index(stage)]; }
+    uint64_t bytes(Stage stage) const { return raw.stage_bytes[index(stage)]; }
+
+    /// Busy fraction of the parallel pool, 0 before any parallel read.
+    double worker_utilization() const {
+        if (raw.parallel_capacity_nanos == 0) {
+            return 0.0;
+        }
+        double u = static_cast<double>(raw.parallel_busy_nanos) /
+                   static_cast<double>(raw.parallel_capacity_nanos);
+        return u < 1.0 ? u : 1.0;
+    }
+
+  private:
+    static size_t index(Stage stage) { return static_cast<size_t>(stage); }
+};
+
+/// True when the library records statistics (`stats` feature).
+inline bool stats_enabled() {
+    RKRStats scratch;
+    return rkr_stats_get(&scratch) == RKRStatus::RKR_STATUS_SUCCESS;
+}
+
+/// Current counters (zeros when stats_enabled() is false).
+inline Stats stats() {
+    Stats out;
+    (void)rkr_stats_get(&out.raw);
+    return out;
+}
+
+/// Zero the counters; a no-op when stats_enabled() is false.
+inline void reset_stats() { (void)rkr_stats_reset(); }
+
 /**
  * @brief Reads the first frame from a .con file using mmap.
  * @throws std::runtime_error on failure.
@@ -874,6 +1484,68 @@ inline ConFrame read_first_frame(const std::filesystem::path &path) {
     return ConFrame(handle);
 }
 
+/**
+ * @brief Reads frame `index` (0-based) from a .con file.
+ *
+ * Seeks directly via a fresh `<path>.idx` sidecar when one exists (see
+ * write_offset_index()); otherwise skips earlier frames without parsing
+ * their atoms.
+ * @throws std::runtime_error on failure or if `index` is out of range.
+ */
+inline ConFrame read_frame(const std::filesystem::path &path, size_t index) {
+    RKRConFrame *handle = rkr_read_frame(path.string().c_str(), index);
+    if (!handle) {
+        throw std::runtime_error("Failed to read frame " + std::to_string(index) +
+                                 " from: " + path.string());
+    }
+    return ConFrame(handle);
+}
+
+/**
+ * @brief Writes the `<path>.idx` frame offset sidecar for an uncompressed .con file.
+ * @throws std::runtime_error on failure.
+ */
+inline void write_offset_index(const std::filesystem::path &path) {
+    throw_on_error(rkr_write_offset_index(path.string().c_str()),
+                   "write_offset_index(" + path.string() + ")");
+}
+
+/// A frame accepted by query_frames(): index plus its byte span in the file.
+struct QueryHit {
+    uint64_t frame;
+    uint64_t offset;
+    uint64_t len;
+};
+
+/**
+ * @brief Frames of a .con file matching a query such as
+ *        `energy < -40 && composition == 'Cu:2|H:2' && fmax < 0.05`.
+ *
+ * Uses a fresh `<path>.idx` sidecar (see write_offset_index()) without
+ * parsing frames; otherwise scans decoding only the columns the predicates
+ * need.
+ * @throws std::runtime_error on a malformed query or unreadable file.
+ */
+inline std::vector<QueryHit> query_frames(const std::filesystem::path &path,
+                                          const std::string &expr) {
+    RKRQueryResult *raw = nullptr;
+    throw_on_error(rkr_query_frames(path.string().c_str(), expr.c_str(), &raw),
+                   "query_frames(" + path.string() + ")");
+    std::unique_ptr<RKRQueryResult, void (*)(RKRQueryResult *)> result(
+        raw, rkr_query_result_free);
+    const uint64_t n = rkr_query_result_len(result.get());
+    std::vector<uint64_t> frames(n), offsets(n), lens(n);
+    uint64_t written = 0;
+    throw_on_error(rkr_query_result_hits(result.get(), frames.data(), offsets.data(),
+                                         lens.data(), n, &written),
+                   "rkr_query_result_hits");
+    std::vector<QueryHit> hits(written);
+    for (uint64_t i = 0; i < written; ++i) {
+        hits[i] = QueryHit{frames[i], offsets[i], lens[i]};
+    }
+    return hits;
+}
+
 /**
  * @brief Reads all frames from a .con file using mmap.
  * @throws std::runtime_error on failure.
@@ -899,6 +1571,27 @@ inline std::vector<ConFrame> read_all_frames(const std::filesystem::path &path)
     return frames;
 }
 
+/**
+ * @brief Reads frames `start, start + step, ...` before `stop` (to the end by
+ *        default) into one TrajectoryTensors batch.
+ *
+ * `float_bits` (64, 32 or 16) sets the element type of every block. All
+ * frames must have the atom count of the first.
+ * @throws std::runtime_error on failure or a mismatched frame.
+ */
+inline TrajectoryTensors read_trajectory_tensors(const std::filesystem::path &path,
+                                                 size_t start = 0,
+                                                 size_t stop = RKR_FRAMES_END,
+                                                 size_t step = 1,
+                                                 uint8_t float_bits = 64) {
+    RKRDLDataType dtype{RKR_DL_FLOAT, float_bits, 1};
+    RKRTrajectoryTensors *handle = nullptr;
+    throw_on_error(rkr_read_trajectory_tensors(path.string().c_str(), start, stop, step,
+                                               &dtype, &handle),
+                   "read_trajectory_tensors(" + path.string() + ")");
+    return TrajectoryTensors(handle);
+}
+
 // --- Implementation of ConFrameIterator and its nested Iterator ---
 
 inline ConFrameIterator::ConFrameIterator(const std::filesystem::path &path) {
@@ -910,6 +1603,17 @@ inline ConFrameIterator::ConFrameIterator(const std::filesystem::path &path) {
     iterator_ptr_.reset(iter_ptr);
 }
 
+inline ConFrameIterator::ConFrameIterator(const std::filesystem::path &path,
+                                          size_t num_threads) {
+    CConFrameIterator *iter_ptr =
+        read_con_file_iterator_parallel(path.string().c_str(), num_threads);
+    if (!iter_ptr) {
+        throw std::runtime_error("Failed to open .con file for iteration: " +
+                                 path.string());
+    }
+    iterator_ptr_.reset(iter_ptr);
+}
+
 inline ConFrameIterator::Iterator ConFrameIterator::begin() {
     return Iterator(iterator_ptr_.get());
 }
@@ -924,16 +1628,68 @@ inline bool
 ConFrameIterator::Iterator::operator!=(const Iterator &other) const {
     return !(*this == other);
 }
-inline ConFrameIterator::Iterator::Iterator(CConFrameIterator *iterator_ptr)
-    : iterator_ptr_(iterator_ptr) {
+inline size_t ConFrameIterator::skip(size_t n) {
+    return con_frame_iterator_skip(iterator_ptr_.get(), n);
+}
+inline void ConFrameIterator::seek(size_t frame_index) {
+    throw_on_error(con_frame_iterator_seek(iterator_ptr_.get(), frame_index),
+                   "seek(" + std::to_string(frame_index) + ")");
+}
+inline size_t ConFrameIterator::position() const {
+    return con_frame_iterator_position(iterator_ptr_.get());
+}
+inline void ConFrameIterator::set_columns(uint32_t columns) {
+    throw_on_error(con_frame_iterator_set_columns(iterator_ptr_.get(), columns),
+                   "set_columns");
+}
+inline ConFrameIterator::Range ConFrameIterator::slice(size_t start,
+                                                       size_t stop,
+                                                       size_t step) {
+    if (step == 0) {
+        throw std::invalid_argument("slice step must be non-zero");
+    }
+    return Range(iterator_ptr_.get(), start, stop, step);
+}
+inline ConFrameIterator::Iterator ConFrameIterator::Range::begin() {
+    if (start_ >= stop_) {
+        return Iterator(nullptr);
+    }
+    RKRStatus st = con_frame_iterator_seek(iterator_ptr_, start_);
+    if (st == RKRStatus::RKR_STATUS_INDEX_OUT_OF_BOUNDS) {
+        return Iterator(nullptr);
+    }
+    throw_on_error(st, "slice seek(" + std::to_string(start_) + ")");
+    return Iterator(iterator_ptr_, stop_, step_);
+}
+inline ConFrameIterator::Iterator ConFrameIterator::Range::end() {
+    return Iterator(nullptr);
+}
+
+inline ConFrameIterator::Iterator::Iterator(CConFrameIterator *iterator_ptr,
+                                            size_t stop, size_t step)
+    : iterator_ptr_(iterator_ptr), stop_(stop), step_(step) {
     if (iterator_ptr_)
         fetch_next_frame();
 }
 
 inline void ConFrameIterator::Iterator::fetch_next_frame() {
-    RKRConFrame *frame_handle = con_frame_iterator_next(iterator_ptr_);
-    if (frame_handle) {
-        current_frame_ = std::unique_ptr<ConFrame>(new ConFrame(frame_handle));
+    if (stop_ != npos && con_frame_iterator_position(iterator_ptr_) >= stop_) {
+        current_frame_ = nullptr;
+        return;
+    }
+    bool advanced;
+    if (current_frame_) {
+        advanced = current_frame_->refill_from(iterator_ptr_);
+    } else {
+        RKRConFrame *frame_handle = nullptr;
+        advanced = con_frame_iterator_next_into(iterator_ptr_, &frame_handle);
+        if (advanced)
+            current_frame_ = std::unique_ptr<ConFrame>(new ConFrame(frame_handle));
+    }
+    if (advanced) {
+        if (step_ > 1) {
+            con_frame_iterator_skip(iterator_ptr_, step_ - 1);
+        }
     } else {
         current_frame_ = nullptr;
     }
@@ -967,10 +1723,6 @@ inline void ConFrame::cache_data() const {
             "Failed to extract CFrame from handle for caching.");
     }
 
-    cell_cache_ = {c_frame->cell[0], c_frame->cell[1], c_frame->cell[2]};
-    angles_cache_ = {c_frame->angles[0], c_frame->angles[1],
-                     c_frame->angles[2]};
-
     has_velocities_cache_ = c_frame->has_velocities;
     has_forces_cache_ = c_frame->has_forces;
     has_energies_cache_ = c_frame->has_energies;
@@ -1001,7 +1753,83 @@ inline void ConFrame::cache_data() const {
 #endif
 
     free_c_frame(c_frame);
+    is_cached_ = true;
+}
+
+inline bool ConFrame::refill_from(CConFrameIterator *iterator) {
+    // A moved-from frame has no handle; next_into allocates one then.
+    RKRConFrame *handle = frame_handle_.release();
+    bool advanced = con_frame_iterator_next_into(iterator, &handle);
+    frame_handle_.reset(handle);
+    invalidate_caches();
+    return advanced;
+}
+
+inline bool ConFrame::refill_from(RKRFramePrefetcher *prefetcher, size_t &index) {
+    RKRConFrame *handle = frame_handle_.release();
+    RKRStatus st = rkr_prefetcher_next(prefetcher, &handle, &index);
+    frame_handle_.reset(handle);
+    invalidate_caches();
+    throw_on_error(st, "rkr_prefetcher_next(frame " + std::to_string(index) + ")");
+    return index != ConFramePrefetcher::npos;
+}
+
+inline void ConFrame::invalidate_caches() {
+    is_cached_ = false;
+    cell_cached_ = false;
+    headers_cached_ = false;
+    atoms_cache_.clear();
+}
+
+// --- Implementation of ConFramePrefetcher methods ---
+
+inline ConFramePrefetcher::ConFramePrefetcher(const std::filesystem::path &path,
+                                              size_t start, size_t stop, size_t step,
+                                              size_t depth, uint32_t columns) {
+    RKRFramePrefetcher *raw = nullptr;
+    throw_on_error(rkr_prefetcher_open(path.string().c_str(), start, stop, step, depth,
+                                       columns, &raw),
+                   "rkr_prefetcher_open(" + path.string() + ")");
+    handle_.reset(raw);
+}
+
+inline std::optional<ConFrame> ConFramePrefetcher::next() {
+    RKRConFrame *frame = nullptr;
+    RKRStatus st = rkr_prefetcher_next(handle_.get(), &frame, &last_index_);
+    throw_on_error(st, "rkr_prefetcher_next(frame " + std::to_string(last_index_) + ")");
+    if (!frame) {
+        return std::nullopt;
+    }
+    return ConFrame(frame);
+}
 
+inline bool ConFramePrefetcher::next_into(ConFrame &frame) {
+    return frame.refill_from(handle_.get(), last_index_);
+}
+
+inline void ConFramePrefetcher::Iterator::fetch_next_frame() {
+    if (!current_frame_) {
+        current_frame_.reset(new ConFrame(nullptr));
+    }
+    if (!current_frame_->refill_from(prefetcher_, index_)) {
+        current_frame_ = nullptr;
+    }
+}
+
+inline void ConFrame::cache_cell() const {
+    if (cell_cached_) {
+        return;
+    }
+    throw_on_error(rkr_frame_get_cell(frame_handle_.get(), cell_cache_.data(),
+                                      angles_cache_.data()),
+                   "rkr_frame_get_cell");
+    cell_cached_ = true;
+}
+
+inline void ConFrame::cache_headers() const {
+    if (headers_cached_) {
+        return;
+    }
     // Cache headers using the flexible FFI that allocates and frees
     // strings. This helper lambda makes the code cleaner and ensures memory is
     // always freed.
@@ -1022,16 +1850,16 @@ inline void ConFrame::cache_data() const {
     postbox_header_cache_[0] = get_and_free_string(false, 0);
     postbox_header_cache_[1] = get_and_free_string(false, 1);
 
-    is_cached_ = true;
+    headers_cached_ = true;
 }
 
 inline const std::array<double, 3> &ConFrame::cell() const {
-    cache_data();
+    cache_cell();
     return cell_cache_;
 }
 
 inline const std::array<double, 3> &ConFrame::angles() const {
-    cache_data();
+    cache_cell();
     return angles_cache_;
 }
 
@@ -1041,12 +1869,12 @@ inline const std::vector<Atom> &ConFrame::atoms() const {
 }
 
 inline const std::array<std::string, 2> &ConFrame::prebox_header() const {
-    cache_data();
+    cache_headers();
     return prebox_header_cache_;
 }
 
 inline const std::array<std::string, 2> &ConFrame::postbox_header() const {
-    cache_data();
+    cache_headers();
     return postbox_header_cache_;
 }
 
@@ -1294,6 +2122,18 @@ ConFrameWriter::compression_from_extension(
     return Compression::None;
 }
 
+inline ConFrameWriter
+ConFrameWriter::parallel(const std::filesystem::path &path,
+                         uint8_t precision) {
+    RKRConFrameWriter *raw =
+        create_writer_parallel_c(path.string().c_str(), precision);
+    if (!raw) {
+        throw std::runtime_error("Failed to create parallel writer for file: " +
+                                 path.string());
+    }
+    return ConFrameWriter(raw);
+}
+
 inline void ConFrameWriter::set_canonical(bool on) {
     throw_on_error(rkr_writer_set_canonical(writer_handle_.get(), on ? 1 : 0),
                    "rkr_writer_set_canonical");
@@ -1517,6 +2357,59 @@ ConFrameBuilder::set_atom_energies_from_flat(const std::vector<double> &energies
     return *this;
 }
 
+inline void ConFrameBuilder::set_atoms_from_columns(const char *const *run_symbols,
+                                                    const uintptr_t *run_counts,
+                                                    size_t n_runs,
+                                                    const uint64_t *atomic_numbers,
+                                                    const FrameArrays &c) {
+    // The C call trusts n = masses.size() for every column; check spans first.
+    const size_t n = c.masses.size();
+    auto sized = [](size_t len, size_t want, bool optional) {
+        return len == want || (optional && len == 0);
+    };
+    if (!sized(c.positions.size(), 3 * n, false) || !sized(c.fixed.size(), n, true) ||
+        !sized(c.atom_ids.size(), n, true) || !sized(c.velocities.size(), 3 * n, true) ||
+        !sized(c.forces.size(), 3 * n, true) || !sized(c.energies.size(), n, true)) {
+        throw std::runtime_error("Failed to bulk-set atoms: column length disagrees with masses");
+    }
+    // Empty optional columns go across as NULL (absent section / default).
+    auto optional = [](auto column) { return column.empty() ? nullptr : column.data(); };
+    throw_on_error(rkr_frame_builder_set_atoms_from_arrays(
+                       builder_handle_, n, c.positions.data(),
+                       c.masses.data(), run_symbols, run_counts, n_runs, atomic_numbers,
+                       optional(c.fixed), optional(c.atom_ids), optional(c.velocities),
+                       optional(c.forces), optional(c.energies)),
+                   "Failed to bulk-set atoms");
+}
+
+inline ConFrameBuilder &
+ConFrameBuilder::set_atoms_from_arrays(span<const std::string> symbols,
+                                       span<const size_t> counts,
+                                       const FrameArrays &columns) {
+    if (symbols.size() != counts.size()) {
+        throw std::runtime_error("Failed to bulk-set atoms: symbols and counts differ in length");
+    }
+    std::vector<const char *> names;
+    names.reserve(symbols.size());
+    for (const auto &symbol : symbols) {
+        names.push_back(symbol.c_str());
+    }
+    std::vector<uintptr_t> run_counts(counts.begin(), counts.end());
+    set_atoms_from_columns(names.data(), run_counts.data(), names.size(), nullptr, columns);
+    return *this;
+}
+
+inline ConFrameBuilder &
+ConFrameBuilder::set_atoms_from_arrays(span<const uint64_t> atomic_numbers,
+                                       const FrameArrays &columns) {
+    if (atomic_numbers.size() != columns.masses.size()) {
+        throw std::runtime_error(
+            "Failed to bulk-set atoms: atomic_numbers and masses differ in length");
+    }
+    set_atoms_from_columns(nullptr, nullptr, 0, atomic_numbers.data(), columns);
+    return *this;
+}
+
 inline std::array<double, 3>
 ConFrameBuilder::get_atom_position(size_t i) const {
     std::array<double, 3> xyz{0.0, 0.0, 0.0};
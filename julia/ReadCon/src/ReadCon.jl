@@ -3,10 +3,14 @@ module ReadCon
 include("types.jl")
 include("wrapper.jl")
 
-export Atom, ConFrame, read_con, write_con,
+export Atom, ConFrame, read_con, write_con, read_con_tensors,
        index_energy, composition_formula, total_mass, cell_volume, fmax,
        sections_mask, index_natoms, index_projection_json,
        atom_index_by_id, build_atom_id_index,
-       has_chemfiles_support, select_on_frame, select_atom_indices, frame_bond_count
+       has_chemfiles_support, select_on_frame, select_atom_indices, frame_bond_count,
+       CompiledSelection,
+       FrameBuffers, TrajectoryBuffers, read_frame_buffers, read_trajectory_buffers,
+       positions_view, velocities_view, forces_view, masses_view, atom_energies_view,
+       energies_view, BorrowedArray
 
 end # module
@@ -89,6 +89,48 @@ function has_chemfiles_support()
     return ccall(_lib_symbol(:rkr_has_chemfiles_support), UInt8, ()) != 0
 end
 
+function _take_selection_result(result_handle::Ptr{Cvoid}, selection::String)
+    try
+        n = ccall(
+            _lib_symbol(:rkr_selection_result_match_count),
+            UInt64,
+            (Ptr{Cvoid},),
+            result_handle,
+        )
+        ctx = ccall(
+            _lib_symbol(:rkr_selection_result_context_size),
+            UInt32,
+            (Ptr{Cvoid},),
+            result_handle,
+        )
+        matches = Vector{Vector{UInt64}}()
+        for i in 0:(n - 1)
+            atoms = Vector{UInt64}(undef, 4)
+            fill!(atoms, typemax(UInt64))
+            size_ref = Ref{UInt32}(0)
+            st = ccall(
+                _lib_symbol(:rkr_selection_result_match_at),
+                Cint,
+                (Ptr{Cvoid}, UInt64, Ptr{UInt64}, Ref{UInt32}),
+                result_handle,
+                i,
+                atoms,
+                size_ref,
+            )
+            _check_status(st, "rkr_selection_result_match_at")
+            sz = Int(size_ref[])
+            push!(matches, atoms[1:sz])
+        end
+        return (
+            selection = selection,
+            context_size = Int(ctx),
+            matches = matches,
+        )
+    finally
+        ccall(_lib_symbol(:rkr_selection_result_free), Cvoid, (Ptr{Cvoid},), result_handle)
+    end
+end
+
 """
     select_on_frame(frame::ConFrame, selection::String) -> NamedTuple
 
@@ -118,47 +160,8 @@ function select_on_frame(frame::ConFrame, selection::String)
             out,
         )
         _check_status(status, "rkr_frame_select")
-        result_handle = out[]
-        result_handle == C_NULL && error("rkr_frame_select returned null result")
-        try
-            n = ccall(
-                _lib_symbol(:rkr_selection_result_match_count),
-                UInt64,
-                (Ptr{Cvoid},),
-                result_handle,
-            )
-            ctx = ccall(
-                _lib_symbol(:rkr_selection_result_context_size),
-                UInt32,
-                (Ptr{Cvoid},),
-                result_handle,
-            )
-            matches = Vector{Vector{UInt64}}()
-            for i in 0:(n - 1)
-                atoms = Vector{UInt64}(undef, 4)
-                fill!(atoms, typemax(UInt64))
-                size_ref = Ref{UInt32}(0)
-                st = ccall(
-                    _lib_symbol(:rkr_selection_result_match_at),
-                    Cint,
-                    (Ptr{Cvoid}, UInt64, Ptr{UInt64}, Ref{UInt32}),
-                    result_handle,
-                    i,
-                    atoms,
-                    size_ref,
-                )
-                _check_status(st, "rkr_selection_result_match_at")
-                sz = Int(size_ref[])
-                push!(matches, atoms[1:sz])
-            end
-            return (
-                selection = selection,
-                context_size = Int(ctx),
-                matches = matches,
-            )
-        finally
-            ccall(_lib_symbol(:rkr_selection_result_free), Cvoid, (Ptr{Cvoid},), result_handle)
-        end
+        out[] == C_NULL && error("rkr_frame_select returned null result")
+        return _take_selection_result(out[], selection)
     finally
         handle != C_NULL && ccall(_lib_symbol(:free_rkr_frame), Cvoid, (Ptr{Cvoid},), handle)
     end
@@ -179,6 +182,87 @@ function select_atom_indices(frame::ConFrame, selection::String)
     return idxs
 end
 
+"""
+    CompiledSelection(selection::String)
+
+Chemfiles selection parsed once (`rkr_selection_compile`). Evaluating it on
+successive frames with the same topology (symbols, chemfiles names / types,
+bonds) updates one projected chemfiles frame in place instead of re-parsing
+the selection and rebuilding the frame, as [`select_on_frame`](@ref) does.
+
+```julia
+sel = CompiledSelection("name O and z > 5.0")
+hits = [select_atom_indices(sel, f) for f in frames]
+```
+
+The handle is released by a finalizer. One task at a time per handle.
+"""
+mutable struct CompiledSelection
+    handle::Ptr{Cvoid}
+    selection::String
+
+    function CompiledSelection(selection::String)
+        has_chemfiles_support() || error(
+            "CompiledSelection requires libreadcon_core built with --features chemfiles"
+        )
+        out = Ref{Ptr{Cvoid}}(C_NULL)
+        status = ccall(
+            _lib_symbol(:rkr_selection_compile),
+            Cint,
+            (Cstring, Ref{Ptr{Cvoid}}),
+            selection,
+            out,
+        )
+        _check_status(status, "rkr_selection_compile")
+        sel = new(out[], selection)
+        finalizer(sel) do s
+            if s.handle != C_NULL
+                ccall(_lib_symbol(:rkr_compiled_selection_free), Cvoid, (Ptr{Cvoid},), s.handle)
+                s.handle = C_NULL
+            end
+        end
+        return sel
+    end
+end
+
+"""
+    select_on_frame(sel::CompiledSelection, frame::ConFrame) -> NamedTuple
+
+Same result as `select_on_frame(frame, sel.selection)`, reusing `sel`'s parsed
+selection and projected frame.
+"""
+function select_on_frame(sel::CompiledSelection, frame::ConFrame)
+    handle = _build_frame_handle(frame)
+    try
+        out = Ref{Ptr{Cvoid}}(C_NULL)
+        status = ccall(
+            _lib_symbol(:rkr_compiled_selection_evaluate),
+            Cint,
+            (Ptr{Cvoid}, Ptr{Cvoid}, Ref{Ptr{Cvoid}}),
+            sel.handle,
+            handle,
+            out,
+        )
+        _check_status(status, "rkr_compiled_selection_evaluate")
+        return _take_selection_result(out[], sel.selection)
+    finally
+        handle != C_NULL && ccall(_lib_symbol(:free_rkr_frame), Cvoid, (Ptr{Cvoid},), handle)
+    end
+end
+
+"""
+    select_atom_indices(sel::CompiledSelection, frame::ConFrame) -> Vector{Int}
+
+Atom-context indices with a compiled selection (see [`CompiledSelection`](@ref)).
+"""
+function select_atom_indices(sel::CompiledSelection, frame::ConFrame)
+    res = select_on_frame(sel, frame)
+    res.context_size == 1 || error(
+        "select_atom_indices requires atom-context selection, got context_size=$(res.context_size)"
+    )
+    return sort(unique(Int(m[1]) for m in res.matches))
+end
+
 """
     frame_bond_count(frame::ConFrame) -> Int
 
@@ -548,6 +632,242 @@ function positions_matrix(frame::ConFrame)::Matrix{Float64}
     end
 end
 
+# 1-based inclusive `start:step:stop` -> owned `RKRTrajectoryTensors*` (float64).
+function _open_trajectory_tensors(path::String, start::Integer, stop, step::Integer)
+    start >= 1 || error("trajectory tensors: start must be >= 1")
+    step >= 1 || error("trajectory tensors: step must be >= 1")
+    # 1-based inclusive -> 0-based exclusive.
+    c_stop = stop === nothing ? typemax(Csize_t) : Csize_t(stop)
+    out = Ref{Ptr{Cvoid}}(C_NULL)
+    st = ccall(
+        _lib_symbol(:rkr_read_trajectory_tensors),
+        Cint,
+        (Cstring, Csize_t, Csize_t, Csize_t, Ptr{Cvoid}, Ref{Ptr{Cvoid}}),
+        path,
+        Csize_t(start - 1),
+        c_stop,
+        Csize_t(step),
+        C_NULL,
+        out,
+    )
+    _check_status(st, "rkr_read_trajectory_tensors($path)")
+    return out[]
+end
+
+"""
+    read_con_tensors(path; start=1, stop=nothing, step=1) -> NamedTuple
+
+Parse frames `start:step:stop` (1-based, inclusive; `stop=nothing` reads to
+the end) into batched arrays via `rkr_read_trajectory_tensors`. Returns
+`(positions, forces, energies)`: `positions` is `3×N×F`, `forces` the same
+or `nothing`, and `energies` a length-`F` vector (NaN where a frame has none).
+Every selected frame must share one atom count.
+"""
+function read_con_tensors(path::String; start::Integer=1, stop=nothing, step::Integer=1)
+    handle = _open_trajectory_tensors(path, start, stop, step)
+    try
+        nf = Int(ccall(_lib_symbol(:rkr_trajectory_tensors_frame_count), Csize_t,
+                       (Ptr{Cvoid},), handle))
+        na = Int(ccall(_lib_symbol(:rkr_trajectory_tensors_atom_count), Csize_t,
+                       (Ptr{Cvoid},), handle))
+        # Row-major (F, N, 3) in C is column-major 3×N×F here: no permute.
+        function block(sym::Symbol, dims...)
+            buf = Array{Float64}(undef, dims...)
+            st = ccall(_lib_symbol(sym), Cint, (Ptr{Cvoid}, Ptr{Float64}, Csize_t),
+                       handle, buf, length(buf))
+            _check_status(st, String(sym))
+            return buf
+        end
+        positions = block(:rkr_trajectory_copy_positions, 3, na, nf)
+        has_forces = ccall(_lib_symbol(:rkr_trajectory_tensors_has_forces), Bool,
+                           (Ptr{Cvoid},), handle)
+        forces = has_forces ? block(:rkr_trajectory_copy_forces, 3, na, nf) : nothing
+        energies = block(:rkr_trajectory_copy_energies, nf)
+        return (positions=positions, forces=forces, energies=energies)
+    finally
+        ccall(_lib_symbol(:free_rkr_trajectory_tensors), Cvoid, (Ptr{Cvoid},), handle)
+    end
+end
+
+# --- Borrowed views over native SoA buffers (no per-access copy) ---
+
+"""
+    FrameBuffers(frame::ConFrame)
+
+Native frame handle whose SoA blocks are exposed as borrowed arrays by
+[`positions_view`](@ref), [`velocities_view`](@ref), [`forces_view`](@ref),
+[`masses_view`](@ref) and [`atom_energies_view`](@ref). Row-major `(N, 3)`
+storage is a column-major `3×N` matrix as is, so a view reads the frame's
+own buffer without a copy or transpose.
+
+Views are read-only [`BorrowedArray`](@ref)s that keep their owner alive,
+so a view may outlive the loop variable that produced it. Frames stored
+narrower than f64 fall back to one widening (and writable) copy.
+
+```julia
+for fb in read_frame_buffers("traj.con")
+    com = positions_view(fb) * masses_view(fb) / sum(masses_view(fb))
+end
+```
+"""
+mutable struct FrameBuffers
+    handle::Ptr{Cvoid}
+    natoms::Int
+
+    function FrameBuffers(handle::Ptr{Cvoid})
+        handle == C_NULL && error("FrameBuffers: null frame handle")
+        n = Int(ccall(_lib_symbol(:rkr_frame_atom_count), Csize_t, (Ptr{Cvoid},), handle))
+        fb = new(handle, n)
+        finalizer(fb) do b
+            if b.handle != C_NULL
+                ccall(_lib_symbol(:free_rkr_frame), Cvoid, (Ptr{Cvoid},), b.handle)
+                b.handle = C_NULL
+            end
+        end
+        return fb
+    end
+end
+
+FrameBuffers(frame::ConFrame) = FrameBuffers(_build_frame_handle(frame))
+
+"""
+    read_frame_buffers(path::String) -> Vector{FrameBuffers}
+
+Parse every frame into a native handle without building `ConFrame` /
+`CAtom` copies; pair with the `*_view` accessors.
+"""
+function read_frame_buffers(path::String)::Vector{FrameBuffers}
+    iter_ptr = ccall(_lib_symbol(:read_con_file_iterator), Ptr{Cvoid}, (Cstring,), path)
+    iter_ptr == C_NULL && error("Failed to open file: $path")
+    frames = FrameBuffers[]
+    try
+        while true
+            handle = ccall(_lib_symbol(:con_frame_iterator_next), Ptr{Cvoid},
+                           (Ptr{Cvoid},), iter_ptr)
+            handle == C_NULL && break
+            push!(frames, FrameBuffers(handle))
+        end
+    finally
+        ccall(_lib_symbol(:free_con_frame_iterator), Cvoid, (Ptr{Cvoid},), iter_ptr)
+    end
+    return frames
+end
+
+"""
+    BorrowedArray{N} <: AbstractArray{Float64, N}
+
+Read-only column-major array over a native buffer owned by a
+[`FrameBuffers`](@ref) or [`TrajectoryBuffers`](@ref). The array holds a
+reference to its owner, so the owner's finalizer cannot release the buffer
+while the view is reachable. The buffer may be shared copy-on-write with
+other frames, hence no `setindex!`; `copy` gives a writable `Array`.
+"""
+struct BorrowedArray{N} <: AbstractArray{Float64, N}
+    owner::Any
+    ptr::Ptr{Float64}
+    dims::NTuple{N, Int}
+end
+
+Base.size(a::BorrowedArray) = a.dims
+Base.IndexStyle(::Type{<:BorrowedArray}) = IndexLinear()
+Base.@propagate_inbounds function Base.getindex(a::BorrowedArray, i::Int)
+    @boundscheck checkbounds(a, i)
+    GC.@preserve a unsafe_load(a.ptr, i)
+end
+Base.pointer(a::BorrowedArray) = a.ptr
+Base.unsafe_convert(::Type{Ptr{Float64}}, a::BorrowedArray) = a.ptr
+Base.elsize(::Type{<:BorrowedArray}) = sizeof(Float64)
+Base.strides(a::BorrowedArray) = Base.size_to_strides(1, a.dims...)
+Base.copy(a::BorrowedArray) = GC.@preserve a copy(unsafe_wrap(Array, a.ptr, a.dims))
+
+# Borrow `dims` doubles from `data(owner.handle)`; NULL (absent or non-f64)
+# falls back to `copy(handle, buf, len)`, and `nothing` when the section is
+# absent.
+function _borrow_block(owner, data::Symbol, copy::Symbol, dims::Int...)
+    handle = owner.handle
+    handle == C_NULL && error("$data: handle already released")
+    prod(dims) == 0 && return zeros(Float64, dims...)
+    ptr = ccall(_lib_symbol(data), Ptr{Float64}, (Ptr{Cvoid},), handle)
+    ptr != C_NULL && return BorrowedArray(owner, ptr, dims)
+    buf = Array{Float64}(undef, dims...)
+    st = ccall(_lib_symbol(copy), Cint, (Ptr{Cvoid}, Ptr{Float64}, Csize_t),
+               handle, buf, length(buf))
+    st == Cint(-8) && return nothing  # RKR_STATUS_SECTION_ABSENT
+    _check_status(st, String(copy))
+    return buf
+end
+
+"""Borrowed `3×N` positions of `fb` (see [`FrameBuffers`](@ref))."""
+positions_view(fb::FrameBuffers)::AbstractMatrix{Float64} =
+    _borrow_block(fb, :rkr_frame_positions_data, :rkr_frame_copy_positions, 3, fb.natoms)
+
+"""Borrowed `3×N` velocities, or `nothing` when the frame has none."""
+velocities_view(fb::FrameBuffers) =
+    _borrow_block(fb, :rkr_frame_velocities_data, :rkr_frame_copy_velocities,
+                  3, fb.natoms)
+
+"""Borrowed `3×N` forces, or `nothing` when the frame has none."""
+forces_view(fb::FrameBuffers) =
+    _borrow_block(fb, :rkr_frame_forces_data, :rkr_frame_copy_forces, 3, fb.natoms)
+
+"""Borrowed length-`N` masses."""
+masses_view(fb::FrameBuffers)::AbstractVector{Float64} =
+    _borrow_block(fb, :rkr_frame_masses_data, :rkr_frame_copy_masses, fb.natoms)
+
+"""Borrowed length-`N` per-atom energies, or `nothing` when the frame has none."""
+atom_energies_view(fb::FrameBuffers) =
+    _borrow_block(fb, :rkr_frame_atom_energies_data, :rkr_frame_copy_atom_energies,
+                  fb.natoms)
+
+"""Native `RKRTrajectoryTensors` batch; see [`read_trajectory_buffers`](@ref)."""
+mutable struct TrajectoryBuffers
+    handle::Ptr{Cvoid}
+    nframes::Int
+    natoms::Int
+
+    function TrajectoryBuffers(handle::Ptr{Cvoid})
+        nf = Int(ccall(_lib_symbol(:rkr_trajectory_tensors_frame_count), Csize_t,
+                       (Ptr{Cvoid},), handle))
+        na = Int(ccall(_lib_symbol(:rkr_trajectory_tensors_atom_count), Csize_t,
+                       (Ptr{Cvoid},), handle))
+        tb = new(handle, nf, na)
+        finalizer(tb) do t
+            if t.handle != C_NULL
+                ccall(_lib_symbol(:free_rkr_trajectory_tensors), Cvoid, (Ptr{Cvoid},), t.handle)
+                t.handle = C_NULL
+            end
+        end
+        return tb
+    end
+end
+
+"""
+    read_trajectory_buffers(path; start=1, stop=nothing, step=1) -> TrajectoryBuffers
+
+Same frame selection and batching as [`read_con_tensors`](@ref), but the
+batch stays native: [`positions_view`](@ref) / [`forces_view`](@ref) return
+`3×N×F` arrays and [`energies_view`](@ref) a length-`F` vector wrapped over
+the batch buffers instead of copies. The lifetime rules of
+[`FrameBuffers`](@ref) apply.
+"""
+function read_trajectory_buffers(path::String; start::Integer=1, stop=nothing,
+                                 step::Integer=1)::TrajectoryBuffers
+    return TrajectoryBuffers(_open_trajectory_tensors(path, start, stop, step))
+end
+
+positions_view(t::TrajectoryBuffers)::AbstractArray{Float64, 3} =
+    _borrow_block(t, :rkr_trajectory_positions_data, :rkr_trajectory_copy_positions,
+                  3, t.natoms, t.nframes)
+
+forces_view(t::TrajectoryBuffers) =
+    _borrow_block(t, :rkr_trajectory_forces_data, :rkr_trajectory_copy_forces,
+                  3, t.natoms, t.nframes)
+
+"""Borrowed length-`F` total energies of a batch (NaN where a frame has none)."""
+energies_view(t::TrajectoryBuffers)::AbstractVector{Float64} =
+    _borrow_block(t, :rkr_trajectory_energies_data, :rkr_trajectory_copy_energies,
+                  t.nframes)
+
 function _section_matrix_3(frame::ConFrame, sym::Symbol)::Matrix{Float64}
     _with_frame_handle(frame) do handle
         n = Int(ccall(_lib_symbol(:rkr_frame_atom_count), Csize_t, (Ptr{Cvoid},), handle))
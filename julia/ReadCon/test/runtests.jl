@@ -47,6 +47,51 @@ end
         @test length(frames[2].atoms) == 4
     end
 
+    @testset "Batched trajectory tensors" begin
+        path = joinpath(TEST_DIR, "tiny_multi_cuh2.con")
+        frames = read_con(path)
+        batch = read_con_tensors(path)
+        @test size(batch.positions) == (3, 4, 2)
+        @test length(batch.energies) == 2
+        @test batch.positions[1, 1, 2] ≈ frames[2].atoms[1].x
+        tail = read_con_tensors(path; start=2)
+        @test size(tail.positions) == (3, 4, 1)
+        @test tail.positions[:, :, 1] ≈ batch.positions[:, :, 2]
+    end
+
+    @testset "Borrowed frame and trajectory views" begin
+        path = joinpath(TEST_DIR, "tiny_multi_cuh2.con")
+        frames = read_con(path)
+        fbs = read_frame_buffers(path)
+        @test length(fbs) == length(frames)
+        fb = fbs[2]
+        pos = positions_view(fb)
+        @test size(pos) == (3, length(frames[2].atoms))
+        @test pos[:, 1] ≈ [frames[2].atoms[1].x, frames[2].atoms[1].y, frames[2].atoms[1].z]
+        @test pos == positions_view(fb)
+        @test pointer(pos) == pointer(positions_view(fb))
+        @test forces_view(fb) === nothing
+        @test length(masses_view(fb)) == size(pos, 2)
+        @test pos isa BorrowedArray
+        @test_throws ErrorException pos[1, 1] = 0.0
+        @test copy(pos) isa Matrix{Float64}
+
+        # A view keeps its owner alive after the last direct reference is gone.
+        outlived = positions_view(read_frame_buffers(path)[1])
+        GC.gc(); GC.gc()
+        @test outlived[:, 1] ≈ [frames[1].atoms[1].x, frames[1].atoms[1].y,
+                                frames[1].atoms[1].z]
+
+        tb = read_trajectory_buffers(path)
+        copied = read_con_tensors(path)
+        @test positions_view(tb) == copied.positions
+        @test forces_view(tb) === nothing
+        @test isequal(energies_view(tb), copied.energies)
+
+        forced = FrameBuffers(read_con(joinpath(TEST_DIR, "tiny_cuh2_forces.con"))[1])
+        @test forces_view(forced)[:, 1] ≈ [0.123456, 0.234567, -0.345678] atol=1e-6
+    end
+
     @testset "Read .convel file" begin
         frames = read_con(joinpath(TEST_DIR, "tiny_cuh2.convel"))
         @test length(frames) == 1
@@ -59,4 +59,8 @@ using ReadCon
 
     o_idxs = select_atom_indices(frame, "name O")
     @test o_idxs == [2, 3]
+
+    compiled = CompiledSelection("bonds: all")
+    @test length(select_on_frame(compiled, frame).matches) == 3
+    @test select_atom_indices(CompiledSelection("name O"), frame) == o_idxs
 end
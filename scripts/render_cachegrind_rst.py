@@ -19,6 +19,8 @@ NOTES = {
     "parse_cuh2_218": "218-atom frame (20×)",
     "float_fast_float2": "5-col fast-float2 (10k)",
     "float_std_parse": "5-col str::parse (10k)",
+    "coord_block_kernel_256": "256-row block, bitmask kernel (40×)",
+    "coord_block_lines_256": "256-row block, line by line (40×)",
     "write_100_frames": "buffer writer (10×)",
     "chemfiles_xyz_path": "XYZ path → ConFrame (50×)",
     "chemfiles_xyz_memory": "XYZ memory → ConFrame (50×)",
@@ -0,0 +1,1153 @@
+//! Compact binary trajectory cache (`.conb`) with memory-mapped columnar frames.
+//!
+//! Re-reading the same trajectory pays text decode every pass; a `.conb` file
+//! stores each frame as little-endian SoA blocks so later passes map the file
+//! and slice coordinates in place ([`ConbFrameView`]) or rebuild a
+//! [`ConFrame`] without touching the text parser ([`ConbFile::read_frame`]).
+//!
+//! # Layout
+//!
+//! | bytes | field |
+//! |-------|-------|
+//! | 8     | magic `RKRCONB\0` |
+//! | 4     | format version ([`CONB_VERSION`]) |
+//! | 4     | record size ([`CONB_RECORD_SIZE`]) |
+//! | 8     | frame count |
+//! | 8     | record table offset |
+//! | 8     | source file length (0 when not a cache of a CON file) |
+//! | 8 + 4 | source mtime (seconds, nanoseconds since the Unix epoch) |
+//! | 4     | formula table length |
+//! | 8     | reserved (zero) |
+//!
+//! Frame blocks follow the header back to back. Each block is a header blob
+//! (spec version, cell, user / metadata / postbox lines, metadata JSON,
+//! sections, type runs and per-type masses) padded to 8 bytes, then the
+//! columns: positions `(N, 3)`, the optional velocities / forces `(N, 3)`,
+//! energies / charges / spins `(N,)` and magmoms `(N, 3)` as `f64`, atom ids
+//! as `u64` and fixed bitmasks as `u8`. The record table at the end holds one
+//! [`CONB_RECORD_SIZE`]-byte record per frame (block offsets, natoms, column
+//! flags, [`StorageDtypes`] codes and the [`FrameIndexProjection`] scalars,
+//! NaN when absent), then the formula table (`u32` length + UTF-8 bytes).
+//!
+//! Blocks are always binary64, like CON text; [`StorageDtypes`] travel in
+//! the metadata JSON (and the record) and are re-applied on decode, so the
+//! round trip is lossless. Views need a little-endian host.
+//!
+//! # Freshness
+//! A cache written by [`ConbFile::build_for_path`] is stamped with the source
+//! length and mtime, as the offset index is; [`ConbFile::open_fresh`] ignores
+//! stale caches.
+
+use crate::index_proj::{self, FrameIndexProjection};
+use crate::offset_index::source_stamp;
+use crate::storage_dtype::{ElementKind, StorageDtypes};
+use crate::types::{AtomDatum, ConFrame, FrameHeader, PreboxHeader};
+use std::collections::HashMap;
+use std::fs::File;
+use std::io::{self, BufWriter, Seek, SeekFrom, Write};
+use std::path::{Path, PathBuf};
+use std::sync::Arc;
+
+/// `.conb` magic bytes.
+pub const CONB_MAGIC: [u8; 8] = *b"RKRCONB\0";
+/// `.conb` format version written by this build.
+pub const CONB_VERSION: u32 = 1;
+/// Fixed file header size in bytes.
+pub const CONB_HEADER_SIZE: usize = 64;
+/// Fixed per-frame record size in bytes.
+pub const CONB_RECORD_SIZE: usize = 128;
+
+/// Column flag: velocities block present.
+pub const COLUMN_VELOCITIES: u8 = 1 << 0;
+/// Column flag: forces block present.
+pub const COLUMN_FORCES: u8 = 1 << 1;
+/// Column flag: per-atom energies block present.
+pub const COLUMN_ENERGIES: u8 = 1 << 2;
+/// Column flag: charges block present.
+pub const COLUMN_CHARGES: u8 = 1 << 3;
+/// Column flag: spins block present.
+pub const COLUMN_SPINS: u8 = 1 << 4;
+/// Column flag: magnetic moments block present.
+pub const COLUMN_MAGMOMS: u8 = 1 << 5;
+
+/// Optional `f64` columns in block order, with their width per atom.
+const OPTIONAL_COLUMNS: [(u8, usize); 6] = [
+    (COLUMN_VELOCITIES, 3),
+    (COLUMN_FORCES, 3),
+    (COLUMN_ENERGIES, 1),
+    (COLUMN_CHARGES, 1),
+    (COLUMN_SPINS, 1),
+    (COLUMN_MAGMOMS, 3),
+];
+
+const HEADER_FLAG_SECTIONS_DECLARED: u32 = 1 << 0;
+const HEADER_FLAG_STRICT_VALIDATION: u32 = 1 << 1;
+const PBC_PRESENT: u8 = 1 << 3;
+const N_SCALARS: usize = 11;
+
+/// Cache path for a CON file: `traj.con` → `traj.con.conb`.
+pub fn cache_path(con_path: &Path) -> PathBuf {
+    let mut s = con_path.as_os_str().to_owned();
+    s.push(".conb");
+    PathBuf::from(s)
+}
+
+/// True when `path` names a `.conb` file.
+pub fn path_is_conb(path: &Path) -> bool {
+    path.extension()
+        .and_then(|e| e.to_str())
+        .is_some_and(|e| e.eq_ignore_ascii_case("conb"))
+}
+
+fn invalid(msg: &str) -> io::Error {
+    io::Error::new(io::ErrorKind::InvalidData, format!("conb: {msg}"))
+}
+
+fn kind_code(kind: ElementKind) -> u8 {
+    ElementKind::all_hosted()
+        .iter()
+        .position(|&k| k == kind)
+        .unwrap_or(0) as u8
+}
+
+fn kind_from_code(code: u8) -> io::Result<ElementKind> {
+    ElementKind::all_hosted()
+        .get(code as usize)
+        .copied()
+        .ok_or_else(|| invalid("unknown storage dtype code"))
+}
+
+fn pad8(n: usize) -> usize {
+    n.next_multiple_of(8)
+}
+
+/// Little-endian cursor over a validated byte range.
+struct Bytes<'a> {
+    b: &'a [u8],
+    at: usize,
+}
+
+impl<'a> Bytes<'a> {
+    fn take(&mut self, n: usize) -> io::Result<&'a [u8]> {
+        let out = self
+            .b
+            .get(self.at..self.at.saturating_add(n))
+            .ok_or_else(|| invalid("truncated frame header"))?;
+        self.at += n;
+        Ok(out)
+    }
+
+    fn u32(&mut self) -> io::Result<u32> {
+        Ok(u32::from_le_bytes(self.take(4)?.try_into().expect("4 bytes")))
+    }
+
+    fn u64(&mut self) -> io::Result<u64> {
+        Ok(u64::from_le_bytes(self.take(8)?.try_into().expect("8 bytes")))
+    }
+
+    fn f64(&mut self) -> io::Result<f64> {
+        Ok(f64::from_bits(self.u64()?))
+    }
+
+    fn str(&mut self) -> io::Result<&'a str> {
+        let len = self.u32()? as usize;
+        std::str::from_utf8(self.take(len)?).map_err(|_| invalid("string is not UTF-8"))
+    }
+}
+
+fn put_str(out: &mut Vec<u8>, s: &str) {
+    out.extend_from_slice(&(s.len() as u32).to_le_bytes());
+    out.extend_from_slice(s.as_bytes());
+}
+
+fn put_opt(out: &mut Vec<u8>, v: Option<f64>) {
+    out.extend_from_slice(&v.unwrap_or(f64::NAN).to_le_bytes());
+}
+
+fn opt_f64(v: f64) -> Option<f64> {
+    (!v.is_nan()).then_some(v)
+}
+
+/// Column flags for `frame`, decided by the first atom like
+/// [`crate::types::con_frame_from_atom_data`].
+fn frame_columns(frame: &ConFrame) -> u8 {
+    let Some(a) = frame.atom_data.first() else {
+        return 0;
+    };
+    let mut flags = 0u8;
+    for (present, bit) in [
+        (a.has_velocity(), COLUMN_VELOCITIES),
+        (a.has_forces(), COLUMN_FORCES),
+        (a.has_energy(), COLUMN_ENERGIES),
+        (a.has_charge(), COLUMN_CHARGES),
+        (a.has_spin(), COLUMN_SPINS),
+        (a.has_magmom(), COLUMN_MAGMOMS),
+    ] {
+        if present {
+            flags |= bit;
+        }
+    }
+    flags
+}
+
+/// Byte length of a frame's column region.
+fn columns_len(natoms: usize, columns: u8) -> Option<usize> {
+    let widths: usize = 3 + OPTIONAL_COLUMNS
+        .iter()
+        .filter(|(bit, _)| columns & bit != 0)
+        .map(|&(_, w)| w)
+        .sum::<usize>();
+    // f64 blocks + u64 ids + u8 fixed masks.
+    natoms.checked_mul(8 * widths + 8 + 1)
+}
+
+fn encode_header(header: &FrameHeader, atom_data: &[AtomDatum]) -> io::Result<Vec<u8>> {
+    let mut out = Vec::new();
+    let mut flags = 0u32;
+    if header.sections_declared {
+        flags |= HEADER_FLAG_SECTIONS_DECLARED;
+    }
+    if header.strict_validation {
+        flags |= HEADER_FLAG_STRICT_VALIDATION;
+    }
+    out.extend_from_slice(&header.spec_version.to_le_bytes());
+    out.extend_from_slice(&flags.to_le_bytes());
+    for v in header.boxl.iter().chain(&header.angles) {
+        out.extend_from_slice(&v.to_le_bytes());
+    }
+    put_str(&mut out, &header.prebox_header.user);
+    put_str(&mut out, &header.prebox_header.metadata_line);
+    put_str(&mut out, &header.postbox_header[0]);
+    put_str(&mut out, &header.postbox_header[1]);
+    let metadata = if header.metadata.is_empty() {
+        String::new()
+    } else {
+        serde_json::to_string(&header.metadata).map_err(io::Error::other)?
+    };
+    put_str(&mut out, &metadata);
+    out.extend_from_slice(&(header.sections.len() as u32).to_le_bytes());
+    for s in &header.sections {
+        put_str(&mut out, s);
+    }
+    out.extend_from_slice(&(header.natm_types as u64).to_le_bytes());
+    out.extend_from_slice(&(header.natms_per_type.len() as u32).to_le_bytes());
+    let mut start = 0usize;
+    for &count in &header.natms_per_type {
+        put_str(&mut out, atom_data.get(start).map_or("", |a| &*a.symbol));
+        out.extend_from_slice(&(count as u64).to_le_bytes());
+        start += count;
+    }
+    out.extend_from_slice(&(header.masses_per_type.len() as u32).to_le_bytes());
+    for m in &header.masses_per_type {
+        out.extend_from_slice(&m.to_le_bytes());
+    }
+    Ok(out)
+}
+
+/// Decoded header blob: the header plus one symbol per type run.
+fn decode_header(b: &[u8]) -> io::Result<(FrameHeader, Vec<Arc<str>>)> {
+    let mut r = Bytes { b, at: 0 };
+    let spec_version = r.u32()?;
+    let flags = r.u32()?;
+    let mut cell = [0.0f64; 6];
+    for v in &mut cell {
+        *v = r.f64()?;
+    }
+    let user = r.str()?.to_owned();
+    let metadata_line = r.str()?.to_owned();
+    let postbox_header = [r.str()?.to_owned(), r.str()?.to_owned()];
+    let metadata_json = r.str()?;
+    let metadata = if metadata_json.is_empty() {
+        std::collections::BTreeMap::new()
+    } else {
+        serde_json::from_str(metadata_json).map_err(|_| invalid("bad metadata JSON"))?
+    };
+    let n_sections = r.u32()?;
+    let mut sections = Vec::new();
+    for _ in 0..n_sections {
+        sections.push(r.str()?.to_owned());
+    }
+    let natm_types = r.u64()? as usize;
+    let n_runs = r.u32()?;
+    let mut symbols = Vec::new();
+    let mut natms_per_type = Vec::new();
+    for _ in 0..n_runs {
+        symbols.push(Arc::from(r.str()?));
+        natms_per_type.push(r.u64()? as usize);
+    }
+    let n_masses = r.u32()?;
+    let mut masses_per_type = Vec::new();
+    for _ in 0..n_masses {
+        masses_per_type.push(r.f64()?);
+    }
+    let header = FrameHeader {
+        prebox_header: PreboxHeader {
+            user,
+            metadata_line,
+        },
+        boxl: [cell[0], cell[1], cell[2]],
+        angles: [cell[3], cell[4], cell[5]],
+        postbox_header,
+        natm_types,
+        natms_per_type,
+        masses_per_type,
+        spec_version,
+        metadata,
+        sections,
+        strict_validation: flags & HEADER_FLAG_STRICT_VALIDATION != 0,
+        sections_declared: flags & HEADER_FLAG_SECTIONS_DECLARED != 0,
+    };
+    Ok((header, symbols))
+}
+
+/// One frame's table entry: block offsets, column flags, storage dtypes and
+/// the [`FrameIndexProjection`] scalars.
+#[derive(Clone, Debug, PartialEq)]
+pub struct ConbFrameRecord {
+    /// Byte offset of the frame's header blob.
+    pub offset: u64,
+    /// Byte offset (8-aligned) of the frame's first column.
+    pub columns_offset: u64,
+    pub natoms: u64,
+    /// Index into [`ConbFile::formulas`].
+    pub formula_id: u32,
+    /// [`index_proj`] `SECTIONS_MASK_*` bits.
+    pub sections_mask: u8,
+    /// `COLUMN_*` bits for the optional blocks.
+    pub columns: u8,
+    pub pbc: Option<[bool; 3]>,
+    pub storage_dtypes: StorageDtypes,
+    pub energy: Option<f64>,
+    pub fmax: Option<f64>,
+    pub total_mass: Option<f64>,
+    pub cell_volume: Option<f64>,
+    pub time: Option<f64>,
+    pub timestep: Option<f64>,
+    pub frame_index: Option<f64>,
+    pub neb_bead: Option<f64>,
+    pub neb_band: Option<f64>,
+    pub charge: Option<f64>,
+    pub magmom: Option<f64>,
+}
+
+impl ConbFrameRecord {
+    fn to_bytes(&self, out: &mut Vec<u8>) {
+        let start = out.len();
+        out.extend_from_slice(&self.offset.to_le_bytes());
+        out.extend_from_slice(&self.columns_offset.to_le_bytes());
+        out.extend_from_slice(&self.natoms.to_le_bytes());
+        out.extend_from_slice(&self.formula_id.to_le_bytes());
+        out.push(self.sections_mask);
+        out.push(self.columns);
+        out.push(self.pbc.map_or(0, |p| {
+            PBC_PRESENT | p[0] as u8 | (p[1] as u8) << 1 | (p[2] as u8) << 2
+        }));
+        out.push(0);
+        let dt = &self.storage_dtypes;
+        for kind in [dt.positions, dt.velocities, dt.forces, dt.energies, dt.masses, dt.atom_ids] {
+            out.push(kind_code(kind));
+        }
+        out.extend_from_slice(&[0u8; 2]);
+        for v in self.scalars() {
+            put_opt(out, v);
+        }
+        debug_assert_eq!(out.len() - start, CONB_RECORD_SIZE);
+    }
+
+    fn from_bytes(rec: &[u8]) -> io::Result<Self> {
+        let mut r = Bytes { b: rec, at: 0 };
+        let offset = r.u64()?;
+        let columns_offset = r.u64()?;
+        let natoms = r.u64()?;
+        let formula_id = r.u32()?;
+        let flags = r.take(4)?;
+        let pbc = (flags[2] & PBC_PRESENT != 0)
+            .then(|| [flags[2] & 1 != 0, flags[2] & 2 != 0, flags[2] & 4 != 0]);
+        let codes = r.take(8)?;
+        let storage_dtypes = StorageDtypes {
+            positions: kind_from_code(codes[0])?,
+            velocities: kind_from_code(codes[1])?,
+            forces: kind_from_code(codes[2])?,
+            energies: kind_from_code(codes[3])?,
+            masses: kind_from_code(codes[4])?,
+            atom_ids: kind_from_code(codes[5])?,
+        };
+        let mut s = [None; N_SCALARS];
+        for v in &mut s {
+            *v = opt_f64(r.f64()?);
+        }
+        Ok(Self {
+            offset,
+            columns_offset,
+            natoms,
+            formula_id,
+            sections_mask: flags[0],
+            columns: flags[1],
+            pbc,
+            storage_dtypes,
+            energy: s[0],
+            fmax: s[1],
+            total_mass: s[2],
+            cell_volume: s[3],
+            time: s[4],
+            timestep: s[5],
+            frame_index: s[6],
+            neb_bead: s[7],
+            neb_band: s[8],
+            charge: s[9],
+            magmom: s[10],
+        })
+    }
+
+    fn scalars(&self) -> [Option<f64>; N_SCALARS] {
+        [
+            self.energy,
+            self.fmax,
+            self.total_mass,
+            self.cell_volume,
+            self.time,
+            self.timestep,
+            self.frame_index,
+            self.neb_bead,
+            self.neb_band,
+            self.charge,
+            self.magmom,
+        ]
+    }
+
+    /// Byte offset and element count of the `f64` column `bit` (0 for positions).
+    fn column(&self, bit: u8) -> Option<(usize, usize)> {
+        let n = self.natoms as usize;
+        let mut at = self.columns_offset as usize;
+        if bit == 0 {
+            return Some((at, 3 * n));
+        }
+        at += 24 * n;
+        for &(b, width) in &OPTIONAL_COLUMNS {
+            if self.columns & b == 0 {
+                continue;
+            }
+            if b == bit {
+                return Some((at, width * n));
+            }
+            at += 8 * width * n;
+        }
+        None
+    }
+
+    /// Byte offset of the atom id column.
+    fn ids_offset(&self) -> usize {
+        let n = self.natoms as usize;
+        let floats: usize = OPTIONAL_COLUMNS
+            .iter()
+            .filter(|(b, _)| self.columns & b != 0)
+            .map(|&(_, w)| w * n)
+            .sum();
+        self.columns_offset as usize + 8 * (3 * n + floats)
+    }
+}
+
+/// Streaming `.conb` writer: frame blocks go out as they are pushed, the
+/// record table and header are written by [`Self::finish`].
+pub struct ConbWriter<W: Write + Seek> {
+    out: W,
+    pos: u64,
+    records: Vec<ConbFrameRecord>,
+    formulas: Vec<String>,
+    formula_ids: HashMap<String, u32>,
+}
+
+impl ConbWriter<BufWriter<File>> {
+    /// Create (truncate) `path`.
+    pub fn from_path(path: impl AsRef<Path>) -> io::Result<Self> {
+        Self::new(BufWriter::new(File::create(path)?))
+    }
+}
+
+impl<W: Write + Seek> ConbWriter<W> {
+    /// Start a `.conb` stream on `out` (written from its start).
+    pub fn new(mut out: W) -> io::Result<Self> {
+        out.write_all(&[0u8; CONB_HEADER_SIZE])?;
+        Ok(Self {
+            out,
+            pos: CONB_HEADER_SIZE as u64,
+            records: Vec::new(),
+            formulas: Vec::new(),
+            formula_ids: HashMap::new(),
+        })
+    }
+
+    /// Frames written so far.
+    pub fn len(&self) -> usize {
+        self.records.len()
+    }
+
+    #[must_use]
+    pub fn is_empty(&self) -> bool {
+        self.records.is_empty()
+    }
+
+    /// Append one frame.
+    pub fn write_frame(&mut self, frame: &ConFrame) -> io::Result<()> {
+        let n = frame.atom_data.len();
+        let columns = frame_columns(frame);
+        let mut block = encode_header(&frame.header, &frame.atom_data)?;
+        block.resize(pad8(block.len()), 0);
+        let columns_offset = self.pos + block.len() as u64;
+        block.reserve(columns_len(n, columns).unwrap_or(0));
+        let atoms = &frame.atom_data;
+        for a in atoms {
+            for v in [a.x, a.y, a.z] {
+                block.extend_from_slice(&v.to_le_bytes());
+            }
+        }
+        let row = |v: Option<[f64; 3]>| v.unwrap_or([0.0; 3]);
+        for &(bit, _) in &OPTIONAL_COLUMNS {
+            if columns & bit == 0 {
+                continue;
+            }
+            for a in atoms {
+                let values: &[f64] = match bit {
+                    COLUMN_VELOCITIES => &row(a.velocity),
+                    COLUMN_FORCES => &row(a.force),
+                    COLUMN_ENERGIES => &[a.energy.unwrap_or(0.0)],
+                    COLUMN_CHARGES => &[a.charge.unwrap_or(0.0)],
+                    COLUMN_SPINS => &[a.spin.unwrap_or(0.0)],
+                    _ => &row(a.magmom),
+                };
+                for v in values {
+                    block.extend_from_slice(&v.to_le_bytes());
+                }
+            }
+        }
+        for a in atoms {
+            block.extend_from_slice(&a.atom_id.to_le_bytes());
+        }
+        block.extend(atoms.iter().map(|a| crate::types::encode_fixed_bitmask(a.fixed)));
+        block.resize(pad8(block.len()), 0);
+        self.out.write_all(&block)?;
+
+        let proj = FrameIndexProjection::from_frame(frame);
+        let formula_id = self.formula_id(proj.formula);
+        self.records.push(ConbFrameRecord {
+            offset: self.pos,
+            columns_offset,
+            natoms: n as u64,
+            formula_id,
+            sections_mask: proj.sections_mask,
+            columns,
+            pbc: proj.pbc,
+            storage_dtypes: StorageDtypes::from_metadata(&frame.header.metadata)
+                .unwrap_or_default(),
+            energy: proj.energy,
+            fmax: proj.fmax,
+            total_mass: proj.total_mass,
+            cell_volume: proj.cell_volume,
+            time: proj.time,
+            timestep: proj.timestep,
+            frame_index: proj.frame_index,
+            neb_bead: proj.neb_bead,
+            neb_band: proj.neb_band,
+            charge: proj.charge,
+            magmom: proj.magmom,
+        });
+        self.pos += block.len() as u64;
+        Ok(())
+    }
+
+    /// Append every frame of `frames`.
+    pub fn extend<'a>(&mut self, frames: impl IntoIterator<Item = &'a ConFrame>) -> io::Result<()> {
+        for frame in frames {
+            self.write_frame(frame)?;
+        }
+        Ok(())
+    }
+
+    fn formula_id(&mut self, formula: String) -> u32 {
+        if let Some(&id) = self.formula_ids.get(&formula) {
+            return id;
+        }
+        let id = self.formulas.len() as u32;
+        self.formula_ids.insert(formula.clone(), id);
+        self.formulas.push(formula);
+        id
+    }
+
+    /// Write the record table and an unstamped header; returns the sink.
+    pub fn finish(self) -> io::Result<W> {
+        self.finish_with_stamp(0, (0, 0))
+    }
+
+    /// Like [`Self::finish`], stamping the cache with the current length
+    /// and mtime of `con_path` so [`ConbFile::is_fresh`] can check it.
+    pub fn finish_for_source(self, con_path: &Path) -> io::Result<W> {
+        let (len, mtime) = source_stamp(con_path)?;
+        self.finish_with_stamp(len, mtime)
+    }
+
+    fn finish_with_stamp(mut self, source_len: u64, source_mtime: (u64, u32)) -> io::Result<W> {
+        let mut table = Vec::with_capacity(self.records.len() * CONB_RECORD_SIZE);
+        for r in &self.records {
+            r.to_bytes(&mut table);
+        }
+        for f in &self.formulas {
+            put_str(&mut table, f);
+        }
+        self.out.write_all(&table)?;
+
+        let mut header = Vec::with_capacity(CONB_HEADER_SIZE);
+        header.extend_from_slice(&CONB_MAGIC);
+        header.extend_from_slice(&CONB_VERSION.to_le_bytes());
+        header.extend_from_slice(&(CONB_RECORD_SIZE as u32).to_le_bytes());
+        header.extend_from_slice(&(self.records.len() as u64).to_le_bytes());
+        header.extend_from_slice(&self.pos.to_le_bytes());
+        header.extend_from_slice(&source_len.to_le_bytes());
+        header.extend_from_slice(&source_mtime.0.to_le_bytes());
+        header.extend_from_slice(&source_mtime.1.to_le_bytes());
+        header.extend_from_slice(&(self.formulas.len() as u32).to_le_bytes());
+        header.extend_from_slice(&[0u8; 8]);
+        debug_assert_eq!(header.len(), CONB_HEADER_SIZE);
+        self.out.seek(SeekFrom::Start(0))?;
+        self.out.write_all(&header)?;
+        self.out.flush()?;
+        Ok(self.out)
+    }
+}
+
+/// A memory-mapped `.conb` file: the record table is decoded on open, frame
+/// blocks are only touched when viewed.
+pub struct ConbFile {
+    map: Arc<memmap2::Mmap>,
+    records: Vec<ConbFrameRecord>,
+    /// Distinct composition formulas ([`crate::index_proj::composition_formula`]).
+    pub formulas: Vec<String>,
+    /// Source file length at stamp time (0 when unstamped).
+    pub source_len: u64,
+    /// Source mtime at stamp time, `(secs, nanos)` since the Unix epoch.
+    pub source_mtime: (u64, u32),
+}
+
+impl ConbFile {
+    /// Map `path` and validate its header, record table and block bounds.
+    pub fn open(path: impl AsRef<Path>) -> io::Result<Self> {
+        if cfg!(target_endian = "big") {
+            return Err(invalid("zero-copy views need a little-endian host"));
+        }
+        let file = File::open(path)?;
+        // Safety: the map is read-only; like any mmap reader, it assumes
+        // the file is not truncated underneath it.
+        let map = unsafe { memmap2::Mmap::map(&file)? };
+        let b: &[u8] = &map;
+        if b.len() < CONB_HEADER_SIZE || b[..8] != CONB_MAGIC {
+            return Err(invalid("bad magic"));
+        }
+        if b.as_ptr() as usize % 8 != 0 {
+            return Err(invalid("mapping is not 8-byte aligned"));
+        }
+        let mut h = Bytes { b: &b[8..CONB_HEADER_SIZE], at: 0 };
+        if h.u32()? != CONB_VERSION {
+            return Err(invalid("unsupported version"));
+        }
+        if h.u32()? as usize != CONB_RECORD_SIZE {
+            return Err(invalid("unexpected record size"));
+        }
+        let n = h.u64()? as usize;
+        let table = h.u64()? as usize;
+        let source_len = h.u64()?;
+        let source_mtime = (h.u64()?, h.u32()?);
+        let n_formulas = h.u32()?;
+
+        let records_end = n
+            .checked_mul(CONB_RECORD_SIZE)
+            .and_then(|r| r.checked_add(table))
+            .filter(|&end| table >= CONB_HEADER_SIZE && end <= b.len())
+            .ok_or_else(|| invalid("truncated record table"))?;
+        let mut records = Vec::with_capacity(n);
+        for rec in b[table..records_end].chunks_exact(CONB_RECORD_SIZE) {
+            let r = ConbFrameRecord::from_bytes(rec)?;
+            let fits = columns_len(r.natoms as usize, r.columns)
+                .and_then(|len| len.checked_add(r.columns_offset as usize))
+                .is_some_and(|end| end <= table);
+            if !fits || r.columns_offset % 8 != 0 || r.offset > r.columns_offset {
+                return Err(invalid("frame block out of bounds"));
+            }
+            records.push(r);
+        }
+        let mut t = Bytes { b, at: records_end };
+        let mut formulas = Vec::with_capacity(n_formulas as usize);
+        for _ in 0..n_formulas {
+            formulas.push(t.str()?.to_owned());
+        }
+        Ok(Self {
+            map: Arc::new(map),
+            records,
+            formulas,
+            source_len,
+            source_mtime,
+        })
+    }
+
+    /// Number of frames.
+    pub fn len(&self) -> usize {
+        self.records.len()
+    }
+
+    #[must_use]
+    pub fn is_empty(&self) -> bool {
+        self.records.is_empty()
+    }
+
+    /// All frame records.
+    pub fn records(&self) -> &[ConbFrameRecord] {
+        &self.records
+    }
+
+    /// Composition formula of frame `i`, or `None` past the end.
+    pub fn formula(&self, i: usize) -> Option<&str> {
+        let r = self.records.get(i)?;
+        self.formulas.get(r.formula_id as usize).map(String::as_str)
+    }
+
+    /// [`FrameIndexProjection`] of frame `i` from the record table alone
+    /// (equal to `FrameIndexProjection::from_frame` on the decoded frame).
+    pub fn projection(&self, i: usize) -> Option<FrameIndexProjection> {
+        let r = self.records.get(i)?;
+        let formula = self.formula(i)?.to_owned();
+        let species_counts: Vec<(String, u32)> = formula
+            .split('|')
+            .filter_map(|part| {
+                let (s, c) = part.rsplit_once(':')?;
+                Some((s.to_owned(), c.parse().ok()?))
+            })
+            .collect();
+        Some(FrameIndexProjection {
+            n_atoms: r.natoms as u32,
+            symbols: species_counts.iter().map(|(s, _)| s.clone()).collect(),
+            species_counts,
+            formula,
+            energy: r.energy,
+            fmax: r.fmax,
+            total_mass: r.total_mass,
+            cell_volume: r.cell_volume,
+            pbc: r.pbc,
+            sections_mask: r.sections_mask,
+            has_forces: r.sections_mask & index_proj::SECTIONS_MASK_FORCES != 0,
+            has_velocities: r.sections_mask & index_proj::SECTIONS_MASK_VELOCITIES != 0,
+            has_energy: r.sections_mask & index_proj::SECTIONS_MASK_ENERGIES != 0,
+            time: r.time,
+            timestep: r.timestep,
+            frame_index: r.frame_index,
+            neb_bead: r.neb_bead,
+            neb_band: r.neb_band,
+            charge: r.charge,
+            magmom: r.magmom,
+        })
+    }
+
+    /// Zero-copy view of frame `i`.
+    pub fn frame(&self, i: usize) -> Option<ConbFrameView<'_>> {
+        let record = self.records.get(i)?;
+        Some(ConbFrameView { file: self, record })
+    }
+
+    /// Decode frame `i` into an owned [`ConFrame`] (storage dtypes re-applied).
+    pub fn read_frame(&self, i: usize) -> io::Result<ConFrame> {
+        self.frame(i)
+            .ok_or_else(|| io::Error::new(io::ErrorKind::InvalidInput, "frame index out of range"))?
+            .to_frame()
+    }
+
+    /// Decode every frame in order.
+    pub fn frames(&self) -> impl Iterator<Item = io::Result<ConFrame>> + '_ {
+        (0..self.len()).map(|i| self.read_frame(i))
+    }
+
+    /// True when `con_path` still has the stamped length and mtime.
+    pub fn is_fresh(&self, con_path: &Path) -> bool {
+        self.source_len != 0
+            && matches!(source_stamp(con_path), Ok(s) if s == (self.source_len, self.source_mtime))
+    }
+
+    /// The `<con_path>.conb` cache, if present, well-formed and fresh.
+    pub fn open_fresh(con_path: &Path) -> Option<Self> {
+        let cache = Self::open(cache_path(con_path)).ok()?;
+        cache.is_fresh(con_path).then_some(cache)
+    }
+
+    /// Stream `con_path` (plain, `.gz` or `.zst`) into `<con_path>.conb`,
+    /// written atomically (temp file + rename) and stamped with the source
+    /// length and mtime as they were before the scan.
+    pub fn build_for_path(con_path: &Path) -> Result<(), Box<dyn std::error::Error>> {
+        let stamp = source_stamp(con_path)?;
+        let target = cache_path(con_path);
+        let mut tmp = target.as_os_str().to_owned();
+        tmp.push(".tmp");
+        let tmp = PathBuf::from(tmp);
+        let mut writer = ConbWriter::from_path(&tmp)?;
+        for frame in crate::streaming::StreamingConFrameIterator::from_path(con_path)? {
+            writer.write_frame(&frame?)?;
+        }
+        let file = writer.finish_with_stamp(stamp.0, stamp.1)?.into_inner()?;
+        file.sync_all()?;
+        std::fs::rename(&tmp, &target)?;
+        Ok(())
+    }
+
+    /// Fresh cache if available, otherwise rebuild it from `con_path`.
+    pub fn open_or_build(con_path: &Path) -> Result<Self, Box<dyn std::error::Error>> {
+        if let Some(cache) = Self::open_fresh(con_path) {
+            return Ok(cache);
+        }
+        Self::build_for_path(con_path)?;
+        Ok(Self::open(cache_path(con_path))?)
+    }
+
+    fn f64_block(&self, at: usize, len: usize) -> &[f64] {
+        let bytes = &self.map[at..at + 8 * len];
+        // Safety: `open` checked the map is 8-aligned, offsets are 8-aligned
+        // and in bounds, and the host is little-endian.
+        unsafe { std::slice::from_raw_parts(bytes.as_ptr().cast::<f64>(), len) }
+    }
+
+    fn u64_block(&self, at: usize, len: usize) -> &[u64] {
+        let bytes = &self.map[at..at + 8 * len];
+        // Safety: as for `f64_block`.
+        unsafe { std::slice::from_raw_parts(bytes.as_ptr().cast::<u64>(), len) }
+    }
+
+    /// CPU DLPack tensor over `len` elements at `at`; the tensor keeps the
+    /// mapping alive and is flagged read-only.
+    fn dlpack_block(
+        &self,
+        at: usize,
+        shape: Vec<i64>,
+        code: dlpk::sys::DLDataTypeCode,
+    ) -> dlpk::DLPackTensor {
+        let mut manager = Box::new(MmapDlpackManager {
+            _map: Arc::clone(&self.map),
+            shape,
+        });
+        let data_ptr = self.map[at..].as_ptr() as *mut std::ffi::c_void;
+        let shape_ptr = manager.shape.as_mut_ptr();
+        let ndim = manager.shape.len() as i32;
+        let managed = dlpk::sys::DLManagedTensorVersioned {
+            version: dlpk::sys::DLPackVersion {
+                major: dlpk::sys::DLPACK_MAJOR_VERSION,
+                minor: dlpk::sys::DLPACK_MINOR_VERSION,
+            },
+            manager_ctx: Box::into_raw(manager) as *mut std::ffi::c_void,
+            deleter: Some(mmap_dlpack_deleter),
+            flags: dlpk::sys::DLPACK_FLAG_BITMASK_READ_ONLY as u64,
+            dl_tensor: dlpk::sys::DLTensor {
+                data: data_ptr,
+                device: dlpk::sys::DLDevice::cpu(),
+                ndim,
+                dtype: dlpk::sys::DLDataType {
+                    code,
+                    bits: 64,
+                    lanes: 1,
+                },
+                shape: shape_ptr,
+                strides: std::ptr::null_mut(),
+                byte_offset: 0,
+            },
+        };
+        // Safety: valid DLManagedTensorVersioned; the deleter drops the
+        // manager (mapping handle + shape) exactly once.
+        unsafe { dlpk::DLPackTensor::from_raw(managed) }
+    }
+}
+
+/// Owner behind a DLPack tensor into a `.conb` mapping.
+struct MmapDlpackManager {
+    _map: Arc<memmap2::Mmap>,
+    shape: Vec<i64>,
+}
+
+unsafe extern "C" fn mmap_dlpack_deleter(managed: *mut dlpk::sys::DLManagedTensorVersioned) {
+    if managed.is_null() {
+        return;
+    }
+    // Only free our manager_ctx; the outer dlpk deleter (from_raw) frees
+    // the managed allocation itself.
+    unsafe {
+        let ctx = (*managed).manager_ctx;
+        if !ctx.is_null() {
+            let _ = Box::from_raw(ctx as *mut MmapDlpackManager);
+            (*managed).manager_ctx = std::ptr::null_mut();
+        }
+    }
+}
+
+/// Borrowed view of one `.conb` frame; column accessors slice the mapping.
+#[derive(Clone, Copy)]
+pub struct ConbFrameView<'a> {
+    file: &'a ConbFile,
+    record: &'a ConbFrameRecord,
+}
+
+impl<'a> ConbFrameView<'a> {
+    pub fn record(&self) -> &'a ConbFrameRecord {
+        self.record
+    }
+
+    pub fn natoms(&self) -> usize {
+        self.record.natoms as usize
+    }
+
+    fn optional(&self, bit: u8) -> Option<&'a [f64]> {
+        let (at, len) = self.record.column(bit)?;
+        Some(self.file.f64_block(at, len))
+    }
+
+    /// Row-major `(N, 3)` positions.
+    pub fn positions(&self) -> &'a [f64] {
+        self.optional(0).expect("positions are always present")
+    }
+
+    pub fn velocities(&self) -> Option<&'a [f64]> {
+        self.optional(COLUMN_VELOCITIES)
+    }
+
+    pub fn forces(&self) -> Option<&'a [f64]> {
+        self.optional(COLUMN_FORCES)
+    }
+
+    pub fn energies(&self) -> Option<&'a [f64]> {
+        self.optional(COLUMN_ENERGIES)
+    }
+
+    pub fn charges(&self) -> Option<&'a [f64]> {
+        self.optional(COLUMN_CHARGES)
+    }
+
+    pub fn spins(&self) -> Option<&'a [f64]> {
+        self.optional(COLUMN_SPINS)
+    }
+
+    pub fn magmoms(&self) -> Option<&'a [f64]> {
+        self.optional(COLUMN_MAGMOMS)
+    }
+
+    pub fn atom_ids(&self) -> &'a [u64] {
+        self.file.u64_block(self.record.ids_offset(), self.natoms())
+    }
+
+    /// Per-atom fixed bitmasks (see [`crate::types::decode_fixed_bitmask`]).
+    pub fn fixed_masks(&self) -> &'a [u8] {
+        let at = self.record.ids_offset() + 8 * self.natoms();
+        &self.file.map[at..at + self.natoms()]
+    }
+
+    /// Decode the header blob (cell, lines, metadata, type runs).
+    pub fn header(&self) -> io::Result<FrameHeader> {
+        Ok(self.decode_header()?.0)
+    }
+
+    fn decode_header(&self) -> io::Result<(FrameHeader, Vec<Arc<str>>)> {
+        let (start, end) = (self.record.offset as usize, self.record.columns_offset as usize);
+        decode_header(&self.file.map[start..end])
+    }
+
+    fn dlpack(&self, bit: u8, width: usize) -> Option<dlpk::DLPackTensor> {
+        let (at, _) = self.record.column(bit)?;
+        let n = self.natoms() as i64;
+        let shape = if width == 3 { vec![n, 3] } else { vec![n] };
+        Some(self.file.dlpack_block(at, shape, dlpk::sys::DLDataTypeCode::kDLFloat))
+    }
+
+    /// Read-only `(N, 3)` float64 DLPack tensor over the mapped positions.
+    pub fn positions_dlpack(&self) -> dlpk::DLPackTensor {
+        self.dlpack(0, 3).expect("positions are always present")
+    }
+
+    pub fn velocities_dlpack(&self) -> Option<dlpk::DLPackTensor> {
+        self.dlpack(COLUMN_VELOCITIES, 3)
+    }
+
+    pub fn forces_dlpack(&self) -> Option<dlpk::DLPackTensor> {
+        self.dlpack(COLUMN_FORCES, 3)
+    }
+
+    pub fn energies_dlpack(&self) -> Option<dlpk::DLPackTensor> {
+        self.dlpack(COLUMN_ENERGIES, 1)
+    }
+
+    /// Read-only `(N,)` uint64 DLPack tensor over the mapped atom ids.
+    pub fn atom_ids_dlpack(&self) -> dlpk::DLPackTensor {
+        let shape = vec![self.natoms() as i64];
+        self.file
+            .dlpack_block(self.record.ids_offset(), shape, dlpk::sys::DLDataTypeCode::kDLUInt)
+    }
+
+    /// Rebuild an owned [`ConFrame`] from the mapped blocks.
+    pub fn to_frame(&self) -> io::Result<ConFrame> {
+        let (header, symbols) = self.decode_header()?;
+        let n = self.natoms();
+        if header.natms_per_type.iter().sum::<usize>() != n {
+            return Err(invalid("type runs disagree with natoms"));
+        }
+        let pos = self.positions();
+        let vel = self.velocities();
+        let frc = self.forces();
+        let eng = self.energies();
+        let chg = self.charges();
+        let spn = self.spins();
+        let mm = self.magmoms();
+        let ids = self.atom_ids();
+        let fixed = self.fixed_masks();
+        let row = |block: Option<&[f64]>, i: usize| {
+            block.map(|b| [b[3 * i], b[3 * i + 1], b[3 * i + 2]])
+        };
+        let mut atom_data = Vec::with_capacity(n);
+        for (symbol, &count) in symbols.iter().zip(&header.natms_per_type) {
+            for _ in 0..count {
+                let i = atom_data.len();
+                atom_data.push(AtomDatum {
+                    symbol: Arc::clone(symbol),
+                    x: pos[3 * i],
+                    y: pos[3 * i + 1],
+                    z: pos[3 * i + 2],
+                    fixed: crate::types::decode_fixed_bitmask(fixed[i]),
+                    atom_id: ids[i],
+                    velocity: row(vel, i),
+                    force: row(frc, i),
+                    energy: eng.map(|e| e[i]),
+                    charge: chg.map(|c| c[i]),
+                    spin: spn.map(|s| s[i]),
+                    magmom: row(mm, i),
+                });
+            }
+        }
+        Ok(crate::types::con_frame_from_atom_data(header, atom_data))
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use crate::iterators::ConFrameIterator;
+
+    fn fixture(name: &str) -> PathBuf {
+        PathBuf::from(env!("CARGO_MANIFEST_DIR")).join("resources/test").join(name)
+    }
+
+    fn frames_of(name: &str) -> Vec<ConFrame> {
+        let text = std::fs::read_to_string(fixture(name)).unwrap();
+        ConFrameIterator::new(&text).map(Result::unwrap).collect()
+    }
+
+    fn write_conb(path: &Path, frames: &[ConFrame]) {
+        let mut writer = ConbWriter::from_path(path).unwrap();
+        writer.extend(frames).unwrap();
+        writer.finish().unwrap();
+    }
+
+    #[test]
+    fn frames_round_trip_losslessly() {
+        let dir = tempfile::tempdir().expect("tempdir");
+        for name in [
+            "tiny_multi_cuh2.con",
+            "tiny_multi_cuh2.convel",
+            "tiny_cuh2_vel_forces.con",
+            "tiny_cuh2_charges_spins_magmoms.con",
+            "sulfolene.con",
+        ] {
+            let frames = frames_of(name);
+            let path = dir.path().join(format!("{name}.conb"));
+            write_conb(&path, &frames);
+            let conb = ConbFile::open(&path).unwrap();
+            assert_eq!(conb.len(), frames.len(), "{name}");
+            for (i, expected) in frames.iter().enumerate() {
+                let got = conb.read_frame(i).unwrap();
+                assert_eq!(&got, expected, "{name} frame {i}");
+                assert_eq!(
+                    got.header.prebox_header.metadata_line(),
+                    expected.header.prebox_header.metadata_line()
+                );
+                assert_eq!(conb.projection(i).unwrap(), FrameIndexProjection::from_frame(expected));
+            }
+            assert!(conb.read_frame(frames.len()).is_err());
+        }
+    }
+
+    #[test]
+    fn views_slice_the_mapping() {
+        let frames = frames_of("tiny_cuh2_vel_forces.con");
+        let dir = tempfile::tempdir().expect("tempdir");
+        let path = dir.path().join("vf.conb");
+        write_conb(&path, &frames);
+        let conb = ConbFile::open(&path).unwrap();
+        let view = conb.frame(0).unwrap();
+        let frame = &frames[0];
+        assert_eq!(view.positions(), frame.positions.as_f64_slice().unwrap());
+        assert_eq!(view.forces().unwrap(), frame.forces.as_f64_slice().unwrap());
+        assert_eq!(view.velocities().unwrap(), frame.velocities.as_f64_slice().unwrap());
+        assert_eq!(view.energies(), None);
+        assert_eq!(view.atom_ids(), frame.atom_ids.as_slice().unwrap());
+        let map = conb.map.as_ptr_range();
+        assert!(map.contains(&view.positions().as_ptr().cast::<u8>()));
+
+        let tensor = view.positions_dlpack();
+        assert_eq!(tensor.shape(), &[view.natoms() as i64, 3]);
+        let data = tensor.data_ptr::<f64>().expect("data_ptr");
+        assert_eq!(data, view.positions().as_ptr());
+        assert!(view.energies_dlpack().is_none());
+    }
+
+    #[test]
+    fn storage_dtypes_are_reapplied() {
+        let mut frames = frames_of("tiny_multi_cuh2.con");
+        let dtypes = StorageDtypes {
+            positions: ElementKind::Float32,
+            ..StorageDtypes::default()
+        };
+        for f in &mut frames {
+            f.project_storage_dtypes(&dtypes);
+        }
+        let dir = tempfile::tempdir().expect("tempdir");
+        let path = dir.path().join("f32.conb");
+        write_conb(&path, &frames);
+        let conb = ConbFile::open(&path).unwrap();
+        assert_eq!(conb.records()[0].storage_dtypes, dtypes);
+        let back = conb.read_frame(1).unwrap();
+        assert_eq!(back.positions.kind(), ElementKind::Float32);
+        assert_eq!(back.positions, frames[1].positions);
+        assert_eq!(back.atom_data, frames[1].atom_data);
+    }
+
+    #[test]
+    fn cache_is_rebuilt_when_stale() {
+        let dir = tempfile::tempdir().expect("tempdir");
+        let path = dir.path().join("multi.con");
+        std::fs::copy(fixture("tiny_multi_cuh2.con"), &path).unwrap();
+        assert!(ConbFile::open_fresh(&path).is_none());
+        let conb = ConbFile::open_or_build(&path).unwrap();
+        assert_eq!(conb.len(), 2);
+        assert!(ConbFile::open_fresh(&path).is_some());
+
+        // Appending the frames again changes the length, invalidating the stamp.
+        let text = std::fs::read(&path).unwrap();
+        let mut f = std::fs::OpenOptions::new().append(true).open(&path).unwrap();
+        f.write_all(&text).unwrap();
+        drop(f);
+        assert!(ConbFile::open_fresh(&path).is_none());
+        let rebuilt = ConbFile::open_or_build(&path).unwrap();
+        assert_eq!(rebuilt.len(), 4);
+        assert!(rebuilt.is_fresh(&path));
+    }
+
+    #[test]
+    fn corrupt_files_are_rejected() {
+        let frames = frames_of("tiny_multi_cuh2.con");
+        let dir = tempfile::tempdir().expect("tempdir");
+        let path = dir.path().join("bad.conb");
+        write_conb(&path, &frames);
+        let mut bytes = std::fs::read(&path).unwrap();
+        bytes.truncate(bytes.len() - CONB_RECORD_SIZE);
+        std::fs::write(&path, &bytes).unwrap();
+        assert!(ConbFile::open(&path).is_err());
+        std::fs::write(&path, b"not a conb file").unwrap();
+        assert!(ConbFile::open(&path).is_err());
+    }
+}
@@ -84,6 +84,16 @@ mod stubs {
         disabled()
     }
 
+    /// Stream every trajectory step into `sink`.
+    ///
+    /// Stub without the `chemfiles` feature — always returns [`ChemfilesImportError::FeatureDisabled`].
+    pub fn for_each_con_frame_in_trajectory_path<P: AsRef<Path>>(
+        _path: P,
+        _sink: impl FnMut(ConFrame) -> std::ops::ControlFlow<()>,
+    ) -> Result<usize, ChemfilesImportError> {
+        disabled()
+    }
+
     /// Read the first frame from a trajectory path.
     ///
     /// Stub without the `chemfiles` feature — always returns [`ChemfilesImportError::FeatureDisabled`].
@@ -10,6 +10,7 @@
 
 use std::collections::BTreeMap;
 use std::fmt;
+use std::ops::ControlFlow;
 use std::path::Path;
 
 use chemfiles::{BondOrder, CellShape, Frame, Property, Trajectory, UnitCell};
@@ -410,16 +411,34 @@ pub fn con_frame_from_chemfiles(frame: &Frame) -> Result<ConFrame, ChemfilesImpo
 pub fn con_frames_from_trajectory_path<P: AsRef<Path>>(
     path: P,
 ) -> Result<Vec<ConFrame>, ChemfilesImportError> {
+    let mut frames = Vec::new();
+    for_each_con_frame_in_trajectory_path(path, |frame| {
+        frames.push(frame);
+        ControlFlow::Continue(())
+    })?;
+    Ok(frames)
+}
+
+/// Stream every step of a trajectory into `sink` as a [`ConFrame`], one
+/// chemfiles frame buffer reused throughout; `ControlFlow::Break` stops early.
+///
+/// Returns the number of frames delivered. Memory stays at one converted
+/// frame regardless of trajectory length.
+pub fn for_each_con_frame_in_trajectory_path<P: AsRef<Path>>(
+    path: P,
+    mut sink: impl FnMut(ConFrame) -> ControlFlow<()>,
+) -> Result<usize, ChemfilesImportError> {
     let path = path.as_ref();
     let mut traj = Trajectory::open(path, 'r')?;
     let nsteps = traj.nsteps();
-    let mut frames = Vec::with_capacity(nsteps);
     let mut chfl_frame = Frame::new();
-    for _ in 0..nsteps {
+    for step in 0..nsteps {
         traj.read(&mut chfl_frame)?;
-        frames.push(con_frame_from_chemfiles(&chfl_frame)?);
+        if sink(con_frame_from_chemfiles(&chfl_frame)?).is_break() {
+            return Ok(step + 1);
+        }
     }
-    Ok(frames)
+    Ok(nsteps)
 }
 
 /// Read the first frame from a trajectory path.
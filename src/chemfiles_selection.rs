@@ -77,6 +77,39 @@ impl MultiFrameSelectionResult {
     }
 }
 
+/// A chemfiles selection parsed once and evaluated on many frames.
+///
+/// The free functions ([`evaluate_selection_on_con_frame`], …) parse the
+/// selection string and rebuild a chemfiles frame atom by atom on every call.
+/// A compiled selection keeps the parsed selection and its last projected
+/// frame: while atom count, symbols, chemfiles name / type sidecars, bonds
+/// and the velocity / scalar-property layout match the previous frame, only
+/// the cell, positions, velocities and scalar properties are copied in. A
+/// topology change rebuilds the projection once.
+///
+/// [`Self::evaluate`] reuses that state (one evaluation at a time, hence
+/// `&mut self`); [`Self::evaluate_frames`] runs a whole trajectory, split
+/// across worker threads with the `parallel` feature, each worker holding
+/// its own projection.
+pub struct CompiledSelection {
+    selection: String,
+    context_size: usize,
+    #[cfg(feature = "chemfiles")]
+    state: imp::ProjectionState,
+}
+
+impl CompiledSelection {
+    /// Selection string this handle evaluates.
+    pub fn selection(&self) -> &str {
+        &self.selection
+    }
+
+    /// 1 = atom, 2 = pair/bond, 3 = angle, 4 = dihedral.
+    pub fn context_size(&self) -> usize {
+        self.context_size
+    }
+}
+
 #[cfg(feature = "chemfiles")]
 #[path = "chemfiles_selection_imp.rs"]
 mod imp;
@@ -137,6 +170,32 @@ pub fn select_atom_positions_on_frames(
     Err(ChemfilesImportError::FeatureDisabled)
 }
 
+#[cfg(not(feature = "chemfiles"))]
+impl CompiledSelection {
+    /// Parse `selection` once (stub without `chemfiles` feature).
+    pub fn new(_selection: &str) -> Result<Self, ChemfilesImportError> {
+        Err(ChemfilesImportError::FeatureDisabled)
+    }
+
+    /// Evaluate on one frame (stub without `chemfiles` feature).
+    pub fn evaluate(&mut self, _frame: &ConFrame) -> Result<SelectionResult, ChemfilesImportError> {
+        Err(ChemfilesImportError::FeatureDisabled)
+    }
+
+    /// Atom-context indices on one frame (stub without `chemfiles` feature).
+    pub fn atom_indices(&mut self, _frame: &ConFrame) -> Result<Vec<usize>, ChemfilesImportError> {
+        Err(ChemfilesImportError::FeatureDisabled)
+    }
+
+    /// Evaluate on every frame (stub without `chemfiles` feature).
+    pub fn evaluate_frames<F: std::borrow::Borrow<ConFrame> + Sync>(
+        &self,
+        _frames: &[F],
+    ) -> Result<MultiFrameSelectionResult, ChemfilesImportError> {
+        Err(ChemfilesImportError::FeatureDisabled)
+    }
+}
+
 #[cfg(all(test, not(feature = "chemfiles")))]
 mod stub_tests {
     use super::*;
@@ -159,4 +218,10 @@ mod stub_tests {
         let err2 = select_atom_positions_on_frames("name H", &[frame2]).unwrap_err();
         assert!(matches!(err2, ChemfilesImportError::FeatureDisabled));
     }
+
+    #[test]
+    fn compiled_selection_stub_is_feature_disabled() {
+        let err = CompiledSelection::new("name O").err().expect("stub");
+        assert!(matches!(err, ChemfilesImportError::FeatureDisabled));
+    }
 }
@@ -5,13 +5,16 @@
 //! a [`ConFrame`](crate::types::ConFrame) by projecting it into a temporary
 //! chemfiles [`Frame`](chemfiles::Frame).
 
+use std::borrow::Borrow;
+use std::sync::Arc;
+
 use chemfiles::{Atom, BondOrder, Frame, Selection, UnitCell};
 use serde_json::Value;
 
 use crate::chemfiles_import::{
     ChemfilesImportError, CHEMFILES_ATOM_NAMES_KEY, CHEMFILES_ATOM_TYPES_KEY,
 };
-use crate::types::ConFrame;
+use crate::types::{meta, ConFrame};
 
 /// Chemfiles display name / atomic type for one CON atom, from optional import sidecars.
 ///
@@ -81,23 +84,40 @@ pub fn apply_con_bonds_to_chemfiles_frame(frame: &ConFrame, chfl: &mut Frame) {
     }
 }
 
-use super::{SelectionMatch, SelectionResult};
+use super::{CompiledSelection, FrameSelectionSlice, SelectionMatch, SelectionResult};
 
-pub fn chemfiles_frame_from_con_frame(frame: &ConFrame) -> Result<Frame, ChemfilesImportError> {
-    let mut chfl = Frame::new();
+/// Chemfiles cell for the CON box (all-nonpositive lengths = infinite).
+fn unit_cell_of(frame: &ConFrame) -> UnitCell {
     let cell = frame.header.boxl;
     let angles = frame.header.angles;
     let is_ortho = (angles[0] - 90.0).abs() < 1e-6
         && (angles[1] - 90.0).abs() < 1e-6
         && (angles[2] - 90.0).abs() < 1e-6;
-    let unit_cell = if cell.iter().all(|&c| c <= 0.0) {
+    if cell.iter().all(|&c| c <= 0.0) {
         UnitCell::infinite()
     } else if is_ortho {
         UnitCell::new(cell)
     } else {
         UnitCell::triclinic(cell, angles)
-    };
-    chfl.set_cell(&unit_cell);
+    }
+}
+
+/// Copy step / energy / time from CON metadata (the keys selection filters see).
+fn apply_scalar_properties(frame: &ConFrame, chfl: &mut Frame) {
+    if let Some(idx) = frame.header.frame_index() {
+        chfl.set_step(idx as usize);
+    }
+    if let Some(e) = frame.header.energy() {
+        chfl.set("energy", e);
+    }
+    if let Some(t) = frame.header.time() {
+        chfl.set("time", t);
+    }
+}
+
+pub fn chemfiles_frame_from_con_frame(frame: &ConFrame) -> Result<Frame, ChemfilesImportError> {
+    let mut chfl = Frame::new();
+    chfl.set_cell(&unit_cell_of(frame));
 
     let n = frame.atom_data.len();
     let mut need_vel = false;
@@ -140,18 +160,8 @@ pub fn chemfiles_frame_from_con_frame(frame: &ConFrame) -> Result<Frame, Chemfil
         )));
     }
 
-    // Preserve step from metadata when present.
-    if let Some(idx) = frame.header.frame_index() {
-        chfl.set_step(idx as usize);
-    }
-
-    // Copy a few scalar frame properties useful for selection filters.
-    if let Some(e) = frame.header.energy() {
-        chfl.set("energy", e);
-    }
-    if let Some(t) = frame.header.time() {
-        chfl.set("time", t);
-    }
+    // Preserve step and a few scalar properties useful for selection filters.
+    apply_scalar_properties(frame, &mut chfl);
 
     // Optional topology: enables bonds:/angles:/is_bonded selections.
     apply_con_bonds_to_chemfiles_frame(frame, &mut chfl);
@@ -165,9 +175,14 @@ pub fn evaluate_selection_on_chemfiles_frame(
     frame: &Frame,
 ) -> Result<SelectionResult, ChemfilesImportError> {
     let mut sel = Selection::new(selection).map_err(ChemfilesImportError::from)?;
+    Ok(run_selection(&mut sel, selection, frame))
+}
+
+/// Evaluate an already-parsed selection and convert its matches.
+fn run_selection(sel: &mut Selection, selection: &str, frame: &Frame) -> SelectionResult {
     let context_size = sel.size();
-    let matches_raw = sel.evaluate(frame);
-    let matches = matches_raw
+    let matches = sel
+        .evaluate(frame)
         .into_iter()
         .map(|m| {
             let size = m.len();
@@ -180,11 +195,11 @@ pub fn evaluate_selection_on_chemfiles_frame(
             SelectionMatch { size, atoms }
         })
         .collect();
-    Ok(SelectionResult {
+    SelectionResult {
         selection: selection.to_string(),
         context_size,
         matches,
-    })
+    }
 }
 
 /// Evaluate selection on a readcon [`ConFrame`] (projects to chemfiles first).
@@ -230,29 +245,30 @@ pub fn evaluate_selection_on_frames(
     selection: &str,
     frames: &[ConFrame],
 ) -> Result<super::MultiFrameSelectionResult, ChemfilesImportError> {
-    let mut out = Vec::with_capacity(frames.len());
-    for (frame_index, frame) in frames.iter().enumerate() {
-        let result = evaluate_selection_on_con_frame(selection, frame)?;
-        let (atom_indices, positions) = if result.context_size == 1 {
-            let mut idxs = result.primary_indices();
-            idxs.sort_unstable();
-            idxs.dedup();
-            let pos = positions_for_atom_indices(frame, &idxs);
-            (idxs, pos)
-        } else {
-            (Vec::new(), Vec::new())
-        };
-        out.push(super::FrameSelectionSlice {
-            frame_index,
-            result,
-            positions,
-            atom_indices,
-        });
+    CompiledSelection::new(selection)?.evaluate_frames(frames)
+}
+
+/// Per-frame slice: atom-context results also carry sorted unique indices + xyz.
+fn frame_slice(
+    frame_index: usize,
+    frame: &ConFrame,
+    result: SelectionResult,
+) -> FrameSelectionSlice {
+    let (atom_indices, positions) = if result.context_size == 1 {
+        let mut idxs = result.primary_indices();
+        idxs.sort_unstable();
+        idxs.dedup();
+        let pos = positions_for_atom_indices(frame, &idxs);
+        (idxs, pos)
+    } else {
+        (Vec::new(), Vec::new())
+    };
+    FrameSelectionSlice {
+        frame_index,
+        result,
+        positions,
+        atom_indices,
     }
-    Ok(super::MultiFrameSelectionResult {
-        selection: selection.to_string(),
-        frames: out,
-    })
 }
 
 /// Atom-context multi-frame selection: same as [`evaluate_selection_on_frames`] but
@@ -287,6 +303,191 @@ pub fn parse_selection_string(selection: &str) -> Result<usize, ChemfilesImportE
     Ok(sel.size())
 }
 
+/// What the projected chemfiles frame was built from, beyond coordinates.
+///
+/// A frame matching the key only needs cell, positions, velocities and scalar
+/// properties copied in; anything else (atom count, symbols, name / type
+/// sidecars, bonds, velocity or property presence) forces a rebuild. Chemfiles
+/// has no way to drop a frame property, so presence is part of the key too.
+struct TopologyKey {
+    symbols: Vec<Arc<str>>,
+    names: Option<Value>,
+    types: Option<Value>,
+    bonds: Option<Value>,
+    has_velocities: bool,
+    has_step: bool,
+    has_energy: bool,
+    has_time: bool,
+}
+
+impl TopologyKey {
+    fn of(frame: &ConFrame) -> Self {
+        let header = &frame.header;
+        Self {
+            symbols: frame.atom_data.iter().map(|a| Arc::clone(&a.symbol)).collect(),
+            names: header.metadata.get(CHEMFILES_ATOM_NAMES_KEY).cloned(),
+            types: header.metadata.get(CHEMFILES_ATOM_TYPES_KEY).cloned(),
+            bonds: header.metadata.get(meta::BONDS).cloned(),
+            has_velocities: frame.atom_data.iter().any(|a| a.velocity.is_some()),
+            has_step: header.frame_index().is_some(),
+            has_energy: header.energy().is_some(),
+            has_time: header.time().is_some(),
+        }
+    }
+
+    /// Compare without allocating; symbols shared through the header cache
+    /// usually hit the pointer check.
+    fn matches(&self, frame: &ConFrame) -> bool {
+        let header = &frame.header;
+        self.symbols.len() == frame.atom_data.len()
+            && self
+                .symbols
+                .iter()
+                .zip(&frame.atom_data)
+                .all(|(s, a)| Arc::ptr_eq(s, &a.symbol) || **s == *a.symbol)
+            && self.names.as_ref() == header.metadata.get(CHEMFILES_ATOM_NAMES_KEY)
+            && self.types.as_ref() == header.metadata.get(CHEMFILES_ATOM_TYPES_KEY)
+            && self.bonds.as_ref() == header.metadata.get(meta::BONDS)
+            && self.has_velocities == frame.atom_data.iter().any(|a| a.velocity.is_some())
+            && self.has_step == header.frame_index().is_some()
+            && self.has_energy == header.energy().is_some()
+            && self.has_time == header.time().is_some()
+    }
+}
+
+/// Parsed selection plus the chemfiles frame it last ran on.
+pub(super) struct ProjectionState {
+    selection: Selection,
+    projected: Option<(Frame, TopologyKey)>,
+}
+
+impl ProjectionState {
+    pub(super) fn new(selection: &str) -> Result<Self, ChemfilesImportError> {
+        Ok(Self {
+            selection: Selection::new(selection).map_err(ChemfilesImportError::from)?,
+            projected: None,
+        })
+    }
+
+    pub(super) fn context_size(&self) -> usize {
+        self.selection.size()
+    }
+
+    pub(super) fn evaluate(
+        &mut self,
+        selection: &str,
+        frame: &ConFrame,
+    ) -> Result<SelectionResult, ChemfilesImportError> {
+        match &mut self.projected {
+            Some((chfl, key)) if key.matches(frame) => refresh_projection(frame, chfl),
+            projected => {
+                // Drop the stale projection first so a failed rebuild is not reused.
+                *projected = None;
+                let chfl = chemfiles_frame_from_con_frame(frame)?;
+                *projected = Some((chfl, TopologyKey::of(frame)));
+            }
+        }
+        let (chfl, _) = self.projected.as_ref().expect("projection set above");
+        Ok(run_selection(&mut self.selection, selection, chfl))
+    }
+}
+
+/// Overwrite the per-frame parts of a projection whose topology still matches.
+fn refresh_projection(frame: &ConFrame, chfl: &mut Frame) {
+    chfl.set_cell(&unit_cell_of(frame));
+    for (dst, atom) in chfl.positions_mut().iter_mut().zip(&frame.atom_data) {
+        *dst = [atom.x, atom.y, atom.z];
+    }
+    if let Some(vels) = chfl.velocities_mut() {
+        for (dst, atom) in vels.iter_mut().zip(&frame.atom_data) {
+            *dst = atom.velocity.unwrap_or_default();
+        }
+    }
+    apply_scalar_properties(frame, chfl);
+}
+
+impl CompiledSelection {
+    /// Parse `selection` once; errors on invalid grammar.
+    pub fn new(selection: &str) -> Result<Self, ChemfilesImportError> {
+        let state = ProjectionState::new(selection)?;
+        Ok(Self {
+            selection: selection.to_string(),
+            context_size: state.context_size(),
+            state,
+        })
+    }
+
+    /// Evaluate on `frame`, reusing the previous projection when the topology
+    /// is unchanged.
+    pub fn evaluate(&mut self, frame: &ConFrame) -> Result<SelectionResult, ChemfilesImportError> {
+        self.state.evaluate(&self.selection, frame)
+    }
+
+    /// Sorted unique atom indices (atom-context selections only).
+    pub fn atom_indices(&mut self, frame: &ConFrame) -> Result<Vec<usize>, ChemfilesImportError> {
+        if self.context_size != 1 {
+            return Err(ChemfilesImportError::InvalidFrame(format!(
+                "atom_indices requires atom context (size 1), got {}",
+                self.context_size
+            )));
+        }
+        let mut idxs = self.evaluate(frame)?.primary_indices();
+        idxs.sort_unstable();
+        idxs.dedup();
+        Ok(idxs)
+    }
+
+    /// Evaluate on every frame, like [`evaluate_selection_on_frames`].
+    ///
+    /// With the `parallel` feature the frames are split into contiguous runs
+    /// across the rayon pool; each worker parses its own copy of the selection
+    /// and keeps its own projection, so runs of same-topology frames refresh in
+    /// place. Output order matches `frames`. This handle's own projection is
+    /// left untouched.
+    ///
+    /// `frames` may hold frames or references to them (`&[ConFrame]` or
+    /// `&[&ConFrame]`).
+    pub fn evaluate_frames<F: Borrow<ConFrame> + Sync>(
+        &self,
+        frames: &[F],
+    ) -> Result<super::MultiFrameSelectionResult, ChemfilesImportError> {
+        let selection = self.selection.as_str();
+        #[cfg(feature = "parallel")]
+        let out = {
+            use rayon::prelude::*;
+            frames
+                .par_iter()
+                .enumerate()
+                .with_min_len(16)
+                .map_init(
+                    || ProjectionState::new(selection),
+                    |state, (i, frame)| {
+                        let frame = frame.borrow();
+                        let state = state.as_mut().map_err(|e| {
+                            ChemfilesImportError::InvalidFrame(format!("selection: {e}"))
+                        })?;
+                        Ok(frame_slice(i, frame, state.evaluate(selection, frame)?))
+                    },
+                )
+                .collect::<Result<Vec<_>, ChemfilesImportError>>()?
+        };
+        #[cfg(not(feature = "parallel"))]
+        let out = {
+            let mut state = ProjectionState::new(selection)?;
+            let mut out = Vec::with_capacity(frames.len());
+            for (i, frame) in frames.iter().enumerate() {
+                let frame = frame.borrow();
+                out.push(frame_slice(i, frame, state.evaluate(selection, frame)?));
+            }
+            out
+        };
+        Ok(super::MultiFrameSelectionResult {
+            selection: self.selection.clone(),
+            frames: out,
+        })
+    }
+}
+
 /// Helper for tests/metadata: read optional f64 from frame header metadata.
 #[allow(dead_code)]
 fn meta_f64(frame: &ConFrame, key: &str) -> Option<f64> {
@@ -427,6 +628,46 @@ mod tests {
         assert!(empty.matches.is_empty());
     }
 
+    #[test]
+    fn compiled_selection_refreshes_positions_in_place() {
+        let mut sel = CompiledSelection::new("name H and x > 0.5").expect("compile");
+        let mut frame = water_con_frame();
+        assert_eq!(sel.atom_indices(&frame).unwrap(), vec![1]);
+        // Same topology: only coordinates move, the answer must follow them.
+        frame.atom_data[1].x = -0.96;
+        frame.atom_data[2].x = 0.75;
+        assert_eq!(sel.atom_indices(&frame).unwrap(), vec![2]);
+        assert!(sel.state.projected.is_some());
+    }
+
+    #[test]
+    fn compiled_selection_rebuilds_on_topology_change() {
+        use crate::types::Bond;
+        let mut sel = CompiledSelection::new("bonds: all").expect("compile");
+        let mut frame = water_con_frame();
+        assert!(sel.evaluate(&frame).unwrap().matches.is_empty());
+        frame.header.set_bonds(&[Bond::new(0, 1), Bond::new(0, 2)]);
+        assert_eq!(sel.evaluate(&frame).unwrap().matches.len(), 2);
+    }
+
+    #[test]
+    fn compiled_evaluate_frames_matches_per_frame_evaluation() {
+        let mut frames = Vec::new();
+        for k in 0..40 {
+            let mut frame = water_con_frame();
+            frame.atom_data[2].x = if k % 3 == 0 { 1.0 } else { -1.0 };
+            frames.push(frame);
+        }
+        let sel = CompiledSelection::new("name H and x > 0.5").expect("compile");
+        let multi = sel.evaluate_frames(&frames).expect("frames");
+        assert_eq!(multi.frames.len(), frames.len());
+        for (k, slice) in multi.frames.iter().enumerate() {
+            let want = select_atom_indices("name H and x > 0.5", &frames[k]).unwrap();
+            assert_eq!(slice.frame_index, k);
+            assert_eq!(slice.atom_indices, want);
+        }
+    }
+
     #[test]
     fn import_preserves_chemfiles_bonds_in_metadata() {
         use crate::chemfiles_import::con_frame_from_chemfiles;
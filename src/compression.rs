@@ -2,9 +2,11 @@
 // Transparent compression support
 //=============================================================================
 
-use std::io::{self, Read};
+use std::io::{self, BufRead, BufReader, Read};
 use std::path::Path;
 
+use crate::stats::{self, Counter, Stage};
+
 /// Detected compression format based on magic bytes.
 ///
 /// `Zstd` is only constructed when the `zstd` Cargo feature is enabled.
@@ -51,6 +53,58 @@ pub fn detect_compression_from_extension(path: &Path) -> Compression {
     }
 }
 
+/// Read the first 4 bytes of `file` for magic detection (gzip needs 2,
+/// zstd needs 4). Advances the handle's cursor.
+fn sniff_compression(file: &std::fs::File) -> io::Result<Compression> {
+    let mut magic = [0u8; 4];
+    let bytes_read = {
+        let mut f = file;
+        f.read(&mut magic)?
+    };
+    Ok(if bytes_read > 0 {
+        detect_compression(&magic[..bytes_read])
+    } else {
+        Compression::None
+    })
+}
+
+/// Detect the compression of the file at `path` from its magic bytes.
+pub fn detect_path_compression(path: &Path) -> io::Result<Compression> {
+    sniff_compression(&std::fs::File::open(path)?)
+}
+
+/// Opens `path` as a buffered byte stream, decompressing on the fly.
+///
+/// Unlike [`read_file_contents`], nothing is inflated up front: gzip
+/// (including concatenated members) and zstd are decoded as the caller
+/// reads. Pair with [`crate::streaming::StreamingConFrameIterator`] for
+/// constant-memory iteration over compressed trajectories.
+pub fn open_reader(path: &Path) -> Result<Box<dyn BufRead + Send>, Box<dyn std::error::Error>> {
+    let compression = detect_path_compression(path)?;
+    let file = std::fs::File::open(path)?;
+    match compression {
+        Compression::Gzip => Ok(Box::new(BufReader::new(flate2::read::MultiGzDecoder::new(
+            file,
+        )))),
+        Compression::Zstd => {
+            #[cfg(feature = "zstd")]
+            {
+                Ok(Box::new(BufReader::new(zstd::stream::read::Decoder::new(file)?)))
+            }
+            #[cfg(not(feature = "zstd"))]
+            {
+                let _ = file;
+                Err(io::Error::new(
+                    io::ErrorKind::Unsupported,
+                    "zstd-compressed input detected; rebuild readcon-core with --features zstd",
+                )
+                .into())
+            }
+        }
+        Compression::None => Ok(Box::new(BufReader::new(file))),
+    }
+}
+
 /// Size threshold below which we use `read_to_string` instead of mmap.
 const MMAP_THRESHOLD: u64 = 64 * 1024;
 
@@ -64,36 +118,30 @@ const MMAP_THRESHOLD: u64 = 64 * 1024;
 pub fn read_file_contents(path: &Path) -> Result<FileContents, Box<dyn std::error::Error>> {
     let file = std::fs::File::open(path)?;
     let metadata = file.metadata()?;
-
-    // Read first 4 bytes for magic detection (gzip needs 2, zstd needs 4)
-    let mut magic = [0u8; 4];
-    let bytes_read = {
-        let mut f = &file;
-        f.read(&mut magic)?
-    };
-
-    let compression = if bytes_read > 0 {
-        detect_compression(&magic[..bytes_read])
-    } else {
-        Compression::None
-    };
+    let compression = sniff_compression(&file)?;
 
     match compression {
         Compression::Gzip => {
             // Re-open and decompress the entire file
+            let mut timer = stats::timer(Stage::Decompress);
             let file = std::fs::File::open(path)?;
-            let mut decoder = flate2::read::GzDecoder::new(file);
+            let mut decoder = flate2::read::MultiGzDecoder::new(file);
             let mut contents = String::new();
             decoder.read_to_string(&mut contents)?;
+            timer.add_bytes(contents.len() as u64);
+            stats::count(Counter::BuffersAllocated, 1);
             Ok(FileContents::Owned(contents))
         }
         Compression::Zstd => {
             #[cfg(feature = "zstd")]
             {
+                let mut timer = stats::timer(Stage::Decompress);
                 let file = std::fs::File::open(path)?;
                 let mut decoder = zstd::stream::read::Decoder::new(file)?;
                 let mut contents = String::new();
                 decoder.read_to_string(&mut contents)?;
+                timer.add_bytes(contents.len() as u64);
+                stats::count(Counter::BuffersAllocated, 1);
                 Ok(FileContents::Owned(contents))
             }
             #[cfg(not(feature = "zstd"))]
@@ -106,8 +154,11 @@ pub fn read_file_contents(path: &Path) -> Result<FileContents, Box<dyn std::erro
             }
         }
         Compression::None => {
+            let mut timer = stats::timer(Stage::Read);
+            timer.add_bytes(metadata.len());
             if metadata.len() < MMAP_THRESHOLD {
                 let contents = std::fs::read_to_string(path)?;
+                stats::count(Counter::BuffersAllocated, 1);
                 Ok(FileContents::Owned(contents))
             } else {
                 let file = std::fs::File::open(path)?;
@@ -124,6 +175,10 @@ pub enum FileContents {
     Mapped(memmap2::Mmap),
 }
 
+/// Granularity of [`FileContents::release_before`]. A multiple of every
+/// page size in use (4 KiB, 16 KiB, 64 KiB), so range starts stay aligned.
+pub const RELEASE_CHUNK: usize = 16 * 1024 * 1024;
+
 impl FileContents {
     pub fn as_str(&self) -> Result<&str, std::str::Utf8Error> {
         match self {
@@ -131,6 +186,48 @@ impl FileContents {
             FileContents::Mapped(m) => std::str::from_utf8(m),
         }
     }
+
+    /// True when the contents are backed by a memory map.
+    pub fn is_mapped(&self) -> bool {
+        matches!(self, FileContents::Mapped(_))
+    }
+
+    /// Hint the kernel that the mapping is read front to back
+    /// (`madvise(MADV_SEQUENTIAL)`): aggressive read-ahead, early reclaim.
+    ///
+    /// No-op for owned buffers and on non-unix targets. Advice failures are
+    /// ignored; they only affect paging, never correctness.
+    pub fn advise_sequential(&self) {
+        #[cfg(unix)]
+        if let FileContents::Mapped(m) = self {
+            let _ = m.advise(memmap2::Advice::Sequential);
+        }
+    }
+
+    /// Drop resident pages of the mapping below `offset`, rounded down to
+    /// [`RELEASE_CHUNK`], starting at `from` (already released prefix).
+    ///
+    /// Returns the new released prefix length. The mapping is read-only and
+    /// file-backed, so released pages refault from the page cache if touched
+    /// again; callers only use this behind a forward-only cursor to keep RSS
+    /// flat on multi-GB trajectories. No-op for owned buffers and non-unix.
+    pub fn release_before(&self, from: usize, offset: usize) -> usize {
+        #[cfg(unix)]
+        if let FileContents::Mapped(m) = self {
+            let upto = (offset.min(m.len()) / RELEASE_CHUNK) * RELEASE_CHUNK;
+            if upto > from {
+                // SAFETY: read-only file mapping, so every page is clean and
+                // MADV_DONTNEED leaves the observable bytes unchanged (they
+                // refault from the file); only residency changes.
+                let _ = unsafe {
+                    m.unchecked_advise_range(memmap2::UncheckedAdvice::DontNeed, from, upto - from)
+                };
+                return upto;
+            }
+        }
+        let _ = offset;
+        from
+    }
 }
 
 /// Creates a gzip-compressed writer wrapping a file at the given path.
@@ -156,3 +253,184 @@ pub fn zstd_writer(
     let encoder = zstd::stream::write::Encoder::new(file, 3)?;
     Ok(encoder.auto_finish())
 }
+
+//=============================================================================
+// Seekable zstd (independent frame-aligned blocks + seek table)
+//=============================================================================
+
+/// Skippable-frame magic of the zstd seekable format's seek table.
+pub const ZSTD_SEEK_TABLE_MAGIC: u32 = 0x184D_2A5E;
+/// Footer magic closing a zstd seekable-format seek table.
+pub const ZSTD_SEEKABLE_MAGIC: u32 = 0x8F92_EAB1;
+/// Skippable-frame magic of the per-block CON frame counts written just
+/// before the seek table; other zstd readers skip it like any skippable frame.
+pub const ZSTD_FRAME_COUNTS_MAGIC: u32 = 0x184D_2A5F;
+const FRAME_COUNTS_TAG: [u8; 8] = *b"RKRZFCNT";
+const SEEK_FOOTER_SIZE: usize = 9;
+
+/// One independently decodable zstd frame of a seekable file.
+#[derive(Debug, Clone, Copy, PartialEq, Eq)]
+pub struct ZstdSeekBlock {
+    /// Byte offset of the zstd frame in the file.
+    pub compressed_offset: u64,
+    pub compressed_len: u32,
+    /// Decompressed (CON text) length.
+    pub raw_len: u32,
+    /// Index of the first CON frame in the block.
+    pub first_frame: u64,
+    /// CON frames in the block.
+    pub n_frames: u32,
+}
+
+/// Seek table of a seekable `.con.zst`: every block holds whole CON frames,
+/// so frame `i` is found without inflating the blocks before it.
+///
+/// The layout is the zstd seekable format (v0.1, no checksums) preceded by a
+/// skippable frame with the CON frame count of each block. Both are zstd
+/// skippable frames, so the file still decompresses with any zstd reader.
+#[derive(Debug, Clone, PartialEq, Eq)]
+pub struct ZstdSeekTable {
+    pub blocks: Vec<ZstdSeekBlock>,
+}
+
+fn le_u32_at(b: &[u8], at: usize) -> u32 {
+    u32::from_le_bytes(b[at..at + 4].try_into().expect("4 bytes"))
+}
+
+impl ZstdSeekTable {
+    /// Total CON frames across all blocks.
+    pub fn n_frames(&self) -> usize {
+        self.blocks
+            .last()
+            .map_or(0, |b| (b.first_frame + u64::from(b.n_frames)) as usize)
+    }
+
+    /// Block holding CON frame `frame`, or `None` past the end.
+    pub fn block_of_frame(&self, frame: usize) -> Option<usize> {
+        if frame >= self.n_frames() {
+            return None;
+        }
+        Some(self.blocks.partition_point(|b| b.first_frame <= frame as u64) - 1)
+    }
+
+    /// Serialize the trailing skippable frames for blocks given as
+    /// `(compressed_len, raw_len, n_frames)`, in file order.
+    pub(crate) fn encode(blocks: &[(u32, u32, u32)]) -> Vec<u8> {
+        let n = blocks.len();
+        let mut out = Vec::with_capacity(16 + 4 * n + 8 + 8 * n + SEEK_FOOTER_SIZE);
+        out.extend_from_slice(&ZSTD_FRAME_COUNTS_MAGIC.to_le_bytes());
+        out.extend_from_slice(&((8 + 4 * n) as u32).to_le_bytes());
+        out.extend_from_slice(&FRAME_COUNTS_TAG);
+        for &(_, _, frames) in blocks {
+            out.extend_from_slice(&frames.to_le_bytes());
+        }
+        out.extend_from_slice(&ZSTD_SEEK_TABLE_MAGIC.to_le_bytes());
+        out.extend_from_slice(&((8 * n + SEEK_FOOTER_SIZE) as u32).to_le_bytes());
+        for &(compressed, raw, _) in blocks {
+            out.extend_from_slice(&compressed.to_le_bytes());
+            out.extend_from_slice(&raw.to_le_bytes());
+        }
+        out.extend_from_slice(&(n as u32).to_le_bytes());
+        out.push(0); // descriptor: no checksums
+        out.extend_from_slice(&ZSTD_SEEKABLE_MAGIC.to_le_bytes());
+        out
+    }
+
+    /// Read the seek table from the tail of `file`. `Ok(None)` when the file
+    /// has no seek table or no frame counts (plain zstd streams included).
+    pub fn read(file: &std::fs::File) -> io::Result<Option<Self>> {
+        use std::io::{Seek, SeekFrom};
+        let mut f = file;
+        let len = f.metadata()?.len();
+        if len < SEEK_FOOTER_SIZE as u64 {
+            return Ok(None);
+        }
+        let mut footer = [0u8; SEEK_FOOTER_SIZE];
+        f.seek(SeekFrom::Start(len - SEEK_FOOTER_SIZE as u64))?;
+        f.read_exact(&mut footer)?;
+        if le_u32_at(&footer, 5) != ZSTD_SEEKABLE_MAGIC || footer[4] & 0x7c != 0 {
+            return Ok(None);
+        }
+        let n = le_u32_at(&footer, 0) as u64;
+        let entry = if footer[4] & 0x80 != 0 { 12 } else { 8 };
+        let table_len = 8 + n * entry + SEEK_FOOTER_SIZE as u64;
+        let counts_len = 16 + 4 * n;
+        if table_len + counts_len > len {
+            return Ok(None);
+        }
+        let start = len - table_len - counts_len;
+        let mut tail = vec![0u8; (counts_len + table_len) as usize];
+        f.seek(SeekFrom::Start(start))?;
+        f.read_exact(&mut tail)?;
+        let table = &tail[counts_len as usize..];
+        if le_u32_at(&tail, 0) != ZSTD_FRAME_COUNTS_MAGIC
+            || le_u32_at(&tail, 4) as u64 != counts_len - 8
+            || tail[8..16] != FRAME_COUNTS_TAG
+            || le_u32_at(table, 0) != ZSTD_SEEK_TABLE_MAGIC
+            || le_u32_at(table, 4) as u64 != table_len - 8
+        {
+            return Ok(None);
+        }
+        let mut blocks = Vec::with_capacity(n as usize);
+        let (mut offset, mut first_frame) = (0u64, 0u64);
+        for k in 0..n as usize {
+            let at = 8 + k * entry as usize;
+            let block = ZstdSeekBlock {
+                compressed_offset: offset,
+                compressed_len: le_u32_at(table, at),
+                raw_len: le_u32_at(table, at + 4),
+                first_frame,
+                n_frames: le_u32_at(&tail, 16 + 4 * k),
+            };
+            offset += u64::from(block.compressed_len);
+            first_frame += u64::from(block.n_frames);
+            blocks.push(block);
+        }
+        if offset > start {
+            return Err(io::Error::new(
+                io::ErrorKind::InvalidData,
+                "zstd seek table addresses past the end of the data",
+            ));
+        }
+        Ok(Some(Self { blocks }))
+    }
+
+    /// Read and decompress block `k` from `file` (whole CON frames).
+    #[cfg(feature = "zstd")]
+    pub fn read_block(&self, file: &std::fs::File, k: usize) -> io::Result<String> {
+        use std::io::{Seek, SeekFrom};
+        let block = self.blocks.get(k).ok_or_else(|| {
+            io::Error::new(io::ErrorKind::InvalidInput, "seek table block out of range")
+        })?;
+        let mut f = file;
+        f.seek(SeekFrom::Start(block.compressed_offset))?;
+        let mut compressed = vec![0u8; block.compressed_len as usize];
+        f.read_exact(&mut compressed)?;
+        decode_block(&compressed, block)
+    }
+
+    /// Bytes of block `k` within the whole file's contents `data`.
+    pub fn block_bytes<'a>(&self, data: &'a [u8], k: usize) -> Option<&'a [u8]> {
+        let b = self.blocks.get(k)?;
+        let start = b.compressed_offset as usize;
+        data.get(start..start + b.compressed_len as usize)
+    }
+}
+
+/// Decompress one seekable block (`compressed` is exactly its zstd frame).
+#[cfg(feature = "zstd")]
+pub fn decode_block(compressed: &[u8], block: &ZstdSeekBlock) -> io::Result<String> {
+    let raw = zstd::bulk::decompress(compressed, block.raw_len as usize)?;
+    String::from_utf8(raw).map_err(|_| {
+        io::Error::new(io::ErrorKind::InvalidData, "zstd block is not UTF-8 CON text")
+    })
+}
+
+/// Seek table of `path` when it is a seekable zstd file (see [`ZstdSeekTable`]).
+pub fn detect_zstd_seek_table(path: &Path) -> io::Result<Option<ZstdSeekTable>> {
+    let file = std::fs::File::open(path)?;
+    if sniff_compression(&file)? != Compression::Zstd {
+        return Ok(None);
+    }
+    ZstdSeekTable::read(&file)
+}
@@ -2,17 +2,30 @@
 //!
 //! Used by the CLI (`readcon-core convert …`) and callable from Rust without
 //! inventing a second conversion stack. Non-CON inputs require the `chemfiles`
-//! feature at runtime ([`chemfiles_import::chemfiles_enabled`]).
+//! feature at runtime ([`chemfiles_import::chemfiles_enabled`]). `.conb`
+//! ([`crate::binary_cache`]) works on either side: as output it writes the
+//! binary cache instead of text, as input it is decoded without the parser.
+//!
+//! [`convert_path_to_con`] is a streaming pipeline: a reader thread imports
+//! (or parses / inflates) frames into bounded batches, and the calling thread
+//! formats and compresses each batch on the Rayon pool
+//! ([`ParallelConWriter`]) while the reader fills the next one. At most
+//! [`ConvertOptions::prefetch_batches`] + 2 batches are alive at once, so
+//! memory does not grow with trajectory length.
 
 use std::fmt;
+use std::fs;
 use std::io;
-use std::path::Path;
+use std::ops::ControlFlow;
+use std::path::{Path, PathBuf};
+use std::sync::mpsc;
+use std::time::{Duration, Instant};
 
+use crate::binary_cache::{self, ConbFile, ConbWriter};
 use crate::chemfiles_import::{self, ChemfilesImportError};
-use crate::compression;
-use crate::iterators::ConFrameIterator;
+use crate::streaming::StreamingConFrameIterator;
 use crate::types::ConFrame;
-use crate::writer::ConFrameWriter;
+use crate::parallel_writer::ParallelConWriter;
 
 /// Outcome of a successful convert.
 #[derive(Debug, Clone, PartialEq, Eq)]
@@ -23,6 +36,54 @@ pub struct ConvertReport {
     pub n_atoms_last: usize,
     /// True when the input was treated as native CON/convel (no chemfiles).
     pub native_con: bool,
+    /// Size of the input file on disk.
+    pub bytes_read: u64,
+    /// Size of the output file on disk (compressed size for `.gz` / `.zst`).
+    pub bytes_written: u64,
+    /// Wall time from opening the input to closing the output.
+    pub elapsed: Duration,
+}
+
+impl ConvertReport {
+    /// Frames converted per second of wall time.
+    pub fn frames_per_second(&self) -> f64 {
+        self.n_frames as f64 / self.elapsed.as_secs_f64().max(1e-9)
+    }
+
+    /// Input bytes consumed per second of wall time.
+    pub fn read_bytes_per_second(&self) -> f64 {
+        self.bytes_read as f64 / self.elapsed.as_secs_f64().max(1e-9)
+    }
+
+    /// Output bytes produced per second of wall time.
+    pub fn write_bytes_per_second(&self) -> f64 {
+        self.bytes_written as f64 / self.elapsed.as_secs_f64().max(1e-9)
+    }
+}
+
+/// Batching knobs for [`convert_path_to_con_with`].
+#[derive(Debug, Clone, PartialEq, Eq)]
+pub struct ConvertOptions {
+    /// A batch is handed to the writer once it holds this many frames...
+    pub batch_frames: usize,
+    /// ...or this many atoms, whichever comes first (bounds memory for
+    /// large frames).
+    pub batch_atoms: usize,
+    /// Filled batches the reader may queue ahead of the writer.
+    pub prefetch_batches: usize,
+}
+
+impl Default for ConvertOptions {
+    /// One writer window of full chunks per batch (so every worker gets
+    /// whole chunks), capped at 4M atoms, two batches of read-ahead.
+    fn default() -> Self {
+        use crate::parallel_writer::{window_frames, DEFAULT_FRAMES_PER_CHUNK};
+        Self {
+            batch_frames: window_frames(DEFAULT_FRAMES_PER_CHUNK),
+            batch_atoms: 1 << 22,
+            prefetch_batches: 2,
+        }
+    }
 }
 
 /// Errors from path conversion.
@@ -89,62 +150,215 @@ pub fn path_looks_like_con(path: &Path) -> bool {
     base.ends_with(".con") || base.ends_with(".convel")
 }
 
-/// Read frames from a path: native CON/convel via the hot-path iterator, else chemfiles.
-pub fn read_frames_for_convert(input: &Path) -> Result<(Vec<ConFrame>, bool), ConvertError> {
-    if !input.is_file() {
-        return Err(ConvertError::InputMissing(input.display().to_string()));
-    }
-    if path_looks_like_con(input) {
-        // gzip/zstd-aware (same path as library readers)
-        let contents = compression::read_file_contents(input).map_err(|e| {
-            ConvertError::Io(io::Error::other(e.to_string()))
-        })?;
-        let text = contents
-            .as_str()
-            .map_err(|e| ConvertError::Parse(format!("input is not valid UTF-8: {e}")))?;
-        let mut frames = Vec::new();
-        for item in ConFrameIterator::new(text) {
-            match item {
-                Ok(f) => frames.push(f),
-                Err(e) => {
-                    return Err(ConvertError::Parse(e.to_string()));
+/// How an input path is decoded.
+#[derive(Debug, Clone, Copy, PartialEq, Eq)]
+enum InputKind {
+    Conb,
+    Con,
+    Foreign,
+}
+
+impl InputKind {
+    fn of(input: &Path) -> Result<Self, ConvertError> {
+        if !input.is_file() {
+            return Err(ConvertError::InputMissing(input.display().to_string()));
+        }
+        if binary_cache::path_is_conb(input) {
+            Ok(InputKind::Conb)
+        } else if path_looks_like_con(input) {
+            Ok(InputKind::Con)
+        } else if chemfiles_import::chemfiles_enabled() {
+            Ok(InputKind::Foreign)
+        } else {
+            Err(ConvertError::Chemfiles(ChemfilesImportError::FeatureDisabled))
+        }
+    }
+
+    fn native(self) -> bool {
+        self != InputKind::Foreign
+    }
+}
+
+/// Push every frame of `input` into `sink` until it breaks or the input
+/// ends. Native CON goes through [`StreamingConFrameIterator`] (gzip / zstd
+/// inflated incrementally); the first malformed frame aborts.
+fn for_each_input_frame(
+    input: &Path,
+    kind: InputKind,
+    mut sink: impl FnMut(ConFrame) -> ControlFlow<()>,
+) -> Result<(), ConvertError> {
+    match kind {
+        InputKind::Conb => {
+            let conb = ConbFile::open(input)?;
+            for frame in conb.frames() {
+                if sink(frame?).is_break() {
+                    break;
+                }
+            }
+        }
+        InputKind::Con => {
+            let frames = StreamingConFrameIterator::from_path(input)
+                .map_err(|e| ConvertError::Io(io::Error::other(e.to_string())))?;
+            for frame in frames {
+                let frame = frame.map_err(|e| ConvertError::Parse(e.to_string()))?;
+                if sink(frame).is_break() {
+                    break;
                 }
             }
         }
-        if frames.is_empty() {
-            return Err(ConvertError::Empty);
+        InputKind::Foreign => {
+            chemfiles_import::for_each_con_frame_in_trajectory_path(input, sink)?;
         }
-        Ok((frames, true))
-    } else {
-        if !chemfiles_import::chemfiles_enabled() {
-            return Err(ConvertError::Chemfiles(
-                ChemfilesImportError::FeatureDisabled,
-            ));
+    }
+    Ok(())
+}
+
+/// Read frames from a path: native CON/convel via the hot-path iterator, else chemfiles.
+///
+/// Collects the whole input; [`convert_path_to_con`] streams instead.
+pub fn read_frames_for_convert(input: &Path) -> Result<(Vec<ConFrame>, bool), ConvertError> {
+    let kind = InputKind::of(input)?;
+    let mut frames = Vec::new();
+    for_each_input_frame(input, kind, |frame| {
+        frames.push(frame);
+        ControlFlow::Continue(())
+    })?;
+    if frames.is_empty() {
+        return Err(ConvertError::Empty);
+    }
+    Ok((frames, kind.native()))
+}
+
+/// Output side of the pipeline.
+enum Sink {
+    Text(ParallelConWriter<fs::File>),
+    Conb(ConbWriter<io::BufWriter<fs::File>>),
+}
+
+impl Sink {
+    /// Writes to `tmp` in the format `output`'s extension selects.
+    fn create(output: &Path, tmp: &Path) -> io::Result<Self> {
+        if binary_cache::path_is_conb(output) {
+            Ok(Sink::Conb(ConbWriter::from_path(tmp)?))
+        } else {
+            // Chunks are formatted (and, for `.gz` / `.zst` outputs,
+            // compressed) in parallel and written in order.
+            Ok(Sink::Text(ParallelConWriter::for_path(fs::File::create(tmp)?, output)?))
         }
-        let frames = chemfiles_import::con_frames_from_trajectory_path(input)?;
-        if frames.is_empty() {
-            return Err(ConvertError::Empty);
+    }
+
+    fn write(&mut self, frames: &[ConFrame]) -> io::Result<()> {
+        match self {
+            Sink::Text(w) => w.extend(frames),
+            Sink::Conb(w) => w.extend(frames),
         }
-        Ok((frames, false))
+    }
+
+    fn finish(self) -> io::Result<()> {
+        let file = match self {
+            Sink::Text(w) => w.finish()?,
+            Sink::Conb(w) => w.finish()?.into_inner()?,
+        };
+        file.sync_all()
     }
 }
 
-/// Convert `input` (CON or chemfiles-readable foreign format) to CON at `output`.
+/// Convert `input` (CON, `.conb` or chemfiles-readable foreign format) to CON
+/// at `output`, or to the binary cache when `output` ends in `.conb`.
 ///
-/// Returns a [`ConvertReport`]. Fails if the foreign path needs chemfiles and
-/// this build is lean, or if zero frames are produced.
+/// Streams with [`ConvertOptions::default`]; see [`convert_path_to_con_with`].
+/// Fails if the foreign path needs chemfiles and this build is lean, or if
+/// zero frames are produced.
 pub fn convert_path_to_con(input: &Path, output: &Path) -> Result<ConvertReport, ConvertError> {
-    let (frames, native_con) = read_frames_for_convert(input)?;
-    let n_frames = frames.len();
-    let n_atoms_last = frames.last().map(|f| f.atom_data.len()).unwrap_or(0);
-    let mut writer = ConFrameWriter::from_path(output)?;
-    writer
-        .extend(frames.iter())
-        .map_err(|e| ConvertError::Io(io::Error::other(e.to_string())))?;
+    convert_path_to_con_with(input, output, &ConvertOptions::default())
+}
+
+/// [`convert_path_to_con`] with explicit batching.
+///
+/// Frames are written to a sibling `<output>.tmp`, created once the first
+/// batch is ready and renamed over `output` only when every frame is
+/// written (as [`ConbFile::build_for_path`] does), so a failed convert leaves
+/// neither a truncated file nor a clobbered `output` behind.
+pub fn convert_path_to_con_with(
+    input: &Path,
+    output: &Path,
+    options: &ConvertOptions,
+) -> Result<ConvertReport, ConvertError> {
+    let started = Instant::now();
+    let kind = InputKind::of(input)?;
+    let mut tmp = output.as_os_str().to_owned();
+    tmp.push(".tmp");
+    let tmp = PathBuf::from(tmp);
+    let bytes_read = fs::metadata(input)?.len();
+    let batch_frames = options.batch_frames.max(1);
+    let batch_atoms = options.batch_atoms.max(1);
+    let (tx, rx) = mpsc::sync_channel::<Result<Vec<ConFrame>, ConvertError>>(
+        options.prefetch_batches,
+    );
+
+    let (n_frames, n_atoms_last) = std::thread::scope(|scope| {
+        scope.spawn(move || {
+            let mut batch = Vec::new();
+            let mut atoms = 0usize;
+            let read = for_each_input_frame(input, kind, |frame| {
+                atoms += frame.atom_data.len();
+                batch.push(frame);
+                if batch.len() >= batch_frames || atoms >= batch_atoms {
+                    atoms = 0;
+                    // A closed channel means the writer failed; stop reading.
+                    if tx.send(Ok(std::mem::take(&mut batch))).is_err() {
+                        return ControlFlow::Break(());
+                    }
+                }
+                ControlFlow::Continue(())
+            });
+            let _ = match read {
+                Ok(()) if batch.is_empty() => Ok(()),
+                Ok(()) => tx.send(Ok(batch)),
+                Err(e) => tx.send(Err(e)),
+            };
+        });
+
+        let mut sink = None;
+        let mut counts = (0usize, 0usize);
+        let written = rx.iter().try_for_each(|batch| {
+            let batch = batch?;
+            let out = match sink.as_mut() {
+                Some(out) => out,
+                None => sink.insert(Sink::create(output, &tmp)?),
+            };
+            out.write(&batch)?;
+            counts.0 += batch.len();
+            counts.1 = batch.last().map_or(0, |f| f.atom_data.len());
+            Ok::<(), ConvertError>(())
+        });
+        // Dropping the receiver unblocks a reader still waiting to send.
+        drop(rx);
+        let created = sink.is_some();
+        let finished = written.and_then(|()| match sink.take() {
+            Some(out) => {
+                out.finish()?;
+                Ok(fs::rename(&tmp, output)?)
+            }
+            None => Err(ConvertError::Empty),
+        });
+        if let Err(e) = finished {
+            if created {
+                drop(sink);
+                let _ = fs::remove_file(&tmp);
+            }
+            return Err(e);
+        }
+        Ok(counts)
+    })?;
+
     Ok(ConvertReport {
         n_frames,
         n_atoms_last,
-        native_con,
+        native_con: kind.native(),
+        bytes_read,
+        bytes_written: fs::metadata(output)?.len(),
+        elapsed: started.elapsed(),
     })
 }
 
@@ -184,6 +398,76 @@ mod tests {
         assert_eq!(back[0].atom_data[0].atom_id, 0);
     }
 
+    #[test]
+    fn convert_streams_in_small_batches() {
+        let dir = tempfile_dir();
+        let input = fixture("tiny_multi_cuh2.convel");
+        let options = ConvertOptions {
+            batch_frames: 1,
+            batch_atoms: usize::MAX,
+            prefetch_batches: 0,
+        };
+        for name in ["batched.convel", "batched.convel.gz", "batched.conb"] {
+            let out = dir.join(name);
+            let report = convert_path_to_con_with(&input, &out, &options).unwrap();
+            assert_eq!(report.n_frames, 2);
+            assert_eq!(report.bytes_read, fs::metadata(&input).unwrap().len());
+            assert_eq!(report.bytes_written, fs::metadata(&out).unwrap().len());
+            assert!(report.frames_per_second() > 0.0);
+            let (back, _) = read_frames_for_convert(&out).unwrap();
+            assert_eq!(back, read_frames_for_convert(&input).unwrap().0);
+        }
+    }
+
+    #[test]
+    fn failed_convert_leaves_no_output() {
+        let dir = tempfile_dir();
+        let text = fs::read_to_string(fixture("tiny_multi_cuh2.con")).unwrap();
+        // First frame intact, second one cut inside its atom block.
+        let bad = dir.join("bad.con");
+        let cut = text.len() - 40;
+        fs::write(&bad, format!("{}\nnot-a-coordinate\n", &text[..cut])).unwrap();
+        let out = dir.join("out.con");
+        let options = ConvertOptions {
+            batch_frames: 1,
+            ..ConvertOptions::default()
+        };
+        assert!(convert_path_to_con_with(&bad, &out, &options).is_err());
+        assert!(!out.exists());
+        assert!(!dir.join("out.con.tmp").exists());
+        // An existing output survives a failure past the first batch.
+        fs::write(&out, "existing").unwrap();
+        assert!(convert_path_to_con_with(&bad, &out, &options).is_err());
+        assert_eq!(fs::read_to_string(&out).unwrap(), "existing");
+
+        let empty = dir.join("empty.con");
+        fs::write(&empty, "").unwrap();
+        let keep = dir.join("keep.con");
+        fs::write(&keep, "existing").unwrap();
+        assert!(matches!(
+            convert_path_to_con(&empty, &keep),
+            Err(ConvertError::Empty)
+        ));
+        assert_eq!(fs::read_to_string(&keep).unwrap(), "existing");
+    }
+
+    #[test]
+    fn convert_to_and_from_conb() {
+        let dir = tempfile_dir();
+        let conb = dir.join("out.conb");
+        let report = convert_path_to_con(&fixture("tiny_multi_cuh2.convel"), &conb).unwrap();
+        assert_eq!(report.n_frames, 2);
+        let (cached, native) = read_frames_for_convert(&conb).unwrap();
+        assert!(native);
+        let (original, _) = read_frames_for_convert(&fixture("tiny_multi_cuh2.convel")).unwrap();
+        assert_eq!(cached, original);
+
+        let out = dir.join("back.convel");
+        convert_path_to_con(&conb, &out).unwrap();
+        let (back, _) = read_frames_for_convert(&out).unwrap();
+        assert_eq!(back, original);
+    }
+
     #[test]
     #[cfg(feature = "chemfiles")]
     fn convert_xyz_via_chemfiles() {
@@ -1,17 +1,24 @@
-//! Real CUDA-backed f64 arrays for DLPack device allocate/export.
+//! Real CUDA-backed arrays for DLPack device allocate/export.
 //!
 //! Enabled only with `--features cuda`. Uses cudarc's CUDA driver API so
 //! `allocate_array_on_device(..., DLDevice::cuda(id))` obtains device memory
 //! via `cuMemAlloc`, not host staging.
+//!
+//! One-shot exports ([`export_host_as_cuda_dlpack`]) copy synchronously in
+//! f64 / f32 / f16. Streaming consumers use [`CudaUploadRing`] (or the
+//! [`CudaFrameUploader`] frame adapter): pinned staging slots and async
+//! copies on a dedicated stream, with DLPack exports ordered after the copy.
 
 use std::sync::Arc;
 
-use cudarc::driver::{CudaDevice, DevicePtr, DriverError};
-use dlpk::sys::{DLDataType, DLDevice, DLPackVersion};
+use cudarc::driver::{result, sys, CudaDevice, CudaStream, DevicePtr, DriverError};
+use dlpk::sys::{DLDataType, DLDataTypeCode, DLDevice, DLPackVersion};
 use dlpk::{DLPackTensor, GetDLPackDataType};
 
 use crate::array::Array;
 use crate::error::ParseError;
+use crate::iterators::ConFrameIterator;
+use crate::storage_dtype::ElementKind;
 
 fn map_cuda(e: DriverError) -> ParseError {
     ParseError::ValidationError(format!("CUDA driver error: {e:?}"))
@@ -91,7 +98,7 @@ impl CudaF64Array {
 struct CudaDlpackManager {
     /// Owning Arc so the slice stays alive while the DLPack consumer holds the tensor.
     #[allow(dead_code)]
-    array: Arc<CudaF64Array>,
+    array: Arc<dyn std::any::Any + Send + Sync>,
     shape: Vec<i64>,
 }
 
@@ -108,6 +115,41 @@ unsafe extern "C" fn cuda_dlpack_deleter(managed: *mut dlpk::sys::DLManagedTenso
     }
 }
 
+/// Wrap a device allocation kept alive by `owner` as a DLPack tensor.
+fn export_device_tensor(
+    owner: Arc<dyn std::any::Any + Send + Sync>,
+    data_ptr: *mut std::ffi::c_void,
+    device: DLDevice,
+    shape: &[usize],
+    dtype: DLDataType,
+) -> DLPackTensor {
+    let manager = Box::new(CudaDlpackManager {
+        array: owner,
+        shape: shape.iter().map(|&d| d as i64).collect(),
+    });
+    let shape_ptr = manager.shape.as_ptr() as *mut i64;
+    let mut managed = dlpk::sys::DLManagedTensorVersioned {
+        version: dlpk::sys::DLPackVersion {
+            major: dlpk::sys::DLPACK_MAJOR_VERSION,
+            minor: dlpk::sys::DLPACK_MINOR_VERSION,
+        },
+        manager_ctx: std::ptr::null_mut(),
+        deleter: Some(cuda_dlpack_deleter),
+        dl_tensor: dlpk::sys::DLTensor {
+            data: data_ptr,
+            device,
+            ndim: shape.len() as i32,
+            dtype,
+            shape: shape_ptr,
+            strides: std::ptr::null_mut(),
+            byte_offset: 0,
+        },
+        flags: 0,
+    };
+    managed.manager_ctx = Box::into_raw(manager) as *mut std::ffi::c_void;
+    unsafe { DLPackTensor::from_raw(managed) }
+}
+
 impl Array for CudaF64Array {
     fn as_any(&self) -> &dyn std::any::Any {
         self
@@ -198,32 +240,13 @@ impl Array for CudaArrayHandle {
                 device
             )));
         }
-        let manager = Box::new(CudaDlpackManager {
-            array: Arc::clone(&self.0),
-            shape: self.0.shape.iter().map(|&d| d as i64).collect(),
-        });
-        let data_ptr = self.0.device_ptr();
-        let shape_ptr = manager.shape.as_ptr() as *mut i64;
-        let mut managed = dlpk::sys::DLManagedTensorVersioned {
-            version: dlpk::sys::DLPackVersion {
-                major: dlpk::sys::DLPACK_MAJOR_VERSION,
-                minor: dlpk::sys::DLPACK_MINOR_VERSION,
-            },
-            manager_ctx: std::ptr::null_mut(),
-            deleter: Some(cuda_dlpack_deleter),
-            dl_tensor: dlpk::sys::DLTensor {
-                data: data_ptr,
-                device: self.0.dl_device(),
-                ndim: self.0.shape.len() as i32,
-                dtype: f64::get_dlpack_data_type(),
-                shape: shape_ptr,
-                strides: std::ptr::null_mut(),
-                byte_offset: 0,
-            },
-            flags: 0,
-        };
-        managed.manager_ctx = Box::into_raw(manager) as *mut std::ffi::c_void;
-        Ok(unsafe { DLPackTensor::from_raw(managed) })
+        Ok(export_device_tensor(
+            Arc::clone(&self.0) as Arc<dyn std::any::Any + Send + Sync>,
+            self.0.device_ptr(),
+            self.0.dl_device(),
+            &self.0.shape,
+            f64::get_dlpack_data_type(),
+        ))
     }
     fn copy(&self) -> Box<dyn Array> {
         let host = self.0.to_host().unwrap_or_default();
@@ -252,6 +275,509 @@ pub fn export_host_f64_as_cuda_dlpack(
     handle.as_dlpack(DLDevice::cuda(device_id), None, DLPackVersion::current())
 }
 
+/// Copy host values into CUDA memory as `kind` (`Float64` / `Float32` /
+/// `Float16`) and export a device DLPack tensor; the narrowing happens on the
+/// host so only `kind`-sized elements cross PCIe.
+pub fn export_host_as_cuda_dlpack(
+    shape: &[usize],
+    host: &[f64],
+    kind: ElementKind,
+    device_id: i32,
+) -> Result<DLPackTensor, ParseError> {
+    let handle = CudaFloatHandle(Arc::new(CudaFloatArray::from_host(
+        shape, host, kind, device_id,
+    )?));
+    handle.as_dlpack(DLDevice::cuda(device_id), None, DLPackVersion::current())
+}
+
+// ---------------------------------------------------------------------------
+// Typed device buffers + pinned-host asynchronous upload
+// ---------------------------------------------------------------------------
+
+/// Bytes per element of the float kinds hosted on the device.
+fn float_width(kind: ElementKind) -> Result<usize, ParseError> {
+    match kind {
+        ElementKind::Float64 => Ok(8),
+        ElementKind::Float32 => Ok(4),
+        ElementKind::Float16 => Ok(2),
+        other => Err(ParseError::ValidationError(format!(
+            "CUDA upload: {other:?} is not a float kind (float64 / float32 / float16)"
+        ))),
+    }
+}
+
+/// Narrow `src` into native-endian `kind` elements in `dst`
+/// (`dst.len() == src.len() * float_width(kind)`).
+fn narrow_into(kind: ElementKind, src: &[f64], dst: &mut [u8]) {
+    match kind {
+        ElementKind::Float32 => {
+            for (out, &x) in dst.chunks_exact_mut(4).zip(src) {
+                out.copy_from_slice(&(x as f32).to_ne_bytes());
+            }
+        }
+        ElementKind::Float16 => {
+            for (out, &x) in dst.chunks_exact_mut(2).zip(src) {
+                out.copy_from_slice(&half::f16::from_f64(x).to_bits().to_ne_bytes());
+            }
+        }
+        _ => {
+            for (out, &x) in dst.chunks_exact_mut(8).zip(src) {
+                out.copy_from_slice(&x.to_ne_bytes());
+            }
+        }
+    }
+}
+
+/// Inverse of [`narrow_into`] (device read-back in tests and `to_host`).
+fn widen_from(kind: ElementKind, src: &[u8]) -> Vec<f64> {
+    match kind {
+        ElementKind::Float32 => src
+            .chunks_exact(4)
+            .map(|b| f32::from_ne_bytes([b[0], b[1], b[2], b[3]]) as f64)
+            .collect(),
+        ElementKind::Float16 => src
+            .chunks_exact(2)
+            .map(|b| half::f16::from_bits(u16::from_ne_bytes([b[0], b[1]])).to_f64())
+            .collect(),
+        _ => src
+            .chunks_exact(8)
+            .map(|b| f64::from_ne_bytes(b.try_into().expect("8-byte chunk")))
+            .collect(),
+    }
+}
+
+/// Owned `CUevent` (timing disabled); destroyed on drop.
+struct CudaEvent(sys::CUevent);
+
+// Safety: a CUevent is a context-scoped driver handle usable from any thread.
+unsafe impl Send for CudaEvent {}
+unsafe impl Sync for CudaEvent {}
+
+impl CudaEvent {
+    /// Record a fresh event at the current tail of `stream`.
+    fn record(stream: sys::CUstream) -> Result<Self, ParseError> {
+        let event = result::event::create(sys::CUevent_flags::CU_EVENT_DISABLE_TIMING)
+            .map_err(map_cuda)?;
+        unsafe { result::event::record(event, stream) }.map_err(map_cuda)?;
+        Ok(Self(event))
+    }
+
+    fn is_complete(&self) -> bool {
+        let status = unsafe { sys::lib().cuEventQuery(self.0) };
+        status == sys::CUresult::CUDA_SUCCESS
+    }
+
+    fn synchronize(&self) -> Result<(), ParseError> {
+        unsafe { result::event::synchronize(self.0) }.map_err(map_cuda)
+    }
+}
+
+impl Drop for CudaEvent {
+    fn drop(&mut self) {
+        let _ = unsafe { result::event::destroy(self.0) };
+    }
+}
+
+/// CUDA-resident float buffer in any hosted kind (`f64` / `f32` / `f16`).
+///
+/// Buffers produced by [`CudaUploadRing`] may still be filling when they are
+/// handed out; `ready` marks the end of that copy and DLPack export orders
+/// the consumer's stream after it.
+pub struct CudaFloatArray {
+    shape: Vec<usize>,
+    kind: ElementKind,
+    device_id: i32,
+    bytes: cudarc::driver::CudaSlice<u8>,
+    ready: Option<Arc<CudaEvent>>,
+    _dev: Arc<CudaDevice>,
+}
+
+impl CudaFloatArray {
+    /// Narrow `host` to `kind` and copy it synchronously to `device_id`.
+    pub fn from_host(
+        shape: &[usize],
+        host: &[f64],
+        kind: ElementKind,
+        device_id: i32,
+    ) -> Result<Self, ParseError> {
+        let width = float_width(kind)?;
+        let n = checked_len(shape, host)?;
+        let mut staged = vec![0u8; n * width];
+        narrow_into(kind, host, &mut staged);
+        let dev = CudaDevice::new(device_id as usize).map_err(map_cuda)?;
+        // cudarc may not like zero-length; allocate 1 byte and track n = 0.
+        let mut bytes = dev.alloc_zeros::<u8>(staged.len().max(1)).map_err(map_cuda)?;
+        if !staged.is_empty() {
+            dev.htod_sync_copy_into(&staged, &mut bytes).map_err(map_cuda)?;
+        }
+        Ok(Self {
+            shape: shape.to_vec(),
+            kind,
+            device_id,
+            bytes,
+            ready: None,
+            _dev: dev,
+        })
+    }
+
+    pub fn kind(&self) -> ElementKind {
+        self.kind
+    }
+
+    pub fn shape(&self) -> &[usize] {
+        &self.shape
+    }
+
+    /// True once the upload that fills this buffer has landed on the device.
+    pub fn is_ready(&self) -> bool {
+        self.ready.as_ref().is_none_or(|e| e.is_complete())
+    }
+
+    /// Block the host until the upload has finished.
+    pub fn synchronize(&self) -> Result<(), ParseError> {
+        match &self.ready {
+            Some(event) => event.synchronize(),
+            None => Ok(()),
+        }
+    }
+
+    /// Copy the buffer back to host, widened to f64 (tests / verification).
+    pub fn to_host(&self) -> Result<Vec<f64>, ParseError> {
+        let n: usize = self.shape.iter().product();
+        if n == 0 {
+            return Ok(Vec::new());
+        }
+        self.synchronize()?;
+        let mut raw = vec![0u8; self.bytes.len()];
+        self._dev
+            .dtoh_sync_copy_into(&self.bytes, &mut raw)
+            .map_err(map_cuda)?;
+        raw.truncate(n * float_width(self.kind)?);
+        Ok(widen_from(self.kind, &raw))
+    }
+
+    pub fn device_ptr(&self) -> *mut std::ffi::c_void {
+        let p: u64 = *self.bytes.device_ptr();
+        p as usize as *mut std::ffi::c_void
+    }
+
+    pub fn dl_device(&self) -> DLDevice {
+        DLDevice::cuda(self.device_id)
+    }
+
+    fn dl_dtype(&self) -> DLDataType {
+        DLDataType {
+            code: DLDataTypeCode::kDLFloat,
+            bits: (8 * float_width(self.kind).unwrap_or(8)) as u8,
+            lanes: 1,
+        }
+    }
+
+    /// DLPack `__dlpack__(stream=...)` contract: make the buffer safe to read
+    /// on the consumer's stream. `None` blocks the host; `-1` skips ordering;
+    /// `1` / `2` name the legacy / per-thread default streams; any other value
+    /// is a `CUstream` handle that is made to wait on the upload event.
+    fn order_for_consumer(&self, stream: Option<i64>) -> Result<(), ParseError> {
+        let Some(event) = &self.ready else {
+            return Ok(());
+        };
+        let consumer = match stream {
+            None => return event.synchronize(),
+            Some(-1) => return Ok(()),
+            Some(0) => {
+                return Err(ParseError::ValidationError(
+                    "DLPack stream 0 is ambiguous for CUDA; pass 1 (legacy default) or 2".into(),
+                ));
+            }
+            Some(s) => s as usize as sys::CUstream,
+        };
+        if event.is_complete() {
+            return Ok(());
+        }
+        unsafe {
+            result::stream::wait_event(
+                consumer,
+                event.0,
+                sys::CUevent_wait_flags::CU_EVENT_WAIT_DEFAULT,
+            )
+        }
+        .map_err(map_cuda)
+    }
+}
+
+impl Drop for CudaFloatArray {
+    fn drop(&mut self) {
+        // The slice is freed on the device's default stream; never let that
+        // race an in-flight copy issued on the upload stream.
+        if let Some(event) = &self.ready {
+            let _ = event.synchronize();
+        }
+    }
+}
+
+fn checked_len(shape: &[usize], host: &[f64]) -> Result<usize, ParseError> {
+    let n: usize = shape.iter().product();
+    if host.len() != n {
+        return Err(ParseError::ValidationError(format!(
+            "CUDA array: expected {n} values, got {}",
+            host.len()
+        )));
+    }
+    Ok(n)
+}
+
+/// Shared handle to a [`CudaFloatArray`]; DLPack exports keep it alive.
+#[derive(Clone)]
+pub struct CudaFloatHandle(pub Arc<CudaFloatArray>);
+
+impl Array for CudaFloatHandle {
+    fn as_any(&self) -> &dyn std::any::Any {
+        self
+    }
+    fn as_any_mut(&mut self) -> &mut dyn std::any::Any {
+        self
+    }
+    fn shape(&self) -> Vec<usize> {
+        self.0.shape.clone()
+    }
+    fn dtype(&self) -> DLDataType {
+        self.0.dl_dtype()
+    }
+    fn device(&self) -> DLDevice {
+        self.0.dl_device()
+    }
+    fn as_dlpack(
+        &self,
+        device: DLDevice,
+        stream: Option<i64>,
+        _max_version: DLPackVersion,
+    ) -> Result<DLPackTensor, ParseError> {
+        if device != self.0.dl_device() {
+            return Err(ParseError::ValidationError(format!(
+                "device mismatch: array is on {:?}, requested {:?}",
+                self.0.dl_device(),
+                device
+            )));
+        }
+        self.0.order_for_consumer(stream)?;
+        Ok(export_device_tensor(
+            Arc::clone(&self.0) as Arc<dyn std::any::Any + Send + Sync>,
+            self.0.device_ptr(),
+            self.0.dl_device(),
+            &self.0.shape,
+            self.0.dl_dtype(),
+        ))
+    }
+    fn copy(&self) -> Box<dyn Array> {
+        let host = self.0.to_host().unwrap_or_default();
+        let inner = CudaFloatArray::from_host(&self.0.shape, &host, self.0.kind, self.0.device_id)
+            .expect("cuda copy");
+        Box::new(CudaFloatHandle(Arc::new(inner)))
+    }
+}
+
+/// One page-locked staging buffer. `in_flight` is the event recorded after
+/// the last copy that reads from it; the slot is reusable once it fires.
+struct PinnedSlot {
+    ptr: *mut u8,
+    cap: usize,
+    in_flight: Option<Arc<CudaEvent>>,
+}
+
+// Safety: the slot owns its pinned allocation; access goes through `&mut`.
+unsafe impl Send for PinnedSlot {}
+
+impl PinnedSlot {
+    const fn empty() -> Self {
+        Self {
+            ptr: std::ptr::null_mut(),
+            cap: 0,
+            in_flight: None,
+        }
+    }
+
+    /// Wait for the previous copy out of this slot, then make room for
+    /// `nbytes` (page-locked via `cuMemHostAlloc`).
+    fn acquire(&mut self, nbytes: usize) -> Result<&mut [u8], ParseError> {
+        if let Some(event) = self.in_flight.take() {
+            event.synchronize()?;
+        }
+        if nbytes > self.cap {
+            self.release();
+            let cap = nbytes.next_power_of_two();
+            let ptr = unsafe { result::malloc_host(cap, 0) }.map_err(map_cuda)?;
+            self.ptr = ptr as *mut u8;
+            self.cap = cap;
+        }
+        if nbytes == 0 {
+            return Ok(&mut []);
+        }
+        Ok(unsafe { std::slice::from_raw_parts_mut(self.ptr, nbytes) })
+    }
+
+    fn release(&mut self) {
+        if !self.ptr.is_null() {
+            let _ = unsafe { result::free_host(self.ptr as *mut std::ffi::c_void) };
+            self.ptr = std::ptr::null_mut();
+            self.cap = 0;
+        }
+    }
+}
+
+impl Drop for PinnedSlot {
+    fn drop(&mut self) {
+        if let Some(event) = self.in_flight.take() {
+            let _ = event.synchronize();
+        }
+        self.release();
+    }
+}
+
+/// Pinned-host ring feeding asynchronous H2D copies on a dedicated stream.
+///
+/// [`upload`](Self::upload) narrows host values into the next page-locked
+/// slot, enqueues `cuMemcpyHtoDAsync`, and returns immediately with a device
+/// buffer whose DLPack export is ordered after the copy. The host only waits
+/// when it wraps around to a slot whose previous copy is still reading it,
+/// so with `depth >= 2` uploads per frame the copy of frame k overlaps the
+/// parse of frame k + 1.
+pub struct CudaUploadRing {
+    dev: Arc<CudaDevice>,
+    device_id: i32,
+    stream: CudaStream,
+    slots: Vec<PinnedSlot>,
+    next: usize,
+}
+
+impl CudaUploadRing {
+    /// Ring of `depth` (at least 1) staging slots on `device_id`; slots grow
+    /// on demand and are reused in order.
+    pub fn new(device_id: i32, depth: usize) -> Result<Self, ParseError> {
+        let dev = CudaDevice::new(device_id as usize).map_err(map_cuda)?;
+        let stream = dev.fork_default_stream().map_err(map_cuda)?;
+        Ok(Self {
+            dev,
+            device_id,
+            stream,
+            slots: (0..depth.max(1)).map(|_| PinnedSlot::empty()).collect(),
+            next: 0,
+        })
+    }
+
+    pub fn depth(&self) -> usize {
+        self.slots.len()
+    }
+
+    /// Stage `host` as `kind` in the next pinned slot and start its upload.
+    /// The returned buffer may still be filling; see [`CudaFloatArray::is_ready`].
+    pub fn upload(
+        &mut self,
+        shape: &[usize],
+        host: &[f64],
+        kind: ElementKind,
+    ) -> Result<CudaFloatHandle, ParseError> {
+        let width = float_width(kind)?;
+        let nbytes = checked_len(shape, host)? * width;
+        self.dev.bind_to_thread().map_err(map_cuda)?;
+        let depth = self.slots.len();
+        let slot = &mut self.slots[self.next];
+        self.next = (self.next + 1) % depth;
+        let staging = slot.acquire(nbytes)?;
+        narrow_into(kind, host, staging);
+
+        let bytes = unsafe { self.dev.alloc::<u8>(nbytes.max(1)) }.map_err(map_cuda)?;
+        // Allocations are ordered on the device's default stream.
+        self.stream.wait_for_default().map_err(map_cuda)?;
+        if nbytes > 0 {
+            unsafe { result::memcpy_htod_async(*bytes.device_ptr(), &*staging, self.stream.stream) }
+                .map_err(map_cuda)?;
+        }
+        let ready = Arc::new(CudaEvent::record(self.stream.stream)?);
+        slot.in_flight = Some(Arc::clone(&ready));
+        Ok(CudaFloatHandle(Arc::new(CudaFloatArray {
+            shape: shape.to_vec(),
+            kind,
+            device_id: self.device_id,
+            bytes,
+            ready: Some(ready),
+            _dev: Arc::clone(&self.dev),
+        })))
+    }
+
+    /// Block until every upload issued so far has landed.
+    pub fn synchronize(&self) -> Result<(), ParseError> {
+        self.stream.synchronize().map_err(map_cuda)
+    }
+}
+
+/// Device-side sections of one frame from [`CudaFrameUploader`].
+pub struct CudaFrameUpload {
+    /// Positions `(N, 3)`.
+    pub positions: CudaFloatHandle,
+    /// Forces `(N, 3)` when the frame carries a force section.
+    pub forces: Option<CudaFloatHandle>,
+}
+
+/// Frame iterator adapter that streams each frame's positions (and forces)
+/// to the GPU through a [`CudaUploadRing`] while the next frame parses.
+pub struct CudaFrameUploader<'a> {
+    frames: ConFrameIterator<'a>,
+    ring: CudaUploadRing,
+    kind: ElementKind,
+}
+
+impl<'a> CudaFrameUploader<'a> {
+    /// Upload frames of `text` to `device_id` as `kind`, double-buffered
+    /// (four staging slots: positions + forces for two frames in flight).
+    pub fn new(text: &'a str, device_id: i32, kind: ElementKind) -> Result<Self, ParseError> {
+        float_width(kind)?;
+        Ok(Self {
+            frames: ConFrameIterator::new(text),
+            ring: CudaUploadRing::new(device_id, 4)?,
+            kind,
+        })
+    }
+
+    pub fn ring(&self) -> &CudaUploadRing {
+        &self.ring
+    }
+
+    fn upload_section(
+        &mut self,
+        section: &crate::storage_dtype::Array2Storage,
+    ) -> Result<CudaFloatHandle, ParseError> {
+        let shape = [section.nrows(), section.ncols()];
+        match section.as_f64_slice() {
+            Some(host) => self.ring.upload(&shape, host, self.kind),
+            None => {
+                let host: Vec<f64> =
+                    (0..shape[0]).flat_map(|i| section.as_f64_row(i)).collect();
+                self.ring.upload(&shape, &host, self.kind)
+            }
+        }
+    }
+}
+
+impl Iterator for CudaFrameUploader<'_> {
+    type Item = Result<CudaFrameUpload, ParseError>;
+
+    fn next(&mut self) -> Option<Self::Item> {
+        let frame = match self.frames.next()? {
+            Ok(frame) => frame,
+            Err(e) => return Some(Err(e)),
+        };
+        Some((|| {
+            let positions = self.upload_section(&frame.positions)?;
+            let forces = if frame.forces.nrows() > 0 {
+                Some(self.upload_section(&frame.forces)?)
+            } else {
+                None
+            };
+            Ok(CudaFrameUpload { positions, forces })
+        })())
+    }
+}
+
 /// True if at least one CUDA device is visible.
 pub fn cuda_device_count() -> Result<usize, ParseError> {
     // Probe device 0; if it fails, report zero.
@@ -297,6 +823,58 @@ mod tests {
         assert!(format!("{err:?}").contains("device mismatch"));
     }
 
+    #[test]
+    fn cuda_float32_and_float16_exports_report_kind() {
+        let host: Vec<f64> = (0..6).map(|i| i as f64 * 0.25).collect();
+        for (kind, bits) in [(ElementKind::Float32, 32u8), (ElementKind::Float16, 16)] {
+            let t = export_host_as_cuda_dlpack(&[2, 3], &host, kind, 0).expect("export");
+            assert_eq!(t.device().device_type, DLDeviceType::kDLCUDA);
+            assert_eq!(t.dtype().bits, bits);
+            let arr = CudaFloatArray::from_host(&[2, 3], &host, kind, 0).expect("from_host");
+            assert_eq!(arr.to_host().expect("to_host"), host);
+        }
+        assert!(export_host_as_cuda_dlpack(&[1], &[1.0], ElementKind::Int32, 0).is_err());
+    }
+
+    #[test]
+    fn cuda_upload_ring_reuses_slots_and_orders_exports() {
+        let mut ring = CudaUploadRing::new(0, 2).expect("ring");
+        let mut uploads = Vec::new();
+        for k in 0..5 {
+            let host: Vec<f64> = (0..12).map(|i| (k * 100 + i) as f64).collect();
+            uploads.push((host.clone(), ring.upload(&[4, 3], &host, ElementKind::Float32).unwrap()));
+        }
+        for (host, handle) in &uploads {
+            // `None` stream: export blocks until the copy has landed.
+            let t = handle
+                .as_dlpack(DLDevice::cuda(0), None, DLPackVersion::current())
+                .expect("export");
+            assert_eq!(t.dtype().bits, 32);
+            assert!(handle.0.is_ready());
+            assert_eq!(&handle.0.to_host().unwrap(), host);
+        }
+        ring.synchronize().unwrap();
+    }
+
+    #[test]
+    fn cuda_frame_uploader_streams_every_frame() {
+        let text = std::fs::read_to_string(concat!(
+            env!("CARGO_MANIFEST_DIR"),
+            "/resources/test/tiny_multi_cuh2.con"
+        ))
+        .unwrap();
+        let frames: Vec<_> = ConFrameIterator::new(&text).map(Result::unwrap).collect();
+        let uploads: Vec<_> = CudaFrameUploader::new(&text, 0, ElementKind::Float64)
+            .unwrap()
+            .map(Result::unwrap)
+            .collect();
+        assert_eq!(uploads.len(), frames.len());
+        for (up, frame) in uploads.iter().zip(&frames) {
+            assert_eq!(up.positions.0.shape(), &[frame.atom_data.len(), 3]);
+            assert_eq!(up.positions.0.to_host().unwrap()[0], frame.atom_data[0].x);
+        }
+    }
+
     #[test]
     fn cuda_alloc_zeros_via_public_allocate() {
         let a = allocate_cuda_f64(&[4, 3], 0).expect("allocate_cuda_f64");
@@ -24,6 +24,9 @@ pub enum ParseError {
     /// the current length. Surfaces as `IndexError` in PyO3 and as
     /// `RKR_STATUS_INDEX_OUT_OF_BOUNDS` over the C ABI.
     IndexOutOfBounds { index: usize, len: usize },
+    /// Reading the underlying stream failed (streaming iterators only;
+    /// in-memory parsing never produces this).
+    Io(String),
 }
 
 impl fmt::Display for ParseError {
@@ -77,12 +80,21 @@ impl fmt::Display for ParseError {
                     "atom index {index} is out of bounds (builder holds {len} atoms)"
                 )
             }
+            ParseError::Io(msg) => {
+                write!(f, "I/O error while reading frames: {msg}")
+            }
         }
     }
 }
 
 impl std::error::Error for ParseError {}
 
+impl From<std::io::Error> for ParseError {
+    fn from(e: std::io::Error) -> Self {
+        ParseError::Io(e.to_string())
+    }
+}
+
 impl From<ParseFloatError> for ParseError {
     fn from(e: ParseFloatError) -> Self {
         ParseError::InvalidNumberFormat(e.to_string())
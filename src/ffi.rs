@@ -1,8 +1,10 @@
+use crate::compression::FileContents;
 use crate::helpers::symbol_to_atomic_number;
 use crate::iterators::{self, ConFrameIterator};
 use crate::types::{ConFrame, ConFrameBuilder, meta};
+use crate::parallel_writer::{ChunkCompression, ParallelConWriter};
 use crate::writer::ConFrameWriter;
-use std::ffi::{CStr, CString, c_char};
+use std::ffi::{CStr, CString, c_char, c_void};
 use std::fs::File;
 use std::path::Path;
 use std::ptr;
@@ -17,6 +19,25 @@ use std::ptr;
 /// the convenience of either naming convention; they always carry the
 /// same value.
 pub const RKR_CON_SPEC_VERSION: u32 = 3;
+/// Column bits for [`con_frame_iterator_set_columns`] (mirror
+/// `crate::types::ColumnMask`). 0 selects header-only frames.
+pub const RKR_COLUMN_POSITIONS: u32 = 1 << 0;
+pub const RKR_COLUMN_VELOCITIES: u32 = 1 << 1;
+pub const RKR_COLUMN_FORCES: u32 = 1 << 2;
+pub const RKR_COLUMN_ENERGIES: u32 = 1 << 3;
+pub const RKR_COLUMN_CHARGES: u32 = 1 << 4;
+pub const RKR_COLUMN_SPINS: u32 = 1 << 5;
+pub const RKR_COLUMN_MAGMOMS: u32 = 1 << 6;
+/// Every column; the default for new iterators.
+pub const RKR_COLUMNS_ALL: u32 = (1 << 7) - 1;
+/// `stop` for [`rkr_read_trajectory_tensors`]: read to the last frame.
+pub const RKR_FRAMES_END: usize = usize::MAX;
+/// `keys` for [`rkr_read_trajectory_metatensor`]: one block per quantity.
+pub const RKR_MTS_KEYS_QUANTITY: u32 = 0;
+/// One positions block per species (atomic number).
+pub const RKR_MTS_KEYS_SPECIES_POSITIONS: u32 = 1;
+/// One forces block per species (atomic number).
+pub const RKR_MTS_KEYS_SPECIES_FORCES: u32 = 2;
 /// Returns the spec version at runtime (for dynamically linked consumers).
 #[unsafe(no_mangle)]
 pub extern "C" fn rkr_con_spec_version() -> u32 {
@@ -491,25 +512,131 @@ pub struct CAtom {
     pub energy: f64,
     pub has_energy: bool,
 }
+/// C iterator handle. Owns the backing [`FileContents`] (heap string or
+/// read-only mmap) and a `ConFrameIterator` borrowing it for `'static`.
+///
+/// Path-backed iterators over uncompressed files keep the mapping instead of
+/// copying it, and release pages behind the cursor as frames are consumed,
+/// so resident memory stays bounded by one [`crate::compression::RELEASE_CHUNK`]
+/// window plus the frame being parsed.
+///
+/// Compressed paths instead hold a [`RKRFrameStream`] (with `iterator` and
+/// `file_contents` NULL) that inflates one chunk at a time.
+///
+/// `offset_index` is the file's fresh `.con.idx` sidecar when one existed at
+/// open time (NULL otherwise); [`con_frame_iterator_seek`] then jumps
+/// directly instead of skipping frame by frame.
 #[repr(C)]
 pub struct CConFrameIterator {
     iterator: *mut ConFrameIterator<'static>,
-    file_contents: *mut String,
+    file_contents: *mut FileContents,
+    /// Prefix of a mapped buffer already handed back to the kernel.
+    released: usize,
+    stream: *mut RKRFrameStream,
+    offset_index: *mut crate::offset_index::FrameOffsetIndex,
+    /// Set instead of `iterator` by [`read_con_file_iterator_parallel`].
+    parallel: *mut ParallelFrameIterator,
 }
 
-/// Build a path/buffer-backed C iterator from an owned CON text buffer.
-fn c_iterator_from_owned_string(contents: String) -> *mut CConFrameIterator {
-    let file_contents_box = Box::new(contents);
-    let file_contents_ptr = Box::into_raw(file_contents_box);
-    let static_file_contents: &'static str = unsafe { &*file_contents_ptr };
-    let iterator = Box::new(ConFrameIterator::new(static_file_contents));
+/// Decoder behind a [`read_con_file_iterator_parallel`] handle.
+#[cfg(feature = "parallel")]
+pub type ParallelFrameIterator = crate::iterators::ParallelFrameIterator<'static>;
+/// Without the `parallel` feature the handle decodes on the calling thread.
+#[cfg(not(feature = "parallel"))]
+pub type ParallelFrameIterator = ConFrameIterator<'static>;
+
+#[cfg(feature = "parallel")]
+fn new_parallel_frames(text: &'static str, num_threads: usize) -> ParallelFrameIterator {
+    let threads = (num_threads > 0).then_some(num_threads);
+    crate::iterators::ParallelFrameIterator::new(text, threads)
+}
+#[cfg(not(feature = "parallel"))]
+fn new_parallel_frames(text: &'static str, _num_threads: usize) -> ParallelFrameIterator {
+    ConFrameIterator::new(text)
+}
+
+/// Streaming frame source behind a compressed-path [`CConFrameIterator`].
+pub struct RKRFrameStream {
+    stream: crate::streaming::StreamingConFrameIterator<Box<dyn std::io::BufRead + Send>>,
+    /// Reopened to seek backwards (a decoder cannot rewind).
+    path: std::path::PathBuf,
+}
+
+/// Wrap a streaming source in a C iterator handle.
+fn c_iterator_from_stream(path: &Path) -> *mut CConFrameIterator {
+    let stream = match crate::streaming::StreamingConFrameIterator::from_path(path) {
+        Ok(stream) => stream,
+        Err(_) => return ptr::null_mut(),
+    };
+    Box::into_raw(Box::new(CConFrameIterator {
+        iterator: ptr::null_mut(),
+        file_contents: ptr::null_mut(),
+        released: 0,
+        stream: Box::into_raw(Box::new(RKRFrameStream {
+            stream,
+            path: path.to_path_buf(),
+        })),
+        offset_index: ptr::null_mut(),
+        parallel: ptr::null_mut(),
+    }))
+}
+
+/// Build a C iterator over owned or mapped contents. Returns NULL when the
+/// buffer is not valid UTF-8 (validated once here, not per frame).
+/// `num_threads` selects the parallel decoder (`Some(0)`: global pool).
+fn c_iterator_from_contents(
+    contents: FileContents,
+    index: Option<crate::offset_index::FrameOffsetIndex>,
+    num_threads: Option<usize>,
+) -> *mut CConFrameIterator {
+    let file_contents_ptr = Box::into_raw(Box::new(contents));
+    // SAFETY: the box is freed only in `free_con_frame_iterator`, after the
+    // iterator borrowing it. Moving the box pointer does not move the bytes
+    // (String heap buffer / mapped pages).
+    let static_file_contents: &'static FileContents = unsafe { &*file_contents_ptr };
+    let text: &'static str = match static_file_contents.as_str() {
+        Ok(s) => s,
+        Err(_) => {
+            let _ = unsafe { Box::from_raw(file_contents_ptr) };
+            return ptr::null_mut();
+        }
+    };
+    static_file_contents.advise_sequential();
+    let index_ptr = index.map_or(ptr::null_mut(), |index| Box::into_raw(Box::new(index)));
+    // SAFETY: freed after the iterator, like `file_contents`.
+    let index_ref = unsafe { index_ptr.as_ref() };
+    let (iterator, parallel) = match num_threads {
+        None => {
+            let mut iterator = ConFrameIterator::new(text);
+            if let Some(index) = index_ref {
+                iterator = iterator.with_offset_index(index);
+            }
+            (Box::into_raw(Box::new(iterator)), ptr::null_mut())
+        }
+        Some(n) => {
+            let mut frames = new_parallel_frames(text, n);
+            if let Some(index) = index_ref {
+                frames = frames.with_offset_index(index);
+            }
+            (ptr::null_mut(), Box::into_raw(Box::new(frames)))
+        }
+    };
     let c_iterator = Box::new(CConFrameIterator {
-        iterator: Box::into_raw(iterator),
+        iterator,
         file_contents: file_contents_ptr,
+        released: 0,
+        stream: ptr::null_mut(),
+        offset_index: index_ptr,
+        parallel,
     });
     Box::into_raw(c_iterator)
 }
 
+/// Build a path/buffer-backed C iterator from an owned CON text buffer.
+fn c_iterator_from_owned_string(contents: String) -> *mut CConFrameIterator {
+    c_iterator_from_contents(FileContents::Owned(contents), None, None)
+}
+
 //=============================================================================
 // Iterator and Memory Management
 //=============================================================================
@@ -517,8 +644,16 @@ fn c_iterator_from_owned_string(contents: String) -> *mut CConFrameIterator {
 /// gzip (`.con.gz`) and zstd (`.con.zst`, requires `zstd` feature) inputs via
 /// [`crate::compression::read_file_contents`].
 ///
-/// Returns NULL if the file cannot be read, decompressed, or is not valid
-/// UTF-8. A successfully-opened file with zero frames returns a non-NULL
+/// Uncompressed files of 64 KiB or more are iterated directly over a
+/// read-only memory map (no heap copy); pages already parsed are released
+/// as the iterator advances. Compressed files are inflated incrementally
+/// (one frame plus one chunk resident), so decompression or UTF-8 errors
+/// past the first bytes surface as NULL from [`con_frame_iterator_next`].
+/// A fresh `<file>.idx` sidecar, if present, is loaded for
+/// [`con_frame_iterator_seek`].
+///
+/// Returns NULL if the file cannot be opened, uses an unsupported
+/// compression, or an uncompressed file is not valid UTF-8. A successfully-opened file with zero frames returns a non-NULL
 /// iterator that yields NULL on the first call to [`con_frame_iterator_next`].
 /// The caller OWNS the returned pointer and MUST call [`free_con_frame_iterator`].
 ///
@@ -528,6 +663,36 @@ fn c_iterator_from_owned_string(contents: String) -> *mut CConFrameIterator {
 #[unsafe(no_mangle)]
 pub unsafe extern "C" fn read_con_file_iterator(
     filename_c: *const c_char,
+) -> *mut CConFrameIterator {
+    unsafe { c_file_iterator(filename_c, None) }
+}
+
+/// Like [`read_con_file_iterator`], but uncompressed files are decoded by a
+/// pipelined parallel parser on `num_threads` workers (0: the global Rayon
+/// pool). Frames still come back in file order from
+/// [`con_frame_iterator_next`]; a bounded window of frames is decoded ahead,
+/// so memory does not grow with the file. Skip, seek and position behave as
+/// for the sequential iterator.
+///
+/// Compressed files are streamed sequentially, as by
+/// [`read_con_file_iterator`]. Builds without the `parallel` feature decode
+/// on the calling thread and ignore `num_threads`.
+///
+/// # Safety
+/// filename_c must be a valid null-terminated string. The caller takes
+/// ownership of the returned iterator and MUST call [`free_con_frame_iterator`].
+#[unsafe(no_mangle)]
+pub unsafe extern "C" fn read_con_file_iterator_parallel(
+    filename_c: *const c_char,
+    num_threads: usize,
+) -> *mut CConFrameIterator {
+    unsafe { c_file_iterator(filename_c, Some(num_threads)) }
+}
+
+/// Shared body of the path-backed iterator constructors.
+unsafe fn c_file_iterator(
+    filename_c: *const c_char,
+    num_threads: Option<usize>,
 ) -> *mut CConFrameIterator {
     if filename_c.is_null() {
         return ptr::null_mut();
@@ -536,14 +701,17 @@ pub unsafe extern "C" fn read_con_file_iterator(
         Ok(s) => s,
         Err(_) => return ptr::null_mut(),
     };
-    let owned = match crate::compression::read_file_contents(Path::new(filename)) {
-        Ok(fc) => match fc.as_str() {
-            Ok(s) => s.to_owned(),
-            Err(_) => return ptr::null_mut(),
-        },
+    let path = Path::new(filename);
+    match crate::compression::detect_path_compression(path) {
+        Ok(crate::compression::Compression::None) => {}
+        Ok(_) => return c_iterator_from_stream(path),
         Err(_) => return ptr::null_mut(),
-    };
-    c_iterator_from_owned_string(owned)
+    }
+    let index = crate::offset_index::FrameOffsetIndex::load_fresh(path);
+    match crate::compression::read_file_contents(path) {
+        Ok(fc) => c_iterator_from_contents(fc, index, num_threads),
+        Err(_) => ptr::null_mut(),
+    }
 }
 
 /// Iterate frames from an in-memory CON text buffer (null-terminated C string).
@@ -603,12 +771,228 @@ pub unsafe extern "C" fn con_frame_iterator_next(
     if iterator.is_null() {
         return ptr::null_mut();
     }
-    let iter = unsafe { &mut *(*iterator).iterator };
-    match iter.next() {
+    let c_iter = unsafe { &mut *iterator };
+    if !c_iter.stream.is_null() {
+        let stream = unsafe { &mut (*c_iter.stream).stream };
+        return match stream.next() {
+            Some(Ok(frame)) => Box::into_raw(Box::new(frame)) as *mut RKRConFrame,
+            _ => ptr::null_mut(),
+        };
+    }
+    let (next, offset) = if !c_iter.parallel.is_null() {
+        let frames = unsafe { &mut *c_iter.parallel };
+        (frames.next(), frames.byte_offset())
+    } else {
+        let iter = unsafe { &mut *c_iter.iterator };
+        (iter.next(), iter.byte_offset())
+    };
+    // Frames own their data, so mapped pages behind the cursor are dead.
+    let contents = unsafe { &*c_iter.file_contents };
+    c_iter.released = contents.release_before(c_iter.released, offset);
+    match next {
         Some(Ok(frame)) => Box::into_raw(Box::new(frame)) as *mut RKRConFrame,
         _ => ptr::null_mut(),
     }
 }
+/// Recycling counterpart of [`con_frame_iterator_next`]: parses the next
+/// frame into `*frame`, reusing that handle's buffers (header strings, atom
+/// vector, SoA blocks, interned symbols) when the atom count and species are
+/// unchanged. If `*frame` is NULL a new handle is allocated and stored there.
+///
+/// Returns true when `*frame` holds the next frame; false at end of input
+/// or on a malformed frame (the cases where `con_frame_iterator_next`
+/// returns NULL), leaving `*frame` owned by the caller either way. Free the
+/// handle with [`free_rkr_frame`] once, after the loop. Frames from a
+/// parallel iterator are decoded ahead, so they replace the handle's
+/// contents instead of refilling it.
+///
+/// # Safety
+/// `iterator` must be valid; `frame` non-null, pointing at NULL or at a
+/// handle from this library that no other thread is using.
+#[unsafe(no_mangle)]
+pub unsafe extern "C" fn con_frame_iterator_next_into(
+    iterator: *mut CConFrameIterator,
+    frame: *mut *mut RKRConFrame,
+) -> bool {
+    if iterator.is_null() || frame.is_null() {
+        return false;
+    }
+    let c_iter = unsafe { &mut *iterator };
+    let mut fresh = None;
+    let target: &mut ConFrame = match unsafe { (*frame as *mut ConFrame).as_mut() } {
+        Some(existing) => existing,
+        None => fresh.insert(ConFrame::default()),
+    };
+    let ok = if !c_iter.stream.is_null() {
+        let stream = unsafe { &mut (*c_iter.stream).stream };
+        matches!(stream.next_into(target), Some(Ok(())))
+    } else {
+        let (ok, offset) = if !c_iter.parallel.is_null() {
+            let frames = unsafe { &mut *c_iter.parallel };
+            let ok = match frames.next() {
+                Some(Ok(next)) => {
+                    *target = next;
+                    true
+                }
+                _ => false,
+            };
+            (ok, frames.byte_offset())
+        } else {
+            let iter = unsafe { &mut *c_iter.iterator };
+            (matches!(iter.next_into(target), Some(Ok(()))), iter.byte_offset())
+        };
+        let contents = unsafe { &*c_iter.file_contents };
+        c_iter.released = contents.release_before(c_iter.released, offset);
+        ok
+    };
+    if ok {
+        if let Some(new_frame) = fresh {
+            unsafe { *frame = Box::into_raw(Box::new(new_frame)) as *mut RKRConFrame };
+        }
+    }
+    ok
+}
+/// Skips up to `n` frames without parsing their atom data and returns the
+/// number actually skipped (fewer than `n` at end of input or at a malformed
+/// frame). Use with [`con_frame_iterator_next`] for strided reads: next, then
+/// skip `step - 1`.
+///
+/// # Safety
+/// iterator must be valid or null (returns 0).
+#[unsafe(no_mangle)]
+pub unsafe extern "C" fn con_frame_iterator_skip(
+    iterator: *mut CConFrameIterator,
+    n: usize,
+) -> usize {
+    if iterator.is_null() {
+        return 0;
+    }
+    let c_iter = unsafe { &mut *iterator };
+    if !c_iter.stream.is_null() {
+        let stream = unsafe { &mut (*c_iter.stream).stream };
+        let before = stream.next_frame_index();
+        let _ = stream.skip_frames(n);
+        return stream.next_frame_index() - before;
+    }
+    let (skipped, offset) = if !c_iter.parallel.is_null() {
+        let frames = unsafe { &mut *c_iter.parallel };
+        let before = frames.next_frame_index();
+        let _ = frames.skip_frames(n);
+        (frames.next_frame_index() - before, frames.byte_offset())
+    } else {
+        let iter = unsafe { &mut *c_iter.iterator };
+        let before = iter.next_frame_index();
+        let _ = iter.skip_frames(n);
+        (iter.next_frame_index() - before, iter.byte_offset())
+    };
+    let contents = unsafe { &*c_iter.file_contents };
+    c_iter.released = contents.release_before(c_iter.released, offset);
+    skipped
+}
+/// Positions the iterator so the next [`con_frame_iterator_next`] returns
+/// frame `frame_index` (0-based). Backward seeks are allowed.
+///
+/// O(1) when the file had a fresh `.con.idx` sidecar at open time (see
+/// [`rkr_write_offset_index`]); otherwise intervening frames are skipped
+/// without parsing, and compressed inputs are reopened to seek backward.
+///
+/// Returns `RKR_STATUS_INDEX_OUT_OF_BOUNDS` when the input holds fewer than
+/// `frame_index + 1` frames (the iterator is then exhausted), and
+/// `RKR_STATUS_IO_ERROR` on a malformed frame before the target or a failed
+/// reopen.
+///
+/// # Safety
+/// iterator must be valid or null.
+#[unsafe(no_mangle)]
+pub unsafe extern "C" fn con_frame_iterator_seek(
+    iterator: *mut CConFrameIterator,
+    frame_index: usize,
+) -> RKRStatus {
+    if iterator.is_null() {
+        return RKRStatus::RKR_STATUS_NULL_POINTER;
+    }
+    let c_iter = unsafe { &mut *iterator };
+    let found = if !c_iter.stream.is_null() {
+        let src = unsafe { &mut *c_iter.stream };
+        if frame_index < src.stream.next_frame_index() {
+            match crate::streaming::StreamingConFrameIterator::from_path(&src.path) {
+                Ok(stream) => src.stream = stream,
+                Err(_) => return RKRStatus::RKR_STATUS_IO_ERROR,
+            }
+        }
+        let want = frame_index - src.stream.next_frame_index();
+        match src.stream.skip_frames(want) {
+            Ok(n) if n == want => src.stream.has_next(),
+            other => other.map(|_| false),
+        }
+    } else {
+        let (found, offset) = if !c_iter.parallel.is_null() {
+            let frames = unsafe { &mut *c_iter.parallel };
+            (frames.seek(frame_index), frames.byte_offset())
+        } else {
+            let iter = unsafe { &mut *c_iter.iterator };
+            (iter.seek(frame_index), iter.byte_offset())
+        };
+        let contents = unsafe { &*c_iter.file_contents };
+        c_iter.released = contents.release_before(c_iter.released, offset);
+        found
+    };
+    match found {
+        Ok(true) => RKRStatus::RKR_STATUS_SUCCESS,
+        Ok(false) => RKRStatus::RKR_STATUS_INDEX_OUT_OF_BOUNDS,
+        Err(_) => RKRStatus::RKR_STATUS_IO_ERROR,
+    }
+}
+/// Index of the frame the next [`con_frame_iterator_next`] returns.
+///
+/// # Safety
+/// iterator must be valid or null (returns 0).
+#[unsafe(no_mangle)]
+pub unsafe extern "C" fn con_frame_iterator_position(iterator: *const CConFrameIterator) -> usize {
+    if iterator.is_null() {
+        return 0;
+    }
+    let c_iter = unsafe { &*iterator };
+    if !c_iter.stream.is_null() {
+        unsafe { (*c_iter.stream).stream.next_frame_index() }
+    } else if !c_iter.parallel.is_null() {
+        unsafe { (*c_iter.parallel).next_frame_index() }
+    } else {
+        unsafe { (*c_iter.iterator).next_frame_index() }
+    }
+}
+/// Restricts the per-atom columns decoded by later
+/// [`con_frame_iterator_next`] calls to `columns`, a bitwise OR of
+/// `RKR_COLUMN_*` values (`RKR_COLUMNS_ALL` restores the full parse).
+///
+/// Sections left out are skipped by line count without decoding their rows
+/// and are absent from the returned frames; any section bit implies
+/// `RKR_COLUMN_POSITIONS`. With `columns == 0` frames carry the header and
+/// metadata only (no atoms), e.g. for energy screening; such frames cannot
+/// be written back. Frames a parallel iterator already decoded ahead keep
+/// the previous projection.
+///
+/// # Safety
+/// iterator must be valid or null.
+#[unsafe(no_mangle)]
+pub unsafe extern "C" fn con_frame_iterator_set_columns(
+    iterator: *mut CConFrameIterator,
+    columns: u32,
+) -> RKRStatus {
+    if iterator.is_null() {
+        return RKRStatus::RKR_STATUS_NULL_POINTER;
+    }
+    let columns = crate::types::ColumnMask(columns & RKR_COLUMNS_ALL);
+    let c_iter = unsafe { &mut *iterator };
+    if !c_iter.stream.is_null() {
+        unsafe { (*c_iter.stream).stream.set_projection(columns) };
+    } else if !c_iter.parallel.is_null() {
+        unsafe { (*c_iter.parallel).set_projection(columns) };
+    } else {
+        unsafe { (*c_iter.iterator).set_projection(columns) };
+    }
+    RKRStatus::RKR_STATUS_SUCCESS
+}
 /// Frees the memory for an opaque `RKRConFrame` handle.
 ///
 /// # Safety
@@ -630,7 +1014,18 @@ pub unsafe extern "C" fn free_con_frame_iterator(iterator: *mut CConFrameIterato
     }
     unsafe {
         let c_iterator_box = Box::from_raw(iterator);
-        let _ = Box::from_raw(c_iterator_box.iterator);
+        if !c_iterator_box.stream.is_null() {
+            let _ = Box::from_raw(c_iterator_box.stream);
+            return;
+        }
+        if !c_iterator_box.parallel.is_null() {
+            let _ = Box::from_raw(c_iterator_box.parallel);
+        } else {
+            let _ = Box::from_raw(c_iterator_box.iterator);
+        }
+        if !c_iterator_box.offset_index.is_null() {
+            let _ = Box::from_raw(c_iterator_box.offset_index);
+        }
         let _ = Box::from_raw(c_iterator_box.file_contents);
     }
 }
@@ -841,7 +1236,30 @@ pub unsafe extern "C" fn rkr_free_string(s: *mut c_char) {
 /// to exactly one type regardless of the compression chosen at
 /// construction. Dropping the box flushes the `BufWriter` and then runs
 /// the sink's own `Drop` (gzip/zstd finalize their streams there).
-type RkrWriter = ConFrameWriter<Box<dyn std::io::Write>>;
+///
+/// `Chunked` handles (`create_writer_parallel_c`) write whole chunks
+/// straight to the file; `free_rkr_writer` finishes them so `.zst` outputs
+/// get their seek table.
+enum RkrWriter {
+    Stream(ConFrameWriter<Box<dyn std::io::Write>>),
+    Chunked(ParallelConWriter<File>),
+}
+
+impl RkrWriter {
+    fn set_canonical(&mut self, on: bool) {
+        match self {
+            Self::Stream(w) => w.set_canonical(on),
+            Self::Chunked(w) => w.set_canonical(on),
+        }
+    }
+
+    fn is_canonical(&self) -> bool {
+        match self {
+            Self::Stream(w) => w.is_canonical(),
+            Self::Chunked(w) => w.is_canonical(),
+        }
+    }
+}
 /// Boxes a sink into an `RKRConFrameWriter` handle at the requested
 /// precision. `precision == None` selects the writer's built-in default.
 #[inline]
@@ -849,11 +1267,11 @@ fn into_rkr_writer(
     sink: Box<dyn std::io::Write>,
     precision: Option<u8>,
 ) -> *mut RKRConFrameWriter {
-    let writer: RkrWriter = match precision {
+    let writer = match precision {
         Some(p) => ConFrameWriter::with_precision(sink, p as usize),
         None => ConFrameWriter::new(sink),
     };
-    Box::into_raw(Box::new(writer)) as *mut RKRConFrameWriter
+    Box::into_raw(Box::new(RkrWriter::Stream(writer))) as *mut RKRConFrameWriter
 }
 /// Parses a borrowed C string, returning `None` for null or non-UTF-8.
 #[inline]
@@ -888,7 +1306,11 @@ pub unsafe extern "C" fn create_writer_from_path_c(
 #[unsafe(no_mangle)]
 pub unsafe extern "C" fn free_rkr_writer(writer_handle: *mut RKRConFrameWriter) {
     if !writer_handle.is_null() {
-        let _ = unsafe { Box::from_raw(writer_handle as *mut RkrWriter) };
+        let writer = unsafe { Box::from_raw(writer_handle as *mut RkrWriter) };
+        if let RkrWriter::Chunked(w) = *writer {
+            // Appends the seek table of `.zst` outputs.
+            let _ = w.finish();
+        }
     }
 }
 /// Writes multiple frames from an array of handles to the file managed by the writer.
@@ -924,7 +1346,14 @@ pub unsafe extern "C" fn rkr_writer_extend(
             None => return RKRStatus::RKR_STATUS_NULL_POINTER,
         }
     }
-    match writer.extend(rust_frames.into_iter()) {
+    let written = match writer {
+        #[cfg(feature = "parallel")]
+        RkrWriter::Stream(w) => w.par_extend(&rust_frames),
+        #[cfg(not(feature = "parallel"))]
+        RkrWriter::Stream(w) => w.extend(rust_frames.into_iter()),
+        RkrWriter::Chunked(w) => w.extend(&rust_frames),
+    };
+    match written {
         Ok(_) => RKRStatus::RKR_STATUS_SUCCESS,
         Err(_) => RKRStatus::RKR_STATUS_IO_ERROR,
     }
@@ -1064,6 +1493,44 @@ pub unsafe extern "C" fn create_writer_from_path_with_precision_c(
     }
 }
 //=============================================================================
+// Chunked Parallel Writer
+//=============================================================================
+/// Creates a writer whose `rkr_writer_extend` formats frames in parallel
+/// chunks and writes them in order. A `.gz` / `.zst` filename compresses
+/// each chunk as an independent gzip member / zstd frame on the worker, so
+/// compression scales with cores too; other names write plain text. A
+/// `.zst` output ends with a seek table, so `rkr_read_frame`-style random
+/// access inflates only the block holding the frame.
+/// Returns NULL on a bad path, on I/O failure, or for `.zst` when the
+/// library was built without zstd.
+/// The caller OWNS the returned pointer and MUST call `free_rkr_writer`.
+///
+/// # Safety
+/// filename_c must be valid. The caller takes ownership of the returned writer.
+#[unsafe(no_mangle)]
+pub unsafe extern "C" fn create_writer_parallel_c(
+    filename_c: *const c_char,
+    precision: u8,
+) -> *mut RKRConFrameWriter {
+    let filename = match unsafe { cstr_path(filename_c) } {
+        Some(s) => s,
+        None => return ptr::null_mut(),
+    };
+    let compression = match ChunkCompression::from_extension(Path::new(filename)) {
+        Ok(c) => c,
+        Err(_) => return ptr::null_mut(),
+    };
+    match File::create(filename) {
+        Ok(file) => {
+            let writer = ParallelConWriter::new(file)
+                .with_precision(precision as usize)
+                .with_compression(compression);
+            Box::into_raw(Box::new(RkrWriter::Chunked(writer))) as *mut RKRConFrameWriter
+        }
+        Err(_) => ptr::null_mut(),
+    }
+}
+//=============================================================================
 // Frame Builder FFI (construct ConFrame from C data)
 //=============================================================================
 /// An opaque handle to a Rust `ConFrameBuilder` object.
@@ -1438,6 +1905,107 @@ pub unsafe extern "C" fn rkr_frame_builder_set_atom_energies_from_flat(
         Err(e) => map_builder_err(e),
     }
 }
+/// `None` for a NULL column pointer, else the `len`-element slice behind it.
+///
+/// # Safety
+/// A non-NULL `ptr` must point to `len` initialized values.
+unsafe fn optional_column<'a, T>(ptr: *const T, len: usize) -> Option<&'a [T]> {
+    (!ptr.is_null()).then(|| unsafe { std::slice::from_raw_parts(ptr, len) })
+}
+
+/// Replaces every atom in the builder from flat columns in one call.
+///
+/// Species come from `n_runs` symbol runs (`run_symbols[k]` repeated
+/// `run_counts[k]` times) or, when `run_symbols` is NULL, from one atomic
+/// number per atom in `atomic_numbers`. `positions` (and `velocities` /
+/// `forces` when non-NULL) hold `3 * n_atoms` row-major f64; `masses`,
+/// `fixed` (CON column-4 bitmask), `atom_ids` and `energies` hold `n_atoms`
+/// values. NULL `fixed` means all free, NULL `atom_ids` means `0..n_atoms`,
+/// and NULL `velocities` / `forces` / `energies` leave that section out.
+/// Run counts that do not sum to `n_atoms` return
+/// RKR_STATUS_INDEX_OUT_OF_BOUNDS; run counts whose sum overflows `size_t`,
+/// or an `n_atoms` whose `3 * n_atoms` f64 columns would overflow the
+/// address space, return RKR_STATUS_VALIDATION_ERROR.
+/// # Safety
+/// builder_handle must be valid; every non-NULL pointer must cover the
+/// lengths above, and each `run_symbols[k]` must be a NUL-terminated string.
+#[unsafe(no_mangle)]
+#[allow(clippy::too_many_arguments)]
+pub unsafe extern "C" fn rkr_frame_builder_set_atoms_from_arrays(
+    builder_handle: *mut RKRConFrameBuilder,
+    n_atoms: usize,
+    positions: *const f64,
+    masses: *const f64,
+    run_symbols: *const *const c_char,
+    run_counts: *const usize,
+    n_runs: usize,
+    atomic_numbers: *const u64,
+    fixed: *const u8,
+    atom_ids: *const u64,
+    velocities: *const f64,
+    forces: *const f64,
+    energies: *const f64,
+) -> RKRStatus {
+    if builder_handle.is_null() || positions.is_null() || masses.is_null() {
+        return RKRStatus::RKR_STATUS_NULL_POINTER;
+    }
+    if run_symbols.is_null() && atomic_numbers.is_null() {
+        return RKRStatus::RKR_STATUS_NULL_POINTER;
+    }
+    if !run_symbols.is_null() && n_runs > 0 && run_counts.is_null() {
+        return RKRStatus::RKR_STATUS_NULL_POINTER;
+    }
+    // `3 * n_atoms` f64 is the longest column; it must be addressable.
+    let n_xyz = match n_atoms.checked_mul(3) {
+        Some(n) if n <= isize::MAX as usize / std::mem::size_of::<f64>() => n,
+        _ => return RKRStatus::RKR_STATUS_VALIDATION_ERROR,
+    };
+    let mut names: Vec<&str> = Vec::with_capacity(n_runs);
+    let counts: &[usize] = if run_symbols.is_null() || n_runs == 0 {
+        &[]
+    } else {
+        for k in 0..n_runs {
+            let name = unsafe { *run_symbols.add(k) };
+            if name.is_null() {
+                return RKRStatus::RKR_STATUS_NULL_POINTER;
+            }
+            match unsafe { CStr::from_ptr(name) }.to_str() {
+                Ok(name) => names.push(name),
+                Err(_) => return RKRStatus::RKR_STATUS_INVALID_UTF8,
+            }
+        }
+        unsafe { std::slice::from_raw_parts(run_counts, n_runs) }
+    };
+    let species = if run_symbols.is_null() {
+        let numbers = unsafe { std::slice::from_raw_parts(atomic_numbers, n_atoms) };
+        crate::types::SpeciesColumn::AtomicNumbers(numbers)
+    } else {
+        crate::types::SpeciesColumn::Runs {
+            symbols: &names,
+            counts,
+        }
+    };
+    match species.atom_count() {
+        Some(n) if n == n_atoms => {}
+        Some(_) => return RKRStatus::RKR_STATUS_INDEX_OUT_OF_BOUNDS,
+        None => return RKRStatus::RKR_STATUS_VALIDATION_ERROR,
+    }
+    let arrays = crate::types::FrameArrays {
+        species,
+        positions: unsafe { std::slice::from_raw_parts(positions, n_xyz) },
+        masses: unsafe { std::slice::from_raw_parts(masses, n_atoms) },
+        fixed: unsafe { optional_column(fixed, n_atoms) },
+        atom_ids: unsafe { optional_column(atom_ids, n_atoms) },
+        velocities: unsafe { optional_column(velocities, n_xyz) },
+        forces: unsafe { optional_column(forces, n_xyz) },
+        energies: unsafe { optional_column(energies, n_atoms) },
+    };
+    let builder = unsafe { &mut *(builder_handle as *mut ConFrameBuilder) };
+    match builder.set_atoms_from_arrays(&arrays) {
+        Ok(_) => RKRStatus::RKR_STATUS_SUCCESS,
+        Err(e) => map_builder_err(e),
+    }
+}
 /// Reads the position of an existing atom into 3 contiguous f64 out values.
 /// # Safety
 /// builder_handle must be valid; out_xyz must point to 3 writable f64.
@@ -1664,7 +2232,7 @@ pub struct RKRDLDevice {
 /// `RKR_STATUS_VALIDATION_ERROR` until implemented.
 ///
 /// **Device:** `kDLCPU` always; with `--features cuda`, `kDLCUDA` performs H2D
-/// into real device memory then exports DLPack. Other devices return
+/// into real device memory then exports DLPack (`kDLFloat` 64 / 32 / 16). Other devices return
 /// `RKR_STATUS_FEATURE_DISABLED` so callers can feature-detect.
 #[repr(C)]
 #[derive(Clone, Copy, Debug)]
@@ -1785,6 +2353,18 @@ fn export_f64_slice_as_dlpack(
     finish_dlpack_tensor(tensor, out_tensor)
 }
 
+/// Float dtypes the CUDA export path uploads (`kDLFloat` 64 / 32 / 16).
+#[cfg(feature = "cuda")]
+fn cuda_float_kind(dtype: RKRDLDataType) -> Option<crate::storage_dtype::ElementKind> {
+    use crate::storage_dtype::ElementKind;
+    match (dtype.code, dtype.bits) {
+        (rkr_dl_type_code::RKR_DL_FLOAT, 64) => Some(ElementKind::Float64),
+        (rkr_dl_type_code::RKR_DL_FLOAT, 32) => Some(ElementKind::Float32),
+        (rkr_dl_type_code::RKR_DL_FLOAT, 16) => Some(ElementKind::Float16),
+        _ => None,
+    }
+}
+
 fn export_owned_array2_dlpack_opts(
     arr: &ndarray::ArcArray2<f64>,
     opts: &RKRDlpackExportOptions,
@@ -1795,14 +2375,15 @@ fn export_owned_array2_dlpack_opts(
     if opts.device.device_type == rkr_dl_device_type::RKR_DL_CUDA {
         #[cfg(feature = "cuda")]
         {
-            // H2D into real device memory (f64 only for CUDA path here).
-            if opts.dtype.code != rkr_dl_type_code::RKR_DL_FLOAT || opts.dtype.bits != 64 {
+            // H2D into real device memory, narrowed on the host to f32 / f16.
+            let Some(kind) = cuda_float_kind(opts.dtype) else {
                 return RKRStatus::RKR_STATUS_VALIDATION_ERROR;
-            }
+            };
             return finish_dlpack_tensor(
-                crate::cuda_array::export_host_f64_as_cuda_dlpack(
+                crate::cuda_array::export_host_as_cuda_dlpack(
                     &[r, c],
                     &flat,
+                    kind,
                     opts.device.device_id,
                 ),
                 out_tensor,
@@ -1826,13 +2407,14 @@ fn export_owned_array1_f64_dlpack_opts(
     if opts.device.device_type == rkr_dl_device_type::RKR_DL_CUDA {
         #[cfg(feature = "cuda")]
         {
-            if opts.dtype.code != rkr_dl_type_code::RKR_DL_FLOAT || opts.dtype.bits != 64 {
+            let Some(kind) = cuda_float_kind(opts.dtype) else {
                 return RKRStatus::RKR_STATUS_VALIDATION_ERROR;
-            }
+            };
             return finish_dlpack_tensor(
-                crate::cuda_array::export_host_f64_as_cuda_dlpack(
+                crate::cuda_array::export_host_as_cuda_dlpack(
                     &[n],
                     &flat,
+                    kind,
                     opts.device.device_id,
                 ),
                 out_tensor,
@@ -2958,66 +3540,234 @@ pub unsafe extern "C" fn rkr_read_first_frame(filename_c: *const c_char) -> *mut
         Err(_) => ptr::null_mut(),
     }
 }
-/// Reads all frames from a .con file using mmap.
-/// Returns an array of frame handles and sets `num_frames` to the count.
-/// The caller OWNS both the array and each frame handle.
-/// Free frames with `free_rkr_frame` and the array with `free_rkr_frame_array`.
-/// Returns NULL on error.
+/// Reads frame `index` (0-based) from a .con file.
+/// Uses a fresh `<file>.idx` sidecar (see [`rkr_write_offset_index`]) to seek
+/// straight to the frame; otherwise skips the preceding frames without
+/// parsing their atom data.
+/// The caller OWNS the returned handle and MUST call `free_rkr_frame`.
+/// Returns NULL on error or if `index` is past the last frame.
 ///
 /// # Safety
-/// filename_c and num_frames must be valid. The caller takes ownership of the returned handles and array.
+/// filename_c must be valid. The caller takes ownership of the returned frame.
 #[unsafe(no_mangle)]
-pub unsafe extern "C" fn rkr_read_all_frames(
+pub unsafe extern "C" fn rkr_read_frame(
     filename_c: *const c_char,
-    num_frames: *mut usize,
-) -> *mut *mut RKRConFrame {
-    if filename_c.is_null() || num_frames.is_null() {
+    index: usize,
+) -> *mut RKRConFrame {
+    if filename_c.is_null() {
         return ptr::null_mut();
     }
     let filename = match unsafe { CStr::from_ptr(filename_c).to_str() } {
         Ok(s) => s,
         Err(_) => return ptr::null_mut(),
     };
-    match iterators::read_all_frames(Path::new(filename)) {
-        Ok(frames) => {
-            let count = frames.len();
-            // shrink_to_fit ensures len == capacity so the matching
-            // free_rkr_frame_array can soundly call Vec::from_raw_parts
-            // with len == cap.
-            let mut handles: Vec<*mut RKRConFrame> = frames
-                .into_iter()
-                .map(|f| Box::into_raw(Box::new(f)) as *mut RKRConFrame)
-                .collect();
-            handles.shrink_to_fit();
-            debug_assert_eq!(handles.len(), handles.capacity());
-            let ptr = handles.as_mut_ptr();
-            std::mem::forget(handles);
-            unsafe { *num_frames = count };
-            ptr
-        }
+    match iterators::read_frame(Path::new(filename), index) {
+        Ok(frame) => Box::into_raw(Box::new(frame)) as *mut RKRConFrame,
         Err(_) => ptr::null_mut(),
     }
 }
-/// Frees an array of frame handles returned by `rkr_read_all_frames`.
-/// Each frame is freed individually, then the array itself.
+/// Builds the frame offset index for an uncompressed .con file and writes it
+/// to `<file>.idx`. Later [`rkr_read_frame`] calls (and `count_frames` in
+/// every binding) use it while the file's size and mtime are unchanged.
+///
+/// Returns `RKR_STATUS_IO_ERROR` if the file cannot be read or parsed, is
+/// compressed, or the sidecar cannot be written.
 ///
 /// # Safety
-/// frames must be valid or null.
+/// filename_c must be a valid null-terminated string or NULL.
 #[unsafe(no_mangle)]
-pub unsafe extern "C" fn free_rkr_frame_array(frames: *mut *mut RKRConFrame, num_frames: usize) {
-    if frames.is_null() {
-        return;
+pub unsafe extern "C" fn rkr_write_offset_index(filename_c: *const c_char) -> RKRStatus {
+    if filename_c.is_null() {
+        return RKRStatus::RKR_STATUS_NULL_POINTER;
     }
-    unsafe {
-        let handles = Vec::from_raw_parts(frames, num_frames, num_frames);
-        for handle in handles {
-            if !handle.is_null() {
-                let _ = Box::from_raw(handle as *mut ConFrame);
-            }
-        }
+    let filename = match unsafe { CStr::from_ptr(filename_c).to_str() } {
+        Ok(s) => s,
+        Err(_) => return RKRStatus::RKR_STATUS_INVALID_UTF8,
+    };
+    let path = Path::new(filename);
+    match crate::offset_index::FrameOffsetIndex::build_for_path(path)
+        .and_then(|index| Ok(index.write_sidecar(path)?))
+    {
+        Ok(()) => RKRStatus::RKR_STATUS_SUCCESS,
+        Err(_) => RKRStatus::RKR_STATUS_IO_ERROR,
     }
 }
-/// Free only the outer pointer array from `rkr_read_all_frames` (not the frames).
+/// Opaque handle for the frames accepted by [`rkr_query_frames`].
+pub struct RKRQueryResult;
+/// Screens the .con file at `filename_c` with a frame query such as
+/// `energy < -40 && composition == 'Cu:2|H:2' && fmax < 0.05` (grammar in
+/// [`crate::query::FrameQuery::parse`]). Answered from a fresh `<file>.idx`
+/// sidecar without parsing frames when present, otherwise by a projected
+/// scan that decodes only the columns the predicates need.
+///
+/// On success writes a result handle to `*out_result` (free with
+/// [`rkr_query_result_free`]). Returns `RKR_STATUS_VALIDATION_ERROR` for a
+/// malformed expression and `RKR_STATUS_IO_ERROR` if the file cannot be
+/// read or parsed; `*out_result` is untouched on error.
+///
+/// # Safety
+/// All pointers must be non-null; strings must be null-terminated.
+#[unsafe(no_mangle)]
+pub unsafe extern "C" fn rkr_query_frames(
+    filename_c: *const c_char,
+    expr_c: *const c_char,
+    out_result: *mut *mut RKRQueryResult,
+) -> RKRStatus {
+    if filename_c.is_null() || expr_c.is_null() || out_result.is_null() {
+        return RKRStatus::RKR_STATUS_NULL_POINTER;
+    }
+    let (filename, expr) = match (
+        unsafe { CStr::from_ptr(filename_c) }.to_str(),
+        unsafe { CStr::from_ptr(expr_c) }.to_str(),
+    ) {
+        (Ok(f), Ok(e)) => (f, e),
+        _ => return RKRStatus::RKR_STATUS_INVALID_UTF8,
+    };
+    let query = match crate::query::FrameQuery::parse(expr) {
+        Ok(q) => q,
+        Err(_) => return RKRStatus::RKR_STATUS_VALIDATION_ERROR,
+    };
+    match crate::query::query_frames(Path::new(filename), &query) {
+        Ok(hits) => {
+            unsafe {
+                *out_result = Box::into_raw(Box::new(hits)) as *mut RKRQueryResult;
+            }
+            RKRStatus::RKR_STATUS_SUCCESS
+        }
+        Err(_) => RKRStatus::RKR_STATUS_IO_ERROR,
+    }
+}
+/// Number of frames accepted by the query (0 for NULL).
+///
+/// # Safety
+/// `result_handle` must be from [`rkr_query_frames`] or NULL.
+#[unsafe(no_mangle)]
+pub unsafe extern "C" fn rkr_query_result_len(result_handle: *const RKRQueryResult) -> u64 {
+    match unsafe { (result_handle as *const Vec<crate::query::QueryHit>).as_ref() } {
+        Some(hits) => hits.len() as u64,
+        None => 0,
+    }
+}
+/// Copies the accepted frames, in file order: frame indices to `out_frames`
+/// and byte offset / length of each frame to `out_offsets` / `out_lens`.
+/// Any of the three arrays may be NULL to skip it. `*out_written` (if
+/// non-null) receives the hit count; returns `RKR_STATUS_BUFFER_TOO_SMALL`
+/// when `capacity` is less than that.
+///
+/// Spans address the file bytes, or the decompressed text for a
+/// compressed input (which is never indexed).
+///
+/// # Safety
+/// Non-null arrays must hold at least `capacity` elements.
+#[unsafe(no_mangle)]
+pub unsafe extern "C" fn rkr_query_result_hits(
+    result_handle: *const RKRQueryResult,
+    out_frames: *mut u64,
+    out_offsets: *mut u64,
+    out_lens: *mut u64,
+    capacity: u64,
+    out_written: *mut u64,
+) -> RKRStatus {
+    let Some(hits) = (unsafe { (result_handle as *const Vec<crate::query::QueryHit>).as_ref() })
+    else {
+        return RKRStatus::RKR_STATUS_NULL_POINTER;
+    };
+    let n = hits.len() as u64;
+    if !out_written.is_null() {
+        unsafe {
+            *out_written = n;
+        }
+    }
+    if capacity < n {
+        return RKRStatus::RKR_STATUS_BUFFER_TOO_SMALL;
+    }
+    for (i, hit) in hits.iter().enumerate() {
+        unsafe {
+            if !out_frames.is_null() {
+                *out_frames.add(i) = hit.frame as u64;
+            }
+            if !out_offsets.is_null() {
+                *out_offsets.add(i) = hit.span.start as u64;
+            }
+            if !out_lens.is_null() {
+                *out_lens.add(i) = hit.span.len() as u64;
+            }
+        }
+    }
+    RKRStatus::RKR_STATUS_SUCCESS
+}
+/// Frees a result from [`rkr_query_frames`]. Safe with NULL.
+///
+/// # Safety
+/// `result_handle` must be from [`rkr_query_frames`] or NULL.
+#[unsafe(no_mangle)]
+pub unsafe extern "C" fn rkr_query_result_free(result_handle: *mut RKRQueryResult) {
+    if !result_handle.is_null() {
+        unsafe {
+            drop(Box::from_raw(result_handle as *mut Vec<crate::query::QueryHit>));
+        }
+    }
+}
+/// Reads all frames from a .con file using mmap.
+/// Returns an array of frame handles and sets `num_frames` to the count.
+/// The caller OWNS both the array and each frame handle.
+/// Free frames with `free_rkr_frame` and the array with `free_rkr_frame_array`.
+/// Returns NULL on error.
+///
+/// # Safety
+/// filename_c and num_frames must be valid. The caller takes ownership of the returned handles and array.
+#[unsafe(no_mangle)]
+pub unsafe extern "C" fn rkr_read_all_frames(
+    filename_c: *const c_char,
+    num_frames: *mut usize,
+) -> *mut *mut RKRConFrame {
+    if filename_c.is_null() || num_frames.is_null() {
+        return ptr::null_mut();
+    }
+    let filename = match unsafe { CStr::from_ptr(filename_c).to_str() } {
+        Ok(s) => s,
+        Err(_) => return ptr::null_mut(),
+    };
+    match iterators::read_all_frames(Path::new(filename)) {
+        Ok(frames) => {
+            let count = frames.len();
+            // shrink_to_fit ensures len == capacity so the matching
+            // free_rkr_frame_array can soundly call Vec::from_raw_parts
+            // with len == cap.
+            let mut handles: Vec<*mut RKRConFrame> = frames
+                .into_iter()
+                .map(|f| Box::into_raw(Box::new(f)) as *mut RKRConFrame)
+                .collect();
+            handles.shrink_to_fit();
+            debug_assert_eq!(handles.len(), handles.capacity());
+            let ptr = handles.as_mut_ptr();
+            std::mem::forget(handles);
+            unsafe { *num_frames = count };
+            ptr
+        }
+        Err(_) => ptr::null_mut(),
+    }
+}
+/// Frees an array of frame handles returned by `rkr_read_all_frames`.
+/// Each frame is freed individually, then the array itself.
+///
+/// # Safety
+/// frames must be valid or null.
+#[unsafe(no_mangle)]
+pub unsafe extern "C" fn free_rkr_frame_array(frames: *mut *mut RKRConFrame, num_frames: usize) {
+    if frames.is_null() {
+        return;
+    }
+    unsafe {
+        let handles = Vec::from_raw_parts(frames, num_frames, num_frames);
+        for handle in handles {
+            if !handle.is_null() {
+                let _ = Box::from_raw(handle as *mut ConFrame);
+            }
+        }
+    }
+}
+/// Free only the outer pointer array from `rkr_read_all_frames` (not the frames).
 ///
 /// # Safety
 /// `frames` null or from `rkr_read_all_frames` with length `num_frames`. Frame
@@ -3147,6 +3897,75 @@ pub unsafe extern "C" fn rkr_frame_metatensor_atom_energies_block(
         Ok(Err(_)) | Err(_) => RKRStatus::RKR_STATUS_INTERNAL_ERROR,
     }
 }
+/// Free an owned map from [`rkr_read_trajectory_metatensor`]. Prefer this
+/// or `mts_tensormap_free` (metatensor.h) — not both on the same pointer.
+///
+/// # Safety
+/// `map` is NULL or an owning `mts_tensormap_t*` from this library.
+#[cfg(feature = "metatensor")]
+#[unsafe(no_mangle)]
+pub unsafe extern "C" fn rkr_mts_tensormap_free(map: *mut metatensor::c_api::mts_tensormap_t) {
+    unsafe { crate::metatensor_export::mts_tensormap_free_sys(map) };
+}
+/// Frames `start, start + step, …` before `stop` (`RKR_FRAMES_END`: to the
+/// end) as one TensorMap with `(system, atom)` samples, keyed per
+/// `RKR_MTS_KEYS_*`. Frame-range rules and errors are those of
+/// [`rkr_read_trajectory_tensors`]; an unknown `keys` or forces requested
+/// from frames without them is `RKR_STATUS_VALIDATION_ERROR`. Caller frees
+/// with `rkr_mts_tensormap_free` / `mts_tensormap_free`.
+///
+/// # Safety
+/// `filename_c` must be a valid null-terminated string; `out_map` non-null.
+#[cfg(feature = "metatensor")]
+#[unsafe(no_mangle)]
+pub unsafe extern "C" fn rkr_read_trajectory_metatensor(
+    filename_c: *const c_char,
+    start: usize,
+    stop: usize,
+    step: usize,
+    keys: u32,
+    out_map: *mut *mut metatensor::c_api::mts_tensormap_t,
+) -> RKRStatus {
+    use crate::trajectory_tensor::{BatchKeys, BatchQuantity};
+    if filename_c.is_null() || out_map.is_null() {
+        return RKRStatus::RKR_STATUS_NULL_POINTER;
+    }
+    unsafe { *out_map = std::ptr::null_mut() };
+    let filename = match unsafe { CStr::from_ptr(filename_c).to_str() } {
+        Ok(s) => s,
+        Err(_) => return RKRStatus::RKR_STATUS_INVALID_UTF8,
+    };
+    let keys = match keys {
+        RKR_MTS_KEYS_QUANTITY => BatchKeys::Quantity,
+        RKR_MTS_KEYS_SPECIES_POSITIONS => BatchKeys::Species(BatchQuantity::Positions),
+        RKR_MTS_KEYS_SPECIES_FORCES => BatchKeys::Species(BatchQuantity::Forces),
+        _ => return RKRStatus::RKR_STATUS_VALIDATION_ERROR,
+    };
+    let stop = (stop != RKR_FRAMES_END).then_some(stop);
+    match std::panic::catch_unwind(std::panic::AssertUnwindSafe(|| {
+        crate::metatensor_export::read_trajectory_tensor_map(
+            Path::new(filename),
+            start,
+            stop,
+            step,
+            keys,
+        )
+    })) {
+        Ok(Ok(map)) => {
+            unsafe { *out_map = metatensor::TensorMap::into_raw(map) };
+            RKRStatus::RKR_STATUS_SUCCESS
+        }
+        Ok(Err(e)) => match e.downcast_ref::<crate::error::ParseError>() {
+            Some(crate::error::ParseError::ValidationError(_)) => {
+                RKRStatus::RKR_STATUS_VALIDATION_ERROR
+            }
+            Some(_) => RKRStatus::RKR_STATUS_IO_ERROR,
+            None if e.is::<metatensor::Error>() => RKRStatus::RKR_STATUS_INTERNAL_ERROR,
+            None => RKRStatus::RKR_STATUS_IO_ERROR,
+        },
+        Err(_) => RKRStatus::RKR_STATUS_INTERNAL_ERROR,
+    }
+}
 #[cfg(not(feature = "zstd"))]
 #[unsafe(no_mangle)]
 pub unsafe extern "C" fn create_writer_zstd_c(_filename_c: *const c_char) -> *mut RKRConFrameWriter {
@@ -3169,10 +3988,33 @@ pub struct mts_block_t {
     _private: [u8; 0],
 }
 #[cfg(not(feature = "metatensor"))]
+#[repr(C)]
+pub struct mts_tensormap_t {
+    _private: [u8; 0],
+}
+#[cfg(not(feature = "metatensor"))]
 #[unsafe(no_mangle)]
 pub unsafe extern "C" fn rkr_mts_block_free(_block: *mut mts_block_t) {}
 #[cfg(not(feature = "metatensor"))]
 #[unsafe(no_mangle)]
+pub unsafe extern "C" fn rkr_mts_tensormap_free(_map: *mut mts_tensormap_t) {}
+#[cfg(not(feature = "metatensor"))]
+#[unsafe(no_mangle)]
+pub unsafe extern "C" fn rkr_read_trajectory_metatensor(
+    _filename_c: *const c_char,
+    _start: usize,
+    _stop: usize,
+    _step: usize,
+    _keys: u32,
+    out_map: *mut *mut mts_tensormap_t,
+) -> RKRStatus {
+    if !out_map.is_null() {
+        unsafe { *out_map = std::ptr::null_mut() };
+    }
+    RKRStatus::RKR_STATUS_FEATURE_DISABLED
+}
+#[cfg(not(feature = "metatensor"))]
+#[unsafe(no_mangle)]
 pub unsafe extern "C" fn rkr_frame_metatensor_positions_block(
     _frame_handle: *const RKRConFrame,
     out_block: *mut *mut mts_block_t,
@@ -3383,6 +4225,134 @@ pub unsafe extern "C" fn rkr_frame_copy_atom_ids(
     }
     RKRStatus::RKR_STATUS_SUCCESS
 }
+// ----- Borrowed frame SoA buffers (no copy) ------------------------------------
+//
+// Read-only counterparts of `rkr_frame_builder_*_data` for parsed frames:
+// pointers into the frame's own SoA blocks, valid while the frame handle is
+// alive (frames are immutable through the C ABI). A block is only borrowable
+// when stored as f64, which is the default; frames whose metadata selects a
+// narrower storage dtype return NULL here and must use `rkr_frame_copy_*`.
+/// Borrow positions as a row-major `(N, 3)` f64 buffer, `N =
+/// rkr_frame_atom_count`. NULL for a null handle, a frame without atoms, or
+/// non-f64 storage.
+///
+/// # Safety
+/// `frame_handle` must be valid or null; the pointer dies with the frame.
+#[unsafe(no_mangle)]
+pub unsafe extern "C" fn rkr_frame_positions_data(frame_handle: *const RKRConFrame) -> *const f64 {
+    unsafe { frame_block_ptr(frame_handle, |f| f.positions.as_f64_slice()) }
+}
+/// Borrow velocities as `(N, 3)` f64; NULL when the section is absent.
+///
+/// # Safety
+/// Same contract as rkr_frame_positions_data.
+#[unsafe(no_mangle)]
+pub unsafe extern "C" fn rkr_frame_velocities_data(
+    frame_handle: *const RKRConFrame,
+) -> *const f64 {
+    unsafe { frame_block_ptr(frame_handle, |f| f.velocities.as_f64_slice()) }
+}
+/// Borrow forces as `(N, 3)` f64; NULL when the section is absent.
+///
+/// # Safety
+/// Same contract as rkr_frame_positions_data.
+#[unsafe(no_mangle)]
+pub unsafe extern "C" fn rkr_frame_forces_data(frame_handle: *const RKRConFrame) -> *const f64 {
+    unsafe { frame_block_ptr(frame_handle, |f| f.forces.as_f64_slice()) }
+}
+/// Borrow per-atom masses as `(N,)` f64.
+///
+/// # Safety
+/// Same contract as rkr_frame_positions_data.
+#[unsafe(no_mangle)]
+pub unsafe extern "C" fn rkr_frame_masses_data(frame_handle: *const RKRConFrame) -> *const f64 {
+    unsafe { frame_block_ptr(frame_handle, |f| f.masses.as_f64_slice()) }
+}
+/// Borrow per-atom energies as `(N,)` f64; NULL when the section is absent.
+///
+/// # Safety
+/// Same contract as rkr_frame_positions_data.
+#[unsafe(no_mangle)]
+pub unsafe extern "C" fn rkr_frame_atom_energies_data(
+    frame_handle: *const RKRConFrame,
+) -> *const f64 {
+    unsafe { frame_block_ptr(frame_handle, |f| f.atom_energies.as_f64_slice()) }
+}
+/// Borrow per-atom ids as `(N,)` u64.
+///
+/// # Safety
+/// Same contract as rkr_frame_positions_data.
+#[unsafe(no_mangle)]
+pub unsafe extern "C" fn rkr_frame_atom_ids_data(frame_handle: *const RKRConFrame) -> *const u64 {
+    unsafe { frame_block_ptr(frame_handle, |f| f.atom_ids.as_slice()) }
+}
+/// Shared body of the `rkr_frame_*_data` getters: NULL for a null handle or
+/// an absent / empty / non-borrowable block.
+unsafe fn frame_block_ptr<T>(
+    frame_handle: *const RKRConFrame,
+    block: impl FnOnce(&ConFrame) -> Option<&[T]>,
+) -> *const T {
+    match unsafe { (frame_handle as *const ConFrame).as_ref() }.and_then(block) {
+        Some(slice) if !slice.is_empty() => slice.as_ptr(),
+        _ => ptr::null(),
+    }
+}
+/// Copy the cell lengths and angles into `out_cell[3]` / `out_angles[3]`
+/// without building the `CFrame` AoS copy. Either output may be NULL.
+///
+/// # Safety
+/// `frame_handle` must be valid; non-null outputs must hold 3 doubles.
+#[unsafe(no_mangle)]
+pub unsafe extern "C" fn rkr_frame_get_cell(
+    frame_handle: *const RKRConFrame,
+    out_cell: *mut f64,
+    out_angles: *mut f64,
+) -> RKRStatus {
+    let Some(frame) = (unsafe { (frame_handle as *const ConFrame).as_ref() }) else {
+        return RKRStatus::RKR_STATUS_NULL_POINTER;
+    };
+    if !out_cell.is_null() {
+        unsafe { std::ptr::copy_nonoverlapping(frame.header.boxl.as_ptr(), out_cell, 3) };
+    }
+    if !out_angles.is_null() {
+        unsafe { std::ptr::copy_nonoverlapping(frame.header.angles.as_ptr(), out_angles, 3) };
+    }
+    RKRStatus::RKR_STATUS_SUCCESS
+}
+
+#[cfg(test)]
+mod frame_view_ffi_tests {
+    use super::*;
+    use std::path::PathBuf;
+
+    #[test]
+    fn borrowed_blocks_alias_frame_storage() {
+        let p = PathBuf::from(env!("CARGO_MANIFEST_DIR")).join("resources/test/tiny_cuh2_forces.con");
+        let frame = crate::iterators::read_first_frame(&p).unwrap();
+        let handle = &frame as *const ConFrame as *const RKRConFrame;
+        let n = unsafe { rkr_frame_atom_count(handle) };
+        let pos = unsafe { std::slice::from_raw_parts(rkr_frame_positions_data(handle), 3 * n) };
+        for (i, a) in frame.atom_data.iter().enumerate() {
+            assert_eq!(&pos[3 * i..3 * i + 3], &[a.x, a.y, a.z]);
+        }
+        assert_eq!(
+            unsafe { rkr_frame_positions_data(handle) },
+            frame.positions.as_f64_slice().unwrap().as_ptr()
+        );
+        assert!(!unsafe { rkr_frame_forces_data(handle) }.is_null());
+        assert!(unsafe { rkr_frame_velocities_data(handle) }.is_null());
+        let ids = unsafe { std::slice::from_raw_parts(rkr_frame_atom_ids_data(handle), n) };
+        assert!(ids.iter().zip(&frame.atom_data).all(|(&id, a)| id == a.atom_id));
+        assert!(!unsafe { rkr_frame_masses_data(handle) }.is_null());
+        assert!(unsafe { rkr_frame_atom_energies_data(handle) }.is_null());
+        assert!(unsafe { rkr_frame_positions_data(std::ptr::null()) }.is_null());
+
+        let (mut cell, mut angles) = ([0.0; 3], [0.0; 3]);
+        let st = unsafe { rkr_frame_get_cell(handle, cell.as_mut_ptr(), angles.as_mut_ptr()) };
+        assert_eq!(st, RKRStatus::RKR_STATUS_SUCCESS);
+        assert_eq!((cell, angles), (frame.header.boxl, frame.header.angles));
+    }
+}
 fn frame_positions_arc(frame: &ConFrame) -> ndarray::ArcArray2<f64> {
     let n = frame.atom_data.len();
     let mut data = Vec::with_capacity(n * 3);
@@ -3662,46 +4632,725 @@ pub unsafe extern "C" fn rkr_frame_atom_energies_dlpack_ex(
     export_owned_array1_f64_dlpack_opts(&arr, &o, out_tensor)
 }
 
-// Chemfiles selection (always linked; real impl needs --features chemfiles)
 //=============================================================================
-/// Opaque handle for a cached selection evaluation result.
-pub struct RKRSelectionResult;
-/// Evaluate a chemfiles selection-language string on an `RKRConFrame`.
+// Batched trajectory tensors
+//=============================================================================
+/// Opaque handle to a frame range batched by [`rkr_read_trajectory_tensors`].
+pub struct RKRTrajectoryTensors;
+
+fn trajectory_tensors_ref<'a>(
+    handle: *const RKRTrajectoryTensors,
+) -> Option<&'a crate::trajectory_tensor::TrajectoryTensors> {
+    unsafe { (handle as *const crate::trajectory_tensor::TrajectoryTensors).as_ref() }
+}
+
+/// Convert a C device request (NULL → CPU) into a dlpk device.
+fn dl_device_from(device: *const RKRDLDevice) -> Result<dlpk::sys::DLDevice, RKRStatus> {
+    let Some(d) = (unsafe { device.as_ref() }) else {
+        return Ok(dlpk::sys::DLDevice::cpu());
+    };
+    if d.device_type == rkr_dl_device_type::RKR_DL_CPU {
+        return Ok(dlpk::sys::DLDevice::cpu());
+    }
+    #[cfg(feature = "cuda")]
+    if d.device_type == rkr_dl_device_type::RKR_DL_CUDA {
+        return Ok(dlpk::sys::DLDevice::cuda(d.device_id));
+    }
+    Err(RKRStatus::RKR_STATUS_FEATURE_DISABLED)
+}
+
+/// Reads frames `start, start + step, …` before `stop` (`RKR_FRAMES_END`:
+/// to the end) into one batch: positions and forces `(F, N, 3)` and total
+/// energies `(F,)` (NaN where a frame has none), each in a single buffer.
 ///
-/// On success writes a heap-allocated result handle to `*out_result` (caller
-/// frees with [`rkr_selection_result_free`]). Returns
-/// `RKR_STATUS_SELECTION_ERROR` for invalid grammar, evaluation failure, or
-/// when this build was compiled without the `chemfiles` feature.
+/// `dtype` (NULL → float64) selects the element type of all three blocks:
+/// `RKR_DL_FLOAT` with 64, 32 or 16 bits. Every selected frame must have the
+/// atom count of the first; forces are batched when the first frame has a
+/// force section, and then every frame must.
+///
+/// Returns `RKR_STATUS_VALIDATION_ERROR` for a bad dtype, zero `step` or a
+/// mismatched frame, `RKR_STATUS_IO_ERROR` if the file cannot be read or
+/// parsed. On success the caller owns `*out` and MUST call
+/// [`free_rkr_trajectory_tensors`].
 ///
 /// # Safety
-/// `frame_handle`, `selection`, and `out_result` must be non-null; `selection`
-/// must point to a valid UTF-8 C string.
+/// `filename_c` must be a valid null-terminated string; `out` non-null;
+/// `dtype` null or valid.
 #[unsafe(no_mangle)]
-pub unsafe extern "C" fn rkr_frame_select(
-    frame_handle: *const RKRConFrame,
-    selection: *const c_char,
-    out_result: *mut *mut RKRSelectionResult,
+pub unsafe extern "C" fn rkr_read_trajectory_tensors(
+    filename_c: *const c_char,
+    start: usize,
+    stop: usize,
+    step: usize,
+    dtype: *const RKRDLDataType,
+    out: *mut *mut RKRTrajectoryTensors,
 ) -> RKRStatus {
-    if frame_handle.is_null() || selection.is_null() || out_result.is_null() {
+    if filename_c.is_null() || out.is_null() {
         return RKRStatus::RKR_STATUS_NULL_POINTER;
     }
-    let frame = unsafe { &*(frame_handle as *const ConFrame) };
-    let sel_str = match unsafe { CStr::from_ptr(selection) }.to_str() {
+    unsafe { *out = ptr::null_mut() };
+    let filename = match unsafe { CStr::from_ptr(filename_c).to_str() } {
         Ok(s) => s,
         Err(_) => return RKRStatus::RKR_STATUS_INVALID_UTF8,
     };
-    match crate::chemfiles_selection::evaluate_selection_on_con_frame(sel_str, frame) {
-        Ok(result) => {
-            let boxed = Box::new(result);
-            unsafe {
-                *out_result = Box::into_raw(boxed) as *mut RKRSelectionResult;
-            }
+    let kind = match unsafe { dtype.as_ref() } {
+        None => crate::storage_dtype::ElementKind::Float64,
+        Some(d) if d.code != rkr_dl_type_code::RKR_DL_FLOAT || d.lanes != 1 => {
+            return RKRStatus::RKR_STATUS_VALIDATION_ERROR;
+        }
+        Some(d) => match d.bits {
+            64 => crate::storage_dtype::ElementKind::Float64,
+            32 => crate::storage_dtype::ElementKind::Float32,
+            16 => crate::storage_dtype::ElementKind::Float16,
+            _ => return RKRStatus::RKR_STATUS_VALIDATION_ERROR,
+        },
+    };
+    let dtypes = crate::storage_dtype::StorageDtypes {
+        positions: kind,
+        forces: kind,
+        energies: kind,
+        ..Default::default()
+    };
+    let stop = (stop != RKR_FRAMES_END).then_some(stop);
+    match crate::trajectory_tensor::read_trajectory_tensors(
+        Path::new(filename),
+        start,
+        stop,
+        step,
+        &dtypes,
+    ) {
+        Ok(batch) => {
+            unsafe { *out = Box::into_raw(Box::new(batch)) as *mut RKRTrajectoryTensors };
             RKRStatus::RKR_STATUS_SUCCESS
         }
-        Err(_) => RKRStatus::RKR_STATUS_SELECTION_ERROR,
+        Err(e) => match e.downcast_ref::<crate::error::ParseError>() {
+            Some(crate::error::ParseError::ValidationError(_)) => {
+                RKRStatus::RKR_STATUS_VALIDATION_ERROR
+            }
+            _ => RKRStatus::RKR_STATUS_IO_ERROR,
+        },
     }
 }
-/// Number of matches in a selection result.
+
+/// Frees a batch from [`rkr_read_trajectory_tensors`]. Tensors exported from
+/// it stay valid (they share the buffers). Safe with NULL.
+///
+/// # Safety
+/// `handle` must be NULL or a handle not yet freed.
+#[unsafe(no_mangle)]
+pub unsafe extern "C" fn free_rkr_trajectory_tensors(handle: *mut RKRTrajectoryTensors) {
+    if !handle.is_null() {
+        let _ = unsafe {
+            Box::from_raw(handle as *mut crate::trajectory_tensor::TrajectoryTensors)
+        };
+    }
+}
+
+/// Number of frames `F` in the batch (0 on NULL).
+///
+/// # Safety
+/// `handle` must be valid or NULL.
+#[unsafe(no_mangle)]
+pub unsafe extern "C" fn rkr_trajectory_tensors_frame_count(
+    handle: *const RKRTrajectoryTensors,
+) -> usize {
+    trajectory_tensors_ref(handle).map_or(0, |t| t.n_frames())
+}
+
+/// Atoms per frame `N` (0 on NULL).
+///
+/// # Safety
+/// `handle` must be valid or NULL.
+#[unsafe(no_mangle)]
+pub unsafe extern "C" fn rkr_trajectory_tensors_atom_count(
+    handle: *const RKRTrajectoryTensors,
+) -> usize {
+    trajectory_tensors_ref(handle).map_or(0, |t| t.n_atoms())
+}
+
+/// Whether the batch carries a forces block.
+///
+/// # Safety
+/// `handle` must be valid or NULL.
+#[unsafe(no_mangle)]
+pub unsafe extern "C" fn rkr_trajectory_tensors_has_forces(
+    handle: *const RKRTrajectoryTensors,
+) -> bool {
+    trajectory_tensors_ref(handle).is_some_and(|t| t.has_forces())
+}
+
+/// Block `0` positions, `1` forces, `2` energies of a batch.
+fn trajectory_block<'a>(
+    handle: *const RKRTrajectoryTensors,
+    block: u8,
+) -> Result<TrajectoryBlock<'a>, RKRStatus> {
+    let t = trajectory_tensors_ref(handle).ok_or(RKRStatus::RKR_STATUS_NULL_POINTER)?;
+    match block {
+        0 => Ok(TrajectoryBlock::Xyz(&t.positions)),
+        1 => t
+            .forces
+            .as_ref()
+            .map(TrajectoryBlock::Xyz)
+            .ok_or(RKRStatus::RKR_STATUS_SECTION_ABSENT),
+        _ => Ok(TrajectoryBlock::Scalar(&t.energies)),
+    }
+}
+
+enum TrajectoryBlock<'a> {
+    Xyz(&'a crate::storage_dtype::Array3Storage),
+    Scalar(&'a crate::storage_dtype::Array1Storage),
+}
+
+unsafe fn trajectory_dlpack(
+    handle: *const RKRTrajectoryTensors,
+    block: u8,
+    device: *const RKRDLDevice,
+    out_tensor: *mut *mut RKRDLManagedTensorVersioned,
+) -> RKRStatus {
+    if handle.is_null() || out_tensor.is_null() {
+        return RKRStatus::RKR_STATUS_NULL_POINTER;
+    }
+    unsafe { *out_tensor = ptr::null_mut() };
+    let device = match dl_device_from(device) {
+        Ok(d) => d,
+        Err(st) => return st,
+    };
+    let tensor = match trajectory_block(handle, block) {
+        Ok(TrajectoryBlock::Xyz(a)) => a.as_dlpack(device),
+        Ok(TrajectoryBlock::Scalar(a)) => a.as_dlpack(device),
+        Err(st) => return st,
+    };
+    match tensor {
+        Ok(tensor) => {
+            unsafe { *out_tensor = tensor.into_raw().as_ptr() };
+            RKRStatus::RKR_STATUS_SUCCESS
+        }
+        Err(e) => map_dlpack_err(e),
+    }
+}
+
+unsafe fn trajectory_copy(
+    handle: *const RKRTrajectoryTensors,
+    block: u8,
+    out: *mut f64,
+    out_len: usize,
+) -> RKRStatus {
+    if handle.is_null() || out.is_null() {
+        return RKRStatus::RKR_STATUS_NULL_POINTER;
+    }
+    let values = match trajectory_block(handle, block) {
+        Ok(TrajectoryBlock::Xyz(a)) => match a.as_f64_slice() {
+            Some(s) => std::borrow::Cow::Borrowed(s),
+            None => std::borrow::Cow::Owned(a.to_f64_vec()),
+        },
+        Ok(TrajectoryBlock::Scalar(a)) => match a.as_f64_slice() {
+            Some(s) => std::borrow::Cow::Borrowed(s),
+            None => std::borrow::Cow::Owned((0..a.len()).map(|i| a.get_f64(i)).collect()),
+        },
+        Err(st) => return st,
+    };
+    if out_len < values.len() {
+        return RKRStatus::RKR_STATUS_BUFFER_TOO_SMALL;
+    }
+    unsafe { ptr::copy_nonoverlapping(values.as_ptr(), out, values.len()) };
+    RKRStatus::RKR_STATUS_SUCCESS
+}
+
+/// Export the whole `(F, N, 3)` positions block as one DLPack tensor in the
+/// batch dtype. `device` NULL → CPU, which shares the buffer (no copy);
+/// `RKR_DL_CUDA` (with `--features cuda`) copies it to the device in the same dtype.
+/// Free with [`rkr_dlpack_delete`].
+///
+/// # Safety
+/// `handle` / `out_tensor` valid; `device` null or valid.
+#[unsafe(no_mangle)]
+pub unsafe extern "C" fn rkr_trajectory_positions_dlpack(
+    handle: *const RKRTrajectoryTensors,
+    device: *const RKRDLDevice,
+    out_tensor: *mut *mut RKRDLManagedTensorVersioned,
+) -> RKRStatus {
+    unsafe { trajectory_dlpack(handle, 0, device, out_tensor) }
+}
+
+/// Forces `(F, N, 3)` as one DLPack tensor, or `SECTION_ABSENT`; see
+/// [`rkr_trajectory_positions_dlpack`].
+///
+/// # Safety
+/// `handle` / `out_tensor` valid; `device` null or valid.
+#[unsafe(no_mangle)]
+pub unsafe extern "C" fn rkr_trajectory_forces_dlpack(
+    handle: *const RKRTrajectoryTensors,
+    device: *const RKRDLDevice,
+    out_tensor: *mut *mut RKRDLManagedTensorVersioned,
+) -> RKRStatus {
+    unsafe { trajectory_dlpack(handle, 1, device, out_tensor) }
+}
+
+/// Total energies `(F,)` as one DLPack tensor; see
+/// [`rkr_trajectory_positions_dlpack`].
+///
+/// # Safety
+/// `handle` / `out_tensor` valid; `device` null or valid.
+#[unsafe(no_mangle)]
+pub unsafe extern "C" fn rkr_trajectory_energies_dlpack(
+    handle: *const RKRTrajectoryTensors,
+    device: *const RKRDLDevice,
+    out_tensor: *mut *mut RKRDLManagedTensorVersioned,
+) -> RKRStatus {
+    unsafe { trajectory_dlpack(handle, 2, device, out_tensor) }
+}
+
+/// Copy positions as row-major `(F, N, 3)` doubles into `out`
+/// (`out_len >= 3 * F * N`), widening f32 / f16 batches.
+///
+/// # Safety
+/// `handle` valid; `out` must hold `out_len` doubles.
+#[unsafe(no_mangle)]
+pub unsafe extern "C" fn rkr_trajectory_copy_positions(
+    handle: *const RKRTrajectoryTensors,
+    out: *mut f64,
+    out_len: usize,
+) -> RKRStatus {
+    unsafe { trajectory_copy(handle, 0, out, out_len) }
+}
+
+/// Copy forces like [`rkr_trajectory_copy_positions`], or `SECTION_ABSENT`.
+///
+/// # Safety
+/// `handle` valid; `out` must hold `out_len` doubles.
+#[unsafe(no_mangle)]
+pub unsafe extern "C" fn rkr_trajectory_copy_forces(
+    handle: *const RKRTrajectoryTensors,
+    out: *mut f64,
+    out_len: usize,
+) -> RKRStatus {
+    unsafe { trajectory_copy(handle, 1, out, out_len) }
+}
+
+/// Copy the `(F,)` total energies into `out` (`out_len >= F`).
+///
+/// # Safety
+/// `handle` valid; `out` must hold `out_len` doubles.
+#[unsafe(no_mangle)]
+pub unsafe extern "C" fn rkr_trajectory_copy_energies(
+    handle: *const RKRTrajectoryTensors,
+    out: *mut f64,
+    out_len: usize,
+) -> RKRStatus {
+    unsafe { trajectory_copy(handle, 2, out, out_len) }
+}
+
+/// Borrow a batch block without copying: NULL for a null handle, an absent
+/// block, an empty batch, or non-f64 storage (use `rkr_trajectory_copy_*`).
+unsafe fn trajectory_block_ptr(handle: *const RKRTrajectoryTensors, block: u8) -> *const f64 {
+    let values = match trajectory_block(handle, block) {
+        Ok(TrajectoryBlock::Xyz(a)) => a.as_f64_slice(),
+        Ok(TrajectoryBlock::Scalar(a)) => a.as_f64_slice(),
+        Err(_) => None,
+    };
+    match values {
+        Some(s) if !s.is_empty() => s.as_ptr(),
+        _ => ptr::null(),
+    }
+}
+
+/// Borrow positions as a row-major `(F, N, 3)` f64 buffer, valid while the
+/// batch handle is alive. NULL for a null handle, an empty batch, or an
+/// f32 / f16 batch.
+///
+/// # Safety
+/// `handle` must be valid or null; the pointer dies with the batch.
+#[unsafe(no_mangle)]
+pub unsafe extern "C" fn rkr_trajectory_positions_data(
+    handle: *const RKRTrajectoryTensors,
+) -> *const f64 {
+    unsafe { trajectory_block_ptr(handle, 0) }
+}
+
+/// Borrow forces `(F, N, 3)`; NULL also when the batch has no forces.
+///
+/// # Safety
+/// Same contract as rkr_trajectory_positions_data.
+#[unsafe(no_mangle)]
+pub unsafe extern "C" fn rkr_trajectory_forces_data(
+    handle: *const RKRTrajectoryTensors,
+) -> *const f64 {
+    unsafe { trajectory_block_ptr(handle, 1) }
+}
+
+/// Borrow the `(F,)` total energies.
+///
+/// # Safety
+/// Same contract as rkr_trajectory_positions_data.
+#[unsafe(no_mangle)]
+pub unsafe extern "C" fn rkr_trajectory_energies_data(
+    handle: *const RKRTrajectoryTensors,
+) -> *const f64 {
+    unsafe { trajectory_block_ptr(handle, 2) }
+}
+
+//=============================================================================
+// Following a file that is still being written
+//=============================================================================
+/// Opaque handle to a [`crate::follow::ConFrameFollower`].
+pub struct RKRFollower;
+
+fn follower_mut<'a>(handle: *mut RKRFollower) -> Option<&'a mut crate::follow::ConFrameFollower> {
+    unsafe { (handle as *mut crate::follow::ConFrameFollower).as_mut() }
+}
+
+/// Opens `filename_c`, a plain `.con` / `.convel` file another process may
+/// still be appending to, for following from byte `offset` (0: the start,
+/// otherwise a value from [`rkr_follower_byte_offset`]). `frames_before` is
+/// the index reported for the first frame read.
+///
+/// Returns `RKR_STATUS_IO_ERROR` if the file cannot be opened, is compressed,
+/// or is shorter than `offset`. On success the caller owns `*out` and MUST
+/// call [`free_rkr_follower`].
+///
+/// # Safety
+/// `filename_c` must be a valid null-terminated string; `out` non-null.
+#[unsafe(no_mangle)]
+pub unsafe extern "C" fn rkr_follower_open(
+    filename_c: *const c_char,
+    offset: u64,
+    frames_before: usize,
+    out: *mut *mut RKRFollower,
+) -> RKRStatus {
+    if filename_c.is_null() || out.is_null() {
+        return RKRStatus::RKR_STATUS_NULL_POINTER;
+    }
+    unsafe { *out = ptr::null_mut() };
+    let filename = match unsafe { CStr::from_ptr(filename_c).to_str() } {
+        Ok(s) => s,
+        Err(_) => return RKRStatus::RKR_STATUS_INVALID_UTF8,
+    };
+    match crate::follow::ConFrameFollower::resume(Path::new(filename), offset, frames_before) {
+        Ok(follower) => {
+            unsafe { *out = Box::into_raw(Box::new(follower)) as *mut RKRFollower };
+            RKRStatus::RKR_STATUS_SUCCESS
+        }
+        Err(_) => RKRStatus::RKR_STATUS_IO_ERROR,
+    }
+}
+
+/// Returns the next complete frame in `*out_frame`, waiting up to
+/// `timeout_ms` milliseconds for the writer to finish it (0: check once).
+///
+/// `RKR_STATUS_SUCCESS` with `*out_frame == NULL` means "no complete frame
+/// yet": the file ends inside a frame, or exactly at the end of one whose
+/// sections are not declared. Call again later. Otherwise the caller owns
+/// `*out_frame` and must free it with [`free_rkr_frame`].
+///
+/// Returns `RKR_STATUS_IO_ERROR` if the file shrank or is not valid UTF-8,
+/// and `RKR_STATUS_VALIDATION_ERROR` for a malformed frame (which is
+/// consumed, so the next call moves on).
+///
+/// # Safety
+/// `follower` must be valid; `out_frame` non-null.
+#[unsafe(no_mangle)]
+pub unsafe extern "C" fn rkr_follower_next(
+    follower: *mut RKRFollower,
+    timeout_ms: u64,
+    out_frame: *mut *mut RKRConFrame,
+) -> RKRStatus {
+    if out_frame.is_null() {
+        return RKRStatus::RKR_STATUS_NULL_POINTER;
+    }
+    unsafe { *out_frame = ptr::null_mut() };
+    let Some(f) = follower_mut(follower) else {
+        return RKRStatus::RKR_STATUS_NULL_POINTER;
+    };
+    let next = if timeout_ms == 0 {
+        f.try_next()
+    } else {
+        f.wait_next(std::time::Duration::from_millis(timeout_ms))
+    };
+    match next {
+        Ok(Some(frame)) => {
+            unsafe { *out_frame = Box::into_raw(Box::new(frame)) as *mut RKRConFrame };
+            RKRStatus::RKR_STATUS_SUCCESS
+        }
+        Ok(None) => RKRStatus::RKR_STATUS_SUCCESS,
+        Err(crate::error::ParseError::Io(_)) => RKRStatus::RKR_STATUS_IO_ERROR,
+        Err(_) => RKRStatus::RKR_STATUS_VALIDATION_ERROR,
+    }
+}
+
+/// File offset just past the last frame returned (0 on NULL). Pass it to
+/// [`rkr_follower_open`] to resume later.
+///
+/// # Safety
+/// `follower` must be valid or NULL.
+#[unsafe(no_mangle)]
+pub unsafe extern "C" fn rkr_follower_byte_offset(follower: *mut RKRFollower) -> u64 {
+    follower_mut(follower).map_or(0, |f| f.byte_offset())
+}
+
+/// Index of the frame the next successful [`rkr_follower_next`] returns
+/// (0 on NULL).
+///
+/// # Safety
+/// `follower` must be valid or NULL.
+#[unsafe(no_mangle)]
+pub unsafe extern "C" fn rkr_follower_position(follower: *mut RKRFollower) -> usize {
+    follower_mut(follower).map_or(0, |f| f.next_frame_index())
+}
+
+/// Decodes only `columns` in later reads, as [`con_frame_iterator_set_columns`].
+///
+/// # Safety
+/// `follower` must be valid or NULL.
+#[unsafe(no_mangle)]
+pub unsafe extern "C" fn rkr_follower_set_columns(
+    follower: *mut RKRFollower,
+    columns: u32,
+) -> RKRStatus {
+    let Some(f) = follower_mut(follower) else {
+        return RKRStatus::RKR_STATUS_NULL_POINTER;
+    };
+    f.set_projection(crate::types::ColumnMask(columns & RKR_COLUMNS_ALL));
+    RKRStatus::RKR_STATUS_SUCCESS
+}
+
+/// Frees a follower from [`rkr_follower_open`]. Safe with NULL.
+///
+/// # Safety
+/// `follower` must be NULL or a handle not yet freed.
+#[unsafe(no_mangle)]
+pub unsafe extern "C" fn free_rkr_follower(follower: *mut RKRFollower) {
+    if !follower.is_null() {
+        let _ = unsafe { Box::from_raw(follower as *mut crate::follow::ConFrameFollower) };
+    }
+}
+
+//=============================================================================
+// Background prefetch
+//=============================================================================
+/// Opaque handle to a [`crate::prefetch::FramePrefetcher`].
+pub struct RKRFramePrefetcher;
+
+fn prefetcher_mut<'a>(
+    handle: *mut RKRFramePrefetcher,
+) -> Option<&'a mut crate::prefetch::FramePrefetcher> {
+    unsafe { (handle as *mut crate::prefetch::FramePrefetcher).as_mut() }
+}
+
+/// Shared open path of [`rkr_prefetcher_open`] / [`rkr_prefetch_for_each`].
+unsafe fn spawn_prefetcher(
+    filename_c: *const c_char,
+    start: usize,
+    stop: usize,
+    step: usize,
+    depth: usize,
+    columns: u32,
+) -> Result<crate::prefetch::FramePrefetcher, RKRStatus> {
+    if filename_c.is_null() {
+        return Err(RKRStatus::RKR_STATUS_NULL_POINTER);
+    }
+    let filename = unsafe { CStr::from_ptr(filename_c).to_str() }
+        .map_err(|_| RKRStatus::RKR_STATUS_INVALID_UTF8)?;
+    if step == 0 {
+        return Err(RKRStatus::RKR_STATUS_VALIDATION_ERROR);
+    }
+    let source = crate::prefetch::IndexedTrajectory::open(Path::new(filename))
+        .map_err(|_| RKRStatus::RKR_STATUS_IO_ERROR)?;
+    let end = stop.min(source.len());
+    let depth = if depth == 0 {
+        crate::prefetch::DEFAULT_PREFETCH_DEPTH
+    } else {
+        depth
+    };
+    Ok(crate::prefetch::FramePrefetcher::spawn(
+        std::sync::Arc::new(source),
+        (start.min(end)..end).step_by(step),
+        depth,
+        crate::types::ColumnMask(columns & RKR_COLUMNS_ALL),
+    ))
+}
+
+/// Opens `filename_c` and starts parsing frames `start, start + step, …`
+/// before `stop` (`RKR_FRAMES_END`: to the end) on a background thread, at
+/// most `depth` frames ahead (0: 16), decoding only `columns`
+/// (`RKR_COLUMN_*`). Frame boundaries come from a fresh `.con.idx` sidecar
+/// or one skip scan; gzip / zstd inputs are inflated in memory first.
+///
+/// Returns `RKR_STATUS_VALIDATION_ERROR` for a zero `step` and
+/// `RKR_STATUS_IO_ERROR` if the file cannot be read. On success the caller
+/// owns `*out` and MUST call [`free_rkr_prefetcher`].
+///
+/// # Safety
+/// `filename_c` must be a valid null-terminated string; `out` non-null.
+#[unsafe(no_mangle)]
+pub unsafe extern "C" fn rkr_prefetcher_open(
+    filename_c: *const c_char,
+    start: usize,
+    stop: usize,
+    step: usize,
+    depth: usize,
+    columns: u32,
+    out: *mut *mut RKRFramePrefetcher,
+) -> RKRStatus {
+    if out.is_null() {
+        return RKRStatus::RKR_STATUS_NULL_POINTER;
+    }
+    unsafe { *out = ptr::null_mut() };
+    match unsafe { spawn_prefetcher(filename_c, start, stop, step, depth, columns) } {
+        Ok(frames) => {
+            unsafe { *out = Box::into_raw(Box::new(frames)) as *mut RKRFramePrefetcher };
+            RKRStatus::RKR_STATUS_SUCCESS
+        }
+        Err(status) => status,
+    }
+}
+
+/// Waits for the next prefetched frame and stores it in `*frame`, with its
+/// index in the file in `*out_index`. A handle already in `*frame` is
+/// handed back to the worker, which parses a later frame into its buffers,
+/// and then holds the new frame; if `*frame` is NULL a handle is allocated.
+/// Free the handle with [`free_rkr_frame`] once, after the loop.
+///
+/// Once every frame has been delivered, returns `RKR_STATUS_SUCCESS` with
+/// `*out_index == RKR_FRAMES_END` and `*frame` untouched. A malformed
+/// frame returns `RKR_STATUS_IO_ERROR` (with its index; `*frame` untouched)
+/// and the next call moves on.
+///
+/// # Safety
+/// `prefetcher` must be valid; `frame` and `out_index` non-null, `*frame`
+/// NULL or a handle from this library that no other thread is using.
+#[unsafe(no_mangle)]
+pub unsafe extern "C" fn rkr_prefetcher_next(
+    prefetcher: *mut RKRFramePrefetcher,
+    frame: *mut *mut RKRConFrame,
+    out_index: *mut usize,
+) -> RKRStatus {
+    if frame.is_null() || out_index.is_null() {
+        return RKRStatus::RKR_STATUS_NULL_POINTER;
+    }
+    let Some(frames) = prefetcher_mut(prefetcher) else {
+        return RKRStatus::RKR_STATUS_NULL_POINTER;
+    };
+    unsafe { *out_index = RKR_FRAMES_END };
+    let Some((index, next)) = frames.next() else {
+        return RKRStatus::RKR_STATUS_SUCCESS;
+    };
+    unsafe { *out_index = index };
+    let next = match next {
+        Ok(next) => next,
+        Err(_) => return RKRStatus::RKR_STATUS_IO_ERROR,
+    };
+    match unsafe { (*frame as *mut ConFrame).as_mut() } {
+        Some(existing) => frames.recycle(std::mem::replace(existing, next)),
+        None => unsafe { *frame = Box::into_raw(Box::new(next)) as *mut RKRConFrame },
+    }
+    RKRStatus::RKR_STATUS_SUCCESS
+}
+
+/// Frees a prefetcher from [`rkr_prefetcher_open`], stopping its worker.
+/// Frames already returned stay valid. Safe with NULL.
+///
+/// # Safety
+/// `prefetcher` must be NULL or a handle not yet freed.
+#[unsafe(no_mangle)]
+pub unsafe extern "C" fn free_rkr_prefetcher(prefetcher: *mut RKRFramePrefetcher) {
+    if !prefetcher.is_null() {
+        let _ = unsafe { Box::from_raw(prefetcher as *mut crate::prefetch::FramePrefetcher) };
+    }
+}
+
+/// Per-frame callback for [`rkr_prefetch_for_each`]: the frame (borrowed,
+/// valid only during the call), its index in the file and the caller's
+/// `user_data`. Return `false` to stop early.
+pub type RKRFrameCallback = Option<
+    unsafe extern "C" fn(frame: *const RKRConFrame, index: usize, user_data: *mut c_void) -> bool,
+>;
+
+/// Calls `callback` on the frames [`rkr_prefetcher_open`] would select, in
+/// order, on the calling thread, while a background thread parses ahead;
+/// the plain-C counterpart of `readcon::ConFramePrefetcher`. The frame
+/// passed to the callback is recycled afterwards: copy out what should
+/// outlive it.
+///
+/// Returns `RKR_STATUS_SUCCESS` after the last frame or when the callback
+/// returns false, `RKR_STATUS_VALIDATION_ERROR` for a zero `step`, and
+/// `RKR_STATUS_IO_ERROR` if the file cannot be read or a frame is
+/// malformed (frames before it have been delivered).
+///
+/// # Safety
+/// `filename_c` must be a valid null-terminated string; `callback` must
+/// be safe to call with `user_data`.
+#[unsafe(no_mangle)]
+pub unsafe extern "C" fn rkr_prefetch_for_each(
+    filename_c: *const c_char,
+    start: usize,
+    stop: usize,
+    step: usize,
+    depth: usize,
+    columns: u32,
+    callback: RKRFrameCallback,
+    user_data: *mut c_void,
+) -> RKRStatus {
+    let Some(callback) = callback else {
+        return RKRStatus::RKR_STATUS_NULL_POINTER;
+    };
+    let spawned = unsafe { spawn_prefetcher(filename_c, start, stop, step, depth, columns) };
+    let mut frames = match spawned {
+        Ok(frames) => frames,
+        Err(status) => return status,
+    };
+    while let Some((index, frame)) = frames.next() {
+        let Ok(frame) = frame else {
+            return RKRStatus::RKR_STATUS_IO_ERROR;
+        };
+        let handle = &frame as *const ConFrame as *const RKRConFrame;
+        if !unsafe { callback(handle, index, user_data) } {
+            break;
+        }
+        frames.recycle(frame);
+    }
+    RKRStatus::RKR_STATUS_SUCCESS
+}
+
+// Chemfiles selection (always linked; real impl needs --features chemfiles)
+//=============================================================================
+/// Opaque handle for a cached selection evaluation result.
+pub struct RKRSelectionResult;
+/// Evaluate a chemfiles selection-language string on an `RKRConFrame`.
+///
+/// On success writes a heap-allocated result handle to `*out_result` (caller
+/// frees with [`rkr_selection_result_free`]). Returns
+/// `RKR_STATUS_SELECTION_ERROR` for invalid grammar, evaluation failure, or
+/// when this build was compiled without the `chemfiles` feature.
+///
+/// # Safety
+/// `frame_handle`, `selection`, and `out_result` must be non-null; `selection`
+/// must point to a valid UTF-8 C string.
+#[unsafe(no_mangle)]
+pub unsafe extern "C" fn rkr_frame_select(
+    frame_handle: *const RKRConFrame,
+    selection: *const c_char,
+    out_result: *mut *mut RKRSelectionResult,
+) -> RKRStatus {
+    if frame_handle.is_null() || selection.is_null() || out_result.is_null() {
+        return RKRStatus::RKR_STATUS_NULL_POINTER;
+    }
+    let frame = unsafe { &*(frame_handle as *const ConFrame) };
+    let sel_str = match unsafe { CStr::from_ptr(selection) }.to_str() {
+        Ok(s) => s,
+        Err(_) => return RKRStatus::RKR_STATUS_INVALID_UTF8,
+    };
+    match crate::chemfiles_selection::evaluate_selection_on_con_frame(sel_str, frame) {
+        Ok(result) => {
+            let boxed = Box::new(result);
+            unsafe {
+                *out_result = Box::into_raw(boxed) as *mut RKRSelectionResult;
+            }
+            RKRStatus::RKR_STATUS_SUCCESS
+        }
+        Err(_) => RKRStatus::RKR_STATUS_SELECTION_ERROR,
+    }
+}
+/// Number of matches in a selection result.
 ///
 /// # Safety
 /// `result_handle` must be a valid handle from [`rkr_frame_select`] or NULL.
@@ -3765,59 +5414,197 @@ pub unsafe extern "C" fn rkr_selection_result_match_at(
             *out_size = m.size as u32;
         }
     }
-    RKRStatus::RKR_STATUS_SUCCESS
+    RKRStatus::RKR_STATUS_SUCCESS
+}
+/// Fill `out_indices` with primary atom indices for each match (length =
+/// match count). Returns `RKR_STATUS_BUFFER_TOO_SMALL` if `capacity` is too small.
+///
+/// # Safety
+/// `result_handle` and `out_indices` must be valid when capacity > 0.
+#[unsafe(no_mangle)]
+pub unsafe extern "C" fn rkr_selection_result_primary_indices(
+    result_handle: *const RKRSelectionResult,
+    out_indices: *mut u64,
+    capacity: u64,
+    out_written: *mut u64,
+) -> RKRStatus {
+    if result_handle.is_null() {
+        return RKRStatus::RKR_STATUS_NULL_POINTER;
+    }
+    let result =
+        unsafe { &*(result_handle as *const crate::chemfiles_selection::SelectionResult) };
+    let n = result.matches.len() as u64;
+    if !out_written.is_null() {
+        unsafe {
+            *out_written = n;
+        }
+    }
+    if n == 0 {
+        return RKRStatus::RKR_STATUS_SUCCESS;
+    }
+    if out_indices.is_null() {
+        return RKRStatus::RKR_STATUS_NULL_POINTER;
+    }
+    if capacity < n {
+        return RKRStatus::RKR_STATUS_BUFFER_TOO_SMALL;
+    }
+    unsafe {
+        for (i, m) in result.matches.iter().enumerate() {
+            *out_indices.add(i) = m.atoms[0] as u64;
+        }
+    }
+    RKRStatus::RKR_STATUS_SUCCESS
+}
+/// Free a selection result from [`rkr_frame_select`]. Safe with NULL.
+///
+/// # Safety
+/// `result_handle` must be from `rkr_frame_select` or NULL.
+#[unsafe(no_mangle)]
+pub unsafe extern "C" fn rkr_selection_result_free(result_handle: *mut RKRSelectionResult) {
+    if result_handle.is_null() {
+        return;
+    }
+    unsafe {
+        drop(Box::from_raw(
+            result_handle as *mut crate::chemfiles_selection::SelectionResult,
+        ));
+    }
+}
+/// Opaque handle to a [`crate::chemfiles_selection::CompiledSelection`].
+pub struct RKRCompiledSelection;
+/// Parse `selection` once for repeated evaluation.
+///
+/// On success writes a handle to `*out_selection` (caller frees with
+/// [`rkr_compiled_selection_free`]). Returns `RKR_STATUS_SELECTION_ERROR` for
+/// invalid grammar or without the `chemfiles` feature.
+///
+/// # Safety
+/// `selection` must be a valid NUL-terminated UTF-8 string; `out_selection`
+/// must be non-null.
+#[unsafe(no_mangle)]
+pub unsafe extern "C" fn rkr_selection_compile(
+    selection: *const c_char,
+    out_selection: *mut *mut RKRCompiledSelection,
+) -> RKRStatus {
+    if selection.is_null() || out_selection.is_null() {
+        return RKRStatus::RKR_STATUS_NULL_POINTER;
+    }
+    let sel_str = match unsafe { CStr::from_ptr(selection) }.to_str() {
+        Ok(s) => s,
+        Err(_) => return RKRStatus::RKR_STATUS_INVALID_UTF8,
+    };
+    match crate::chemfiles_selection::CompiledSelection::new(sel_str) {
+        Ok(compiled) => {
+            unsafe {
+                *out_selection = Box::into_raw(Box::new(compiled)) as *mut RKRCompiledSelection;
+            }
+            RKRStatus::RKR_STATUS_SUCCESS
+        }
+        Err(_) => RKRStatus::RKR_STATUS_SELECTION_ERROR,
+    }
 }
-/// Fill `out_indices` with primary atom indices for each match (length =
-/// match count). Returns `RKR_STATUS_BUFFER_TOO_SMALL` if `capacity` is too small.
+/// Context size of a compiled selection (1=atom … 4=dihedral; 0 for NULL).
 ///
 /// # Safety
-/// `result_handle` and `out_indices` must be valid when capacity > 0.
+/// `compiled` must be valid or NULL.
 #[unsafe(no_mangle)]
-pub unsafe extern "C" fn rkr_selection_result_primary_indices(
-    result_handle: *const RKRSelectionResult,
-    out_indices: *mut u64,
-    capacity: u64,
-    out_written: *mut u64,
+pub unsafe extern "C" fn rkr_compiled_selection_context_size(
+    compiled: *const RKRCompiledSelection,
+) -> u32 {
+    if compiled.is_null() {
+        return 0;
+    }
+    let compiled =
+        unsafe { &*(compiled as *const crate::chemfiles_selection::CompiledSelection) };
+    compiled.context_size() as u32
+}
+/// Evaluate a compiled selection on one frame.
+///
+/// Consecutive calls on frames with the same topology (atom count, symbols,
+/// chemfiles name / type sidecars, bonds) update the handle's chemfiles frame
+/// in place instead of rebuilding it. The result is read and freed like one
+/// from [`rkr_frame_select`].
+///
+/// # Safety
+/// All pointers must be non-null and valid; one thread at a time per handle.
+#[unsafe(no_mangle)]
+pub unsafe extern "C" fn rkr_compiled_selection_evaluate(
+    compiled: *mut RKRCompiledSelection,
+    frame_handle: *const RKRConFrame,
+    out_result: *mut *mut RKRSelectionResult,
 ) -> RKRStatus {
-    if result_handle.is_null() {
+    if compiled.is_null() || frame_handle.is_null() || out_result.is_null() {
         return RKRStatus::RKR_STATUS_NULL_POINTER;
     }
-    let result =
-        unsafe { &*(result_handle as *const crate::chemfiles_selection::SelectionResult) };
-    let n = result.matches.len() as u64;
-    if !out_written.is_null() {
-        unsafe {
-            *out_written = n;
+    let compiled =
+        unsafe { &mut *(compiled as *mut crate::chemfiles_selection::CompiledSelection) };
+    let frame = unsafe { &*(frame_handle as *const ConFrame) };
+    match compiled.evaluate(frame) {
+        Ok(result) => {
+            unsafe {
+                *out_result = Box::into_raw(Box::new(result)) as *mut RKRSelectionResult;
+            }
+            RKRStatus::RKR_STATUS_SUCCESS
         }
+        Err(_) => RKRStatus::RKR_STATUS_SELECTION_ERROR,
     }
-    if n == 0 {
-        return RKRStatus::RKR_STATUS_SUCCESS;
-    }
-    if out_indices.is_null() {
+}
+/// Evaluate a compiled selection on `n_frames` frames (in parallel when the
+/// library is built with `parallel`).
+///
+/// On success `out_results[i]` receives the result for `frames[i]`; free
+/// each with [`rkr_selection_result_free`]. On error nothing is written.
+///
+/// # Safety
+/// `frames` and `out_results` must each hold `n_frames` entries; every frame
+/// handle must be valid and not mutated during the call.
+#[unsafe(no_mangle)]
+pub unsafe extern "C" fn rkr_compiled_selection_evaluate_frames(
+    compiled: *const RKRCompiledSelection,
+    frames: *const *const RKRConFrame,
+    n_frames: usize,
+    out_results: *mut *mut RKRSelectionResult,
+) -> RKRStatus {
+    if compiled.is_null() || (n_frames > 0 && (frames.is_null() || out_results.is_null())) {
         return RKRStatus::RKR_STATUS_NULL_POINTER;
     }
-    if capacity < n {
-        return RKRStatus::RKR_STATUS_BUFFER_TOO_SMALL;
+    let compiled =
+        unsafe { &*(compiled as *const crate::chemfiles_selection::CompiledSelection) };
+    let handles = if n_frames == 0 {
+        &[][..]
+    } else {
+        unsafe { std::slice::from_raw_parts(frames, n_frames) }
+    };
+    if handles.iter().any(|h| h.is_null()) {
+        return RKRStatus::RKR_STATUS_NULL_POINTER;
     }
-    unsafe {
-        for (i, m) in result.matches.iter().enumerate() {
-            *out_indices.add(i) = m.atoms[0] as u64;
+    let frames: Vec<&ConFrame> =
+        handles.iter().map(|&h| unsafe { &*(h as *const ConFrame) }).collect();
+    match compiled.evaluate_frames(&frames) {
+        Ok(multi) => {
+            for (i, slice) in multi.frames.into_iter().enumerate() {
+                unsafe {
+                    *out_results.add(i) =
+                        Box::into_raw(Box::new(slice.result)) as *mut RKRSelectionResult;
+                }
+            }
+            RKRStatus::RKR_STATUS_SUCCESS
         }
+        Err(_) => RKRStatus::RKR_STATUS_SELECTION_ERROR,
     }
-    RKRStatus::RKR_STATUS_SUCCESS
 }
-/// Free a selection result from [`rkr_frame_select`]. Safe with NULL.
+/// Free a compiled selection. Safe with NULL.
 ///
 /// # Safety
-/// `result_handle` must be from `rkr_frame_select` or NULL.
+/// `compiled` must be from [`rkr_selection_compile`] or NULL.
 #[unsafe(no_mangle)]
-pub unsafe extern "C" fn rkr_selection_result_free(result_handle: *mut RKRSelectionResult) {
-    if result_handle.is_null() {
+pub unsafe extern "C" fn rkr_compiled_selection_free(compiled: *mut RKRCompiledSelection) {
+    if compiled.is_null() {
         return;
     }
     unsafe {
         drop(Box::from_raw(
-            result_handle as *mut crate::chemfiles_selection::SelectionResult,
+            compiled as *mut crate::chemfiles_selection::CompiledSelection,
         ));
     }
 }
@@ -3903,11 +5690,225 @@ pub unsafe extern "C" fn rkr_dlpack_delete(tensor: *mut RKRDLManagedTensorVersio
         }
     }
 }
+
+//=============================================================================
+// Hot-path statistics (real counters need --features stats)
+//=============================================================================
+/// Stage indices into the `RKRStats` per-stage arrays (mirror
+/// `crate::stats::Stage`).
+pub const RKR_STAGE_READ: u32 = 0;
+pub const RKR_STAGE_DECOMPRESS: u32 = 1;
+pub const RKR_STAGE_SCAN: u32 = 2;
+pub const RKR_STAGE_HEADER: u32 = 3;
+pub const RKR_STAGE_METADATA: u32 = 4;
+pub const RKR_STAGE_COORDINATES: u32 = 5;
+pub const RKR_STAGE_SECTIONS: u32 = 6;
+pub const RKR_STAGE_ASSEMBLE: u32 = 7;
+pub const RKR_STAGE_WRITE: u32 = 8;
+/// Length of the `RKRStats` per-stage arrays.
+pub const RKR_STAGE_COUNT: usize = 9;
+const _: () = assert!(RKR_STAGE_COUNT == crate::stats::STAGE_COUNT);
+/// Process-wide read / write counters filled by [`rkr_stats_get`]; see
+/// `crate::stats::Stats` for the meaning of each field.
+#[repr(C)]
+#[derive(Debug, Default)]
+pub struct RKRStats {
+    pub stage_nanos: [u64; RKR_STAGE_COUNT],
+    pub stage_calls: [u64; RKR_STAGE_COUNT],
+    pub stage_bytes: [u64; RKR_STAGE_COUNT],
+    pub frames_read: u64,
+    pub frames_written: u64,
+    pub buffers_allocated: u64,
+    pub buffers_reused: u64,
+    pub parallel_batches: u64,
+    pub parallel_wall_nanos: u64,
+    pub parallel_busy_nanos: u64,
+    pub parallel_capacity_nanos: u64,
+}
+impl From<crate::stats::Stats> for RKRStats {
+    fn from(s: crate::stats::Stats) -> Self {
+        let mut out = Self {
+            frames_read: s.frames_read,
+            frames_written: s.frames_written,
+            buffers_allocated: s.buffers_allocated,
+            buffers_reused: s.buffers_reused,
+            parallel_batches: s.parallel_batches,
+            parallel_wall_nanos: s.parallel_wall_nanos,
+            parallel_busy_nanos: s.parallel_busy_nanos,
+            parallel_capacity_nanos: s.parallel_capacity_nanos,
+            ..Self::default()
+        };
+        for (i, stage) in s.stages.iter().enumerate() {
+            out.stage_nanos[i] = stage.nanos;
+            out.stage_calls[i] = stage.calls;
+            out.stage_bytes[i] = stage.bytes;
+        }
+        out
+    }
+}
+/// Copy the current counters into `*out`. Without the `stats` feature
+/// `*out` is zeroed and `RKR_STATUS_FEATURE_DISABLED` is returned.
+///
+/// # Safety
+/// `out` must be NULL or point to writable `RKRStats` storage.
+#[unsafe(no_mangle)]
+pub unsafe extern "C" fn rkr_stats_get(out: *mut RKRStats) -> RKRStatus {
+    if out.is_null() {
+        return RKRStatus::RKR_STATUS_NULL_POINTER;
+    }
+    unsafe { out.write(crate::stats::snapshot().into()) };
+    if crate::stats::ENABLED {
+        RKRStatus::RKR_STATUS_SUCCESS
+    } else {
+        RKRStatus::RKR_STATUS_FEATURE_DISABLED
+    }
+}
+/// Zero the counters. `RKR_STATUS_FEATURE_DISABLED` without `stats`.
+#[unsafe(no_mangle)]
+pub extern "C" fn rkr_stats_reset() -> RKRStatus {
+    crate::stats::reset();
+    if crate::stats::ENABLED {
+        RKRStatus::RKR_STATUS_SUCCESS
+    } else {
+        RKRStatus::RKR_STATUS_FEATURE_DISABLED
+    }
+}
 #[cfg(test)]
 mod tests {
     use super::*;
     use std::ffi::{CStr, CString};
     #[test]
+    fn stats_get_reports_feature_state() {
+        assert_eq!(unsafe { rkr_stats_get(ptr::null_mut()) }, RKRStatus::RKR_STATUS_NULL_POINTER);
+        let expected = if crate::stats::ENABLED {
+            RKRStatus::RKR_STATUS_SUCCESS
+        } else {
+            RKRStatus::RKR_STATUS_FEATURE_DISABLED
+        };
+        let path = CString::new(concat!(
+            env!("CARGO_MANIFEST_DIR"),
+            "/resources/test/tiny_multi_cuh2.con"
+        ))
+        .unwrap();
+        let frame = unsafe { rkr_read_first_frame(path.as_ptr()) };
+        assert!(!frame.is_null());
+        unsafe { free_rkr_frame(frame) };
+        let mut out = RKRStats::default();
+        assert_eq!(unsafe { rkr_stats_get(&mut out) }, expected);
+        if crate::stats::ENABLED {
+            // No reset here: the stats module tests read the same counters.
+            assert!(out.frames_read > 0);
+            assert!(out.stage_calls[RKR_STAGE_HEADER as usize] > 0);
+        } else {
+            assert_eq!(out.frames_read, 0);
+            assert_eq!(rkr_stats_reset(), RKRStatus::RKR_STATUS_FEATURE_DISABLED);
+        }
+    }
+    #[test]
+    fn prefetcher_c_abi_recycles_and_calls_back() {
+        let path = CString::new(concat!(
+            env!("CARGO_MANIFEST_DIR"),
+            "/resources/test/tiny_multi_cuh2.con"
+        ))
+        .unwrap();
+        let mut p: *mut RKRFramePrefetcher = ptr::null_mut();
+        assert_eq!(
+            unsafe { rkr_prefetcher_open(path.as_ptr(), 0, RKR_FRAMES_END, 0, 0, 0, &mut p) },
+            RKRStatus::RKR_STATUS_VALIDATION_ERROR
+        );
+        assert!(p.is_null());
+        let st = unsafe {
+            rkr_prefetcher_open(path.as_ptr(), 1, RKR_FRAMES_END, 1, 1, RKR_COLUMNS_ALL, &mut p)
+        };
+        assert_eq!(st, RKRStatus::RKR_STATUS_SUCCESS);
+        let mut frame: *mut RKRConFrame = ptr::null_mut();
+        let mut index = 0usize;
+        assert_eq!(
+            unsafe { rkr_prefetcher_next(p, &mut frame, &mut index) },
+            RKRStatus::RKR_STATUS_SUCCESS
+        );
+        assert_eq!(index, 1);
+        assert!(!frame.is_null());
+        let held = frame;
+        assert_eq!(unsafe { rkr_frame_atom_count(frame) }, 4);
+        assert_eq!(
+            unsafe { rkr_prefetcher_next(p, &mut frame, &mut index) },
+            RKRStatus::RKR_STATUS_SUCCESS
+        );
+        assert_eq!(index, RKR_FRAMES_END);
+        assert_eq!(frame, held);
+        unsafe {
+            free_rkr_prefetcher(p);
+            free_rkr_frame(frame);
+        }
+
+        unsafe extern "C" fn collect(
+            frame: *const RKRConFrame,
+            index: usize,
+            user_data: *mut c_void,
+        ) -> bool {
+            let seen = unsafe { &mut *(user_data as *mut Vec<(usize, usize)>) };
+            seen.push((index, unsafe { rkr_frame_atom_count(frame) }));
+            true
+        }
+        let mut seen: Vec<(usize, usize)> = Vec::new();
+        let st = unsafe {
+            rkr_prefetch_for_each(
+                path.as_ptr(),
+                0,
+                RKR_FRAMES_END,
+                1,
+                0,
+                RKR_COLUMNS_ALL,
+                Some(collect),
+                &mut seen as *mut _ as *mut c_void,
+            )
+        };
+        assert_eq!(st, RKRStatus::RKR_STATUS_SUCCESS);
+        assert_eq!(seen, vec![(0, 4), (1, 4)]);
+    }
+
+    #[test]
+    fn query_frames_c_abi() {
+        let path = CString::new(concat!(
+            env!("CARGO_MANIFEST_DIR"),
+            "/resources/test/tiny_multi_cuh2.con"
+        ))
+        .unwrap();
+        let mut result: *mut RKRQueryResult = ptr::null_mut();
+        let bad = CString::new("energy <").unwrap();
+        assert_eq!(
+            unsafe { rkr_query_frames(path.as_ptr(), bad.as_ptr(), &mut result) },
+            RKRStatus::RKR_STATUS_VALIDATION_ERROR
+        );
+        assert!(result.is_null());
+
+        let expr = CString::new("natoms > 0 && composition == 'H:2|Cu:2'").unwrap();
+        assert_eq!(
+            unsafe { rkr_query_frames(path.as_ptr(), expr.as_ptr(), &mut result) },
+            RKRStatus::RKR_STATUS_SUCCESS
+        );
+        let n = unsafe { rkr_query_result_len(result) };
+        assert_eq!(n, 2);
+        let (mut frames, mut lens) = (vec![0u64; 2], vec![0u64; 2]);
+        let mut written = 0u64;
+        assert_eq!(
+            unsafe { rkr_query_result_hits(result, frames.as_mut_ptr(), ptr::null_mut(),
+                                           lens.as_mut_ptr(), 1, &mut written) },
+            RKRStatus::RKR_STATUS_BUFFER_TOO_SMALL
+        );
+        assert_eq!(written, 2);
+        assert_eq!(
+            unsafe { rkr_query_result_hits(result, frames.as_mut_ptr(), ptr::null_mut(),
+                                           lens.as_mut_ptr(), n, &mut written) },
+            RKRStatus::RKR_STATUS_SUCCESS
+        );
+        assert_eq!(frames, [0, 1]);
+        assert!(lens.iter().all(|&l| l > 0));
+        unsafe { rkr_query_result_free(result) };
+        unsafe { rkr_query_result_free(ptr::null_mut()) };
+    }
+    #[test]
     fn frame_copy_positions_without_cframe() {
         let handle = test_frame_handle();
         let n = unsafe { rkr_frame_atom_count(handle) };
@@ -4560,6 +6561,81 @@ mod tests {
         assert_eq!(status, RKRStatus::RKR_STATUS_NULL_POINTER);
         assert!(t.is_null());
     }
+    #[test]
+    fn compiled_selection_ffi_status_paths() {
+        let sel = CString::new("name O").unwrap();
+        let mut compiled: *mut RKRCompiledSelection = ptr::null_mut();
+        assert_eq!(
+            unsafe { rkr_selection_compile(ptr::null(), &mut compiled) },
+            RKRStatus::RKR_STATUS_NULL_POINTER
+        );
+        let st = unsafe { rkr_selection_compile(sel.as_ptr(), &mut compiled) };
+        if cfg!(feature = "chemfiles") {
+            assert_eq!(st, RKRStatus::RKR_STATUS_SUCCESS);
+            assert_eq!(unsafe { rkr_compiled_selection_context_size(compiled) }, 1);
+        } else {
+            assert_eq!(st, RKRStatus::RKR_STATUS_SELECTION_ERROR);
+            assert!(compiled.is_null());
+        }
+        let mut out: *mut RKRSelectionResult = ptr::null_mut();
+        assert_eq!(
+            unsafe { rkr_compiled_selection_evaluate(compiled, ptr::null(), &mut out) },
+            RKRStatus::RKR_STATUS_NULL_POINTER
+        );
+        if !compiled.is_null() {
+            assert_eq!(
+                unsafe {
+                    let none = ptr::null_mut();
+                    rkr_compiled_selection_evaluate_frames(compiled, ptr::null(), 0, none)
+                },
+                RKRStatus::RKR_STATUS_SUCCESS
+            );
+        }
+        unsafe { rkr_compiled_selection_free(compiled) };
+    }
+    #[cfg(feature = "chemfiles")]
+    #[test]
+    fn rkr_compiled_selection_follows_moved_atoms() {
+        use crate::types::ConFrameBuilder;
+        let frame_at = |x: f64| {
+            let mut b = ConFrameBuilder::new([10.0; 3], [90.0; 3]);
+            b.add_atom("O", 0.0, 0.0, 0.0, [false; 3], 0, 16.0);
+            b.add_atom("H", x, 0.0, 0.0, [false; 3], 1, 1.0);
+            Box::into_raw(Box::new(b.build())) as *const RKRConFrame
+        };
+        let frames = [frame_at(1.0), frame_at(3.0), frame_at(0.5)];
+        let sel = CString::new("x > 0.8").unwrap();
+        let mut compiled: *mut RKRCompiledSelection = ptr::null_mut();
+        assert_eq!(
+            unsafe { rkr_selection_compile(sel.as_ptr(), &mut compiled) },
+            RKRStatus::RKR_STATUS_SUCCESS
+        );
+        let mut results = [ptr::null_mut::<RKRSelectionResult>(); 3];
+        let st = unsafe {
+            let out = results.as_mut_ptr();
+            rkr_compiled_selection_evaluate_frames(compiled, frames.as_ptr(), 3, out)
+        };
+        assert_eq!(st, RKRStatus::RKR_STATUS_SUCCESS);
+        let counts: Vec<u64> =
+            results.iter().map(|&r| unsafe { rkr_selection_result_match_count(r) }).collect();
+        assert_eq!(counts, vec![1, 1, 0]);
+        for (&frame, &want) in frames.iter().zip(&counts) {
+            let mut out: *mut RKRSelectionResult = ptr::null_mut();
+            let st = unsafe { rkr_compiled_selection_evaluate(compiled, frame, &mut out) };
+            assert_eq!(st, RKRStatus::RKR_STATUS_SUCCESS);
+            assert_eq!(unsafe { rkr_selection_result_match_count(out) }, want);
+            unsafe { rkr_selection_result_free(out) };
+        }
+        unsafe {
+            for r in results {
+                rkr_selection_result_free(r);
+            }
+            for frame in frames {
+                free_rkr_frame(frame as *mut RKRConFrame);
+            }
+            rkr_compiled_selection_free(compiled);
+        }
+    }
     #[cfg(feature = "chemfiles")]
     #[test]
     fn rkr_frame_select_finds_oxygen() {
@@ -4651,6 +6727,36 @@ mod tests {
         let prop_lab = unsafe { metatensor::c_api::mts_block_labels(block, 1) };
         assert!(!samples.is_null() && !prop_lab.is_null());
     }
+    #[test]
+    fn trajectory_metatensor_c_abi() {
+        let path = CString::new(concat!(
+            env!("CARGO_MANIFEST_DIR"),
+            "/resources/test/tiny_multi_cuh2.con"
+        ))
+        .unwrap();
+        let read = |keys: u32, out: &mut *mut _| unsafe {
+            rkr_read_trajectory_metatensor(path.as_ptr(), 0, RKR_FRAMES_END, 1, keys, out)
+        };
+        let mut map = ptr::null_mut();
+        #[cfg(not(feature = "metatensor"))]
+        assert_eq!(
+            read(RKR_MTS_KEYS_QUANTITY, &mut map),
+            RKRStatus::RKR_STATUS_FEATURE_DISABLED
+        );
+        #[cfg(feature = "metatensor")]
+        {
+            assert_eq!(
+                read(RKR_MTS_KEYS_SPECIES_POSITIONS, &mut map),
+                RKRStatus::RKR_STATUS_SUCCESS
+            );
+            assert!(!map.is_null());
+            unsafe { rkr_mts_tensormap_free(map) };
+            for keys in [RKR_MTS_KEYS_SPECIES_FORCES, 7] {
+                assert_eq!(read(keys, &mut map), RKRStatus::RKR_STATUS_VALIDATION_ERROR);
+            }
+        }
+        assert!(map.is_null());
+    }
     #[cfg(feature = "metatensor")]
     #[test]
     fn metatensor_positions_via_c_abi() {
@@ -4803,4 +6909,179 @@ mod tests {
             free_con_frame_iterator(it);
         }
     }
+
+    #[test]
+    fn file_iterator_keeps_large_input_mapped() {
+        let frame = std::fs::read_to_string("resources/test/tiny_cuh2.con").expect("fixture");
+        let reps = (70 * 1024) / frame.len() + 1;
+        let dir = tempfile::tempdir().expect("tempdir");
+        let path = dir.path().join("many.con");
+        std::fs::write(&path, frame.repeat(reps)).unwrap();
+        let c_path = CString::new(path.to_str().unwrap()).unwrap();
+        let it = unsafe { read_con_file_iterator(c_path.as_ptr()) };
+        assert!(!it.is_null());
+        assert!(
+            unsafe { (*(*it).file_contents).is_mapped() },
+            "inputs above the mmap threshold must not be copied to the heap"
+        );
+        let mut n = 0usize;
+        loop {
+            let fr = unsafe { con_frame_iterator_next(it) };
+            if fr.is_null() {
+                break;
+            }
+            n += 1;
+            unsafe { free_rkr_frame(fr) };
+        }
+        unsafe { free_con_frame_iterator(it) };
+        assert_eq!(n, reps);
+    }
+
+#[cfg(test)]
+mod trajectory_tensor_ffi_tests {
+    use super::*;
+    use std::ffi::CString;
+
+    #[test]
+    fn batch_exports_one_tensor_per_block() {
+        let path = CString::new("resources/test/tiny_multi_cuh2.con").unwrap();
+        let frames =
+            crate::iterators::read_all_frames(Path::new("resources/test/tiny_multi_cuh2.con"))
+                .unwrap();
+        let f32_type = RKRDLDataType {
+            code: rkr_dl_type_code::RKR_DL_FLOAT,
+            bits: 32,
+            lanes: 1,
+        };
+        let mut h: *mut RKRTrajectoryTensors = ptr::null_mut();
+        let st = unsafe {
+            rkr_read_trajectory_tensors(path.as_ptr(), 0, RKR_FRAMES_END, 1, &f32_type, &mut h)
+        };
+        assert_eq!(st, RKRStatus::RKR_STATUS_SUCCESS);
+        let (f, n) = unsafe {
+            (rkr_trajectory_tensors_frame_count(h), rkr_trajectory_tensors_atom_count(h))
+        };
+        assert_eq!((f, n), (frames.len(), frames[0].atom_data.len()));
+        assert!(!unsafe { rkr_trajectory_tensors_has_forces(h) });
+
+        let mut t: *mut RKRDLManagedTensorVersioned = ptr::null_mut();
+        assert_eq!(
+            unsafe { rkr_trajectory_positions_dlpack(h, ptr::null(), &mut t) },
+            RKRStatus::RKR_STATUS_SUCCESS
+        );
+        unsafe {
+            let dl = &(*t).dl_tensor;
+            assert_eq!(dl.ndim, 3);
+            assert_eq!(std::slice::from_raw_parts(dl.shape, 3), &[f as i64, n as i64, 3]);
+            assert_eq!(dl.dtype.bits, 32);
+        }
+        assert_eq!(
+            unsafe { rkr_trajectory_forces_dlpack(h, ptr::null(), &mut t) },
+            RKRStatus::RKR_STATUS_SECTION_ABSENT
+        );
+        assert!(t.is_null());
+
+        let mut buf = vec![0.0f64; 3 * f * n];
+        assert_eq!(
+            unsafe { rkr_trajectory_copy_positions(h, buf.as_mut_ptr(), buf.len() - 1) },
+            RKRStatus::RKR_STATUS_BUFFER_TOO_SMALL
+        );
+        assert_eq!(
+            unsafe { rkr_trajectory_copy_positions(h, buf.as_mut_ptr(), buf.len()) },
+            RKRStatus::RKR_STATUS_SUCCESS
+        );
+        let last = &frames[f - 1].atom_data[n - 1];
+        assert_eq!(buf[buf.len() - 1], last.z as f32 as f64);
+        // The tensor shares the batch buffer and outlives the handle.
+        let mut e: *mut RKRDLManagedTensorVersioned = ptr::null_mut();
+        assert_eq!(
+            unsafe { rkr_trajectory_energies_dlpack(h, ptr::null(), &mut e) },
+            RKRStatus::RKR_STATUS_SUCCESS
+        );
+        unsafe {
+            free_rkr_trajectory_tensors(h);
+            rkr_dlpack_delete(e);
+        }
+
+        let bad = RKRDLDataType {
+            code: rkr_dl_type_code::RKR_DL_INT,
+            bits: 32,
+            lanes: 1,
+        };
+        let st = unsafe { rkr_read_trajectory_tensors(path.as_ptr(), 0, 2, 1, &bad, &mut h) };
+        assert_eq!(st, RKRStatus::RKR_STATUS_VALIDATION_ERROR);
+        assert!(h.is_null());
+        let missing = CString::new("resources/test/does_not_exist.con").unwrap();
+        let st = unsafe {
+            rkr_read_trajectory_tensors(missing.as_ptr(), 0, RKR_FRAMES_END, 1, ptr::null(), &mut h)
+        };
+        assert_eq!(st, RKRStatus::RKR_STATUS_IO_ERROR);
+    }
+
+    #[test]
+    fn data_pointers_borrow_f64_batches_only() {
+        let path = CString::new("resources/test/tiny_multi_cuh2.con").unwrap();
+        let mut h: *mut RKRTrajectoryTensors = ptr::null_mut();
+        let st = unsafe {
+            rkr_read_trajectory_tensors(path.as_ptr(), 0, RKR_FRAMES_END, 1, ptr::null(), &mut h)
+        };
+        assert_eq!(st, RKRStatus::RKR_STATUS_SUCCESS);
+        let (f, n) = unsafe {
+            (rkr_trajectory_tensors_frame_count(h), rkr_trajectory_tensors_atom_count(h))
+        };
+        let mut buf = vec![0.0f64; 3 * f * n];
+        assert_eq!(
+            unsafe { rkr_trajectory_copy_positions(h, buf.as_mut_ptr(), buf.len()) },
+            RKRStatus::RKR_STATUS_SUCCESS
+        );
+        let p = unsafe { rkr_trajectory_positions_data(h) };
+        assert!(!p.is_null());
+        assert_eq!(unsafe { std::slice::from_raw_parts(p, buf.len()) }, &buf[..]);
+        assert!(unsafe { rkr_trajectory_forces_data(h) }.is_null());
+        assert!(!unsafe { rkr_trajectory_energies_data(h) }.is_null());
+        unsafe { free_rkr_trajectory_tensors(h) };
+
+        let f32_type = RKRDLDataType {
+            code: rkr_dl_type_code::RKR_DL_FLOAT,
+            bits: 32,
+            lanes: 1,
+        };
+        let st = unsafe {
+            rkr_read_trajectory_tensors(path.as_ptr(), 0, RKR_FRAMES_END, 1, &f32_type, &mut h)
+        };
+        assert_eq!(st, RKRStatus::RKR_STATUS_SUCCESS);
+        assert!(unsafe { rkr_trajectory_positions_data(h) }.is_null());
+        unsafe { free_rkr_trajectory_tensors(h) };
+        assert!(unsafe { rkr_trajectory_positions_data(ptr::null()) }.is_null());
+    }
+}
+
+    #[test]
+    fn follower_waits_for_appended_frames() {
+        let frame = std::fs::read_to_string("resources/test/tiny_cuh2.con").expect("fixture");
+        let dir = tempfile::tempdir().expect("tempdir");
+        let path = dir.path().join("live.con");
+        std::fs::write(&path, &frame[..frame.len() / 2]).unwrap();
+        let c_path = CString::new(path.to_str().unwrap()).unwrap();
+        let mut f: *mut RKRFollower = ptr::null_mut();
+        assert_eq!(
+            unsafe { rkr_follower_open(c_path.as_ptr(), 0, 0, &mut f) },
+            RKRStatus::RKR_STATUS_SUCCESS
+        );
+        let mut fr: *mut RKRConFrame = ptr::null_mut();
+        assert_eq!(unsafe { rkr_follower_next(f, 0, &mut fr) }, RKRStatus::RKR_STATUS_SUCCESS);
+        assert!(fr.is_null(), "a partial frame means wait");
+        std::fs::write(&path, frame.repeat(2)).unwrap();
+        assert_eq!(unsafe { rkr_follower_next(f, 10, &mut fr) }, RKRStatus::RKR_STATUS_SUCCESS);
+        assert!(!fr.is_null());
+        assert_eq!(unsafe { rkr_follower_byte_offset(f) }, frame.len() as u64);
+        assert_eq!(unsafe { rkr_follower_position(f) }, 1);
+        unsafe {
+            free_rkr_frame(fr);
+            free_rkr_follower(f);
+        }
+        let st = unsafe { rkr_follower_open(c_path.as_ptr(), 1 << 40, 0, &mut f) };
+        assert_eq!(st, RKRStatus::RKR_STATUS_IO_ERROR);
+        assert!(f.is_null());
+    }
 }
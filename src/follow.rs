@@ -0,0 +1,381 @@
+//! **Tail / follow**: iterate a trajectory that is still being written.
+//!
+//! [`ConFrameFollower`](crate::follow::ConFrameFollower) reads only the
+//! bytes appended since its last frame and treats a partial trailing frame
+//! as "wait", not as an error.
+
+use crate::error::ParseError;
+use crate::iterators::ConFrameIterator;
+use crate::types::{ColumnMask, ConFrame};
+use std::fs::File;
+use std::io::{Read, Seek, SeekFrom};
+use std::path::{Path, PathBuf};
+use std::time::{Duration, Instant};
+
+/// Sleep between size checks in [`ConFrameFollower::wait_next`].
+pub const FOLLOW_POLL_INTERVAL: Duration = Duration::from_millis(50);
+
+/// Frame iterator over a plain `.con` / `.convel` file that another process
+/// is still appending to (a running MD or NEB job).
+///
+/// The follower remembers the byte offset just past the last frame it
+/// returned and, on each call, reads only the bytes appended since. A
+/// trailing partial frame is not an error but "wait": [`Self::try_next`]
+/// returns `Ok(None)` until the writer completes it, and the bytes already
+/// read are kept, so nothing is re-read from disk.
+///
+/// A frame whose last line is the last byte of the file is ambiguous unless
+/// its header declares its sections (`con_spec_version` 3 `"sections"`): a
+/// legacy velocity block may still follow a blank line. Such a frame is held
+/// back until the next frame starts or [`Self::finish`] is called.
+///
+/// Growth is detected by polling the file length; no inotify / kqueue watch
+/// is installed. Compressed inputs are rejected, since a gzip or zstd stream
+/// cannot be resumed mid-member. A file that shrinks below the committed
+/// offset (truncated or replaced by the writer) is reported as
+/// [`ParseError::Io`].
+pub struct ConFrameFollower {
+    path: PathBuf,
+    file: File,
+    /// File offset of `buf[0]`.
+    base: u64,
+    buf: Vec<u8>,
+    /// Start of the unconsumed region of `buf` (a frame boundary).
+    start: usize,
+    /// End of the validated, newline-terminated region of `buf`.
+    visible: usize,
+    /// Index of the next frame to be returned.
+    position: usize,
+    /// No bytes arrived since the last "wait" answer, so the buffered tail is
+    /// known to be incomplete and is not rescanned.
+    stalled: bool,
+    columns: ColumnMask,
+}
+
+impl ConFrameFollower {
+    /// Follows `path` from its first frame. No bytes are read until the first
+    /// call to [`Self::try_next`].
+    pub fn open(path: &Path) -> Result<Self, Box<dyn std::error::Error>> {
+        Self::resume(path, 0, 0)
+    }
+
+    /// Follows `path` from `offset`, a value previously returned by
+    /// [`Self::byte_offset`]; `frames_before` is the index the next frame is
+    /// reported under by [`Self::next_frame_index`].
+    pub fn resume(
+        path: &Path,
+        offset: u64,
+        frames_before: usize,
+    ) -> Result<Self, Box<dyn std::error::Error>> {
+        match crate::compression::detect_path_compression(path)? {
+            crate::compression::Compression::None => {}
+            _ => return Err(format!("{}: cannot follow a compressed file", path.display()).into()),
+        }
+        let file = File::open(path)?;
+        let len = file.metadata()?.len();
+        if offset > len {
+            return Err(format!(
+                "{}: resume offset {offset} is past the end of the file ({len} bytes)",
+                path.display()
+            )
+            .into());
+        }
+        Ok(ConFrameFollower {
+            path: path.to_path_buf(),
+            file,
+            base: offset,
+            buf: Vec::new(),
+            start: 0,
+            visible: 0,
+            position: frames_before,
+            stalled: false,
+            columns: ColumnMask::ALL,
+        })
+    }
+
+    /// Decode only `columns`, as [`ConFrameIterator::with_projection`].
+    pub fn with_projection(mut self, columns: ColumnMask) -> Self {
+        self.set_projection(columns);
+        self
+    }
+
+    /// Set the projection on an existing follower (C ABI / FFI).
+    pub fn set_projection(&mut self, columns: ColumnMask) {
+        self.columns = columns;
+    }
+
+    /// The followed path.
+    pub fn path(&self) -> &Path {
+        &self.path
+    }
+
+    /// File offset just past the last frame returned; pass it to
+    /// [`Self::resume`] to continue in another process or session.
+    pub fn byte_offset(&self) -> u64 {
+        self.base + self.start as u64
+    }
+
+    /// Index of the frame the next successful [`Self::try_next`] returns.
+    pub fn next_frame_index(&self) -> usize {
+        self.position
+    }
+
+    /// Bytes read past [`Self::byte_offset`] that do not yet form a
+    /// complete frame.
+    pub fn pending_bytes(&self) -> usize {
+        self.buf.len() - self.start
+    }
+
+    /// Unconsumed complete lines currently buffered.
+    fn text(&self) -> &str {
+        // SAFETY: `start..visible` was validated in `refresh`, and `start`
+        // only advances by frame spans, which end on a line boundary.
+        unsafe { std::str::from_utf8_unchecked(&self.buf[self.start..self.visible]) }
+    }
+
+    /// Reads whatever was appended since the last call and extends the
+    /// visible region to the last complete line. Returns whether any bytes
+    /// arrived.
+    fn refresh(&mut self) -> Result<bool, ParseError> {
+        let read_to = self.base + self.buf.len() as u64;
+        let len = self.file.metadata()?.len();
+        if len < read_to {
+            return Err(ParseError::Io(format!(
+                "{}: file shrank from {read_to} to {len} bytes while being followed",
+                self.path.display()
+            )));
+        }
+        if len == read_to {
+            return Ok(false);
+        }
+        if self.start > 0 {
+            self.buf.drain(..self.start);
+            self.visible -= self.start;
+            self.base += self.start as u64;
+            self.start = 0;
+        }
+        self.file.seek(SeekFrom::Start(read_to))?;
+        let before = self.buf.len();
+        (&mut self.file).take(len - read_to).read_to_end(&mut self.buf)?;
+        if let Some(i) = memchr::memrchr(b'\n', &self.buf[self.visible..]) {
+            let new_visible = self.visible + i + 1;
+            // A cut after '\n' is always a char boundary, so each newly
+            // visible slice validates on its own.
+            if let Err(e) = std::str::from_utf8(&self.buf[self.visible..new_visible]) {
+                return Err(ParseError::Io(format!("input is not valid UTF-8: {e}")));
+            }
+            self.visible = new_visible;
+        }
+        Ok(self.buf.len() > before)
+    }
+
+    /// Parses the next frame of the buffered text if its end is known.
+    /// `at_end` treats the buffer as end of input (see [`Self::finish`]).
+    fn take_frame(&mut self, at_end: bool) -> Option<Result<ConFrame, ParseError>> {
+        let text = self.text();
+        if text.trim().is_empty() {
+            return None;
+        }
+        let mut it = ConFrameIterator::new(text);
+        let end = match it.forward_fast() {
+            Some(Ok(())) => it.byte_offset(),
+            Some(Err(ParseError::IncompleteHeader | ParseError::IncompleteFrame)) if !at_end => {
+                return None;
+            }
+            // Only complete lines are visible, so any other error is real.
+            Some(Err(e)) => return Some(Err(e)),
+            None => return None,
+        };
+        let parsed = ConFrameIterator::new(&text[..end]).with_projection(self.columns).next()?;
+        if end == text.len() && !at_end {
+            match &parsed {
+                Ok(frame) if frame.header.sections_declared => {}
+                _ => return None,
+            }
+        }
+        self.start += end;
+        self.position += 1;
+        Some(parsed)
+    }
+
+    /// Returns the next complete frame, or `Ok(None)` if the file currently
+    /// ends inside (or exactly at the end of an undeclared) frame. Call again
+    /// later; [`Self::wait_next`] does so with a timeout.
+    ///
+    /// A malformed frame whose extent is known is consumed and returned as
+    /// `Err`, as in [`crate::streaming::StreamingConFrameIterator`].
+    pub fn try_next(&mut self) -> Result<Option<ConFrame>, ParseError> {
+        loop {
+            if !self.stalled {
+                match self.take_frame(false) {
+                    Some(r) => return r.map(Some),
+                    None => self.stalled = true,
+                }
+            }
+            if !self.refresh()? {
+                return Ok(None);
+            }
+            self.stalled = false;
+        }
+    }
+
+    /// All frames completed since the last call, in file order.
+    pub fn poll(&mut self) -> Result<Vec<ConFrame>, ParseError> {
+        let mut frames = Vec::new();
+        while let Some(frame) = self.try_next()? {
+            frames.push(frame);
+        }
+        Ok(frames)
+    }
+
+    /// Like [`Self::try_next`], but checks the file every
+    /// [`FOLLOW_POLL_INTERVAL`] until a frame completes or `timeout` elapses
+    /// (`Ok(None)`).
+    pub fn wait_next(&mut self, timeout: Duration) -> Result<Option<ConFrame>, ParseError> {
+        let deadline = Instant::now() + timeout;
+        loop {
+            if let Some(frame) = self.try_next()? {
+                return Ok(Some(frame));
+            }
+            let now = Instant::now();
+            if now >= deadline {
+                return Ok(None);
+            }
+            std::thread::sleep(FOLLOW_POLL_INTERVAL.min(deadline - now));
+        }
+    }
+
+    /// Treats the current end of file as final (the writer has exited) and
+    /// returns the remaining frames, including one held back at the edge.
+    /// A truncated trailing frame is an error.
+    pub fn finish(mut self) -> Result<Vec<ConFrame>, ParseError> {
+        self.refresh()?;
+        if self.buf.last().is_some_and(|&b| b != b'\n') {
+            self.buf.push(b'\n');
+        }
+        if let Err(e) = std::str::from_utf8(&self.buf[self.visible..]) {
+            return Err(ParseError::Io(format!("input is not valid UTF-8: {e}")));
+        }
+        self.visible = self.buf.len();
+        let mut frames = Vec::new();
+        while let Some(frame) = self.take_frame(true) {
+            frames.push(frame?);
+        }
+        Ok(frames)
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use std::io::Write;
+
+    fn fixture(name: &str) -> String {
+        let p = Path::new(env!("CARGO_MANIFEST_DIR")).join("resources/test").join(name);
+        std::fs::read_to_string(p).expect("fixture")
+    }
+
+    fn append(path: &Path, bytes: &str) {
+        let mut f = std::fs::OpenOptions::new().append(true).open(path).unwrap();
+        f.write_all(bytes.as_bytes()).unwrap();
+    }
+
+    /// Byte spans of each frame of `text`.
+    fn spans(text: &str) -> Vec<std::ops::Range<usize>> {
+        let mut it = ConFrameIterator::new(text);
+        let mut out = Vec::new();
+        let mut prev = 0;
+        while let Some(r) = it.forward_fast() {
+            r.unwrap();
+            out.push(prev..it.byte_offset());
+            prev = it.byte_offset();
+        }
+        out
+    }
+
+    #[test]
+    fn follows_frames_as_they_are_appended() {
+        let text = fixture("tiny_multi_cuh2.con");
+        let expected: Vec<ConFrame> = ConFrameIterator::new(&text).map(Result::unwrap).collect();
+        let spans = spans(&text);
+        assert!(spans.len() >= 2);
+        let dir = tempfile::tempdir().unwrap();
+        let path = dir.path().join("live.con");
+        std::fs::write(&path, "").unwrap();
+
+        let mut follower = ConFrameFollower::open(&path).unwrap();
+        assert!(follower.try_next().unwrap().is_none());
+        // First frame, cut mid-way through its atom block.
+        let first = &text[spans[0].clone()];
+        let cut = first.len() * 2 / 3;
+        append(&path, &first[..cut]);
+        assert!(follower.try_next().unwrap().is_none());
+        append(&path, &first[cut..]);
+        // Complete but at the file edge with undeclared sections: held back.
+        assert!(follower.try_next().unwrap().is_none());
+        assert_eq!(follower.byte_offset(), 0);
+        // The first line of the next frame releases it.
+        let second = &text[spans[1].clone()];
+        let line = second.find('\n').unwrap() + 1;
+        append(&path, &second[..line]);
+        let got = follower.try_next().unwrap().expect("first frame");
+        assert_eq!(got.atom_data, expected[0].atom_data);
+        assert_eq!(follower.byte_offset(), spans[0].end as u64);
+        assert_eq!(follower.next_frame_index(), 1);
+
+        append(&path, &text[spans[1].start + line..]);
+        let rest = follower.poll().unwrap();
+        assert_eq!(rest.len(), expected.len() - 2);
+        let tail = follower.finish().unwrap();
+        assert_eq!(tail.len(), 1);
+        assert_eq!(tail[0].atom_data, expected[expected.len() - 1].atom_data);
+    }
+
+    #[test]
+    fn resume_continues_from_saved_offset() {
+        let text = fixture("tiny_multi_cuh2.con");
+        let n = ConFrameIterator::new(&text).count();
+        let dir = tempfile::tempdir().unwrap();
+        let path = dir.path().join("live.con");
+        std::fs::write(&path, &text).unwrap();
+
+        let mut follower = ConFrameFollower::open(&path).unwrap();
+        let first = follower.try_next().unwrap().unwrap();
+        let offset = follower.byte_offset();
+        drop(follower);
+
+        append(&path, &text);
+        let mut resumed = ConFrameFollower::resume(&path, offset, 1).unwrap();
+        let mut frames = resumed.poll().unwrap();
+        assert_eq!(resumed.next_frame_index(), 2 * n - 1);
+        frames.extend(resumed.finish().unwrap());
+        assert_eq!(frames.len(), 2 * n - 1);
+        assert_eq!(frames[n - 1].atom_data, first.atom_data);
+    }
+
+    #[test]
+    fn truncation_and_partial_tail_are_errors() {
+        let text = fixture("tiny_cuh2.con");
+        let dir = tempfile::tempdir().unwrap();
+        let path = dir.path().join("live.con");
+        std::fs::write(&path, &text[..text.len() / 2]).unwrap();
+        let mut follower = ConFrameFollower::open(&path).unwrap();
+        assert!(follower.try_next().unwrap().is_none());
+        std::fs::write(&path, "").unwrap();
+        assert!(matches!(follower.try_next(), Err(ParseError::Io(_))));
+
+        std::fs::write(&path, &text[..text.len() / 2]).unwrap();
+        let follower = ConFrameFollower::open(&path).unwrap();
+        assert!(follower.finish().is_err());
+    }
+
+    #[test]
+    fn compressed_files_are_rejected() {
+        let dir = tempfile::tempdir().unwrap();
+        let path = dir.path().join("live.con.gz");
+        let mut enc = flate2::write::GzEncoder::new(Vec::new(), flate2::Compression::fast());
+        enc.write_all(fixture("tiny_cuh2.con").as_bytes()).unwrap();
+        std::fs::write(&path, enc.finish().unwrap()).unwrap();
+        assert!(ConFrameFollower::open(&path).is_err());
+    }
+}
@@ -16,7 +16,8 @@
 //! so stored blobs are exact substrings; [`frame_byte_spans`] is a structural pre-pass
 //! (offsets only) for planning.
 
-use crate::types::{ConFrame, SECTION_ENERGIES, SECTION_FORCES, SECTION_VELOCITIES};
+use crate::lean::LeanFrame;
+use crate::types::{ConFrame, FrameHeader, SECTION_ENERGIES, SECTION_FORCES, SECTION_VELOCITIES};
 use std::collections::BTreeMap;
 
 /// Bit 0: forces section or per-atom forces present.
@@ -67,13 +68,16 @@ pub fn frame_composition_formula(frame: &ConFrame) -> String {
 
 /// Finite frame energy from header helper or metadata `"energy"`; **None** if missing or non-finite.
 pub fn finite_energy(frame: &ConFrame) -> Option<f64> {
-    frame
-        .header
+    header_finite_energy(&frame.header)
+}
+
+/// [`finite_energy`] from the header alone.
+pub fn header_finite_energy(header: &FrameHeader) -> Option<f64> {
+    header
         .energy()
         .filter(|e| e.is_finite())
         .or_else(|| {
-            frame
-                .header
+            header
                 .metadata
                 .get("energy")
                 .and_then(|v| v.as_f64())
@@ -199,6 +203,56 @@ pub fn sections_present_mask(frame: &ConFrame) -> u8 {
     m
 }
 
+/// [`frame_composition_formula`] for a [`LeanFrame`], from its per-component
+/// symbol table (no per-atom walk).
+pub fn lean_composition_formula(frame: &LeanFrame) -> String {
+    let mut counts = BTreeMap::new();
+    for (symbol, &n) in frame.symbols.iter().zip(&frame.header.natms_per_type) {
+        if !symbol.is_empty() && n > 0 {
+            *counts.entry(symbol.to_string()).or_insert(0u32) += n as u32;
+        }
+    }
+    composition_formula(&counts.into_iter().collect::<Vec<_>>())
+}
+
+/// [`frame_fmax`] over the forces block of a [`LeanFrame`].
+pub fn lean_fmax(frame: &LeanFrame) -> Option<f64> {
+    let mut m = None;
+    for i in 0..frame.forces.nrows() {
+        let f = frame.forces.as_f64_row(i);
+        let mag = (f[0] * f[0] + f[1] * f[1] + f[2] * f[2]).sqrt();
+        if mag.is_finite() {
+            m = Some(m.map_or(mag, |cur: f64| cur.max(mag)));
+        }
+    }
+    m
+}
+
+/// [`sections_present_mask`] for a [`LeanFrame`].
+pub fn lean_sections_mask(frame: &LeanFrame) -> u8 {
+    let declared = |name: &str| {
+        frame
+            .header
+            .sections
+            .iter()
+            .any(|s| s.eq_ignore_ascii_case(name))
+    };
+    let mut m = 0u8;
+    if declared(SECTION_FORCES) || frame.has_forces() {
+        m |= SECTIONS_MASK_FORCES;
+    }
+    if declared(SECTION_VELOCITIES) || frame.has_velocities() {
+        m |= SECTIONS_MASK_VELOCITIES;
+    }
+    if declared(SECTION_ENERGIES)
+        || frame.has_energies()
+        || header_finite_energy(&frame.header).is_some()
+    {
+        m |= SECTIONS_MASK_ENERGIES;
+    }
+    m
+}
+
 fn meta_f64(frame: &ConFrame, key: &str) -> Option<f64> {
     let v = frame.header.metadata.get(key)?;
     if let Some(f) = v.as_f64() {
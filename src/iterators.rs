@@ -2,8 +2,12 @@
 // The Public API - A clean iterator for users of our library
 //=============================================================================
 
-use crate::parser::{parse_declared_sections, parse_single_frame, LineStream};
-use crate::{error, types};
+use crate::lean::LeanFrame;
+use crate::parser::{
+    parse_declared_sections_projected, parse_lean_frame_stream, parse_single_frame_cached,
+    LineStream,
+};
+use crate::{error, stats, types};
 use std::path::Path;
 
 /// memchr-backed line cursor for the full parse path (not only frame skip).
@@ -16,6 +20,9 @@ pub struct MemchrLines<'a> {
     bytes: &'a [u8],
     pos: usize,
     peeked: Option<&'a str>,
+    /// Smallest block [`LineStream::row_block`] hands out; `usize::MAX`
+    /// keeps every block on the line-by-line path.
+    row_block_min: usize,
 }
 
 impl<'a> MemchrLines<'a> {
@@ -24,9 +31,33 @@ impl<'a> MemchrLines<'a> {
             bytes: text.as_bytes(),
             pos: 0,
             peeked: None,
+            row_block_min: usize::MAX,
         }
     }
 
+    /// Consumes the next `rows` lines as one slice (see
+    /// [`LineStream::row_block`]). Returns `None` without moving the cursor
+    /// when `rows` is under the threshold or the buffer ends first, so the
+    /// caller's line-by-line path reports truncation as usual.
+    fn row_block(&mut self, rows: usize) -> Option<&'a str> {
+        if rows < self.row_block_min {
+            return None;
+        }
+        self.clear_peek();
+        let start = self.pos;
+        let mut end = start;
+        for _ in 0..rows {
+            if end >= self.bytes.len() {
+                return None;
+            }
+            end = memchr::memchr(b'\n', &self.bytes[end..])
+                .map_or(self.bytes.len(), |i| end + i + 1);
+        }
+        self.pos = end;
+        // SAFETY: source was `&str`; both ends sit on ASCII `\n` boundaries.
+        Some(unsafe { std::str::from_utf8_unchecked(&self.bytes[start..end]) })
+    }
+
     #[inline]
     fn read_one(&mut self) -> Option<&'a str> {
         if self.pos >= self.bytes.len() {
@@ -89,6 +120,19 @@ impl<'a> LineStream<'a> for MemchrLines<'a> {
     fn peek_line(&mut self) -> Option<&'a str> {
         MemchrLines::peek_line(self)
     }
+    #[inline]
+    fn row_block(&mut self, rows: usize) -> Option<&'a str> {
+        MemchrLines::row_block(self, rows)
+    }
+    fn remainder(&mut self) -> Option<&'a str> {
+        self.clear_peek();
+        // SAFETY: source was `&str`; `pos` sits on a line boundary.
+        Some(unsafe { std::str::from_utf8_unchecked(&self.bytes[self.pos..]) })
+    }
+    fn consume(&mut self, bytes: usize) {
+        debug_assert!(self.peeked.is_none());
+        self.pos += bytes;
+    }
 }
 
 /// An iterator that lazily parses simulation frames from a `.con` or `.convel`
@@ -103,6 +147,15 @@ impl<'a> LineStream<'a> for MemchrLines<'a> {
 /// robust error handling for each frame.
 pub struct ConFrameIterator<'a> {
     pub(crate) lines: MemchrLines<'a>,
+    /// Index of the next frame `next` / `forward_fast` will consume.
+    position: usize,
+    /// Offsets for O(1) [`Self::seek`]; must describe this exact buffer.
+    index: Option<&'a crate::offset_index::FrameOffsetIndex>,
+    /// Columns decoded by `next` (see [`Self::with_projection`]).
+    columns: types::ColumnMask,
+    /// Previous frame's header pieces and component symbols, reused while
+    /// the raw header lines repeat.
+    pub(crate) header_cache: crate::parser::HeaderCache,
 }
 
 impl<'a> ConFrameIterator<'a> {
@@ -114,6 +167,123 @@ impl<'a> ConFrameIterator<'a> {
     pub fn new(file_contents: &'a str) -> Self {
         ConFrameIterator {
             lines: MemchrLines::new(file_contents),
+            position: 0,
+            index: None,
+            columns: types::ColumnMask::ALL,
+            header_cache: crate::parser::HeaderCache::new(),
+        }
+    }
+
+    /// Decode only the per-atom columns in `columns` (see
+    /// [`types::ColumnMask`]); sections left out are skipped by line count
+    /// like [`Self::forward_fast`]. For energy screening over a large
+    /// archive, [`types::ColumnMask::NONE`] parses headers only;
+    /// `POSITIONS | FORCES` is enough for `fmax`.
+    pub fn with_projection(mut self, columns: types::ColumnMask) -> Self {
+        self.set_projection(columns);
+        self
+    }
+
+    /// Set the projection on an existing iterator (C ABI / FFI).
+    pub fn set_projection(&mut self, columns: types::ColumnMask) {
+        self.columns = columns;
+    }
+
+    /// Columns decoded by `next`.
+    pub fn projection(&self) -> types::ColumnMask {
+        self.columns
+    }
+
+    /// Use `index` for [`Self::seek`] (and so [`Self::strided`]) instead of
+    /// skipping frame by frame. The index must have been built for the exact
+    /// buffer passed to [`Self::new`], e.g. via
+    /// [`crate::offset_index::FrameOffsetIndex::load_fresh`] on its file.
+    pub fn with_offset_index(mut self, index: &'a crate::offset_index::FrameOffsetIndex) -> Self {
+        self.index = Some(index);
+        self
+    }
+
+    /// Index of the frame the next call to `next` / `forward_fast` consumes.
+    pub fn next_frame_index(&self) -> usize {
+        self.position
+    }
+
+    /// Opt into intra-frame parallel decoding: per-component coordinate
+    /// blocks and per-atom section blocks of at least
+    /// [`INTRA_FRAME_PARALLEL_ROWS`] rows are cut at newlines and parsed on
+    /// the global Rayon pool. Frames are identical to the sequential parse;
+    /// this only pays off for very large single frames (millions of atoms).
+    ///
+    /// Requires the `parallel` feature.
+    #[cfg(feature = "parallel")]
+    pub fn with_intra_frame_parallel(mut self) -> Self {
+        self.lines.row_block_min = INTRA_FRAME_PARALLEL_ROWS;
+        self
+    }
+
+    /// Skips up to `n` frames with [`Self::forward_fast`] and returns how
+    /// many were skipped (fewer than `n` only at end of input).
+    pub fn skip_frames(&mut self, n: usize) -> Result<usize, error::ParseError> {
+        for skipped in 0..n {
+            match self.forward_fast() {
+                Some(Ok(())) => {}
+                Some(Err(e)) => return Err(e),
+                None => return Ok(skipped),
+            }
+        }
+        Ok(n)
+    }
+
+    /// Positions the cursor so the next frame consumed is frame `frame`.
+    ///
+    /// With an offset index this is O(1). Otherwise seeking forward skips
+    /// the intervening frames and seeking backward rewinds to the start of
+    /// the buffer first. Returns `Ok(false)` (cursor left at end of input)
+    /// when the buffer holds `frame` frames or fewer.
+    pub fn seek(&mut self, frame: usize) -> Result<bool, error::ParseError> {
+        if let Some(index) = self.index {
+            self.lines.peeked = None;
+            self.lines.pos = match index.entries.get(frame) {
+                Some(entry) => (entry.offset as usize).min(self.lines.bytes.len()),
+                None => self.lines.bytes.len(),
+            };
+            self.position = frame.min(index.len());
+            return Ok(frame < index.len());
+        }
+        if frame < self.position {
+            self.lines.peeked = None;
+            self.lines.pos = 0;
+            self.position = 0;
+        }
+        let want = frame - self.position;
+        if self.skip_frames(want)? < want {
+            return Ok(false);
+        }
+        Ok(self.lines.peek_line().is_some())
+    }
+
+    /// Frames `start, start + step, …` before `stop` (all remaining frames
+    /// when `stop` is `None`), like Python's `frames[start:stop:step]`.
+    /// Frames in between are skipped without parsing their atom data.
+    ///
+    /// # Panics
+    /// If `step` is zero.
+    pub fn strided(self, start: usize, stop: Option<usize>, step: usize) -> StridedFrames<'a> {
+        assert!(step > 0, "stride step must be non-zero");
+        StridedFrames {
+            inner: self,
+            next: start,
+            stop,
+            step,
+        }
+    }
+
+    /// Byte offset of the next unconsumed line in the buffer passed to
+    /// [`Self::new`] (a pending peek counts as unconsumed).
+    pub fn byte_offset(&self) -> usize {
+        match self.lines.peeked {
+            Some(p) => p.as_ptr() as usize - self.lines.bytes.as_ptr() as usize,
+            None => self.lines.pos,
         }
     }
 
@@ -150,6 +320,7 @@ impl<'a> ConFrameIterator<'a> {
         if self.lines.pos >= self.lines.bytes.len() {
             return None;
         }
+        self.position += 1;
         // Lines 1..=6 of the header are skipped wholesale.
         if let Err(e) = self.advance_lines(6) {
             return Some(Err(e));
@@ -175,10 +346,18 @@ impl<'a> ConFrameIterator<'a> {
             return Some(Err(e));
         }
         let total_atoms: usize = natms_per_type.iter().sum();
+        Some(self.skip_atom_blocks(natm_types, total_atoms))
+    }
+
+    /// Skips the coordinate block and every blank-separated section after
+    /// a frame header with `natm_types` components and `total_atoms` atoms.
+    fn skip_atom_blocks(
+        &mut self,
+        natm_types: usize,
+        total_atoms: usize,
+    ) -> Result<(), error::ParseError> {
         let coord_block_lines = total_atoms + natm_types * 2;
-        if let Err(e) = self.advance_lines(coord_block_lines) {
-            return Some(Err(e));
-        }
+        self.advance_lines(coord_block_lines)?;
         // Optional sections: blank line + same-shape block, repeated.
         self.lines.clear_peek();
         loop {
@@ -197,11 +376,26 @@ impl<'a> ConFrameIterator<'a> {
             }
             // Consume the blank separator and the section block.
             self.lines.pos += next_eol.map(|p| p + 1).unwrap_or(rest.len());
-            if let Err(e) = self.advance_lines(coord_block_lines) {
-                return Some(Err(e));
-            }
+            self.advance_lines(coord_block_lines)?;
         }
-        Some(Ok(()))
+        Ok(())
+    }
+
+    /// Header-only frame for [`types::ColumnMask::NONE`]: the atom blocks
+    /// are skipped as in [`Self::forward_fast`].
+    fn next_header_only(&mut self) -> Result<types::ConFrame, error::ParseError> {
+        let mut header = types::FrameHeader::default();
+        crate::parser::parse_frame_header_cached(
+            &mut self.lines,
+            &mut header,
+            &mut self.header_cache,
+        )?;
+        let total_atoms: usize = header.natms_per_type.iter().sum();
+        self.skip_atom_blocks(header.natm_types, total_atoms)?;
+        header.sections.clear();
+        let kind = self.header_cache.dtypes().positions;
+        let positions = crate::storage_dtype::FloatArray2::zeros(kind, 0, 3);
+        Ok(types::con_frame_coords_only(header, Vec::new(), positions))
     }
 
     /// Skips the next frame without fully parsing its atomic data.
@@ -252,6 +446,15 @@ impl<'a> ConFrameIterator<'a> {
         debug_assert!(end >= start && end <= file_contents.len());
         Some(Ok((frame, &file_contents[start..end])))
     }
+
+    /// Parses the next frame, sections included, as a [`LeanFrame`]: SoA
+    /// blocks only, no `AtomDatum` vector. Shares the cursor (and frame
+    /// position) with [`Iterator::next`], so the two can be interleaved.
+    pub fn next_lean(&mut self) -> Option<Result<LeanFrame, error::ParseError>> {
+        self.lines.peek_line()?;
+        self.position += 1;
+        Some(parse_lean_frame_stream(&mut self.lines))
+    }
 }
 
 impl<'a> Iterator for ConFrameIterator<'a> {
@@ -269,29 +472,118 @@ impl<'a> Iterator for ConFrameIterator<'a> {
     fn next(&mut self) -> Option<Self::Item> {
         // If there are no more lines at all, the iterator is exhausted.
         self.lines.peek_line()?;
+        self.position += 1;
+        if self.columns.is_header_only() {
+            return Some(self.next_header_only());
+        }
         // Otherwise, attempt to parse the next frame from the available lines.
-        let mut frame = match parse_single_frame(&mut self.lines) {
+        let mut frame = match parse_single_frame_cached(&mut self.lines, &mut self.header_cache) {
             Ok(f) => f,
             Err(e) => return Some(Err(e)),
         };
         // Optional sections mutate AoS; only re-sync section SoA when needed.
         // Plain .con assembly already filled positions/ids/masses (no O(N)
         // post-scan when no velocity/force sections were applied).
-        let sections = match parse_declared_sections(
+        let sections = match parse_declared_sections_projected(
             &mut self.lines,
             &mut frame.header,
             &mut frame.atom_data,
+            self.columns,
         ) {
             Ok(n) => n,
             Err(e) => return Some(Err(e)),
         };
         if sections > 0 {
+            let _timer = stats::timer(stats::Stage::Assemble);
             frame.sync_arrays_from_atom_data();
         }
         Some(Ok(frame))
     }
 }
 
+impl ConFrameIterator<'_> {
+    /// Parses the next frame into `frame`, reusing its allocations: the
+    /// recycling counterpart of `next` for loops that process and drop each
+    /// frame. `Some(Ok(()))` when `frame` now holds the next frame, `None` at
+    /// end of input; errors and projection behave as for `next`.
+    ///
+    /// Header strings, `atom_data`, the SoA blocks and the component symbol
+    /// `Arc`s are refilled in place while the atom count, species layout and
+    /// storage dtypes stay the same, so steady-state parsing of a fixed-size
+    /// trajectory does not allocate per atom. Blocks still shared with a
+    /// clone of `frame` are copied on write instead of being overwritten.
+    /// After an error `frame` is in an unspecified (but valid) state.
+    ///
+    /// ```
+    /// use readcon_core::iterators::ConFrameIterator;
+    /// use readcon_core::types::ConFrame;
+    ///
+    /// let text = std::fs::read_to_string("resources/test/tiny_multi_cuh2.con").unwrap();
+    /// let mut frames = ConFrameIterator::new(&text);
+    /// let mut frame = ConFrame::default();
+    /// while let Some(r) = frames.next_into(&mut frame) {
+    ///     r.unwrap();
+    ///     assert!(!frame.atom_data.is_empty());
+    /// }
+    /// ```
+    pub fn next_into(
+        &mut self,
+        frame: &mut types::ConFrame,
+    ) -> Option<Result<(), error::ParseError>> {
+        self.lines.peek_line()?;
+        self.position += 1;
+        if self.columns.is_header_only() {
+            return Some(self.next_header_only().map(|f| *frame = f));
+        }
+        Some(self.refill(frame))
+    }
+
+    fn refill(&mut self, frame: &mut types::ConFrame) -> Result<(), error::ParseError> {
+        crate::parser::parse_single_frame_into(&mut self.lines, frame, &mut self.header_cache)?;
+        let sections = parse_declared_sections_projected(
+            &mut self.lines,
+            &mut frame.header,
+            &mut frame.atom_data,
+            self.columns,
+        )?;
+        let _timer = stats::timer(stats::Stage::Assemble);
+        if sections > 0 {
+            frame.sync_arrays_from_atom_data();
+        } else {
+            frame.clear_section_arrays();
+        }
+        Ok(())
+    }
+}
+
+/// Strided view over a [`ConFrameIterator`]; see [`ConFrameIterator::strided`].
+pub struct StridedFrames<'a> {
+    inner: ConFrameIterator<'a>,
+    next: usize,
+    stop: Option<usize>,
+    step: usize,
+}
+
+impl<'a> Iterator for StridedFrames<'a> {
+    type Item = Result<types::ConFrame, error::ParseError>;
+
+    fn next(&mut self) -> Option<Self::Item> {
+        if self.stop.is_some_and(|stop| self.next >= stop) {
+            return None;
+        }
+        match self.inner.seek(self.next) {
+            Ok(true) => {}
+            Ok(false) => return None,
+            Err(e) => {
+                self.stop = Some(0);
+                return Some(Err(e));
+            }
+        }
+        self.next = self.next.saturating_add(self.step);
+        self.inner.next()
+    }
+}
+
 #[cfg(test)]
 mod aos_soa_agreement_tests {
     use super::*;
@@ -359,6 +651,53 @@ mod aos_soa_agreement_tests {
             fr2.atom_data[0].force.expect("force")
         );
     }
+    #[test]
+    fn next_into_matches_next_and_reuses_buffers() {
+        let dir = PathBuf::from(env!("CARGO_MANIFEST_DIR")).join("resources/test");
+        let text: String = [
+            "tiny_multi_cuh2.con",
+            "tiny_cuh2_vel_forces.con",
+            "tiny_multi_cuh2.con",
+            "sulfolene.con",
+            "tiny_cuh2_charges_spins_magmoms.con",
+        ]
+        .iter()
+        .map(|name| std::fs::read_to_string(dir.join(name)).expect("fixture"))
+        .collect();
+        let expected: Vec<types::ConFrame> =
+            ConFrameIterator::new(&text).map(|r| r.expect("parse")).collect();
+
+        let mut it = ConFrameIterator::new(&text);
+        let mut frame = types::ConFrame::default();
+        let mut prev: Option<(*const f64, std::sync::Arc<str>, usize)> = None;
+        for want in &expected {
+            it.next_into(&mut frame).expect("frame").expect("parse");
+            assert_eq!(&frame, want);
+            assert_eq!(frame.header.prebox_header.metadata_line(), want.header.prebox_header.metadata_line());
+            let ptr = frame.positions.as_f64_slice().unwrap().as_ptr();
+            let symbol = std::sync::Arc::clone(&frame.atom_data[0].symbol);
+            if let Some((p, s, n)) = &prev {
+                if *n == frame.atom_data.len() && **s == *symbol {
+                    assert_eq!(*p, ptr, "same-size frames must refill positions in place");
+                    assert!(std::sync::Arc::ptr_eq(s, &symbol), "symbols are interned");
+                }
+            }
+            prev = Some((ptr, symbol, frame.atom_data.len()));
+        }
+        assert!(it.next_into(&mut frame).is_none());
+
+        // Buffers still shared with a clone are replaced, never written through.
+        let mut it = ConFrameIterator::new(&text);
+        it.next_into(&mut frame).expect("frame").expect("parse");
+        let kept = frame.clone();
+        it.next_into(&mut frame).expect("frame").expect("parse");
+        assert_eq!(kept, expected[0]);
+        assert_eq!(frame, expected[1]);
+        assert_ne!(
+            kept.positions.as_f64_slice().unwrap().as_ptr(),
+            frame.positions.as_f64_slice().unwrap().as_ptr()
+        );
+    }
 }
 
 /// Reads all frames from a file.
@@ -374,30 +713,125 @@ mod aos_soa_agreement_tests {
 #[cfg(feature = "parallel")]
 pub const PARALLEL_BYTES_THRESHOLD: usize = 48 * 1024;
 
+/// Rows in one component block from which
+/// [`ConFrameIterator::with_intra_frame_parallel`] splits the block across
+/// Rayon workers. Below this the per-chunk bookkeeping outweighs the gain.
+#[cfg(feature = "parallel")]
+pub const INTRA_FRAME_PARALLEL_ROWS: usize = 32 * 1024;
+
 pub fn read_all_frames(path: &Path) -> Result<Vec<types::ConFrame>, Box<dyn std::error::Error>> {
+    read_all_frames_projected(path, types::ColumnMask::ALL)
+}
+
+/// Like [`read_all_frames`], decoding only `columns` (see
+/// [`ConFrameIterator::with_projection`]).
+pub fn read_all_frames_projected(
+    path: &Path,
+    columns: types::ColumnMask,
+) -> Result<Vec<types::ConFrame>, Box<dyn std::error::Error>> {
+    #[cfg(feature = "zstd")]
+    if let Some(table) = crate::compression::detect_zstd_seek_table(path)? {
+        return read_seekable_blocks(path, &table, columns);
+    }
     let contents = crate::compression::read_file_contents(path)?;
     let text = contents.as_str()?;
     #[cfg(feature = "parallel")]
     {
         if text.len() >= PARALLEL_BYTES_THRESHOLD {
-            let parts = parse_frames_parallel(text);
-            let mut frames = Vec::with_capacity(parts.len());
-            for r in parts {
-                frames.push(r?);
-            }
-            return Ok(frames);
+            let frames: Result<Vec<_>, _> = ParallelFrameIterator::scope(text, None, |it| {
+                it.with_projection(columns).collect()
+            });
+            return Ok(frames?);
         }
     }
-    let iter = ConFrameIterator::new(text);
+    let iter = ConFrameIterator::new(text).with_projection(columns);
     let frames: Result<Vec<_>, _> = iter.collect();
     Ok(frames?)
 }
 
+/// Inflate and parse every block of a seekable `.con.zst`; blocks are
+/// independent, so with the `parallel` feature they decode on the Rayon pool.
+#[cfg(feature = "zstd")]
+fn read_seekable_blocks(
+    path: &Path,
+    table: &crate::compression::ZstdSeekTable,
+    columns: types::ColumnMask,
+) -> Result<Vec<types::ConFrame>, Box<dyn std::error::Error>> {
+    type BlockResult = Result<Vec<types::ConFrame>, Box<dyn std::error::Error + Send + Sync>>;
+    let file = std::fs::File::open(path)?;
+    // Safety: read-only mapping of a file we do not modify.
+    let data = unsafe { memmap2::Mmap::map(&file)? };
+    let decode = |k: usize| -> BlockResult {
+        let compressed = table.block_bytes(&data, k).ok_or("seek table block out of range")?;
+        let text = crate::compression::decode_block(compressed, &table.blocks[k])?;
+        Ok(ConFrameIterator::new(&text).with_projection(columns).collect::<Result<_, _>>()?)
+    };
+    #[cfg(feature = "parallel")]
+    let blocks: Result<Vec<_>, _> = {
+        use rayon::prelude::*;
+        (0..table.blocks.len()).into_par_iter().map(decode).collect()
+    };
+    #[cfg(not(feature = "parallel"))]
+    let blocks: Result<Vec<_>, _> = (0..table.blocks.len()).map(decode).collect();
+    match blocks {
+        Ok(blocks) => Ok(blocks.into_iter().flatten().collect()),
+        Err(e) => Err(e),
+    }
+}
+
+/// Like [`read_all_frames`], but always decodes with a
+/// [`ParallelFrameIterator`] on `num_threads` workers (`None`: the global
+/// Rayon pool), whatever the file size.
+///
+/// Requires the `parallel` feature.
+#[cfg(feature = "parallel")]
+pub fn read_all_frames_with_threads(
+    path: &Path,
+    num_threads: Option<usize>,
+) -> Result<Vec<types::ConFrame>, Box<dyn std::error::Error>> {
+    let contents = crate::compression::read_file_contents(path)?;
+    let frames: Result<Vec<_>, _> =
+        ParallelFrameIterator::scope(contents.as_str()?, num_threads, |it| it.collect());
+    Ok(frames?)
+}
+
+/// Like [`read_all_frames`], but yields [`LeanFrame`]s (SoA blocks only),
+/// roughly halving resident memory for large trajectories.
+pub fn read_all_frames_lean(path: &Path) -> Result<Vec<LeanFrame>, Box<dyn std::error::Error>> {
+    let contents = crate::compression::read_file_contents(path)?;
+    let mut iter = ConFrameIterator::new(contents.as_str()?);
+    let frames: Result<Vec<_>, _> = std::iter::from_fn(|| iter.next_lean()).collect();
+    Ok(frames?)
+}
+
+/// Whether `path` holds gzip/zstd data, i.e. should be streamed rather than
+/// inflated whole by [`crate::compression::read_file_contents`].
+fn is_compressed(path: &Path) -> std::io::Result<bool> {
+    Ok(crate::compression::detect_path_compression(path)? != crate::compression::Compression::None)
+}
+
 /// Count frames without building atom payloads (uses [`ConFrameIterator::forward_fast`]
 /// when possible, else [`ConFrameIterator::forward`]).
 ///
 /// Prefer this over `read_all_frames(...).len()` when only the frame count is needed.
 pub fn count_frames(path: &Path) -> Result<usize, Box<dyn std::error::Error>> {
+    #[cfg(feature = "zstd")]
+    if let Some(table) = crate::compression::detect_zstd_seek_table(path)? {
+        return Ok(table.n_frames());
+    }
+    if is_compressed(path)? {
+        // Constant memory: inflate and skip chunk by chunk.
+        let mut stream = crate::streaming::StreamingConFrameIterator::from_path(path)?;
+        let mut n = 0usize;
+        while let Some(r) = stream.forward() {
+            r?;
+            n += 1;
+        }
+        return Ok(n);
+    }
+    if let Some(n) = crate::offset_index::fresh_frame_count(path) {
+        return Ok(n);
+    }
     let contents = crate::compression::read_file_contents(path)?;
     let text = contents.as_str()?;
     let mut n = 0usize;
@@ -417,6 +851,15 @@ pub fn count_frames(path: &Path) -> Result<usize, Box<dyn std::error::Error>> {
 /// More efficient than `read_all_frames` for single-frame access because it
 /// stops parsing after the first frame rather than collecting all of them.
 pub fn read_first_frame(path: &Path) -> Result<types::ConFrame, Box<dyn std::error::Error>> {
+    if is_compressed(path)? {
+        // Inflate only as far as the end of frame 0.
+        let mut stream = crate::streaming::StreamingConFrameIterator::from_path(path)?;
+        return match stream.next() {
+            Some(Ok(frame)) => Ok(frame),
+            Some(Err(e)) => Err(Box::new(e)),
+            None => Err("No frames found in file".into()),
+        };
+    }
     let contents = crate::compression::read_file_contents(path)?;
     let text = contents.as_str()?;
     let mut iter = ConFrameIterator::new(text);
@@ -427,18 +870,126 @@ pub fn read_first_frame(path: &Path) -> Result<types::ConFrame, Box<dyn std::err
     }
 }
 
-/// Parses frames in parallel using rayon, splitting on frame boundaries.
+/// Reads frame `index` (0-based) from a file.
+///
+/// With a fresh `.con.idx` sidecar (see [`crate::offset_index`]) this reads
+/// only that frame's bytes. Otherwise frames before `index` are skipped with
+/// [`ConFrameIterator::forward_fast`] (or streamed for compressed input).
+pub fn read_frame(path: &Path, index: usize) -> Result<types::ConFrame, Box<dyn std::error::Error>> {
+    if let Some(records) = crate::offset_index::SidecarRecords::open_fresh(path) {
+        if index >= records.len() {
+            return Err(format!("frame {index} out of range ({} frames)", records.len()).into());
+        }
+        return records.entry(index)?.read_frame(&std::fs::File::open(path)?);
+    }
+    let out_of_range = || -> Box<dyn std::error::Error> { format!("frame {index} out of range").into() };
+    #[cfg(feature = "zstd")]
+    if let Some(table) = crate::compression::detect_zstd_seek_table(path)? {
+        // Inflate only the block that holds the frame.
+        let k = table.block_of_frame(index).ok_or_else(out_of_range)?;
+        let text = table.read_block(&std::fs::File::open(path)?, k)?;
+        let mut iter = ConFrameIterator::new(&text);
+        for _ in 0..index - table.blocks[k].first_frame as usize {
+            iter.forward_fast().ok_or_else(out_of_range)??;
+        }
+        return Ok(iter.next().ok_or_else(out_of_range)??);
+    }
+    if is_compressed(path)? {
+        let mut stream = crate::streaming::StreamingConFrameIterator::from_path(path)?;
+        for _ in 0..index {
+            stream.forward().ok_or_else(out_of_range)??;
+        }
+        return Ok(stream.next().ok_or_else(out_of_range)??);
+    }
+    let contents = crate::compression::read_file_contents(path)?;
+    let mut iter = ConFrameIterator::new(contents.as_str()?);
+    for _ in 0..index {
+        iter.forward_fast().ok_or_else(out_of_range)??;
+    }
+    Ok(iter.next().ok_or_else(out_of_range)??)
+}
+
+/// Reads frames `start, start + step, …` before `stop` (to the end when
+/// `None`) from a file; the path-level counterpart of
+/// [`ConFrameIterator::strided`].
 ///
-/// Phase 1: sequential O(N) scan via memchr-backed
-/// [`ConFrameIterator::forward_fast`] to find byte offsets of every
-/// frame's start. The previous implementation built a `Vec<&str>` of
-/// every line and called `lines[..i].iter().map(|l| l.len() +
-/// 1).sum()` on every frame, which is O(N^2) in line count and
-/// dominated runtime on multi-frame trajectories.
+/// With a fresh `.con.idx` sidecar only the selected frames' bytes are read.
+/// Otherwise unselected frames are skipped with
+/// [`ConFrameIterator::forward_fast`] (or streamed for compressed input), so
+/// they are never parsed.
+pub fn read_frames_strided(
+    path: &Path,
+    start: usize,
+    stop: Option<usize>,
+    step: usize,
+) -> Result<Vec<types::ConFrame>, Box<dyn std::error::Error>> {
+    if step == 0 {
+        return Err("stride step must be non-zero".into());
+    }
+    if let Some(records) = crate::offset_index::SidecarRecords::open_fresh(path) {
+        let file = std::fs::File::open(path)?;
+        let stop = stop.map_or(records.len(), |s| s.min(records.len()));
+        return (start..stop)
+            .step_by(step)
+            .map(|i| records.entry(i)?.read_frame(&file))
+            .collect();
+    }
+    #[cfg(feature = "zstd")]
+    if let Some(table) = crate::compression::detect_zstd_seek_table(path)? {
+        // Only blocks holding a selected frame are inflated.
+        let file = std::fs::File::open(path)?;
+        let stop = stop.map_or(table.n_frames(), |s| s.min(table.n_frames()));
+        let mut frames = Vec::new();
+        for (k, block) in table.blocks.iter().enumerate() {
+            let first = block.first_frame as usize;
+            let end = (first + block.n_frames as usize).min(stop);
+            let next = if first <= start {
+                start
+            } else {
+                start + (first - start).div_ceil(step) * step
+            };
+            if next >= end {
+                continue;
+            }
+            let text = table.read_block(&file, k)?;
+            for frame in ConFrameIterator::new(&text).strided(next - first, Some(end - first), step) {
+                frames.push(frame?);
+            }
+        }
+        return Ok(frames);
+    }
+    if is_compressed(path)? {
+        let mut stream = crate::streaming::StreamingConFrameIterator::from_path(path)?;
+        let mut frames = Vec::new();
+        let mut i = 0usize;
+        while stop.is_none_or(|stop| i < stop) {
+            let selected = i >= start && (i - start) % step == 0;
+            let item = if selected {
+                stream.next().map(|r| r.map(|f| frames.push(f)))
+            } else {
+                stream.forward()
+            };
+            match item {
+                Some(r) => r?,
+                None => break,
+            }
+            i += 1;
+        }
+        return Ok(frames);
+    }
+    let contents = crate::compression::read_file_contents(path)?;
+    let frames = ConFrameIterator::new(contents.as_str()?)
+        .strided(start, stop, step)
+        .collect::<Result<Vec<_>, _>>()?;
+    Ok(frames)
+}
+
+/// Parses frames in parallel using rayon, splitting on frame boundaries.
 ///
-/// Phase 2: parallel parse of each frame slice using rayon on the
-/// **global** Rayon pool (see also [`parse_frames_parallel_with_threads`]
-/// for strong-scaling control of the worker count).
+/// Collects a [`ParallelFrameIterator`] on the **global** Rayon pool (see
+/// also [`parse_frames_parallel_with_threads`] for strong-scaling control of
+/// the worker count). The boundary scan for each window of frames overlaps
+/// with parsing of the previous one, so it is not a serial prelude.
 ///
 /// Requires the `parallel` feature.
 #[cfg(feature = "parallel")]
@@ -448,9 +999,9 @@ pub fn parse_frames_parallel(
     parse_frames_parallel_with_threads(file_contents, None)
 }
 
-/// Like [`parse_frames_parallel`], but runs phase-2 on an explicit Rayon
-/// pool with `num_threads` workers when `Some(n)` (`n` is clamped to at
-/// least 1). `None` uses the global pool (same as [`parse_frames_parallel`]).
+/// Like [`parse_frames_parallel`], but runs on an explicit Rayon pool with
+/// `num_threads` workers when `Some(n)` (`n` is clamped to at least 1).
+/// `None` uses the global pool (same as [`parse_frames_parallel`]).
 ///
 /// Strong-scaling tests pin worker counts without racing the global pool.
 /// Results are ordered by frame index (stable vs sequential iterator order).
@@ -461,55 +1012,426 @@ pub fn parse_frames_parallel_with_threads(
     file_contents: &str,
     num_threads: Option<usize>,
 ) -> Vec<Result<types::ConFrame, error::ParseError>> {
-    use rayon::prelude::*;
+    ParallelFrameIterator::scope(file_contents, num_threads, |it| it.collect())
+}
 
-    // Phase 1: walk the file once with forward_fast and snapshot the
-    // cursor before each frame.
-    let mut boundaries: Vec<usize> = Vec::new();
-    let mut scanner = ConFrameIterator::new(file_contents);
-    loop {
+/// Frames kept in flight per worker by [`ParallelFrameIterator`] unless
+/// overridden with [`ParallelFrameIterator::with_window`].
+#[cfg(feature = "parallel")]
+pub const PIPELINE_FRAMES_PER_THREAD: usize = 4;
+
+/// Pipelined parallel frame iterator: yields the same frames, in the same
+/// order, as [`ConFrameIterator`], decoding them on a Rayon pool.
+///
+/// Frames are handled a window at a time. The calling thread's
+/// `forward_fast` scan finds the byte spans of a window and sends them to
+/// a background worker (the bounded stage that also drives
+/// [`crate::prefetch::FramePrefetcher`]), which parses the window on
+/// the pool straight out of the shared buffer; no window is copied. Up to
+/// [`PIPELINE_WINDOWS`] windows are in flight, so scanning and decoding
+/// stay ahead of the consumer instead of stalling each `next` that crosses
+/// a window. Parsed frames are buffered in file order and handed out one by
+/// one; memory is bounded by the window (one parsed window plus those in
+/// flight) rather than by the trajectory length.
+///
+/// The worker borrows the buffer, so it runs either on a plain thread over
+/// `'static` text ([`Self::new`], e.g. the C ABI's file handles) or inside
+/// a [`std::thread::scope`] ([`Self::scoped`], [`Self::scope`]).
+///
+/// Requires the `parallel` feature.
+#[cfg(feature = "parallel")]
+pub struct ParallelFrameIterator<'a> {
+    text: &'a str,
+    scanner: ConFrameIterator<'a>,
+    /// The scanner has reached end of input (or a malformed frame).
+    scanned_all: bool,
+    /// Byte spans of frames scanned but not yet sent to the worker.
+    queued: std::collections::VecDeque<std::ops::Range<usize>>,
+    /// Byte spans of frames sent to the worker, in file order.
+    pending: std::collections::VecDeque<std::ops::Range<usize>>,
+    /// Parsed frames not yet consumed, with their byte spans, in file order.
+    ready: std::collections::VecDeque<ParsedSpan>,
+    window: usize,
+    worker: WindowWorker,
+    /// Windows sent to the worker whose results are not yet received.
+    in_flight: usize,
+    /// Leading frames of the windows in flight that were skipped; they are
+    /// dropped on arrival (their spans are already gone from `pending`).
+    discard: usize,
+    /// Bumped whenever buffered frames are dropped, so stale windows still
+    /// in flight are discarded on arrival.
+    generation: u64,
+    position: usize,
+    columns: types::ColumnMask,
+}
+
+/// Windows [`ParallelFrameIterator`] keeps scanned and decoding ahead of
+/// the one being consumed.
+#[cfg(feature = "parallel")]
+pub const PIPELINE_WINDOWS: usize = 2;
+
+#[cfg(feature = "parallel")]
+type ParsedSpan = (
+    Result<types::ConFrame, error::ParseError>,
+    std::ops::Range<usize>,
+);
+
+/// A window of frame spans into the worker's buffer.
+#[cfg(feature = "parallel")]
+struct WindowJob {
+    generation: u64,
+    spans: Vec<std::ops::Range<usize>>,
+    columns: types::ColumnMask,
+}
+
+#[cfg(feature = "parallel")]
+impl WindowJob {
+    fn parse(self, text: &str) -> Vec<ParsedSpan> {
+        use rayon::prelude::*;
+        let columns = self.columns;
+        self.spans
+            .into_par_iter()
+            .map(|span| {
+                let busy = stats::stopwatch();
+                let frame = ConFrameIterator::new(&text[span.clone()])
+                    .with_projection(columns)
+                    .next()
+                    .unwrap_or(Err(error::ParseError::IncompleteFrame));
+                stats::worker_busy(busy.nanos());
+                (frame, span)
+            })
+            .collect()
+    }
+}
+
+/// Parses [`WindowJob`]s over `text` in the order received, on `pool` or
+/// the global pool.
+#[cfg(feature = "parallel")]
+type WindowWorker = crate::pipeline::Stage<WindowJob, (u64, Vec<ParsedSpan>)>;
+
+#[cfg(feature = "parallel")]
+fn spawn_window_worker<'a>(
+    text: &'a str,
+    pool: Option<rayon::ThreadPool>,
+    launch: Box<crate::pipeline::Launch<'a>>,
+) -> WindowWorker {
+    WindowWorker::spawn(PIPELINE_WINDOWS, PIPELINE_WINDOWS, launch, move |jobs, parsed| {
+        while let Ok(job) = jobs.recv() {
+            let generation = job.generation;
+            let wall = stats::stopwatch();
+            let (frames, workers) = match &pool {
+                Some(pool) => (pool.install(|| job.parse(text)), pool.current_num_threads()),
+                None => (job.parse(text), rayon::current_num_threads()),
+            };
+            stats::parallel_batch(wall.nanos(), workers);
+            if !parsed.send((generation, frames)) {
+                return;
+            }
+        }
+    })
+}
+
+#[cfg(feature = "parallel")]
+impl ParallelFrameIterator<'static> {
+    /// Decode `'static` text on a private pool of `num_threads` workers
+    /// (clamped to at least 1), or on the global pool when `None`. The
+    /// window defaults to [`PIPELINE_FRAMES_PER_THREAD`] frames per worker.
+    /// Borrowed text goes through [`Self::scope`] or [`Self::scoped`].
+    pub fn new(file_contents: &'static str, num_threads: Option<usize>) -> Self {
+        Self::start(file_contents, num_threads, crate::pipeline::detached())
+    }
+}
+
+#[cfg(feature = "parallel")]
+impl<'a> ParallelFrameIterator<'a> {
+    /// [`Self::new`] for borrowed text: the worker runs on `scope`, which
+    /// joins it once the iterator is dropped.
+    pub fn scoped(
+        scope: &'a std::thread::Scope<'a, '_>,
+        file_contents: &'a str,
+        num_threads: Option<usize>,
+    ) -> Self {
+        Self::start(file_contents, num_threads, crate::pipeline::scoped(scope))
+    }
+
+    /// Runs `f` on a [`Self::scoped`] iterator over `file_contents` and
+    /// returns its result.
+    pub fn scope<R>(
+        file_contents: &str,
+        num_threads: Option<usize>,
+        f: impl for<'s> FnOnce(ParallelFrameIterator<'s>) -> R,
+    ) -> R {
+        std::thread::scope(|scope| {
+            f(ParallelFrameIterator::scoped(scope, file_contents, num_threads))
+        })
+    }
+
+    fn start(
+        file_contents: &'a str,
+        num_threads: Option<usize>,
+        launch: Box<crate::pipeline::Launch<'a>>,
+    ) -> Self {
+        let pool = num_threads.map(|n| {
+            rayon::ThreadPoolBuilder::new()
+                .num_threads(n.max(1))
+                .build()
+                .expect("rayon pool")
+        });
+        let workers = pool
+            .as_ref()
+            .map_or_else(rayon::current_num_threads, |p| p.current_num_threads());
+        Self {
+            text: file_contents,
+            scanner: ConFrameIterator::new(file_contents),
+            scanned_all: false,
+            queued: std::collections::VecDeque::new(),
+            pending: std::collections::VecDeque::new(),
+            ready: std::collections::VecDeque::new(),
+            window: workers.max(1) * PIPELINE_FRAMES_PER_THREAD,
+            worker: spawn_window_worker(file_contents, pool, launch),
+            in_flight: 0,
+            discard: 0,
+            generation: 0,
+            position: 0,
+            columns: types::ColumnMask::ALL,
+        }
+    }
+
+    /// Decode only `columns`, as [`ConFrameIterator::with_projection`].
+    pub fn with_projection(mut self, columns: types::ColumnMask) -> Self {
+        self.set_projection(columns);
+        self
+    }
+
+    /// Set the projection on an existing iterator (C ABI / FFI). Frames
+    /// already decoded ahead keep the previous projection.
+    pub fn set_projection(&mut self, columns: types::ColumnMask) {
+        self.columns = columns;
+    }
+
+    /// Sets how many frames are scanned ahead and parsed per batch (the
+    /// reorder window; clamped to at least 1). Larger windows amortise the
+    /// per-batch hand-off, smaller ones bound memory more tightly.
+    pub fn with_window(mut self, window: usize) -> Self {
+        self.window = window.max(1);
+        self
+    }
+
+    /// Uses `index` for O(1) [`Self::seek`], as
+    /// [`ConFrameIterator::with_offset_index`].
+    pub fn with_offset_index(mut self, index: &'a crate::offset_index::FrameOffsetIndex) -> Self {
+        self.scanner = self.scanner.with_offset_index(index);
+        self
+    }
+
+    /// Index of the frame the next call to `next` returns.
+    pub fn next_frame_index(&self) -> usize {
+        self.position
+    }
+
+    /// Start of the bytes not yet parsed; everything before it belongs to
+    /// frames already consumed or buffered.
+    pub fn byte_offset(&self) -> usize {
+        self.pending
+            .front()
+            .or(self.queued.front())
+            .map_or_else(|| self.scanner.byte_offset(), |span| span.start)
+    }
+
+    /// Skips up to `n` frames, returning how many were skipped. Frames
+    /// already scanned are popped from the buffers in order (frames still
+    /// being parsed are dropped when their window arrives), so the rest of
+    /// the pipeline keeps running; frames past the buffers are skipped
+    /// without parsing.
+    pub fn skip_frames(&mut self, n: usize) -> Result<usize, error::ParseError> {
+        let mut skipped = 0;
+        while skipped < n && self.ready.pop_front().is_some() {
+            skipped += 1;
+        }
+        while skipped < n && self.pending.pop_front().is_some() {
+            self.discard += 1;
+            skipped += 1;
+        }
+        while skipped < n && self.queued.pop_front().is_some() {
+            skipped += 1;
+        }
+        if skipped < n && !self.scanned_all {
+            skipped += self.scanner.skip_frames(n - skipped)?;
+        }
+        self.position += skipped;
+        Ok(skipped)
+    }
+
+    /// Positions the iterator at frame `frame`, as [`ConFrameIterator::seek`].
+    /// Seeking forward never rescans: frames already scanned ahead are
+    /// located from their buffered spans, later ones by skipping on from
+    /// the scanner (or through the offset index).
+    pub fn seek(&mut self, frame: usize) -> Result<bool, error::ParseError> {
+        let ahead = frame.checked_sub(self.position);
+        if let Some(want) = ahead
+            && (self.scanner.index.is_none() || self.buffered_start(want).is_some())
+        {
+            if self.skip_frames(want)? < want {
+                return Ok(false);
+            }
+            return Ok(!self.ready.is_empty()
+                || !self.pending.is_empty()
+                || !self.queued.is_empty()
+                || (!self.scanned_all && self.scanner.lines.peek_line().is_some()));
+        }
+        self.drop_buffered();
+        self.scanned_all = false;
+        let found = self.scanner.seek(frame);
+        self.position = self.scanner.next_frame_index();
+        found
+    }
+
+    /// Start of the `k`-th frame (0: the next one) among those scanned but
+    /// not yet consumed.
+    fn buffered_start(&self, k: usize) -> Option<usize> {
+        self.ready
+            .iter()
+            .map(|(_, span)| span)
+            .chain(&self.pending)
+            .chain(&self.queued)
+            .nth(k)
+            .map(|span| span.start)
+    }
+
+    /// Drops every buffered frame before the scanner is moved; windows
+    /// still in flight are discarded when they arrive.
+    fn drop_buffered(&mut self) {
+        self.ready.clear();
+        self.pending.clear();
+        self.queued.clear();
+        self.discard = 0;
+        self.generation += 1;
+    }
+
+    /// Scans and sends windows until [`PIPELINE_WINDOWS`] are in flight or
+    /// the input is exhausted.
+    fn fill_pipeline(&mut self) {
+        while self.in_flight < PIPELINE_WINDOWS {
+            if self.queued.is_empty() && !self.scanned_all {
+                self.scanned_all =
+                    scan_frame_spans(&mut self.scanner, self.window, &mut self.queued);
+            }
+            if self.queued.is_empty() {
+                return;
+            }
+            let job = WindowJob {
+                generation: self.generation,
+                spans: self.queued.drain(..).collect(),
+                columns: self.columns,
+            };
+            self.pending.extend(job.spans.iter().cloned());
+            if !self.worker.send(job) {
+                // The worker is gone (it panicked): stop at what was read.
+                self.pending.clear();
+                self.scanned_all = true;
+                return;
+            }
+            self.in_flight += 1;
+        }
+    }
+
+    /// Blocks for the oldest window in flight and buffers its frames unless
+    /// it is stale.
+    fn receive_window(&mut self) {
+        let Some((generation, frames)) = self.worker.recv() else {
+            self.in_flight = 0;
+            self.pending.clear();
+            self.discard = 0;
+            return;
+        };
+        self.in_flight -= 1;
+        if generation == self.generation {
+            let skipped = self.discard.min(frames.len());
+            self.discard -= skipped;
+            let kept = frames.len() - skipped;
+            self.pending.drain(..kept);
+            self.ready.extend(frames.into_iter().skip(skipped));
+        }
+    }
+}
+
+/// Appends the byte spans of up to `limit - out.len()` further frames to
+/// `out`. Returns `true` once the scan has reached end of input; a frame
+/// that fails to scan is queued to the end of the buffer so parsing reports
+/// its error in order.
+#[cfg(feature = "parallel")]
+fn scan_frame_spans(
+    scanner: &mut ConFrameIterator<'_>,
+    limit: usize,
+    out: &mut std::collections::VecDeque<std::ops::Range<usize>>,
+) -> bool {
+    let mut timer = stats::timer(stats::Stage::Scan);
+    let from = scanner.lines.pos;
+    let done = scan_spans(scanner, limit, out);
+    timer.add_bytes(out.back().map_or(from, |span| span.end).saturating_sub(from) as u64);
+    done
+}
+
+#[cfg(feature = "parallel")]
+fn scan_spans(
+    scanner: &mut ConFrameIterator<'_>,
+    limit: usize,
+    out: &mut std::collections::VecDeque<std::ops::Range<usize>>,
+) -> bool {
+    let len = scanner.lines.bytes.len();
+    while out.len() < limit {
         scanner.lines.clear_peek();
         let start = scanner.lines.pos;
-        if start >= scanner.lines.bytes.len() {
-            break;
+        if start >= len {
+            return true;
         }
-        boundaries.push(start);
         match scanner.forward_fast() {
-            Some(Ok(())) => {}
-            Some(Err(_)) | None => break,
+            Some(Ok(())) => {
+                scanner.lines.clear_peek();
+                out.push_back(start..scanner.lines.pos);
+            }
+            Some(Err(_)) | None => {
+                out.push_back(start..len);
+                return true;
+            }
         }
     }
+    false
+}
 
-    let parse_chunks = || {
-        let num_frames = boundaries.len();
-        (0..num_frames)
-            .into_par_iter()
-            .map(|i| {
-                let start = boundaries[i];
-                let end = if i + 1 < num_frames {
-                    boundaries[i + 1]
-                } else {
-                    file_contents.len()
-                };
-                let chunk = &file_contents[start..end];
-                let mut iter = ConFrameIterator::new(chunk);
-                match iter.next() {
-                    Some(result) => result,
-                    None => Err(error::ParseError::IncompleteFrame),
-                }
-            })
-            .collect()
-    };
+#[cfg(feature = "parallel")]
+impl<'a> Iterator for ParallelFrameIterator<'a> {
+    type Item = Result<types::ConFrame, error::ParseError>;
 
-    match num_threads {
-        None => parse_chunks(),
-        Some(n) => {
-            let n = n.max(1);
-            let pool = rayon::ThreadPoolBuilder::new()
-                .num_threads(n)
-                .build()
-                .expect("rayon pool");
-            pool.install(parse_chunks)
+    fn next(&mut self) -> Option<Self::Item> {
+        self.next_parsed().map(|(frame, _)| frame)
+    }
+}
+
+#[cfg(feature = "parallel")]
+impl<'a> ParallelFrameIterator<'a> {
+    /// Next frame plus its exact substring of the buffer passed to
+    /// [`Self::new`], as [`ConFrameIterator::next_with_raw_span`].
+    pub fn next_with_raw_span(
+        &mut self,
+    ) -> Option<Result<(types::ConFrame, &'a str), error::ParseError>> {
+        let text = self.text;
+        self.next_parsed()
+            .map(|(frame, span)| frame.map(|f| (f, &text[span])))
+    }
+
+    fn next_parsed(&mut self) -> Option<ParsedSpan> {
+        loop {
+            if let Some(frame) = self.ready.pop_front() {
+                self.position += 1;
+                self.fill_pipeline();
+                return Some(frame);
+            }
+            self.fill_pipeline();
+            if self.in_flight == 0 {
+                return None;
+            }
+            self.receive_window();
         }
     }
 }
@@ -567,4 +1489,302 @@ mod parallel_strong_scale_tests {
             .collect();
         assert_eq!(def_keys, seq_keys);
     }
+
+    #[test]
+    fn pipeline_window_keeps_order_and_supports_seek() {
+        let text = multi_frame_fixture();
+        let seq_keys: Vec<_> = sequential_frames(&text).iter().map(frames_payload_key).collect();
+        for window in [1usize, 3, 64] {
+            let keys: Vec<_> = ParallelFrameIterator::scope(&text, Some(2), |it| {
+                it.with_window(window)
+                    .map(|r| frames_payload_key(&r.expect("frame")))
+                    .collect()
+            });
+            assert_eq!(keys, seq_keys, "window={window}");
+        }
+
+        std::thread::scope(|s| {
+            let mut it = ParallelFrameIterator::scoped(s, &text, Some(2)).with_window(3);
+            it.next().unwrap().unwrap();
+            assert_eq!(it.skip_frames(4).unwrap(), 4);
+            assert_eq!(it.next_frame_index(), 5);
+            assert_eq!(it.by_ref().count(), 3);
+            assert!(it.seek(2).unwrap());
+            assert_eq!(it.next_frame_index(), 2);
+            assert_eq!(it.count(), 6);
+        });
+    }
+
+    #[test]
+    fn seek_within_scanned_frames_drops_stale_windows() {
+        let p = PathBuf::from(env!("CARGO_MANIFEST_DIR")).join("resources/test/tiny_cuh2.con");
+        let one = std::fs::read_to_string(p).expect("fixture");
+        let text: String = (0..12)
+            .map(|k| one.replacen("0.63940000000000108", &format!("{k}.0"), 1))
+            .collect();
+        let text: &'static str = Box::leak(text.into_boxed_str());
+        let first_x = |r: Option<Result<types::ConFrame, _>>| r.unwrap().unwrap().atom_data[0].x;
+
+        let mut it = ParallelFrameIterator::new(text, Some(2)).with_window(2);
+        assert_eq!(first_x(it.next()), 0.0);
+        // Frames 1..=5 are buffered or in flight; land inside them.
+        let scanned = it.scanner.next_frame_index();
+        assert!(scanned > 4, "scanned={scanned}");
+        assert!(it.seek(4).unwrap());
+        assert_eq!(it.next_frame_index(), 4);
+        assert_eq!(first_x(it.next()), 4.0);
+        assert_eq!(first_x(it.next()), 5.0);
+        // Forward past the scanner, then backward.
+        assert!(it.seek(10).unwrap());
+        assert_eq!(first_x(it.next()), 10.0);
+        assert!(it.seek(2).unwrap());
+        let rest: Vec<f64> = it.by_ref().map(|r| r.unwrap().atom_data[0].x).collect();
+        assert_eq!(rest, (2..12).map(f64::from).collect::<Vec<_>>());
+        assert!(!it.seek(12).unwrap());
+        assert!(it.next().is_none());
+    }
+
+    #[test]
+    fn strided_skips_keep_the_pipeline() {
+        let p = PathBuf::from(env!("CARGO_MANIFEST_DIR")).join("resources/test/tiny_cuh2.con");
+        let one = std::fs::read_to_string(p).expect("fixture");
+        let text: String = (0..20)
+            .map(|k| one.replacen("0.63940000000000108", &format!("{k}.0"), 1))
+            .collect();
+        // As the C++ `Range` with step 3 does: one frame, then skip two.
+        std::thread::scope(|s| {
+            let mut it = ParallelFrameIterator::scoped(s, &text, Some(2)).with_window(2);
+            let mut got = Vec::new();
+            while let Some(frame) = it.next() {
+                got.push(frame.unwrap().atom_data[0].x as usize);
+                it.skip_frames(2).unwrap();
+            }
+            assert_eq!(got, (0..20).step_by(3).collect::<Vec<_>>());
+            assert_eq!(it.generation, 0, "skips must not restart the pipeline");
+            assert_eq!(it.discard, 0);
+        });
+    }
+
+    #[test]
+    fn pipeline_reports_truncated_tail_in_order() {
+        let mut text = multi_frame_fixture();
+        let cut = text.len() - 40;
+        text.truncate(cut);
+        let seq: Vec<bool> = ConFrameIterator::new(&text).map(|r| r.is_ok()).collect();
+        let par: Vec<bool> = ParallelFrameIterator::scope(&text, Some(2), |it| {
+            it.with_window(2).map(|r| r.is_ok()).collect()
+        });
+        assert_eq!(par, seq);
+        assert_eq!(par.last(), Some(&false));
+    }
+}
+
+#[cfg(test)]
+mod seek_stride_tests {
+    use super::*;
+    use std::path::PathBuf;
+
+    /// Ten frames whose first atom's x coordinate equals the frame number.
+    fn numbered_frames() -> String {
+        let p = PathBuf::from(env!("CARGO_MANIFEST_DIR")).join("resources/test/tiny_cuh2.con");
+        let one = std::fs::read_to_string(p).expect("fixture");
+        (0..10)
+            .map(|k| one.replacen("0.63940000000000108", &format!("{k}.0"), 1))
+            .collect()
+    }
+
+    fn first_x(f: &types::ConFrame) -> usize {
+        f.atom_data[0].x as usize
+    }
+
+    #[test]
+    fn skip_and_seek_track_position() {
+        let text = numbered_frames();
+        let mut it = ConFrameIterator::new(&text);
+        assert_eq!(it.skip_frames(3).unwrap(), 3);
+        assert_eq!(it.next_frame_index(), 3);
+        assert_eq!(first_x(&it.next().unwrap().unwrap()), 3);
+
+        assert!(it.seek(7).unwrap());
+        assert_eq!(first_x(&it.next().unwrap().unwrap()), 7);
+        assert!(it.seek(1).unwrap(), "backward seek rewinds");
+        assert_eq!(first_x(&it.next().unwrap().unwrap()), 1);
+        assert!(!it.seek(10).unwrap());
+        assert!(it.next().is_none());
+        assert_eq!(it.skip_frames(5).unwrap(), 0);
+    }
+
+    #[test]
+    fn seek_uses_offset_index_when_given() {
+        let text = numbered_frames();
+        let dir = tempfile::tempdir().expect("tempdir");
+        let path = dir.path().join("numbered.con");
+        std::fs::write(&path, &text).unwrap();
+        let idx = crate::offset_index::FrameOffsetIndex::build_for_path(&path).unwrap();
+        let mut it = ConFrameIterator::new(&text).with_offset_index(&idx);
+        assert!(it.seek(8).unwrap());
+        assert_eq!(it.next_frame_index(), 8);
+        assert_eq!(first_x(&it.next().unwrap().unwrap()), 8);
+        assert!(it.seek(2).unwrap());
+        assert_eq!(first_x(&it.next().unwrap().unwrap()), 2);
+        assert!(!it.seek(11).unwrap());
+    }
+
+    #[test]
+    fn strided_matches_step_by_with_and_without_sidecar() {
+        let text = numbered_frames();
+        let expected: Vec<usize> = (1..9).step_by(3).collect();
+        let got: Vec<usize> = ConFrameIterator::new(&text)
+            .strided(1, Some(9), 3)
+            .map(|f| first_x(&f.unwrap()))
+            .collect();
+        assert_eq!(got, expected);
+
+        let dir = tempfile::tempdir().expect("tempdir");
+        let path = dir.path().join("numbered.con");
+        std::fs::write(&path, &text).unwrap();
+        let xs = |v: Vec<types::ConFrame>| v.iter().map(first_x).collect::<Vec<_>>();
+        assert_eq!(xs(read_frames_strided(&path, 1, Some(9), 3).unwrap()), expected);
+        crate::offset_index::FrameOffsetIndex::open_or_build(&path).unwrap();
+        assert_eq!(xs(read_frames_strided(&path, 1, Some(9), 3).unwrap()), expected);
+        assert_eq!(xs(read_frames_strided(&path, 8, None, 5).unwrap()), vec![8]);
+        assert!(read_frames_strided(&path, 0, None, 0).is_err());
+    }
+}
+
+#[cfg(test)]
+mod projection_tests {
+    use super::*;
+    use std::path::PathBuf;
+
+    fn fixture(name: &str) -> String {
+        let p = PathBuf::from(env!("CARGO_MANIFEST_DIR")).join("resources/test").join(name);
+        std::fs::read_to_string(p).expect("fixture")
+    }
+
+    #[test]
+    fn header_only_projection_keeps_headers_and_frame_count() {
+        let text = fixture("tiny_multi_cuh2.con");
+        let full: Vec<_> = ConFrameIterator::new(&text).map(Result::unwrap).collect();
+        let lean: Vec<_> = ConFrameIterator::new(&text)
+            .with_projection(types::ColumnMask::NONE)
+            .map(Result::unwrap)
+            .collect();
+        assert_eq!(full.len(), lean.len());
+        for (a, b) in full.iter().zip(&lean) {
+            assert!(b.atom_data.is_empty());
+            assert_eq!(a.header.natms_per_type, b.header.natms_per_type);
+            assert_eq!(a.header.boxl, b.header.boxl);
+            assert!(b.header.sections.is_empty());
+        }
+    }
+
+    #[test]
+    fn forces_only_projection_skips_velocities() {
+        let text = fixture("tiny_cuh2_vel_forces.con");
+        let full = ConFrameIterator::new(&text).next().unwrap().unwrap();
+        let mut it = ConFrameIterator::new(&text).with_projection(types::ColumnMask::FORCES);
+        let proj = it.next().unwrap().unwrap();
+        assert!(it.next().is_none());
+        assert!(!proj.has_velocities());
+        assert!(proj.has_forces());
+        assert_eq!(proj.header.sections, vec!["forces".to_string()]);
+        assert_eq!(proj.atom_data.len(), full.atom_data.len());
+        for (a, b) in full.atom_data.iter().zip(&proj.atom_data) {
+            assert_eq!((a.x, a.y, a.z, a.atom_id), (b.x, b.y, b.z, b.atom_id));
+            assert_eq!(a.force, b.force);
+        }
+    }
+
+    #[test]
+    fn legacy_velocity_block_is_skipped() {
+        let text = fixture("tiny_multi_cuh2.convel");
+        let full: Vec<_> = ConFrameIterator::new(&text).map(Result::unwrap).collect();
+        let proj: Vec<_> = ConFrameIterator::new(&text)
+            .with_projection(types::ColumnMask::POSITIONS)
+            .map(Result::unwrap)
+            .collect();
+        assert_eq!(full.len(), proj.len());
+        for (a, b) in full.iter().zip(&proj) {
+            assert!(a.has_velocities());
+            assert!(!b.has_velocities());
+            assert_eq!(a.atom_data.len(), b.atom_data.len());
+        }
+    }
+
+    #[test]
+    fn column_mask_names() {
+        use types::ColumnMask;
+        assert_eq!(ColumnMask::from_name("forces"), Some(ColumnMask::FORCES));
+        assert_eq!(ColumnMask::from_name("positions"), Some(ColumnMask::POSITIONS));
+        assert_eq!(ColumnMask::from_name("bogus"), None);
+        assert!(ColumnMask::default().contains(ColumnMask::MAGMOMS));
+        assert!(ColumnMask::NONE.is_header_only());
+    }
+}
+
+#[cfg(all(test, feature = "parallel"))]
+mod intra_frame_parallel_tests {
+    use super::*;
+
+    /// One frame with two components of `n` atoms each plus velocity and
+    /// force sections, large enough to cross [`INTRA_FRAME_PARALLEL_ROWS`].
+    fn big_frame(n: usize) -> String {
+        let mut s = String::from(
+            "Random Number Seed\n\
+             {\"con_spec_version\":2,\"sections\":[\"velocities\",\"forces\"]}\n\
+             100.0 100.0 100.0\n90.0 90.0 90.0\n0 0\n218 0 1\n2\n",
+        );
+        s.push_str(&format!("{n} {n}\n63.546 1.008\n"));
+        for (label, scale) in [("Coordinates", 1.0), ("Velocities", 0.5), ("Forces", -0.25)] {
+            if label != "Coordinates" {
+                s.push('\n');
+            }
+            for (c, sym) in ["Cu", "H"].iter().enumerate() {
+                s.push_str(&format!("{sym}\n{label} of Component {}\n", c + 1));
+                for i in 0..n {
+                    let id = c * n + i;
+                    let x = scale * id as f64 * 0.001;
+                    let (y, z, fixed) = (x + 1.0, x - 1.0, id % 2);
+                    s.push_str(&format!("{x:.6} {y:.6} {z:.6} {fixed} {id}\r\n"));
+                }
+            }
+        }
+        s
+    }
+
+    #[test]
+    fn intra_frame_parse_matches_sequential() {
+        let text = big_frame(INTRA_FRAME_PARALLEL_ROWS + 17);
+        let seq: Vec<_> = ConFrameIterator::new(&text).map(|f| f.unwrap()).collect();
+        let par: Vec<_> = ConFrameIterator::new(&text)
+            .with_intra_frame_parallel()
+            .map(|f| f.unwrap())
+            .collect();
+        assert_eq!(seq.len(), 1);
+        assert_eq!(par, seq);
+        assert!(par[0].has_velocities() && par[0].has_forces());
+    }
+
+    #[test]
+    fn intra_frame_parse_reports_the_first_bad_row() {
+        let mut text = big_frame(INTRA_FRAME_PARALLEL_ROWS);
+        // Corrupt a row in the second component block.
+        let at = text.rfind("Coordinates of Component 2").unwrap();
+        let row = at + text[at..].find('\n').unwrap() + 1;
+        text.replace_range(row..row + 3, "abc");
+        let seq = ConFrameIterator::new(&text).next().unwrap().unwrap_err();
+        let par = ConFrameIterator::new(&text)
+            .with_intra_frame_parallel()
+            .next()
+            .unwrap()
+            .unwrap_err();
+        assert_eq!(par.to_string(), seq.to_string());
+
+        // Truncation inside a block falls back to the line path and errors alike.
+        let short = &text[..text.len() / 3];
+        let seq = ConFrameIterator::new(short).next().unwrap().is_err();
+        let par = ConFrameIterator::new(short).with_intra_frame_parallel().next().unwrap().is_err();
+        assert!(seq && par);
+    }
 }
@@ -0,0 +1,424 @@
+//! SoA-only frame representation.
+//!
+//! [`crate::types::ConFrame`] keeps every coordinate twice: once in the SoA
+//! blocks and once in its `atom_data: Vec<AtomDatum>` projection, each entry
+//! carrying an `Arc<str>` symbol and six optional section slots. A
+//! [`LeanFrame`] holds only the SoA blocks, a per-component symbol table
+//! (run-length encoded by `header.natms_per_type`) and one `[bool; 3]` fixed
+//! mask per atom. [`AtomDatum`] values are derived on demand.
+//!
+//! Parse with [`crate::parser::parse_single_frame_lean`],
+//! [`crate::iterators::ConFrameIterator::next_lean`] or
+//! [`crate::iterators::read_all_frames_lean`]; write with
+//! [`crate::writer::ConFrameWriter::write_lean_frame`].
+
+use crate::parser::{ScalarSection, SectionTarget, VectorSection};
+use crate::storage_dtype::{FloatArray1, FloatArray2, StorageDtypes};
+use crate::types::{AtomDatum, ConFrame, FrameHeader};
+use std::sync::Arc;
+
+/// A frame stored as SoA columns only; see the [module docs](self).
+///
+/// Field layout mirrors [`ConFrame`] minus `atom_data`: absent sections are
+/// `(0, 3)` / `(0,)` blocks, and atoms are in type-grouped file order.
+#[derive(Debug, Clone, PartialEq)]
+pub struct LeanFrame {
+    pub header: FrameHeader,
+    /// One symbol per component; component `k` covers the next
+    /// `header.natms_per_type[k]` atoms.
+    pub symbols: Vec<Arc<str>>,
+    /// Per-atom fixed flags `(N,)`.
+    pub fixed: Vec<[bool; 3]>,
+    /// Positions `(N, 3)` in the storage dtype.
+    pub positions: FloatArray2,
+    /// Velocities `(N, 3)` when present; else `(0, 3)`.
+    pub velocities: FloatArray2,
+    /// Forces `(N, 3)` when present; else `(0, 3)`.
+    pub forces: FloatArray2,
+    /// Per-atom energies `(N,)` when present; else `(0,)`.
+    pub atom_energies: FloatArray1,
+    /// Per-atom charges `(N,)` when present; else `(0,)`.
+    pub charges: FloatArray1,
+    /// Per-atom spins `(N,)` when present; else `(0,)`.
+    pub spins: FloatArray1,
+    /// Magnetic moments `(N, 3)` when present; else `(0, 3)`.
+    pub magmoms: FloatArray2,
+    /// Per-atom masses `(N,)`.
+    pub masses: FloatArray1,
+    /// Per-atom ids `(N,)`.
+    pub atom_ids: ndarray::ArcArray1<u64>,
+}
+
+impl LeanFrame {
+    /// Number of atoms.
+    pub fn len(&self) -> usize {
+        self.fixed.len()
+    }
+
+    pub fn is_empty(&self) -> bool {
+        self.fixed.is_empty()
+    }
+
+    pub fn has_velocities(&self) -> bool {
+        self.velocities.nrows() > 0
+    }
+
+    pub fn has_forces(&self) -> bool {
+        self.forces.nrows() > 0
+    }
+
+    pub fn has_energies(&self) -> bool {
+        self.atom_energies.len() > 0
+    }
+
+    pub fn has_charges(&self) -> bool {
+        self.charges.len() > 0
+    }
+
+    pub fn has_spins(&self) -> bool {
+        self.spins.len() > 0
+    }
+
+    pub fn has_magmoms(&self) -> bool {
+        self.magmoms.nrows() > 0
+    }
+
+    /// Component index of atom `atom_idx` (O(number of components)).
+    pub fn component_of(&self, atom_idx: usize) -> Option<usize> {
+        component_of(&self.header.natms_per_type, atom_idx)
+    }
+
+    /// Symbol of atom `atom_idx`.
+    pub fn symbol(&self, atom_idx: usize) -> Option<&Arc<str>> {
+        self.component_of(atom_idx).and_then(|k| self.symbols.get(k))
+    }
+
+    /// Derives the [`AtomDatum`] view of atom `atom_idx`.
+    pub fn atom(&self, atom_idx: usize) -> Option<AtomDatum> {
+        let symbol = self.symbol(atom_idx)?;
+        Some(self.datum(atom_idx, symbol))
+    }
+
+    /// Derives every [`AtomDatum`] in order, walking the symbol table once.
+    pub fn atoms(&self) -> impl Iterator<Item = AtomDatum> + '_ {
+        let per_component = self
+            .symbols
+            .iter()
+            .zip(&self.header.natms_per_type)
+            .flat_map(|(symbol, &count)| std::iter::repeat_n(symbol, count));
+        per_component
+            .take(self.len())
+            .enumerate()
+            .map(|(i, symbol)| self.datum(i, symbol))
+    }
+
+    fn datum(&self, i: usize, symbol: &Arc<str>) -> AtomDatum {
+        let p = self.positions.as_f64_row(i);
+        AtomDatum {
+            symbol: Arc::clone(symbol),
+            x: p[0],
+            y: p[1],
+            z: p[2],
+            fixed: self.fixed[i],
+            atom_id: self.atom_ids[i],
+            velocity: self.has_velocities().then(|| self.velocities.as_f64_row(i)),
+            force: self.has_forces().then(|| self.forces.as_f64_row(i)),
+            energy: self.has_energies().then(|| self.atom_energies.get_f64(i)),
+            charge: self.has_charges().then(|| self.charges.get_f64(i)),
+            spin: self.has_spins().then(|| self.spins.get_f64(i)),
+            magmom: self.has_magmoms().then(|| self.magmoms.as_f64_row(i)),
+        }
+    }
+
+    /// Materializes the `atom_data` projection and returns the equivalent
+    /// [`ConFrame`]. SoA blocks are moved, not copied.
+    pub fn into_con_frame(self) -> ConFrame {
+        let atom_data = self.atoms().collect();
+        ConFrame {
+            header: self.header,
+            atom_data,
+            positions: self.positions,
+            velocities: self.velocities,
+            forces: self.forces,
+            atom_energies: self.atom_energies,
+            charges: self.charges,
+            spins: self.spins,
+            magmoms: self.magmoms,
+            masses: self.masses,
+            atom_ids: self.atom_ids,
+        }
+    }
+}
+
+impl From<&ConFrame> for LeanFrame {
+    /// Drops the `atom_data` projection; SoA blocks share their buffers.
+    fn from(frame: &ConFrame) -> Self {
+        let mut symbols = Vec::with_capacity(frame.header.natms_per_type.len());
+        let mut start = 0usize;
+        for &count in &frame.header.natms_per_type {
+            let symbol = frame
+                .atom_data
+                .get(start)
+                .map_or_else(|| Arc::from(""), |atom| Arc::clone(&atom.symbol));
+            symbols.push(symbol);
+            start += count;
+        }
+        Self {
+            header: frame.header.clone(),
+            symbols,
+            fixed: frame.atom_data.iter().map(|atom| atom.fixed).collect(),
+            positions: frame.positions.clone(),
+            velocities: frame.velocities.clone(),
+            forces: frame.forces.clone(),
+            atom_energies: frame.atom_energies.clone(),
+            charges: frame.charges.clone(),
+            spins: frame.spins.clone(),
+            magmoms: frame.magmoms.clone(),
+            masses: frame.masses.clone(),
+            atom_ids: frame.atom_ids.clone(),
+        }
+    }
+}
+
+impl From<LeanFrame> for ConFrame {
+    fn from(frame: LeanFrame) -> Self {
+        frame.into_con_frame()
+    }
+}
+
+pub(crate) fn component_of(natms_per_type: &[usize], atom_idx: usize) -> Option<usize> {
+    let mut end = 0usize;
+    natms_per_type.iter().position(|&count| {
+        end += count;
+        atom_idx < end
+    })
+}
+
+/// Parse-time columns behind [`LeanFrame`]: coordinate identity for section
+/// validation plus flat f64 section buffers, allocated when a section first
+/// stores a row.
+pub(crate) struct LeanColumns {
+    natms_per_type: Vec<usize>,
+    symbols: Vec<Arc<str>>,
+    fixed: Vec<[bool; 3]>,
+    atom_ids: Vec<u64>,
+    velocities: Option<Vec<f64>>,
+    forces: Option<Vec<f64>>,
+    magmoms: Option<Vec<f64>>,
+    energies: Option<Vec<f64>>,
+    charges: Option<Vec<f64>>,
+    spins: Option<Vec<f64>>,
+}
+
+impl LeanColumns {
+    pub(crate) fn new(
+        natms_per_type: &[usize],
+        symbols: Vec<Arc<str>>,
+        fixed: Vec<[bool; 3]>,
+        atom_ids: Vec<u64>,
+    ) -> Self {
+        Self {
+            natms_per_type: natms_per_type.to_vec(),
+            symbols,
+            fixed,
+            atom_ids,
+            velocities: None,
+            forces: None,
+            magmoms: None,
+            energies: None,
+            charges: None,
+            spins: None,
+        }
+    }
+
+    /// Assembles the frame; section buffers are projected to the storage
+    /// dtypes named in the metadata, as [`ConFrame`] assembly does.
+    pub(crate) fn finish(self, header: FrameHeader, positions: FloatArray2) -> LeanFrame {
+        let n = self.fixed.len();
+        debug_assert_eq!(positions.nrows(), n);
+        let dt = StorageDtypes::from_metadata(&header.metadata).unwrap_or_default();
+        let block2 = |data: Option<Vec<f64>>, kind| match data {
+            Some(flat) => {
+                let mut block = FloatArray2::from_f64_row_major(n, 3, flat);
+                block.project_to(kind);
+                block
+            }
+            None => FloatArray2::zeros(kind, 0, 3),
+        };
+        let block1 = |data: Option<Vec<f64>>, kind| match data {
+            Some(flat) => {
+                let mut block = FloatArray1::from_f64_vec(flat);
+                block.project_to(kind);
+                block
+            }
+            None => FloatArray1::zeros(kind, 0),
+        };
+        let mut mass_flat = vec![0.0f64; n];
+        let mut off = 0usize;
+        for (ti, &count) in header.natms_per_type.iter().enumerate() {
+            let m = header.masses_per_type.get(ti).copied().unwrap_or(0.0);
+            let end = (off + count).min(n);
+            mass_flat[off..end].fill(m);
+            off = end;
+        }
+        let mut header = header;
+        if dt != StorageDtypes::all_f64() {
+            dt.insert_into(&mut header.metadata);
+        }
+        LeanFrame {
+            header,
+            symbols: self.symbols,
+            fixed: self.fixed,
+            positions,
+            velocities: block2(self.velocities, dt.velocities),
+            forces: block2(self.forces, dt.forces),
+            atom_energies: block1(self.energies, dt.energies),
+            charges: block1(self.charges, dt.energies),
+            spins: block1(self.spins, dt.energies),
+            magmoms: block2(self.magmoms, dt.forces),
+            masses: block1(Some(mass_flat), dt.masses),
+            atom_ids: ndarray::Array1::from(self.atom_ids).into_shared(),
+        }
+    }
+}
+
+impl SectionTarget for LeanColumns {
+    fn atom_symbol(&self, atom_idx: usize) -> Option<&str> {
+        if atom_idx >= self.fixed.len() {
+            return None;
+        }
+        component_of(&self.natms_per_type, atom_idx)
+            .and_then(|k| self.symbols.get(k))
+            .map(|symbol| symbol.as_ref())
+    }
+
+    fn atom_identity(&self, atom_idx: usize) -> Option<([bool; 3], u64)> {
+        Some((*self.fixed.get(atom_idx)?, *self.atom_ids.get(atom_idx)?))
+    }
+
+    fn set_vector(&mut self, section: VectorSection, atom_idx: usize, value: [f64; 3]) {
+        let n = self.fixed.len();
+        if atom_idx >= n {
+            return;
+        }
+        let slot = match section {
+            VectorSection::Velocities => &mut self.velocities,
+            VectorSection::Forces => &mut self.forces,
+            VectorSection::Magmoms => &mut self.magmoms,
+        };
+        let buf = slot.get_or_insert_with(|| vec![0.0; n * 3]);
+        buf[atom_idx * 3..atom_idx * 3 + 3].copy_from_slice(&value);
+    }
+
+    fn set_scalar(&mut self, section: ScalarSection, atom_idx: usize, value: f64) {
+        let n = self.fixed.len();
+        if atom_idx >= n {
+            return;
+        }
+        let slot = match section {
+            ScalarSection::Energies => &mut self.energies,
+            ScalarSection::Charges => &mut self.charges,
+            ScalarSection::Spins => &mut self.spins,
+        };
+        slot.get_or_insert_with(|| vec![0.0; n])[atom_idx] = value;
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use crate::iterators::{read_all_frames, read_all_frames_lean, ConFrameIterator};
+    use crate::writer::ConFrameWriter;
+    use std::path::PathBuf;
+
+    const FIXTURES: [&str; 5] = [
+        "tiny_cuh2.con",
+        "tiny_multi_cuh2.convel",
+        "tiny_cuh2_forces.con",
+        "tiny_cuh2_vel_forces.con",
+        "tiny_cuh2_charges_spins_magmoms.con",
+    ];
+
+    fn fixture(name: &str) -> PathBuf {
+        PathBuf::from(env!("CARGO_MANIFEST_DIR"))
+            .join("resources/test")
+            .join(name)
+    }
+
+    #[test]
+    fn lean_parse_matches_full_parse() {
+        for name in FIXTURES {
+            let full = read_all_frames(&fixture(name)).unwrap();
+            let lean = read_all_frames_lean(&fixture(name)).unwrap();
+            assert_eq!(full.len(), lean.len(), "{name}");
+            for (f, l) in full.iter().zip(&lean) {
+                assert_eq!(l.len(), f.atom_data.len(), "{name}");
+                assert_eq!(LeanFrame::from(f), *l, "{name}");
+                assert_eq!(l.atoms().collect::<Vec<_>>(), f.atom_data, "{name}");
+                assert_eq!(l.clone().into_con_frame(), *f, "{name}");
+            }
+        }
+    }
+
+    #[test]
+    fn lean_write_is_byte_identical() {
+        for name in FIXTURES {
+            let full = read_all_frames(&fixture(name)).unwrap();
+            let lean = read_all_frames_lean(&fixture(name)).unwrap();
+            let (mut a, mut b) = (Vec::new(), Vec::new());
+            let (idx_a, idx_b) = {
+                let mut wa = ConFrameWriter::new(&mut a).with_offset_index();
+                let mut wb = ConFrameWriter::new(&mut b).with_offset_index();
+                wa.extend(full.iter()).unwrap();
+                for frame in &lean {
+                    wb.write_lean_frame(frame).unwrap();
+                }
+                wa.flush().unwrap();
+                wb.flush().unwrap();
+                (wa.take_offset_index().unwrap(), wb.take_offset_index().unwrap())
+            };
+            assert_eq!(a, b, "{name}");
+            assert_eq!(format!("{idx_a:?}"), format!("{idx_b:?}"), "{name}");
+        }
+    }
+
+    #[test]
+    fn next_lean_interleaves_with_next() {
+        let text = std::fs::read_to_string(fixture("tiny_multi_cuh2.convel")).unwrap();
+        let mut it = ConFrameIterator::new(&text);
+        let first = it.next_lean().unwrap().unwrap();
+        let second = it.next().unwrap().unwrap();
+        assert_eq!(it.next_frame_index(), 2);
+        assert_eq!(first.symbol(0).map(|s| s.as_ref()), Some("Cu"));
+        assert_eq!(first.atom(first.len() - 1).unwrap().symbol.as_ref(), "H");
+        assert!(first.atom(first.len()).is_none());
+        assert_eq!(second.atom_data.len(), first.len());
+    }
+
+    #[test]
+    fn lean_strict_mode_validates_section_identity() {
+        let text = std::fs::read_to_string(fixture("tiny_cuh2_vel_forces.con")).unwrap();
+        let mut frame = ConFrameIterator::new(&text).next_lean().unwrap().unwrap();
+        frame
+            .header
+            .metadata
+            .insert("validate".into(), serde_json::Value::Bool(true));
+        let mut buf = Vec::new();
+        {
+            let mut w = ConFrameWriter::new(&mut buf);
+            w.write_lean_frame(&frame).unwrap();
+            w.flush().unwrap();
+        }
+        let strict = String::from_utf8(buf).unwrap();
+        let lean = ConFrameIterator::new(&strict).next_lean().unwrap().unwrap();
+        let full = ConFrameIterator::new(&strict).next().unwrap().unwrap();
+        assert_eq!(lean.into_con_frame(), full);
+
+        // Last force row: point its atom_id at another atom.
+        let (head, last) = strict.trim_end().rsplit_once(' ').unwrap();
+        let bad = format!("{head} {}\n", last.parse::<u64>().unwrap() + 100);
+        let err = ConFrameIterator::new(&bad).next_lean().unwrap().unwrap_err();
+        assert!(err.to_string().contains("atom_id mismatch"), "{err}");
+        assert!(ConFrameIterator::new(&bad).next().unwrap().is_err());
+    }
+}
@@ -1,16 +1,40 @@
 pub mod array;
+/// Memory-mapped `.conb` binary trajectory cache (columnar frames, zero-copy views).
+pub mod binary_cache;
 #[cfg(feature = "cuda")]
 pub mod cuda_array;
 pub mod compression;
 pub mod error;
+/// Tail/follow iterator over a `.con` file that is still being appended to.
+pub mod follow;
 pub mod ffi;
 pub mod helpers;
 /// Campaign screening scalars / CON ingest contracts for corpus stores (`readcon-db`).
 pub mod index_proj;
 pub mod iterators;
+/// SoA-only [`lean::LeanFrame`] parse / write path (no `AtomDatum` vector).
+pub mod lean;
+/// Persistent `.con.idx` frame offset sidecar for O(1) random frame access.
+pub mod offset_index;
+/// Bounded background worker stage shared by the pipelined readers.
+pub(crate) mod pipeline;
+/// Span-indexed in-memory trajectory with a bounded background frame prefetcher.
+pub mod prefetch;
+/// Order-preserving multi-frame writer with per-chunk parallel formatting and compression.
+pub mod parallel_writer;
+/// Chunked frame iterator over `BufRead` for compressed or unbounded inputs.
+pub mod streaming;
 pub mod parser;
+/// Energy / fmax / composition frame queries answered from the offset index or a projected scan.
+pub mod query;
+/// Bitmask block decoder for coordinate rows (runtime-dispatched SIMD).
+pub mod scan;
+/// Opt-in per-stage timing counters (`stats` feature; zero-cost stubs otherwise).
+pub mod stats;
 #[cfg(feature = "grammar")]
 pub mod grammar;
+/// Frame ranges parsed into one `(n_frames, n_atoms, 3)` buffer per field.
+pub mod trajectory_tensor;
 pub mod types;
 pub mod storage_dtype;
 pub mod units;
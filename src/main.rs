@@ -3,6 +3,8 @@
 //! ```text
 //! readcon-core <input.con> [output.con]           # inspect / optional CON write
 //! readcon-core convert <input> <output.con>       # CON or chemfiles format → CON
+//! readcon-core index <input.con>                  # write <input.con>.idx offset sidecar
+//! readcon-core cache <input.con>                  # write <input.con>.conb binary cache
 //! readcon-core --help
 //! ```
 //!
@@ -12,8 +14,10 @@ use std::env;
 use std::path::Path;
 use std::process;
 
+use readcon_core::binary_cache::{ConbFile, cache_path};
 use readcon_core::convert::{convert_path_to_con, path_looks_like_con};
 use readcon_core::iterators::ConFrameIterator;
+use readcon_core::offset_index::{FrameOffsetIndex, sidecar_path};
 use readcon_core::types::ConFrame;
 use readcon_core::writer::ConFrameWriter;
 use readcon_core::{CON_SPEC_VERSION, VERSION};
@@ -30,6 +34,18 @@ Usage:
       Convert a structure or trajectory into CON.
       - .con / .convel (and .gz/.zst): native reader
       - other formats (XYZ, PDB, GRO, …): requires --features chemfiles
+      - an output (or input) ending in .conb is the binary cache format
+      Frames are streamed (bounded memory); throughput is reported at the end.
+
+  {argv0} index <input.con>
+      Write <input.con>.idx (frame offsets, natoms, energy, fmax) so that
+      read_frame / count_frames skip the linear scan on later opens.
+      Uncompressed input only.
+
+  {argv0} cache <input.con>
+      Write <input.con>.conb, a memory-mappable columnar copy of every frame
+      that later reads decode without the text parser. Compressed input is
+      fine; the cache is rebuilt by readers once the source changes.
 
 Why CON: per-direction constraints, atom_id, optional sections (forces,
 velocities, charges, …), multi-language hourglass ABI, campaign-storeable text.
@@ -50,7 +66,7 @@ fn main() {
     }
     if args[1] == "convert" {
         if args.len() != 4 {
-            eprintln!("Usage: {} convert <input> <output.con>", args[0]);
+            eprintln!("Usage: {} convert <input> <output.con|output.conb>", args[0]);
             process::exit(2);
         }
         let input = Path::new(&args[2]);
@@ -68,6 +84,13 @@ fn main() {
                     report.n_atoms_last,
                     output.display()
                 );
+                println!(
+                    "-> throughput: {:.1} frame/s, {:.1} MB/s read, {:.1} MB/s written ({:.2} s)",
+                    report.frames_per_second(),
+                    report.read_bytes_per_second() / 1e6,
+                    report.write_bytes_per_second() / 1e6,
+                    report.elapsed.as_secs_f64()
+                );
                 if !report.native_con && !path_looks_like_con(input) {
                     println!(
                         "-> tip: keep this .con as the interchange file; link C/Fortran/Python via rkr_* / readcon"
@@ -82,6 +105,56 @@ fn main() {
         return;
     }
 
+    if args[1] == "index" {
+        if args.len() != 3 {
+            eprintln!("Usage: {} index <input.con>", args[0]);
+            process::exit(2);
+        }
+        let input = Path::new(&args[2]);
+        let index = match FrameOffsetIndex::build_for_path(input) {
+            Ok(index) => index,
+            Err(e) => {
+                eprintln!("Error: {e}");
+                process::exit(1);
+            }
+        };
+        if let Err(e) = index.write_sidecar(input) {
+            eprintln!("Error writing index: {e}");
+            process::exit(1);
+        }
+        println!(
+            "-> index: {} frame(s), {} distinct formula(s) → {}",
+            index.len(),
+            index.formulas.len(),
+            sidecar_path(input).display()
+        );
+        return;
+    }
+
+    if args[1] == "cache" {
+        if args.len() != 3 {
+            eprintln!("Usage: {} cache <input.con>", args[0]);
+            process::exit(2);
+        }
+        let input = Path::new(&args[2]);
+        let cache = match ConbFile::build_for_path(input)
+            .and_then(|()| Ok(ConbFile::open(cache_path(input))?))
+        {
+            Ok(cache) => cache,
+            Err(e) => {
+                eprintln!("Error: {e}");
+                process::exit(1);
+            }
+        };
+        println!(
+            "-> cache: {} frame(s), {} distinct formula(s) → {}",
+            cache.len(),
+            cache.formulas.len(),
+            cache_path(input).display()
+        );
+        return;
+    }
+
     // Legacy: inspect / optional rewrite
     if args.len() > 3 {
         usage(&args[0]);
@@ -5,10 +5,13 @@
 //! and columns are properties (`x`, `y`, `z` for vector quantities or
 //! a single column for scalars).
 //!
-//! Users that want a `TensorMap` keyed by species can build one on top
-//! of these blocks; the choice of "per-species block" vs "single block
-//! with `species` as a sample column" is user-specific, so we expose
-//! the building blocks rather than baking in one convention.
+//! For training batches, [`trajectory_tensor_map`] exports a whole frame
+//! range as one `TensorMap` keyed by `quantity` or by `species` (atomic
+//! number), with `(system, atom)` samples. Values come from the batched
+//! parse of [`crate::trajectory_tensor`], so no per-frame block or `Labels`
+//! is built, and all blocks share one `xyz` properties `Labels`. Other
+//! layouts (say `species` as a sample column) can still be assembled from
+//! the per-frame blocks below.
 //!
 //! ## C ABI ownership (option A)
 //!
@@ -18,11 +21,13 @@
 //! [`tensor_block_into_raw_mts`] / [`mts_block_free_sys`] so callers never
 //! ad-hoc transmute and never double-free with Rust `Drop`.
 
+use crate::trajectory_tensor::{BatchKeys, TrajectoryTensors};
 use crate::types::ConFrame;
-use metatensor::c_api::{self as mts_sys, mts_block_t};
-use metatensor::{Labels, LabelsBuilder, TensorBlock};
+use metatensor::c_api::{self as mts_sys, mts_block_t, mts_tensormap_t};
+use metatensor::{Labels, LabelsBuilder, TensorBlock, TensorMap};
 use ndarray::Array2;
 use std::mem::ManuallyDrop;
+use std::path::Path;
 
 /// Pin: `metatensor` 0.3.0-rc2 `TensorBlock` is `#[repr(transparent)]` over
 /// `*mut mts_block_t` (see upstream `block/owned.rs`). No public `into_raw`
@@ -52,6 +57,64 @@ pub unsafe fn mts_block_free_sys(block: *mut mts_block_t) {
     }
 }
 
+/// Free an owned `mts_tensormap_t*` from [`TensorMap::into_raw`]. Null-safe.
+pub unsafe fn mts_tensormap_free_sys(map: *mut mts_tensormap_t) {
+    if !map.is_null() {
+        let _ = unsafe { mts_sys::mts_tensormap_free(map) };
+    }
+}
+
+/// Builds one `TensorMap` from a batch: one `[n_samples, 3]` block per
+/// key of [`TrajectoryTensors::into_keyed_blocks`], under a `quantity`
+/// key (0 positions, 1 forces) or a `species` key (atomic number).
+/// Samples are `(system, atom)`: the frame's index in the file and the
+/// atom's index in the frame. Properties are `xyz`, as for the per-frame
+/// blocks.
+pub fn trajectory_tensor_map(
+    batch: TrajectoryTensors,
+    keys: BatchKeys,
+) -> Result<TensorMap, Box<dyn std::error::Error>> {
+    let key_name = match keys {
+        BatchKeys::Quantity => "quantity",
+        BatchKeys::Species(_) => "species",
+    };
+    let properties = build_xyz_properties()?;
+    let mut key_labels = LabelsBuilder::new(vec![key_name]);
+    let mut blocks = Vec::new();
+    for block in batch.into_keyed_blocks(keys)? {
+        key_labels.add(&[block.key]);
+        let mut samples = LabelsBuilder::new(vec!["system", "atom"]);
+        for sample in &block.samples {
+            samples.add(&sample[..]);
+        }
+        let values = Array2::from_shape_vec((block.samples.len(), 3), block.values)
+            .expect("array shape mismatch when building trajectory block")
+            .into_dyn();
+        blocks.push(TensorBlock::new(values, &samples.finish(), &[], &properties)?);
+    }
+    Ok(TensorMap::new(key_labels.finish(), blocks)?)
+}
+
+/// Reads frames `start, start + step, …` before `stop` as float64 and
+/// exports them with [`trajectory_tensor_map`]. The frame-range rules are
+/// those of [`crate::trajectory_tensor::read_trajectory_tensors`].
+pub fn read_trajectory_tensor_map(
+    path: &Path,
+    start: usize,
+    stop: Option<usize>,
+    step: usize,
+    keys: BatchKeys,
+) -> Result<TensorMap, Box<dyn std::error::Error>> {
+    let batch = crate::trajectory_tensor::read_trajectory_tensors(
+        path,
+        start,
+        stop,
+        step,
+        &crate::storage_dtype::StorageDtypes::default(),
+    )?;
+    trajectory_tensor_map(batch, keys)
+}
+
 /// Builds a `TensorBlock` with shape `[N, 3]` carrying the per-atom
 /// xyz coordinates from `frame`. Samples are labelled `atom_id` (the
 /// post-grouping index from the file's column 5), properties are
@@ -250,6 +313,26 @@ mod tests {
         assert!(frame_energies_block(&frame).unwrap().is_none());
     }
 
+    #[test]
+    fn trajectory_map_keys_by_species_and_quantity() {
+        use crate::trajectory_tensor::BatchQuantity;
+        let path = std::path::PathBuf::from(env!("CARGO_MANIFEST_DIR"))
+            .join("resources/test/tiny_multi_cuh2.con");
+        let map = read_trajectory_tensor_map(&path, 0, None, 1, BatchKeys::Quantity).unwrap();
+        assert_eq!(map.keys().count(), 1); // no forces section
+        let positions = map.block_by_id(0);
+        assert_eq!(positions.samples().count(), 8); // 2 frames x 4 atoms
+        assert_eq!(positions.properties().count(), 3);
+
+        let keys = BatchKeys::Species(BatchQuantity::Positions);
+        let map = read_trajectory_tensor_map(&path, 1, None, 1, keys).unwrap();
+        assert_eq!(map.keys().count(), 2); // H, Cu
+        let total: usize = (0..2).map(|i| map.block_by_id(i).samples().count()).sum();
+        assert_eq!(total, 4);
+        let forces = BatchKeys::Species(BatchQuantity::Forces);
+        assert!(read_trajectory_tensor_map(&path, 0, None, 1, forces).is_err());
+    }
+
     #[test]
     fn tensor_block_into_raw_mts_round_trip_free_via_sys() {
         let frame = small_frame();
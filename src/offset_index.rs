@@ -0,0 +1,587 @@
+//! Persistent **frame offset index** (`<file>.con.idx` sidecar) for O(1) random access.
+//!
+//! # Layout
+//! Little-endian binary, fixed-width records so frame `i` is a single seek:
+//!
+//! | bytes | field |
+//! |-------|-------|
+//! | 8     | magic `RKRCIDX\0` |
+//! | 4     | format version ([`INDEX_VERSION`]) |
+//! | 4     | record size ([`RECORD_SIZE`]) |
+//! | 8     | frame count |
+//! | 8     | source file length (bytes) |
+//! | 8 + 4 | source mtime (seconds, nanoseconds since the Unix epoch) |
+//! | 4     | formula table length |
+//! | 16    | reserved (zero) |
+//!
+//! followed by one [`RECORD_SIZE`]-byte record per frame (offset, length,
+//! natoms, energy, fmax, formula id, sections mask; absent scalars are NaN)
+//! and the formula table (`u32` length + UTF-8 bytes per entry).
+//!
+//! # Freshness
+//! A sidecar is only trusted while the source length and mtime match the
+//! stamp ([`FrameOffsetIndex::is_fresh`]); stale sidecars are ignored, never
+//! used to slice a rewritten file. Only uncompressed CON is indexed: offsets
+//! address the bytes on disk.
+//!
+//! Scalars come from [`FrameIndexProjection`], so index filters agree with
+//! campaign-store projections.
+
+use crate::index_proj::{self, FrameByteSpan, FrameIndexProjection};
+use crate::iterators::ConFrameIterator;
+use crate::lean::LeanFrame;
+use crate::types::ConFrame;
+use std::collections::HashMap;
+use std::fs::File;
+use std::io::{self, Read, Seek, SeekFrom, Write};
+use std::path::{Path, PathBuf};
+use std::time::UNIX_EPOCH;
+
+/// Sidecar magic bytes.
+pub const INDEX_MAGIC: [u8; 8] = *b"RKRCIDX\0";
+/// Sidecar format version written by this build.
+pub const INDEX_VERSION: u32 = 1;
+/// Fixed header size in bytes.
+pub const HEADER_SIZE: usize = 64;
+/// Fixed per-frame record size in bytes.
+pub const RECORD_SIZE: usize = 48;
+
+/// Sidecar path for a CON file: `traj.con` → `traj.con.idx`.
+pub fn sidecar_path(con_path: &Path) -> PathBuf {
+    let mut s = con_path.as_os_str().to_owned();
+    s.push(".idx");
+    PathBuf::from(s)
+}
+
+/// One frame's location and screening scalars.
+#[derive(Clone, Copy, Debug, PartialEq)]
+pub struct FrameIndexEntry {
+    /// Byte offset of the frame's first line in the source file.
+    pub offset: u64,
+    /// Byte length of the frame (through its last section line).
+    pub len: u64,
+    pub natoms: u64,
+    /// Finite frame energy ([`FrameIndexProjection::energy`]).
+    pub energy: Option<f64>,
+    /// Max force magnitude ([`FrameIndexProjection::fmax`]).
+    pub fmax: Option<f64>,
+    /// Index into [`FrameOffsetIndex::formulas`].
+    pub formula_id: u32,
+    /// [`crate::index_proj::sections_present_mask`] bits.
+    pub sections_mask: u8,
+}
+
+impl FrameIndexEntry {
+    /// Byte span of the frame within the source file.
+    pub fn span(&self) -> FrameByteSpan {
+        FrameByteSpan {
+            start: self.offset as usize,
+            end: (self.offset + self.len) as usize,
+        }
+    }
+
+    /// Read the frame's bytes from an open handle on the source file.
+    pub fn read_span(&self, file: &File) -> io::Result<String> {
+        let mut f = file;
+        f.seek(SeekFrom::Start(self.offset))?;
+        let mut buf = vec![0u8; self.len as usize];
+        f.read_exact(&mut buf)?;
+        String::from_utf8(buf).map_err(|_| invalid("frame bytes are not UTF-8"))
+    }
+
+    /// Parse the frame from an open handle on the source file.
+    pub fn read_frame(&self, file: &File) -> Result<ConFrame, Box<dyn std::error::Error>> {
+        let text = self.read_span(file)?;
+        match ConFrameIterator::new(&text).next() {
+            Some(Ok(frame)) => Ok(frame),
+            Some(Err(e)) => Err(Box::new(e)),
+            None => Err("indexed span is empty".into()),
+        }
+    }
+}
+
+/// Accumulates entries while scanning or writing a trajectory.
+#[derive(Debug, Default)]
+pub struct FrameIndexBuilder {
+    entries: Vec<FrameIndexEntry>,
+    formulas: Vec<String>,
+    formula_ids: HashMap<String, u32>,
+}
+
+impl FrameIndexBuilder {
+    pub fn new() -> Self {
+        Self::default()
+    }
+
+    /// Record `frame`, which occupies `len` bytes starting at `offset`.
+    pub fn push(&mut self, frame: &ConFrame, offset: u64, len: u64) {
+        let proj = FrameIndexProjection::from_frame(frame);
+        let formula_id = self.formula_id(proj.formula);
+        self.entries.push(FrameIndexEntry {
+            offset,
+            len,
+            natoms: frame.atom_data.len() as u64,
+            energy: proj.energy,
+            fmax: proj.fmax,
+            formula_id,
+            sections_mask: proj.sections_mask,
+        });
+    }
+
+    /// [`Self::push`] for a [`LeanFrame`]; records the same scalars the
+    /// equivalent [`ConFrame`] would.
+    pub fn push_lean(&mut self, frame: &LeanFrame, offset: u64, len: u64) {
+        let formula_id = self.formula_id(index_proj::lean_composition_formula(frame));
+        self.entries.push(FrameIndexEntry {
+            offset,
+            len,
+            natoms: frame.len() as u64,
+            energy: index_proj::header_finite_energy(&frame.header),
+            fmax: index_proj::lean_fmax(frame),
+            formula_id,
+            sections_mask: index_proj::lean_sections_mask(frame),
+        });
+    }
+
+    fn formula_id(&mut self, formula: String) -> u32 {
+        if let Some(&id) = self.formula_ids.get(&formula) {
+            return id;
+        }
+        let id = self.formulas.len() as u32;
+        self.formula_ids.insert(formula.clone(), id);
+        self.formulas.push(formula);
+        id
+    }
+
+    /// Number of frames recorded so far.
+    pub fn len(&self) -> usize {
+        self.entries.len()
+    }
+
+    #[must_use]
+    pub fn is_empty(&self) -> bool {
+        self.entries.is_empty()
+    }
+
+    /// Index every frame of an in-memory CON buffer (full parse per frame).
+    pub fn scan(text: &str) -> Result<Self, crate::error::ParseError> {
+        let mut builder = Self::new();
+        let base = text.as_ptr() as usize;
+        let mut it = ConFrameIterator::new(text);
+        while let Some(item) = it.next_with_raw_span(text) {
+            let (frame, span) = item?;
+            let start = span.as_ptr() as usize - base;
+            builder.push(&frame, start as u64, span.len() as u64);
+        }
+        Ok(builder)
+    }
+
+    /// Stamp with the current size / mtime of `con_path` (call after the
+    /// source is fully written and closed).
+    pub fn finish(self, con_path: &Path) -> io::Result<FrameOffsetIndex> {
+        let (source_len, source_mtime) = source_stamp(con_path)?;
+        Ok(FrameOffsetIndex {
+            entries: self.entries,
+            formulas: self.formulas,
+            source_len,
+            source_mtime,
+        })
+    }
+}
+
+/// Size and mtime (`(secs, nanos)`, zero when unsupported) of a file.
+pub(crate) fn source_stamp(path: &Path) -> io::Result<(u64, (u64, u32))> {
+    let md = std::fs::metadata(path)?;
+    let mtime = md
+        .modified()
+        .ok()
+        .and_then(|t| t.duration_since(UNIX_EPOCH).ok())
+        .map(|d| (d.as_secs(), d.subsec_nanos()))
+        .unwrap_or((0, 0));
+    Ok((md.len(), mtime))
+}
+
+fn invalid(msg: &str) -> io::Error {
+    io::Error::new(io::ErrorKind::InvalidData, format!("offset index: {msg}"))
+}
+
+fn le_u32(b: &[u8], at: usize) -> u32 {
+    u32::from_le_bytes(b[at..at + 4].try_into().expect("4 bytes"))
+}
+
+fn le_u64(b: &[u8], at: usize) -> u64 {
+    u64::from_le_bytes(b[at..at + 8].try_into().expect("8 bytes"))
+}
+
+fn opt_f64(v: f64) -> Option<f64> {
+    (!v.is_nan()).then_some(v)
+}
+
+/// Parsed header fields: (frame count, source len, mtime, formula count).
+fn parse_header(b: &[u8]) -> io::Result<(u64, u64, (u64, u32), u32)> {
+    if b.len() < HEADER_SIZE || b[..8] != INDEX_MAGIC {
+        return Err(invalid("bad magic"));
+    }
+    if le_u32(b, 8) != INDEX_VERSION {
+        return Err(invalid("unsupported version"));
+    }
+    if le_u32(b, 12) as usize != RECORD_SIZE {
+        return Err(invalid("unexpected record size"));
+    }
+    Ok((
+        le_u64(b, 16),
+        le_u64(b, 24),
+        (le_u64(b, 32), le_u32(b, 40)),
+        le_u32(b, 44),
+    ))
+}
+
+/// Decode one [`RECORD_SIZE`]-byte record.
+fn parse_record(rec: &[u8]) -> FrameIndexEntry {
+    FrameIndexEntry {
+        offset: le_u64(rec, 0),
+        len: le_u64(rec, 8),
+        natoms: le_u64(rec, 16),
+        energy: opt_f64(f64::from_bits(le_u64(rec, 24))),
+        fmax: opt_f64(f64::from_bits(le_u64(rec, 32))),
+        formula_id: le_u32(rec, 40),
+        sections_mask: rec[44],
+    }
+}
+
+/// Frame offsets plus screening scalars for one CON file.
+#[derive(Clone, Debug, PartialEq)]
+pub struct FrameOffsetIndex {
+    pub entries: Vec<FrameIndexEntry>,
+    /// Distinct composition formulas ([`crate::index_proj::composition_formula`]).
+    pub formulas: Vec<String>,
+    /// Source file length at stamp time.
+    pub source_len: u64,
+    /// Source mtime at stamp time, `(secs, nanos)` since the Unix epoch.
+    pub source_mtime: (u64, u32),
+}
+
+impl FrameOffsetIndex {
+    /// Scan an uncompressed CON file and stamp the result (does not write
+    /// the sidecar; see [`Self::write_sidecar`] / [`Self::open_or_build`]).
+    pub fn build_for_path(con_path: &Path) -> Result<Self, Box<dyn std::error::Error>> {
+        if crate::compression::detect_path_compression(con_path)?
+            != crate::compression::Compression::None
+        {
+            return Err("offset index requires an uncompressed CON file".into());
+        }
+        let contents = crate::compression::read_file_contents(con_path)?;
+        let builder = FrameIndexBuilder::scan(contents.as_str()?)?;
+        Ok(builder.finish(con_path)?)
+    }
+
+    /// Number of indexed frames.
+    pub fn len(&self) -> usize {
+        self.entries.len()
+    }
+
+    #[must_use]
+    pub fn is_empty(&self) -> bool {
+        self.entries.is_empty()
+    }
+
+    /// Composition formula of entry `i`, or `None` past the end.
+    pub fn formula(&self, i: usize) -> Option<&str> {
+        let e = self.entries.get(i)?;
+        self.formulas.get(e.formula_id as usize).map(String::as_str)
+    }
+
+    /// True when `con_path` still has the stamped length and mtime.
+    pub fn is_fresh(&self, con_path: &Path) -> bool {
+        matches!(source_stamp(con_path), Ok(s) if s == (self.source_len, self.source_mtime))
+    }
+
+    /// Serialize to the sidecar byte layout.
+    pub fn to_bytes(&self) -> Vec<u8> {
+        let mut out = Vec::with_capacity(HEADER_SIZE + self.entries.len() * RECORD_SIZE);
+        out.extend_from_slice(&INDEX_MAGIC);
+        out.extend_from_slice(&INDEX_VERSION.to_le_bytes());
+        out.extend_from_slice(&(RECORD_SIZE as u32).to_le_bytes());
+        out.extend_from_slice(&(self.entries.len() as u64).to_le_bytes());
+        out.extend_from_slice(&self.source_len.to_le_bytes());
+        out.extend_from_slice(&self.source_mtime.0.to_le_bytes());
+        out.extend_from_slice(&self.source_mtime.1.to_le_bytes());
+        out.extend_from_slice(&(self.formulas.len() as u32).to_le_bytes());
+        out.extend_from_slice(&[0u8; 16]);
+        debug_assert_eq!(out.len(), HEADER_SIZE);
+        for e in &self.entries {
+            out.extend_from_slice(&e.offset.to_le_bytes());
+            out.extend_from_slice(&e.len.to_le_bytes());
+            out.extend_from_slice(&e.natoms.to_le_bytes());
+            out.extend_from_slice(&e.energy.unwrap_or(f64::NAN).to_le_bytes());
+            out.extend_from_slice(&e.fmax.unwrap_or(f64::NAN).to_le_bytes());
+            out.extend_from_slice(&e.formula_id.to_le_bytes());
+            out.push(e.sections_mask);
+            out.extend_from_slice(&[0u8; 3]);
+        }
+        for f in &self.formulas {
+            out.extend_from_slice(&(f.len() as u32).to_le_bytes());
+            out.extend_from_slice(f.as_bytes());
+        }
+        out
+    }
+
+    /// Parse the sidecar byte layout.
+    pub fn from_bytes(b: &[u8]) -> io::Result<Self> {
+        let (n, source_len, source_mtime, n_formulas) = parse_header(b)?;
+        let n = n as usize;
+        let records_end = n
+            .checked_mul(RECORD_SIZE)
+            .and_then(|r| r.checked_add(HEADER_SIZE))
+            .filter(|&end| end <= b.len())
+            .ok_or_else(|| invalid("truncated records"))?;
+        let entries = b[HEADER_SIZE..records_end]
+            .chunks_exact(RECORD_SIZE)
+            .map(parse_record)
+            .collect();
+        let mut formulas = Vec::with_capacity(n_formulas as usize);
+        let mut at = records_end;
+        for _ in 0..n_formulas {
+            if at + 4 > b.len() {
+                return Err(invalid("truncated formula table"));
+            }
+            let len = le_u32(b, at) as usize;
+            at += 4;
+            let bytes = b
+                .get(at..at + len)
+                .ok_or_else(|| invalid("truncated formula table"))?;
+            formulas.push(
+                std::str::from_utf8(bytes)
+                    .map_err(|_| invalid("formula is not UTF-8"))?
+                    .to_owned(),
+            );
+            at += len;
+        }
+        Ok(Self {
+            entries,
+            formulas,
+            source_len,
+            source_mtime,
+        })
+    }
+
+    /// Write `<con_path>.idx` atomically (temp file + rename).
+    pub fn write_sidecar(&self, con_path: &Path) -> io::Result<()> {
+        let target = sidecar_path(con_path);
+        let mut tmp = target.as_os_str().to_owned();
+        tmp.push(".tmp");
+        let tmp = PathBuf::from(tmp);
+        {
+            let mut f = File::create(&tmp)?;
+            f.write_all(&self.to_bytes())?;
+            f.sync_all()?;
+        }
+        std::fs::rename(&tmp, &target)
+    }
+
+    /// Read `<con_path>.idx` without checking freshness.
+    pub fn read_sidecar(con_path: &Path) -> io::Result<Self> {
+        Self::from_bytes(&std::fs::read(sidecar_path(con_path))?)
+    }
+
+    /// The sidecar for `con_path`, if present, well-formed and fresh, and
+    /// `con_path` is uncompressed (offsets into inflated text cannot slice
+    /// the bytes on disk, whoever wrote the sidecar).
+    pub fn load_fresh(con_path: &Path) -> Option<Self> {
+        if !is_indexable(con_path) {
+            return None;
+        }
+        let idx = Self::read_sidecar(con_path).ok()?;
+        idx.is_fresh(con_path).then_some(idx)
+    }
+
+    /// Fresh sidecar if available, otherwise scan `con_path` and try to
+    /// persist a new sidecar (a read-only directory is not an error).
+    pub fn open_or_build(con_path: &Path) -> Result<Self, Box<dyn std::error::Error>> {
+        if let Some(idx) = Self::load_fresh(con_path) {
+            return Ok(idx);
+        }
+        let idx = Self::build_for_path(con_path)?;
+        let _ = idx.write_sidecar(con_path);
+        Ok(idx)
+    }
+
+    /// Read frame `i`'s bytes from an open handle on the source file.
+    pub fn read_span(&self, file: &File, i: usize) -> io::Result<String> {
+        self.entries.get(i).ok_or_else(out_of_range)?.read_span(file)
+    }
+
+    /// Parse frame `i` from an open handle on the source file.
+    pub fn read_frame(&self, file: &File, i: usize) -> Result<ConFrame, Box<dyn std::error::Error>> {
+        self.entries.get(i).ok_or_else(out_of_range)?.read_frame(file)
+    }
+}
+
+fn out_of_range() -> io::Error {
+    io::Error::new(io::ErrorKind::InvalidInput, "frame index out of range")
+}
+
+/// A fresh sidecar opened for point lookups: the header is validated once
+/// and [`Self::entry`] reads the single record at `HEADER_SIZE + RECORD_SIZE * i`,
+/// so random access does not load or parse the whole index.
+#[derive(Debug)]
+pub struct SidecarRecords {
+    file: File,
+    len: usize,
+}
+
+impl SidecarRecords {
+    /// Open `<con_path>.idx` when it is well-formed, fresh and `con_path`
+    /// is uncompressed (the conditions of [`FrameOffsetIndex::load_fresh`]).
+    pub fn open_fresh(con_path: &Path) -> Option<Self> {
+        if !is_indexable(con_path) {
+            return None;
+        }
+        let mut file = File::open(sidecar_path(con_path)).ok()?;
+        let mut header = [0u8; HEADER_SIZE];
+        file.read_exact(&mut header).ok()?;
+        let (n, source_len, source_mtime, _) = parse_header(&header).ok()?;
+        if source_stamp(con_path).ok()? != (source_len, source_mtime) {
+            return None;
+        }
+        let records_end = n
+            .checked_mul(RECORD_SIZE as u64)?
+            .checked_add(HEADER_SIZE as u64)?;
+        if file.metadata().ok()?.len() < records_end {
+            return None;
+        }
+        Some(Self {
+            file,
+            len: usize::try_from(n).ok()?,
+        })
+    }
+
+    /// Number of indexed frames.
+    pub fn len(&self) -> usize {
+        self.len
+    }
+
+    #[must_use]
+    pub fn is_empty(&self) -> bool {
+        self.len == 0
+    }
+
+    /// Record `i`, read from disk.
+    pub fn entry(&self, i: usize) -> io::Result<FrameIndexEntry> {
+        if i >= self.len {
+            return Err(out_of_range());
+        }
+        let mut f = &self.file;
+        f.seek(SeekFrom::Start((HEADER_SIZE + RECORD_SIZE * i) as u64))?;
+        let mut rec = [0u8; RECORD_SIZE];
+        f.read_exact(&mut rec)?;
+        Ok(parse_record(&rec))
+    }
+}
+
+/// True when `con_path` is readable plain text, the only input a sidecar
+/// may describe.
+fn is_indexable(con_path: &Path) -> bool {
+    matches!(
+        crate::compression::detect_path_compression(con_path),
+        Ok(crate::compression::Compression::None)
+    )
+}
+
+/// Frame count from a fresh sidecar header alone (no record reads).
+pub fn fresh_frame_count(con_path: &Path) -> Option<usize> {
+    SidecarRecords::open_fresh(con_path).map(|records| records.len())
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    fn multi_fixture() -> PathBuf {
+        PathBuf::from(env!("CARGO_MANIFEST_DIR")).join("resources/test/tiny_multi_cuh2.con")
+    }
+
+    #[test]
+    fn index_spans_match_raw_spans_and_round_trip() {
+        let dir = tempfile::tempdir().expect("tempdir");
+        let path = dir.path().join("multi.con");
+        std::fs::copy(multi_fixture(), &path).unwrap();
+        let idx = FrameOffsetIndex::build_for_path(&path).expect("build");
+        let text = std::fs::read_to_string(&path).unwrap();
+        let spans = crate::index_proj::frame_byte_spans(&text).unwrap();
+        assert_eq!(idx.len(), spans.len());
+        for (e, s) in idx.entries.iter().zip(&spans) {
+            assert_eq!(e.span(), *s);
+        }
+        assert_eq!(FrameOffsetIndex::from_bytes(&idx.to_bytes()).unwrap(), idx);
+
+        idx.write_sidecar(&path).unwrap();
+        assert_eq!(fresh_frame_count(&path), Some(spans.len()));
+        let records = SidecarRecords::open_fresh(&path).unwrap();
+        for (i, e) in idx.entries.iter().enumerate() {
+            assert_eq!(records.entry(i).unwrap(), *e);
+        }
+        assert!(records.entry(idx.len()).is_err());
+        let file = File::open(&path).unwrap();
+        let last = idx.read_frame(&file, idx.len() - 1).unwrap();
+        let expected = ConFrameIterator::new(&text).last().unwrap().unwrap();
+        assert_eq!(last, expected);
+    }
+
+    #[test]
+    fn writer_emits_index_matching_a_rescan() {
+        let text = std::fs::read_to_string(multi_fixture()).unwrap();
+        let frames: Vec<ConFrame> = ConFrameIterator::new(&text).map(|f| f.unwrap()).collect();
+        let dir = tempfile::tempdir().expect("tempdir");
+        let path = dir.path().join("written.con");
+        let mut writer = crate::writer::ConFrameWriter::from_path(&path)
+            .unwrap()
+            .with_offset_index();
+        writer.extend(frames.iter()).unwrap();
+        let written = writer.finish_with_index(&path).unwrap();
+
+        let rescanned = FrameOffsetIndex::build_for_path(&path).unwrap();
+        assert_eq!(written.entries, rescanned.entries);
+        assert_eq!(written.formulas, rescanned.formulas);
+        assert_eq!(FrameOffsetIndex::load_fresh(&path).as_ref(), Some(&written));
+        for (i, expected) in frames.iter().enumerate() {
+            let got = crate::iterators::read_frame(&path, i).unwrap();
+            assert_eq!(got.atom_data, expected.atom_data);
+        }
+        assert!(crate::iterators::read_frame(&path, frames.len()).is_err());
+    }
+
+    #[test]
+    fn stale_sidecar_is_ignored() {
+        let dir = tempfile::tempdir().expect("tempdir");
+        let path = dir.path().join("multi.con");
+        std::fs::copy(multi_fixture(), &path).unwrap();
+        FrameOffsetIndex::open_or_build(&path).unwrap();
+        assert!(FrameOffsetIndex::load_fresh(&path).is_some());
+        // Growing the file changes its length, invalidating the stamp.
+        let mut f = std::fs::OpenOptions::new().append(true).open(&path).unwrap();
+        f.write_all(b"\n").unwrap();
+        drop(f);
+        assert!(FrameOffsetIndex::load_fresh(&path).is_none());
+        assert_eq!(fresh_frame_count(&path), None);
+    }
+
+    #[test]
+    fn sidecar_next_to_compressed_file_is_ignored() {
+        let text = std::fs::read_to_string(multi_fixture()).unwrap();
+        let dir = tempfile::tempdir().expect("tempdir");
+        let path = dir.path().join("multi.con.gz");
+        let mut enc = crate::compression::gzip_writer(&path).unwrap();
+        enc.write_all(text.as_bytes()).unwrap();
+        enc.finish().unwrap();
+        // A stamped sidecar holding offsets into the inflated text.
+        let idx = FrameIndexBuilder::scan(&text).unwrap().finish(&path).unwrap();
+        idx.write_sidecar(&path).unwrap();
+
+        assert!(FrameOffsetIndex::load_fresh(&path).is_none());
+        assert_eq!(fresh_frame_count(&path), None);
+        let expected = ConFrameIterator::new(&text).last().unwrap().unwrap();
+        let got = crate::iterators::read_frame(&path, idx.len() - 1).unwrap();
+        assert_eq!(got, expected);
+    }
+}
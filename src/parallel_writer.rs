@@ -0,0 +1,508 @@
+//! Multi-frame writer that formats (and compresses) chunks of frames on the
+//! Rayon pool and emits them in file order.
+//!
+//! [`crate::writer::ConFrameWriter`] serializes frame after frame on the
+//! calling thread, and its gzip / zstd sinks compress one continuous stream.
+//! [`ParallelConWriter`] splits each [`ParallelConWriter::extend`] batch into
+//! chunks of [`ParallelConWriter::with_frames_per_chunk`] frames, renders
+//! every chunk into its own byte buffer with a private `ConFrameWriter`, and
+//! optionally compresses it into an independent gzip member or zstd frame
+//! on the same worker. Buffers are written in input order, so the output is
+//! the byte sequence a serial writer would produce (compressed outputs
+//! decompress to it); every reader in this crate accepts concatenated gzip
+//! members and zstd frames.
+//!
+//! With [`ParallelConWriter::with_seek_table`] (on by default for `.zst`
+//! paths) the zstd frames double as seekable blocks:
+//! [`ParallelConWriter::finish`] appends a
+//! [`crate::compression::ZstdSeekTable`] so readers can inflate only the
+//! block that holds a requested frame.
+//!
+//! Without the `parallel` feature the same chunking runs on the calling
+//! thread.
+
+use crate::compression::Compression;
+use crate::offset_index::{FrameIndexBuilder, FrameOffsetIndex};
+use crate::types::ConFrame;
+use crate::writer::ConFrameWriter;
+use std::borrow::Borrow;
+use std::fs::File;
+use std::io::{self, Write};
+use std::path::Path;
+
+/// Frames rendered per chunk unless overridden.
+pub(crate) const DEFAULT_FRAMES_PER_CHUNK: usize = 64;
+
+/// Chunks in flight per worker thread; bounds buffered output to roughly
+/// `threads * CHUNKS_PER_THREAD * frames_per_chunk` formatted frames.
+const CHUNKS_PER_THREAD: usize = 4;
+
+/// Codec applied independently to every chunk.
+#[derive(Debug, Clone, Copy, PartialEq, Eq)]
+pub enum ChunkCompression {
+    /// Plain text.
+    None,
+    /// One gzip member per chunk (default level).
+    Gzip,
+    /// One zstd frame per chunk (level 3, as [`crate::compression::zstd_writer`]).
+    #[cfg(feature = "zstd")]
+    Zstd,
+}
+
+impl ChunkCompression {
+    /// Codec matching a path's extension (`.gz`, `.zst`), as the readers
+    /// detect it. `.zst` without the `zstd` feature is an error.
+    pub fn from_extension(path: &Path) -> io::Result<Self> {
+        match crate::compression::detect_compression_from_extension(path) {
+            Compression::None => Ok(Self::None),
+            Compression::Gzip => Ok(Self::Gzip),
+            #[cfg(feature = "zstd")]
+            Compression::Zstd => Ok(Self::Zstd),
+            #[allow(unreachable_patterns)]
+            _ => Err(io::Error::new(
+                io::ErrorKind::Unsupported,
+                "zstd output requires the `zstd` feature",
+            )),
+        }
+    }
+
+    fn encode(self, raw: Vec<u8>) -> io::Result<Vec<u8>> {
+        match self {
+            Self::None => Ok(raw),
+            Self::Gzip => {
+                let mut gz = flate2::write::GzEncoder::new(
+                    Vec::with_capacity(raw.len() / 3),
+                    flate2::Compression::default(),
+                );
+                gz.write_all(&raw)?;
+                gz.finish()
+            }
+            #[cfg(feature = "zstd")]
+            Self::Zstd => zstd::bulk::compress(&raw, 3),
+        }
+    }
+}
+
+/// One rendered chunk: encoded bytes, their uncompressed length, and the
+/// uncompressed length of each frame (only collected when an offset index
+/// is being recorded).
+pub(crate) struct FormattedChunk {
+    pub(crate) bytes: Vec<u8>,
+    pub(crate) raw_len: u64,
+    pub(crate) frame_lens: Vec<u64>,
+}
+
+/// Render `frames` as `chunk`-sized groups, each through its own writer
+/// configured like the caller's, encoding the result with `codec`. Chunks are
+/// returned in input order.
+pub(crate) fn format_chunks<F: Borrow<ConFrame> + Sync>(
+    frames: &[F],
+    chunk: usize,
+    precision: usize,
+    canonical: bool,
+    codec: ChunkCompression,
+    record_lens: bool,
+) -> io::Result<Vec<FormattedChunk>> {
+    let render = |group: &[F]| -> io::Result<FormattedChunk> {
+        let mut writer = ConFrameWriter::with_precision(Vec::new(), precision).canonical(canonical);
+        let mut frame_lens = Vec::with_capacity(if record_lens { group.len() } else { 0 });
+        for frame in group {
+            let start = writer.bytes_written();
+            writer.write_frame(frame.borrow())?;
+            if record_lens {
+                frame_lens.push(writer.bytes_written() - start);
+            }
+        }
+        let raw = writer.into_inner()?;
+        let raw_len = raw.len() as u64;
+        let bytes = codec.encode(raw)?;
+        Ok(FormattedChunk {
+            bytes,
+            raw_len,
+            frame_lens,
+        })
+    };
+    let n_chunks = frames.len().div_ceil(chunk.max(1));
+    let group = |k: usize| &frames[k * chunk..((k + 1) * chunk).min(frames.len())];
+    #[cfg(feature = "parallel")]
+    {
+        use rayon::prelude::*;
+        (0..n_chunks).into_par_iter().map(|k| render(group(k))).collect()
+    }
+    #[cfg(not(feature = "parallel"))]
+    {
+        (0..n_chunks).map(|k| render(group(k))).collect()
+    }
+}
+
+/// Frames handed to [`format_chunks`] per round so buffered output stays bounded.
+pub(crate) fn window_frames(chunk: usize) -> usize {
+    #[cfg(feature = "parallel")]
+    let threads = rayon::current_num_threads();
+    #[cfg(not(feature = "parallel"))]
+    let threads = 1;
+    chunk.max(1) * threads.max(1) * CHUNKS_PER_THREAD
+}
+
+/// Chunked, order-preserving multi-frame writer; see the [module docs](self).
+///
+/// # Example
+/// ```no_run
+/// # use readcon_core::types::ConFrame;
+/// # use readcon_core::parallel_writer::ParallelConWriter;
+/// # let frames: Vec<ConFrame> = Vec::new();
+/// // `.gz` / `.zst` select per-chunk gzip members / zstd frames.
+/// let mut writer = ParallelConWriter::from_path("out.con.gz").unwrap();
+/// writer.extend(&frames).unwrap();
+/// writer.finish().unwrap();
+/// ```
+pub struct ParallelConWriter<W: Write> {
+    sink: W,
+    precision: usize,
+    canonical: bool,
+    compression: ChunkCompression,
+    frames_per_chunk: usize,
+    /// Uncompressed bytes emitted so far (offset-index coordinates).
+    uncompressed: u64,
+    index: Option<FrameIndexBuilder>,
+    /// `(compressed_len, raw_len, n_frames)` per chunk when a seek table is recorded.
+    seek_blocks: Option<Vec<(u32, u32, u32)>>,
+}
+
+impl<W: Write> ParallelConWriter<W> {
+    /// Plain-text writer over `sink` at the default precision.
+    pub fn new(sink: W) -> Self {
+        Self {
+            sink,
+            precision: crate::writer::DEFAULT_FLOAT_PRECISION,
+            canonical: false,
+            compression: ChunkCompression::None,
+            frames_per_chunk: DEFAULT_FRAMES_PER_CHUNK,
+            uncompressed: 0,
+            index: None,
+            seek_blocks: None,
+        }
+    }
+
+    /// Number of decimal places for floating-point output.
+    pub fn with_precision(mut self, precision: usize) -> Self {
+        self.precision = precision;
+        self
+    }
+
+    /// Canonical serialization, as [`ConFrameWriter::canonical`].
+    pub fn canonical(mut self, on: bool) -> Self {
+        self.canonical = on;
+        self
+    }
+
+    /// Set or clear canonical mode on an existing writer (C ABI / FFI).
+    pub fn set_canonical(&mut self, on: bool) {
+        self.canonical = on;
+    }
+
+    /// Whether canonical serialization is enabled.
+    pub fn is_canonical(&self) -> bool {
+        self.canonical
+    }
+
+    /// Codec applied to each chunk written from now on.
+    pub fn with_compression(mut self, compression: ChunkCompression) -> Self {
+        self.compression = compression;
+        self
+    }
+
+    /// Frames per chunk (at least 1). Larger chunks compress better; smaller
+    /// ones spread short batches over more workers.
+    pub fn with_frames_per_chunk(mut self, frames: usize) -> Self {
+        self.frames_per_chunk = frames.max(1);
+        self
+    }
+
+    /// Record an offset-index entry (uncompressed offsets) for every frame
+    /// written from now on; persist with [`ParallelConWriter::finish_with_index`],
+    /// which only accepts plain-text output.
+    pub fn with_offset_index(mut self) -> Self {
+        self.index.get_or_insert_with(FrameIndexBuilder::new);
+        self
+    }
+
+    /// Record every chunk as a seekable block and append the seek table in
+    /// [`Self::finish`]. Only valid with zstd chunks, and only before the
+    /// first frame: block offsets count from byte 0 of the sink.
+    #[cfg(feature = "zstd")]
+    pub fn with_seek_table(mut self) -> io::Result<Self> {
+        if self.uncompressed > 0 {
+            return Err(io::Error::new(
+                io::ErrorKind::InvalidInput,
+                "a seek table must be enabled before the first frame is written",
+            ));
+        }
+        self.seek_blocks.get_or_insert_with(Vec::new);
+        Ok(self)
+    }
+
+    /// Uncompressed bytes emitted so far.
+    pub fn bytes_written(&self) -> u64 {
+        self.uncompressed
+    }
+
+    /// Format `frames` in parallel and append them in order. Accepts
+    /// `&[ConFrame]` as well as `&[&ConFrame]` (e.g. frames gathered from handles).
+    pub fn extend<F: Borrow<ConFrame> + Sync>(&mut self, frames: &[F]) -> io::Result<()> {
+        let chunk = self.frames_per_chunk;
+        for window in frames.chunks(window_frames(chunk)) {
+            let chunks = format_chunks(
+                window,
+                chunk,
+                self.precision,
+                self.canonical,
+                self.compression,
+                self.index.is_some(),
+            )?;
+            for (k, formatted) in chunks.iter().enumerate() {
+                let group = &window[k * chunk..((k + 1) * chunk).min(window.len())];
+                if let Some(blocks) = self.seek_blocks.as_mut() {
+                    let too_big = || {
+                        io::Error::new(
+                            io::ErrorKind::InvalidInput,
+                            "seekable block exceeds 4 GiB; lower frames_per_chunk",
+                        )
+                    };
+                    blocks.push((
+                        u32::try_from(formatted.bytes.len()).map_err(|_| too_big())?,
+                        u32::try_from(formatted.raw_len).map_err(|_| too_big())?,
+                        group.len() as u32,
+                    ));
+                }
+                self.sink.write_all(&formatted.bytes)?;
+                if let Some(index) = self.index.as_mut() {
+                    let mut offset = self.uncompressed;
+                    for (frame, &len) in group.iter().zip(&formatted.frame_lens) {
+                        index.push(frame.borrow(), offset, len);
+                        offset += len;
+                    }
+                }
+                self.uncompressed += formatted.raw_len;
+            }
+        }
+        Ok(())
+    }
+
+    /// Append the seek table (when recorded), flush the sink and hand it back.
+    pub fn finish(mut self) -> io::Result<W> {
+        if let Some(blocks) = self.seek_blocks.take() {
+            #[cfg(feature = "zstd")]
+            let zstd = self.compression == ChunkCompression::Zstd;
+            #[cfg(not(feature = "zstd"))]
+            let zstd = false;
+            if !zstd {
+                return Err(io::Error::new(
+                    io::ErrorKind::InvalidInput,
+                    "a seek table needs zstd chunk compression",
+                ));
+            }
+            self.sink
+                .write_all(&crate::compression::ZstdSeekTable::encode(&blocks))?;
+        }
+        self.sink.flush()?;
+        Ok(self.sink)
+    }
+}
+
+impl ParallelConWriter<File> {
+    /// Creates `path`, picking the chunk codec from its extension
+    /// (see [`ChunkCompression::from_extension`]). `.zst` outputs also get a
+    /// seek table ([`Self::with_seek_table`]).
+    pub fn from_path<P: AsRef<Path>>(path: P) -> io::Result<Self> {
+        Self::for_path(File::create(path.as_ref())?, path.as_ref())
+    }
+
+    /// Writer over `file` with the codec (and seek table) [`Self::from_path`]
+    /// picks for `path`, e.g. for a temporary file later renamed to `path`.
+    pub fn for_path(file: File, path: &Path) -> io::Result<Self> {
+        let compression = ChunkCompression::from_extension(path)?;
+        let writer = Self::new(file).with_compression(compression);
+        #[cfg(feature = "zstd")]
+        if compression == ChunkCompression::Zstd {
+            return writer.with_seek_table();
+        }
+        Ok(writer)
+    }
+
+    /// Flush and close the file, then write its `<path>.idx` sidecar.
+    /// [`Self::with_offset_index`] must have been enabled before the first frame.
+    ///
+    /// Sidecar offsets address the bytes on disk, so compressed chunks are
+    /// refused: the file is still finished, but no sidecar is written.
+    pub fn finish_with_index<P: AsRef<Path>>(mut self, path: P) -> io::Result<FrameOffsetIndex> {
+        let builder = self.index.take().ok_or_else(|| {
+            io::Error::new(
+                io::ErrorKind::InvalidInput,
+                "offset index recording was not enabled on this writer",
+            )
+        })?;
+        let compressed = self.compression != ChunkCompression::None;
+        drop(self.finish()?);
+        if compressed {
+            return Err(io::Error::new(
+                io::ErrorKind::InvalidInput,
+                "offset index sidecars require uncompressed output",
+            ));
+        }
+        let idx = builder.finish(path.as_ref())?;
+        idx.write_sidecar(path.as_ref())?;
+        Ok(idx)
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use std::path::PathBuf;
+
+    fn fixture_frames() -> Vec<ConFrame> {
+        let p = PathBuf::from(env!("CARGO_MANIFEST_DIR")).join("resources/test/tiny_multi_cuh2.con");
+        let frames = crate::iterators::read_all_frames(&p).expect("fixture");
+        frames.iter().cycle().take(frames.len() * 37).cloned().collect()
+    }
+
+    fn serial_bytes(frames: &[ConFrame]) -> Vec<u8> {
+        let mut buf = Vec::new();
+        {
+            let mut w = ConFrameWriter::new(&mut buf);
+            w.extend(frames.iter()).unwrap();
+            w.flush().unwrap();
+        }
+        buf
+    }
+
+    #[test]
+    fn plain_output_matches_serial_writer() {
+        let frames = fixture_frames();
+        for chunk in [1, 3, 64] {
+            let mut w = ParallelConWriter::new(Vec::new()).with_frames_per_chunk(chunk);
+            w.extend(&frames[..5]).unwrap();
+            w.extend(&frames[5..]).unwrap();
+            assert_eq!(w.finish().unwrap(), serial_bytes(&frames), "chunk {chunk}");
+        }
+    }
+
+    #[test]
+    fn gzip_members_read_back_without_index() {
+        let frames = fixture_frames();
+        let dir = tempfile::tempdir().expect("tempdir");
+        let path = dir.path().join("par.con.gz");
+        let mut w = ParallelConWriter::from_path(&path)
+            .unwrap()
+            .with_frames_per_chunk(4)
+            .with_offset_index();
+        w.extend(&frames).unwrap();
+        let err = w.finish_with_index(&path).unwrap_err();
+        assert_eq!(err.kind(), io::ErrorKind::InvalidInput);
+        assert!(!crate::offset_index::sidecar_path(&path).exists());
+
+        let contents = crate::compression::read_file_contents(&path).unwrap();
+        assert_eq!(contents.as_str().unwrap().as_bytes(), serial_bytes(&frames));
+        let back = crate::iterators::read_all_frames(&path).unwrap();
+        assert_eq!(back.len(), frames.len());
+        assert_eq!(crate::iterators::count_frames(&path).unwrap(), frames.len());
+    }
+
+    #[cfg(feature = "parallel")]
+    #[test]
+    fn par_extend_matches_extend_including_index() {
+        let frames = fixture_frames();
+        let refs: Vec<&ConFrame> = frames.iter().collect();
+        let mut buf = Vec::new();
+        let index = {
+            let mut w = ConFrameWriter::new(&mut buf).with_offset_index();
+            w.write_frame(&frames[0]).unwrap();
+            w.par_extend(&refs[1..]).unwrap();
+            w.flush().unwrap();
+            w.take_offset_index().unwrap()
+        };
+        assert_eq!(buf, serial_bytes(&frames));
+        let dir = tempfile::tempdir().expect("tempdir");
+        let path = dir.path().join("par.con");
+        std::fs::write(&path, &buf).unwrap();
+        let scanned = FrameIndexBuilder::scan(std::str::from_utf8(&buf).unwrap()).unwrap();
+        assert_eq!(index.finish(&path).unwrap(), scanned.finish(&path).unwrap());
+    }
+
+    #[cfg(feature = "zstd")]
+    #[test]
+    fn zstd_frames_read_back() {
+        let frames = fixture_frames();
+        let dir = tempfile::tempdir().expect("tempdir");
+        let path = dir.path().join("par.con.zst");
+        let mut w = ParallelConWriter::from_path(&path).unwrap().with_frames_per_chunk(5);
+        w.extend(&frames).unwrap();
+        w.finish().unwrap();
+        let contents = crate::compression::read_file_contents(&path).unwrap();
+        assert_eq!(contents.as_str().unwrap().as_bytes(), serial_bytes(&frames));
+    }
+
+    #[cfg(feature = "zstd")]
+    #[test]
+    fn zstd_seek_table_gives_random_access() {
+        let frames = fixture_frames();
+        let dir = tempfile::tempdir().expect("tempdir");
+        let path = dir.path().join("seek.con.zst");
+        let mut w = ParallelConWriter::from_path(&path).unwrap().with_frames_per_chunk(5);
+        w.extend(&frames[..3]).unwrap();
+        w.extend(&frames[3..]).unwrap();
+        w.finish().unwrap();
+
+        let table = crate::compression::detect_zstd_seek_table(&path).unwrap().unwrap();
+        assert_eq!(table.n_frames(), frames.len());
+        // The first `extend` flushed a short block.
+        assert_eq!(table.blocks[0].n_frames, 3);
+        assert_eq!(table.blocks[1].first_frame, 3);
+        let file = File::open(&path).unwrap();
+        let k = table.block_of_frame(40).unwrap();
+        let text = table.read_block(&file, k).unwrap();
+        let first = table.blocks[k].first_frame as usize;
+        let in_block: Vec<ConFrame> = crate::iterators::ConFrameIterator::new(&text)
+            .map(Result::unwrap)
+            .collect();
+        assert_eq!(in_block[..], frames[first..first + in_block.len()]);
+        assert_eq!(table.block_of_frame(frames.len()), None);
+
+        // Plain zstd readers skip the table.
+        let contents = crate::compression::read_file_contents(&path).unwrap();
+        assert_eq!(contents.as_str().unwrap().as_bytes(), serial_bytes(&frames));
+        assert_eq!(crate::iterators::count_frames(&path).unwrap(), frames.len());
+        for i in [0, 17, frames.len() - 1] {
+            assert_eq!(crate::iterators::read_frame(&path, i).unwrap(), frames[i]);
+        }
+        assert!(crate::iterators::read_frame(&path, frames.len()).is_err());
+        let strided = crate::iterators::read_frames_strided(&path, 2, Some(60), 7).unwrap();
+        let expected: Vec<_> = frames[2..60].iter().step_by(7).cloned().collect();
+        assert_eq!(strided, expected);
+        assert_eq!(crate::iterators::read_all_frames(&path).unwrap(), frames);
+    }
+
+    #[cfg(feature = "zstd")]
+    #[test]
+    fn plain_zstd_stream_has_no_seek_table() {
+        let frames = fixture_frames();
+        let dir = tempfile::tempdir().expect("tempdir");
+        let path = dir.path().join("stream.con.zst");
+        let mut w = ConFrameWriter::from_path_zstd(&path).unwrap();
+        w.extend(frames.iter()).unwrap();
+        drop(w);
+        assert_eq!(crate::compression::detect_zstd_seek_table(&path).unwrap(), None);
+        assert_eq!(crate::iterators::read_frame(&path, 9).unwrap(), frames[9]);
+    }
+
+    #[cfg(feature = "zstd")]
+    #[test]
+    fn seek_table_must_precede_the_first_frame() {
+        let frames = fixture_frames();
+        let mut w = ParallelConWriter::new(Vec::new()).with_compression(ChunkCompression::Zstd);
+        w.extend(&frames[..2]).unwrap();
+        let err = w.with_seek_table().err().expect("late seek table refused");
+        assert_eq!(err.kind(), io::ErrorKind::InvalidInput);
+    }
+}
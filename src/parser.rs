@@ -1,10 +1,14 @@
 use crate::error::ParseError;
 use crate::helpers::symbol_to_atomic_number;
 use crate::types::{
-    AtomDatum, ConFrame, FrameHeader, PreboxHeader, SECTION_CHARGES, SECTION_ENERGIES,
+    AtomDatum, ColumnMask, ConFrame, FrameHeader, SECTION_CHARGES, SECTION_ENERGIES,
     SECTION_FORCES, SECTION_MAGMOMS, SECTION_SPINS, SECTION_VELOCITIES,
     decode_fixed_bitmask, meta,
 };
+use crate::lean::{LeanColumns, LeanFrame};
+use crate::scan::CoordinateRow;
+use crate::stats::{self, Counter, Stage};
+use crate::storage_dtype::{ElementKind, FloatArray2, StorageDtypes};
 use serde_json::Value;
 use std::collections::BTreeMap;
 use std::iter::Peekable;
@@ -17,6 +21,22 @@ use std::sync::Arc;
 pub trait LineStream<'a> {
     fn next_line(&mut self) -> Option<&'a str>;
     fn peek_line(&mut self) -> Option<&'a str>;
+    /// Consumes the next `rows` lines as one contiguous slice when the source
+    /// opts into intra-frame parallel decoding and `rows` is large enough to
+    /// pay for it. `None` (the default) leaves the stream untouched; callers
+    /// then read the rows line by line.
+    fn row_block(&mut self, _rows: usize) -> Option<&'a str> {
+        None
+    }
+    /// Everything not yet read, for block kernels that find line ends
+    /// themselves ([`crate::scan::decode_coordinate_rows`]); pair with
+    /// [`Self::consume`]. `None` (the default) keeps callers line by line.
+    fn remainder(&mut self) -> Option<&'a str> {
+        None
+    }
+    /// Advances past `bytes` bytes of [`Self::remainder`], ending on a line
+    /// boundary.
+    fn consume(&mut self, _bytes: usize) {}
 }
 
 impl<'a, I> LineStream<'a> for Peekable<I>
@@ -33,6 +53,79 @@ where
     }
 }
 
+/// Per-atom 3-vector columns filled by a section block.
+#[derive(Clone, Copy, Debug, PartialEq, Eq)]
+pub enum VectorSection {
+    Velocities,
+    Forces,
+    Magmoms,
+}
+
+/// Per-atom scalar columns filled by a section block.
+#[derive(Clone, Copy, Debug, PartialEq, Eq)]
+pub enum ScalarSection {
+    Energies,
+    Charges,
+    Spins,
+}
+
+/// Destination of the section parsers: the coordinate atoms a section row
+/// is validated against, and the columns it fills.
+///
+/// Implemented for the `AtomDatum` vector of a [`ConFrame`] and for the SoA
+/// columns behind [`crate::lean::LeanFrame`]; indices past the coordinate
+/// block are ignored on store, as the AoS path always did.
+pub trait SectionTarget: Sync {
+    /// Component symbol of coordinate atom `atom_idx`.
+    fn atom_symbol(&self, atom_idx: usize) -> Option<&str>;
+    /// `(fixed, atom_id)` of coordinate atom `atom_idx`.
+    fn atom_identity(&self, atom_idx: usize) -> Option<([bool; 3], u64)>;
+    fn set_vector(&mut self, section: VectorSection, atom_idx: usize, value: [f64; 3]);
+    fn set_scalar(&mut self, section: ScalarSection, atom_idx: usize, value: f64);
+}
+
+impl SectionTarget for [AtomDatum] {
+    fn atom_symbol(&self, atom_idx: usize) -> Option<&str> {
+        self.get(atom_idx).map(|atom| atom.symbol.as_ref())
+    }
+    fn atom_identity(&self, atom_idx: usize) -> Option<([bool; 3], u64)> {
+        self.get(atom_idx).map(|atom| (atom.fixed, atom.atom_id))
+    }
+    fn set_vector(&mut self, section: VectorSection, atom_idx: usize, value: [f64; 3]) {
+        if let Some(atom) = self.get_mut(atom_idx) {
+            match section {
+                VectorSection::Velocities => atom.velocity = Some(value),
+                VectorSection::Forces => atom.force = Some(value),
+                VectorSection::Magmoms => atom.magmom = Some(value),
+            }
+        }
+    }
+    fn set_scalar(&mut self, section: ScalarSection, atom_idx: usize, value: f64) {
+        if let Some(atom) = self.get_mut(atom_idx) {
+            match section {
+                ScalarSection::Energies => atom.energy = Some(value),
+                ScalarSection::Charges => atom.charge = Some(value),
+                ScalarSection::Spins => atom.spin = Some(value),
+            }
+        }
+    }
+}
+
+impl SectionTarget for Vec<AtomDatum> {
+    fn atom_symbol(&self, atom_idx: usize) -> Option<&str> {
+        self.as_slice().atom_symbol(atom_idx)
+    }
+    fn atom_identity(&self, atom_idx: usize) -> Option<([bool; 3], u64)> {
+        self.as_slice().atom_identity(atom_idx)
+    }
+    fn set_vector(&mut self, section: VectorSection, atom_idx: usize, value: [f64; 3]) {
+        self.as_mut_slice().set_vector(section, atom_idx, value)
+    }
+    fn set_scalar(&mut self, section: ScalarSection, atom_idx: usize, value: f64) {
+        self.as_mut_slice().set_scalar(section, atom_idx, value)
+    }
+}
+
 /// Hot-path: parse up to 5 whitespace-separated f64s into a stack buffer.
 /// Returns count of tokens actually present (before padding).
 /// Pads `out[found..max]` from `defaults` when `found < max` and `found >= min`.
@@ -123,28 +216,47 @@ pub fn parse_line_of_range_f64_stack(
 /// * `line` - A string slice representing a single line of data.
 /// * `n` - The exact number of f64 values expected on the line.
 pub fn parse_line_of_n_f64(line: &str, n: usize) -> Result<Vec<f64>, ParseError> {
+    let mut values = Vec::with_capacity(n);
+    parse_line_of_n_f64_into(line, n, &mut values)?;
+    Ok(values)
+}
+
+/// [`parse_line_of_n_f64`] into `out` (cleared first), reusing its capacity.
+pub fn parse_line_of_n_f64_into(
+    line: &str,
+    n: usize,
+    out: &mut Vec<f64>,
+) -> Result<(), ParseError> {
+    out.clear();
     if n <= 5 {
         let defaults = [0.0f64; 5];
         let mut buf = [0.0f64; 5];
         parse_line_of_range_f64_stack(line, n, n, &defaults, &mut buf)?;
-        return Ok(buf[..n].to_vec());
+        out.extend_from_slice(&buf[..n]);
+        return Ok(());
     }
-    let mut values = Vec::with_capacity(n);
     for token in line.split_ascii_whitespace() {
         let val: f64 = fast_float2::parse(token)
             .map_err(|_| ParseError::InvalidNumberFormat(format!("invalid float: {token}")))?;
-        values.push(val);
+        out.push(val);
     }
-    if values.len() == n {
-        Ok(values)
+    if out.len() == n {
+        Ok(())
     } else {
         Err(ParseError::InvalidVectorLength {
             expected: n,
-            found: values.len(),
+            found: out.len(),
         })
     }
 }
 
+/// Three whitespace-separated floats (box lengths or angles) on the stack.
+fn parse_line_of_3_f64(line: &str) -> Result<[f64; 3], ParseError> {
+    let mut buf = [0.0f64; 5];
+    parse_line_of_range_f64_stack(line, 3, 3, &[0.0f64; 5], &mut buf)?;
+    Ok([buf[0], buf[1], buf[2]])
+}
+
 /// Parses a line of whitespace-separated f64 values, accepting between `min`
 /// and `max` values (inclusive). Returns a vector of exactly `max` elements,
 /// padding with values from `defaults` when fewer than `max` are present.
@@ -411,17 +523,30 @@ pub fn parse_line_of_n<T: std::str::FromStr>(line: &str, n: usize) -> Result<Vec
 where
     ParseError: From<<T as std::str::FromStr>::Err>,
 {
-    let values: Vec<T> = line
-        .split_whitespace()
-        .map(|s| s.parse::<T>())
-        .collect::<Result<_, _>>()?;
+    let mut values = Vec::with_capacity(n);
+    parse_line_of_n_into(line, n, &mut values)?;
+    Ok(values)
+}
 
-    if values.len() == n {
-        Ok(values)
+/// [`parse_line_of_n`] into `out` (cleared first), reusing its capacity.
+pub fn parse_line_of_n_into<T: std::str::FromStr>(
+    line: &str,
+    n: usize,
+    out: &mut Vec<T>,
+) -> Result<(), ParseError>
+where
+    ParseError: From<<T as std::str::FromStr>::Err>,
+{
+    out.clear();
+    for token in line.split_whitespace() {
+        out.push(token.parse::<T>()?);
+    }
+    if out.len() == n {
+        Ok(())
     } else {
         Err(ParseError::InvalidVectorLength {
             expected: n,
-            found: values.len(),
+            found: out.len(),
         })
     }
 }
@@ -440,141 +565,251 @@ where
 /// * `ParseError::IncompleteHeader` if the iterator has fewer than 9 lines remaining.
 /// * Propagates any errors from `parse_line_of_n` if the numeric data within
 ///   the header is malformed.
-///
-/// # Panics
-///
-/// This function will panic if the intermediate vectors for box dimensions or angles,
-/// after being successfully parsed, cannot be converted into fixed-size arrays.
-/// This should not happen if `parse_line_of_n` is used correctly with `n=3`.
 pub fn parse_frame_header<'a>(
     lines: &mut impl Iterator<Item = &'a str>,
 ) -> Result<FrameHeader, ParseError> {
-    let prebox1 = lines
-        .next()
-        .ok_or(ParseError::IncompleteHeader)?
-        .to_string();
-    let prebox2_raw = lines.next().ok_or(ParseError::IncompleteHeader)?;
-
-    // Line 2: if it starts with '{', parse as JSON metadata (spec v2+).
-    // Otherwise treat as a legacy (pre-v2) file with spec_version = 1.
-    let trimmed = prebox2_raw.trim();
-    let (spec_version, metadata, sections, validate, sections_declared) = if trimmed.starts_with('{') {
-        let json_val: serde_json::Value = serde_json::from_str(trimmed)
-            .map_err(|e| ParseError::InvalidMetadataJson(e.to_string()))?;
-        let json_obj = json_val
-            .as_object()
-            .ok_or_else(|| ParseError::InvalidMetadataJson("expected a JSON object".to_string()))?;
-        let ver = json_obj
-            .get(meta::CON_SPEC_VERSION)
-            .and_then(|v| v.as_u64())
-            .ok_or(ParseError::MissingSpecVersion)? as u32;
-        if ver > crate::CON_SPEC_VERSION {
-            return Err(ParseError::UnsupportedSpecVersion(ver));
+    let mut header = FrameHeader::default();
+    parse_frame_header_into(lines, &mut header)?;
+    Ok(header)
+}
+
+/// [`parse_frame_header`] into an existing header, reusing the capacity of
+/// its strings. On error `header` is left partially overwritten.
+pub fn parse_frame_header_into<'a>(
+    lines: &mut impl Iterator<Item = &'a str>,
+    header: &mut FrameHeader,
+) -> Result<(), ParseError> {
+    let mut cache = HeaderCache::default();
+    parse_header_lines(lines, header, &mut cache)?;
+    header.metadata = std::mem::take(&mut cache.metadata);
+    header.sections = std::mem::take(&mut cache.sections);
+    header.natms_per_type = std::mem::take(&mut cache.natms_per_type);
+    header.masses_per_type = std::mem::take(&mut cache.masses_per_type);
+    Ok(())
+}
+
+/// [`parse_frame_header_into`] through a [`HeaderCache`]: header lines that
+/// repeat the previous frame's byte for byte are not decoded again (the
+/// recycling path of [`crate::iterators::ConFrameIterator::next_into`]).
+pub fn parse_frame_header_cached<'a>(
+    lines: &mut impl Iterator<Item = &'a str>,
+    header: &mut FrameHeader,
+    cache: &mut HeaderCache,
+) -> Result<(), ParseError> {
+    parse_header_lines(lines, header, cache)?;
+    // Compare before copying: a recycled header usually already matches.
+    if header.metadata != cache.metadata {
+        header.metadata.clone_from(&cache.metadata);
+    }
+    if header.sections != cache.sections {
+        header.sections.clone_from(&cache.sections);
+    }
+    header.natms_per_type.clone_from(&cache.natms_per_type);
+    header.masses_per_type.clone_from(&cache.masses_per_type);
+    Ok(())
+}
+
+/// Parsed pieces of the previous frame's header, keyed by the raw lines they
+/// came from, so a homogeneous trajectory decodes them once.
+///
+/// Line 2 (the JSON metadata) and lines 7-9 (component count, atoms per
+/// component, masses) are compared with the previous frame's bytes; on a
+/// match the JSON decode, schema / units validation, [`StorageDtypes`]
+/// lookup and mass parsing are skipped. The component symbols interned by
+/// [`parse_single_frame_into`] are kept here too. A cache belongs to one
+/// cursor; a fresh one costs nothing until the first header.
+#[derive(Debug, Default)]
+pub struct HeaderCache {
+    metadata_line: Option<String>,
+    spec_version: u32,
+    metadata: BTreeMap<String, Value>,
+    sections: Vec<String>,
+    validate: bool,
+    sections_declared: bool,
+    dtypes: StorageDtypes,
+    layout_lines: Option<[String; 3]>,
+    natm_types: usize,
+    natms_per_type: Vec<usize>,
+    masses_per_type: Vec<f64>,
+    /// Set once the cached masses passed strict validation.
+    masses_checked: bool,
+    symbols: Vec<Arc<str>>,
+}
+
+impl HeaderCache {
+    pub fn new() -> Self {
+        Self::default()
+    }
+
+    /// Storage dtypes of the last header parsed through this cache.
+    pub fn dtypes(&self) -> &StorageDtypes {
+        &self.dtypes
+    }
+
+    fn refresh_metadata(&mut self, raw: &str) -> Result<(), ParseError> {
+        if self.metadata_line.as_deref() == Some(raw) {
+            return Ok(());
         }
-        if ver >= 3 {
-            match json_obj.get(meta::UNITS) {
-                Some(u) => crate::units::validate_v3_units_metadata(u).map_err(|e| {
-                    ParseError::ValidationError(format!("v3 units: {e}"))
-                })?,
-                None => {
-                    return Err(ParseError::ValidationError(
-                        "con_spec_version >= 3 requires metadata \"units\" with length and energy"
-                            .into(),
-                    ));
-                }
+        let _timer = stats::timer(Stage::Metadata);
+        let mut line = self.metadata_line.take().unwrap_or_default();
+        let (spec_version, metadata, sections, validate, sections_declared) =
+            parse_metadata_line(raw.trim())?;
+        self.dtypes = StorageDtypes::from_metadata(&metadata).unwrap_or_default();
+        self.spec_version = spec_version;
+        self.metadata = metadata;
+        self.sections = sections;
+        self.validate = validate;
+        self.sections_declared = sections_declared;
+        self.masses_checked = false;
+        line.clear();
+        line.push_str(raw);
+        self.metadata_line = Some(line);
+        Ok(())
+    }
+
+    fn refresh_layout(&mut self, raw: [&str; 3]) -> Result<(), ParseError> {
+        if self
+            .layout_lines
+            .as_ref()
+            .is_some_and(|lines| lines.iter().zip(raw).all(|(a, b)| a == b))
+        {
+            return Ok(());
+        }
+        let mut lines = self.layout_lines.take().unwrap_or_default();
+        self.natm_types = parse_line_of_n::<usize>(raw[0], 1)?[0];
+        parse_line_of_n_into(raw[1], self.natm_types, &mut self.natms_per_type)?;
+        parse_line_of_n_f64_into(raw[2], self.natm_types, &mut self.masses_per_type)?;
+        self.masses_checked = false;
+        for (dst, src) in lines.iter_mut().zip(raw) {
+            dst.clear();
+            dst.push_str(src);
+        }
+        self.layout_lines = Some(lines);
+        Ok(())
+    }
+}
+
+/// Reads the nine header lines into `header` (strings and geometry) and
+/// `cache` (metadata and component layout); the callers move or copy the
+/// cached pieces into `header`.
+fn parse_header_lines<'a>(
+    lines: &mut impl Iterator<Item = &'a str>,
+    header: &mut FrameHeader,
+    cache: &mut HeaderCache,
+) -> Result<(), ParseError> {
+    let _timer = stats::timer(Stage::Header);
+    let mut next = || lines.next().ok_or(ParseError::IncompleteHeader);
+    let prebox1 = next()?;
+    let prebox2_raw = next()?;
+    cache.refresh_metadata(prebox2_raw)?;
+    let boxl = parse_line_of_3_f64(next()?)?;
+    let angles = parse_line_of_3_f64(next()?)?;
+    let postbox1 = next()?;
+    let postbox2 = next()?;
+    cache.refresh_layout([next()?, next()?, next()?])?;
+    if cache.validate {
+        validate_header_geometry(&boxl, &angles, cache.natm_types, &cache.natms_per_type)?;
+        if !cache.masses_checked {
+            validate_masses(&cache.masses_per_type)?;
+            cache.masses_checked = true;
+        }
+    }
+    let assign = |dst: &mut String, src: &str| {
+        dst.clear();
+        dst.push_str(src);
+    };
+    assign(&mut header.prebox_header.user, prebox1);
+    assign(&mut header.prebox_header.metadata_line, prebox2_raw);
+    assign(&mut header.postbox_header[0], postbox1);
+    assign(&mut header.postbox_header[1], postbox2);
+    header.boxl = boxl;
+    header.angles = angles;
+    header.natm_types = cache.natm_types;
+    header.spec_version = cache.spec_version;
+    header.strict_validation = cache.validate;
+    header.sections_declared = cache.sections_declared;
+    Ok(())
+}
+
+/// Decodes header line 2: `(spec_version, metadata, sections, validate,
+/// sections_declared)`. Lines not starting with `{` are legacy (v1) files.
+#[allow(clippy::type_complexity)]
+fn parse_metadata_line(
+    trimmed: &str,
+) -> Result<(u32, BTreeMap<String, Value>, Vec<String>, bool, bool), ParseError> {
+    if !trimmed.starts_with('{') {
+        // Legacy file: no JSON metadata line.
+        return Ok((1_u32, BTreeMap::new(), Vec::new(), false, false));
+    }
+    let json_val: serde_json::Value = serde_json::from_str(trimmed)
+        .map_err(|e| ParseError::InvalidMetadataJson(e.to_string()))?;
+    let json_obj = json_val
+        .as_object()
+        .ok_or_else(|| ParseError::InvalidMetadataJson("expected a JSON object".to_string()))?;
+    let ver = json_obj
+        .get(meta::CON_SPEC_VERSION)
+        .and_then(|v| v.as_u64())
+        .ok_or(ParseError::MissingSpecVersion)? as u32;
+    if ver > crate::CON_SPEC_VERSION {
+        return Err(ParseError::UnsupportedSpecVersion(ver));
+    }
+    if ver >= 3 {
+        match json_obj.get(meta::UNITS) {
+            Some(u) => crate::units::validate_v3_units_metadata(u).map_err(|e| {
+                ParseError::ValidationError(format!("v3 units: {e}"))
+            })?,
+            None => {
+                return Err(ParseError::ValidationError(
+                    "con_spec_version >= 3 requires metadata \"units\" with length and energy"
+                        .into(),
+                ));
             }
         }
+    }
 
-        // Single pass over the JSON object: collect sections, capture the
-        // validate flag, copy the rest into metadata. Folds the previous
-        // pre-extract get(validate) + re-iterate pattern into one walk.
-        let mut sections: Vec<String> = Vec::new();
-        let mut metadata = BTreeMap::new();
-        let mut sections_declared = false;
-        let mut validate = false;
-        for (k, v) in json_obj {
-            match k.as_str() {
-                meta::CON_SPEC_VERSION => {}
-                meta::SECTIONS => {
-                    sections_declared = true;
-                    let arr = v.as_array().ok_or_else(|| {
+    // Single pass over the JSON object: collect sections, capture the
+    // validate flag, copy the rest into metadata. Folds the previous
+    // pre-extract get(validate) + re-iterate pattern into one walk.
+    let mut sections: Vec<String> = Vec::new();
+    let mut metadata = BTreeMap::new();
+    let mut sections_declared = false;
+    let mut validate = false;
+    for (k, v) in json_obj {
+        match k.as_str() {
+            meta::CON_SPEC_VERSION => {}
+            meta::SECTIONS => {
+                sections_declared = true;
+                let arr = v.as_array().ok_or_else(|| {
+                    metadata_json_error("sections must be an array of strings")
+                })?;
+                sections.reserve(arr.len());
+                for entry in arr {
+                    let s = entry.as_str().ok_or_else(|| {
                         metadata_json_error("sections must be an array of strings")
                     })?;
-                    sections.reserve(arr.len());
-                    for entry in arr {
-                        let s = entry.as_str().ok_or_else(|| {
-                            metadata_json_error("sections must be an array of strings")
-                        })?;
-                        sections.push(s.to_string());
-                    }
-                }
-                meta::VALIDATE => {
-                    validate = match v {
-                        Value::Bool(b) => *b,
-                        _ => return Err(metadata_json_error("validate must be a boolean")),
-                    };
-                    metadata.insert(k.clone(), v.clone());
-                }
-                _ => {
-                    metadata.insert(k.clone(), v.clone());
+                    sections.push(s.to_string());
                 }
             }
+            meta::VALIDATE => {
+                validate = match v {
+                    Value::Bool(b) => *b,
+                    _ => return Err(metadata_json_error("validate must be a boolean")),
+                };
+                metadata.insert(k.clone(), v.clone());
+            }
+            _ => {
+                metadata.insert(k.clone(), v.clone());
+            }
         }
+    }
 
-        // Strict-mode schema check fires only when the file requested
-        // it. Hot-path parses (validate=false) skip the per-key match.
-        if validate {
-            validate_metadata_schema(json_obj)?;
-        }
-
-        (ver, metadata, sections, validate, sections_declared)
-    } else {
-        // Legacy file: no JSON metadata line.
-        (1_u32, BTreeMap::new(), Vec::new(), false, false)
-    };
-    let prebox2 = prebox2_raw.to_string();
-
-    let boxl_vec = parse_line_of_n_f64(lines.next().ok_or(ParseError::IncompleteHeader)?, 3)?;
-    let angles_vec = parse_line_of_n_f64(lines.next().ok_or(ParseError::IncompleteHeader)?, 3)?;
-    let postbox1 = lines
-        .next()
-        .ok_or(ParseError::IncompleteHeader)?
-        .to_string();
-    let postbox2 = lines
-        .next()
-        .ok_or(ParseError::IncompleteHeader)?
-        .to_string();
-    let natm_types =
-        parse_line_of_n::<usize>(lines.next().ok_or(ParseError::IncompleteHeader)?, 1)?[0];
-    let natms_per_type = parse_line_of_n::<usize>(
-        lines.next().ok_or(ParseError::IncompleteHeader)?,
-        natm_types,
-    )?;
-    let masses_per_type = parse_line_of_n_f64(
-        lines.next().ok_or(ParseError::IncompleteHeader)?,
-        natm_types,
-    )?;
+    // Strict-mode schema check fires only when the file requested
+    // it. Hot-path parses (validate=false) skip the per-key match.
     if validate {
-        validate_header_geometry(&boxl_vec, &angles_vec, natm_types, &natms_per_type)?;
-        validate_masses(&masses_per_type)?;
-    }
-    Ok(FrameHeader {
-        prebox_header: PreboxHeader {
-            user: prebox1,
-            metadata_line: prebox2,
-        },
-        boxl: boxl_vec.try_into().unwrap(),
-        angles: angles_vec.try_into().unwrap(),
-        postbox_header: [postbox1, postbox2],
-        natm_types,
-        natms_per_type,
-        masses_per_type,
-        spec_version,
-        metadata,
-        sections,
-        strict_validation: validate,
-        sections_declared,
-    })
+        validate_metadata_schema(json_obj)?;
+    }
+
+    Ok((ver, metadata, sections, validate, sections_declared))
 }
 
 /// Parses a complete frame from a `.con` file, including its header and atomic data.
@@ -628,86 +863,352 @@ pub fn parse_frame_header<'a>(
 pub fn parse_single_frame<'a>(
     lines: &mut impl Iterator<Item = &'a str>,
 ) -> Result<ConFrame, ParseError> {
+    parse_single_frame_stream(&mut lines.peekable())
+}
+
+/// [`parse_single_frame`] over a [`LineStream`]. Coordinate blocks the
+/// stream hands out through [`LineStream::row_block`] are decoded in
+/// parallel (see [`crate::iterators::ConFrameIterator::with_intra_frame_parallel`]).
+pub fn parse_single_frame_stream<'a, L>(lines: &mut L) -> Result<ConFrame, ParseError>
+where
+    L: Iterator<Item = &'a str> + LineStream<'a>,
+{
     let header = parse_frame_header(lines)?;
-    let validate = header.strict_validation;
+    let dt = StorageDtypes::from_metadata(&header.metadata).unwrap_or_default();
+    let mut symbols = Vec::with_capacity(header.natms_per_type.len());
+    assemble_frame(lines, header, &dt, &mut symbols)
+}
+
+/// [`parse_single_frame_stream`] through a [`HeaderCache`] (see
+/// [`parse_frame_header_cached`]); the iterators' allocating path.
+pub fn parse_single_frame_cached<'a, L>(
+    lines: &mut L,
+    cache: &mut HeaderCache,
+) -> Result<ConFrame, ParseError>
+where
+    L: Iterator<Item = &'a str> + LineStream<'a>,
+{
+    let mut header = FrameHeader::default();
+    parse_frame_header_cached(lines, &mut header, cache)?;
+    assemble_frame(lines, header, &cache.dtypes, &mut cache.symbols)
+}
+
+/// Coordinate blocks after a parsed `header`, as a new [`ConFrame`].
+fn assemble_frame<'a, L>(
+    lines: &mut L,
+    header: FrameHeader,
+    dt: &StorageDtypes,
+    symbols: &mut Vec<Arc<str>>,
+) -> Result<ConFrame, ParseError>
+where
+    L: Iterator<Item = &'a str> + LineStream<'a>,
+{
     let total_atoms: usize = header.natms_per_type.iter().sum();
     let mut atom_data = Vec::with_capacity(total_atoms);
-    // SoA positions: default f64 fills a flat `Vec` then one Arc wrap (profile:
-    // per-row ArcArray mut checks were a real cost on multi-atom parse).
-    use crate::storage_dtype::{ElementKind, FloatArray2, StorageDtypes};
-    let dt = StorageDtypes::from_metadata(&header.metadata).unwrap_or_default();
-    let f64_positions = dt.positions == ElementKind::Float64;
-    let mut pos_flat = if f64_positions {
-        vec![0.0f64; total_atoms.saturating_mul(3)]
-    } else {
-        Vec::new()
+    let mut positions = PositionColumns::with_kind(dt.positions, total_atoms);
+    parse_coordinate_blocks(lines, &header, symbols, |atom_i, symbol, row| {
+        let (xyz, fixed, atom_id) = row;
+        positions.set(atom_i, xyz);
+        atom_data.push(AtomDatum {
+            // This is a cheap reference-count increment, not a full string clone.
+            symbol: Arc::clone(symbol),
+            x: xyz[0],
+            y: xyz[1],
+            z: xyz[2],
+            fixed,
+            atom_id,
+            velocity: None,
+            force: None,
+            energy: None,
+            charge: None,
+            spin: None,
+            magmom: None,
+        });
+    })?;
+    let _timer = stats::timer(Stage::Assemble);
+    stats::count(Counter::FramesRead, 1);
+    stats::count(Counter::BuffersAllocated, 1);
+    // Sections still attach to AoS; assemble uses prefilled positions (no second pos pass).
+    Ok(crate::types::con_frame_from_atom_data_with_positions(
+        header,
+        atom_data,
+        positions.finish(),
+    ))
+}
+
+/// [`parse_single_frame_stream`] into an existing frame, the recycling path
+/// of [`crate::iterators::ConFrameIterator::next_into`].
+///
+/// Header strings, the `atom_data` vector and the positions / masses / ids
+/// blocks keep their allocations when the atom count and storage dtypes are
+/// unchanged, and component symbols and repeated header lines come from
+/// `cache` (see [`HeaderCache`]), so a fixed-size trajectory refills
+/// without touching the allocator. Optional-section arrays are left as
+/// they are for the caller to refill or clear. On error `frame` holds a
+/// partial mix of old and new data.
+pub fn parse_single_frame_into<'a, L>(
+    lines: &mut L,
+    frame: &mut ConFrame,
+    cache: &mut HeaderCache,
+) -> Result<(), ParseError>
+where
+    L: Iterator<Item = &'a str> + LineStream<'a>,
+{
+    parse_frame_header_cached(lines, &mut frame.header, cache)?;
+    let HeaderCache { dtypes: dt, symbols, .. } = cache;
+    let ConFrame {
+        header,
+        atom_data,
+        positions,
+        ..
+    } = frame;
+    let total_atoms: usize = header.natms_per_type.iter().sum();
+    // Check shape and ownership before borrowing mutably, so a buffer still
+    // shared with an earlier frame is replaced rather than copied.
+    let reusable = dt.positions == ElementKind::Float64 && positions.nrows() == total_atoms;
+    let reused = if reusable { positions.unique_f64_slice_mut() } else { None };
+    let mut sink = match reused {
+        Some(flat) => PositionSink::Reused(flat),
+        None => PositionSink::Fresh(PositionColumns::with_kind(dt.positions, total_atoms)),
     };
-    let mut positions_other = if f64_positions {
-        None
+    atom_data.clear();
+    atom_data.reserve(total_atoms);
+    parse_coordinate_blocks(lines, header, symbols, |atom_i, symbol, row| {
+        let (xyz, fixed, atom_id) = row;
+        sink.set(atom_i, xyz);
+        atom_data.push(AtomDatum {
+            symbol: Arc::clone(symbol),
+            x: xyz[0],
+            y: xyz[1],
+            z: xyz[2],
+            fixed,
+            atom_id,
+            velocity: None,
+            force: None,
+            energy: None,
+            charge: None,
+            spin: None,
+            magmom: None,
+        });
+    })?;
+    let _timer = stats::timer(Stage::Assemble);
+    stats::count(Counter::FramesRead, 1);
+    if let PositionSink::Fresh(columns) = sink {
+        stats::count(Counter::BuffersAllocated, 1);
+        *positions = columns.finish();
     } else {
-        Some(FloatArray2::zeros(dt.positions, total_atoms, 3))
-    };
+        stats::count(Counter::BuffersReused, 1);
+    }
+    crate::types::refill_masses_and_ids(frame, dt);
+    Ok(())
+}
 
-    let mut global_atom_idx: u64 = 0;
-    let mut atom_i = 0usize;
-    for (type_idx, num_atoms) in header.natms_per_type.iter().enumerate() {
+/// Where [`parse_single_frame_into`] writes coordinates: the previous
+/// frame's f64 block when it has the right shape, else a new block.
+enum PositionSink<'b> {
+    Reused(&'b mut [f64]),
+    Fresh(PositionColumns),
+}
+
+impl PositionSink<'_> {
+    #[inline]
+    fn set(&mut self, atom_i: usize, xyz: [f64; 3]) {
+        match self {
+            Self::Reused(flat) => flat[atom_i * 3..atom_i * 3 + 3].copy_from_slice(&xyz),
+            Self::Fresh(columns) => columns.set(atom_i, xyz),
+        }
+    }
+}
+
+/// Parses one complete frame -- coordinates and every declared section --
+/// into a [`LeanFrame`], without building the per-atom `AtomDatum` vector.
+///
+/// Unlike [`parse_single_frame`], which leaves the sections to
+/// [`parse_declared_sections`], this consumes the whole frame: section rows
+/// are validated against and written into the SoA columns directly.
+pub fn parse_single_frame_lean<'a>(
+    lines: &mut impl Iterator<Item = &'a str>,
+) -> Result<LeanFrame, ParseError> {
+    parse_lean_frame_stream(&mut lines.peekable())
+}
+
+/// [`parse_single_frame_lean`] over a [`LineStream`].
+pub fn parse_lean_frame_stream<'a, L>(lines: &mut L) -> Result<LeanFrame, ParseError>
+where
+    L: Iterator<Item = &'a str> + LineStream<'a>,
+{
+    let mut header = parse_frame_header(lines)?;
+    let total_atoms: usize = header.natms_per_type.iter().sum();
+    let mut positions = PositionColumns::new(&header, total_atoms);
+    let mut fixed = Vec::with_capacity(total_atoms);
+    let mut atom_ids = Vec::with_capacity(total_atoms);
+    let mut symbols = Vec::with_capacity(header.natms_per_type.len());
+    parse_coordinate_blocks(lines, &header, &mut symbols, |atom_i, _, (xyz, f, atom_id)| {
+        positions.set(atom_i, xyz);
+        fixed.push(f);
+        atom_ids.push(atom_id);
+    })?;
+    let mut columns = LeanColumns::new(&header.natms_per_type, symbols, fixed, atom_ids);
+    parse_declared_sections(lines, &mut header, &mut columns)?;
+    let _timer = stats::timer(Stage::Assemble);
+    stats::count(Counter::FramesRead, 1);
+    stats::count(Counter::BuffersAllocated, 1);
+    Ok(columns.finish(header, positions.finish()))
+}
+
+/// Parses one frame without assembling any columns: each coordinate row
+/// goes to `push_atom(target, atom_idx, row)` as it is decoded, then
+/// `accept(header, symbols)` may reject the frame before the declared
+/// sections in `columns` are decoded into `target`. Returns the header.
+///
+/// For callers that own the destination buffers, such as the batched
+/// trajectory tensors, which write each row straight into its slab.
+pub(crate) fn parse_frame_rows_stream<'a, L, T>(
+    lines: &mut L,
+    target: &mut T,
+    columns: ColumnMask,
+    mut push_atom: impl FnMut(&mut T, usize, CoordinateRow),
+    accept: impl FnOnce(&FrameHeader, &[Arc<str>]) -> Result<(), ParseError>,
+) -> Result<FrameHeader, ParseError>
+where
+    L: Iterator<Item = &'a str> + LineStream<'a>,
+    T: SectionTarget + ?Sized,
+{
+    let mut header = parse_frame_header(lines)?;
+    let mut symbols = Vec::with_capacity(header.natms_per_type.len());
+    parse_coordinate_blocks(lines, &header, &mut symbols, |atom_i, _, row| {
+        push_atom(target, atom_i, row)
+    })?;
+    accept(&header, &symbols)?;
+    parse_declared_sections_projected(lines, &mut header, target, columns)?;
+    stats::count(Counter::FramesRead, 1);
+    Ok(header)
+}
+
+
+/// Reads the per-component coordinate blocks that follow the header,
+/// handing each atom to `push_atom(atom_idx, symbol, row)` in file order.
+///
+/// `symbols` receives the component symbols, one per entry of
+/// `natms_per_type`. Entries it already holds act as an intern table: a
+/// component whose symbol matches the entry at its index reuses that
+/// `Arc<str>` instead of allocating a new one.
+fn parse_coordinate_blocks<'a, L>(
+    lines: &mut L,
+    header: &FrameHeader,
+    symbols: &mut Vec<Arc<str>>,
+    mut push_atom: impl FnMut(usize, &Arc<str>, CoordinateRow),
+) -> Result<(), ParseError>
+where
+    L: Iterator<Item = &'a str> + LineStream<'a>,
+{
+    let _timer = stats::timer(Stage::Coordinates);
+    let validate = header.strict_validation;
+    let mut first_atom = 0usize;
+    for (type_idx, &num_atoms) in header.natms_per_type.iter().enumerate() {
         // Allocate the per-component Arc<str> directly from the trimmed
         // line; going through a String intermediate would add a second
         // allocation and copy for no semantic gain.
-        let symbol_line = lines.next().ok_or(ParseError::IncompleteFrame)?;
-        let symbol: Arc<str> = Arc::from(symbol_line.trim());
+        let symbol_line = lines.next().ok_or(ParseError::IncompleteFrame)?.trim();
+        let symbol: Arc<str> = match symbols.get(type_idx) {
+            Some(known) if &**known == symbol_line => Arc::clone(known),
+            _ => Arc::from(symbol_line),
+        };
         let coord_label = lines.next().ok_or(ParseError::IncompleteFrame)?;
         if validate {
             validate_coordinate_component(type_idx, symbol.as_ref(), coord_label)?;
         }
-        for _ in 0..*num_atoms {
-            let coord_line = lines.next().ok_or(ParseError::IncompleteFrame)?;
+        let parse_row = |atom_i: usize, coord_line: &str| -> Result<CoordinateRow, ParseError> {
+            if !validate {
+                return crate::scan::scalar_row(atom_i, coord_line);
+            }
             // Column 5 (atom_index) is optional; defaults to sequential index.
-            let defaults = [0.0, 0.0, 0.0, 0.0, global_atom_idx as f64];
+            let defaults = [0.0, 0.0, 0.0, 0.0, atom_i as f64];
             let mut vals = [0.0f64; 5];
             parse_line_of_range_f64_stack(coord_line, 4, 5, &defaults, &mut vals)?;
-            let (fixed, atom_id) = if validate {
-                parse_identity_columns(coord_line, "coordinate", 3, 4, 5)?
-            } else {
-                (decode_fixed_bitmask(vals[3] as u8), vals[4] as u64)
-            };
-            let xyz = [vals[0], vals[1], vals[2]];
-            if f64_positions {
-                let o = atom_i * 3;
-                pos_flat[o] = xyz[0];
-                pos_flat[o + 1] = xyz[1];
-                pos_flat[o + 2] = xyz[2];
-            } else if let Some(ref mut pos) = positions_other {
-                pos.set_f64_row(atom_i, xyz);
+            let (fixed, atom_id) = parse_identity_columns(coord_line, "coordinate", 3, 4, 5)?;
+            Ok(([vals[0], vals[1], vals[2]], fixed, atom_id))
+        };
+        match lines.row_block(num_atoms) {
+            Some(block) => {
+                let rows = decode_row_block(block, |k, line| parse_row(first_atom + k, line))?;
+                for (k, row) in rows.into_iter().enumerate() {
+                    push_atom(first_atom + k, &symbol, row);
+                }
+            }
+            None => match lines.remainder().filter(|_| !validate) {
+                Some(rest) => {
+                    let (used, result) =
+                        crate::scan::decode_coordinate_rows(rest, num_atoms, first_atom, |i, row| {
+                            push_atom(i, &symbol, row)
+                        });
+                    lines.consume(used);
+                    result?;
+                }
+                None => {
+                    for atom_i in first_atom..first_atom + num_atoms {
+                        let coord_line = lines.next().ok_or(ParseError::IncompleteFrame)?;
+                        push_atom(atom_i, &symbol, parse_row(atom_i, coord_line)?);
+                    }
+                }
+            },
+        }
+        first_atom += num_atoms;
+        if type_idx < symbols.len() {
+            symbols[type_idx] = symbol;
+        } else {
+            symbols.push(symbol);
+        }
+    }
+    symbols.truncate(header.natms_per_type.len());
+    Ok(())
+}
+
+/// SoA positions in the frame's storage dtype. Default f64 fills a flat
+/// `Vec` then one Arc wrap (profile: per-row ArcArray mut checks were a real
+/// cost on multi-atom parse).
+struct PositionColumns {
+    rows: usize,
+    flat: Vec<f64>,
+    other: Option<FloatArray2>,
+}
+
+impl PositionColumns {
+    fn new(header: &FrameHeader, rows: usize) -> Self {
+        let dt = StorageDtypes::from_metadata(&header.metadata).unwrap_or_default();
+        Self::with_kind(dt.positions, rows)
+    }
+
+    fn with_kind(kind: ElementKind, rows: usize) -> Self {
+        if kind == ElementKind::Float64 {
+            Self {
+                rows,
+                flat: vec![0.0f64; rows.saturating_mul(3)],
+                other: None,
+            }
+        } else {
+            Self {
+                rows,
+                flat: Vec::new(),
+                other: Some(FloatArray2::zeros(kind, rows, 3)),
             }
-            atom_data.push(AtomDatum {
-                // This is a cheap reference-count increment, not a full string clone.
-                symbol: Arc::clone(&symbol),
-                x: xyz[0],
-                y: xyz[1],
-                z: xyz[2],
-                fixed,
-                atom_id,
-                velocity: None,
-                force: None,
-                energy: None,
-                charge: None,
-                spin: None,
-                magmom: None,
-            });
-            global_atom_idx += 1;
-            atom_i += 1;
         }
     }
-    let positions = if f64_positions {
-        FloatArray2::from_f64_row_major(total_atoms, 3, pos_flat)
-    } else {
-        positions_other.expect("non-f64 positions allocated")
-    };
-    // Sections still attach to AoS; assemble uses prefilled positions (no second pos pass).
-    Ok(crate::types::con_frame_from_atom_data_with_positions(
-        header, atom_data, positions,
-    ))
+
+    #[inline]
+    fn set(&mut self, atom_i: usize, xyz: [f64; 3]) {
+        match self.other {
+            None => self.flat[atom_i * 3..atom_i * 3 + 3].copy_from_slice(&xyz),
+            Some(ref mut pos) => pos.set_f64_row(atom_i, xyz),
+        }
+    }
+
+    fn finish(self) -> FloatArray2 {
+        match self.other {
+            None => FloatArray2::from_f64_row_major(self.rows, 3, self.flat),
+            Some(pos) => pos,
+        }
+    }
 }
 
 fn validate_header_geometry(
@@ -806,6 +1307,143 @@ fn parse_identity_columns(
     Ok((decode_fixed_bitmask(fixed_flag), atom_id))
 }
 
+/// Decodes each line of `block` with `parse_row(row, line)`, `row` counting
+/// from zero at the start of the block. With the `parallel` feature the
+/// block is cut at newlines into a few chunks per Rayon worker; a cheap
+/// newline count per chunk gives each its first row before the chunks are
+/// parsed concurrently. Either way the first failing row in file order
+/// decides the error, as in the sequential loops.
+fn decode_row_block<R: Send>(
+    block: &str,
+    parse_row: impl Fn(usize, &str) -> Result<R, ParseError> + Sync,
+) -> Result<Vec<R>, ParseError> {
+    fn decode_chunk<R>(
+        chunk: &str,
+        first_row: usize,
+        parse_row: &impl Fn(usize, &str) -> Result<R, ParseError>,
+    ) -> Result<Vec<R>, ParseError> {
+        chunk
+            .split_terminator('\n')
+            .enumerate()
+            .map(|(k, line)| parse_row(first_row + k, line.strip_suffix('\r').unwrap_or(line)))
+            .collect()
+    }
+
+    #[cfg(feature = "parallel")]
+    {
+        use rayon::prelude::*;
+        let bytes = block.as_bytes();
+        let target = bytes
+            .len()
+            .div_ceil(rayon::current_num_threads() * 4)
+            .max(1);
+        let mut chunks = Vec::new();
+        let mut start = 0;
+        while start < bytes.len() {
+            let probe = (start + target).min(bytes.len() - 1);
+            let end = memchr::memchr(b'\n', &bytes[probe..]).map_or(bytes.len(), |i| probe + i + 1);
+            chunks.push(&block[start..end]);
+            start = end;
+        }
+        let rows_per_chunk: Vec<usize> = chunks
+            .par_iter()
+            .map(|c| {
+                memchr::memchr_iter(b'\n', c.as_bytes()).count() + usize::from(!c.ends_with('\n'))
+            })
+            .collect();
+        let first_rows: Vec<usize> = rows_per_chunk
+            .iter()
+            .scan(0, |row, n| {
+                let first = *row;
+                *row += n;
+                Some(first)
+            })
+            .collect();
+        let parts: Vec<Result<Vec<R>, ParseError>> = chunks
+            .par_iter()
+            .zip(first_rows)
+            .map(|(chunk, first)| decode_chunk(chunk, first, &parse_row))
+            .collect();
+        let mut rows = Vec::with_capacity(rows_per_chunk.iter().sum());
+        for part in parts {
+            rows.extend(part?);
+        }
+        Ok(rows)
+    }
+    #[cfg(not(feature = "parallel"))]
+    decode_chunk(block, 0, &parse_row)
+}
+
+/// Reads the `n` data rows of one section component starting at atom
+/// `first_atom`: `parse_row(atoms, atom_idx, line)` decodes (and in strict
+/// mode validates) a row, and `store(atoms, atom_idx, value)` attaches the
+/// result. Blocks the stream hands out via [`LineStream::row_block`] are
+/// decoded with [`decode_row_block`]; otherwise rows are read one by one.
+fn read_section_rows<'a, T: SectionTarget + ?Sized, R: Send>(
+    lines: &mut impl LineStream<'a>,
+    n: usize,
+    first_atom: usize,
+    atoms: &mut T,
+    missing: impl Fn() -> ParseError,
+    parse_row: impl Fn(&T, usize, &str) -> Result<R, ParseError> + Sync,
+    mut store: impl FnMut(&mut T, usize, R),
+) -> Result<(), ParseError> {
+    match lines.row_block(n) {
+        Some(block) => {
+            let shared: &T = atoms;
+            let rows = decode_row_block(block, |k, line| parse_row(shared, first_atom + k, line))?;
+            for (k, value) in rows.into_iter().enumerate() {
+                store(atoms, first_atom + k, value);
+            }
+        }
+        None => {
+            for atom_idx in first_atom..first_atom + n {
+                let line = lines.next_line().ok_or_else(&missing)?;
+                let value = parse_row(atoms, atom_idx, line)?;
+                store(atoms, atom_idx, value);
+            }
+        }
+    }
+    Ok(())
+}
+
+/// One `x y z fixed_flag atom_id` row of a velocity, force or magmom block.
+fn parse_vector_row(
+    atom_data: &(impl SectionTarget + ?Sized),
+    atom_idx: usize,
+    line: &str,
+    row_kind: &str,
+    validate: bool,
+) -> Result<[f64; 3], ParseError> {
+    // Column 5 (atom_index) is optional in section lines too.
+    let defaults = [0.0, 0.0, 0.0, 0.0, atom_idx as f64];
+    let mut vals = [0.0f64; 5];
+    parse_line_of_range_f64_stack(line, 4, 5, &defaults, &mut vals)?;
+    if validate {
+        let (fixed, atom_id) = parse_identity_columns(line, row_kind, 3, 4, 5)?;
+        validate_section_atom_identity(row_kind, atom_idx, fixed, atom_id, atom_data)?;
+    }
+    Ok([vals[0], vals[1], vals[2]])
+}
+
+/// One `value fixed_flag atom_id` row of an energy / charge / spin block;
+/// the two identity columns are optional outside strict mode.
+fn parse_scalar_row(
+    atom_data: &(impl SectionTarget + ?Sized),
+    atom_idx: usize,
+    line: &str,
+    row_kind: &str,
+    validate: bool,
+) -> Result<f64, ParseError> {
+    let defaults = [0.0, 0.0, atom_idx as f64];
+    let vals = parse_line_of_range_f64(line, 1, 3, &defaults)?;
+    if validate {
+        let (fixed, atom_id) = parse_identity_columns(line, row_kind, 1, 2, 3)?;
+        validate_section_atom_identity(row_kind, atom_idx, fixed, atom_id, atom_data)?;
+    }
+    Ok(vals[0])
+}
+
 
 fn validate_section_component(
     section: &str,
@@ -814,7 +1452,7 @@ fn validate_section_component(
     symbol: &str,
     label: &str,
     header: &FrameHeader,
-    atom_data: &[AtomDatum],
+    atom_data: &(impl SectionTarget + ?Sized),
 ) -> Result<(), ParseError> {
     let expected_label = format!("{section} of Component {}", type_idx + 1);
     if label.trim() != expected_label {
@@ -828,8 +1466,7 @@ fn validate_section_component(
     }
 
     let expected_symbol = atom_data
-        .get(atom_idx)
-        .map(|atom| atom.symbol.as_ref())
+        .atom_symbol(atom_idx)
         .ok_or_else(|| {
             ParseError::ValidationError(format!(
                 "{section} component {} has no coordinate atom to validate against",
@@ -851,24 +1488,22 @@ fn validate_section_atom_identity(
     atom_idx: usize,
     fixed: [bool; 3],
     atom_id: u64,
-    atom_data: &[AtomDatum],
+    atom_data: &(impl SectionTarget + ?Sized),
 ) -> Result<(), ParseError> {
-    let atom = atom_data.get(atom_idx).ok_or_else(|| {
+    let (expected_fixed, expected_id) = atom_data.atom_identity(atom_idx).ok_or_else(|| {
         ParseError::ValidationError(format!(
             "{section} row {atom_idx} has no coordinate atom to validate against"
         ))
     })?;
 
-    if atom.fixed != fixed {
+    if expected_fixed != fixed {
         return Err(ParseError::ValidationError(format!(
-            "{section} row {atom_idx} fixed mask mismatch for atom_id {}",
-            atom.atom_id
+            "{section} row {atom_idx} fixed mask mismatch for atom_id {expected_id}"
         )));
     }
-    if atom.atom_id != atom_id {
+    if expected_id != atom_id {
         return Err(ParseError::ValidationError(format!(
-            "{section} row {atom_idx} atom_id mismatch: expected {}, found {atom_id}",
-            atom.atom_id
+            "{section} row {atom_idx} atom_id mismatch: expected {expected_id}, found {atom_id}"
         )));
     }
 
@@ -890,7 +1525,7 @@ fn validate_section_atom_identity(
 pub fn parse_velocity_section<'a>(
     lines: &mut impl LineStream<'a>,
     header: &FrameHeader,
-    atom_data: &mut [AtomDatum],
+    atom_data: &mut (impl SectionTarget + ?Sized),
 ) -> Result<bool, ParseError> {
     let validate = header.strict_validation;
     // Peek at the next line to check for blank separator
@@ -928,22 +1563,16 @@ pub fn parse_velocity_section<'a>(
             )?;
         }
 
-        for _ in 0..num_atoms {
-            let vel_line = lines.next_line().ok_or(ParseError::IncompleteVelocitySection)?;
-            // Column 5 (atom_index) is optional in velocity lines too.
-            let defaults = [0.0, 0.0, 0.0, 0.0, atom_idx as f64];
-            let mut vals = [0.0f64; 5];
-            parse_line_of_range_f64_stack(vel_line, 4, 5, &defaults, &mut vals)?;
-            if validate {
-                let (fixed, atom_id) =
-                    parse_identity_columns(vel_line, "velocities", 3, 4, 5)?;
-                validate_section_atom_identity("velocities", atom_idx, fixed, atom_id, atom_data)?;
-            }
-            if atom_idx < atom_data.len() {
-                atom_data[atom_idx].velocity = Some([vals[0], vals[1], vals[2]]);
-            }
-            atom_idx += 1;
-        }
+        read_section_rows(
+            lines,
+            num_atoms,
+            atom_idx,
+            atom_data,
+            || ParseError::IncompleteVelocitySection,
+            |atoms, i, line| parse_vector_row(atoms, i, line, "velocities", validate),
+            |atoms, i, v| atoms.set_vector(VectorSection::Velocities, i, v),
+        )?;
+        atom_idx += num_atoms;
     }
 
     Ok(true)
@@ -959,7 +1588,7 @@ pub fn parse_velocity_section<'a>(
 pub fn parse_force_section<'a>(
     lines: &mut impl LineStream<'a>,
     header: &FrameHeader,
-    atom_data: &mut [AtomDatum],
+    atom_data: &mut (impl SectionTarget + ?Sized),
 ) -> Result<bool, ParseError> {
     let validate = header.strict_validation;
     // Peek at the next line to check for blank separator
@@ -987,21 +1616,16 @@ pub fn parse_force_section<'a>(
             )?;
         }
 
-        for _ in 0..num_atoms {
-            let force_line = lines.next_line().ok_or(ParseError::IncompleteForceSection)?;
-            let defaults = [0.0, 0.0, 0.0, 0.0, atom_idx as f64];
-            let mut vals = [0.0f64; 5];
-            parse_line_of_range_f64_stack(force_line, 4, 5, &defaults, &mut vals)?;
-            if validate {
-                let (fixed, atom_id) =
-                    parse_identity_columns(force_line, "forces", 3, 4, 5)?;
-                validate_section_atom_identity("forces", atom_idx, fixed, atom_id, atom_data)?;
-            }
-            if atom_idx < atom_data.len() {
-                atom_data[atom_idx].force = Some([vals[0], vals[1], vals[2]]);
-            }
-            atom_idx += 1;
-        }
+        read_section_rows(
+            lines,
+            num_atoms,
+            atom_idx,
+            atom_data,
+            || ParseError::IncompleteForceSection,
+            |atoms, i, line| parse_vector_row(atoms, i, line, "forces", validate),
+            |atoms, i, f| atoms.set_vector(VectorSection::Forces, i, f),
+        )?;
+        atom_idx += num_atoms;
     }
 
     Ok(true)
@@ -1022,7 +1646,7 @@ pub fn parse_force_section<'a>(
 pub fn parse_energy_section<'a>(
     lines: &mut impl LineStream<'a>,
     header: &FrameHeader,
-    atom_data: &mut [AtomDatum],
+    atom_data: &mut (impl SectionTarget + ?Sized),
 ) -> Result<bool, ParseError> {
     let validate = header.strict_validation;
     match lines.peek_line() {
@@ -1049,22 +1673,16 @@ pub fn parse_energy_section<'a>(
             )?;
         }
 
-        for _ in 0..num_atoms {
-            let energy_line = lines.next_line().ok_or(ParseError::IncompleteEnergySection)?;
-            // Single energy column, plus optional fixed flag and atom_id
-            // for round-trip identity checks.
-            let defaults = [0.0, 0.0, atom_idx as f64];
-            let vals = parse_line_of_range_f64(energy_line, 1, 3, &defaults)?;
-            if validate {
-                let (fixed, atom_id) =
-                    parse_identity_columns(energy_line, "energies", 1, 2, 3)?;
-                validate_section_atom_identity("energies", atom_idx, fixed, atom_id, atom_data)?;
-            }
-            if atom_idx < atom_data.len() {
-                atom_data[atom_idx].energy = Some(vals[0]);
-            }
-            atom_idx += 1;
-        }
+        read_section_rows(
+            lines,
+            num_atoms,
+            atom_idx,
+            atom_data,
+            || ParseError::IncompleteEnergySection,
+            |atoms, i, line| parse_scalar_row(atoms, i, line, "energies", validate),
+            |atoms, i, e| atoms.set_scalar(ScalarSection::Energies, i, e),
+        )?;
+        atom_idx += num_atoms;
     }
 
     Ok(true)
@@ -1078,19 +1696,49 @@ pub fn parse_energy_section<'a>(
 pub fn parse_declared_sections<'a>(
     lines: &mut impl LineStream<'a>,
     header: &mut FrameHeader,
-    atom_data: &mut [AtomDatum],
+    atom_data: &mut (impl SectionTarget + ?Sized),
 ) -> Result<usize, ParseError> {
+    parse_declared_sections_projected(lines, header, atom_data, ColumnMask::ALL)
+}
+
+/// [`parse_declared_sections`] decoding only the sections in `columns`.
+/// Every other section is skipped by line count, as
+/// [`crate::iterators::ConFrameIterator::forward_fast`] does, and removed
+/// from `header.sections`. Returns the number of sections decoded.
+pub fn parse_declared_sections_projected<'a>(
+    lines: &mut impl LineStream<'a>,
+    header: &mut FrameHeader,
+    atom_data: &mut (impl SectionTarget + ?Sized),
+    columns: ColumnMask,
+) -> Result<usize, ParseError> {
+    let _timer = stats::timer(Stage::Sections);
     let mut applied = 0usize;
     if !header.sections_declared && header.sections.is_empty() {
         // Legacy: try velocity detection via blank separator
+        if !columns.contains(ColumnMask::VELOCITIES) {
+            skip_section_block(lines, header, || ParseError::IncompleteVelocitySection)?;
+            return Ok(0);
+        }
         let found = parse_velocity_section(lines, header, atom_data)?;
         if found {
             header.sections.push(SECTION_VELOCITIES.into());
             applied = 1;
         }
     } else {
-        let sections = std::mem::take(&mut header.sections);
+        let mut sections = std::mem::take(&mut header.sections);
         for section in &sections {
+            if !columns.decodes_section(section) {
+                let missing = || match section.as_str() {
+                    SECTION_VELOCITIES => ParseError::IncompleteVelocitySection,
+                    SECTION_FORCES => ParseError::IncompleteForceSection,
+                    SECTION_ENERGIES => ParseError::IncompleteEnergySection,
+                    other => ParseError::IncompleteSection(other.into()),
+                };
+                if !skip_section_block(lines, header, missing)? {
+                    return Err(missing());
+                }
+                continue;
+            }
             match section.as_str() {
                 SECTION_VELOCITIES => {
                     let found = parse_velocity_section(lines, header, atom_data)?;
@@ -1137,20 +1785,47 @@ pub fn parse_declared_sections<'a>(
                 other => return Err(ParseError::UnknownSection(other.to_string())),
             }
         }
+        if columns != ColumnMask::ALL {
+            sections.retain(|section| columns.decodes_section(section));
+        }
         header.sections = sections;
     }
     Ok(applied)
 }
 
+/// Consumes one blank-separated section block (symbol and label line per
+/// component plus one row per atom) without decoding it. Returns
+/// `Ok(false)`, consuming nothing, when no blank separator follows;
+/// `missing` is reported if the block is cut short.
+fn skip_section_block<'a>(
+    lines: &mut impl LineStream<'a>,
+    header: &FrameHeader,
+    missing: impl Fn() -> ParseError,
+) -> Result<bool, ParseError> {
+    match lines.peek_line() {
+        Some(line) if line.trim().is_empty() => {
+            lines.next_line();
+        }
+        _ => return Ok(false),
+    }
+    let total_atoms: usize = header.natms_per_type.iter().sum();
+    for _ in 0..total_atoms + header.natm_types * 2 {
+        if lines.next_line().is_none() {
+            return Err(missing());
+        }
+    }
+    Ok(true)
+}
+
 /// Scalar per-atom section: blank separator + per-type blocks
 /// (`symbol`, `"X of Component N"`, lines `value fixed atom_id`).
 fn parse_scalar_atom_section<'a>(
     lines: &mut impl LineStream<'a>,
     header: &FrameHeader,
-    atom_data: &mut [AtomDatum],
+    atom_data: &mut (impl SectionTarget + ?Sized),
     section_name: &str,
     component_label: &str,
-    mut set_value: impl FnMut(&mut AtomDatum, f64),
+    section: ScalarSection,
 ) -> Result<bool, ParseError> {
     let validate = header.strict_validation;
     match lines.peek_line() {
@@ -1185,22 +1860,16 @@ fn parse_scalar_atom_section<'a>(
             )?;
         }
 
-        for _ in 0..num_atoms {
-            let data_line = lines
-                .next_line()
-                .ok_or_else(|| ParseError::IncompleteSection(section_name.into()))?;
-            let defaults = [0.0, 0.0, atom_idx as f64];
-            let vals = parse_line_of_range_f64(data_line, 1, 3, &defaults)?;
-            if validate {
-                let (fixed, atom_id) =
-                    parse_identity_columns(data_line, section_name, 1, 2, 3)?;
-                validate_section_atom_identity(section_name, atom_idx, fixed, atom_id, atom_data)?;
-            }
-            if atom_idx < atom_data.len() {
-                set_value(&mut atom_data[atom_idx], vals[0]);
-            }
-            atom_idx += 1;
-        }
+        read_section_rows(
+            lines,
+            num_atoms,
+            atom_idx,
+            atom_data,
+            || ParseError::IncompleteSection(section_name.into()),
+            |atoms, i, line| parse_scalar_row(atoms, i, line, section_name, validate),
+            |atoms, i, v| atoms.set_scalar(section, i, v),
+        )?;
+        atom_idx += num_atoms;
     }
     Ok(true)
 }
@@ -1208,7 +1877,7 @@ fn parse_scalar_atom_section<'a>(
 pub fn parse_charge_section<'a>(
     lines: &mut impl LineStream<'a>,
     header: &FrameHeader,
-    atom_data: &mut [AtomDatum],
+    atom_data: &mut (impl SectionTarget + ?Sized),
 ) -> Result<bool, ParseError> {
     parse_scalar_atom_section(
         lines,
@@ -1216,14 +1885,14 @@ pub fn parse_charge_section<'a>(
         atom_data,
         SECTION_CHARGES,
         "Charges of Component",
-        |a, v| a.charge = Some(v),
+        ScalarSection::Charges,
     )
 }
 
 pub fn parse_spin_section<'a>(
     lines: &mut impl LineStream<'a>,
     header: &FrameHeader,
-    atom_data: &mut [AtomDatum],
+    atom_data: &mut (impl SectionTarget + ?Sized),
 ) -> Result<bool, ParseError> {
     parse_scalar_atom_section(
         lines,
@@ -1231,7 +1900,7 @@ pub fn parse_spin_section<'a>(
         atom_data,
         SECTION_SPINS,
         "Spins of Component",
-        |a, v| a.spin = Some(v),
+        ScalarSection::Spins,
     )
 }
 
@@ -1239,7 +1908,7 @@ pub fn parse_spin_section<'a>(
 pub fn parse_magmom_section<'a>(
     lines: &mut impl LineStream<'a>,
     header: &FrameHeader,
-    atom_data: &mut [AtomDatum],
+    atom_data: &mut (impl SectionTarget + ?Sized),
 ) -> Result<bool, ParseError> {
     let validate = header.strict_validation;
     match lines.peek_line() {
@@ -1274,29 +1943,16 @@ pub fn parse_magmom_section<'a>(
             )?;
         }
 
-        for _ in 0..num_atoms {
-            let mm_line = lines
-                .next_line()
-                .ok_or_else(|| ParseError::IncompleteSection(SECTION_MAGMOMS.into()))?;
-            let defaults = [0.0, 0.0, 0.0, 0.0, atom_idx as f64];
-            let mut vals = [0.0f64; 5];
-            parse_line_of_range_f64_stack(mm_line, 4, 5, &defaults, &mut vals)?;
-            if validate {
-                let (fixed, atom_id) =
-                    parse_identity_columns(mm_line, SECTION_MAGMOMS, 3, 4, 5)?;
-                validate_section_atom_identity(
-                    SECTION_MAGMOMS,
-                    atom_idx,
-                    fixed,
-                    atom_id,
-                    atom_data,
-                )?;
-            }
-            if atom_idx < atom_data.len() {
-                atom_data[atom_idx].magmom = Some([vals[0], vals[1], vals[2]]);
-            }
-            atom_idx += 1;
-        }
+        read_section_rows(
+            lines,
+            num_atoms,
+            atom_idx,
+            atom_data,
+            || ParseError::IncompleteSection(SECTION_MAGMOMS.into()),
+            |atoms, i, line| parse_vector_row(atoms, i, line, SECTION_MAGMOMS, validate),
+            |atoms, i, m| atoms.set_vector(VectorSection::Magmoms, i, m),
+        )?;
+        atom_idx += num_atoms;
     }
     Ok(true)
 }
@@ -2251,4 +2907,76 @@ Coordinates of Component 1
         assert_eq!(frame.atom_data[2].atom_id, 2);
         assert!(frame.atom_data[2].is_fixed());
     }
+
+    fn one_atom_frame(metadata: &str, mass: &str, x: f64) -> String {
+        format!(
+            "PREBOX1\n{metadata}\n10.0 20.0 30.0\n90.0 90.0 90.0\nPOSTBOX1\nPOSTBOX2\n1\n1\n\
+             {mass}\nCu\nCoordinates of Component 1\n{x} 0.0 0.0 0 0\n"
+        )
+    }
+
+    #[test]
+    fn header_cache_tracks_changed_header_lines() {
+        let plain = r#"{"con_spec_version":2}"#;
+        let tagged = r#"{"con_spec_version":2,"potential":"eam"}"#;
+        let text = [
+            one_atom_frame(plain, "63.546", 0.0),
+            one_atom_frame(plain, "63.546", 1.0),
+            one_atom_frame(tagged, "63.546", 2.0),
+            one_atom_frame(tagged, "1.008", 3.0),
+        ]
+        .concat();
+        let uncached: Vec<ConFrame> = {
+            let mut lines = text.lines().peekable();
+            std::iter::from_fn(|| {
+                lines.peek()?;
+                Some(parse_single_frame_stream(&mut lines).expect("frame"))
+            })
+            .collect()
+        };
+        let cached: Vec<ConFrame> = ConFrameIterator::new(&text).map(|f| f.unwrap()).collect();
+        assert_eq!(cached, uncached);
+        assert!(!cached[1].header.metadata.contains_key("potential"));
+        assert_eq!(cached[2].header.metadata["potential"], "eam");
+        assert_eq!(cached[3].header.masses_per_type, vec![1.008]);
+
+        let mut recycled = ConFrame::default();
+        let mut it = ConFrameIterator::new(&text);
+        for want in &uncached {
+            it.next_into(&mut recycled).unwrap().unwrap();
+            assert_eq!(&recycled, want);
+        }
+    }
+
+    #[test]
+    fn header_cache_revalidates_when_strict_mode_turns_on() {
+        // Same layout lines, so only the metadata changes between frames:
+        // the mass check skipped for the lax frame must still run.
+        let strict = r#"{"con_spec_version":2,"sections":[],"validate":true}"#;
+        let mut cache = HeaderCache::new();
+        let mut header = FrameHeader::default();
+        let mut parse =
+            |text: &str| parse_frame_header_cached(&mut text.lines(), &mut header, &mut cache);
+        assert!(parse(&one_atom_frame(r#"{"con_spec_version":2}"#, "-1.0", 0.0)).is_ok());
+        let err = parse(&one_atom_frame(strict, "-1.0", 0.0)).unwrap_err();
+        assert!(err.to_string().contains("masses"), "{err}");
+        assert!(parse(&one_atom_frame(strict, "63.546", 0.0)).is_ok());
+    }
+
+    #[test]
+    fn header_cache_does_not_remember_failed_metadata() {
+        let good = one_atom_frame(r#"{"con_spec_version":2}"#, "63.546", 0.0);
+        let bad = one_atom_frame(r#"{"con_spec_version":2"#, "63.546", 0.0);
+        let mut cache = HeaderCache::new();
+        let mut header = FrameHeader::default();
+        let mut parse =
+            |text: &str| parse_frame_header_cached(&mut text.lines(), &mut header, &mut cache);
+        assert!(parse(&good).is_ok());
+        for _ in 0..2 {
+            let err = parse(&bad).unwrap_err();
+            assert!(matches!(err, ParseError::InvalidMetadataJson(_)), "{err:?}");
+        }
+        assert!(parse(&good).is_ok());
+        assert_eq!(header.spec_version, 2);
+    }
 }
@@ -0,0 +1,150 @@
+//! Bounded background stage shared by the pipelined readers.
+//!
+//! A [`Stage`] is one worker thread between two bounded
+//! `mpsc::sync_channel`s: jobs go in, results come back in the order the
+//! worker produced them. [`crate::iterators::ParallelFrameIterator`] feeds
+//! it windows of frame spans; [`crate::prefetch::FramePrefetcher`] uses a
+//! [`Stage::source`], whose worker produces results on its own. Dropping the
+//! stage disconnects both channels, so a worker blocked on either side
+//! wakes and exits, and then joins it.
+
+use std::sync::mpsc::{Receiver, SyncSender, sync_channel};
+use std::thread::JoinHandle;
+
+/// Starts a worker body on some thread, returning its handle if the stage
+/// must join it.
+pub(crate) type Launch<'a> =
+    dyn FnOnce(Box<dyn FnOnce() + Send + 'a>) -> Option<JoinHandle<()>> + 'a;
+
+/// Runs the worker on a plain thread, joined when the stage drops.
+pub(crate) fn detached() -> Box<Launch<'static>> {
+    Box::new(|body| Some(std::thread::spawn(body)))
+}
+
+/// Runs the worker on `scope`, which joins it; lets the worker borrow data
+/// that lives as long as the scope.
+#[cfg(feature = "parallel")]
+pub(crate) fn scoped<'a>(scope: &'a std::thread::Scope<'a, '_>) -> Box<Launch<'a>> {
+    Box::new(move |body| {
+        scope.spawn(body);
+        None
+    })
+}
+
+/// Result side handed to a stage's worker.
+pub(crate) struct Emit<R>(SyncSender<R>);
+
+impl<R> Emit<R> {
+    /// Queues `result`, blocking while the queue is full; `false` once the
+    /// stage is gone and the worker should return.
+    pub(crate) fn send(&self, result: R) -> bool {
+        self.0.send(result).is_ok()
+    }
+}
+
+/// One background worker with bounded job and result queues.
+pub(crate) struct Stage<J, R> {
+    jobs: Option<SyncSender<J>>,
+    results: Option<Receiver<R>>,
+    /// Joined on drop; `None` for a scoped worker, which its scope joins.
+    thread: Option<JoinHandle<()>>,
+}
+
+impl<J: Send, R: Send> Stage<J, R> {
+    /// Starts `body` with the job queue (`jobs` deep) and result queue
+    /// (`results` deep). The worker should return once the job queue
+    /// disconnects or [`Emit::send`] fails.
+    pub(crate) fn spawn<'a>(
+        jobs: usize,
+        results: usize,
+        launch: Box<Launch<'a>>,
+        body: impl FnOnce(Receiver<J>, Emit<R>) + Send + 'a,
+    ) -> Self
+    where
+        J: 'a,
+        R: 'a,
+    {
+        let (job_tx, job_rx) = sync_channel(jobs);
+        let (result_tx, result_rx) = sync_channel(results);
+        let thread = launch(Box::new(move || body(job_rx, Emit(result_tx))));
+        Self {
+            jobs: Some(job_tx),
+            results: Some(result_rx),
+            thread,
+        }
+    }
+
+    /// Queues `job`, blocking while the queue is full; `false` once the
+    /// worker is gone (it returned or panicked).
+    #[cfg_attr(not(feature = "parallel"), allow(dead_code))]
+    pub(crate) fn send(&self, job: J) -> bool {
+        self.jobs.as_ref().is_some_and(|jobs| jobs.send(job).is_ok())
+    }
+
+    /// Blocks for the next result; `None` once the worker is gone and every
+    /// queued result is delivered.
+    pub(crate) fn recv(&self) -> Option<R> {
+        self.results.as_ref()?.recv().ok()
+    }
+}
+
+impl<R: Send> Stage<(), R> {
+    /// A stage without jobs: `body` produces results on its own until it
+    /// is done or [`Emit::send`] fails.
+    pub(crate) fn source<'a>(
+        results: usize,
+        launch: Box<Launch<'a>>,
+        body: impl FnOnce(Emit<R>) + Send + 'a,
+    ) -> Self
+    where
+        R: 'a,
+    {
+        let mut stage = Self::spawn(0, results, launch, move |_jobs, emit| body(emit));
+        stage.jobs = None;
+        stage
+    }
+}
+
+impl<J, R> Drop for Stage<J, R> {
+    fn drop(&mut self) {
+        drop(self.jobs.take());
+        drop(self.results.take());
+        if let Some(thread) = self.thread.take() {
+            let _ = thread.join();
+        }
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    #[test]
+    fn results_keep_order_and_drop_stops_a_blocked_worker() {
+        let stage = Stage::spawn(1, 1, detached(), |jobs: Receiver<u32>, out| {
+            while let Ok(job) = jobs.recv() {
+                if !out.send(job * 2) {
+                    return;
+                }
+            }
+        });
+        assert!(stage.send(1) && stage.send(2));
+        assert_eq!((stage.recv(), stage.recv()), (Some(2), Some(4)));
+        drop(stage);
+
+        // A source worker blocked on a full queue wakes and exits on drop.
+        let produced = std::sync::Arc::new(std::sync::atomic::AtomicUsize::new(0));
+        let count = std::sync::Arc::clone(&produced);
+        let source = Stage::source(1, detached(), move |out| {
+            for k in 0.. {
+                count.fetch_add(1, std::sync::atomic::Ordering::Relaxed);
+                if !out.send(k) {
+                    return;
+                }
+            }
+        });
+        assert_eq!(source.recv(), Some(0));
+        drop(source);
+        assert!(produced.load(std::sync::atomic::Ordering::Relaxed) <= 3);
+    }
+}
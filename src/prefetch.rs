@@ -0,0 +1,345 @@
+//! **Random access and background prefetch** over a loaded trajectory.
+//!
+//! [`IndexedTrajectory`] keeps a file's text (memory-mapped when large, see
+//! [`crate::compression::read_file_contents`]) together with the byte span of
+//! every frame. Spans come from a fresh `.con.idx` sidecar when there is one
+//! and from a [`ConFrameIterator::forward_fast`] walk otherwise, so the open
+//! costs one skip scan and any frame then parses on its own.
+//!
+//! [`FramePrefetcher`] parses a sequence of those frames on a background
+//! thread and hands them over in order through a bounded queue. The thread
+//! works in batches of `depth` frames (decoded on the Rayon pool with the
+//! `parallel` feature) and blocks once `depth` parsed frames are waiting, so
+//! at most about `2 * depth` frames sit ahead of the consumer. Dropping the
+//! prefetcher stops the thread; the worker, queues and shutdown are the
+//! same stage the `parallel` feature's `ParallelFrameIterator` runs. Frames
+//! handed back through [`FramePrefetcher::recycle`] are refilled in place by
+//! the worker (see [`ConFrameIterator::next_into`]), so a steady loop stops
+//! allocating.
+
+use crate::compression::FileContents;
+use crate::error::ParseError;
+use crate::index_proj::FrameByteSpan;
+use crate::iterators::ConFrameIterator;
+use crate::offset_index::FrameOffsetIndex;
+use crate::types::{ColumnMask, ConFrame};
+use std::path::Path;
+use std::sync::{Arc, Mutex};
+
+/// Frames queued ahead by [`FramePrefetcher`] unless the caller picks a depth.
+pub const DEFAULT_PREFETCH_DEPTH: usize = 16;
+
+/// A trajectory held in memory with the byte span of each frame.
+pub struct IndexedTrajectory {
+    contents: FileContents,
+    spans: Vec<FrameByteSpan>,
+}
+
+impl IndexedTrajectory {
+    /// Loads `path` (gzip / zstd inflated in memory) and locates its frames.
+    pub fn open(path: &Path) -> Result<Self, Box<dyn std::error::Error>> {
+        let contents = crate::compression::read_file_contents(path)?;
+        let text = contents.as_str()?;
+        let indexed = FrameOffsetIndex::load_fresh(path).map(|index| {
+            index.entries.iter().map(|e| e.span()).collect::<Vec<_>>()
+        });
+        let spans = match indexed {
+            Some(spans) if spans_fit(text, &spans) => spans,
+            _ => scan_spans(text)?,
+        };
+        Ok(Self { contents, spans })
+    }
+
+    /// Takes ownership of an in-memory CON buffer.
+    pub fn from_string(text: String) -> Result<Self, ParseError> {
+        let spans = scan_spans(&text)?;
+        Ok(Self {
+            contents: FileContents::Owned(text),
+            spans,
+        })
+    }
+
+    /// Number of frames.
+    pub fn len(&self) -> usize {
+        self.spans.len()
+    }
+
+    #[must_use]
+    pub fn is_empty(&self) -> bool {
+        self.spans.is_empty()
+    }
+
+    /// Byte span of frame `i` within [`Self::text`].
+    pub fn span(&self, i: usize) -> Option<FrameByteSpan> {
+        self.spans.get(i).copied()
+    }
+
+    /// The whole trajectory text.
+    pub fn text(&self) -> &str {
+        match &self.contents {
+            FileContents::Owned(s) => s,
+            // SAFETY: validated as UTF-8 when the trajectory was opened; the
+            // mapping is read-only.
+            FileContents::Mapped(m) => unsafe { std::str::from_utf8_unchecked(m) },
+        }
+    }
+
+    /// Exact text of frame `i`.
+    pub fn raw_frame(&self, i: usize) -> Option<&str> {
+        self.span(i)?.slice(self.text())
+    }
+
+    /// Parses frame `i`, decoding only `columns`; `None` past the end.
+    pub fn frame(&self, i: usize, columns: ColumnMask) -> Option<Result<ConFrame, ParseError>> {
+        let mut frame = ConFrame::default();
+        Some(self.frame_into(i, columns, &mut frame)?.map(|()| frame))
+    }
+
+    /// [`Self::frame`] into `frame`, reusing its buffers.
+    pub fn frame_into(
+        &self,
+        i: usize,
+        columns: ColumnMask,
+        frame: &mut ConFrame,
+    ) -> Option<Result<(), ParseError>> {
+        let raw = self.raw_frame(i)?;
+        Some(
+            ConFrameIterator::new(raw)
+                .with_projection(columns)
+                .next_into(frame)
+                .unwrap_or(Err(ParseError::IncompleteFrame)),
+        )
+    }
+}
+
+/// Sidecar spans are only trusted if they address whole lines of `text`.
+fn spans_fit(text: &str, spans: &[FrameByteSpan]) -> bool {
+    spans.iter().all(|s| {
+        s.start <= s.end
+            && s.end <= text.len()
+            && text.is_char_boundary(s.start)
+            && text.is_char_boundary(s.end)
+    })
+}
+
+/// Frame spans by the skip walk [`crate::iterators::count_frames`] uses.
+fn scan_spans(text: &str) -> Result<Vec<FrameByteSpan>, ParseError> {
+    let mut spans = Vec::new();
+    let mut it = ConFrameIterator::new(text);
+    loop {
+        let start = it.byte_offset();
+        match it.forward_fast() {
+            Some(Ok(())) => spans.push(FrameByteSpan {
+                start,
+                end: it.byte_offset(),
+            }),
+            Some(Err(e)) => return Err(e),
+            None => return Ok(spans),
+        }
+    }
+}
+
+/// One prefetched frame: its index in the trajectory and the parse result.
+pub type PrefetchedFrame = (usize, Result<ConFrame, ParseError>);
+
+/// Parses frames of an [`IndexedTrajectory`] ahead of the consumer on a
+/// background thread; iterate it to receive them in the requested order.
+pub struct FramePrefetcher {
+    worker: crate::pipeline::Stage<(), PrefetchedFrame>,
+    /// Spent frames the worker refills before allocating new ones.
+    pool: Arc<FramePool>,
+}
+
+/// At most `cap` spare frames shared between consumer and worker.
+struct FramePool {
+    frames: Mutex<Vec<ConFrame>>,
+    cap: usize,
+}
+
+impl FramePool {
+    fn take(&self) -> ConFrame {
+        self.frames.lock().ok().and_then(|mut f| f.pop()).unwrap_or_default()
+    }
+
+    fn give(&self, frame: ConFrame) {
+        if let Ok(mut frames) = self.frames.lock()
+            && frames.len() < self.cap
+        {
+            frames.push(frame);
+        }
+    }
+}
+
+impl FramePrefetcher {
+    /// Starts parsing `frames` (indices into `source`, in delivery order)
+    /// with projection `columns`, keeping up to `depth` (at least 1) parsed
+    /// frames queued. Indices past the end are skipped.
+    pub fn spawn<I>(
+        source: Arc<IndexedTrajectory>,
+        frames: I,
+        depth: usize,
+        columns: ColumnMask,
+    ) -> Self
+    where
+        I: IntoIterator<Item = usize>,
+        I::IntoIter: Send + 'static,
+    {
+        let depth = depth.max(1);
+        let n = source.len();
+        let mut frames = frames.into_iter().filter(move |&i| i < n);
+        let pool = Arc::new(FramePool {
+            frames: Mutex::new(Vec::new()),
+            cap: depth,
+        });
+        let worker_pool = Arc::clone(&pool);
+        let launch = crate::pipeline::detached();
+        let worker = crate::pipeline::Stage::source(depth, launch, move |out| {
+            loop {
+                let batch: Vec<usize> = frames.by_ref().take(depth).collect();
+                if batch.is_empty() {
+                    return;
+                }
+                for item in parse_batch(&source, &worker_pool, batch, columns) {
+                    if !out.send(item) {
+                        return;
+                    }
+                }
+            }
+        });
+        Self { worker, pool }
+    }
+
+    /// Hands a frame the consumer is done with back to the worker, which
+    /// parses a later frame into its buffers. Extra frames beyond the queue
+    /// depth are dropped.
+    pub fn recycle(&self, frame: ConFrame) {
+        self.pool.give(frame);
+    }
+}
+
+fn parse_one(
+    source: &IndexedTrajectory,
+    pool: &FramePool,
+    i: usize,
+    columns: ColumnMask,
+) -> PrefetchedFrame {
+    let mut frame = pool.take();
+    let result = source
+        .frame_into(i, columns, &mut frame)
+        .unwrap_or(Err(ParseError::IncompleteFrame));
+    (i, result.map(|()| frame))
+}
+
+#[cfg(feature = "parallel")]
+fn parse_batch(
+    source: &IndexedTrajectory,
+    pool: &FramePool,
+    batch: Vec<usize>,
+    columns: ColumnMask,
+) -> Vec<PrefetchedFrame> {
+    use rayon::prelude::*;
+    batch
+        .into_par_iter()
+        .map(|i| parse_one(source, pool, i, columns))
+        .collect()
+}
+
+#[cfg(not(feature = "parallel"))]
+fn parse_batch(
+    source: &IndexedTrajectory,
+    pool: &FramePool,
+    batch: Vec<usize>,
+    columns: ColumnMask,
+) -> Vec<PrefetchedFrame> {
+    batch
+        .into_iter()
+        .map(|i| parse_one(source, pool, i, columns))
+        .collect()
+}
+
+impl Iterator for FramePrefetcher {
+    type Item = PrefetchedFrame;
+
+    /// Blocks until the next frame is parsed; `None` once all are delivered.
+    fn next(&mut self) -> Option<Self::Item> {
+        self.worker.recv()
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use std::path::PathBuf;
+
+    fn fixture() -> PathBuf {
+        PathBuf::from(env!("CARGO_MANIFEST_DIR")).join("resources/test/tiny_multi_cuh2.con")
+    }
+
+    #[test]
+    fn spans_match_sequential_parse() {
+        let traj = IndexedTrajectory::open(&fixture()).unwrap();
+        let text = std::fs::read_to_string(fixture()).unwrap();
+        let expected: Vec<ConFrame> = ConFrameIterator::new(&text).map(|f| f.unwrap()).collect();
+        assert_eq!(traj.len(), expected.len());
+        for (i, want) in expected.iter().enumerate().rev() {
+            assert_eq!(&traj.frame(i, ColumnMask::ALL).unwrap().unwrap(), want);
+        }
+        assert!(traj.frame(expected.len(), ColumnMask::ALL).is_none());
+        assert_eq!(
+            crate::index_proj::frame_byte_spans(&text).unwrap(),
+            (0..traj.len()).map(|i| traj.span(i).unwrap()).collect::<Vec<_>>()
+        );
+    }
+
+    #[test]
+    fn sidecar_spans_are_used_when_fresh() {
+        let dir = tempfile::tempdir().expect("tempdir");
+        let path = dir.path().join("multi.con");
+        std::fs::copy(fixture(), &path).unwrap();
+        let scanned = IndexedTrajectory::open(&path).unwrap();
+        FrameOffsetIndex::build_for_path(&path)
+            .unwrap()
+            .write_sidecar(&path)
+            .unwrap();
+        let indexed = IndexedTrajectory::open(&path).unwrap();
+        assert_eq!(indexed.spans, scanned.spans);
+    }
+
+    #[test]
+    fn prefetcher_delivers_in_order_and_stops_early() {
+        let one = std::fs::read_to_string(fixture()).unwrap();
+        let traj = Arc::new(IndexedTrajectory::from_string(one.repeat(10)).unwrap());
+        assert_eq!(traj.len(), 20);
+        let frames = (1..40).step_by(3);
+        let got: Vec<usize> = FramePrefetcher::spawn(Arc::clone(&traj), frames, 2, ColumnMask::NONE)
+            .map(|(i, frame)| {
+                assert!(frame.unwrap().atom_data.is_empty());
+                i
+            })
+            .collect();
+        assert_eq!(got, (1..20).step_by(3).collect::<Vec<_>>());
+
+        // Dropping mid-stream joins a worker that is blocked on the queue.
+        let mut early = FramePrefetcher::spawn(Arc::clone(&traj), 0..20, 1, ColumnMask::ALL);
+        let (i, frame) = early.next().unwrap();
+        assert_eq!(i, 0);
+        assert_eq!(frame.unwrap(), traj.frame(0, ColumnMask::ALL).unwrap().unwrap());
+        drop(early);
+        assert_eq!(Arc::strong_count(&traj), 1);
+    }
+
+    #[test]
+    fn recycled_frames_are_refilled() {
+        let one = std::fs::read_to_string(fixture()).unwrap();
+        let traj = Arc::new(IndexedTrajectory::from_string(one.repeat(5)).unwrap());
+        let mut frames = FramePrefetcher::spawn(Arc::clone(&traj), 0..10, 1, ColumnMask::ALL);
+        for want in 0..10 {
+            let (i, frame) = frames.next().unwrap();
+            let frame = frame.unwrap();
+            assert_eq!(i, want);
+            assert_eq!(frame, traj.frame(i, ColumnMask::ALL).unwrap().unwrap());
+            frames.recycle(frame);
+        }
+        assert!(frames.next().is_none());
+    }
+}
@@ -2,16 +2,19 @@ use ndarray::Array2;
 use numpy::{IntoPyArray, PyArray1, PyArray2};
 use pyo3::IntoPyObjectExt;
 use pyo3::exceptions::PyIOError;
+use pyo3::exceptions::PyIndexError;
 use pyo3::exceptions::PyTypeError;
 use pyo3::exceptions::PyValueError;
 use pyo3::prelude::*;
-use pyo3::types::{IntoPyDict, PyDict, PyIterator, PyList, PyTuple};
+use pyo3::types::{IntoPyDict, PyDict, PyIterator, PyList, PySlice, PyTuple};
 use serde_json::{Number, Value};
 use std::collections::BTreeMap;
 use std::path::Path;
+use std::sync::Arc;
 
 use crate::iterators::ConFrameIterator;
-use crate::types::{AtomDatum, ConFrame, ConFrameBuilder, meta};
+use crate::types::{AtomDatum, ColumnMask, ConFrame, ConFrameBuilder, meta};
+use crate::parallel_writer::{ChunkCompression, ParallelConWriter};
 use crate::writer::ConFrameWriter;
 
 /// Python-visible atom data.
@@ -978,17 +981,53 @@ impl PyConFrame {
 #[pyfunction]
 #[pyo3(name = "read_all_frames")]
 fn read_all_frames(py: Python<'_>, path: &str) -> PyResult<Vec<PyConFrame>> {
-    read_con(py, path)
+    read_con(py, path, None, None)
 }
 
+/// Map ``columns=[...]`` section names to a [`ColumnMask`]; ``None`` keeps
+/// every section.
+fn column_mask(columns: Option<Vec<String>>) -> PyResult<ColumnMask> {
+    let Some(names) = columns else {
+        return Ok(ColumnMask::ALL);
+    };
+    let mut mask = ColumnMask::NONE;
+    for name in &names {
+        mask |= ColumnMask::from_name(name)
+            .ok_or_else(|| PyValueError::new_err(format!("unknown column {name:?}")))?;
+    }
+    Ok(mask)
+}
+
+/// Read all frames from a .con or .convel file path.
+///
+/// ``threads`` pins the number of decode workers (pipelined parallel parse,
+/// frames kept in file order) and ``threads=0`` runs that parse on the
+/// global pool; the default picks sequential or parallel decoding by file
+/// size on the global pool.
+///
+/// ``columns`` (e.g. ``["forces"]``) decodes only the named per-atom
+/// sections; coordinates are always kept when any section is named, and
+/// ``columns=[]`` returns header-only frames with no atoms.
 #[pyfunction]
-fn read_con(py: Python<'_>, path: &str) -> PyResult<Vec<PyConFrame>> {
+#[pyo3(signature = (path, threads=None, columns=None))]
+fn read_con(
+    py: Python<'_>,
+    path: &str,
+    threads: Option<usize>,
+    columns: Option<Vec<String>>,
+) -> PyResult<Vec<PyConFrame>> {
+    let mask = column_mask(columns)?;
     // Release the GIL for file I/O + (optional) Rayon multi-frame parse.
     let path_owned = path.to_owned();
     // `detach` requires Ungil; map errors to String inside the closure.
     let frames = py
         .detach(|| {
-            crate::iterators::read_all_frames(Path::new(&path_owned)).map_err(|e| e.to_string())
+            let path = Path::new(&path_owned);
+            match threads {
+                Some(n) => read_frames_with_threads(path, (n > 0).then_some(n), mask),
+                None => crate::iterators::read_all_frames_projected(path, mask),
+            }
+            .map_err(|e| e.to_string())
         })
         .map_err(PyIOError::new_err)?;
     frames
@@ -997,6 +1036,21 @@ fn read_con(py: Python<'_>, path: &str) -> PyResult<Vec<PyConFrame>> {
         .collect()
 }
 
+/// Pinned-worker parallel parse for ``read_con(..., threads=n)`` (`None`:
+/// the global pool).
+fn read_frames_with_threads(
+    path: &Path,
+    threads: Option<usize>,
+    columns: ColumnMask,
+) -> Result<Vec<ConFrame>, Box<dyn std::error::Error>> {
+    let contents = crate::compression::read_file_contents(path)?;
+    let frames: Result<Vec<_>, _> =
+        crate::iterators::ParallelFrameIterator::scope(contents.as_str()?, threads, |it| {
+            it.with_projection(columns).collect()
+        });
+    Ok(frames?)
+}
+
 /// Read only the first frame from a .con or .convel file path.
 #[pyfunction]
 fn read_first_frame(py: Python<'_>, path: &str) -> PyResult<PyConFrame> {
@@ -1009,6 +1063,67 @@ fn read_first_frame(py: Python<'_>, path: &str) -> PyResult<PyConFrame> {
     PyConFrame::from_con_frame(py, &frame)
 }
 
+/// Read frame ``index`` (0-based) from a .con or .convel file path.
+///
+/// Seeks directly when a fresh ``<path>.idx`` sidecar exists (see
+/// [`write_offset_index`]); otherwise skips earlier frames without parsing
+/// their atoms.
+#[pyfunction]
+fn read_frame(py: Python<'_>, path: &str, index: usize) -> PyResult<PyConFrame> {
+    let path_owned = path.to_owned();
+    let frame = py
+        .detach(|| {
+            crate::iterators::read_frame(Path::new(&path_owned), index).map_err(|e| e.to_string())
+        })
+        .map_err(PyIOError::new_err)?;
+    PyConFrame::from_con_frame(py, &frame)
+}
+
+/// Build and write the ``<path>.idx`` frame offset sidecar; returns the
+/// number of indexed frames. Uncompressed files only.
+#[pyfunction]
+fn write_offset_index(py: Python<'_>, path: &str) -> PyResult<usize> {
+    let path_owned = path.to_owned();
+    py.detach(|| {
+        let path = Path::new(&path_owned);
+        let index = crate::offset_index::FrameOffsetIndex::build_for_path(path)
+            .map_err(|e| e.to_string())?;
+        index.write_sidecar(path).map_err(|e| e.to_string())?;
+        Ok::<_, String>(index.len())
+    })
+    .map_err(PyIOError::new_err)
+}
+
+/// Frames of ``path`` matching ``query``, e.g.
+/// ``"energy < -40 && composition == 'Cu:2|H:2' && fmax < 0.05"``.
+///
+/// Answered from a fresh ``<path>.idx`` sidecar (see ``write_offset_index``)
+/// without parsing frames; otherwise the file is scanned decoding only the
+/// columns the predicates need. Returns frame indices, or
+/// ``(index, offset, length)`` byte spans when ``spans=True``. Raises
+/// ``ValueError`` for a malformed query.
+#[pyfunction]
+#[pyo3(signature = (path, query, *, spans=false))]
+fn query_frames(py: Python<'_>, path: &str, query: &str, spans: bool) -> PyResult<Py<PyAny>> {
+    let query =
+        crate::query::FrameQuery::parse(query).map_err(|e| PyValueError::new_err(e.to_string()))?;
+    let path_owned = path.to_owned();
+    let hits = py
+        .detach(|| {
+            crate::query::query_frames(Path::new(&path_owned), &query).map_err(|e| e.to_string())
+        })
+        .map_err(PyIOError::new_err)?;
+    if spans {
+        let rows: Vec<(usize, usize, usize)> = hits
+            .iter()
+            .map(|h| (h.frame, h.span.start, h.span.len()))
+            .collect();
+        rows.into_py_any(py)
+    } else {
+        hits.iter().map(|h| h.frame).collect::<Vec<_>>().into_py_any(py)
+    }
+}
+
 /// Read frames from a string containing .con or .convel data.
 #[pyfunction]
 fn read_con_string(py: Python<'_>, contents: &str) -> PyResult<Vec<PyConFrame>> {
@@ -1035,6 +1150,46 @@ struct PyConFrameIterator {
     contents: String,
     /// Byte offset of the next frame start within `contents`.
     pos: usize,
+    /// Index of the frame at `pos`.
+    frame: usize,
+    /// Stop before this frame index (``iter_con(..., stop=)``).
+    stop: Option<usize>,
+    /// Frames advanced per `__next__` (``iter_con(..., step=)``).
+    step: usize,
+    /// Sections decoded per frame (``iter_con(..., columns=)``).
+    columns: ColumnMask,
+}
+
+impl PyConFrameIterator {
+    /// Skip leading blank lines between frames.
+    fn skip_blank(&mut self) {
+        let bytes = self.contents.as_bytes();
+        while self.pos < bytes.len()
+            && (bytes[self.pos] == b'\n' || bytes[self.pos] == b'\r' || bytes[self.pos] == b' ')
+        {
+            self.pos += 1;
+        }
+    }
+
+    /// Skip up to `n` frames with the header-only walk; returns frames skipped.
+    fn skip_frames(&mut self, n: usize) -> PyResult<usize> {
+        for skipped in 0..n {
+            self.skip_blank();
+            if self.pos >= self.contents.len() {
+                return Ok(skipped);
+            }
+            let mut iter = ConFrameIterator::new(&self.contents[self.pos..]);
+            match iter.forward_fast() {
+                Some(Ok(())) => {
+                    self.pos += iter.byte_offset();
+                    self.frame += 1;
+                }
+                Some(Err(e)) => return Err(PyIOError::new_err(format!("parse error: {e}"))),
+                None => return Ok(skipped),
+            }
+        }
+        Ok(n)
+    }
 }
 
 #[pymethods]
@@ -1044,27 +1199,24 @@ impl PyConFrameIterator {
     }
 
     fn __next__(&mut self, py: Python<'_>) -> PyResult<Option<PyConFrame>> {
-        if self.pos >= self.contents.len() {
+        if self.stop.is_some_and(|stop| self.frame >= stop) {
             return Ok(None);
         }
-        // Skip leading blank lines between frames.
-        let bytes = self.contents.as_bytes();
-        while self.pos < bytes.len()
-            && (bytes[self.pos] == b'\n' || bytes[self.pos] == b'\r' || bytes[self.pos] == b' ')
-        {
-            self.pos += 1;
-        }
+        self.skip_blank();
         if self.pos >= self.contents.len() {
             return Ok(None);
         }
         let slice = &self.contents[self.pos..];
-        let mut iter = ConFrameIterator::new(slice);
+        let mut iter = ConFrameIterator::new(slice).with_projection(self.columns);
         match iter.next_with_raw_span(slice) {
             Some(Ok((frame, span))) => {
                 let consumed =
                     (span.as_ptr() as usize).saturating_sub(slice.as_ptr() as usize) + span.len();
                 self.pos += consumed;
-                Ok(Some(PyConFrame::from_con_frame(py, &frame)?))
+                self.frame += 1;
+                let out = PyConFrame::from_con_frame(py, &frame)?;
+                self.skip_frames(self.step - 1)?;
+                Ok(Some(out))
             }
             Some(Err(e)) => Err(PyIOError::new_err(format!("parse error: {e}"))),
             None => {
@@ -1073,14 +1225,61 @@ impl PyConFrameIterator {
             }
         }
     }
+
+    /// Skip up to ``n`` frames without parsing their atoms; returns the
+    /// number skipped (fewer than ``n`` at end of file).
+    fn skip(&mut self, n: usize) -> PyResult<usize> {
+        self.skip_frames(n)
+    }
+
+    /// Make frame ``index`` (0-based) the next one returned. Backward seeks
+    /// rewind to the start. Raises ``IndexError`` past the last frame.
+    fn seek(&mut self, index: usize) -> PyResult<()> {
+        if index < self.frame {
+            self.pos = 0;
+            self.frame = 0;
+        }
+        let want = index - self.frame;
+        self.skip_frames(want)?;
+        self.skip_blank();
+        if self.frame < index || self.pos >= self.contents.len() {
+            return Err(PyIndexError::new_err(format!(
+                "frame {index} out of range ({} frames)",
+                self.frame
+            )));
+        }
+        Ok(())
+    }
+
+    /// Index of the frame the next ``__next__`` returns.
+    #[getter]
+    fn position(&self) -> usize {
+        self.frame
+    }
 }
 
 /// Return a **streaming** iterator over frames from a path.
 ///
 /// Prefer this over [`read_all_frames`] when you process frames one at a time:
 /// only one `ConFrame` / `PyConFrame` is built per `__next__` call.
+///
+/// ``start`` / ``stop`` / ``step`` select ``frames[start:stop:step]``;
+/// unselected frames are skipped without parsing their atoms.
+/// ``columns`` projects sections as in [`read_con`].
 #[pyfunction]
-fn iter_con(py: Python<'_>, path: &str) -> PyResult<PyConFrameIterator> {
+#[pyo3(signature = (path, start=0, stop=None, step=1, columns=None))]
+fn iter_con(
+    py: Python<'_>,
+    path: &str,
+    start: usize,
+    stop: Option<usize>,
+    step: usize,
+    columns: Option<Vec<String>>,
+) -> PyResult<PyConFrameIterator> {
+    if step == 0 {
+        return Err(PyValueError::new_err("step must be non-zero"));
+    }
+    let columns = column_mask(columns)?;
     let path_owned = path.to_owned();
     let text = py
         .detach(|| {
@@ -1092,12 +1291,614 @@ fn iter_con(py: Python<'_>, path: &str) -> PyResult<PyConFrameIterator> {
                 .map_err(|e| e.to_string())
         })
         .map_err(PyIOError::new_err)?;
-    Ok(PyConFrameIterator {
+    let mut it = PyConFrameIterator {
         contents: text,
         pos: 0,
+        frame: 0,
+        stop,
+        step,
+        columns,
+    };
+    it.skip_frames(start)?;
+    Ok(it)
+}
+
+/// Read-only numpy view of a frame-owned ``(N, 3)`` block. Zero-copy for
+/// float64 / float32 / float16 storage (``owner`` keeps the buffer alive);
+/// other storage dtypes are widened into a fresh float64 array.
+fn block2_view<'py>(
+    owner: &Bound<'py, PyTrajectoryFrame>,
+    block: &crate::storage_dtype::Array2Storage,
+) -> PyResult<Bound<'py, PyAny>> {
+    use crate::storage_dtype::Array2Storage;
+    let container = owner.clone().into_any();
+    // SAFETY (all borrows): the frame is frozen, so the buffer is never
+    // written or freed while `container` holds the frame.
+    let array = match block {
+        Array2Storage::F64(a) => unsafe { PyArray2::borrow_from_array(a, container) }.into_any(),
+        Array2Storage::F32(a) => unsafe { PyArray2::borrow_from_array(a, container) }.into_any(),
+        Array2Storage::F16(a) if a.is_standard_layout() => {
+            // `half::f16` is a transparent u16: borrow the bits, relabel in numpy.
+            let bits = unsafe {
+                ndarray::ArrayView2::<u16>::from_shape_ptr(a.raw_dim(), a.as_ptr().cast::<u16>())
+            };
+            unsafe { PyArray2::borrow_from_array(&bits, container) }
+                .call_method1("view", ("float16",))?
+        }
+        other => {
+            let n = other.nrows();
+            let data: Vec<f64> = (0..n).flat_map(|i| other.as_f64_row(i)).collect();
+            Array2::from_shape_vec((n, 3), data)
+                .map_err(|e| PyValueError::new_err(format!("block shape error: {e}")))?
+                .into_pyarray(owner.py())
+                .into_any()
+        }
+    };
+    array.call_method1("setflags", (false,))?;
+    Ok(array)
+}
+
+/// [`block2_view`] for an ``(N,)`` column.
+fn block1_view<'py>(
+    owner: &Bound<'py, PyTrajectoryFrame>,
+    column: &crate::storage_dtype::Array1Storage,
+) -> PyResult<Bound<'py, PyAny>> {
+    use crate::storage_dtype::Array1Storage;
+    let container = owner.clone().into_any();
+    // SAFETY: as in `block2_view`.
+    let array = match column {
+        Array1Storage::F64(a) => unsafe { PyArray1::borrow_from_array(a, container) }.into_any(),
+        Array1Storage::F32(a) => unsafe { PyArray1::borrow_from_array(a, container) }.into_any(),
+        Array1Storage::F16(a) if a.is_standard_layout() => {
+            let bits = unsafe {
+                ndarray::ArrayView1::<u16>::from_shape_ptr(a.raw_dim(), a.as_ptr().cast::<u16>())
+            };
+            unsafe { PyArray1::borrow_from_array(&bits, container) }
+                .call_method1("view", ("float16",))?
+        }
+        other => (0..other.len())
+            .map(|i| other.get_f64(i))
+            .collect::<Vec<f64>>()
+            .into_pyarray(owner.py())
+            .into_any(),
+    };
+    array.call_method1("setflags", (false,))?;
+    Ok(array)
+}
+
+/// One frame of a [`PyConTrajectory`], kept as the parsed Rust frame.
+///
+/// Read-only: per-atom columns are numpy views of the frame's own buffers
+/// (no per-atom Python objects), created on access. ``to_frame()`` converts
+/// to an editable ``ConFrame``.
+#[pyclass(frozen, name = "TrajectoryFrame")]
+struct PyTrajectoryFrame {
+    /// Index of this frame in the file.
+    #[pyo3(get)]
+    index: usize,
+    frame: ConFrame,
+}
+
+#[pymethods]
+impl PyTrajectoryFrame {
+    #[getter]
+    fn cell(&self) -> [f64; 3] {
+        self.frame.header.boxl
+    }
+
+    #[getter]
+    fn angles(&self) -> [f64; 3] {
+        self.frame.header.angles
+    }
+
+    /// Per-atom element symbols.
+    #[getter]
+    fn symbols(&self) -> Vec<String> {
+        self.frame
+            .atom_data
+            .iter()
+            .map(|a| a.symbol.to_string())
+            .collect()
+    }
+
+    #[getter]
+    fn metadata(&self, py: Python<'_>) -> PyResult<Py<PyDict>> {
+        json_map_to_py_dict(py, &self.frame.header.metadata)
+    }
+
+    #[getter]
+    fn energy(&self) -> Option<f64> {
+        self.frame.header.energy()
+    }
+
+    #[getter]
+    fn has_velocities(&self) -> bool {
+        self.frame.has_velocities()
+    }
+
+    #[getter]
+    fn has_forces(&self) -> bool {
+        self.frame.has_forces()
+    }
+
+    fn __len__(&self) -> usize {
+        self.frame.atom_data.len()
+    }
+
+    fn __repr__(&self) -> String {
+        format!(
+            "TrajectoryFrame(index={}, natoms={}, has_velocities={}, has_forces={})",
+            self.index,
+            self.frame.atom_data.len(),
+            self.frame.has_velocities(),
+            self.frame.has_forces()
+        )
+    }
+
+    /// ``[N, 3]`` positions in the frame's storage dtype (read-only view).
+    fn coords_array<'py>(slf: &Bound<'py, Self>) -> PyResult<Bound<'py, PyAny>> {
+        block2_view(slf, &slf.get().frame.positions)
+    }
+
+    /// ``[N, 3]`` velocities, or ``None`` without a velocities section.
+    fn velocities_array<'py>(slf: &Bound<'py, Self>) -> PyResult<Option<Bound<'py, PyAny>>> {
+        let frame = &slf.get().frame;
+        if !frame.has_velocities() {
+            return Ok(None);
+        }
+        block2_view(slf, &frame.velocities).map(Some)
+    }
+
+    /// ``[N, 3]`` forces, or ``None`` without a forces section.
+    fn forces_array<'py>(slf: &Bound<'py, Self>) -> PyResult<Option<Bound<'py, PyAny>>> {
+        let frame = &slf.get().frame;
+        if !frame.has_forces() {
+            return Ok(None);
+        }
+        block2_view(slf, &frame.forces).map(Some)
+    }
+
+    /// ``[N]`` per-atom energies, or ``None`` without an energies section.
+    fn energies_array<'py>(slf: &Bound<'py, Self>) -> PyResult<Option<Bound<'py, PyAny>>> {
+        let frame = &slf.get().frame;
+        if !frame.has_energies() {
+            return Ok(None);
+        }
+        block1_view(slf, &frame.atom_energies).map(Some)
+    }
+
+    /// ``[N]`` per-atom masses (read-only view).
+    fn masses_array<'py>(slf: &Bound<'py, Self>) -> PyResult<Bound<'py, PyAny>> {
+        block1_view(slf, &slf.get().frame.masses)
+    }
+
+    /// ``[N] uint64`` atom ids (read-only view).
+    fn atom_ids_array<'py>(slf: &Bound<'py, Self>) -> PyResult<Bound<'py, PyAny>> {
+        let container = slf.clone().into_any();
+        // SAFETY: as in `block2_view`.
+        let array =
+            unsafe { PyArray1::borrow_from_array(&slf.get().frame.atom_ids, container) }.into_any();
+        array.call_method1("setflags", (false,))?;
+        Ok(array)
+    }
+
+    /// Editable ``ConFrame`` copy (builds the per-atom ``Atom`` list).
+    fn to_frame(&self, py: Python<'_>) -> PyResult<PyConFrame> {
+        PyConFrame::from_con_frame(py, &self.frame)
+    }
+}
+
+/// Lazily parsed, random-access trajectory: ``len``, indexing, slicing and
+/// iteration without building the whole file as Python objects.
+///
+/// Opening loads the file (memory-mapped when large) and locates the frame
+/// boundaries, from a fresh ``<path>.idx`` sidecar when present, without
+/// parsing atoms. ``traj[i]`` parses one frame with the GIL released;
+/// ``traj[a:b:c]`` is another view over the same buffer. Iterating parses
+/// ``prefetch`` frames ahead on a background thread (on the Rayon pool with
+/// the ``parallel`` feature), also without the GIL. ``columns`` projects
+/// sections as in ``read_con``.
+#[pyclass(frozen, name = "ConTrajectory")]
+struct PyConTrajectory {
+    source: Arc<crate::prefetch::IndexedTrajectory>,
+    /// Source frame of view position 0, stride and length of this view.
+    start: isize,
+    step: isize,
+    len: usize,
+    columns: ColumnMask,
+    prefetch: usize,
+}
+
+impl PyConTrajectory {
+    /// Source frame index of view position `i` (`i < self.len`).
+    fn source_index(&self, i: usize) -> usize {
+        (self.start + i as isize * self.step) as usize
+    }
+
+    fn load(&self, py: Python<'_>, i: usize) -> PyResult<PyTrajectoryFrame> {
+        let index = self.source_index(i);
+        let (source, columns) = (&self.source, self.columns);
+        match py.detach(|| source.frame(index, columns)) {
+            Some(Ok(frame)) => Ok(PyTrajectoryFrame { index, frame }),
+            Some(Err(e)) => Err(PyIOError::new_err(format!("parse error: {e}"))),
+            None => Err(PyIndexError::new_err(format!("frame {index} out of range"))),
+        }
+    }
+}
+
+#[pymethods]
+impl PyConTrajectory {
+    #[new]
+    #[pyo3(signature = (path, *, columns=None, prefetch=crate::prefetch::DEFAULT_PREFETCH_DEPTH))]
+    fn new(
+        py: Python<'_>,
+        path: &str,
+        columns: Option<Vec<String>>,
+        prefetch: usize,
+    ) -> PyResult<Self> {
+        let columns = column_mask(columns)?;
+        let path_owned = path.to_owned();
+        let source = py
+            .detach(|| {
+                crate::prefetch::IndexedTrajectory::open(Path::new(&path_owned))
+                    .map_err(|e| e.to_string())
+            })
+            .map_err(PyIOError::new_err)?;
+        Ok(Self {
+            len: source.len(),
+            source: Arc::new(source),
+            start: 0,
+            step: 1,
+            columns,
+            prefetch: prefetch.max(1),
+        })
+    }
+
+    fn __len__(&self) -> usize {
+        self.len
+    }
+
+    fn __getitem__(&self, py: Python<'_>, key: &Bound<'_, PyAny>) -> PyResult<Py<PyAny>> {
+        if let Ok(slice) = key.cast::<PySlice>() {
+            let idx = slice.indices(self.len as isize)?;
+            let view = Self {
+                source: Arc::clone(&self.source),
+                start: self.start + idx.start * self.step,
+                step: self.step * idx.step,
+                len: idx.slicelength,
+                columns: self.columns,
+                prefetch: self.prefetch,
+            };
+            return Ok(Py::new(py, view)?.into_any());
+        }
+        let i: isize = key.extract()?;
+        let n = self.len as isize;
+        let i = if i < 0 { i + n } else { i };
+        if !(0..n).contains(&i) {
+            return Err(PyIndexError::new_err(format!(
+                "frame {i} out of range ({n} frames)"
+            )));
+        }
+        Ok(Py::new(py, self.load(py, i as usize)?)?.into_any())
+    }
+
+    fn __iter__(&self) -> PyConTrajectoryIterator {
+        let (start, step) = (self.start, self.step);
+        let frames = (0..self.len).map(move |k| (start + k as isize * step) as usize);
+        PyConTrajectoryIterator {
+            frames: crate::prefetch::FramePrefetcher::spawn(
+                Arc::clone(&self.source),
+                frames,
+                self.prefetch,
+                self.columns,
+            ),
+        }
+    }
+
+    fn __repr__(&self) -> String {
+        format!("ConTrajectory(n_frames={})", self.len)
+    }
+}
+
+/// Iterator returned by ``iter(ConTrajectory)``; owns the prefetch thread,
+/// which stops when the iterator is garbage-collected.
+#[pyclass(unsendable, name = "ConTrajectoryIterator")]
+struct PyConTrajectoryIterator {
+    frames: crate::prefetch::FramePrefetcher,
+}
+
+#[pymethods]
+impl PyConTrajectoryIterator {
+    fn __iter__(slf: PyRef<'_, Self>) -> PyRef<'_, Self> {
+        slf
+    }
+
+    fn __next__(&mut self, py: Python<'_>) -> PyResult<Option<PyTrajectoryFrame>> {
+        let frames = &mut self.frames;
+        match py.detach(|| frames.next()) {
+            Some((index, Ok(frame))) => Ok(Some(PyTrajectoryFrame { index, frame })),
+            Some((_, Err(e))) => Err(PyIOError::new_err(format!("parse error: {e}"))),
+            None => Ok(None),
+        }
+    }
+}
+
+/// Follows a ``.con`` file another process is still writing (see
+/// [`follow_con`]). Only bytes appended since the last call are read.
+#[pyclass(name = "ConFrameFollower")]
+struct PyConFrameFollower {
+    inner: crate::follow::ConFrameFollower,
+}
+
+#[pymethods]
+impl PyConFrameFollower {
+    /// Next complete frame, waiting up to ``timeout`` seconds for the writer
+    /// (``0``: check once). ``None`` means no complete frame yet.
+    #[pyo3(signature = (timeout=0.0))]
+    fn next(&mut self, py: Python<'_>, timeout: f64) -> PyResult<Option<PyConFrame>> {
+        let timeout = std::time::Duration::from_secs_f64(timeout.max(0.0));
+        let inner = &mut self.inner;
+        let next = py
+            .detach(|| inner.wait_next(timeout))
+            .map_err(|e| PyIOError::new_err(format!("parse error: {e}")))?;
+        next.map(|frame| PyConFrame::from_con_frame(py, &frame)).transpose()
+    }
+
+    /// All frames completed since the last call.
+    fn poll(&mut self, py: Python<'_>) -> PyResult<Vec<PyConFrame>> {
+        let inner = &mut self.inner;
+        let frames = py
+            .detach(|| inner.poll())
+            .map_err(|e| PyIOError::new_err(format!("parse error: {e}")))?;
+        frames
+            .iter()
+            .map(|frame| PyConFrame::from_con_frame(py, frame))
+            .collect()
+    }
+
+    /// File offset just past the last frame returned; pass it to
+    /// ``follow_con(path, offset=...)`` to resume later.
+    #[getter]
+    fn byte_offset(&self) -> u64 {
+        self.inner.byte_offset()
+    }
+
+    /// Index of the frame the next successful ``next()`` returns.
+    #[getter]
+    fn position(&self) -> usize {
+        self.inner.next_frame_index()
+    }
+}
+
+/// Follow ``path`` while it is being written, as ``tail -f`` does.
+///
+/// ``offset`` / ``frames_before`` resume from a saved ``byte_offset`` /
+/// ``position``. A trailing partial frame is reported as "not yet" rather
+/// than an error; compressed files cannot be followed. ``columns``
+/// projects sections as in [`read_con`].
+#[pyfunction]
+#[pyo3(signature = (path, offset=0, frames_before=0, columns=None))]
+fn follow_con(
+    path: &str,
+    offset: u64,
+    frames_before: usize,
+    columns: Option<Vec<String>>,
+) -> PyResult<PyConFrameFollower> {
+    let columns = column_mask(columns)?;
+    let inner = crate::follow::ConFrameFollower::resume(Path::new(path), offset, frames_before)
+        .map_err(|e| PyIOError::new_err(e.to_string()))?
+        .with_projection(columns);
+    Ok(PyConFrameFollower { inner })
+}
+
+/// Read ``frames[start:stop:step]`` from a path into a list.
+///
+/// Uses a fresh ``<path>.idx`` sidecar to read only the selected frames;
+/// otherwise unselected frames are skipped without parsing their atoms.
+#[pyfunction]
+#[pyo3(signature = (path, start=0, stop=None, step=1))]
+fn read_frames(
+    py: Python<'_>,
+    path: &str,
+    start: usize,
+    stop: Option<usize>,
+    step: usize,
+) -> PyResult<Vec<PyConFrame>> {
+    if step == 0 {
+        return Err(PyValueError::new_err("step must be non-zero"));
+    }
+    let path_owned = path.to_owned();
+    let frames = py
+        .detach(|| {
+            crate::iterators::read_frames_strided(Path::new(&path_owned), start, stop, step)
+                .map_err(|e| e.to_string())
+        })
+        .map_err(PyIOError::new_err)?;
+    frames
+        .iter()
+        .map(|frame| PyConFrame::from_con_frame(py, frame))
+        .collect()
+}
+
+/// Read ``frames[start:stop:step]`` into batched numpy tensors.
+///
+/// Returns a dict with ``positions`` (``[F, N, 3]``), ``forces``
+/// (``[F, N, 3]`` or ``None``) and ``energies`` (``[F]``, NaN where a frame
+/// has no energy), all in ``dtype`` (``"float64"``, ``"float32"`` or
+/// ``"float16"``). Every selected frame must share one atom count.
+#[pyfunction]
+#[pyo3(signature = (path, start=0, stop=None, step=1, dtype="float64"))]
+fn read_con_tensors(
+    py: Python<'_>,
+    path: &str,
+    start: usize,
+    stop: Option<usize>,
+    step: usize,
+    dtype: &str,
+) -> PyResult<Py<PyDict>> {
+    use crate::storage_dtype::{ElementKind, StorageDtypes};
+    let kind = ElementKind::parse(dtype).map_err(|e| PyValueError::new_err(e.to_string()))?;
+    let dtypes = StorageDtypes {
+        positions: kind,
+        forces: kind,
+        energies: kind,
+        ..StorageDtypes::default()
+    };
+    let path_owned = path.to_owned();
+    let batch = py
+        .detach(|| {
+            crate::trajectory_tensor::read_trajectory_tensors(
+                Path::new(&path_owned),
+                start,
+                stop,
+                step,
+                &dtypes,
+            )
+            .map_err(|e| e.to_string())
+        })
+        .map_err(PyIOError::new_err)?;
+    let dict = PyDict::new(py);
+    dict.set_item("positions", array3_to_numpy(py, batch.positions)?)?;
+    match batch.forces {
+        Some(forces) => dict.set_item("forces", array3_to_numpy(py, forces)?)?,
+        None => dict.set_item("forces", py.None())?,
+    }
+    dict.set_item("energies", array1_to_numpy(py, batch.energies)?)?;
+    Ok(dict.unbind())
+}
+
+/// Hand a batch block to numpy; f16 travels as its bit pattern and is
+/// reinterpreted with ``.view("float16")`` (numpy has no Rust f16 element).
+fn array3_to_numpy(
+    py: Python<'_>,
+    block: crate::storage_dtype::Array3Storage,
+) -> PyResult<Py<PyAny>> {
+    use crate::storage_dtype::Array3Storage;
+    Ok(match block {
+        Array3Storage::F64(a) => a.into_owned().into_pyarray(py).into_any().unbind(),
+        Array3Storage::F32(a) => a.into_owned().into_pyarray(py).into_any().unbind(),
+        Array3Storage::F16(a) => a
+            .mapv(|x| x.to_bits())
+            .into_pyarray(py)
+            .call_method1("view", ("float16",))?
+            .unbind(),
+    })
+}
+
+fn array1_to_numpy(
+    py: Python<'_>,
+    column: crate::storage_dtype::Array1Storage,
+) -> PyResult<Py<PyAny>> {
+    use crate::storage_dtype::Array1Storage;
+    Ok(match column {
+        Array1Storage::F64(a) => a.into_owned().into_pyarray(py).into_any().unbind(),
+        Array1Storage::F32(a) => a.into_owned().into_pyarray(py).into_any().unbind(),
+        Array1Storage::F16(a) => a
+            .mapv(|x| x.to_bits())
+            .into_pyarray(py)
+            .call_method1("view", ("float16",))?
+            .unbind(),
+        // Energies are always a float kind; widen anything else defensively.
+        other => (0..other.len())
+            .map(|i| other.get_f64(i))
+            .collect::<Vec<f64>>()
+            .into_pyarray(py)
+            .into_any()
+            .unbind(),
     })
 }
 
+/// Read ``frames[start:stop:step]`` as one ``metatensor.TensorMap``.
+///
+/// ``keys="quantity"`` gives one block per batched field (key ``quantity``:
+/// 0 positions, 1 forces when present); ``keys="species"`` gives one
+/// ``quantity`` block per atomic number (key ``species``). Samples are
+/// ``(system, atom)`` (frame index in the file, atom index in the frame),
+/// properties ``xyz``. Frames are parsed into shared float64 buffers with
+/// the GIL released, so building the map costs one block per key rather
+/// than per frame. Frame rules follow ``read_con_tensors``; requires the
+/// ``metatensor`` Python package.
+#[pyfunction]
+#[pyo3(signature = (path, start=0, stop=None, step=1, keys="quantity", quantity="positions"))]
+fn read_con_tensormap(
+    py: Python<'_>,
+    path: &str,
+    start: usize,
+    stop: Option<usize>,
+    step: usize,
+    keys: &str,
+    quantity: &str,
+) -> PyResult<Py<PyAny>> {
+    use crate::trajectory_tensor::{BatchKeys, BatchQuantity};
+    let quantity = match quantity {
+        "positions" => BatchQuantity::Positions,
+        "forces" => BatchQuantity::Forces,
+        other => {
+            return Err(PyValueError::new_err(format!(
+                "quantity must be 'positions' or 'forces', not {other:?}"
+            )));
+        }
+    };
+    let (key_name, batch_keys) = match keys {
+        "quantity" => ("quantity", BatchKeys::Quantity),
+        "species" => ("species", BatchKeys::Species(quantity)),
+        other => {
+            return Err(PyValueError::new_err(format!(
+                "keys must be 'quantity' or 'species', not {other:?}"
+            )));
+        }
+    };
+    let path_owned = path.to_owned();
+    let blocks = py
+        .detach(|| {
+            let batch = crate::trajectory_tensor::read_trajectory_tensors(
+                Path::new(&path_owned),
+                start,
+                stop,
+                step,
+                &crate::storage_dtype::StorageDtypes::default(),
+            )
+            .map_err(|e| PyIOError::new_err(e.to_string()))?;
+            batch
+                .into_keyed_blocks(batch_keys)
+                .map_err(|e| PyValueError::new_err(e.to_string()))
+        })?;
+
+    let mts = py.import("metatensor")?;
+    let labels = mts.getattr("Labels")?;
+    let properties = labels.call1((
+        "xyz",
+        Array2::from_shape_vec((3, 1), vec![0i32, 1, 2])
+            .expect("xyz labels shape")
+            .into_pyarray(py),
+    ))?;
+    let mut key_values = Vec::with_capacity(blocks.len());
+    let mut py_blocks = Vec::with_capacity(blocks.len());
+    for block in blocks {
+        key_values.push(block.key);
+        let rows = block.samples.len();
+        let samples = Array2::from_shape_vec((rows, 2), block.samples.concat())
+            .map_err(|e| PyValueError::new_err(format!("sample shape error: {e}")))?;
+        let values = Array2::from_shape_vec((rows, 3), block.values)
+            .map_err(|e| PyValueError::new_err(format!("block shape error: {e}")))?;
+        let samples = labels.call1((vec!["system", "atom"], samples.into_pyarray(py)))?;
+        py_blocks.push(mts.getattr("TensorBlock")?.call1((
+            values.into_pyarray(py),
+            samples,
+            PyList::empty(py),
+            &properties,
+        ))?);
+    }
+    let n_keys = key_values.len();
+    let key_labels = labels.call1((
+        key_name,
+        Array2::from_shape_vec((n_keys, 1), key_values)
+            .expect("key labels shape")
+            .into_pyarray(py),
+    ))?;
+    Ok(mts.getattr("TensorMap")?.call1((key_labels, py_blocks))?.unbind())
+}
+
 /// Count frames without building atom / Python objects (skip walk).
 #[pyfunction]
 fn count_frames(py: Python<'_>, path: &str) -> PyResult<usize> {
@@ -1114,7 +1915,11 @@ fn count_frames(py: Python<'_>, path: &str) -> PyResult<usize> {
 /// - other formats: chemfiles-linked build only (``readcon-chemfiles`` /
 ///   ``maturin develop --features python,chemfiles``)
 ///
-/// Returns a dict: ``n_frames``, ``n_atoms_last``, ``native_con``.
+/// Frames are streamed from reader to writer, so memory stays bounded for
+/// trajectories larger than RAM.
+///
+/// Returns a dict: ``n_frames``, ``n_atoms_last``, ``native_con``,
+/// ``bytes_read``, ``bytes_written``, ``elapsed_s``.
 #[pyfunction]
 fn convert_to_con(py: Python<'_>, input_path: &str, output_path: &str) -> PyResult<Py<PyAny>> {
     use crate::convert::convert_path_to_con;
@@ -1126,9 +1931,55 @@ fn convert_to_con(py: Python<'_>, input_path: &str, output_path: &str) -> PyResu
     dict.set_item("n_frames", report.n_frames)?;
     dict.set_item("n_atoms_last", report.n_atoms_last)?;
     dict.set_item("native_con", report.native_con)?;
+    dict.set_item("bytes_read", report.bytes_read)?;
+    dict.set_item("bytes_written", report.bytes_written)?;
+    dict.set_item("elapsed_s", report.elapsed.as_secs_f64())?;
+    Ok(dict.into())
+}
+
+/// Process-wide read / write counters (needs a ``stats``-feature build).
+///
+/// Returns a dict: ``enabled``, ``stages`` (``{name: {"nanos", "calls",
+/// "bytes"}}`` for ``read``, ``decompress``, ``scan``, ``header``,
+/// ``metadata``, ``coordinates``, ``sections``, ``assemble``, ``write``),
+/// ``frames_read``, ``frames_written``, ``buffers_allocated``,
+/// ``buffers_reused``, ``parallel_batches``, ``parallel_wall_ns``,
+/// ``parallel_busy_ns``, ``parallel_capacity_ns``, ``worker_utilization``.
+/// Every count is 0 when ``enabled`` is False.
+#[pyfunction]
+fn stats(py: Python<'_>) -> PyResult<Py<PyAny>> {
+    use crate::stats::Stage;
+    let s = crate::stats::snapshot();
+    let stages = PyDict::new(py);
+    for stage in Stage::ALL {
+        let totals = s.stage(stage);
+        let entry = PyDict::new(py);
+        entry.set_item("nanos", totals.nanos)?;
+        entry.set_item("calls", totals.calls)?;
+        entry.set_item("bytes", totals.bytes)?;
+        stages.set_item(stage.name(), entry)?;
+    }
+    let dict = PyDict::new(py);
+    dict.set_item("enabled", crate::stats::ENABLED)?;
+    dict.set_item("stages", stages)?;
+    dict.set_item("frames_read", s.frames_read)?;
+    dict.set_item("frames_written", s.frames_written)?;
+    dict.set_item("buffers_allocated", s.buffers_allocated)?;
+    dict.set_item("buffers_reused", s.buffers_reused)?;
+    dict.set_item("parallel_batches", s.parallel_batches)?;
+    dict.set_item("parallel_wall_ns", s.parallel_wall_nanos)?;
+    dict.set_item("parallel_busy_ns", s.parallel_busy_nanos)?;
+    dict.set_item("parallel_capacity_ns", s.parallel_capacity_nanos)?;
+    dict.set_item("worker_utilization", s.worker_utilization())?;
     Ok(dict.into())
 }
 
+/// Zero the counters reported by :func:`stats`.
+#[pyfunction]
+fn reset_stats() {
+    crate::stats::reset();
+}
+
 /// Write frames to a .con or .convel file path.
 ///
 /// The `compression` argument controls output compression:
@@ -1158,22 +2009,27 @@ fn write_con(
         None => path.ends_with(".gz"),
     };
 
-    if use_gzip {
-        let mut writer = ConFrameWriter::from_path_gzip_with_precision(path, precision)
-            .map_err(|e| PyIOError::new_err(format!("failed to create gzip writer: {e}")))?
-            .canonical(canonical);
-        writer
-            .extend(rust_frames.iter())
-            .map_err(|e| PyIOError::new_err(format!("write error: {e}")))?;
+    // Chunks are formatted (and gzip members compressed) on the Rayon pool
+    // with the GIL released; the output reads back as one trajectory.
+    let compression = if use_gzip {
+        ChunkCompression::Gzip
     } else {
-        let mut writer = ConFrameWriter::from_path_with_precision(path, precision)
-            .map_err(|e| PyIOError::new_err(format!("failed to create writer: {e}")))?
-            .canonical(canonical);
+        ChunkCompression::None
+    };
+    let path_owned = path.to_owned();
+    py.detach(|| {
+        let file = std::fs::File::create(&path_owned)
+            .map_err(|e| format!("failed to create writer: {e}"))?;
+        let mut writer = ParallelConWriter::new(file)
+            .with_precision(precision)
+            .canonical(canonical)
+            .with_compression(compression);
         writer
-            .extend(rust_frames.iter())
-            .map_err(|e| PyIOError::new_err(format!("write error: {e}")))?;
-    }
-    Ok(())
+            .extend(&rust_frames)
+            .map_err(|e| format!("write error: {e}"))?;
+        writer.finish().map(drop).map_err(|e| format!("write error: {e}"))
+    })
+    .map_err(PyIOError::new_err)
 }
 
 /// Write frames to a string in .con format.
@@ -1200,7 +2056,7 @@ fn write_con_string(
 /// Requires the ase package.
 #[pyfunction]
 fn read_con_as_ase(py: Python<'_>, path: &str) -> PyResult<Vec<Py<PyAny>>> {
-    let frames = read_con(py, path)?;
+    let frames = read_con(py, path, None, None)?;
     frames.iter().map(|f| ase_from_pyconframe(py, f)).collect()
 }
 
@@ -1557,16 +2413,30 @@ fn readcon(m: &Bound<'_, PyModule>) -> PyResult<()> {
     m.add_class::<PyAtomDatum>()?;
     m.add_class::<PyConFrame>()?;
     m.add_class::<PyConFrameIterator>()?;
+    m.add_class::<PyConTrajectory>()?;
+    m.add_class::<PyTrajectoryFrame>()?;
+    m.add_class::<PyConTrajectoryIterator>()?;
+    m.add_class::<PyConFrameFollower>()?;
+    m.add_class::<PyCompiledSelection>()?;
     m.add_function(wrap_pyfunction!(read_con, m)?)?;
     // Ergonomic alias for multi-language matrix (batch all frames).
     m.add_function(wrap_pyfunction!(read_all_frames, m)?)?;
     m.add_function(wrap_pyfunction!(read_first_frame, m)?)?;
+    m.add_function(wrap_pyfunction!(read_frame, m)?)?;
+    m.add_function(wrap_pyfunction!(read_frames, m)?)?;
+    m.add_function(wrap_pyfunction!(read_con_tensors, m)?)?;
+    m.add_function(wrap_pyfunction!(read_con_tensormap, m)?)?;
+    m.add_function(wrap_pyfunction!(write_offset_index, m)?)?;
+    m.add_function(wrap_pyfunction!(query_frames, m)?)?;
     m.add_function(wrap_pyfunction!(iter_con, m)?)?;
+    m.add_function(wrap_pyfunction!(follow_con, m)?)?;
     m.add_function(wrap_pyfunction!(count_frames, m)?)?;
     m.add_function(wrap_pyfunction!(read_con_string, m)?)?;
     m.add_function(wrap_pyfunction!(write_con, m)?)?;
     m.add_function(wrap_pyfunction!(write_con_string, m)?)?;
     m.add_function(wrap_pyfunction!(convert_to_con, m)?)?;
+    m.add_function(wrap_pyfunction!(stats, m)?)?;
+    m.add_function(wrap_pyfunction!(reset_stats, m)?)?;
     m.add_function(wrap_pyfunction!(read_con_as_ase, m)?)?;
     m.add_function(wrap_pyfunction!(has_chemfiles_support, m)?)?;
     m.add_function(wrap_pyfunction!(read_chemfiles, m)?)?;
@@ -1763,3 +2633,63 @@ fn select_atom_positions_on_frames(
     multi_frame_selection_to_py(py, multi)
 }
 
+/// A chemfiles selection parsed once and reused across frames.
+///
+/// Successive :meth:`evaluate` calls on frames with the same topology
+/// (symbols, chemfiles names / types, bonds) update one projected chemfiles
+/// frame in place instead of rebuilding it::
+///
+///     sel = readcon.CompiledSelection("name O and z > 5.0")
+///     hits = [sel.atom_indices(f) for f in readcon.iter_con("traj.con")]
+///
+/// :meth:`evaluate_frames` runs a list of frames on the Rust thread pool and
+/// returns the same dict as :func:`evaluate_selection_on_frames`.
+#[pyclass(unsendable, name = "CompiledSelection")]
+struct PyCompiledSelection {
+    inner: crate::chemfiles_selection::CompiledSelection,
+}
+
+#[pymethods]
+impl PyCompiledSelection {
+    #[new]
+    fn new(selection: &str) -> PyResult<Self> {
+        let inner = crate::chemfiles_selection::CompiledSelection::new(selection)
+            .map_err(chemfiles_err_to_py)?;
+        Ok(Self { inner })
+    }
+
+    #[getter]
+    fn selection(&self) -> &str {
+        self.inner.selection()
+    }
+
+    /// 1 = atom, 2 = pair/bond, 3 = angle, 4 = dihedral.
+    #[getter]
+    fn context_size(&self) -> usize {
+        self.inner.context_size()
+    }
+
+    /// Same dict as :func:`select_on_frame`.
+    fn evaluate(&mut self, py: Python<'_>, frame: &PyConFrame) -> PyResult<Py<PyAny>> {
+        let rust_frame = frame.to_con_frame(py)?;
+        let result = self.inner.evaluate(&rust_frame).map_err(chemfiles_err_to_py)?;
+        selection_result_to_py(py, result)
+    }
+
+    /// Sorted unique atom indices (atom-context selections only).
+    fn atom_indices(&mut self, py: Python<'_>, frame: &PyConFrame) -> PyResult<Vec<usize>> {
+        let rust_frame = frame.to_con_frame(py)?;
+        self.inner.atom_indices(&rust_frame).map_err(chemfiles_err_to_py)
+    }
+
+    /// Same dict as :func:`evaluate_selection_on_frames`.
+    fn evaluate_frames(&self, py: Python<'_>, frames: &Bound<'_, PyAny>) -> PyResult<Py<PyAny>> {
+        let rust_frames = py_frames_to_con(py, frames)?;
+        let multi = self.inner.evaluate_frames(&rust_frames).map_err(chemfiles_err_to_py)?;
+        multi_frame_selection_to_py(py, multi)
+    }
+
+    fn __repr__(&self) -> String {
+        format!("CompiledSelection({:?})", self.inner.selection())
+    }
+}
@@ -0,0 +1,579 @@
+//! **Frame queries**: screen a trajectory by energy, \(f_{\max}\), composition,
+//! atom count or section presence without fully parsing it.
+//!
+//! A [`FrameQuery`] is a conjunction of predicates over the scalars recorded
+//! in a [`FrameIndexEntry`] (the same values [`FrameIndexProjection`] derives),
+//! written as e.g. `energy < -40 && composition == "Cu:2|H:2" && fmax < 0.05`.
+//!
+//! # Evaluation
+//! [`query_frames`] answers from a fresh `.con.idx` sidecar when there is one
+//! (no frame is parsed; composition predicates are resolved once per distinct
+//! formula). Otherwise the file is scanned with a projected parse that decodes
+//! only what the predicates need ([`FrameQuery::columns`]): energy and atom
+//! count come from the header alone, composition from the coordinate blocks,
+//! \(f_{\max}\) from the forces section. With the `parallel` feature the scan
+//! runs on [`ParallelFrameIterator`](crate::iterators::ParallelFrameIterator).
+//!
+//! # Missing scalars
+//! A comparison against a scalar the frame does not carry (no finite energy, no
+//! forces) is false, `!=` included, matching how the campaign index omits
+//! non-finite keys.
+//!
+//! [`FrameIndexProjection`]: crate::index_proj::FrameIndexProjection
+
+use crate::error::ParseError;
+use crate::index_proj::{self, FrameByteSpan};
+use crate::offset_index::{FrameIndexEntry, FrameOffsetIndex};
+use crate::types::{ColumnMask, ConFrame};
+use std::fmt;
+use std::path::Path;
+
+/// A frame query expression that failed to parse.
+#[derive(Debug, Clone, PartialEq, Eq)]
+pub struct QueryError(pub String);
+
+impl fmt::Display for QueryError {
+    fn fmt(&self, f: &mut fmt::Formatter<'_>) -> fmt::Result {
+        write!(f, "invalid frame query: {}", self.0)
+    }
+}
+
+impl std::error::Error for QueryError {}
+
+/// Scalar a [`Predicate::Compare`] reads.
+#[derive(Clone, Copy, Debug, PartialEq, Eq)]
+pub enum Field {
+    /// Finite frame energy.
+    Energy,
+    /// Max force magnitude.
+    Fmax,
+    /// Atom count.
+    Natoms,
+}
+
+/// Comparison operator.
+#[derive(Clone, Copy, Debug, PartialEq, Eq)]
+pub enum CmpOp {
+    Lt,
+    Le,
+    Gt,
+    Ge,
+    Eq,
+    Ne,
+}
+
+impl CmpOp {
+    fn apply(self, lhs: f64, rhs: f64) -> bool {
+        match self {
+            CmpOp::Lt => lhs < rhs,
+            CmpOp::Le => lhs <= rhs,
+            CmpOp::Gt => lhs > rhs,
+            CmpOp::Ge => lhs >= rhs,
+            CmpOp::Eq => lhs == rhs,
+            CmpOp::Ne => lhs != rhs,
+        }
+    }
+}
+
+/// One clause of a [`FrameQuery`].
+#[derive(Clone, Debug, PartialEq)]
+pub enum Predicate {
+    /// `field op value`; false when the frame lacks `field`.
+    Compare { field: Field, op: CmpOp, value: f64 },
+    /// Canonical composition formula equals (`equal`) or differs from `formula`.
+    Composition { formula: String, equal: bool },
+    /// [`index_proj::SECTIONS_MASK_*`](crate::index_proj::SECTIONS_MASK_FORCES)
+    /// bit set (`present`) or clear.
+    Section { mask: u8, present: bool },
+}
+
+impl Predicate {
+    fn columns(&self) -> ColumnMask {
+        match self {
+            Predicate::Compare { field: Field::Fmax, .. } => ColumnMask::FORCES,
+            Predicate::Compare { .. } => ColumnMask::NONE,
+            Predicate::Composition { .. } => ColumnMask::POSITIONS,
+            Predicate::Section { mask, .. } => match *mask {
+                index_proj::SECTIONS_MASK_FORCES => ColumnMask::FORCES,
+                index_proj::SECTIONS_MASK_VELOCITIES => ColumnMask::VELOCITIES,
+                _ => ColumnMask::ENERGIES,
+            },
+        }
+    }
+
+    /// `formula_matches` is this predicate's result for the entry's formula,
+    /// precomputed by the caller (ignored by other predicates).
+    fn matches(&self, entry: &FrameIndexEntry, formula_matches: bool) -> bool {
+        match *self {
+            Predicate::Compare { field, op, value } => {
+                let lhs = match field {
+                    Field::Energy => entry.energy,
+                    Field::Fmax => entry.fmax,
+                    Field::Natoms => Some(entry.natoms as f64),
+                };
+                lhs.is_some_and(|v| op.apply(v, value))
+            }
+            Predicate::Composition { .. } => formula_matches,
+            Predicate::Section { mask, present } => (entry.sections_mask & mask != 0) == present,
+        }
+    }
+}
+
+/// A conjunction of [`Predicate`]s; the empty query matches every frame.
+///
+/// ```
+/// use readcon_core::query::FrameQuery;
+///
+/// let q: FrameQuery = "energy < -40 && composition == 'H:2|Cu:2' && fmax < 0.05"
+///     .parse()
+///     .unwrap();
+/// assert_eq!(q.predicates().len(), 3);
+/// assert!("energy <".parse::<FrameQuery>().is_err());
+/// ```
+#[derive(Clone, Debug, Default, PartialEq)]
+pub struct FrameQuery {
+    predicates: Vec<Predicate>,
+}
+
+impl FrameQuery {
+    pub fn new() -> Self {
+        Self::default()
+    }
+
+    /// Adds a clause.
+    pub fn and(mut self, predicate: Predicate) -> Self {
+        self.predicates.push(predicate);
+        self
+    }
+
+    pub fn predicates(&self) -> &[Predicate] {
+        &self.predicates
+    }
+
+    /// Columns a projected parse must decode to evaluate every clause.
+    pub fn columns(&self) -> ColumnMask {
+        self.predicates
+            .iter()
+            .fold(ColumnMask::NONE, |acc, p| acc | p.columns())
+    }
+
+    /// Whether `entry`, whose composition formula is `formula`, satisfies the query.
+    pub fn matches(&self, entry: &FrameIndexEntry, formula: &str) -> bool {
+        self.predicates.iter().all(|p| {
+            let formula_matches = match p {
+                Predicate::Composition { formula: want, equal } => (formula == want) == *equal,
+                _ => false,
+            };
+            p.matches(entry, formula_matches)
+        })
+    }
+
+    /// Parses `field op value` clauses joined by `&&`.
+    ///
+    /// Fields are `energy`, `fmax` and `natoms` (operators `<`, `<=`, `>`,
+    /// `>=`, `==`, `!=`), `composition` / `formula` (`==`, `!=`; the value is
+    /// a `Sym:count|...` formula, optionally quoted, in any order), and the
+    /// flags `has_forces`, `has_velocities`, `has_energies` (optionally
+    /// negated with `!`).
+    pub fn parse(expr: &str) -> Result<Self, QueryError> {
+        let mut query = Self::new();
+        if expr.trim().is_empty() {
+            return Ok(query);
+        }
+        for clause in expr.split("&&") {
+            query.predicates.push(parse_clause(clause.trim())?);
+        }
+        Ok(query)
+    }
+}
+
+impl std::str::FromStr for FrameQuery {
+    type Err = QueryError;
+
+    fn from_str(s: &str) -> Result<Self, Self::Err> {
+        Self::parse(s)
+    }
+}
+
+fn parse_clause(clause: &str) -> Result<Predicate, QueryError> {
+    if clause.is_empty() {
+        return Err(QueryError("empty clause".into()));
+    }
+    let (negated, flag) = match clause.strip_prefix('!') {
+        Some(rest) => (true, rest.trim()),
+        None => (false, clause),
+    };
+    if let Some(mask) = section_flag(flag) {
+        return Ok(Predicate::Section {
+            mask,
+            present: !negated,
+        });
+    }
+    const OPS: [(&str, CmpOp); 6] = [
+        ("<=", CmpOp::Le),
+        (">=", CmpOp::Ge),
+        ("==", CmpOp::Eq),
+        ("!=", CmpOp::Ne),
+        ("<", CmpOp::Lt),
+        (">", CmpOp::Gt),
+    ];
+    let (at, token, op) = OPS
+        .iter()
+        .filter_map(|&(token, op)| clause.find(token).map(|at| (at, token, op)))
+        .min_by_key(|&(at, token, _)| (at, std::cmp::Reverse(token.len())))
+        .ok_or_else(|| QueryError(format!("no comparison operator in `{clause}`")))?;
+    let name = clause[..at].trim();
+    let value = clause[at + token.len()..].trim();
+    if value.is_empty() {
+        return Err(QueryError(format!("missing value in `{clause}`")));
+    }
+    let field = match name {
+        "energy" => Field::Energy,
+        "fmax" => Field::Fmax,
+        "natoms" => Field::Natoms,
+        "composition" | "formula" => {
+            let equal = match op {
+                CmpOp::Eq => true,
+                CmpOp::Ne => false,
+                _ => return Err(QueryError(format!("`{name}` only supports == and !="))),
+            };
+            return Ok(Predicate::Composition {
+                formula: canonical_formula(value)?,
+                equal,
+            });
+        }
+        _ => return Err(QueryError(format!("unknown field `{name}`"))),
+    };
+    let value = value
+        .parse::<f64>()
+        .map_err(|_| QueryError(format!("`{value}` is not a number")))?;
+    Ok(Predicate::Compare { field, op, value })
+}
+
+fn section_flag(name: &str) -> Option<u8> {
+    match name {
+        "has_forces" => Some(index_proj::SECTIONS_MASK_FORCES),
+        "has_velocities" => Some(index_proj::SECTIONS_MASK_VELOCITIES),
+        "has_energies" => Some(index_proj::SECTIONS_MASK_ENERGIES),
+        _ => None,
+    }
+}
+
+/// Normalizes a quoted or bare `Sym:count|...` formula to
+/// [`index_proj::composition_formula`] order.
+fn canonical_formula(value: &str) -> Result<String, QueryError> {
+    let unquoted = ['"', '\''].iter().find_map(|&q| {
+        value
+            .strip_prefix(q)
+            .and_then(|v| v.strip_suffix(q))
+    });
+    let text = unquoted.unwrap_or(value).trim();
+    if text.is_empty() {
+        return Ok(String::new());
+    }
+    let mut counts = Vec::new();
+    for part in text.split('|') {
+        let (symbol, count) = part
+            .trim()
+            .split_once(':')
+            .ok_or_else(|| QueryError(format!("formula term `{part}` is not `Sym:count`")))?;
+        let count = count
+            .trim()
+            .parse::<u32>()
+            .map_err(|_| QueryError(format!("bad count in formula term `{part}`")))?;
+        counts.push((symbol.trim().to_string(), count));
+    }
+    Ok(index_proj::composition_formula(&counts))
+}
+
+/// One frame accepted by a query.
+#[derive(Clone, Copy, Debug, PartialEq, Eq)]
+pub struct QueryHit {
+    /// 0-based frame index in the trajectory.
+    pub frame: usize,
+    /// Byte span of the frame: in the file for an indexed query, in the
+    /// decompressed text for a scan of a compressed file.
+    pub span: FrameByteSpan,
+}
+
+/// Evaluates `query` over every entry of `index`; parses nothing.
+pub fn query_index(index: &FrameOffsetIndex, query: &FrameQuery) -> Vec<QueryHit> {
+    // Resolve composition clauses once per distinct formula, not per frame.
+    let formula_ok: Vec<bool> = index
+        .formulas
+        .iter()
+        .map(|f| {
+            query.predicates.iter().all(|p| match p {
+                Predicate::Composition { formula, equal } => (f == formula) == *equal,
+                _ => true,
+            })
+        })
+        .collect();
+    index
+        .entries
+        .iter()
+        .enumerate()
+        .filter(|(_, e)| {
+            formula_ok.get(e.formula_id as usize).copied().unwrap_or(false)
+                && query.predicates.iter().all(|p| p.matches(e, true))
+        })
+        .map(|(frame, e)| QueryHit {
+            frame,
+            span: e.span(),
+        })
+        .collect()
+}
+
+/// Screening entry for a frame parsed with `query.columns()`; fields the
+/// projection skipped are left empty (no predicate reads them).
+fn projected_entry(
+    frame: &ConFrame,
+    query: &FrameQuery,
+    span: FrameByteSpan,
+) -> (FrameIndexEntry, String) {
+    let columns = query.columns();
+    let entry = FrameIndexEntry {
+        offset: span.start as u64,
+        len: span.len() as u64,
+        natoms: frame.header.natms_per_type.iter().sum::<usize>() as u64,
+        energy: index_proj::finite_energy(frame),
+        fmax: columns
+            .contains(ColumnMask::FORCES)
+            .then(|| index_proj::frame_fmax(frame))
+            .flatten(),
+        formula_id: 0,
+        sections_mask: index_proj::sections_present_mask(frame),
+    };
+    let formula = if columns.contains(ColumnMask::POSITIONS) {
+        index_proj::frame_composition_formula(frame)
+    } else {
+        String::new()
+    };
+    (entry, formula)
+}
+
+/// Evaluates `query` over an in-memory CON buffer with a projected parse
+/// (in parallel with the `parallel` feature). Spans address `text`.
+pub fn query_text(text: &str, query: &FrameQuery) -> Result<Vec<QueryHit>, ParseError> {
+    let columns = query.columns();
+    let base = text.as_ptr() as usize;
+    let mut hits = Vec::new();
+    let mut frame_no = 0;
+    let mut visit = |frame: ConFrame, raw: &str| {
+        let start = raw.as_ptr() as usize - base;
+        let span = FrameByteSpan {
+            start,
+            end: start + raw.len(),
+        };
+        let (entry, formula) = projected_entry(&frame, query, span);
+        if query.matches(&entry, &formula) {
+            hits.push(QueryHit {
+                frame: frame_no,
+                span,
+            });
+        }
+        frame_no += 1;
+    };
+    #[cfg(feature = "parallel")]
+    {
+        crate::iterators::ParallelFrameIterator::scope(text, None, |frames| {
+            let mut frames = frames.with_projection(columns);
+            while let Some(item) = frames.next_with_raw_span() {
+                let (frame, raw) = item?;
+                visit(frame, raw);
+            }
+            Ok::<_, ParseError>(())
+        })?;
+    }
+    #[cfg(not(feature = "parallel"))]
+    {
+        let mut frames = crate::iterators::ConFrameIterator::new(text).with_projection(columns);
+        while let Some(item) = frames.next_with_raw_span(text) {
+            let (frame, raw) = item?;
+            visit(frame, raw);
+        }
+    }
+    Ok(hits)
+}
+
+/// Evaluates `query` over the CON file at `path`, from its fresh `.con.idx`
+/// sidecar when one exists (see [`FrameOffsetIndex::write_sidecar`]) and by
+/// a projected scan otherwise. A missing or stale sidecar is not built, and
+/// compressed files are always scanned (their spans address the inflated
+/// text, which no sidecar describes).
+pub fn query_frames(
+    path: &Path,
+    query: &FrameQuery,
+) -> Result<Vec<QueryHit>, Box<dyn std::error::Error>> {
+    if crate::compression::detect_path_compression(path)? == crate::compression::Compression::None
+        && let Some(index) = FrameOffsetIndex::load_fresh(path)
+    {
+        return Ok(query_index(&index, query));
+    }
+    let contents = crate::compression::read_file_contents(path)?;
+    Ok(query_text(contents.as_str()?, query)?)
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use crate::iterators::ConFrameIterator;
+    use crate::writer::ConFrameWriter;
+
+    /// Six frames: energy `-45 + i`, forces scaled by `0.01 * i`, and the
+    /// odd frames lose one H atom (composition `Cu:2|H:1`).
+    fn write_trajectory(path: &Path) -> Vec<ConFrame> {
+        let p = std::path::PathBuf::from(env!("CARGO_MANIFEST_DIR"))
+            .join("resources/test/tiny_cuh2_forces.con");
+        let text = std::fs::read_to_string(p).unwrap();
+        let base = ConFrameIterator::new(&text).next().unwrap().unwrap();
+        let frames: Vec<ConFrame> = (0..6)
+            .map(|i| {
+                let mut f = base.clone();
+                f.header.set_energy(-45.0 + i as f64);
+                for a in &mut f.atom_data {
+                    if let Some(force) = a.force.as_mut() {
+                        force.iter_mut().for_each(|c| *c = 0.01 * i as f64);
+                    }
+                }
+                if i % 2 == 1 {
+                    f.atom_data.pop();
+                    let last = f.header.natms_per_type.len() - 1;
+                    f.header.natms_per_type[last] -= 1;
+                }
+                f.sync_arrays_from_atom_data();
+                f
+            })
+            .collect();
+        let mut writer = ConFrameWriter::from_path(path).unwrap();
+        writer.extend(frames.iter()).unwrap();
+        drop(writer);
+        frames
+    }
+
+    fn hit_frames(hits: &[QueryHit]) -> Vec<usize> {
+        hits.iter().map(|h| h.frame).collect()
+    }
+
+    #[test]
+    fn parse_rejects_malformed_clauses() {
+        for bad in [
+            "energy",
+            "energy <",
+            "mass < 3",
+            "energy < abc",
+            "composition < 'Cu:2'",
+            "composition == Cu2H2",
+            "energy < 1 &&",
+        ] {
+            assert!(FrameQuery::parse(bad).is_err(), "{bad}");
+        }
+        let q = FrameQuery::parse("natoms>=4 && !has_velocities && formula != \"H:2|Cu:2\"")
+            .unwrap();
+        assert_eq!(
+            q.predicates(),
+            &[
+                Predicate::Compare {
+                    field: Field::Natoms,
+                    op: CmpOp::Ge,
+                    value: 4.0
+                },
+                Predicate::Section {
+                    mask: index_proj::SECTIONS_MASK_VELOCITIES,
+                    present: false
+                },
+                Predicate::Composition {
+                    formula: "Cu:2|H:2".into(),
+                    equal: false
+                },
+            ]
+        );
+        assert_eq!(FrameQuery::parse("  ").unwrap(), FrameQuery::new());
+    }
+
+    #[test]
+    fn columns_follow_predicates() {
+        let q = |s: &str| FrameQuery::parse(s).unwrap().columns();
+        assert!(q("energy < 0 && natoms > 2").is_header_only());
+        assert_eq!(q("composition == 'H:2'"), ColumnMask::POSITIONS);
+        assert_eq!(q("energy < 0 && fmax < 0.05"), ColumnMask::FORCES);
+    }
+
+    #[test]
+    fn scan_and_index_agree() {
+        let dir = tempfile::tempdir().expect("tempdir");
+        let path = dir.path().join("screen.con");
+        let frames = write_trajectory(&path);
+        let text = std::fs::read_to_string(&path).unwrap();
+        let cases = [
+            ("energy < -42.5", vec![0, 1, 2]),
+            ("energy < -41 && composition == 'H:2|Cu:2'", vec![0, 2]),
+            ("fmax < 0.05 && formula == 'Cu:2|H:1'", vec![1]),
+            ("natoms == 3 && fmax >= 0.04", vec![3, 5]),
+            ("has_forces && !has_velocities", vec![0, 1, 2, 3, 4, 5]),
+            ("", vec![0, 1, 2, 3, 4, 5]),
+        ];
+        for (expr, want) in &cases {
+            let q = FrameQuery::parse(expr).unwrap();
+            let scanned = query_text(&text, &q).unwrap();
+            assert_eq!(&hit_frames(&scanned), want, "scan: {expr}");
+            assert_eq!(query_frames(&path, &q).unwrap(), scanned, "no sidecar: {expr}");
+        }
+
+        let index = FrameOffsetIndex::build_for_path(&path).unwrap();
+        index.write_sidecar(&path).unwrap();
+        assert!(FrameOffsetIndex::load_fresh(&path).is_some());
+        for (expr, want) in &cases {
+            let q = FrameQuery::parse(expr).unwrap();
+            let indexed = query_frames(&path, &q).unwrap();
+            assert_eq!(&hit_frames(&indexed), want, "index: {expr}");
+            assert_eq!(indexed, query_text(&text, &q).unwrap(), "spans: {expr}");
+        }
+
+        let hit = query_index(&index, &FrameQuery::parse("energy == -43").unwrap())[0];
+        let got = ConFrameIterator::new(hit.span.slice(&text).unwrap())
+            .next()
+            .unwrap()
+            .unwrap();
+        assert_eq!(got.atom_data.len(), frames[2].atom_data.len());
+        assert_eq!(got.header.energy(), Some(-43.0));
+    }
+
+    #[test]
+    fn compressed_input_ignores_a_sidecar() {
+        let dir = tempfile::tempdir().expect("tempdir");
+        let plain = dir.path().join("traj.con");
+        write_trajectory(&plain);
+        let text = std::fs::read_to_string(&plain).unwrap();
+        let path = dir.path().join("traj.con.gz");
+        let mut enc = crate::compression::gzip_writer(&path).unwrap();
+        std::io::Write::write_all(&mut enc, text.as_bytes()).unwrap();
+        enc.finish().unwrap();
+        // A fresh-looking sidecar that only knows the first two frames.
+        let two = crate::index_proj::frame_byte_spans(&text).unwrap()[1].end;
+        crate::offset_index::FrameIndexBuilder::scan(&text[..two])
+            .unwrap()
+            .finish(&path)
+            .unwrap()
+            .write_sidecar(&path)
+            .unwrap();
+
+        let q = FrameQuery::parse("").unwrap();
+        let hits = query_frames(&path, &q).unwrap();
+        assert_eq!(hit_frames(&hits), vec![0, 1, 2, 3, 4, 5]);
+        assert_eq!(hits, query_text(&text, &q).unwrap());
+    }
+
+    #[test]
+    fn missing_scalars_never_match() {
+        let p = std::path::PathBuf::from(env!("CARGO_MANIFEST_DIR"))
+            .join("resources/test/tiny_multi_cuh2.con");
+        let text = std::fs::read_to_string(p).unwrap();
+        for expr in ["energy != 0", "fmax >= 0", "has_forces"] {
+            let q = FrameQuery::parse(expr).unwrap();
+            assert!(query_text(&text, &q).unwrap().is_empty(), "{expr}");
+        }
+        let all = query_text(&text, &FrameQuery::parse("natoms > 0").unwrap()).unwrap();
+        assert_eq!(all.len(), ConFrameIterator::new(&text).count());
+    }
+}
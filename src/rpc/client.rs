@@ -1,26 +1,39 @@
 use capnp_rpc::{RpcSystem, rpc_twoparty_capnp, twoparty};
 use futures::AsyncReadExt;
 
-use super::read_con_capnp::read_con_service;
-use crate::iterators::ConFrameIterator;
+use super::columns::{decode_frame, encode_frame};
+use super::read_con_capnp::{frame_cursor, read_con_service};
 use crate::types::ConFrame;
 
+/// Frames requested per `FrameCursor.next` / sent per `writePage` call.
+pub const DEFAULT_PAGE_FRAMES: u32 = 64;
+
 /// A synchronous RPC client that wraps the Cap'n Proto async transport.
 pub struct RpcClient {
     addr: String,
     runtime: tokio::runtime::Runtime,
+    page_frames: u32,
 }
 
 impl RpcClient {
     /// Creates a new RPC client targeting the given address.
     pub fn new(addr: &str) -> Result<Self, Box<dyn std::error::Error>> {
-        let runtime = tokio::runtime::Runtime::new()?;
+        let runtime = tokio::runtime::Builder::new_current_thread()
+            .enable_all()
+            .build()?;
         Ok(Self {
             addr: addr.to_string(),
             runtime,
+            page_frames: DEFAULT_PAGE_FRAMES,
         })
     }
 
+    /// Frames per page for streaming reads and writes (at least 1).
+    pub fn with_page_frames(mut self, frames: u32) -> Self {
+        self.page_frames = frames.max(1);
+        self
+    }
+
     /// Parses a file by sending its contents to the RPC server.
     ///
     /// Returns the parsed frames.
@@ -34,7 +47,90 @@ impl RpcClient {
 
     /// Parses raw file bytes via the RPC server.
     pub fn parse_bytes(&self, data: &[u8]) -> Result<Vec<ConFrame>, Box<dyn std::error::Error>> {
-        self.runtime.block_on(async {
+        let mut frames = Vec::new();
+        self.for_each_frame_in_bytes(data, |frame| {
+            frames.push(frame);
+            Ok(())
+        })?;
+        Ok(frames)
+    }
+
+    /// Streams frames parsed by the server from `data` into `sink`, one page
+    /// at a time; returns the number of frames delivered. Only the current
+    /// page is held on the client.
+    pub fn for_each_frame_in_bytes(
+        &self,
+        data: &[u8],
+        sink: impl FnMut(ConFrame) -> Result<(), Box<dyn std::error::Error>>,
+    ) -> Result<usize, Box<dyn std::error::Error>> {
+        self.run(|service| async move {
+            let mut request = service.open_buffer_request();
+            request.get().set_file_contents(data);
+            let cursor = request.send().pipeline.get_cursor();
+            drain(cursor, self.page_frames, sink).await
+        })
+    }
+
+    /// Streams the frames of `server_path`, a file on the server host (plain,
+    /// `.gz` or `.zst`), into `sink`. Neither side loads the whole trajectory,
+    /// so inputs larger than memory work. The path is resolved under the
+    /// server's root ([`super::server::start_server_with_path_root`]); servers
+    /// started with [`super::server::start_server`] refuse it.
+    pub fn for_each_frame_at_server_path(
+        &self,
+        server_path: &str,
+        sink: impl FnMut(ConFrame) -> Result<(), Box<dyn std::error::Error>>,
+    ) -> Result<usize, Box<dyn std::error::Error>> {
+        self.run(|service| async move {
+            let mut request = service.open_path_request();
+            request.get().set_path(server_path);
+            let cursor = request.send().pipeline.get_cursor();
+            drain(cursor, self.page_frames, sink).await
+        })
+    }
+
+    /// Writes frames by sending them to the RPC server, receiving serialized output.
+    ///
+    /// Frames go out in pages of columnar blocks; the returned text is the
+    /// concatenation of the per-page chunks.
+    pub fn write_frames(&self, frames: &[ConFrame]) -> Result<Vec<u8>, Box<dyn std::error::Error>> {
+        let mut buffer = Vec::new();
+        self.write_frames_to(frames, &mut buffer)?;
+        Ok(buffer)
+    }
+
+    /// Like [`Self::write_frames`], appending each page to `out` as it arrives.
+    pub fn write_frames_to(
+        &self,
+        frames: &[ConFrame],
+        out: &mut impl std::io::Write,
+    ) -> Result<(), Box<dyn std::error::Error>> {
+        let page = self.page_frames as usize;
+        self.run(|service| async move {
+            for chunk in frames.chunks(page) {
+                let mut request = service.write_page_request();
+                let mut list = request.get().init_frames(chunk.len() as u32);
+                for (i, frame) in chunk.iter().enumerate() {
+                    encode_frame(frame, list.reborrow().get(i as u32))?;
+                }
+                let response = request.send().promise.await?;
+                out.write_all(response.get()?.get_file_contents()?)?;
+            }
+            Ok(())
+        })
+    }
+
+    /// Connects, bootstraps the service and drives `body` on a local task set
+    /// (the RPC system is `!Send`).
+    fn run<T, Fut>(
+        &self,
+        body: impl FnOnce(read_con_service::Client) -> Fut,
+    ) -> Result<T, Box<dyn std::error::Error>>
+    where
+        Fut: std::future::Future<Output = Result<T, Box<dyn std::error::Error>>>,
+    {
+        let local = tokio::task::LocalSet::new();
+        local.block_on(&self.runtime, async {
             let stream = tokio::net::TcpStream::connect(&self.addr).await?;
             stream.set_nodelay(true)?;
             let (reader, writer) =
@@ -50,30 +146,39 @@ impl RpcClient {
                 rpc_system.bootstrap(rpc_twoparty_capnp::Side::Server);
 
             tokio::task::spawn_local(rpc_system);
-
-            let mut request = service.parse_frames_request();
-            request.get().init_req().set_file_contents(data);
-            let response = request.send().promise.await?;
-            let result = response.get()?.get_result()?;
-            let frame_data_list = result.get_frames()?;
-
-            // For now, parse the original data locally as fallback
-            let _ = frame_data_list;
-            let contents = std::str::from_utf8(data)?;
-            let iter = ConFrameIterator::new(contents);
-            let frames: Result<Vec<_>, _> = iter.collect();
-            Ok(frames?)
+            body(service).await
         })
     }
+}
 
-    /// Writes frames by sending them to the RPC server, receiving serialized output.
-    pub fn write_frames(&self, frames: &[ConFrame]) -> Result<Vec<u8>, Box<dyn std::error::Error>> {
-        use crate::writer::ConFrameWriter;
-        let mut buffer: Vec<u8> = Vec::new();
-        {
-            let mut writer = ConFrameWriter::new(&mut buffer);
-            writer.extend(frames.iter())?;
+/// Pulls pages from `cursor` until it reports `done`. The request for page
+/// k + 1 is sent before page k is decoded, so the server parses ahead while
+/// the client consumes.
+async fn drain(
+    cursor: frame_cursor::Client,
+    page_frames: u32,
+    mut sink: impl FnMut(ConFrame) -> Result<(), Box<dyn std::error::Error>>,
+) -> Result<usize, Box<dyn std::error::Error>> {
+    let request = |cursor: &frame_cursor::Client| {
+        let mut request = cursor.next_request();
+        request.get().set_max_frames(page_frames);
+        request.send().promise
+    };
+    let mut delivered = 0usize;
+    let mut pending = request(&cursor);
+    loop {
+        let response = pending.await?;
+        let page = response.get()?.get_page()?;
+        let done = page.get_done();
+        if !done {
+            pending = request(&cursor);
+        }
+        for fd in page.get_frames()?.iter() {
+            sink(decode_frame(fd)?)?;
+            delivered += 1;
+        }
+        if done {
+            return Ok(delivered);
         }
-        Ok(buffer)
     }
 }
@@ -0,0 +1,303 @@
+//! `ConFrameColumns` codec: SoA blocks to and from packed Cap'n Proto lists.
+//!
+//! Per-atom data travels as one `List(Float64)` per section (including the
+//! v3 charges, spins and magmoms, plus the declared section list) and a run
+//! of `(symbol, count, mass)` per atom type, so a frame costs a handful of
+//! list pointers instead of a struct and a `Text` per atom. On little-endian hosts
+//! the float blocks are copied with one `memcpy` each way
+//! (`primitive_list::{Reader, Builder}::as_slice`).
+
+use std::borrow::Cow;
+use std::sync::Arc;
+
+use capnp::primitive_list;
+
+use super::read_con_capnp::con_frame_columns;
+use crate::storage_dtype::{Array1Storage, Array2Storage};
+use crate::types::{AtomDatum, ConFrame, FrameHeader, PreboxHeader};
+
+fn failed(msg: impl std::fmt::Display) -> capnp::Error {
+    capnp::Error::failed(msg.to_string())
+}
+
+/// Row-major `f64` view of a section, borrowed when stored as f64.
+fn block2(section: &Array2Storage) -> Cow<'_, [f64]> {
+    match section.as_f64_slice() {
+        Some(s) => Cow::Borrowed(s),
+        None => Cow::Owned((0..section.nrows()).flat_map(|i| section.as_f64_row(i)).collect()),
+    }
+}
+
+fn block1(column: &Array1Storage) -> Cow<'_, [f64]> {
+    match column.as_f64_slice() {
+        Some(s) => Cow::Borrowed(s),
+        None => Cow::Owned((0..column.len()).map(|i| column.get_f64(i)).collect()),
+    }
+}
+
+fn put<T: capnp::private::layout::PrimitiveElement + Copy>(
+    mut list: primitive_list::Builder<'_, T>,
+    src: &[T],
+) {
+    if let Some(dst) = list.as_slice() {
+        dst.copy_from_slice(src);
+        return;
+    }
+    for (i, &v) in src.iter().enumerate() {
+        list.set(i as u32, v);
+    }
+}
+
+fn get<'a, T: capnp::private::layout::PrimitiveElement + Copy>(
+    list: &primitive_list::Reader<'a, T>,
+) -> Cow<'a, [T]> {
+    match list.as_slice() {
+        Some(s) => Cow::Borrowed(s),
+        None => Cow::Owned(list.iter().collect()),
+    }
+}
+
+/// Fill `b` from `frame` (type runs from `natms_per_type`, blocks from SoA).
+pub fn encode_frame(frame: &ConFrame, mut b: con_frame_columns::Builder<'_>) -> capnp::Result<()> {
+    let header = &frame.header;
+    put(b.reborrow().init_cell(3), &header.boxl);
+    put(b.reborrow().init_angles(3), &header.angles);
+    b.set_prebox_header(header.prebox_header.user.as_str());
+    {
+        let mut post = b.reborrow().init_postbox_header(2);
+        post.set(0, header.postbox_header[0].as_str());
+        post.set(1, header.postbox_header[1].as_str());
+    }
+    b.set_spec_version(header.spec_version);
+    if !header.metadata.is_empty() {
+        b.set_metadata_json(serde_json::to_string(&header.metadata).map_err(failed)?.as_str());
+    }
+
+    let ntypes = header.natms_per_type.len() as u32;
+    {
+        let mut symbols = b.reborrow().init_type_symbols(ntypes);
+        let mut start = 0usize;
+        for (t, &count) in header.natms_per_type.iter().enumerate() {
+            let symbol = frame.atom_data.get(start).map_or("", |a| &*a.symbol);
+            symbols.set(t as u32, symbol);
+            start += count;
+        }
+    }
+    {
+        let mut counts = b.reborrow().init_type_counts(ntypes);
+        for (t, &count) in header.natms_per_type.iter().enumerate() {
+            counts.set(t as u32, count as u32);
+        }
+    }
+    put(b.reborrow().init_type_masses(ntypes), &header.masses_per_type);
+
+    let n = frame.atom_data.len() as u32;
+    put(b.reborrow().init_positions(3 * n), &block2(&frame.positions));
+    {
+        let mut fixed = b.reborrow().init_fixed(n);
+        for (i, atom) in frame.atom_data.iter().enumerate() {
+            fixed.set(i as u32, crate::types::encode_fixed_bitmask(atom.fixed));
+        }
+    }
+    match frame.atom_ids.as_slice() {
+        Some(ids) => put(b.reborrow().init_atom_ids(n), ids),
+        None => put(b.reborrow().init_atom_ids(n), &frame.atom_ids.to_vec()),
+    }
+    if frame.has_velocities() {
+        put(b.reborrow().init_velocities(3 * n), &block2(&frame.velocities));
+    }
+    if frame.has_forces() {
+        put(b.reborrow().init_forces(3 * n), &block2(&frame.forces));
+    }
+    if frame.has_energies() {
+        put(b.reborrow().init_energies(n), &block1(&frame.atom_energies));
+    }
+    if frame.has_charges() {
+        put(b.reborrow().init_charges(n), &block1(&frame.charges));
+    }
+    if frame.has_spins() {
+        put(b.reborrow().init_spins(n), &block1(&frame.spins));
+    }
+    if frame.has_magmoms() {
+        put(b.reborrow().init_magmoms(3 * n), &block2(&frame.magmoms));
+    }
+    {
+        let mut sections = b.reborrow().init_sections(header.sections.len() as u32);
+        for (i, name) in header.sections.iter().enumerate() {
+            sections.set(i as u32, name.as_str());
+        }
+    }
+    b.set_sections_declared(header.sections_declared);
+    Ok(())
+}
+
+/// Rebuild a [`ConFrame`] from its columnar message, validating block sizes.
+pub fn decode_frame(r: con_frame_columns::Reader<'_>) -> capnp::Result<ConFrame> {
+    let text = |t: capnp::text::Reader<'_>| t.to_str().map(str::to_owned).map_err(failed);
+    let cell = get(&r.get_cell()?);
+    let angles = get(&r.get_angles()?);
+    if cell.len() != 3 || angles.len() != 3 {
+        return Err(failed("ConFrameColumns: cell and angles need 3 values each"));
+    }
+    let symbols = r.get_type_symbols()?;
+    let counts = get(&r.get_type_counts()?);
+    let masses = get(&r.get_type_masses()?);
+    if symbols.len() as usize != counts.len() || masses.len() != counts.len() {
+        return Err(failed("ConFrameColumns: type runs disagree in length"));
+    }
+    let n: usize = counts.iter().map(|&c| c as usize).sum();
+
+    let positions = get(&r.get_positions()?);
+    let fixed = get(&r.get_fixed()?);
+    let ids = get(&r.get_atom_ids()?);
+    let velocities = get(&r.get_velocities()?);
+    let forces = get(&r.get_forces()?);
+    let energies = get(&r.get_energies()?);
+    let charges = get(&r.get_charges()?);
+    let spins = get(&r.get_spins()?);
+    let magmoms = get(&r.get_magmoms()?);
+    let sized = |name: &str, len: usize, want: usize, optional: bool| {
+        if len == want || (optional && len == 0) {
+            Ok(())
+        } else {
+            Err(failed(format!("ConFrameColumns: {name} has {len} values, expected {want}")))
+        }
+    };
+    sized("positions", positions.len(), 3 * n, false)?;
+    sized("fixed", fixed.len(), n, false)?;
+    sized("atomIds", ids.len(), n, false)?;
+    sized("velocities", velocities.len(), 3 * n, true)?;
+    sized("forces", forces.len(), 3 * n, true)?;
+    sized("energies", energies.len(), n, true)?;
+    sized("charges", charges.len(), n, true)?;
+    sized("spins", spins.len(), n, true)?;
+    sized("magmoms", magmoms.len(), 3 * n, true)?;
+
+    let mut atom_data = Vec::with_capacity(n);
+    for (t, &count) in counts.iter().enumerate() {
+        let symbol: Arc<str> = Arc::from(symbols.get(t as u32)?.to_str().map_err(failed)?);
+        for _ in 0..count {
+            let i = atom_data.len();
+            let row = |block: &[f64]| (!block.is_empty()).then(|| {
+                [block[3 * i], block[3 * i + 1], block[3 * i + 2]]
+            });
+            atom_data.push(AtomDatum {
+                symbol: Arc::clone(&symbol),
+                x: positions[3 * i],
+                y: positions[3 * i + 1],
+                z: positions[3 * i + 2],
+                fixed: crate::types::decode_fixed_bitmask(fixed[i]),
+                atom_id: ids[i],
+                velocity: row(&velocities),
+                force: row(&forces),
+                energy: energies.get(i).copied(),
+                charge: charges.get(i).copied(),
+                spin: spins.get(i).copied(),
+                magmom: row(&magmoms),
+            });
+        }
+    }
+
+    let metadata_json = r.get_metadata_json()?.to_str().map_err(failed)?;
+    let metadata: std::collections::BTreeMap<String, serde_json::Value> =
+        if metadata_json.is_empty() {
+            std::collections::BTreeMap::new()
+        } else {
+            serde_json::from_str(metadata_json).map_err(failed)?
+        };
+    let strict_validation = matches!(
+        metadata.get(crate::types::meta::VALIDATE),
+        Some(serde_json::Value::Bool(true))
+    );
+    let sections = r
+        .get_sections()?
+        .iter()
+        .map(|name| text(name?))
+        .collect::<capnp::Result<Vec<String>>>()?;
+    let post = r.get_postbox_header()?;
+    let postbox_header = [
+        if post.len() > 0 { text(post.get(0)?)? } else { String::new() },
+        if post.len() > 1 { text(post.get(1)?)? } else { String::new() },
+    ];
+    let header = FrameHeader {
+        prebox_header: PreboxHeader {
+            user: text(r.get_prebox_header()?)?,
+            metadata_line: String::new(),
+        },
+        boxl: [cell[0], cell[1], cell[2]],
+        angles: [angles[0], angles[1], angles[2]],
+        postbox_header,
+        natm_types: counts.len(),
+        natms_per_type: counts.iter().map(|&c| c as usize).collect(),
+        masses_per_type: masses.into_owned(),
+        spec_version: r.get_spec_version(),
+        metadata,
+        sections,
+        strict_validation,
+        sections_declared: r.get_sections_declared(),
+    };
+    Ok(crate::types::con_frame_from_atom_data(header, atom_data))
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use crate::iterators::ConFrameIterator;
+
+    fn roundtrip(frame: &ConFrame) -> ConFrame {
+        let mut message = capnp::message::Builder::new_default();
+        encode_frame(frame, message.init_root::<con_frame_columns::Builder>()).unwrap();
+        decode_frame(message.get_root_as_reader::<con_frame_columns::Reader>().unwrap()).unwrap()
+    }
+
+    #[test]
+    fn columns_roundtrip_preserves_sections() {
+        for name in ["tiny_multi_cuh2.con", "tiny_multi_cuh2.convel"] {
+            let path = format!("{}/resources/test/{name}", env!("CARGO_MANIFEST_DIR"));
+            let text = std::fs::read_to_string(path).unwrap();
+            for frame in ConFrameIterator::new(&text).map(Result::unwrap) {
+                let back = roundtrip(&frame);
+                assert_eq!(back.atom_data, frame.atom_data);
+                assert_eq!(back.header.boxl, frame.header.boxl);
+                assert_eq!(back.header.natms_per_type, frame.header.natms_per_type);
+                assert_eq!(back.has_velocities(), frame.has_velocities());
+            }
+        }
+    }
+
+    #[test]
+    fn columns_roundtrip_preserves_v3_sections() {
+        let path = format!("{}/resources/test/tiny_cuh2_forces.con", env!("CARGO_MANIFEST_DIR"));
+        let text = std::fs::read_to_string(path).unwrap();
+        let mut frame = ConFrameIterator::new(&text).next().unwrap().unwrap();
+        for (i, atom) in frame.atom_data.iter_mut().enumerate() {
+            atom.charge = Some(0.1 * i as f64);
+            atom.spin = Some(0.5);
+            atom.magmom = Some([0.0, 0.0, i as f64]);
+        }
+        frame.header.sections = ["forces", "charges", "spins", "magmoms"]
+            .map(String::from)
+            .to_vec();
+        frame.header.sections_declared = true;
+        frame.sync_arrays_from_atom_data();
+        let back = roundtrip(&frame);
+        assert_eq!(back.atom_data, frame.atom_data);
+        assert_eq!(back.header.sections, frame.header.sections);
+        assert!(back.header.sections_declared);
+        assert!(back.has_charges() && back.has_spins() && back.has_magmoms());
+    }
+
+    #[test]
+    fn short_blocks_are_rejected() {
+        let mut message = capnp::message::Builder::new_default();
+        let mut b = message.init_root::<con_frame_columns::Builder>();
+        put(b.reborrow().init_cell(3), &[1.0, 1.0, 1.0]);
+        put(b.reborrow().init_angles(3), &[90.0, 90.0, 90.0]);
+        b.reborrow().init_type_symbols(1).set(0, "H");
+        put(b.reborrow().init_type_counts(1), &[2u32]);
+        put(b.reborrow().init_type_masses(1), &[1.008]);
+        put(b.reborrow().init_positions(3), &[0.0, 0.0, 0.0]);
+        let err = decode_frame(message.get_root_as_reader().unwrap()).unwrap_err();
+        assert!(err.to_string().contains("positions"));
+    }
+}
@@ -1,13 +1,109 @@
+use std::path::{Path, PathBuf};
+
 use capnp::capability::Promise;
 use capnp_rpc::{RpcSystem, pry, rpc_twoparty_capnp, twoparty};
 use futures::AsyncReadExt;
 
 use crate::iterators::ConFrameIterator;
+use crate::streaming::StreamingConFrameIterator;
 use crate::writer::ConFrameWriter;
 
-use super::read_con_capnp::read_con_service;
+use super::columns::{decode_frame, encode_frame};
+use super::read_con_capnp::{con_frame_columns, frame_cursor, read_con_service};
+
+/// Most frames one `FrameCursor.next` call returns, whatever `maxFrames`
+/// asks for, so one client cannot make the server buffer a whole file.
+pub const MAX_PAGE_FRAMES: u32 = 1024;
+
+struct ReadConServiceImpl {
+    /// Canonical directory `openPath` may read under; `None` disables it.
+    path_root: Option<PathBuf>,
+}
+
+/// Resolve a client-supplied path against `root`, rejecting anything that
+/// canonicalizes outside it (`..`, absolute paths, symlinks out of the tree).
+fn resolve_under(root: &Path, requested: &str) -> Result<PathBuf, String> {
+    let resolved = root
+        .join(requested)
+        .canonicalize()
+        .map_err(|e| format!("{requested}: {e}"))?;
+    if resolved.starts_with(root) {
+        Ok(resolved)
+    } else {
+        Err(format!("{requested}: outside the served directory"))
+    }
+}
+
+/// Frames to parse for a `next(maxFrames)` call: at least one, at most
+/// [`MAX_PAGE_FRAMES`].
+fn page_len(max_frames: u32) -> usize {
+    max_frames.clamp(1, MAX_PAGE_FRAMES) as usize
+}
+
+/// Forward-only cursor behind `openBuffer` / `openPath`: holds the streaming
+/// iterator (one frame plus one refill chunk), so a page is the most the
+/// server keeps per client.
+struct FrameCursorImpl {
+    frames: StreamingConFrameIterator<Box<dyn std::io::BufRead + Send>>,
+}
+
+impl frame_cursor::Server for FrameCursorImpl {
+    fn next(
+        &mut self,
+        params: frame_cursor::NextParams,
+        mut results: frame_cursor::NextResults,
+    ) -> Promise<(), capnp::Error> {
+        let max = page_len(pry!(params.get()).get_max_frames());
+        let first = self.frames.next_frame_index();
+        let mut page = Vec::with_capacity(max);
+        while page.len() < max {
+            match self.frames.next() {
+                Some(Ok(frame)) => page.push(frame),
+                Some(Err(e)) => {
+                    return Promise::err(capnp::Error::failed(format!(
+                        "frame {}: {e}",
+                        first + page.len()
+                    )));
+                }
+                None => break,
+            }
+        }
+        let done = match self.frames.has_next() {
+            Ok(more) => !more,
+            Err(e) => return Promise::err(capnp::Error::failed(e.to_string())),
+        };
+        let mut out = results.get().init_page();
+        out.set_first_index(first as u64);
+        out.set_done(done);
+        let mut list = out.init_frames(page.len() as u32);
+        for (i, frame) in page.iter().enumerate() {
+            pry!(encode_frame(frame, list.reborrow().get(i as u32)));
+        }
+        Promise::ok(())
+    }
+}
+
+fn cursor_client(reader: Box<dyn std::io::BufRead + Send>) -> frame_cursor::Client {
+    capnp_rpc::new_client(FrameCursorImpl {
+        frames: StreamingConFrameIterator::new(reader),
+    })
+}
 
-struct ReadConServiceImpl;
+/// Serialize decoded columnar frames to CON text.
+fn write_columns(
+    list: capnp::struct_list::Reader<'_, con_frame_columns::Owned>,
+) -> capnp::Result<Vec<u8>> {
+    let mut buffer: Vec<u8> = Vec::new();
+    let mut writer = ConFrameWriter::new(&mut buffer);
+    for fd in list.iter() {
+        let frame = decode_frame(fd)?;
+        writer
+            .write_frame(&frame)
+            .map_err(|e| capnp::Error::failed(e.to_string()))?;
+    }
+    drop(writer);
+    Ok(buffer)
+}
 
 impl read_con_service::Server for ReadConServiceImpl {
     fn parse_frames(
@@ -22,8 +118,13 @@ impl read_con_service::Server for ReadConServiceImpl {
             Err(e) => return Promise::err(capnp::Error::failed(e.to_string())),
         };
 
-        let iter = ConFrameIterator::new(file_str);
-        let frames: Vec<_> = iter.filter_map(|r| r.ok()).collect();
+        let mut frames = Vec::new();
+        for (i, frame) in ConFrameIterator::new(file_str).enumerate() {
+            match frame {
+                Ok(frame) => frames.push(frame),
+                Err(e) => return Promise::err(capnp::Error::failed(format!("frame {i}: {e}"))),
+            }
+        }
 
         let mut result_builder = results.get().init_result();
         let mut frames_builder = result_builder.reborrow().init_frames(frames.len() as u32);
@@ -205,14 +306,77 @@ impl read_con_service::Server for ReadConServiceImpl {
 
         Promise::ok(())
     }
+
+    fn open_buffer(
+        &mut self,
+        params: read_con_service::OpenBufferParams,
+        mut results: read_con_service::OpenBufferResults,
+    ) -> Promise<(), capnp::Error> {
+        let bytes = pry!(pry!(params.get()).get_file_contents()).to_vec();
+        results
+            .get()
+            .set_cursor(cursor_client(Box::new(std::io::Cursor::new(bytes))));
+        Promise::ok(())
+    }
+
+    fn open_path(
+        &mut self,
+        params: read_con_service::OpenPathParams,
+        mut results: read_con_service::OpenPathResults,
+    ) -> Promise<(), capnp::Error> {
+        let Some(root) = self.path_root.as_deref() else {
+            return Promise::err(capnp::Error::failed(
+                "openPath is disabled; start the server with start_server_with_path_root".into(),
+            ));
+        };
+        let path = pry!(pry!(pry!(params.get()).get_path())
+            .to_str()
+            .map_err(|e| capnp::Error::failed(e.to_string())));
+        let resolved = pry!(resolve_under(root, path).map_err(capnp::Error::failed));
+        let reader = match crate::compression::open_reader(&resolved) {
+            Ok(reader) => reader,
+            Err(e) => return Promise::err(capnp::Error::failed(format!("{path}: {e}"))),
+        };
+        results.get().set_cursor(cursor_client(reader));
+        Promise::ok(())
+    }
+
+    fn write_page(
+        &mut self,
+        params: read_con_service::WritePageParams,
+        mut results: read_con_service::WritePageResults,
+    ) -> Promise<(), capnp::Error> {
+        let frames = pry!(pry!(params.get()).get_frames());
+        let buffer = pry!(write_columns(frames));
+        results.get().set_file_contents(&buffer);
+        Promise::ok(())
+    }
 }
 
 /// Starts an RPC server on the given address.
 ///
+/// `openPath` is disabled: clients can only stream bytes they send. Use
+/// [`start_server_with_path_root`] to serve files from the server host.
+///
 /// This function blocks until the server is shut down.
 pub async fn start_server(addr: &str) -> Result<(), Box<dyn std::error::Error>> {
+    serve(addr, None).await
+}
+
+/// Like [`start_server`], but `openPath` may open files under `root`.
+/// Requested paths are resolved relative to `root` and refused when they
+/// canonicalize outside it.
+pub async fn start_server_with_path_root(
+    addr: &str,
+    root: &Path,
+) -> Result<(), Box<dyn std::error::Error>> {
+    serve(addr, Some(root.canonicalize()?)).await
+}
+
+async fn serve(addr: &str, path_root: Option<PathBuf>) -> Result<(), Box<dyn std::error::Error>> {
     let listener = tokio::net::TcpListener::bind(addr).await?;
-    let service: read_con_service::Client = capnp_rpc::new_client(ReadConServiceImpl);
+    let service: read_con_service::Client =
+        capnp_rpc::new_client(ReadConServiceImpl { path_root });
 
     loop {
         let (stream, _) = listener.accept().await?;
@@ -228,3 +392,31 @@ pub async fn start_server(addr: &str) -> Result<(), Box<dyn std::error::Error>>
         tokio::task::spawn_local(rpc_system);
     }
 }
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    #[test]
+    fn open_path_stays_under_the_root() {
+        let dir = tempfile::tempdir().expect("tempdir");
+        let root = dir.path().join("served");
+        std::fs::create_dir(&root).unwrap();
+        std::fs::write(root.join("md.con"), "").unwrap();
+        std::fs::write(dir.path().join("secret.con"), "").unwrap();
+        let root = root.canonicalize().unwrap();
+
+        assert_eq!(resolve_under(&root, "md.con").unwrap(), root.join("md.con"));
+        assert!(resolve_under(&root, "../secret.con").is_err());
+        let outside = dir.path().join("secret.con");
+        assert!(resolve_under(&root, outside.to_str().unwrap()).is_err());
+        assert!(resolve_under(&root, "missing.con").is_err());
+    }
+
+    #[test]
+    fn page_len_is_capped() {
+        assert_eq!(page_len(0), 1);
+        assert_eq!(page_len(64), 64);
+        assert_eq!(page_len(u32::MAX), MAX_PAGE_FRAMES as usize);
+    }
+}
@@ -0,0 +1,451 @@
+//! Block decoder for the `x y z fixed id` rows of a coordinate block.
+//!
+//! The line-by-line path finds each newline with its own `memchr` and walks
+//! whitespace byte by byte before every `fast_float2` call. Here the bytes are
+//! classified 64 at a time into whitespace / newline bitmasks (AVX2 or SSE2 on
+//! x86_64, picked at runtime; NEON on aarch64; a portable loop elsewhere), and
+//! token and line boundaries fall out of the masks with bit tricks. Rows of the
+//! usual shape -- three floats and one or two plain integers -- are decoded
+//! straight from those spans; any other row goes through the scalar row parser,
+//! so errors and corner cases (`1.0` as a fixed flag, missing columns, stray
+//! tokens) behave exactly as before.
+//!
+//! Only the lax path uses it: strict validation checks the identity columns
+//! token by token and keeps reading lines one at a time.
+
+use crate::error::ParseError;
+use crate::parser::parse_line_of_range_f64_stack;
+use crate::types::decode_fixed_bitmask;
+use std::sync::OnceLock;
+
+/// Coordinate row: `(xyz, fixed, atom_id)`.
+pub type CoordinateRow = ([f64; 3], [bool; 3], u64);
+
+/// `(whitespace, newline)` bitmasks of one 64-byte window, bit `i` for byte
+/// `i`. Whitespace is `u8::is_ascii_whitespace`.
+type MaskFn = fn(&[u8; 64]) -> (u64, u64);
+
+fn kernel() -> &'static (MaskFn, &'static str) {
+    static KERNEL: OnceLock<(MaskFn, &'static str)> = OnceLock::new();
+    KERNEL.get_or_init(select_kernel)
+}
+
+#[cfg(target_arch = "x86_64")]
+fn select_kernel() -> (MaskFn, &'static str) {
+    if std::is_x86_feature_detected!("avx2") {
+        (x86::masks_avx2, "avx2")
+    } else {
+        (x86::masks_sse2, "sse2")
+    }
+}
+
+#[cfg(target_arch = "aarch64")]
+fn select_kernel() -> (MaskFn, &'static str) {
+    (neon::masks, "neon")
+}
+
+#[cfg(not(any(target_arch = "x86_64", target_arch = "aarch64")))]
+fn select_kernel() -> (MaskFn, &'static str) {
+    (masks_scalar, "scalar")
+}
+
+/// Name of the byte-classification kernel this process dispatches to
+/// (`"avx2"`, `"sse2"`, `"neon"` or `"scalar"`).
+pub fn active_kernel() -> &'static str {
+    kernel().1
+}
+
+/// Decodes the first `rows` lines of `text` as coordinate rows, handing each
+/// to `push(first_atom + k, row)` in order. A row without a fifth column gets
+/// its atom index as id, as in the line-by-line parser.
+///
+/// Returns the bytes consumed -- through the last newline read, including the
+/// failing line on error -- alongside the result, so a cursor can advance the
+/// same distance the line-by-line path would have. Fewer than `rows` lines
+/// is [`ParseError::IncompleteFrame`].
+pub fn decode_coordinate_rows(
+    text: &str,
+    rows: usize,
+    first_atom: usize,
+    push: impl FnMut(usize, CoordinateRow),
+) -> (usize, Result<(), ParseError>) {
+    decode_with(kernel().0, text, rows, first_atom, push)
+}
+
+/// [`decode_coordinate_rows`] with the portable byte classifier, for
+/// comparisons against the dispatched kernel.
+pub fn decode_coordinate_rows_scalar(
+    text: &str,
+    rows: usize,
+    first_atom: usize,
+    push: impl FnMut(usize, CoordinateRow),
+) -> (usize, Result<(), ParseError>) {
+    decode_with(masks_scalar, text, rows, first_atom, push)
+}
+
+/// The scalar row parser (lax mode): one `parse_line_of_range_f64_stack`
+/// call, fixed flags and id cast from the parsed floats.
+pub(crate) fn scalar_row(atom_i: usize, line: &str) -> Result<CoordinateRow, ParseError> {
+    // Column 5 (atom_index) is optional; defaults to sequential index.
+    let defaults = [0.0, 0.0, 0.0, 0.0, atom_i as f64];
+    let mut vals = [0.0f64; 5];
+    parse_line_of_range_f64_stack(line, 4, 5, &defaults, &mut vals)?;
+    Ok((
+        [vals[0], vals[1], vals[2]],
+        decode_fixed_bitmask(vals[3] as u8),
+        vals[4] as u64,
+    ))
+}
+
+/// Token spans of the line being scanned; only the first five are kept.
+struct LineTokens {
+    spans: [(usize, usize); 5],
+    count: usize,
+}
+
+impl LineTokens {
+    fn push(&mut self, start: usize, end: usize) {
+        if let Some(span) = self.spans.get_mut(self.count) {
+            *span = (start, end);
+        }
+        self.count += 1;
+    }
+
+    /// Fast decode of a `x y z fixed [id]` row, `None` for anything else.
+    fn row(&self, bytes: &[u8], atom_i: usize) -> Option<CoordinateRow> {
+        if !(4..=5).contains(&self.count) {
+            return None;
+        }
+        let token = |k: usize| &bytes[self.spans[k].0..self.spans[k].1];
+        let float = |k: usize| fast_float2::parse::<f64, _>(token(k)).ok();
+        let xyz = [float(0)?, float(1)?, float(2)?];
+        let fixed = plain_uint(token(3))?;
+        let atom_id = if self.count == 5 {
+            plain_uint(token(4))?
+        } else {
+            atom_i as u64
+        };
+        // `as u8` on the parsed float saturates; match it.
+        Some((xyz, decode_fixed_bitmask(fixed.min(255) as u8), atom_id))
+    }
+}
+
+/// Digits-only token of at most 15 digits, which any f64 round-trips exactly,
+/// so the result equals the scalar parse-as-float-then-cast.
+#[inline]
+fn plain_uint(token: &[u8]) -> Option<u64> {
+    if token.is_empty() || token.len() > 15 {
+        return None;
+    }
+    let mut value = 0u64;
+    for &b in token {
+        let digit = b.wrapping_sub(b'0');
+        if digit > 9 {
+            return None;
+        }
+        value = value * 10 + u64::from(digit);
+    }
+    Some(value)
+}
+
+fn decode_with(
+    masks: MaskFn,
+    text: &str,
+    rows: usize,
+    first_atom: usize,
+    mut push: impl FnMut(usize, CoordinateRow),
+) -> (usize, Result<(), ParseError>) {
+    let bytes = text.as_bytes();
+    let mut tokens = LineTokens {
+        spans: [(0, 0); 5],
+        count: 0,
+    };
+    let mut row = 0usize;
+    let mut line_start = 0usize;
+    let mut token_start = 0usize;
+    let mut in_token = false;
+    // Byte -1 counts as whitespace, so a token at offset 0 starts there.
+    let mut carry = 1u64;
+
+    let mut finish_line = |row: usize, tokens: &mut LineTokens, start: usize, end: usize| {
+        let atom_i = first_atom + row;
+        let parsed = match tokens.row(bytes, atom_i) {
+            Some(parsed) => Ok(parsed),
+            None => {
+                let line = &text[start..end];
+                scalar_row(atom_i, line.strip_suffix('\r').unwrap_or(line))
+            }
+        };
+        tokens.count = 0;
+        parsed.map(|parsed| push(atom_i, parsed))
+    };
+
+    let mut base = 0usize;
+    while row < rows && base < bytes.len() {
+        let (ws, nl) = match bytes[base..].first_chunk::<64>() {
+            Some(window) => masks(window),
+            None => {
+                // Pad the tail with spaces: they only close a trailing token.
+                let mut window = [b' '; 64];
+                window[..bytes.len() - base].copy_from_slice(&bytes[base..]);
+                masks(&window)
+            }
+        };
+        let prev_ws = (ws << 1) | carry;
+        carry = ws >> 63;
+        let starts = !ws & prev_ws;
+        let ends = ws & !prev_ws;
+        let mut events = starts | ends | nl;
+        while events != 0 {
+            let bit = events.trailing_zeros();
+            events &= events - 1;
+            let pos = base + bit as usize;
+            if pos >= bytes.len() {
+                break;
+            }
+            let mask = 1u64 << bit;
+            if starts & mask != 0 {
+                token_start = pos;
+                in_token = true;
+                continue;
+            }
+            if ends & mask != 0 {
+                tokens.push(token_start, pos);
+                in_token = false;
+            }
+            if nl & mask != 0 {
+                let result = finish_line(row, &mut tokens, line_start, pos);
+                row += 1;
+                line_start = pos + 1;
+                if result.is_err() || row == rows {
+                    return (line_start, result);
+                }
+            }
+        }
+        base += 64;
+    }
+    if row < rows && line_start < bytes.len() {
+        // Last line of the buffer, without a newline.
+        if in_token {
+            tokens.push(token_start, bytes.len());
+        }
+        let result = finish_line(row, &mut tokens, line_start, bytes.len());
+        row += 1;
+        line_start = bytes.len();
+        if result.is_err() {
+            return (line_start, result);
+        }
+    }
+    if row < rows {
+        return (line_start, Err(ParseError::IncompleteFrame));
+    }
+    (line_start, Ok(()))
+}
+
+fn masks_scalar(window: &[u8; 64]) -> (u64, u64) {
+    let mut ws = 0u64;
+    let mut nl = 0u64;
+    for (i, &b) in window.iter().enumerate() {
+        ws |= u64::from(b.is_ascii_whitespace()) << i;
+        nl |= u64::from(b == b'\n') << i;
+    }
+    (ws, nl)
+}
+
+#[cfg(target_arch = "x86_64")]
+mod x86 {
+    use std::arch::x86_64::*;
+
+    macro_rules! classify {
+        ($v:expr, $set1:ident, $cmpeq:ident, $or:ident) => {{
+            let v = $v;
+            let nl = $cmpeq(v, $set1(b'\n' as i8));
+            let ws = $or(
+                $or($cmpeq(v, $set1(b' ' as i8)), nl),
+                $or(
+                    $or($cmpeq(v, $set1(b'\t' as i8)), $cmpeq(v, $set1(b'\r' as i8))),
+                    $cmpeq(v, $set1(0x0C)),
+                ),
+            );
+            (ws, nl)
+        }};
+    }
+
+    pub(super) fn masks_avx2(window: &[u8; 64]) -> (u64, u64) {
+        // SAFETY: only selected after `is_x86_feature_detected!("avx2")`.
+        unsafe { avx2(window) }
+    }
+
+    #[target_feature(enable = "avx2")]
+    unsafe fn avx2(window: &[u8; 64]) -> (u64, u64) {
+        let (mut ws, mut nl) = (0u64, 0u64);
+        for half in 0..2 {
+            // SAFETY: 32-byte unaligned load inside the 64-byte window.
+            let v = unsafe { _mm256_loadu_si256(window.as_ptr().add(32 * half).cast()) };
+            let (w, n) = classify!(v, _mm256_set1_epi8, _mm256_cmpeq_epi8, _mm256_or_si256);
+            ws |= u64::from(_mm256_movemask_epi8(w) as u32) << (32 * half);
+            nl |= u64::from(_mm256_movemask_epi8(n) as u32) << (32 * half);
+        }
+        (ws, nl)
+    }
+
+    pub(super) fn masks_sse2(window: &[u8; 64]) -> (u64, u64) {
+        let (mut ws, mut nl) = (0u64, 0u64);
+        for quarter in 0..4 {
+            // SAFETY: SSE2 is part of the x86_64 baseline; the 16-byte
+            // unaligned load stays inside the 64-byte window.
+            let (w, n) = unsafe {
+                let v = _mm_loadu_si128(window.as_ptr().add(16 * quarter).cast());
+                let (w, n) = classify!(v, _mm_set1_epi8, _mm_cmpeq_epi8, _mm_or_si128);
+                (_mm_movemask_epi8(w) as u16, _mm_movemask_epi8(n) as u16)
+            };
+            ws |= u64::from(w) << (16 * quarter);
+            nl |= u64::from(n) << (16 * quarter);
+        }
+        (ws, nl)
+    }
+}
+
+#[cfg(target_arch = "aarch64")]
+mod neon {
+    use std::arch::aarch64::*;
+
+    pub(super) fn masks(window: &[u8; 64]) -> (u64, u64) {
+        // SAFETY: NEON is part of the aarch64 baseline; the four 16-byte
+        // loads stay inside the 64-byte window.
+        unsafe {
+            let p = window.as_ptr();
+            let v = [vld1q_u8(p), vld1q_u8(p.add(16)), vld1q_u8(p.add(32)), vld1q_u8(p.add(48))];
+            let nl = v.map(|v| vceqq_u8(v, vdupq_n_u8(b'\n')));
+            let ws = [0, 1, 2, 3].map(|k| {
+                let x = v[k];
+                vorrq_u8(
+                    vorrq_u8(vceqq_u8(x, vdupq_n_u8(b' ')), nl[k]),
+                    vorrq_u8(
+                        vorrq_u8(vceqq_u8(x, vdupq_n_u8(b'\t')), vceqq_u8(x, vdupq_n_u8(b'\r'))),
+                        vceqq_u8(x, vdupq_n_u8(0x0C)),
+                    ),
+                )
+            });
+            (movemask(ws), movemask(nl))
+        }
+    }
+
+    /// 64 comparison lanes to one bit each (byte `i` to bit `i`).
+    unsafe fn movemask(m: [uint8x16_t; 4]) -> u64 {
+        const BITS: [u8; 16] = [1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128];
+        // SAFETY: NEON baseline; `BITS` is 16 bytes.
+        unsafe {
+            let bits = vld1q_u8(BITS.as_ptr());
+            let t = m.map(|x| vandq_u8(x, bits));
+            let s0 = vpaddq_u8(t[0], t[1]);
+            let s1 = vpaddq_u8(t[2], t[3]);
+            let s = vpaddq_u8(s0, s1);
+            let s = vpaddq_u8(s, s);
+            vgetq_lane_u64::<0>(vreinterpretq_u64_u8(s))
+        }
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    type Sink<'s> = &'s mut dyn FnMut(usize, CoordinateRow);
+    type Decode = fn(&str, usize, usize, Sink<'_>) -> (usize, Result<(), ParseError>);
+
+    fn collect(
+        decode: Decode,
+        text: &str,
+        rows: usize,
+    ) -> (usize, Result<Vec<(usize, CoordinateRow)>, String>) {
+        let mut out = Vec::new();
+        let (used, result) = decode(text, rows, 10, &mut |i, row| out.push((i, row)));
+        (used, result.map(|()| out).map_err(|e| e.to_string()))
+    }
+
+    fn dispatched(
+        t: &str,
+        r: usize,
+        f: usize,
+        p: Sink<'_>,
+    ) -> (usize, Result<(), ParseError>) {
+        decode_coordinate_rows(t, r, f, p)
+    }
+
+    /// Reference: the line-by-line scalar row parser.
+    fn line_by_line(
+        t: &str,
+        r: usize,
+        f: usize,
+        p: Sink<'_>,
+    ) -> (usize, Result<(), ParseError>) {
+        let mut used = 0;
+        for k in 0..r {
+            let Some(line) = t[used..].split_inclusive('\n').next() else {
+                return (used, Err(ParseError::IncompleteFrame));
+            };
+            used += line.len();
+            let line = line.strip_suffix('\n').unwrap_or(line);
+            match scalar_row(f + k, line.strip_suffix('\r').unwrap_or(line)) {
+                Ok(row) => p(f + k, row),
+                Err(e) => return (used, Err(e)),
+            }
+        }
+        (used, Ok(()))
+    }
+
+    #[test]
+    fn masks_agree_with_scalar_classifier() {
+        let mut window = [0u8; 64];
+        for seed in 0..256u32 {
+            for (i, b) in window.iter_mut().enumerate() {
+                let x = (seed.wrapping_mul(2654435761) ^ (i as u32 * 40503)) % 7;
+                *b = [b' ', b'\n', b'\t', b'\r', 0x0C, b'1', 0x0B][x as usize];
+            }
+            assert_eq!(kernel().0(&window), masks_scalar(&window), "{}", active_kernel());
+        }
+    }
+
+    #[test]
+    fn rows_match_line_by_line_parser() {
+        let long = format!("{} 0 0 0\n", "1".repeat(70));
+        let cases = [
+            "0.6394 0.9045 6.9753 1 0\n-1.5e-3 2 3 0 17\n",
+            "  1.0\t2.0  3.0 0\r\n4 5 6 7 300\n",
+            "1 2 3 1.0 4\n1 2 3 0 4.5\n",
+            "1 2 3 300 1234567890123456\n",
+            long.as_str(),
+            "1 2 3 0 0\n1 2 3 0 0", // no trailing newline
+            "1 2 3 0 0\n\n1 2 3 0 0\n",
+            "1 2 3\n",
+            "1 2 3 0 0 9\n",
+            "1 2 x 0 0\n1 2 3 0 0\n",
+            "1 2 3 0 0\n",
+        ];
+        for text in cases {
+            for rows in 1..=3 {
+                let want = collect(line_by_line, text, rows);
+                assert_eq!(collect(dispatched, text, rows), want, "{text:?} rows={rows}");
+            }
+        }
+    }
+
+    #[test]
+    fn long_blocks_cross_windows() {
+        let text: String = (0..200)
+            .map(|i| {
+                let x = i as f64 * 0.37;
+                format!("{x:.6} {:.4} -{i}.25 {} {}\n", i as f64, i % 8, 1000 - i)
+            })
+            .collect();
+        let want = collect(line_by_line, &text, 200);
+        assert_eq!(collect(dispatched, &text, 200), want);
+        let mut scalar = Vec::new();
+        decode_coordinate_rows_scalar(&text, 200, 10, |i, r| scalar.push((i, r))).1.unwrap();
+        assert_eq!(Ok(scalar), want.1);
+        // Stops at `rows` and reports where the next line starts.
+        let (used, _) = collect(dispatched, &text, 3);
+        assert_eq!(&text[..used], text.split_inclusive('\n').take(3).collect::<String>());
+    }
+}
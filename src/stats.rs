@@ -0,0 +1,392 @@
+//=============================================================================
+// Opt-in hot-path counters (`stats` feature)
+//=============================================================================
+
+//! Per-stage timing and volume counters for reads and writes.
+//!
+//! Built with `--features stats`, the reader and writer accumulate, process
+//! wide, the nanoseconds, calls and bytes of each [`Stage`], the frames read
+//! and written, frame buffer allocations and reuses, and the busy time of
+//! the parallel workers. [`snapshot`] copies the counters out and [`reset`]
+//! zeroes them, so a slow job can be classified as disk-, decompression- or
+//! parse-bound from the numbers alone:
+//!
+//! ```
+//! use readcon_core::stats::{self, Stage};
+//!
+//! stats::reset();
+//! let text = std::fs::read_to_string("resources/test/tiny_multi_cuh2.con").unwrap();
+//! let n = readcon_core::iterators::ConFrameIterator::new(&text).count();
+//! let s = stats::snapshot();
+//! if stats::ENABLED {
+//!     assert!(s.frames_read >= n as u64);
+//!     assert!(s.stage(Stage::Coordinates).calls >= n as u64);
+//! } else {
+//!     assert_eq!(s, stats::Stats::default());
+//! }
+//! ```
+//!
+//! Without the feature every recording hook is an empty inline function
+//! and [`snapshot`] returns zeros. With it, each hook is one `Instant::now`
+//! pair and a few relaxed atomic adds per stage and frame. The `tracing`
+//! feature (which implies `stats`) also opens a `TRACE` span named
+//! `readcon` with a `stage` field around every timed stage.
+//!
+//! Stages nest where the code does: [`Stage::Metadata`] runs inside
+//! [`Stage::Header`], and the parse stages run inside the parallel workers,
+//! so per-stage nanoseconds on a parallel read add up to CPU time, not wall
+//! time.
+
+use std::sync::atomic::{AtomicU64, Ordering};
+
+/// True when this build records statistics (`stats` feature).
+pub const ENABLED: bool = cfg!(feature = "stats");
+
+/// Number of [`Stage`] variants.
+pub const STAGE_COUNT: usize = 9;
+
+/// Timed region of the read or write path.
+#[derive(Debug, Clone, Copy, PartialEq, Eq, Hash)]
+#[repr(u32)]
+pub enum Stage {
+    /// Plain input into memory (`read_file_contents`: `read_to_string` or
+    /// mmap setup); bytes are the file size.
+    Read = 0,
+    /// gzip / zstd input inflated by `read_file_contents`, including the
+    /// file reads it drives; bytes are the decompressed size.
+    Decompress = 1,
+    /// Frame boundary scan ahead of the parallel workers; bytes scanned.
+    Scan = 2,
+    /// The nine header lines, including [`Stage::Metadata`].
+    Header = 3,
+    /// JSON metadata line decode and validation (header cache misses only).
+    Metadata = 4,
+    /// Coordinate blocks: line split and float decode, which the block
+    /// decoder fuses into one pass.
+    Coordinates = 5,
+    /// Optional per-atom sections (velocities, forces, energies, ...).
+    Sections = 6,
+    /// Frame assembly after decoding (SoA blocks, masses, ids).
+    Assemble = 7,
+    /// `ConFrameWriter` formatting and output; bytes are uncompressed.
+    Write = 8,
+}
+
+impl Stage {
+    /// Every stage, in discriminant order.
+    pub const ALL: [Stage; STAGE_COUNT] = [
+        Stage::Read,
+        Stage::Decompress,
+        Stage::Scan,
+        Stage::Header,
+        Stage::Metadata,
+        Stage::Coordinates,
+        Stage::Sections,
+        Stage::Assemble,
+        Stage::Write,
+    ];
+
+    /// Lower-case name, as used by the Python dict and tracing spans.
+    pub fn name(self) -> &'static str {
+        match self {
+            Stage::Read => "read",
+            Stage::Decompress => "decompress",
+            Stage::Scan => "scan",
+            Stage::Header => "header",
+            Stage::Metadata => "metadata",
+            Stage::Coordinates => "coordinates",
+            Stage::Sections => "sections",
+            Stage::Assemble => "assemble",
+            Stage::Write => "write",
+        }
+    }
+}
+
+/// Accumulated totals of one [`Stage`].
+#[derive(Debug, Clone, Copy, Default, PartialEq, Eq)]
+pub struct StageStats {
+    pub nanos: u64,
+    pub calls: u64,
+    pub bytes: u64,
+}
+
+/// Copy of the process-wide counters; see [`snapshot`].
+#[derive(Debug, Clone, Copy, Default, PartialEq, Eq)]
+pub struct Stats {
+    /// Indexed by `Stage as usize`; prefer [`Stats::stage`].
+    pub stages: [StageStats; STAGE_COUNT],
+    pub frames_read: u64,
+    pub frames_written: u64,
+    /// Frame-sized buffers the reader allocated: owned file text and fresh
+    /// position blocks. The global allocator is not hooked.
+    pub buffers_allocated: u64,
+    /// Frames refilled into existing buffers (`next_into`).
+    pub buffers_reused: u64,
+    /// Windows decoded by `ParallelFrameIterator`.
+    pub parallel_batches: u64,
+    /// Wall time of those windows.
+    pub parallel_wall_nanos: u64,
+    /// Time the workers spent parsing frames.
+    pub parallel_busy_nanos: u64,
+    /// Wall time times worker count: the busy time a fully loaded pool
+    /// would have reached.
+    pub parallel_capacity_nanos: u64,
+}
+
+impl Stats {
+    pub fn stage(&self, stage: Stage) -> StageStats {
+        self.stages[stage as usize]
+    }
+
+    /// Fraction of the parallel pool's capacity spent parsing, in `[0, 1]`
+    /// (0 before any parallel read).
+    pub fn worker_utilization(&self) -> f64 {
+        if self.parallel_capacity_nanos == 0 {
+            return 0.0;
+        }
+        (self.parallel_busy_nanos as f64 / self.parallel_capacity_nanos as f64).min(1.0)
+    }
+}
+
+/// Scalar counters bumped with [`count`].
+#[cfg_attr(not(feature = "stats"), allow(dead_code))]
+#[derive(Debug, Clone, Copy)]
+pub(crate) enum Counter {
+    FramesRead,
+    FramesWritten,
+    BuffersAllocated,
+    BuffersReused,
+}
+
+const SCALARS: usize = 4;
+
+struct Counters {
+    nanos: [AtomicU64; STAGE_COUNT],
+    calls: [AtomicU64; STAGE_COUNT],
+    bytes: [AtomicU64; STAGE_COUNT],
+    scalars: [AtomicU64; SCALARS],
+    parallel: [AtomicU64; 4],
+}
+
+const PAR_BATCHES: usize = 0;
+const PAR_WALL: usize = 1;
+const PAR_BUSY: usize = 2;
+const PAR_CAPACITY: usize = 3;
+
+static COUNTERS: Counters = Counters {
+    nanos: [const { AtomicU64::new(0) }; STAGE_COUNT],
+    calls: [const { AtomicU64::new(0) }; STAGE_COUNT],
+    bytes: [const { AtomicU64::new(0) }; STAGE_COUNT],
+    scalars: [const { AtomicU64::new(0) }; SCALARS],
+    parallel: [const { AtomicU64::new(0) }; 4],
+};
+
+/// Current counters (all zero when [`ENABLED`] is false). Counters are
+/// read one by one, so a snapshot taken during a read may be torn.
+pub fn snapshot() -> Stats {
+    let c = &COUNTERS;
+    let load = |a: &AtomicU64| a.load(Ordering::Relaxed);
+    let mut stats = Stats::default();
+    for (i, stage) in stats.stages.iter_mut().enumerate() {
+        *stage = StageStats {
+            nanos: load(&c.nanos[i]),
+            calls: load(&c.calls[i]),
+            bytes: load(&c.bytes[i]),
+        };
+    }
+    stats.frames_read = load(&c.scalars[Counter::FramesRead as usize]);
+    stats.frames_written = load(&c.scalars[Counter::FramesWritten as usize]);
+    stats.buffers_allocated = load(&c.scalars[Counter::BuffersAllocated as usize]);
+    stats.buffers_reused = load(&c.scalars[Counter::BuffersReused as usize]);
+    stats.parallel_batches = load(&c.parallel[PAR_BATCHES]);
+    stats.parallel_wall_nanos = load(&c.parallel[PAR_WALL]);
+    stats.parallel_busy_nanos = load(&c.parallel[PAR_BUSY]);
+    stats.parallel_capacity_nanos = load(&c.parallel[PAR_CAPACITY]);
+    stats
+}
+
+/// Zero every counter.
+pub fn reset() {
+    let c = &COUNTERS;
+    c.nanos
+        .iter()
+        .chain(&c.calls)
+        .chain(&c.bytes)
+        .chain(&c.scalars)
+        .chain(&c.parallel)
+        .for_each(|a| a.store(0, Ordering::Relaxed));
+}
+
+#[cfg(feature = "stats")]
+#[inline]
+fn add(a: &AtomicU64, n: u64) {
+    a.fetch_add(n, Ordering::Relaxed);
+}
+
+#[cfg(feature = "stats")]
+fn elapsed_nanos(start: std::time::Instant) -> u64 {
+    start.elapsed().as_nanos().min(u64::MAX as u128) as u64
+}
+
+/// Adds `n` to a scalar counter.
+#[inline(always)]
+pub(crate) fn count(counter: Counter, n: u64) {
+    #[cfg(feature = "stats")]
+    add(&COUNTERS.scalars[counter as usize], n);
+    #[cfg(not(feature = "stats"))]
+    let _ = (counter, n);
+}
+
+/// Guard timing one [`Stage`] call from [`timer`] to drop.
+#[must_use]
+pub(crate) struct Timer {
+    #[cfg(feature = "stats")]
+    stage: Stage,
+    #[cfg(feature = "stats")]
+    start: std::time::Instant,
+    #[cfg(feature = "stats")]
+    bytes: u64,
+    #[cfg(feature = "tracing")]
+    _span: tracing::span::EnteredSpan,
+}
+
+/// Starts timing `stage`; the call is recorded when the guard drops,
+/// including on early `?` returns.
+#[inline(always)]
+pub(crate) fn timer(stage: Stage) -> Timer {
+    #[cfg(not(feature = "stats"))]
+    let _ = stage;
+    Timer {
+        #[cfg(feature = "tracing")]
+        _span: tracing::trace_span!("readcon", stage = stage.name()).entered(),
+        #[cfg(feature = "stats")]
+        stage,
+        #[cfg(feature = "stats")]
+        start: std::time::Instant::now(),
+        #[cfg(feature = "stats")]
+        bytes: 0,
+    }
+}
+
+impl Timer {
+    /// Attributes `n` bytes to this call.
+    #[inline(always)]
+    pub(crate) fn add_bytes(&mut self, n: u64) {
+        #[cfg(feature = "stats")]
+        {
+            self.bytes += n;
+        }
+        #[cfg(not(feature = "stats"))]
+        let _ = n;
+    }
+}
+
+#[cfg(feature = "stats")]
+impl Drop for Timer {
+    fn drop(&mut self) {
+        let i = self.stage as usize;
+        add(&COUNTERS.nanos[i], elapsed_nanos(self.start));
+        add(&COUNTERS.calls[i], 1);
+        add(&COUNTERS.bytes[i], self.bytes);
+    }
+}
+
+/// Elapsed-time probe for the parallel accounting (reads 0 when disabled).
+#[cfg(feature = "parallel")]
+pub(crate) struct Stopwatch {
+    #[cfg(feature = "stats")]
+    start: std::time::Instant,
+}
+
+#[cfg(feature = "parallel")]
+#[inline(always)]
+pub(crate) fn stopwatch() -> Stopwatch {
+    Stopwatch {
+        #[cfg(feature = "stats")]
+        start: std::time::Instant::now(),
+    }
+}
+
+#[cfg(feature = "parallel")]
+impl Stopwatch {
+    #[inline(always)]
+    pub(crate) fn nanos(&self) -> u64 {
+        #[cfg(feature = "stats")]
+        return elapsed_nanos(self.start);
+        #[cfg(not(feature = "stats"))]
+        0
+    }
+}
+
+/// Adds one worker's time spent parsing a frame.
+#[cfg(feature = "parallel")]
+#[inline(always)]
+pub(crate) fn worker_busy(nanos: u64) {
+    #[cfg(feature = "stats")]
+    add(&COUNTERS.parallel[PAR_BUSY], nanos);
+    #[cfg(not(feature = "stats"))]
+    let _ = nanos;
+}
+
+/// Records one parallel window that took `wall_nanos` on `workers` threads.
+#[cfg(feature = "parallel")]
+#[inline(always)]
+pub(crate) fn parallel_batch(wall_nanos: u64, workers: usize) {
+    #[cfg(feature = "stats")]
+    {
+        add(&COUNTERS.parallel[PAR_BATCHES], 1);
+        add(&COUNTERS.parallel[PAR_WALL], wall_nanos);
+        add(&COUNTERS.parallel[PAR_CAPACITY], wall_nanos.saturating_mul(workers as u64));
+    }
+    #[cfg(not(feature = "stats"))]
+    let _ = (wall_nanos, workers);
+}
+
+#[cfg(all(test, feature = "stats"))]
+mod tests {
+    use super::*;
+
+    // Counters are process-wide and other tests parse concurrently, so
+    // these only assert lower bounds.
+    #[test]
+    fn stages_accumulate_for_reads_and_writes() {
+        let path = format!("{}/resources/test/tiny_multi_cuh2.con", env!("CARGO_MANIFEST_DIR"));
+        let before = snapshot();
+        let contents = crate::compression::read_file_contents(path.as_ref()).unwrap();
+        let frames: Vec<_> = crate::iterators::ConFrameIterator::new(contents.as_str().unwrap())
+            .collect::<Result<_, _>>()
+            .unwrap();
+        let mut out = Vec::new();
+        let mut writer = crate::writer::ConFrameWriter::new(&mut out);
+        writer.extend(frames.iter()).unwrap();
+        drop(writer);
+        let after = snapshot();
+
+        let n = frames.len() as u64;
+        let grew = |stage: Stage| after.stage(stage).calls - before.stage(stage).calls;
+        assert!(grew(Stage::Read) >= 1);
+        assert!(after.stage(Stage::Read).bytes - before.stage(Stage::Read).bytes > 0);
+        assert!(grew(Stage::Header) >= n);
+        assert!(grew(Stage::Coordinates) >= n);
+        assert!(grew(Stage::Assemble) >= n);
+        assert!(grew(Stage::Write) >= n);
+        assert!(after.frames_read - before.frames_read >= n);
+        assert!(after.frames_written - before.frames_written >= n);
+        assert!(after.stage(Stage::Write).bytes - before.stage(Stage::Write).bytes >= out.len() as u64);
+    }
+
+    #[cfg(feature = "parallel")]
+    #[test]
+    fn parallel_reads_record_worker_time() {
+        let path = format!("{}/resources/test/tiny_multi_cuh2.con", env!("CARGO_MANIFEST_DIR"));
+        let text = std::fs::read_to_string(path).unwrap();
+        let before = snapshot();
+        let frames = crate::iterators::parse_frames_parallel_with_threads(&text, Some(2));
+        assert!(frames.iter().all(Result::is_ok));
+        let after = snapshot();
+        assert!(after.parallel_batches > before.parallel_batches);
+        assert!(after.parallel_busy_nanos > before.parallel_busy_nanos);
+        assert!(after.stage(Stage::Scan).bytes > before.stage(Stage::Scan).bytes);
+        assert!((0.0..=1.0).contains(&after.worker_utilization()));
+    }
+}
@@ -107,6 +107,15 @@ impl ElementKind {
         }
     }
 
+    /// Kind a CUDA export uploads this storage as: float kinds keep their
+    /// width, everything else travels as float64 (the device path hosts floats).
+    pub fn cuda_float_kind(self) -> Self {
+        match self {
+            Self::Float32 | Self::Float16 => self,
+            _ => Self::Float64,
+        }
+    }
+
     /// All kinds we can allocate and `as_dlpack` on CPU today (dlpk-hosted).
     pub fn all_hosted() -> &'static [Self] {
         &[
@@ -205,6 +214,77 @@ impl StorageDtypes {
     }
 }
 
+/// Owner of a float16 block behind a DLPack tensor: the array plus the
+/// `i64` shape the tensor points into.
+struct F16DlpackManager<D: ndarray::Dimension> {
+    _data: ndarray::ArcArray<half::f16, D>,
+    shape: Vec<i64>,
+}
+
+unsafe extern "C" fn f16_dlpack_deleter<D: ndarray::Dimension>(
+    managed: *mut dlpk::sys::DLManagedTensorVersioned,
+) {
+    if managed.is_null() {
+        return;
+    }
+    // Only free our manager_ctx; the outer dlpk deleter (from_raw) frees
+    // the managed allocation itself.
+    unsafe {
+        let ctx = (*managed).manager_ctx;
+        if !ctx.is_null() {
+            let _ = Box::from_raw(ctx as *mut F16DlpackManager<D>);
+            (*managed).manager_ctx = std::ptr::null_mut();
+        }
+    }
+}
+
+/// CPU `kDLFloat`/16 export of a float16 block. dlpk's `TryFrom<ArcArray>`
+/// only accepts its own `half` build, so the managed tensor is assembled by
+/// hand (as [`crate::array::DeviceTaggedF64Array`] does) around a shared
+/// clone of the array: no element copy for standard-layout blocks.
+fn f16_as_dlpack<D: ndarray::Dimension + 'static>(
+    a: &ndarray::ArcArray<half::f16, D>,
+) -> Result<dlpk::DLPackTensor, ParseError> {
+    let data = if a.is_standard_layout() {
+        a.clone()
+    } else {
+        ndarray::ArcArray::from_shape_vec(a.raw_dim(), a.iter().copied().collect())
+            .map_err(|e| ParseError::ValidationError(format!("as_dlpack float16: {e}")))?
+    };
+    let mut manager = Box::new(F16DlpackManager {
+        shape: data.shape().iter().map(|&d| d as i64).collect(),
+        _data: data,
+    });
+    let data_ptr = manager._data.as_ptr() as *mut std::ffi::c_void;
+    let shape_ptr = manager.shape.as_mut_ptr();
+    let ndim = manager.shape.len() as i32;
+    let managed = dlpk::sys::DLManagedTensorVersioned {
+        version: dlpk::sys::DLPackVersion {
+            major: dlpk::sys::DLPACK_MAJOR_VERSION,
+            minor: dlpk::sys::DLPACK_MINOR_VERSION,
+        },
+        manager_ctx: Box::into_raw(manager) as *mut std::ffi::c_void,
+        deleter: Some(f16_dlpack_deleter::<D>),
+        flags: 0,
+        dl_tensor: dlpk::sys::DLTensor {
+            data: data_ptr,
+            device: dlpk::sys::DLDevice::cpu(),
+            ndim,
+            dtype: dlpk::sys::DLDataType {
+                code: dlpk::sys::DLDataTypeCode::kDLFloat,
+                bits: 16,
+                lanes: 1,
+            },
+            shape: shape_ptr,
+            strides: std::ptr::null_mut(),
+            byte_offset: 0,
+        },
+    };
+    // Safety: valid DLManagedTensorVersioned; the deleter drops the manager
+    // (array + shape) exactly once.
+    Ok(unsafe { dlpk::DLPackTensor::from_raw(managed) })
+}
+
 /// 2-D SoA block (positions / velocities / forces).
 #[derive(Clone, Debug)]
 pub enum Array2Storage {
@@ -345,6 +425,43 @@ impl Array2Storage {
         *self = next;
     }
 
+    /// Borrow the block as a row-major `f64` slice; `None` for any other
+    /// storage dtype (or a non-standard layout).
+    pub fn as_f64_slice(&self) -> Option<&[f64]> {
+        match self {
+            Self::F64(a) => a.as_slice(),
+            _ => None,
+        }
+    }
+
+    /// Mutable row-major `f64` slice, copying first if the buffer is shared
+    /// (`ArcArray` copy-on-write); `None` for any other storage dtype.
+    pub fn as_f64_slice_mut(&mut self) -> Option<&mut [f64]> {
+        match self {
+            Self::F64(a) => a.as_slice_mut(),
+            _ => None,
+        }
+    }
+
+    /// [`Self::as_f64_slice_mut`] without the copy-on-write: `None` when the
+    /// buffer is shared, so refill paths allocate a fresh block instead of
+    /// copying data they are about to overwrite.
+    pub fn unique_f64_slice_mut(&mut self) -> Option<&mut [f64]> {
+        match self {
+            Self::F64(a) if a.is_unique() => a.as_slice_mut(),
+            _ => None,
+        }
+    }
+
+    /// Borrow the block as a row-major `f32` slice; `None` for any other
+    /// storage dtype (or a non-standard layout).
+    pub fn as_f32_slice(&self) -> Option<&[f32]> {
+        match self {
+            Self::F32(a) => a.as_slice(),
+            _ => None,
+        }
+    }
+
     /// Real part of each column (imag discarded / zero for complex hosts).
     pub fn as_f64_row(&self, i: usize) -> [f64; 3] {
         let g = |a: f64, b: f64, c: f64| [a, b, c];
@@ -519,9 +636,10 @@ impl Array2Storage {
                     for i in 0..nrows {
                         host.extend_from_slice(&self.as_f64_row(i));
                     }
-                    return crate::cuda_array::export_host_f64_as_cuda_dlpack(
+                    return crate::cuda_array::export_host_as_cuda_dlpack(
                         &[nrows, ncols],
                         &host,
+                        self.kind().cuda_float_kind(),
                         device.device_id,
                     );
                 }
@@ -535,9 +653,7 @@ impl Array2Storage {
                 .map_err(|e| ParseError::ValidationError(format!("as_dlpack: {e}"))),
             Self::F32(a) => dlpk::DLPackTensor::try_from(a.clone())
                 .map_err(|e| ParseError::ValidationError(format!("as_dlpack: {e}"))),
-            Self::F16(_) => Err(ParseError::ValidationError(
-                "float16 as_dlpack blocked on half/dlpk version skew; storage still allocates".into(),
-            )),
+            Self::F16(a) => f16_as_dlpack(a),
             Self::I8(a) => dlpk::DLPackTensor::try_from(a.clone())
                 .map_err(|e| ParseError::ValidationError(format!("as_dlpack: {e}"))),
             Self::I16(a) => dlpk::DLPackTensor::try_from(a.clone())
@@ -675,6 +791,32 @@ impl Array1Storage {
         *self = next;
     }
 
+    /// Borrow the block as an `f64` slice; `None` for any other storage dtype.
+    pub fn as_f64_slice(&self) -> Option<&[f64]> {
+        match self {
+            Self::F64(a) => a.as_slice(),
+            _ => None,
+        }
+    }
+
+    /// Mutable `f64` slice, copying first if the buffer is shared; `None`
+    /// for any other storage dtype.
+    pub fn as_f64_slice_mut(&mut self) -> Option<&mut [f64]> {
+        match self {
+            Self::F64(a) => a.as_slice_mut(),
+            _ => None,
+        }
+    }
+
+    /// [`Self::as_f64_slice_mut`] without the copy-on-write; `None` when the
+    /// buffer is shared.
+    pub fn unique_f64_slice_mut(&mut self) -> Option<&mut [f64]> {
+        match self {
+            Self::F64(a) if a.is_unique() => a.as_slice_mut(),
+            _ => None,
+        }
+    }
+
     pub fn get_f64(&self, i: usize) -> f64 {
         match self {
             Self::F64(a) => a[i],
@@ -726,9 +868,10 @@ impl Array1Storage {
                     for i in 0..n {
                         host.push(self.get_f64(i));
                     }
-                    return crate::cuda_array::export_host_f64_as_cuda_dlpack(
+                    return crate::cuda_array::export_host_as_cuda_dlpack(
                         &[n],
                         &host,
+                        self.kind().cuda_float_kind(),
                         device.device_id,
                     );
                 }
@@ -742,9 +885,7 @@ impl Array1Storage {
                 .map_err(|e| ParseError::ValidationError(format!("as_dlpack: {e}"))),
             Self::F32(a) => dlpk::DLPackTensor::try_from(a.clone())
                 .map_err(|e| ParseError::ValidationError(format!("as_dlpack: {e}"))),
-            Self::F16(_) => Err(ParseError::ValidationError(
-                "float16 as_dlpack blocked on half/dlpk version skew; storage still allocates".into(),
-            )),
+            Self::F16(a) => f16_as_dlpack(a),
             Self::I8(a) => dlpk::DLPackTensor::try_from(a.clone())
                 .map_err(|e| ParseError::ValidationError(format!("as_dlpack: {e}"))),
             Self::I16(a) => dlpk::DLPackTensor::try_from(a.clone())
@@ -774,6 +915,94 @@ impl Array1Storage {
     }
 }
 
+/// 3-D float block `(frames, atoms, 3)`: a batch of frames in one
+/// contiguous row-major buffer (see [`crate::trajectory_tensor`]). Only the
+/// float kinds are hosted; batched coordinates have no integer consumer.
+#[derive(Clone, Debug)]
+pub enum Array3Storage {
+    F64(ndarray::ArcArray<f64, ndarray::Ix3>),
+    F32(ndarray::ArcArray<f32, ndarray::Ix3>),
+    F16(ndarray::ArcArray<half::f16, ndarray::Ix3>),
+}
+
+impl Array3Storage {
+    pub fn kind(&self) -> ElementKind {
+        match self {
+            Self::F64(_) => ElementKind::Float64,
+            Self::F32(_) => ElementKind::Float32,
+            Self::F16(_) => ElementKind::Float16,
+        }
+    }
+
+    /// `(frames, atoms, columns)`.
+    pub fn dim(&self) -> (usize, usize, usize) {
+        match self {
+            Self::F64(a) => a.dim(),
+            Self::F32(a) => a.dim(),
+            Self::F16(a) => a.dim(),
+        }
+    }
+
+    /// Borrow the block as a row-major `f64` slice; `None` for f32 / f16.
+    pub fn as_f64_slice(&self) -> Option<&[f64]> {
+        match self {
+            Self::F64(a) => a.as_slice(),
+            _ => None,
+        }
+    }
+
+    pub fn get_f64(&self, frame: usize, atom: usize, col: usize) -> f64 {
+        match self {
+            Self::F64(a) => a[[frame, atom, col]],
+            Self::F32(a) => a[[frame, atom, col]] as f64,
+            Self::F16(a) => a[[frame, atom, col]].to_f64(),
+        }
+    }
+
+    /// Row-major values widened to `f64` (a copy for every kind).
+    pub fn to_f64_vec(&self) -> Vec<f64> {
+        match self {
+            Self::F64(a) => a.iter().copied().collect(),
+            Self::F32(a) => a.iter().map(|&x| x as f64).collect(),
+            Self::F16(a) => a.iter().map(|x| x.to_f64()).collect(),
+        }
+    }
+
+    /// Export the whole batch as one DLPack tensor of shape
+    /// `(frames, atoms, 3)` in the storage dtype. CPU export shares the
+    /// buffer; CUDA (with `--features cuda`) copies it to the device.
+    pub fn as_dlpack(
+        &self,
+        device: dlpk::sys::DLDevice,
+    ) -> Result<dlpk::DLPackTensor, ParseError> {
+        if device != dlpk::sys::DLDevice::cpu() {
+            #[cfg(feature = "cuda")]
+            {
+                use dlpk::sys::DLDeviceType;
+                if device.device_type == DLDeviceType::kDLCUDA {
+                    let (f, n, c) = self.dim();
+                    return crate::cuda_array::export_host_as_cuda_dlpack(
+                        &[f, n, c],
+                        &self.to_f64_vec(),
+                        self.kind(),
+                        device.device_id,
+                    );
+                }
+            }
+            return Err(ParseError::ValidationError(
+                "Array3Storage is CPU-resident; non-CPU as_dlpack unsupported (build with --features cuda for CUDA H2D export)".into(),
+            ));
+        }
+        match self {
+            Self::F64(a) => dlpk::DLPackTensor::try_from(a.clone())
+                .map_err(|e| ParseError::ValidationError(format!("as_dlpack: {e}"))),
+            Self::F32(a) => dlpk::DLPackTensor::try_from(a.clone())
+                .map_err(|e| ParseError::ValidationError(format!("as_dlpack: {e}"))),
+            Self::F16(a) => f16_as_dlpack(a),
+        }
+    }
+}
+
 /// Atom-id column: integer family only; default uint64.
 #[derive(Clone, Debug)]
 pub enum IdArray1 {
@@ -886,10 +1115,6 @@ mod tests {
             let mut a = Array2Storage::zeros(k, 2, 3);
             a.set_f64_row(0, [1.0, 2.0, 3.0]);
             let t = a.as_dlpack(dlpk::sys::DLDevice::cpu());
-            if k == ElementKind::Float16 {
-                assert!(t.is_err());
-                continue;
-            }
             let t = t.unwrap();
             // bool exports as 1-D length 6 (Vec<bool> path)
             if k == ElementKind::Bool {
@@ -908,16 +1133,23 @@ mod tests {
             let mut a = Array1Storage::zeros(k, 4);
             a.set_f64(0, 1.0);
             let t = a.as_dlpack(dlpk::sys::DLDevice::cpu());
-            if k == ElementKind::Float16 {
-                assert!(t.is_err());
-                continue;
-            }
             let t = t.unwrap();
             assert_eq!(t.shape(), &[4]);
             assert_eq!(t.dtype().bits, k.dlpack_bits());
         }
     }
 
+    #[test]
+    fn unique_slice_skips_shared_buffers() {
+        let mut a = Array2Storage::zeros(ElementKind::Float64, 2, 3);
+        assert_eq!(a.unique_f64_slice_mut().map(|s| s.len()), Some(6));
+        let shared = a.clone();
+        assert!(a.unique_f64_slice_mut().is_none());
+        drop(shared);
+        assert!(a.unique_f64_slice_mut().is_some());
+        assert!(Array2Storage::zeros(ElementKind::Float32, 2, 3).unique_f64_slice_mut().is_none());
+    }
+
     #[test]
     fn reject_bfloat_and_float8() {
         assert!(ElementKind::parse("bfloat16").is_err());
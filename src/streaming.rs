@@ -0,0 +1,386 @@
+//=============================================================================
+// Streaming frame iterator over a `BufRead` (compressed / unbounded inputs)
+//=============================================================================
+
+use crate::error::ParseError;
+use crate::iterators::ConFrameIterator;
+use crate::types::ConFrame;
+use std::io::{self, BufRead};
+use std::path::Path;
+
+/// Minimum number of bytes pulled from the reader per refill. Refills grow
+/// geometrically with the pending tail, so a frame larger than the chunk is
+/// rescanned O(log size) times rather than once per chunk.
+pub const STREAM_CHUNK: usize = 1 << 20;
+
+/// Frame iterator over any [`BufRead`], holding at most one frame plus one
+/// refill chunk in memory.
+///
+/// [`ConFrameIterator`] needs the whole trajectory as one `&str`; this type
+/// keeps a chunked byte buffer instead and only exposes complete lines to the
+/// memchr cursor. A frame is yielded once [`ConFrameIterator::forward_fast`]
+/// finds its end strictly inside the buffer (or at end of stream), so
+/// trailing optional sections split across a refill are never cut short.
+///
+/// Used for `.con.gz` / `.con.zst` paths by [`crate::iterators::read_first_frame`],
+/// [`crate::iterators::count_frames`] and the C `read_con_file_iterator`.
+/// UTF-8 is validated incrementally, once per refill.
+pub struct StreamingConFrameIterator<R: BufRead> {
+    reader: R,
+    buf: Vec<u8>,
+    /// Start of the unconsumed region of `buf`.
+    start: usize,
+    /// End of the validated, newline-terminated region of `buf`.
+    visible: usize,
+    eof: bool,
+    /// Index of the next frame to be yielded or skipped.
+    position: usize,
+    /// Set after an I/O error or an unterminated frame; yields `None` after.
+    done: bool,
+    columns: crate::types::ColumnMask,
+    /// Header pieces and symbols carried between the per-frame cursors.
+    header_cache: crate::parser::HeaderCache,
+}
+
+impl<R: BufRead> StreamingConFrameIterator<R> {
+    /// Wraps `reader`. No bytes are read until the first call to `next`.
+    pub fn new(reader: R) -> Self {
+        StreamingConFrameIterator {
+            reader,
+            buf: Vec::new(),
+            start: 0,
+            visible: 0,
+            eof: false,
+            position: 0,
+            done: false,
+            columns: crate::types::ColumnMask::ALL,
+            header_cache: crate::parser::HeaderCache::new(),
+        }
+    }
+
+    /// Decode only `columns`, as [`ConFrameIterator::with_projection`].
+    pub fn with_projection(mut self, columns: crate::types::ColumnMask) -> Self {
+        self.set_projection(columns);
+        self
+    }
+
+    /// Set the projection on an existing iterator (C ABI / FFI).
+    pub fn set_projection(&mut self, columns: crate::types::ColumnMask) {
+        self.columns = columns;
+    }
+
+    /// Index of the frame the next call to `next` / `forward` consumes.
+    pub fn next_frame_index(&self) -> usize {
+        self.position
+    }
+
+    /// Consumes the iterator, returning the wrapped reader.
+    pub fn into_inner(self) -> R {
+        self.reader
+    }
+
+    /// Unconsumed complete lines currently buffered.
+    fn text(&self) -> &str {
+        // SAFETY: `start..visible` was validated in `refill`, and `start` only
+        // advances by frame spans, which end on a line boundary.
+        unsafe { std::str::from_utf8_unchecked(&self.buf[self.start..self.visible]) }
+    }
+
+    /// Drop the consumed prefix, pull at least `want` bytes (or up to EOF),
+    /// and extend the visible region to the last complete line.
+    fn refill(&mut self, want: usize) -> Result<(), ParseError> {
+        if self.start > 0 {
+            self.buf.drain(..self.start);
+            self.visible -= self.start;
+            self.start = 0;
+        }
+        let target = self.buf.len() + want;
+        while self.buf.len() < target {
+            let chunk = match self.reader.fill_buf() {
+                Ok(c) => c,
+                Err(e) if e.kind() == io::ErrorKind::Interrupted => continue,
+                Err(e) => return Err(e.into()),
+            };
+            if chunk.is_empty() {
+                self.eof = true;
+                // `forward_fast` counts newline-terminated lines; terminate
+                // a final unterminated line so it still closes its frame.
+                if self.buf.last().is_some_and(|&b| b != b'\n') {
+                    self.buf.push(b'\n');
+                }
+                break;
+            }
+            let n = chunk.len();
+            self.buf.extend_from_slice(chunk);
+            self.reader.consume(n);
+        }
+        let new_visible = if self.eof {
+            self.buf.len()
+        } else {
+            match memchr::memrchr(b'\n', &self.buf[self.visible..]) {
+                Some(i) => self.visible + i + 1,
+                None => self.visible,
+            }
+        };
+        // A cut after '\n' is always a char boundary, so validating each
+        // newly visible slice on its own is equivalent to validating the whole.
+        if let Err(e) = std::str::from_utf8(&self.buf[self.visible..new_visible]) {
+            return Err(ParseError::Io(format!("input is not valid UTF-8: {e}")));
+        }
+        self.visible = new_visible;
+        Ok(())
+    }
+
+    /// Byte length of the next complete frame at `start`, refilling as
+    /// needed. `Ok(None)` at a clean end of stream.
+    fn next_span(&mut self) -> Result<Option<usize>, ParseError> {
+        let mut want = STREAM_CHUNK;
+        loop {
+            let text = self.text();
+            if !text.is_empty() {
+                let mut it = ConFrameIterator::new(text);
+                match it.forward_fast() {
+                    Some(Ok(())) => {
+                        let end = it.byte_offset();
+                        // A frame ending exactly at the buffer edge may still
+                        // have another blank-separated section after a refill.
+                        if end < text.len() || self.eof {
+                            return Ok(Some(end));
+                        }
+                    }
+                    Some(Err(ParseError::IncompleteHeader | ParseError::IncompleteFrame))
+                        if !self.eof => {}
+                    // Only complete lines are visible, so any other error is
+                    // real and not an artifact of the chunk boundary.
+                    Some(Err(e)) => return Err(e),
+                    None => {}
+                }
+            } else if self.eof {
+                return Ok(None);
+            }
+            let pending = self.visible - self.start;
+            self.refill(want.max(pending))?;
+            want = want.max(pending);
+        }
+    }
+
+    /// [`Self::next_span`] with the end-of-iteration bookkeeping of `next`.
+    fn next_frame_end(&mut self) -> Option<Result<usize, ParseError>> {
+        if self.done {
+            return None;
+        }
+        match self.next_span() {
+            Ok(Some(end)) => Some(Ok(end)),
+            Ok(None) => {
+                self.done = true;
+                None
+            }
+            Err(e) => {
+                self.done = true;
+                Some(Err(e))
+            }
+        }
+    }
+
+    /// Parses the next frame into `frame`, reusing its allocations, as
+    /// [`ConFrameIterator::next_into`].
+    pub fn next_into(&mut self, frame: &mut ConFrame) -> Option<Result<(), ParseError>> {
+        let end = match self.next_frame_end()? {
+            Ok(end) => end,
+            Err(e) => return Some(Err(e)),
+        };
+        let parsed = self.parse_span(end, |it| it.next_into(frame));
+        self.start += end;
+        self.position += 1;
+        parsed
+    }
+
+    /// Runs `parse` on a cursor over the next `end` bytes, lending it the
+    /// header cache so repeated headers are decoded once per stream.
+    fn parse_span<T>(&mut self, end: usize, parse: impl FnOnce(&mut ConFrameIterator) -> T) -> T {
+        let cache = std::mem::take(&mut self.header_cache);
+        let mut it = ConFrameIterator::new(&self.text()[..end]).with_projection(self.columns);
+        it.header_cache = cache;
+        let parsed = parse(&mut it);
+        let cache = std::mem::take(&mut it.header_cache);
+        self.header_cache = cache;
+        parsed
+    }
+
+    /// Skips the next frame without parsing its atom data.
+    ///
+    /// Same contract as [`ConFrameIterator::forward`]: `Some(Ok(()))` on a
+    /// skip, `Some(Err(_))` on a malformed or truncated frame, `None` at end.
+    pub fn forward(&mut self) -> Option<Result<(), ParseError>> {
+        if self.done {
+            return None;
+        }
+        match self.next_span() {
+            Ok(Some(end)) => {
+                self.start += end;
+                self.position += 1;
+                Some(Ok(()))
+            }
+            Ok(None) => {
+                self.done = true;
+                None
+            }
+            Err(e) => {
+                self.done = true;
+                Some(Err(e))
+            }
+        }
+    }
+
+    /// Whether another complete frame follows, buffering it if needed.
+    /// Nothing is consumed.
+    pub fn has_next(&mut self) -> Result<bool, ParseError> {
+        if self.done {
+            return Ok(false);
+        }
+        Ok(self.next_span()?.is_some())
+    }
+
+    /// Skips up to `n` frames and returns how many were skipped (fewer than
+    /// `n` only at end of stream). Same contract as
+    /// [`ConFrameIterator::skip_frames`].
+    pub fn skip_frames(&mut self, n: usize) -> Result<usize, ParseError> {
+        for skipped in 0..n {
+            match self.forward() {
+                Some(Ok(())) => {}
+                Some(Err(e)) => return Err(e),
+                None => return Ok(skipped),
+            }
+        }
+        Ok(n)
+    }
+}
+
+impl StreamingConFrameIterator<Box<dyn BufRead + Send>> {
+    /// Opens `path` through [`crate::compression::open_reader`], so gzip and
+    /// zstd inputs are inflated incrementally rather than up front.
+    pub fn from_path(path: &Path) -> Result<Self, Box<dyn std::error::Error>> {
+        Ok(Self::new(crate::compression::open_reader(path)?))
+    }
+}
+
+impl<R: BufRead> Iterator for StreamingConFrameIterator<R> {
+    type Item = Result<ConFrame, ParseError>;
+
+    /// Parses the next frame. A malformed frame whose extent is known yields
+    /// `Some(Err(_))` and iteration resumes at the following frame; I/O
+    /// errors and truncated trailing frames end the iteration.
+    fn next(&mut self) -> Option<Self::Item> {
+        let end = match self.next_frame_end()? {
+            Ok(end) => end,
+            Err(e) => return Some(Err(e)),
+        };
+        let parsed = self.parse_span(end, |it| it.next());
+        self.start += end;
+        self.position += 1;
+        parsed
+    }
+}
+
+#[cfg(test)]
+mod streaming_tests {
+    use super::*;
+    use std::io::{BufReader, Read};
+    use std::path::PathBuf;
+
+    /// Reader that hands out at most `step` bytes per `read`, forcing
+    /// refills inside headers, atom blocks and section separators.
+    struct Trickle<'a> {
+        data: &'a [u8],
+        step: usize,
+    }
+
+    impl Read for Trickle<'_> {
+        fn read(&mut self, out: &mut [u8]) -> io::Result<usize> {
+            let n = self.step.min(out.len()).min(self.data.len());
+            out[..n].copy_from_slice(&self.data[..n]);
+            self.data = &self.data[n..];
+            Ok(n)
+        }
+    }
+
+    fn fixture(name: &str) -> String {
+        let p = PathBuf::from(env!("CARGO_MANIFEST_DIR")).join("resources/test").join(name);
+        std::fs::read_to_string(p).expect("fixture")
+    }
+
+    #[test]
+    fn streaming_matches_in_memory_across_tiny_refills() {
+        for name in ["tiny_multi_cuh2.con", "tiny_cuh2_vel_forces.con"] {
+            let text = fixture(name);
+            let expected: Vec<ConFrame> = ConFrameIterator::new(&text)
+                .collect::<Result<_, _>>()
+                .expect("in-memory parse");
+            for step in [1usize, 7, 64, 4096] {
+                let reader = BufReader::with_capacity(
+                    step,
+                    Trickle {
+                        data: text.as_bytes(),
+                        step,
+                    },
+                );
+                let got: Vec<ConFrame> = StreamingConFrameIterator::new(reader)
+                    .collect::<Result<_, _>>()
+                    .expect("streaming parse");
+                assert_eq!(got.len(), expected.len(), "{name} step={step}");
+                for (a, b) in got.iter().zip(&expected) {
+                    assert_eq!(a.atom_data, b.atom_data, "{name} step={step}");
+                }
+            }
+        }
+    }
+
+    #[test]
+    fn streaming_next_into_matches_next() {
+        let text = fixture("tiny_multi_cuh2.convel");
+        let expected: Vec<ConFrame> = ConFrameIterator::new(&text)
+            .collect::<Result<_, _>>()
+            .expect("in-memory parse");
+        let reader = BufReader::with_capacity(
+            7,
+            Trickle {
+                data: text.as_bytes(),
+                step: 7,
+            },
+        );
+        let mut it = StreamingConFrameIterator::new(reader);
+        let mut frame = ConFrame::default();
+        for want in &expected {
+            it.next_into(&mut frame).expect("frame").expect("parse");
+            assert_eq!(&frame, want);
+        }
+        assert!(it.next_into(&mut frame).is_none());
+    }
+
+    #[test]
+    fn streaming_forward_counts_frames() {
+        let text = fixture("tiny_multi_cuh2.con");
+        let n = ConFrameIterator::new(&text).count();
+        let mut it = StreamingConFrameIterator::new(text.as_bytes());
+        let mut skipped = 0usize;
+        while let Some(r) = it.forward() {
+            r.expect("skip");
+            skipped += 1;
+        }
+        assert_eq!(skipped, n);
+    }
+
+    #[test]
+    fn streaming_reports_truncated_tail() {
+        let text = fixture("tiny_cuh2.con");
+        let n_lines = text.lines().count();
+        let cut: String = text
+            .lines()
+            .take(n_lines - 2)
+            .map(|l| format!("{l}\n"))
+            .collect();
+        let mut it = StreamingConFrameIterator::new(cut.as_bytes());
+        assert!(matches!(it.next(), Some(Err(_))));
+        assert!(it.next().is_none());
+    }
+}
@@ -0,0 +1,734 @@
+//! Batched trajectory tensors: a frame range parsed straight into one
+//! `(n_frames, n_atoms, 3)` buffer per field.
+//!
+//! The per-frame DLPack exports ([`crate::storage_dtype::Array2Storage::as_dlpack`],
+//! `rkr_frame_positions_dlpack_ex`, …) cost one call, one allocation and a
+//! consumer-side stack per frame. [`read_trajectory_tensors`] instead finds
+//! the selected frames' byte spans with [`ConFrameIterator::forward_fast`]
+//! (O(1) per frame with a fresh `.con.idx` sidecar), allocates the
+//! positions / forces blocks and the `(n_frames,)` energies once, and
+//! decodes every later frame's coordinate and force rows straight into its
+//! slab of the batch (on the Rayon pool with the `parallel` feature); only
+//! the first frame, parsed once for the layout, is copied in. Each block is
+//! then exported as a single tensor via [`Array3Storage::as_dlpack`].
+//!
+//! Batches need a fixed atom count: a frame whose atom count differs from
+//! the first selected frame is a [`ParseError::ValidationError`], as is one
+//! whose component layout (symbols and per-type counts) differs, so
+//! [`TrajectoryTensors::atomic_numbers`] describes every frame. Forces are
+//! batched when the first selected frame has a force section, and then every
+//! frame must have one. Frames without a total energy get NaN.
+//!
+//! [`TrajectoryTensors::into_keyed_blocks`] regroups a batch into
+//! `(system, atom)`-sampled float64 blocks keyed by quantity or species, the
+//! layout behind the metatensor `TensorMap` export.
+
+use crate::compression::Compression;
+use crate::error::ParseError;
+use crate::iterators::ConFrameIterator;
+use crate::offset_index::FrameOffsetIndex;
+use crate::parser::{ScalarSection, SectionTarget, VectorSection};
+use crate::storage_dtype::{Array1Storage, Array2Storage, Array3Storage, ElementKind, StorageDtypes};
+#[cfg(feature = "parallel")]
+use rayon::prelude::*;
+use std::path::Path;
+use std::sync::Arc;
+
+/// One frame range as contiguous blocks; see the [module docs](self).
+#[derive(Clone, Debug)]
+pub struct TrajectoryTensors {
+    /// Positions `(n_frames, n_atoms, 3)` in `StorageDtypes::positions`.
+    pub positions: Array3Storage,
+    /// Forces `(n_frames, n_atoms, 3)` in `StorageDtypes::forces`, when the
+    /// frames carry a force section.
+    pub forces: Option<Array3Storage>,
+    /// Per-frame total energies `(n_frames,)` in `StorageDtypes::energies`;
+    /// NaN where a frame has none.
+    pub energies: Array1Storage,
+    /// Index in the file of each batched frame.
+    pub frames: Vec<usize>,
+    /// Atomic number of each atom `(n_atoms,)` (0 for unknown symbols),
+    /// shared by every batched frame.
+    pub atomic_numbers: Vec<u64>,
+}
+
+impl TrajectoryTensors {
+    pub fn n_frames(&self) -> usize {
+        self.positions.dim().0
+    }
+
+    pub fn n_atoms(&self) -> usize {
+        self.positions.dim().1
+    }
+
+    pub fn has_forces(&self) -> bool {
+        self.forces.is_some()
+    }
+
+    /// Splits the batch into float64 blocks of `(system, atom)` samples; see
+    /// [`BatchKeys`]. Float64 batches hand their buffers over without a copy
+    /// under [`BatchKeys::Quantity`]. Asking for forces the batch does not
+    /// carry is a [`ParseError::ValidationError`].
+    pub fn into_keyed_blocks(self, keys: BatchKeys) -> Result<Vec<KeyedBlock>, ParseError> {
+        let n_atoms = self.n_atoms();
+        let all_samples = || -> Vec<[i32; 2]> {
+            self.frames
+                .iter()
+                .flat_map(|&f| (0..n_atoms).map(move |a| [f as i32, a as i32]))
+                .collect()
+        };
+        let quantity = match keys {
+            BatchKeys::Quantity => {
+                let mut blocks = vec![KeyedBlock {
+                    key: BatchQuantity::Positions as i32,
+                    samples: all_samples(),
+                    values: into_f64_vec(self.positions),
+                }];
+                if let Some(forces) = self.forces {
+                    blocks.push(KeyedBlock {
+                        key: BatchQuantity::Forces as i32,
+                        samples: blocks[0].samples.clone(),
+                        values: into_f64_vec(forces),
+                    });
+                }
+                return Ok(blocks);
+            }
+            BatchKeys::Species(quantity) => quantity,
+        };
+        let values = match quantity {
+            BatchQuantity::Positions => into_f64_vec(self.positions),
+            BatchQuantity::Forces => match self.forces {
+                Some(forces) => into_f64_vec(forces),
+                None => {
+                    return Err(ParseError::ValidationError(
+                        "batch has no force section to key by species".into(),
+                    ));
+                }
+            },
+        };
+        let mut species = self.atomic_numbers.clone();
+        species.sort_unstable();
+        species.dedup();
+        Ok(species
+            .into_iter()
+            .map(|z| {
+                let atoms: Vec<usize> = (0..n_atoms)
+                    .filter(|&a| self.atomic_numbers[a] == z)
+                    .collect();
+                let rows = self.frames.len() * atoms.len();
+                let mut block = KeyedBlock {
+                    key: z as i32,
+                    samples: Vec::with_capacity(rows),
+                    values: Vec::with_capacity(rows * 3),
+                };
+                for (f, &frame) in self.frames.iter().enumerate() {
+                    for &a in &atoms {
+                        let row = (f * n_atoms + a) * 3;
+                        block.samples.push([frame as i32, a as i32]);
+                        block.values.extend_from_slice(&values[row..row + 3]);
+                    }
+                }
+                block
+            })
+            .collect())
+    }
+}
+
+/// A per-atom `(n_atoms, 3)` field of a batch.
+#[derive(Clone, Copy, Debug, PartialEq, Eq)]
+pub enum BatchQuantity {
+    Positions = 0,
+    Forces = 1,
+}
+
+/// How [`TrajectoryTensors::into_keyed_blocks`] groups a batch.
+#[derive(Clone, Copy, Debug, PartialEq, Eq)]
+pub enum BatchKeys {
+    /// One block per batched quantity, keyed by [`BatchQuantity`] as an
+    /// integer (positions, then forces when present), over every atom.
+    Quantity,
+    /// One block of the given quantity per atomic number, ascending.
+    Species(BatchQuantity),
+}
+
+/// One keyed block: row `r` of the row-major `(samples.len(), 3)` `values`
+/// belongs to atom `samples[r][1]` of file frame `samples[r][0]`.
+#[derive(Clone, Debug, PartialEq)]
+pub struct KeyedBlock {
+    pub key: i32,
+    pub samples: Vec<[i32; 2]>,
+    pub values: Vec<f64>,
+}
+
+fn into_f64_vec(block: Array3Storage) -> Vec<f64> {
+    match block {
+        Array3Storage::F64(a) => a.into_owned().into_raw_vec_and_offset().0,
+        Array3Storage::F32(a) => a.iter().map(|&x| f64::from(x)).collect(),
+        Array3Storage::F16(a) => a.iter().map(|x| x.to_f64()).collect(),
+    }
+}
+
+/// Reads frames `start, start + step, …` before `stop` (to the end when
+/// `None`) from a file into one batch, honouring the float kinds in
+/// `dtypes` (`positions`, `forces`, `energies`).
+///
+/// Compressed inputs are inflated into memory first; uncompressed files
+/// with a fresh `.con.idx` sidecar locate the selected frames without a scan.
+pub fn read_trajectory_tensors(
+    path: &Path,
+    start: usize,
+    stop: Option<usize>,
+    step: usize,
+    dtypes: &StorageDtypes,
+) -> Result<TrajectoryTensors, Box<dyn std::error::Error>> {
+    let contents = crate::compression::read_file_contents(path)?;
+    let text = contents.as_str()?;
+    // Sidecar offsets address the bytes on disk, so only plain files use one.
+    let index = if crate::compression::detect_path_compression(path)? == Compression::None {
+        FrameOffsetIndex::load_fresh(path)
+    } else {
+        None
+    };
+    Ok(batch_from_spans(
+        selected_spans(text, index.as_ref(), start, stop, step)?,
+        dtypes,
+    )?)
+}
+
+/// [`read_trajectory_tensors`] over an in-memory CON buffer.
+pub fn trajectory_tensors_from_str(
+    text: &str,
+    start: usize,
+    stop: Option<usize>,
+    step: usize,
+    dtypes: &StorageDtypes,
+) -> Result<TrajectoryTensors, ParseError> {
+    batch_from_spans(selected_spans(text, None, start, stop, step)?, dtypes)
+}
+
+/// Byte spans of the selected frames, skipping everything else unparsed.
+fn selected_spans<'a>(
+    text: &'a str,
+    index: Option<&FrameOffsetIndex>,
+    start: usize,
+    stop: Option<usize>,
+    step: usize,
+) -> Result<Vec<(usize, &'a str)>, ParseError> {
+    if step == 0 {
+        return Err(ParseError::ValidationError("stride step must be non-zero".into()));
+    }
+    let mut it = ConFrameIterator::new(text);
+    if let Some(index) = index {
+        it = it.with_offset_index(index);
+    }
+    let mut spans = Vec::new();
+    let mut i = start;
+    while stop.is_none_or(|stop| i < stop) && it.seek(i)? {
+        let begin = it.byte_offset();
+        match it.forward_fast() {
+            Some(r) => r?,
+            None => break,
+        }
+        spans.push((i, &text[begin..it.byte_offset()]));
+        i = match i.checked_add(step) {
+            Some(next) => next,
+            None => break,
+        };
+    }
+    Ok(spans)
+}
+
+fn float_kind(kind: ElementKind, field: &str) -> Result<ElementKind, ParseError> {
+    match kind {
+        ElementKind::Float64 | ElementKind::Float32 | ElementKind::Float16 => Ok(kind),
+        other => Err(ParseError::ValidationError(format!(
+            "batched {field} must be float64, float32 or float16, not {}",
+            other.as_str()
+        ))),
+    }
+}
+
+fn batch_from_spans(
+    spans: Vec<(usize, &str)>,
+    dtypes: &StorageDtypes,
+) -> Result<TrajectoryTensors, ParseError> {
+    let pos_kind = float_kind(dtypes.positions, "positions")?;
+    let force_kind = float_kind(dtypes.forces, "forces")?;
+    let energy_kind = float_kind(dtypes.energies, "energies")?;
+    // The first frame fixes the atoms and whether forces are batched; its
+    // parse is copied into slab 0 below rather than repeated.
+    let first = spans.first().map(|(_, text)| parse_lean(text)).transpose()?;
+    let layout = first.as_ref().map_or_else(Layout::default, |frame| Layout {
+        n_atoms: frame.len(),
+        symbols: frame.symbols.clone(),
+        counts: frame.header.natms_per_type.clone(),
+    });
+    let with_forces = first.as_ref().is_some_and(|frame| frame.has_forces());
+    let n_atoms = layout.n_atoms;
+    let n_frames = spans.len();
+    let per_frame = n_atoms * 3;
+    let mut positions = Block::zeros(pos_kind, n_frames * per_frame);
+    let mut forces = with_forces.then(|| Block::zeros(force_kind, n_frames * per_frame));
+    let mut energies = vec![f64::NAN; n_frames];
+
+    let force_slabs: Vec<Option<Slab<'_>>> = match forces.as_mut() {
+        Some(b) => b.frame_slabs(n_frames, per_frame).into_iter().map(Some).collect(),
+        None => (0..n_frames).map(|_| None).collect(),
+    };
+    let mut jobs: Vec<FrameJob<'_, '_>> = spans
+        .iter()
+        .zip(positions.frame_slabs(n_frames, per_frame))
+        .zip(force_slabs)
+        .zip(energies.iter_mut())
+        .enumerate()
+        .map(|(index, (((&(_, text), positions), forces), energy))| FrameJob {
+            index,
+            text,
+            positions,
+            forces,
+            energy,
+        })
+        .collect();
+    if let Some(frame) = first {
+        let mut job = jobs.remove(0);
+        job.positions.fill(&frame.positions);
+        if let Some(forces) = job.forces.as_mut() {
+            forces.fill(&frame.forces);
+        }
+        if let Some(e) = frame.header.energy() {
+            *job.energy = e;
+        }
+    }
+    #[cfg(feature = "parallel")]
+    jobs.into_par_iter()
+        .map(|job| job.run(&layout))
+        .collect::<Result<(), ParseError>>()?;
+    #[cfg(not(feature = "parallel"))]
+    jobs.into_iter()
+        .map(|job| job.run(&layout))
+        .collect::<Result<(), ParseError>>()?;
+
+    let mut energies = Array1Storage::from_f64_vec(energies);
+    energies.project_to(energy_kind);
+    Ok(TrajectoryTensors {
+        positions: positions.into_storage(n_frames, n_atoms),
+        forces: forces.map(|b| b.into_storage(n_frames, n_atoms)),
+        energies,
+        frames: spans.iter().map(|&(i, _)| i).collect(),
+        atomic_numbers: layout.atomic_numbers(),
+    })
+}
+
+/// Atoms of the first selected frame, which every batched frame must share.
+#[derive(Default)]
+struct Layout {
+    n_atoms: usize,
+    symbols: Vec<Arc<str>>,
+    counts: Vec<usize>,
+}
+
+impl Layout {
+    fn atomic_numbers(&self) -> Vec<u64> {
+        self.symbols
+            .iter()
+            .zip(&self.counts)
+            .flat_map(|(sym, &count)| {
+                std::iter::repeat_n(crate::helpers::symbol_to_atomic_number(sym), count)
+            })
+            .collect()
+    }
+}
+
+fn parse_lean(text: &str) -> Result<crate::lean::LeanFrame, ParseError> {
+    ConFrameIterator::new(text)
+        .next_lean()
+        .unwrap_or(Err(ParseError::IncompleteHeader))
+}
+
+/// Decode one frame span into its slabs of the batch.
+struct FrameJob<'s, 'b> {
+    index: usize,
+    text: &'s str,
+    positions: Slab<'b>,
+    forces: Option<Slab<'b>>,
+    energy: &'b mut f64,
+}
+
+impl FrameJob<'_, '_> {
+    fn run(mut self, layout: &Layout) -> Result<(), ParseError> {
+        let index = self.index;
+        let n_atoms = layout.n_atoms;
+        let columns = match self.forces {
+            Some(_) => crate::types::ColumnMask::FORCES,
+            None => crate::types::ColumnMask::NONE,
+        };
+        let mut rows = SlabRows {
+            layout,
+            fixed: Vec::with_capacity(n_atoms),
+            atom_ids: Vec::with_capacity(n_atoms),
+            forces: self.forces.take(),
+        };
+        let positions = &mut self.positions;
+        let mut lines = ConFrameIterator::new(self.text).lines;
+        let header = crate::parser::parse_frame_rows_stream(
+            &mut lines,
+            &mut rows,
+            columns,
+            |rows, atom_i, (xyz, fixed, atom_id)| {
+                positions.set_row(atom_i, xyz);
+                rows.fixed.push(fixed);
+                rows.atom_ids.push(atom_id);
+            },
+            |header, symbols| {
+                let len: usize = header.natms_per_type.iter().sum();
+                if len != n_atoms {
+                    return Err(ParseError::ValidationError(format!(
+                        "frame {index} of the batch has {len} atoms, expected {n_atoms} (batched tensors need a fixed atom count)"
+                    )));
+                }
+                if symbols != layout.symbols || header.natms_per_type != layout.counts {
+                    return Err(ParseError::ValidationError(format!(
+                        "frame {index} of the batch has a different atom layout than the first"
+                    )));
+                }
+                Ok(())
+            },
+        )?;
+        let has_forces = header.sections.iter().any(|s| s == crate::types::SECTION_FORCES);
+        if rows.forces.is_some() && !has_forces {
+            return Err(ParseError::ValidationError(format!(
+                "frame {index} of the batch has no force section"
+            )));
+        }
+        if let Some(e) = header.energy() {
+            *self.energy = e;
+        }
+        Ok(())
+    }
+}
+
+/// Section sink for a [`FrameJob`]: force rows land in the force slab, the
+/// other sections are dropped, and the coordinate identities back strict
+/// section validation.
+struct SlabRows<'l, 'b> {
+    layout: &'l Layout,
+    fixed: Vec<[bool; 3]>,
+    atom_ids: Vec<u64>,
+    forces: Option<Slab<'b>>,
+}
+
+impl SectionTarget for SlabRows<'_, '_> {
+    fn atom_symbol(&self, atom_idx: usize) -> Option<&str> {
+        if atom_idx >= self.fixed.len() {
+            return None;
+        }
+        crate::lean::component_of(&self.layout.counts, atom_idx)
+            .and_then(|k| self.layout.symbols.get(k))
+            .map(|symbol| symbol.as_ref())
+    }
+
+    fn atom_identity(&self, atom_idx: usize) -> Option<([bool; 3], u64)> {
+        Some((*self.fixed.get(atom_idx)?, *self.atom_ids.get(atom_idx)?))
+    }
+
+    fn set_vector(&mut self, section: VectorSection, atom_idx: usize, value: [f64; 3]) {
+        if let (VectorSection::Forces, Some(forces)) = (section, self.forces.as_mut()) {
+            forces.set_row(atom_idx, value);
+        }
+    }
+
+    fn set_scalar(&mut self, _section: ScalarSection, _atom_idx: usize, _value: f64) {}
+}
+
+/// Flat row-major buffer for one batched field.
+enum Block {
+    F64(Vec<f64>),
+    F32(Vec<f32>),
+    F16(Vec<half::f16>),
+}
+
+impl Block {
+    fn zeros(kind: ElementKind, len: usize) -> Self {
+        match kind {
+            ElementKind::Float32 => Self::F32(vec![0.0; len]),
+            ElementKind::Float16 => Self::F16(vec![half::f16::ZERO; len]),
+            _ => Self::F64(vec![0.0; len]),
+        }
+    }
+
+    /// One disjoint `per_frame`-element slab per frame.
+    fn frame_slabs(&mut self, n_frames: usize, per_frame: usize) -> Vec<Slab<'_>> {
+        fn split<T>(v: &mut [T], n: usize, per: usize) -> Vec<&mut [T]> {
+            if per == 0 {
+                return (0..n).map(|_| Default::default()).collect();
+            }
+            v.chunks_exact_mut(per).collect()
+        }
+        match self {
+            Self::F64(v) => split(v, n_frames, per_frame).into_iter().map(Slab::F64).collect(),
+            Self::F32(v) => split(v, n_frames, per_frame).into_iter().map(Slab::F32).collect(),
+            Self::F16(v) => split(v, n_frames, per_frame).into_iter().map(Slab::F16).collect(),
+        }
+    }
+
+    fn into_storage(self, n_frames: usize, n_atoms: usize) -> Array3Storage {
+        let shape = (n_frames, n_atoms, 3);
+        let expect = "batch buffer length matches (n_frames, n_atoms, 3)";
+        match self {
+            Self::F64(v) => Array3Storage::F64(
+                ndarray::Array3::from_shape_vec(shape, v).expect(expect).into_shared(),
+            ),
+            Self::F32(v) => Array3Storage::F32(
+                ndarray::Array3::from_shape_vec(shape, v).expect(expect).into_shared(),
+            ),
+            Self::F16(v) => Array3Storage::F16(
+                ndarray::Array3::from_shape_vec(shape, v).expect(expect).into_shared(),
+            ),
+        }
+    }
+}
+
+/// One frame's `(n_atoms * 3)` window into a [`Block`].
+enum Slab<'a> {
+    F64(&'a mut [f64]),
+    F32(&'a mut [f32]),
+    F16(&'a mut [half::f16]),
+}
+
+impl Slab<'_> {
+    /// Write row `i` of the `(n_atoms, 3)` window; rows past it are ignored
+    /// (the frame is then rejected for its atom count).
+    #[inline]
+    fn set_row(&mut self, i: usize, [x, y, z]: [f64; 3]) {
+        fn put<T: Copy>(dst: &mut [T], i: usize, row: [T; 3]) {
+            if let Some(slot) = dst.get_mut(i * 3..i * 3 + 3) {
+                slot.copy_from_slice(&row);
+            }
+        }
+        match self {
+            Self::F64(dst) => put(dst, i, [x, y, z]),
+            Self::F32(dst) => put(dst, i, [x as f32, y as f32, z as f32]),
+            Self::F16(dst) => put(dst, i, [x, y, z].map(half::f16::from_f64)),
+        }
+    }
+
+    /// Copy an `(n_atoms, 3)` block in, converting to the slab dtype. Same
+    /// dtype contiguous blocks are a single `memcpy`.
+    fn fill(&mut self, src: &Array2Storage) {
+        fn rows<T>(dst: &mut [T], src: &Array2Storage, cast: impl Fn(f64) -> T) {
+            for (i, row) in dst.chunks_exact_mut(3).enumerate() {
+                let [x, y, z] = src.as_f64_row(i);
+                row[0] = cast(x);
+                row[1] = cast(y);
+                row[2] = cast(z);
+            }
+        }
+        match self {
+            Self::F64(dst) => match src.as_f64_slice() {
+                Some(s) => dst.copy_from_slice(s),
+                None => rows(dst, src, |x| x),
+            },
+            Self::F32(dst) => match src.as_f32_slice() {
+                Some(s) => dst.copy_from_slice(s),
+                None => rows(dst, src, |x| x as f32),
+            },
+            Self::F16(dst) => rows(dst, src, half::f16::from_f64),
+        }
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use std::path::PathBuf;
+
+    fn fixture(name: &str) -> PathBuf {
+        PathBuf::from(env!("CARGO_MANIFEST_DIR")).join("resources/test").join(name)
+    }
+
+    /// Three copies of the forces fixture, each with its own total energy.
+    fn forces_trajectory() -> String {
+        let text = std::fs::read_to_string(fixture("tiny_cuh2_forces.con")).unwrap();
+        let frame = ConFrameIterator::new(&text).next().unwrap().unwrap();
+        let mut buf = Vec::new();
+        {
+            let mut w = crate::writer::ConFrameWriter::new(&mut buf);
+            for k in 0..3 {
+                let mut f = frame.clone();
+                f.header.set_energy(-1.5 * k as f64);
+                w.write_frame(&f).unwrap();
+            }
+        }
+        String::from_utf8(buf).unwrap()
+    }
+
+    #[test]
+    fn batch_matches_per_frame_parse() {
+        let path = fixture("tiny_multi_cuh2.con");
+        let frames = crate::iterators::read_all_frames(&path).unwrap();
+        let t = read_trajectory_tensors(&path, 0, None, 1, &StorageDtypes::default()).unwrap();
+        assert_eq!(t.n_frames(), frames.len());
+        assert_eq!(t.n_atoms(), frames[0].atom_data.len());
+        assert!(!t.has_forces());
+        let flat = t.positions.as_f64_slice().unwrap();
+        for (f, frame) in frames.iter().enumerate() {
+            let n = t.n_atoms();
+            assert_eq!(&flat[f * n * 3..(f + 1) * n * 3], frame.positions.as_f64_slice().unwrap());
+        }
+        assert!(t.energies.get_f64(0).is_nan());
+    }
+
+    #[test]
+    fn strided_range_forces_and_energies() {
+        let text = forces_trajectory();
+        let t = trajectory_tensors_from_str(&text, 1, None, 1, &StorageDtypes::default()).unwrap();
+        assert_eq!(t.n_frames(), 2);
+        let forces = t.forces.as_ref().expect("forces batched");
+        assert_eq!(forces.dim(), (2, t.n_atoms(), 3));
+        let frame = ConFrameIterator::new(&text).next().unwrap().unwrap();
+        assert_eq!(forces.get_f64(1, 0, 2), frame.forces.as_f64_row(0)[2]);
+        assert_eq!(t.energies.get_f64(0), -1.5);
+        assert_eq!(t.energies.get_f64(1), -3.0);
+
+        let every_other = trajectory_tensors_from_str(&text, 0, Some(3), 2, &StorageDtypes::default())
+            .unwrap();
+        assert_eq!(every_other.n_frames(), 2);
+        assert_eq!(every_other.energies.get_f64(1), -3.0);
+    }
+
+    #[test]
+    fn float32_and_float16_batches_export_as_one_tensor() {
+        let text = forces_trajectory();
+        for kind in [ElementKind::Float32, ElementKind::Float16] {
+            let dtypes = StorageDtypes {
+                positions: kind,
+                forces: kind,
+                energies: kind,
+                ..StorageDtypes::default()
+            };
+            let t = trajectory_tensors_from_str(&text, 0, None, 1, &dtypes).unwrap();
+            assert_eq!(t.positions.kind(), kind);
+            assert_eq!(t.energies.kind(), kind);
+            let tensor = t.positions.as_dlpack(dlpk::sys::DLDevice::cpu()).unwrap();
+            assert_eq!(tensor.shape(), &[3, t.n_atoms() as i64, 3]);
+            assert_eq!(tensor.dtype().bits, kind.dlpack_bits());
+            let frame = ConFrameIterator::new(&text).next().unwrap().unwrap();
+            let want = frame.positions.as_f64_row(1)[0];
+            let got = t.positions.get_f64(2, 1, 0);
+            assert!((got - want).abs() < 1e-2 * want.abs().max(1.0), "{kind:?} {got} {want}");
+        }
+    }
+
+    /// The forces fixture followed by `edit` applied to a copy of it.
+    fn edited_pair(edit: impl FnOnce(&mut crate::types::ConFrame)) -> String {
+        let text = std::fs::read_to_string(fixture("tiny_cuh2_forces.con")).unwrap();
+        let frame = ConFrameIterator::new(&text).next().unwrap().unwrap();
+        let mut second = frame.clone();
+        edit(&mut second);
+        second.sync_arrays_from_atom_data();
+        let mut buf = Vec::new();
+        {
+            let mut w = crate::writer::ConFrameWriter::new(&mut buf);
+            w.write_frame(&frame).unwrap();
+            w.write_frame(&second).unwrap();
+        }
+        String::from_utf8(buf).unwrap()
+    }
+
+    #[test]
+    fn later_frames_decode_into_their_slabs() {
+        let pair = edited_pair(|f| {
+            for (k, atom) in f.atom_data.iter_mut().enumerate() {
+                atom.x += 0.25 * (k + 1) as f64;
+                atom.force = atom.force.map(|[x, y, z]| [-x, 2.0 * y, z + 1.0]);
+            }
+        });
+        let frames: Vec<_> = ConFrameIterator::new(&pair).map(|r| r.unwrap()).collect();
+        let t = trajectory_tensors_from_str(&pair, 0, None, 1, &StorageDtypes::default()).unwrap();
+        let n = t.n_atoms();
+        let positions = t.positions.as_f64_slice().unwrap();
+        let forces = t.forces.as_ref().unwrap().as_f64_slice().unwrap();
+        for (f, frame) in frames.iter().enumerate() {
+            let slab = f * n * 3..(f + 1) * n * 3;
+            assert_eq!(&positions[slab.clone()], frame.positions.as_f64_slice().unwrap());
+            assert_eq!(&forces[slab], frame.forces.as_f64_slice().unwrap());
+        }
+        assert_ne!(positions[..n * 3], positions[n * 3..]);
+    }
+
+    #[test]
+    fn mismatched_atom_count_is_rejected() {
+        let mixed = edited_pair(|f| {
+            f.atom_data.pop();
+            let last = f.header.natms_per_type.len() - 1;
+            f.header.natms_per_type[last] -= 1;
+        });
+        let err = trajectory_tensors_from_str(&mixed, 0, None, 1, &StorageDtypes::default())
+            .unwrap_err();
+        assert!(matches!(err, ParseError::ValidationError(_)), "{err}");
+        assert!(err.to_string().contains("fixed atom count"), "{err}");
+        // Starting past the odd frame batches fine.
+        let tail = trajectory_tensors_from_str(&mixed, 1, None, 1, &StorageDtypes::default());
+        assert_eq!(tail.unwrap().n_atoms(), 3);
+    }
+
+    #[test]
+    fn mismatched_atom_layout_is_rejected() {
+        let relabelled = edited_pair(|f| {
+            let ag: Arc<str> = Arc::from("Ag");
+            let n_first = f.header.natms_per_type[0];
+            f.atom_data[..n_first].iter_mut().for_each(|a| a.symbol = ag.clone());
+        });
+        let err = trajectory_tensors_from_str(&relabelled, 0, None, 1, &StorageDtypes::default())
+            .unwrap_err();
+        assert!(matches!(err, ParseError::ValidationError(_)), "{err}");
+        assert!(err.to_string().contains("atom layout"), "{err}");
+    }
+
+    #[test]
+    fn keyed_blocks_cover_every_sample() {
+        let text = forces_trajectory();
+        let t = trajectory_tensors_from_str(&text, 1, None, 1, &StorageDtypes::default()).unwrap();
+        assert_eq!(t.frames, vec![1, 2]);
+        let n = t.n_atoms();
+        let positions = t.positions.as_f64_slice().unwrap().to_vec();
+        let numbers = t.atomic_numbers.clone();
+        assert_eq!(numbers.len(), n);
+
+        let by_quantity = t.clone().into_keyed_blocks(BatchKeys::Quantity).unwrap();
+        assert_eq!(by_quantity.len(), 2);
+        assert_eq!(by_quantity[0].key, BatchQuantity::Positions as i32);
+        assert_eq!(by_quantity[0].values, positions);
+        assert_eq!(by_quantity[1].samples[n], [2, 0]);
+
+        let by_species = t.into_keyed_blocks(BatchKeys::Species(BatchQuantity::Positions)).unwrap();
+        assert!(by_species.windows(2).all(|w| w[0].key < w[1].key));
+        assert_eq!(by_species.iter().map(|b| b.samples.len()).sum::<usize>(), 2 * n);
+        for block in &by_species {
+            for (r, &[frame, atom]) in block.samples.iter().enumerate() {
+                let (f, a) = (frame as usize - 1, atom as usize);
+                assert_eq!(numbers[a], block.key as u64);
+                let row = (f * n + a) * 3;
+                assert_eq!(&block.values[r * 3..r * 3 + 3], &positions[row..row + 3]);
+            }
+        }
+
+        let multi = std::fs::read_to_string(fixture("tiny_multi_cuh2.con")).unwrap();
+        let no_forces = trajectory_tensors_from_str(&multi, 0, None, 1, &StorageDtypes::default())
+            .unwrap();
+        assert!(no_forces.into_keyed_blocks(BatchKeys::Species(BatchQuantity::Forces)).is_err());
+    }
+
+    #[test]
+    fn empty_range_and_bad_dtypes() {
+        let text = forces_trajectory();
+        let t = trajectory_tensors_from_str(&text, 10, None, 1, &StorageDtypes::default()).unwrap();
+        assert_eq!(t.positions.dim(), (0, 0, 3));
+        let ints = StorageDtypes {
+            positions: ElementKind::Int32,
+            ..StorageDtypes::default()
+        };
+        assert!(trajectory_tensors_from_str(&text, 0, None, 1, &ints).is_err());
+        assert!(trajectory_tensors_from_str(&text, 0, None, 0, &StorageDtypes::default()).is_err());
+    }
+}
@@ -134,6 +134,83 @@ pub const SECTION_SPINS: &str = "spins";
 /// Per-atom magnetic moment (3-vector); same block shape as [`SECTION_VELOCITIES`].
 pub const SECTION_MAGMOMS: &str = "magmoms";
 
+/// Per-atom columns a projected parse decodes; see
+/// [`crate::iterators::ConFrameIterator::with_projection`].
+///
+/// The header, JSON metadata included, is always parsed. Sections hang off
+/// the coordinate atoms (symbol, fixed mask, atom id), so any section bit
+/// implies [`Self::POSITIONS`]. [`Self::NONE`] yields header-only frames
+/// with empty atom data and arrays. Sections left out are skipped by line
+/// count without decoding their rows, and are dropped from
+/// `header.sections`.
+#[derive(Clone, Copy, Debug, PartialEq, Eq, Hash)]
+pub struct ColumnMask(pub u32);
+
+impl ColumnMask {
+    /// Header only.
+    pub const NONE: Self = Self(0);
+    pub const POSITIONS: Self = Self(1 << 0);
+    pub const VELOCITIES: Self = Self(1 << 1);
+    pub const FORCES: Self = Self(1 << 2);
+    pub const ENERGIES: Self = Self(1 << 3);
+    pub const CHARGES: Self = Self(1 << 4);
+    pub const SPINS: Self = Self(1 << 5);
+    pub const MAGMOMS: Self = Self(1 << 6);
+    /// Every column (the unprojected parse).
+    pub const ALL: Self = Self((1 << 7) - 1);
+
+    pub const fn contains(self, other: Self) -> bool {
+        self.0 & other.0 == other.0
+    }
+
+    /// No column requested: frames carry the header only.
+    pub const fn is_header_only(self) -> bool {
+        self.0 & Self::ALL.0 == 0
+    }
+
+    /// Bit for a column name: `"positions"` or one of the `SECTION_*` names.
+    pub fn from_name(name: &str) -> Option<Self> {
+        match name {
+            "positions" => Some(Self::POSITIONS),
+            SECTION_VELOCITIES => Some(Self::VELOCITIES),
+            SECTION_FORCES => Some(Self::FORCES),
+            SECTION_ENERGIES => Some(Self::ENERGIES),
+            SECTION_CHARGES => Some(Self::CHARGES),
+            SECTION_SPINS => Some(Self::SPINS),
+            SECTION_MAGMOMS => Some(Self::MAGMOMS),
+            _ => None,
+        }
+    }
+
+    /// Whether section `name` is decoded. Unknown names report `true` so the
+    /// section parser still rejects them.
+    pub fn decodes_section(self, name: &str) -> bool {
+        match Self::from_name(name) {
+            Some(Self::POSITIONS) | None => true,
+            Some(bit) => self.contains(bit),
+        }
+    }
+}
+
+impl Default for ColumnMask {
+    fn default() -> Self {
+        Self::ALL
+    }
+}
+
+impl std::ops::BitOr for ColumnMask {
+    type Output = Self;
+    fn bitor(self, rhs: Self) -> Self {
+        Self(self.0 | rhs.0)
+    }
+}
+
+impl std::ops::BitOrAssign for ColumnMask {
+    fn bitor_assign(&mut self, rhs: Self) {
+        self.0 |= rhs.0;
+    }
+}
+
 /// The two-line block preceding the box dimensions.
 ///
 /// Line 0 is free-form user text. Line 1 is reserved for machine-readable
@@ -175,7 +252,7 @@ impl PartialEq for PreboxHeader {
 }
 
 /// Holds all metadata from the 9-line header of a simulation frame.
-#[derive(Debug, Clone)]
+#[derive(Debug, Clone, Default)]
 pub struct FrameHeader {
     /// The two text lines preceding the box dimension data: a user line
     /// plus a managed JSON metadata line.
@@ -658,7 +735,36 @@ pub struct ConFrame {
     pub atom_ids: ndarray::ArcArray1<u64>,
 }
 
+impl Default for ConFrame {
+    /// An empty frame (no atoms), e.g. as the initial target of
+    /// [`crate::iterators::ConFrameIterator::next_into`].
+    fn default() -> Self {
+        con_frame_coords_only(
+            FrameHeader::default(),
+            Vec::new(),
+            crate::storage_dtype::FloatArray2::zeros_f64(0, 3),
+        )
+    }
+}
+
 impl ConFrame {
+    /// Empties the optional-section arrays that are not already empty, so a
+    /// recycled frame whose new contents declare no sections matches a
+    /// freshly parsed one.
+    pub(crate) fn clear_section_arrays(&mut self) {
+        use crate::storage_dtype::{FloatArray1, FloatArray2};
+        for block in [&mut self.velocities, &mut self.forces, &mut self.magmoms] {
+            if block.nrows() != 0 {
+                *block = FloatArray2::zeros(block.kind(), 0, 3);
+            }
+        }
+        for column in [&mut self.atom_energies, &mut self.charges, &mut self.spins] {
+            if column.len() != 0 {
+                *column = FloatArray1::zeros(column.kind(), 0);
+            }
+        }
+    }
+
     /// Apply [`crate::storage_dtype::StorageDtypes`] from metadata (or argument) to SoA fields.
     pub fn project_storage_dtypes(&mut self, dtypes: &crate::storage_dtype::StorageDtypes) {
         self.positions.project_to(dtypes.positions);
@@ -1037,6 +1143,50 @@ fn arc_push_f64_1d(arr: &mut ndarray::ArcArray1<f64>, value: f64) {
     *arr = owned.into_shared();
 }
 
+/// Species column for [`FrameArrays`]: either runs of one symbol
+/// (`symbols[k]` repeated `counts[k]` times, in atom order) or one atomic
+/// number per atom (unknown numbers map to `"X"`).
+#[derive(Debug, Clone, Copy)]
+pub enum SpeciesColumn<'a> {
+    Runs {
+        symbols: &'a [&'a str],
+        counts: &'a [usize],
+    },
+    AtomicNumbers(&'a [u64]),
+}
+
+impl SpeciesColumn<'_> {
+    /// Number of atoms described by the column; `None` when the run counts
+    /// sum past `usize::MAX`.
+    pub fn atom_count(&self) -> Option<usize> {
+        match self {
+            SpeciesColumn::Runs { counts, .. } => {
+                counts.iter().try_fold(0usize, |n, &count| n.checked_add(count))
+            }
+            SpeciesColumn::AtomicNumbers(z) => Some(z.len()),
+        }
+    }
+}
+
+/// Borrowed per-atom columns for [`ConFrameBuilder::set_atoms_from_arrays`].
+///
+/// The atom count `N` comes from `species`. Vector blocks are row-major
+/// `[x0, y0, z0, x1, ...]` of length `3 * N`; scalar columns have length
+/// `N`. `fixed` holds CON column-4 bitmask values (see
+/// [`decode_fixed_bitmask`]) and defaults to all free; `atom_ids` defaults
+/// to `0..N`.
+#[derive(Debug, Clone, Copy)]
+pub struct FrameArrays<'a> {
+    pub species: SpeciesColumn<'a>,
+    pub positions: &'a [f64],
+    pub masses: &'a [f64],
+    pub fixed: Option<&'a [u8]>,
+    pub atom_ids: Option<&'a [u64]>,
+    pub velocities: Option<&'a [f64]>,
+    pub forces: Option<&'a [f64]>,
+    pub energies: Option<&'a [f64]>,
+}
+
 #[derive(Debug, Clone)]
 pub struct ConFrameBuilder {
     prebox_user: String,
@@ -1045,7 +1195,8 @@ pub struct ConFrameBuilder {
     postbox_header: [String; 2],
 
     // Per-atom heterogeneous fields kept as Vecs (no DLPack export).
-    symbols: Vec<String>,
+    // Consecutive atoms of one species share an Arc (see `add_atom`).
+    symbols: Vec<Arc<str>>,
     fixed: Vec<[bool; 3]>,
 
     // Per-atom DLPack-exportable fields, owned ndarrays.
@@ -1261,7 +1412,11 @@ impl ConFrameBuilder {
         mass: f64,
     ) -> &mut Self {
         use ndarray::array;
-        self.symbols.push(symbol.to_string());
+        let symbol = match self.symbols.last() {
+            Some(last) if &**last == symbol => Arc::clone(last),
+            _ => Arc::from(symbol),
+        };
+        self.symbols.push(symbol);
         self.fixed.push(fixed);
         // Push a row to each owned ndarray. push_row is defined on
         // owned Array (OwnedRepr) but not on ArcArray (OwnedArcRepr),
@@ -1644,6 +1799,104 @@ impl ConFrameBuilder {
         Ok(self)
     }
 
+    /// Replaces every atom with the columns in `arrays` in one pass.
+    ///
+    /// Only lengths are checked (`InvalidVectorLength`, including run
+    /// counts that disagree with `symbols`); the blocks are copied straight
+    /// into the builder's SoA buffers. Sections are declared exactly for the
+    /// optional blocks that are present. Headers, cell and metadata are kept.
+    pub fn set_atoms_from_arrays(
+        &mut self,
+        arrays: &FrameArrays<'_>,
+    ) -> Result<&mut Self, crate::error::ParseError> {
+        let expect_len = |found: usize, expected: usize| {
+            if found == expected {
+                Ok(())
+            } else {
+                Err(crate::error::ParseError::InvalidVectorLength { expected, found })
+            }
+        };
+        if let SpeciesColumn::Runs { symbols, counts } = arrays.species {
+            expect_len(counts.len(), symbols.len())?;
+        }
+        let overflow = || {
+            crate::error::ParseError::ValidationError("species run counts overflow usize".into())
+        };
+        let n = arrays.species.atom_count().ok_or_else(overflow)?;
+        let n_xyz = n.checked_mul(3).ok_or_else(overflow)?;
+        expect_len(arrays.positions.len(), n_xyz)?;
+        expect_len(arrays.masses.len(), n)?;
+        for column in [arrays.fixed.map(<[u8]>::len), arrays.atom_ids.map(<[u64]>::len)] {
+            column.map_or(Ok(()), |len| expect_len(len, n))?;
+        }
+        for block in [arrays.velocities, arrays.forces] {
+            block.map_or(Ok(()), |b| expect_len(b.len(), n_xyz))?;
+        }
+        arrays.energies.map_or(Ok(()), |e| expect_len(e.len(), n))?;
+
+        let mut symbols: Vec<Arc<str>> = Vec::with_capacity(n);
+        match arrays.species {
+            SpeciesColumn::Runs { symbols: names, counts } => {
+                for (name, &count) in names.iter().zip(counts) {
+                    let symbol: Arc<str> = Arc::from(*name);
+                    symbols.extend(std::iter::repeat_n(symbol, count));
+                }
+            }
+            SpeciesColumn::AtomicNumbers(numbers) => {
+                let mut interned: Vec<(u64, Arc<str>)> = Vec::new();
+                for &z in numbers {
+                    let at = match interned.iter().position(|(seen, _)| *seen == z) {
+                        Some(at) => at,
+                        None => {
+                            let name = crate::helpers::atomic_number_to_symbol(z);
+                            interned.push((z, Arc::from(name)));
+                            interned.len() - 1
+                        }
+                    };
+                    symbols.push(Arc::clone(&interned[at].1));
+                }
+            }
+        }
+        self.symbols = symbols;
+        self.fixed = match arrays.fixed {
+            Some(bits) => bits.iter().map(|&b| decode_fixed_bitmask(b)).collect(),
+            None => vec![[false; 3]; n],
+        };
+
+        let block = |data: &[f64]| {
+            ndarray::ArcArray2::from_shape_vec((n, 3), data.to_vec())
+                .expect("block length checked above")
+        };
+        self.positions = block(arrays.positions);
+        self.masses = ndarray::ArcArray1::from_vec(arrays.masses.to_vec());
+        self.atom_ids = match arrays.atom_ids {
+            Some(ids) => ndarray::ArcArray1::from_vec(ids.to_vec()),
+            None => ndarray::ArcArray1::from_vec((0..n as u64).collect()),
+        };
+        let absent = || ndarray::ArcArray2::<f64>::zeros((0, 3));
+        self.has_velocities = arrays.velocities.is_some();
+        self.velocities = arrays.velocities.map_or_else(absent, block);
+        self.has_forces = arrays.forces.is_some();
+        self.forces = arrays.forces.map_or_else(absent, block);
+        self.has_energies = arrays.energies.is_some();
+        self.atom_energies = ndarray::ArcArray1::from_vec(
+            arrays.energies.map_or_else(Vec::new, <[f64]>::to_vec),
+        );
+        Ok(self)
+    }
+
+    /// Builder for `cell`/`angles` holding the atoms in `arrays`; see
+    /// [`Self::set_atoms_from_arrays`].
+    pub fn from_arrays(
+        cell: [f64; 3],
+        angles: [f64; 3],
+        arrays: &FrameArrays<'_>,
+    ) -> Result<Self, crate::error::ParseError> {
+        let mut builder = Self::new(cell, angles);
+        builder.set_atoms_from_arrays(arrays)?;
+        Ok(builder)
+    }
+
     /// Read-only accessor: position of atom `i` as `(x, y, z)`.
     pub fn get_atom_position(
         &self,
@@ -2018,7 +2271,7 @@ impl ConFrameBuilder {
         // order and bucket its position. The buckets preserve per-symbol
         // input order so the final flatten yields atoms grouped by type.
         let n = self.symbols.len();
-        let mut type_order: Vec<String> = Vec::new();
+        let mut type_order: Vec<Arc<str>> = Vec::new();
         let mut type_counts: Vec<usize> = Vec::new();
         let mut type_masses: Vec<f64> = Vec::new();
         let mut buckets: Vec<Vec<usize>> = Vec::new();
@@ -2026,13 +2279,14 @@ impl ConFrameBuilder {
         for i in 0..n {
             let symbol = &self.symbols[i];
             let mass = self.masses[i];
-            let idx = match type_order.iter().position(|s| s == symbol) {
+            let same = |s: &Arc<str>| Arc::ptr_eq(s, symbol) || s == symbol;
+            let idx = match type_order.iter().position(same) {
                 Some(idx) => {
                     type_counts[idx] += 1;
                     idx
                 }
                 None => {
-                    type_order.push(symbol.clone());
+                    type_order.push(Arc::clone(symbol));
                     type_counts.push(1);
                     type_masses.push(mass);
                     buckets.push(Vec::new());
@@ -2042,17 +2296,14 @@ impl ConFrameBuilder {
             buckets[idx].push(i);
         }
 
-        // One Arc<str> per type so all atoms of the same symbol share storage.
-        let type_symbols: Vec<Arc<str>> =
-            type_order.iter().map(|s| Arc::from(s.as_str())).collect();
-
         let has_vel = self.has_velocities;
         let has_frc = self.has_forces;
         let has_eng = self.has_energies;
 
         let mut atom_data: Vec<AtomDatum> = Vec::with_capacity(n);
         for (type_idx, indices) in buckets.iter().enumerate() {
-            let symbol = &type_symbols[type_idx];
+            // One Arc<str> per type so all atoms of the same symbol share storage.
+            let symbol = &type_order[type_idx];
             for &i in indices {
                 let pos = self.positions.row(i);
                 let velocity = if has_vel {
@@ -2256,6 +2507,43 @@ pub fn con_frame_coords_only(
     }
 }
 
+/// Recycling counterpart of the mass / id assembly in
+/// [`con_frame_coords_only`]: refills `frame.masses` and `frame.atom_ids`
+/// from its (already refilled) header and `atom_data`, in place when their
+/// length and dtype are unchanged and no other frame shares them.
+pub(crate) fn refill_masses_and_ids(
+    frame: &mut ConFrame,
+    dt: &crate::storage_dtype::StorageDtypes,
+) {
+    use crate::storage_dtype::{ElementKind, FloatArray1, StorageDtypes};
+    let n = frame.atom_data.len();
+    let shared = dt.masses == ElementKind::Float64 && frame.masses.unique_f64_slice_mut().is_none();
+    if frame.masses.len() != n || frame.masses.kind() != dt.masses || shared {
+        frame.masses = FloatArray1::zeros(dt.masses, n);
+    }
+    let mut off = 0usize;
+    for (ti, &count) in frame.header.natms_per_type.iter().enumerate() {
+        let m = frame.header.masses_per_type.get(ti).copied().unwrap_or(0.0);
+        let end = (off + count).min(n);
+        match frame.masses.as_f64_slice_mut() {
+            Some(flat) => flat[off..end].fill(m),
+            None => (off..end).for_each(|i| frame.masses.set_f64(i, m)),
+        }
+        off = end;
+    }
+    if frame.atom_ids.len() != n || !frame.atom_ids.is_unique() {
+        frame.atom_ids = ndarray::ArcArray1::<u64>::zeros(n);
+    }
+    if let Some(ids) = frame.atom_ids.as_slice_mut() {
+        for (id, a) in ids.iter_mut().zip(&frame.atom_data) {
+            *id = a.atom_id;
+        }
+    }
+    if *dt != StorageDtypes::all_f64() {
+        dt.insert_into(&mut frame.header.metadata);
+    }
+}
+
 /// Like [`con_frame_from_atom_data`], but **reuses** prefilled `positions` SoA
 /// (no second O(N) position write). Optional sections still filled from AoS
 /// when present; the common coords-only case delegates to [`con_frame_coords_only`].
@@ -2949,6 +3237,114 @@ mod tests {
         assert_eq!(frame.atom_data[2].force, Some([0.0, 0.0, 1.0]));
     }
 
+    #[test]
+    fn builder_from_arrays_matches_per_atom_build() {
+        let mut per_atom = three_atom_builder();
+        per_atom.set_forces_from_flat(&[0.5; 9]).unwrap();
+        let expected = per_atom.build();
+
+        let positions: Vec<f64> = expected
+            .atom_data
+            .iter()
+            .flat_map(|a| [a.x, a.y, a.z])
+            .collect();
+        let fixed: Vec<u8> = expected
+            .atom_data
+            .iter()
+            .map(|a| encode_fixed_bitmask(a.fixed))
+            .collect();
+        let ids: Vec<u64> = expected.atom_data.iter().map(|a| a.atom_id).collect();
+        let arrays = FrameArrays {
+            species: SpeciesColumn::Runs {
+                symbols: &["Cu", "H"],
+                counts: &[2, 1],
+            },
+            positions: &positions,
+            masses: &[63.546, 63.546, 1.008],
+            fixed: Some(&fixed),
+            atom_ids: Some(&ids),
+            velocities: None,
+            forces: Some(&[0.5; 9]),
+            energies: None,
+        };
+        let b = ConFrameBuilder::from_arrays([10.0; 3], [90.0; 3], &arrays).unwrap();
+        let frame = b.build();
+        assert_eq!(frame.atom_data, expected.atom_data);
+        assert_eq!(frame.header.natms_per_type, expected.header.natms_per_type);
+        assert_eq!(frame.header.masses_per_type, expected.header.masses_per_type);
+        assert!(frame.has_forces() && !frame.has_velocities());
+        assert!(Arc::ptr_eq(&frame.atom_data[0].symbol, &frame.atom_data[1].symbol));
+    }
+
+    #[test]
+    fn builder_from_arrays_atomic_numbers_and_defaults() {
+        let arrays = FrameArrays {
+            species: SpeciesColumn::AtomicNumbers(&[29, 1, 29]),
+            positions: &[0.0; 9],
+            masses: &[63.546, 1.008, 63.546],
+            fixed: None,
+            atom_ids: None,
+            velocities: None,
+            forces: None,
+            energies: Some(&[-1.0, -2.0, -3.0]),
+        };
+        let frame = ConFrameBuilder::from_arrays([10.0; 3], [90.0; 3], &arrays)
+            .unwrap()
+            .build();
+        assert_eq!(frame.header.natms_per_type, vec![2, 1]);
+        let symbols: Vec<&str> = frame.atom_data.iter().map(|a| &*a.symbol).collect();
+        assert_eq!(symbols, ["Cu", "Cu", "H"]);
+        let ids: Vec<u64> = frame.atom_data.iter().map(|a| a.atom_id).collect();
+        assert_eq!(ids, [0, 2, 1]);
+        assert!(frame.atom_data.iter().all(|a| a.fixed == [false; 3]));
+        assert_eq!(frame.atom_data[2].energy, Some(-2.0));
+    }
+
+    #[test]
+    fn builder_from_arrays_length_errors() {
+        let base = FrameArrays {
+            species: SpeciesColumn::Runs {
+                symbols: &["Cu"],
+                counts: &[2],
+            },
+            positions: &[0.0; 6],
+            masses: &[63.546; 2],
+            fixed: None,
+            atom_ids: None,
+            velocities: None,
+            forces: None,
+            energies: None,
+        };
+        let lengths = |arrays: FrameArrays<'_>| {
+            match ConFrameBuilder::new([10.0; 3], [90.0; 3]).set_atoms_from_arrays(&arrays) {
+                Err(crate::error::ParseError::InvalidVectorLength { expected, found }) => {
+                    (expected, found)
+                }
+                other => panic!("expected InvalidVectorLength, got {other:?}"),
+            }
+        };
+        let runs = SpeciesColumn::Runs {
+            symbols: &["Cu", "H"],
+            counts: &[2],
+        };
+        assert_eq!(lengths(FrameArrays { species: runs, ..base }), (2, 1));
+        let short = FrameArrays {
+            positions: &[0.0; 5],
+            ..base
+        };
+        assert_eq!(lengths(short), (6, 5));
+        let bad_velocities = FrameArrays {
+            velocities: Some(&[0.0; 3]),
+            ..base
+        };
+        assert_eq!(lengths(bad_velocities), (6, 3));
+        let bad_fixed = FrameArrays {
+            fixed: Some(&[0; 3]),
+            ..base
+        };
+        assert_eq!(lengths(bad_fixed), (2, 3));
+    }
+
     // ----- DLPack export tier tests -----------------------------------------
     //
     // These tests pin the cross-language zero-copy contract: every per-atom
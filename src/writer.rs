@@ -1,14 +1,18 @@
+use crate::lean::LeanFrame;
+use crate::parser::{ScalarSection, VectorSection};
 use crate::types::{
-    ConFrame, SECTION_CHARGES, SECTION_ENERGIES, SECTION_FORCES, SECTION_MAGMOMS, SECTION_SPINS,
+    ConFrame, FrameHeader, SECTION_CHARGES, SECTION_ENERGIES, SECTION_FORCES, SECTION_MAGMOMS, SECTION_SPINS,
     SECTION_VELOCITIES, encode_fixed_bitmask, meta,
 };
+use crate::offset_index::{FrameIndexBuilder, FrameOffsetIndex};
+use crate::stats::{self, Counter, Stage};
 use serde_json::json;
 use std::fs::File;
 use std::io::{self, BufWriter, Write};
 use std::path::Path;
 
 /// Default floating-point precision used for writing coordinates, cell dimensions, and masses.
-const DEFAULT_FLOAT_PRECISION: usize = 6;
+pub(crate) const DEFAULT_FLOAT_PRECISION: usize = 6;
 
 /// A writer that can serialize and write `ConFrame` objects to any output stream.
 ///
@@ -25,7 +29,7 @@ const DEFAULT_FLOAT_PRECISION: usize = 6;
 /// writer.extend(frames.iter()).unwrap();
 /// ```
 pub struct ConFrameWriter<W: Write> {
-    writer: BufWriter<W>,
+    writer: BufWriter<CountingWriter<W>>,
     precision: usize,
     /// When true: sort metadata keys in JSON, emit sections in canonical
     /// order (velocities, forces, energies), fixed precision suitable for
@@ -39,6 +43,32 @@ pub struct ConFrameWriter<W: Write> {
     /// and re-serialisation. Hot for trajectory writes where every
     /// frame has the same `units` / `potential` / `validate` keys.
     metadata_cache: Option<MetadataCacheEntry>,
+    /// Offset-index entries recorded as frames are written (opt-in via
+    /// [`ConFrameWriter::with_offset_index`]).
+    index: Option<FrameIndexBuilder>,
+    /// Reusable scratch buffer: the header and each component block are
+    /// formatted here with [`push_fixed`] and handed to the sink in one
+    /// `write_all`, instead of one `core::fmt` call per field.
+    line: Vec<u8>,
+}
+
+/// `Write` adapter counting bytes handed to the inner sink, so frame byte
+/// offsets are `count + BufWriter::buffer().len()` without extra formatting.
+struct CountingWriter<W: Write> {
+    inner: W,
+    count: u64,
+}
+
+impl<W: Write> Write for CountingWriter<W> {
+    fn write(&mut self, buf: &[u8]) -> io::Result<usize> {
+        let n = self.inner.write(buf)?;
+        self.count += n as u64;
+        Ok(n)
+    }
+
+    fn flush(&mut self) -> io::Result<()> {
+        self.inner.flush()
+    }
 }
 
 #[derive(Debug)]
@@ -81,6 +111,272 @@ impl MetadataCacheEntry {
     }
 }
 
+/// Largest precision [`push_fixed`] formats itself; wider requests fall
+/// back to `core::fmt`.
+const MAX_FAST_PRECISION: usize = 19;
+
+const POW10: [u64; MAX_FAST_PRECISION + 1] = {
+    let mut table = [1u64; MAX_FAST_PRECISION + 1];
+    let mut k = 1;
+    while k < table.len() {
+        table[k] = table[k - 1] * 10;
+        k += 1;
+    }
+    table
+};
+
+/// Append `value` exactly as `format!("{value:.prec$}")` would.
+///
+/// Finite values whose scaled magnitude fits a `u64` are rounded from the
+/// exact binary significand (ties to even, sign kept for negative zero, as
+/// `core::fmt` does) without going through the formatting machinery; the
+/// rest (NaN, infinities, huge values, `prec > 19`) use `core::fmt`.
+fn push_fixed(out: &mut Vec<u8>, value: f64, prec: usize) {
+    match scaled_fixed(value, prec) {
+        Some(scaled) => {
+            if value.is_sign_negative() {
+                out.push(b'-');
+            }
+            let pow = POW10[prec];
+            push_u64(out, scaled / pow);
+            if prec > 0 {
+                out.push(b'.');
+                push_u64_padded(out, scaled % pow, prec);
+            }
+        }
+        None => {
+            // Writing into a Vec cannot fail.
+            let _ = write!(out, "{value:.prec$}");
+        }
+    }
+}
+
+/// `round_half_even(|value| * 10^prec)` computed in integers, or `None`
+/// when it would not fit the fast path.
+fn scaled_fixed(value: f64, prec: usize) -> Option<u64> {
+    if prec > MAX_FAST_PRECISION {
+        return None;
+    }
+    let bits = value.to_bits();
+    let biased = ((bits >> 52) & 0x7ff) as i32;
+    let fraction = bits & ((1u64 << 52) - 1);
+    let (mantissa, exp) = match biased {
+        0x7ff => return None,
+        0 => (fraction, -1074),
+        _ => (fraction | (1u64 << 52), biased - 1075),
+    };
+    // mantissa < 2^53 and 10^19 < 2^64, so the product fits in 117 bits.
+    let product = mantissa as u128 * POW10[prec] as u128;
+    let scaled = if exp >= 0 {
+        if exp >= 64 {
+            return None;
+        }
+        product.checked_mul(1u128 << exp)?
+    } else {
+        let shift = exp.unsigned_abs();
+        if shift >= 128 {
+            // product < 2^117 <= half an ulp of the result: rounds to zero.
+            0
+        } else {
+            let quotient = product >> shift;
+            let remainder = product & ((1u128 << shift) - 1);
+            let half = 1u128 << (shift - 1);
+            let round_up = remainder > half || (remainder == half && quotient & 1 == 1);
+            quotient + round_up as u128
+        }
+    };
+    u64::try_from(scaled).ok()
+}
+
+/// Append the decimal digits of `n`.
+fn push_u64(out: &mut Vec<u8>, n: u64) {
+    let mut digits = [0u8; 20];
+    let mut pos = digits.len();
+    let mut n = n;
+    loop {
+        pos -= 1;
+        digits[pos] = b'0' + (n % 10) as u8;
+        n /= 10;
+        if n == 0 {
+            break;
+        }
+    }
+    out.extend_from_slice(&digits[pos..]);
+}
+
+/// Append `n` left-padded with zeros to `width` digits (`n < 10^width`).
+fn push_u64_padded(out: &mut Vec<u8>, n: u64, width: usize) {
+    let start = out.len();
+    out.resize(start + width, b'0');
+    let mut n = n;
+    for slot in out[start..].iter_mut().rev() {
+        *slot = b'0' + (n % 10) as u8;
+        n /= 10;
+    }
+}
+
+/// Space-separated `values` at `prec` digits, then a newline.
+fn push_fixed_row(out: &mut Vec<u8>, values: &[f64], prec: usize) {
+    for (k, &v) in values.iter().enumerate() {
+        if k > 0 {
+            out.push(b' ');
+        }
+        push_fixed(out, v, prec);
+    }
+    out.push(b'\n');
+}
+
+/// `symbol` line followed by `"<label> of Component N"` (1-based).
+fn push_component_title(out: &mut Vec<u8>, symbol: &str, label: &str, type_idx: usize) {
+    out.extend_from_slice(symbol.as_bytes());
+    out.push(b'\n');
+    out.extend_from_slice(label.as_bytes());
+    out.extend_from_slice(b" of Component ");
+    push_u64(out, type_idx as u64 + 1);
+    out.push(b'\n');
+}
+
+/// One atom row: `values...` at `prec` digits, fixed bitmask, atom id.
+fn push_atom_row(out: &mut Vec<u8>, values: &[f64], prec: usize, fixed: [bool; 3], atom_id: u64) {
+    for &v in values {
+        push_fixed(out, v, prec);
+        out.push(b' ');
+    }
+    push_u64(out, encode_fixed_bitmask(fixed) as u64);
+    out.push(b' ');
+    push_u64(out, atom_id);
+    out.push(b'\n');
+}
+
+/// Row access the serializer needs, so [`ConFrame`] (through its
+/// `atom_data` projection) and [`LeanFrame`] (through its SoA blocks) share
+/// one writer body. Missing section values are written as zero.
+trait FrameRows {
+    fn header(&self) -> &FrameHeader;
+    /// Atoms with row data; must match the header's `natms_per_type` total.
+    fn atom_count(&self) -> usize;
+    fn has_velocities(&self) -> bool;
+    fn has_forces(&self) -> bool;
+    fn has_energies(&self) -> bool;
+    fn has_charges(&self) -> bool;
+    fn has_spins(&self) -> bool;
+    fn has_magmoms(&self) -> bool;
+    /// Symbol line of component `type_idx`, whose first atom is `first_atom`.
+    fn component_symbol(&self, type_idx: usize, first_atom: usize) -> &str;
+    fn position(&self, i: usize) -> [f64; 3];
+    fn identity(&self, i: usize) -> ([bool; 3], u64);
+    fn vector(&self, section: VectorSection, i: usize) -> [f64; 3];
+    fn scalar(&self, section: ScalarSection, i: usize) -> f64;
+}
+
+impl FrameRows for ConFrame {
+    fn header(&self) -> &FrameHeader {
+        &self.header
+    }
+    fn atom_count(&self) -> usize {
+        self.atom_data.len()
+    }
+    fn has_velocities(&self) -> bool {
+        ConFrame::has_velocities(self)
+    }
+    fn has_forces(&self) -> bool {
+        ConFrame::has_forces(self)
+    }
+    fn has_energies(&self) -> bool {
+        ConFrame::has_energies(self)
+    }
+    fn has_charges(&self) -> bool {
+        ConFrame::has_charges(self)
+    }
+    fn has_spins(&self) -> bool {
+        ConFrame::has_spins(self)
+    }
+    fn has_magmoms(&self) -> bool {
+        ConFrame::has_magmoms(self)
+    }
+    fn component_symbol(&self, _type_idx: usize, first_atom: usize) -> &str {
+        &self.atom_data[first_atom].symbol
+    }
+    fn position(&self, i: usize) -> [f64; 3] {
+        let atom = &self.atom_data[i];
+        [atom.x, atom.y, atom.z]
+    }
+    fn identity(&self, i: usize) -> ([bool; 3], u64) {
+        let atom = &self.atom_data[i];
+        (atom.fixed, atom.atom_id)
+    }
+    fn vector(&self, section: VectorSection, i: usize) -> [f64; 3] {
+        let atom = &self.atom_data[i];
+        match section {
+            VectorSection::Velocities => atom.velocity,
+            VectorSection::Forces => atom.force,
+            VectorSection::Magmoms => atom.magmom,
+        }
+        .unwrap_or([0.0; 3])
+    }
+    fn scalar(&self, section: ScalarSection, i: usize) -> f64 {
+        let atom = &self.atom_data[i];
+        match section {
+            ScalarSection::Energies => atom.energy,
+            ScalarSection::Charges => atom.charge,
+            ScalarSection::Spins => atom.spin,
+        }
+        .unwrap_or(0.0)
+    }
+}
+
+impl FrameRows for LeanFrame {
+    fn header(&self) -> &FrameHeader {
+        &self.header
+    }
+    fn atom_count(&self) -> usize {
+        self.len()
+    }
+    fn has_velocities(&self) -> bool {
+        LeanFrame::has_velocities(self)
+    }
+    fn has_forces(&self) -> bool {
+        LeanFrame::has_forces(self)
+    }
+    fn has_energies(&self) -> bool {
+        LeanFrame::has_energies(self)
+    }
+    fn has_charges(&self) -> bool {
+        LeanFrame::has_charges(self)
+    }
+    fn has_spins(&self) -> bool {
+        LeanFrame::has_spins(self)
+    }
+    fn has_magmoms(&self) -> bool {
+        LeanFrame::has_magmoms(self)
+    }
+    fn component_symbol(&self, type_idx: usize, _first_atom: usize) -> &str {
+        &self.symbols[type_idx]
+    }
+    fn position(&self, i: usize) -> [f64; 3] {
+        self.positions.as_f64_row(i)
+    }
+    fn identity(&self, i: usize) -> ([bool; 3], u64) {
+        (self.fixed[i], self.atom_ids[i])
+    }
+    fn vector(&self, section: VectorSection, i: usize) -> [f64; 3] {
+        let block = match section {
+            VectorSection::Velocities => &self.velocities,
+            VectorSection::Forces => &self.forces,
+            VectorSection::Magmoms => &self.magmoms,
+        };
+        if i < block.nrows() { block.as_f64_row(i) } else { [0.0; 3] }
+    }
+    fn scalar(&self, section: ScalarSection, i: usize) -> f64 {
+        let block = match section {
+            ScalarSection::Energies => &self.atom_energies,
+            ScalarSection::Charges => &self.charges,
+            ScalarSection::Spins => &self.spins,
+        };
+        if i < block.len() { block.get_f64(i) } else { 0.0 }
+    }
+}
+
 // General implementation for any type that implements `Write`.
 impl<W: Write> ConFrameWriter<W> {
     /// Creates a new `ConFrameWriter` that wraps a given writer.
@@ -89,12 +385,7 @@ impl<W: Write> ConFrameWriter<W> {
     ///
     /// * `writer` - Any type that implements `std::io::Write`, e.g., a `File`.
     pub fn new(writer: W) -> Self {
-        Self {
-            writer: BufWriter::new(writer),
-            precision: DEFAULT_FLOAT_PRECISION,
-            canonical: false,
-            metadata_cache: None,
-        }
+        Self::with_precision(writer, DEFAULT_FLOAT_PRECISION)
     }
 
     /// Creates a new `ConFrameWriter` with a custom floating-point precision.
@@ -105,10 +396,15 @@ impl<W: Write> ConFrameWriter<W> {
     /// * `precision` - Number of decimal places for floating-point output.
     pub fn with_precision(writer: W, precision: usize) -> Self {
         Self {
-            writer: BufWriter::new(writer),
+            writer: BufWriter::new(CountingWriter {
+                inner: writer,
+                count: 0,
+            }),
             precision,
             canonical: false,
             metadata_cache: None,
+            index: None,
+            line: Vec::new(),
         }
     }
 
@@ -134,12 +430,88 @@ impl<W: Write> ConFrameWriter<W> {
         self.canonical
     }
 
+    /// Record an offset-index entry for every frame written from now on.
+    /// For file outputs, persist it with [`ConFrameWriter::finish_with_index`];
+    /// otherwise retrieve entries via [`Self::take_offset_index`].
+    pub fn with_offset_index(mut self) -> Self {
+        self.index.get_or_insert_with(FrameIndexBuilder::new);
+        self
+    }
+
+    /// Entries recorded so far (offsets are into the uncompressed stream);
+    /// recording stops.
+    pub fn take_offset_index(&mut self) -> Option<FrameIndexBuilder> {
+        self.index.take()
+    }
+
+    /// Uncompressed bytes emitted so far, including still-buffered output.
+    pub fn bytes_written(&self) -> u64 {
+        self.writer.get_ref().count + self.writer.buffer().len() as u64
+    }
+
+    /// Flush buffered output to the underlying sink.
+    pub fn flush(&mut self) -> io::Result<()> {
+        self.writer.flush()
+    }
+
+    /// Flush buffered output and return the underlying sink.
+    pub fn into_inner(self) -> io::Result<W> {
+        let counting = self.writer.into_inner().map_err(|e| e.into_error())?;
+        Ok(counting.inner)
+    }
+
     /// Writes a single `ConFrame` to the output stream.
     pub fn write_frame(&mut self, frame: &ConFrame) -> io::Result<()> {
-        let prec = self.precision;
+        if self.index.is_none() {
+            return self.write_frame_body(frame);
+        }
+        let start = self.bytes_written();
+        self.write_frame_body(frame)?;
+        let len = self.bytes_written() - start;
+        if let Some(index) = self.index.as_mut() {
+            index.push(frame, start, len);
+        }
+        Ok(())
+    }
 
-        // --- Write the 9-line Header ---
-        writeln!(self.writer, "{}", frame.header.prebox_header.user)?;
+    /// Writes a single [`LeanFrame`]; the output is byte-identical to
+    /// [`Self::write_frame`] on the equivalent [`ConFrame`].
+    pub fn write_lean_frame(&mut self, frame: &LeanFrame) -> io::Result<()> {
+        if self.index.is_none() {
+            return self.write_frame_body(frame);
+        }
+        let start = self.bytes_written();
+        self.write_frame_body(frame)?;
+        let len = self.bytes_written() - start;
+        if let Some(index) = self.index.as_mut() {
+            index.push_lean(frame, start, len);
+        }
+        Ok(())
+    }
+
+    fn write_frame_body<F: FrameRows + ?Sized>(&mut self, frame: &F) -> io::Result<()> {
+        let mut timer = stats::timer(Stage::Write);
+        let start = self.bytes_written();
+        self.format_frame(frame)?;
+        timer.add_bytes(self.bytes_written() - start);
+        stats::count(Counter::FramesWritten, 1);
+        Ok(())
+    }
+
+    fn format_frame<F: FrameRows + ?Sized>(&mut self, frame: &F) -> io::Result<()> {
+        let prec = self.precision;
+        let header = frame.header();
+        let declared: usize = header.natms_per_type.iter().sum();
+        if frame.atom_count() != declared {
+            // e.g. a header-only frame from a `ColumnMask::NONE` projection.
+            return Err(io::Error::new(
+                io::ErrorKind::InvalidInput,
+                format!(
+                    "frame has {} atoms but its header declares {declared}",
+                    frame.atom_count()
+                ),
+            ));
+        }
 
         // Line 2: serialised JSON metadata. The serialisation is
         // deterministic in (spec_version, has_*, metadata), so we
@@ -148,7 +520,7 @@ impl<W: Write> ConFrameWriter<W> {
         // frame shares the same `units` / `potential` / `validate`
         // keys this avoids rebuilding and re-serialising the JSON
         // object on every frame.
-        let spec_version = frame.header.spec_version;
+        let spec_version = header.spec_version;
         let has_vel = frame.has_velocities();
         let has_frc = frame.has_forces();
         let has_eng = frame.has_energies();
@@ -166,7 +538,7 @@ impl<W: Write> ConFrameWriter<W> {
                     has_chg,
                     has_spn,
                     has_mm,
-                    &frame.header.metadata,
+                    &header.metadata,
                 )
             });
 
@@ -195,8 +567,7 @@ impl<W: Write> ConFrameWriter<W> {
             if has_mm {
                 sections.push(json!(SECTION_MAGMOMS));
             }
-            let validate = frame
-                .header
+            let validate = header
                 .metadata
                 .get(meta::VALIDATE)
                 .and_then(|value| value.as_bool())
@@ -205,7 +576,7 @@ impl<W: Write> ConFrameWriter<W> {
                 meta_obj.insert(meta::SECTIONS.into(), json!(sections));
             }
             // Canonical: insert remaining keys in BTree order (metadata is already BTreeMap).
-            for (k, v) in &frame.header.metadata {
+            for (k, v) in &header.metadata {
                 if k == meta::CON_SPEC_VERSION || k == meta::SECTIONS {
                     continue;
                 }
@@ -234,7 +605,7 @@ impl<W: Write> ConFrameWriter<W> {
                 has_charges: has_chg,
                 has_spins: has_spn,
                 has_magmoms: has_mm,
-                metadata: frame.header.metadata.clone(),
+                metadata: header.metadata.clone(),
                 serialized,
             });
         }
@@ -243,204 +614,122 @@ impl<W: Write> ConFrameWriter<W> {
             .metadata_cache
             .as_ref()
             .expect("metadata_cache populated above");
-        writeln!(self.writer, "{}", cached.serialized)?;
-        writeln!(
-            self.writer,
-            "{1:.0$} {2:.0$} {3:.0$}",
-            prec, frame.header.boxl[0], frame.header.boxl[1], frame.header.boxl[2]
-        )?;
-        writeln!(
-            self.writer,
-            "{1:.0$} {2:.0$} {3:.0$}",
-            prec, frame.header.angles[0], frame.header.angles[1], frame.header.angles[2]
-        )?;
-        writeln!(self.writer, "{}", frame.header.postbox_header[0])?;
-        writeln!(self.writer, "{}", frame.header.postbox_header[1])?;
-        writeln!(self.writer, "{}", frame.header.natm_types)?;
-
-        let natms_str: Vec<String> = frame
-            .header
-            .natms_per_type
-            .iter()
-            .map(|n| n.to_string())
-            .collect();
-        writeln!(self.writer, "{}", natms_str.join(" "))?;
-
-        let masses_str: Vec<String> = frame
-            .header
-            .masses_per_type
-            .iter()
-            .map(|m| format!("{:.1$}", m, prec))
-            .collect();
-        writeln!(self.writer, "{}", masses_str.join(" "))?;
-
-        // --- Write the Atom Data ---
-        let mut atom_idx_offset = 0;
-        for (type_idx, &num_atoms_in_type) in frame.header.natms_per_type.iter().enumerate() {
-            let symbol = &frame.atom_data[atom_idx_offset].symbol;
-            writeln!(self.writer, "{}", symbol)?;
-            writeln!(self.writer, "Coordinates of Component {}", type_idx + 1)?;
-
-            for i in 0..num_atoms_in_type {
-                let atom = &frame.atom_data[atom_idx_offset + i];
-                writeln!(
-                    self.writer,
-                    "{x:.prec$} {y:.prec$} {z:.prec$} {fixed_flag} {atom_id}",
-                    prec = prec,
-                    x = atom.x,
-                    y = atom.y,
-                    z = atom.z,
-                    fixed_flag = encode_fixed_bitmask(atom.fixed),
-                    atom_id = atom.atom_id
-                )?;
-            }
-            atom_idx_offset += num_atoms_in_type;
+        // --- Write the 9-line Header, batched into one write ---
+        let line = &mut self.line;
+        line.clear();
+        line.extend_from_slice(header.prebox_header.user.as_bytes());
+        line.push(b'\n');
+        line.extend_from_slice(cached.serialized.as_bytes());
+        line.push(b'\n');
+        push_fixed_row(line, &header.boxl, prec);
+        push_fixed_row(line, &header.angles, prec);
+        for text in &header.postbox_header {
+            line.extend_from_slice(text.as_bytes());
+            line.push(b'\n');
         }
-
-        // --- Write optional velocity section ---
-        if frame.has_velocities() {
-            // Blank separator line between coordinates and velocities
-            writeln!(self.writer)?;
-
-            let mut vel_idx_offset = 0;
-            for (type_idx, &num_atoms_in_type) in frame.header.natms_per_type.iter().enumerate() {
-                let symbol = &frame.atom_data[vel_idx_offset].symbol;
-                writeln!(self.writer, "{}", symbol)?;
-                writeln!(self.writer, "Velocities of Component {}", type_idx + 1)?;
-
-                for i in 0..num_atoms_in_type {
-                    let atom = &frame.atom_data[vel_idx_offset + i];
-                    let [vx, vy, vz] = atom.velocity.unwrap_or([0.0; 3]);
-                    writeln!(
-                        self.writer,
-                        "{vx:.prec$} {vy:.prec$} {vz:.prec$} {fixed_flag} {atom_id}",
-                        prec = prec,
-                        fixed_flag = encode_fixed_bitmask(atom.fixed),
-                        atom_id = atom.atom_id
-                    )?;
-                }
-                vel_idx_offset += num_atoms_in_type;
+        push_u64(line, header.natm_types as u64);
+        line.push(b'\n');
+        for (k, &n) in header.natms_per_type.iter().enumerate() {
+            if k > 0 {
+                line.push(b' ');
             }
+            push_u64(line, n as u64);
         }
+        line.push(b'\n');
+        push_fixed_row(line, &header.masses_per_type, prec);
+        self.writer.write_all(line)?;
 
-        // --- Write optional force section ---
-        if frame.has_forces() {
-            // Blank separator line
-            writeln!(self.writer)?;
-
-            let mut force_idx_offset = 0;
-            for (type_idx, &num_atoms_in_type) in frame.header.natms_per_type.iter().enumerate() {
-                let symbol = &frame.atom_data[force_idx_offset].symbol;
-                writeln!(self.writer, "{}", symbol)?;
-                writeln!(self.writer, "Forces of Component {}", type_idx + 1)?;
-
-                for i in 0..num_atoms_in_type {
-                    let atom = &frame.atom_data[force_idx_offset + i];
-                    let [fx, fy, fz] = atom.force.unwrap_or([0.0; 3]);
-                    writeln!(
-                        self.writer,
-                        "{fx:.prec$} {fy:.prec$} {fz:.prec$} {fixed_flag} {atom_id}",
-                        prec = prec,
-                        fixed_flag = encode_fixed_bitmask(atom.fixed),
-                        atom_id = atom.atom_id
-                    )?;
-                }
-                force_idx_offset += num_atoms_in_type;
+        // --- Write the Atom Data, one batched write per component ---
+        let mut atom_idx_offset = 0;
+        for (type_idx, &num_atoms_in_type) in header.natms_per_type.iter().enumerate() {
+            line.clear();
+            push_component_title(
+                line,
+                frame.component_symbol(type_idx, atom_idx_offset),
+                "Coordinates",
+                type_idx,
+            );
+            for i in atom_idx_offset..atom_idx_offset + num_atoms_in_type {
+                let (fixed, atom_id) = frame.identity(i);
+                push_atom_row(line, &frame.position(i), prec, fixed, atom_id);
             }
+            self.writer.write_all(line)?;
+            atom_idx_offset += num_atoms_in_type;
         }
 
-        // --- Write optional energies section ---
-        if frame.has_energies() {
-            writeln!(self.writer)?;
-
-            let mut energy_idx_offset = 0;
-            for (type_idx, &num_atoms_in_type) in frame.header.natms_per_type.iter().enumerate() {
-                let symbol = &frame.atom_data[energy_idx_offset].symbol;
-                writeln!(self.writer, "{}", symbol)?;
-                writeln!(self.writer, "Energies of Component {}", type_idx + 1)?;
-
-                for i in 0..num_atoms_in_type {
-                    let atom = &frame.atom_data[energy_idx_offset + i];
-                    let e = atom.energy.unwrap_or(0.0);
-                    writeln!(
-                        self.writer,
-                        "{e:.prec$} {fixed_flag} {atom_id}",
-                        prec = prec,
-                        fixed_flag = encode_fixed_bitmask(atom.fixed),
-                        atom_id = atom.atom_id
-                    )?;
-                }
-                energy_idx_offset += num_atoms_in_type;
-            }
+        // --- Optional sections, in canonical order ---
+        if has_vel {
+            self.write_vector_section(frame, "Velocities", VectorSection::Velocities)?;
         }
-
-        if frame.has_charges() {
-            writeln!(self.writer)?;
-            let mut off = 0;
-            for (type_idx, &num_atoms_in_type) in frame.header.natms_per_type.iter().enumerate() {
-                let symbol = &frame.atom_data[off].symbol;
-                writeln!(self.writer, "{}", symbol)?;
-                writeln!(self.writer, "Charges of Component {}", type_idx + 1)?;
-                for i in 0..num_atoms_in_type {
-                    let atom = &frame.atom_data[off + i];
-                    let q = atom.charge.unwrap_or(0.0);
-                    writeln!(
-                        self.writer,
-                        "{q:.prec$} {fixed_flag} {atom_id}",
-                        prec = prec,
-                        fixed_flag = encode_fixed_bitmask(atom.fixed),
-                        atom_id = atom.atom_id
-                    )?;
-                }
-                off += num_atoms_in_type;
-            }
+        if has_frc {
+            self.write_vector_section(frame, "Forces", VectorSection::Forces)?;
+        }
+        if has_eng {
+            self.write_scalar_section(frame, "Energies", ScalarSection::Energies)?;
+        }
+        if has_chg {
+            self.write_scalar_section(frame, "Charges", ScalarSection::Charges)?;
+        }
+        if has_spn {
+            self.write_scalar_section(frame, "Spins", ScalarSection::Spins)?;
+        }
+        if has_mm {
+            self.write_vector_section(frame, "Magmoms", VectorSection::Magmoms)?;
         }
 
-        if frame.has_spins() {
-            writeln!(self.writer)?;
-            let mut off = 0;
-            for (type_idx, &num_atoms_in_type) in frame.header.natms_per_type.iter().enumerate() {
-                let symbol = &frame.atom_data[off].symbol;
-                writeln!(self.writer, "{}", symbol)?;
-                writeln!(self.writer, "Spins of Component {}", type_idx + 1)?;
-                for i in 0..num_atoms_in_type {
-                    let atom = &frame.atom_data[off + i];
-                    let s = atom.spin.unwrap_or(0.0);
-                    writeln!(
-                        self.writer,
-                        "{s:.prec$} {fixed_flag} {atom_id}",
-                        prec = prec,
-                        fixed_flag = encode_fixed_bitmask(atom.fixed),
-                        atom_id = atom.atom_id
-                    )?;
-                }
-                off += num_atoms_in_type;
+        Ok(())
+    }
+
+    /// Blank separator, then per component: symbol, `"<label> of Component
+    /// N"` and `vx vy vz fixed_flag atom_id` rows.
+    fn write_vector_section<F: FrameRows + ?Sized>(
+        &mut self,
+        frame: &F,
+        label: &str,
+        section: VectorSection,
+    ) -> io::Result<()> {
+        let prec = self.precision;
+        let line = &mut self.line;
+        line.clear();
+        line.push(b'\n');
+        let mut off = 0;
+        for (type_idx, &num_atoms_in_type) in frame.header().natms_per_type.iter().enumerate() {
+            push_component_title(line, frame.component_symbol(type_idx, off), label, type_idx);
+            for i in off..off + num_atoms_in_type {
+                let (fixed, atom_id) = frame.identity(i);
+                push_atom_row(line, &frame.vector(section, i), prec, fixed, atom_id);
             }
+            self.writer.write_all(line)?;
+            line.clear();
+            off += num_atoms_in_type;
         }
+        self.writer.write_all(line)
+    }
 
-        if frame.has_magmoms() {
-            writeln!(self.writer)?;
-            let mut off = 0;
-            for (type_idx, &num_atoms_in_type) in frame.header.natms_per_type.iter().enumerate() {
-                let symbol = &frame.atom_data[off].symbol;
-                writeln!(self.writer, "{}", symbol)?;
-                writeln!(self.writer, "Magmoms of Component {}", type_idx + 1)?;
-                for i in 0..num_atoms_in_type {
-                    let atom = &frame.atom_data[off + i];
-                    let [mx, my, mz] = atom.magmom.unwrap_or([0.0; 3]);
-                    writeln!(
-                        self.writer,
-                        "{mx:.prec$} {my:.prec$} {mz:.prec$} {fixed_flag} {atom_id}",
-                        prec = prec,
-                        fixed_flag = encode_fixed_bitmask(atom.fixed),
-                        atom_id = atom.atom_id
-                    )?;
-                }
-                off += num_atoms_in_type;
+    /// Blank separator, then per component: symbol, `"<label> of Component
+    /// N"` and `value fixed_flag atom_id` rows.
+    fn write_scalar_section<F: FrameRows + ?Sized>(
+        &mut self,
+        frame: &F,
+        label: &str,
+        section: ScalarSection,
+    ) -> io::Result<()> {
+        let prec = self.precision;
+        let line = &mut self.line;
+        line.clear();
+        line.push(b'\n');
+        let mut off = 0;
+        for (type_idx, &num_atoms_in_type) in frame.header().natms_per_type.iter().enumerate() {
+            push_component_title(line, frame.component_symbol(type_idx, off), label, type_idx);
+            for i in off..off + num_atoms_in_type {
+                let (fixed, atom_id) = frame.identity(i);
+                push_atom_row(line, &[frame.scalar(section, i)], prec, fixed, atom_id);
             }
+            self.writer.write_all(line)?;
+            line.clear();
+            off += num_atoms_in_type;
         }
-
-        Ok(())
+        self.writer.write_all(line)
     }
 
     /// Writes all frames from an iterator to the output stream.
@@ -452,6 +741,45 @@ impl<W: Write> ConFrameWriter<W> {
         }
         Ok(())
     }
+
+    /// [`Self::extend`] with frames formatted in chunks on the Rayon pool and
+    /// written in order; the output is byte-identical. Compression stays on
+    /// this writer's sink (one serial stream); for per-chunk parallel gzip /
+    /// zstd use [`crate::parallel_writer::ParallelConWriter`].
+    #[cfg(feature = "parallel")]
+    pub fn par_extend<F>(&mut self, frames: &[F]) -> io::Result<()>
+    where
+        F: std::borrow::Borrow<ConFrame> + Sync,
+    {
+        use crate::parallel_writer::{ChunkCompression, format_chunks, window_frames};
+        const FRAMES_PER_CHUNK: usize = 16;
+        if frames.len() < 2 {
+            return self.extend(frames.iter().map(|f| f.borrow()));
+        }
+        for window in frames.chunks(window_frames(FRAMES_PER_CHUNK)) {
+            let chunks = format_chunks(
+                window,
+                FRAMES_PER_CHUNK,
+                self.precision,
+                self.canonical,
+                ChunkCompression::None,
+                self.index.is_some(),
+            )?;
+            for (k, formatted) in chunks.iter().enumerate() {
+                let mut offset = self.bytes_written();
+                self.writer.write_all(&formatted.bytes)?;
+                if let Some(index) = self.index.as_mut() {
+                    let end = ((k + 1) * FRAMES_PER_CHUNK).min(window.len());
+                    let group = &window[k * FRAMES_PER_CHUNK..end];
+                    for (frame, &len) in group.iter().zip(&formatted.frame_lens) {
+                        index.push(frame.borrow(), offset, len);
+                        offset += len;
+                    }
+                }
+            }
+        }
+        Ok(())
+    }
 }
 
 // Implementation block specifically for when the writer is a `File`.
@@ -469,6 +797,23 @@ impl ConFrameWriter<File> {
         let file = File::create(path)?;
         Ok(Self::with_precision(file, precision))
     }
+
+    /// Flush and close the file, then write the `<path>.idx` offset-index
+    /// sidecar for it. `path` must be the path this writer was opened on and
+    /// [`Self::with_offset_index`] must have been enabled before the first frame.
+    pub fn finish_with_index<P: AsRef<Path>>(mut self, path: P) -> io::Result<FrameOffsetIndex> {
+        let builder = self.index.take().ok_or_else(|| {
+            io::Error::new(
+                io::ErrorKind::InvalidInput,
+                "offset index recording was not enabled on this writer",
+            )
+        })?;
+        self.writer.flush()?;
+        drop(self);
+        let idx = builder.finish(path.as_ref())?;
+        idx.write_sidecar(path.as_ref())?;
+        Ok(idx)
+    }
 }
 
 // Gzip-compressed writer constructors.
@@ -494,6 +839,11 @@ impl ConFrameWriter<flate2::write::GzEncoder<File>> {
 #[cfg(feature = "zstd")]
 impl ConFrameWriter<zstd::stream::write::AutoFinishEncoder<'static, File>> {
     /// Creates a zstd-compressed writer for the given path.
+    ///
+    /// The output is one continuous zstd stream; for archives that need
+    /// random frame access write through
+    /// [`crate::parallel_writer::ParallelConWriter::from_path`], whose `.zst`
+    /// output is seekable.
     pub fn from_path_zstd<P: AsRef<Path>>(path: P) -> io::Result<Self> {
         let encoder = crate::compression::zstd_writer(path.as_ref())?;
         Ok(Self::new(encoder))
@@ -508,3 +858,79 @@ impl ConFrameWriter<zstd::stream::write::AutoFinishEncoder<'static, File>> {
         Ok(Self::with_precision(encoder, precision))
     }
 }
+
+#[cfg(test)]
+mod fixed_format_tests {
+    use super::*;
+
+    fn fast(value: f64, prec: usize) -> String {
+        let mut out = Vec::new();
+        push_fixed(&mut out, value, prec);
+        String::from_utf8(out).unwrap()
+    }
+
+    #[test]
+    fn matches_core_fmt_on_edge_cases() {
+        let cases = [
+            0.0,
+            -0.0,
+            0.5,
+            1.5,
+            2.5,
+            -0.5,
+            0.125,
+            0.375,
+            -1e-9,
+            1e-300,
+            5e-324,
+            f64::MIN_POSITIVE,
+            0.1,
+            0.7,
+            123456.789,
+            -98765.4321,
+            1e15,
+            9.999_999_5,
+            99.999_999_999,
+            1e19,
+            1.8e19,
+            1e300,
+            f64::MAX,
+            f64::NAN,
+            f64::INFINITY,
+            f64::NEG_INFINITY,
+        ];
+        for prec in 0..=22 {
+            for &v in &cases {
+                assert_eq!(fast(v, prec), format!("{v:.prec$}"), "{v:e} at {prec}");
+            }
+        }
+    }
+
+    #[test]
+    fn matches_core_fmt_on_pseudorandom_values() {
+        // xorshift: deterministic spread over signs, exponents and mantissas.
+        let mut state = 0x9e37_79b9_7f4a_7c15u64;
+        for _ in 0..200_000 {
+            state ^= state << 13;
+            state ^= state >> 7;
+            state ^= state << 17;
+            let magnitude = f64::from_bits(state);
+            let scaled = (state >> 11) as f64 / (1u64 << 53) as f64 * 2e3 - 1e3;
+            let prec = (state % 13) as usize;
+            for v in [magnitude, scaled] {
+                assert_eq!(fast(v, prec), format!("{v:.prec$}"), "{v:e} at {prec}");
+            }
+        }
+    }
+
+    #[test]
+    fn integers_and_padding() {
+        let mut out = Vec::new();
+        push_u64(&mut out, 0);
+        out.push(b' ');
+        push_u64(&mut out, u64::MAX);
+        out.push(b' ');
+        push_u64_padded(&mut out, 42, 6);
+        assert_eq!(out, format!("0 {} 000042", u64::MAX).into_bytes());
+    }
+}
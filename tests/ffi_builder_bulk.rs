@@ -245,6 +245,96 @@ fn builder_bulk_setters_getters_and_metrics() {
     assert!(!msg.to_bytes().is_empty());
 }
 
+#[test]
+fn builder_set_atoms_from_arrays_one_call() {
+    let cu = CString::new("Cu").unwrap();
+    let h = CString::new("H").unwrap();
+    let names = [cu.as_ptr(), h.as_ptr()];
+    let counts = [2usize, 1];
+    let pos = [0.0, 0.0, 0.0, 1.0, 0.0, 0.0, 0.0, 1.0, 0.0];
+    let masses = [63.546, 63.546, 1.008];
+    let forces = [0.5_f64; 9];
+    let fixed = [0u8, 7, 0];
+    let ids = [10u64, 11, 12];
+    let none_f64 = ptr::null::<f64>();
+    unsafe {
+        let b = builder();
+        assert_eq!(
+            rkr_frame_builder_set_atoms_from_arrays(
+                b,
+                3,
+                pos.as_ptr(),
+                masses.as_ptr(),
+                names.as_ptr(),
+                counts.as_ptr(),
+                counts.len(),
+                ptr::null(),
+                fixed.as_ptr(),
+                ids.as_ptr(),
+                none_f64,
+                forces.as_ptr(),
+                none_f64,
+            ),
+            RKRStatus::RKR_STATUS_SUCCESS
+        );
+        assert_eq!(rkr_frame_builder_atom_count(b), 3);
+        let frame = rkr_frame_builder_build(b);
+        assert!(!frame.is_null());
+        assert_eq!(rkr_frame_atom_count(frame), 3);
+        assert!(!rkr_frame_forces_data(frame).is_null());
+        let mut out_ids = [0u64; 3];
+        rkr_frame_copy_atom_ids(frame, out_ids.as_mut_ptr(), out_ids.len());
+        assert_eq!(out_ids, ids);
+        free_rkr_frame(frame);
+
+        // Atomic numbers, defaults for fixed / ids, and a run-count mismatch.
+        let b = builder();
+        let zs = [29u64, 1, 29];
+        assert_eq!(
+            rkr_frame_builder_set_atoms_from_arrays(
+                b, 3, pos.as_ptr(), masses.as_ptr(), ptr::null(), ptr::null(), 0,
+                zs.as_ptr(), ptr::null(), ptr::null(), none_f64, none_f64, none_f64,
+            ),
+            RKRStatus::RKR_STATUS_SUCCESS
+        );
+        let short = [1usize, 1];
+        assert_eq!(
+            rkr_frame_builder_set_atoms_from_arrays(
+                b, 3, pos.as_ptr(), masses.as_ptr(), names.as_ptr(), short.as_ptr(), 2,
+                ptr::null(), ptr::null(), ptr::null(), none_f64, none_f64, none_f64,
+            ),
+            RKRStatus::RKR_STATUS_INDEX_OUT_OF_BOUNDS
+        );
+        assert_eq!(
+            rkr_frame_builder_set_atoms_from_arrays(
+                b, 3, pos.as_ptr(), masses.as_ptr(), ptr::null(), ptr::null(), 0,
+                ptr::null(), ptr::null(), ptr::null(), none_f64, none_f64, none_f64,
+            ),
+            RKRStatus::RKR_STATUS_NULL_POINTER
+        );
+        // Column lengths that overflow are refused before any pointer is read.
+        assert_eq!(
+            rkr_frame_builder_set_atoms_from_arrays(
+                b, usize::MAX / 3 + 1, pos.as_ptr(), masses.as_ptr(), ptr::null(), ptr::null(),
+                0, zs.as_ptr(), ptr::null(), ptr::null(), none_f64, none_f64, none_f64,
+            ),
+            RKRStatus::RKR_STATUS_VALIDATION_ERROR
+        );
+        // Run counts whose sum wraps past usize::MAX are refused too.
+        let wrapping = [usize::MAX, 4];
+        assert_eq!(
+            rkr_frame_builder_set_atoms_from_arrays(
+                b, 3, pos.as_ptr(), masses.as_ptr(), names.as_ptr(), wrapping.as_ptr(), 2,
+                ptr::null(), ptr::null(), ptr::null(), none_f64, none_f64, none_f64,
+            ),
+            RKRStatus::RKR_STATUS_VALIDATION_ERROR
+        );
+        // The failed calls leave the previous atoms in place.
+        assert_eq!(rkr_frame_builder_atom_count(b), 3);
+        free_rkr_frame_builder(b);
+    }
+}
+
 #[test]
 fn iterator_and_writer_surface() {
     let path = CString::new("resources/test/tiny_cuh2.con").unwrap();
@@ -158,3 +158,39 @@ fn zstd_writer_ffi_roundtrip() {
         assert_roundtrip(&path, &expected);
     }
 }
+
+#[test]
+fn parallel_gzip_writer_ffi_roundtrip() {
+    use readcon_core::ffi::create_writer_parallel_c;
+
+    let frames = load_fixture_frames();
+    // Enough frames for several chunks, so the file holds many gzip members.
+    let frames: Vec<ConFrame> = frames.iter().cycle().take(frames.len() * 100).cloned().collect();
+    let expected = frames.clone();
+
+    let dir = tempfile::tempdir().unwrap();
+    let path = dir.path().join("par.con.gz");
+    let c_path = CString::new(path.to_str().unwrap()).unwrap();
+
+    let handles = into_handles(frames);
+    let writer = unsafe { create_writer_parallel_c(c_path.as_ptr(), 6) };
+    // Two extend calls: the second batch must land after the first.
+    let (head, tail) = handles.split_at(7);
+    write_through_ffi_keep(writer, head);
+    write_through_ffi(writer, tail);
+    free_handles(&handles);
+
+    let raw = fs::read(&path).unwrap();
+    assert_eq!(&raw[..2], &[0x1f, 0x8b], "output must be a gzip stream");
+    assert_roundtrip(&path, &expected);
+}
+
+/// `rkr_writer_extend` without freeing the writer.
+fn write_through_ffi_keep(
+    handle: *mut readcon_core::ffi::RKRConFrameWriter,
+    frames: &[*const RKRConFrame],
+) {
+    assert!(!handle.is_null(), "writer handle should be non-null");
+    let status = unsafe { rkr_writer_extend(handle, frames.as_ptr(), frames.len()) };
+    assert_eq!(status, RKRStatus::RKR_STATUS_SUCCESS, "extend should succeed");
+}
@@ -156,6 +156,32 @@ fn test_gzip_roundtrip() {
     assert_eq!(frames_original, frames_rt);
 }
 
+#[test]
+fn test_gzip_streaming_first_frame_and_count() {
+    let fdat =
+        fs::read_to_string(test_case!("tiny_multi_cuh2.con")).expect("Can't find test file.");
+    let frames_original: Vec<_> = ConFrameIterator::new(&fdat).map(|r| r.unwrap()).collect();
+
+    let tmp = tempfile::NamedTempFile::with_suffix(".con.gz").unwrap();
+    let path = tmp.path().to_owned();
+    {
+        let mut writer = ConFrameWriter::from_path_gzip_with_precision(&path, 17).unwrap();
+        writer
+            .extend(frames_original.iter())
+            .expect("Failed to write gzip.");
+    }
+
+    let n = readcon_core::iterators::count_frames(&path).expect("Failed to count gzip.");
+    assert_eq!(n, frames_original.len());
+    let first = readcon_core::iterators::read_first_frame(&path).expect("Failed to read gzip.");
+    assert_eq!(first, frames_original[0]);
+    let streamed: Vec<_> = readcon_core::streaming::StreamingConFrameIterator::from_path(&path)
+        .expect("open gzip stream")
+        .map(|r| r.unwrap())
+        .collect();
+    assert_eq!(streamed, frames_original);
+}
+
 #[test]
 fn test_energies_roundtrip() {
     use readcon_core::types::ConFrameBuilder;
@@ -65,6 +65,21 @@ def test_select_all_atom_count():
     assert len(out["primary_indices"]) == 3
 
 
+def test_compiled_selection_matches_one_shot_selection():
+    sel = readcon.CompiledSelection("name H and x > 1.0")
+    assert sel.selection == "name H and x > 1.0"
+    assert sel.context_size == 1
+    frame = _ho_frame()
+    assert sel.atom_indices(frame) == readcon.select_atom_indices(frame, sel.selection)
+    out = sel.evaluate_frames([frame, frame])
+    assert [s["atom_indices"] for s in out["frames"]] == [[1], [1]]
+
+
+def test_compiled_selection_rejects_bad_grammar():
+    with pytest.raises(Exception):
+        readcon.CompiledSelection("not a valid !!! selection")
+
+
 @pytest.mark.skipif(
     not (
         hasattr(readcon, "select_atom_positions_on_frames")
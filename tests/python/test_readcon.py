@@ -326,6 +326,39 @@ class TestConFrameConstructor:
         assert len(frames) == 2
         assert [len(frame) for frame in frames] == [4, 4]
 
+    def test_iter_con_seek_skip_and_stride(self):
+        path = _resource("tiny_multi_cuh2.con")
+        batch = readcon.read_all_frames(path)
+
+        iterator = readcon.iter_con(path)
+        assert iterator.skip(1) == 1
+        assert iterator.position == 1
+        second = next(iterator)
+        assert second.atoms[0].x == pytest.approx(batch[1].atoms[0].x)
+        iterator.seek(0)
+        assert next(iterator).atoms[0].x == pytest.approx(batch[0].atoms[0].x)
+        assert iterator.skip(5) == 1
+        with pytest.raises(IndexError):
+            iterator.seek(2)
+
+        assert len(list(readcon.iter_con(path, start=1))) == 1
+        assert len(list(readcon.iter_con(path, step=2))) == 1
+        assert len(list(readcon.iter_con(path, stop=1))) == 1
+        strided = readcon.read_frames(path, start=1, step=2)
+        assert len(strided) == 1
+        assert strided[0].atoms[0].x == pytest.approx(batch[1].atoms[0].x)
+
+    def test_read_con_threads_matches_sequential(self):
+        path = _resource("tiny_multi_cuh2.con")
+        batch = readcon.read_con(path)
+        for threads in (0, 1, 2, 4):
+            frames = readcon.read_con(path, threads=threads)
+            assert len(frames) == len(batch)
+            for got, want in zip(frames, batch):
+                assert [a.x for a in got.atoms] == pytest.approx(
+                    [a.x for a in want.atoms]
+                )
+
     def test_count_frames_and_streaming_matches_batch(self):
         path = _resource("tiny_multi_cuh2.con")
         assert readcon.count_frames(path) == 2
@@ -337,6 +370,68 @@ class TestConFrameConstructor:
             assert a.atoms[0].symbol == b.atoms[0].symbol
             assert a.atoms[0].x == pytest.approx(b.atoms[0].x)
 
+    def test_query_frames_screens_by_composition(self):
+        path = _resource("tiny_multi_cuh2.con")
+        assert readcon.query_frames(path, "composition == 'H:2|Cu:2'") == [0, 1]
+        assert readcon.query_frames(path, "natoms > 0 && energy < 0") == []
+        spans = readcon.query_frames(path, "natoms == 4", spans=True)
+        assert [s[0] for s in spans] == [0, 1]
+        assert spans[1][1] == spans[0][1] + spans[0][2]
+        with pytest.raises(ValueError):
+            readcon.query_frames(path, "mass < 3")
+
+    def test_con_trajectory_is_lazy_and_sliceable(self):
+        path = _resource("tiny_multi_cuh2.con")
+        frames = readcon.read_all_frames(path)
+        traj = readcon.ConTrajectory(path, prefetch=1)
+        assert len(traj) == len(frames) == 2
+        assert traj[-1].index == 1
+        assert traj[1].coords_array() == pytest.approx(frames[1].coords_array())
+        assert traj[0].symbols == [a.symbol for a in frames[0].atoms]
+        with pytest.raises(IndexError):
+            traj[2]
+        tail = traj[1:]
+        assert len(tail) == 1 and tail[0].index == 1
+        assert len(traj[::-1]) == 2 and traj[::-1][0].index == 1
+        got = list(traj)
+        assert [f.index for f in got] == [0, 1]
+        assert got[0].to_frame().coords_array() == pytest.approx(frames[0].coords_array())
+        assert not got[0].coords_array().flags.writeable
+
+    def test_read_con_tensors_batches_frames(self):
+        import numpy as np
+
+        path = _resource("tiny_multi_cuh2.con")
+        frames = readcon.read_all_frames(path)
+        batch = readcon.read_con_tensors(path)
+        assert batch["positions"].shape == (2, 4, 3)
+        assert batch["positions"].dtype == np.float64
+        assert batch["energies"].shape == (2,)
+        for f, fr in enumerate(frames):
+            assert batch["positions"][f] == pytest.approx(fr.coords_array())
+
+        tail = readcon.read_con_tensors(path, start=1, dtype="float32")
+        assert tail["positions"].dtype == np.float32
+        assert tail["positions"].shape == (1, 4, 3)
+        half = readcon.read_con_tensors(path, dtype="float16")
+        assert half["positions"].dtype == np.float16
+        with pytest.raises(ValueError):
+            readcon.read_con_tensors(path, dtype="bogus")
+
+    def test_read_con_tensormap_keys_by_species(self):
+        path = _resource("tiny_multi_cuh2.con")
+        with pytest.raises(ValueError):
+            readcon.read_con_tensormap(path, keys="bogus")
+        pytest.importorskip("metatensor")
+        tmap = readcon.read_con_tensormap(path, keys="species")
+        assert len(tmap) == 2  # H, Cu
+        assert sum(block.values.shape[0] for block in tmap.blocks()) == 8
+        block = readcon.read_con_tensormap(path, start=1).block(0)
+        assert block.samples.names == ["system", "atom"]
+        assert block.values == pytest.approx(readcon.read_all_frames(path)[1].coords_array())
+        with pytest.raises(ValueError):
+            readcon.read_con_tensormap(path, keys="species", quantity="forces")
+
     def test_coords_array_matches_atoms_after_full_frame_load(self):
         path = _resource("tiny_multi_cuh2.con")
         frames = readcon.read_all_frames(path)